@@ -0,0 +1,329 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include "../src/prec.h"
+#include "../src/simd/simd.h"
+#include "../src/simd/calloc_aligned.h"
+#include "../src/simd/free_aligned.h"
+#include "../src/leg/leg_func_xnum.h"
+#include "../src/misc/misc_fprintf_real.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* This program measures the throughput and the accuracy of the recurrence
+ * relation for fully-normalized Legendre polynomials, "P_{n}(t) = a_{n} * t *
+ * P_{n - 1}(t) - b_{n} * P_{n - 2}(t)", combined with the sum
+ * "\sum_{n = 0}^{N} c_{n} * P_{n}(t)".  This is the innermost loop of spherical harmonic
+ * transforms.  The recurrence is evaluated using the "PNM_RECURRENCE" macro
+ * and the sum by the "FMA_R" macro, so that the fused multiply-add
+ * instructions are used whenever CHarm is compiled with them (e.g.,
+ * "--enable-avx2", "--enable-avx-512" or "--enable-neon").
+ *
+ * To see the gain due to the fused multiply-add instructions, run the
+ * program with two builds of CHarm, one with "--enable-avx2" (fused
+ * multiply-add enabled) and one with "--enable-avx2" and "CFLAGS=-mno-fma"
+ * (fused multiply-add disabled), and compare the outputs.
+ *
+ * The accuracy is the maximum absolute difference between the sums and
+ * reference sums computed in a higher precision, divided by the maximum
+ * absolute value of the reference sums. */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Total number of maximum harmonic degrees, for which the program is
+ * executed. */
+#undef NMAX
+#define NMAX 6
+
+
+/* Number of evaluation points, must be a multiple of "SIMD_SIZE *
+ * SIMD_BLOCK_S" */
+#undef NPOINT
+#define NPOINT (256 * SIMD_SIZE * SIMD_BLOCK_S)
+
+
+/* Minimum number of repetitions of each test to get reliable timings */
+#undef NREP
+#define NREP 5
+
+
+/* Type of the reference computation */
+#undef REAL_REF
+#if CHARM_QUAD
+#   define REAL_REF REAL
+#else
+#   define REAL_REF long double
+#endif
+
+
+#undef FORMAT
+#if CHARM_FLOAT
+#   define FORMAT "%0.8e"
+#elif CHARM_QUAD
+#   define FORMAT "%0.34Qe"
+#else
+#   define FORMAT "%0.17e"
+#endif
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Evaluates "\sum_{n = 0}^{nmax} c_{n} * P_{n}(t)" for all "NPOINT" values of
+ * "t".  As in CHarm, the points are processed in blocks of "SIMD_BLOCK_S"
+ * SIMD vectors. */
+static void lc_sum(const REAL *t,
+                   const REAL *a,
+                   const REAL *b,
+                   const REAL *c,
+                   unsigned long nmax,
+                   REAL *f)
+{
+    REAL_SIMD tv[SIMD_BLOCK_S], x[SIMD_BLOCK_S], y[SIMD_BLOCK_S];
+    REAL_SIMD pnm2[SIMD_BLOCK_S], sum[SIMD_BLOCK_S];
+    REAL_SIMD anms, bnms, cn;
+    REAL_SIMD root3 = SET1_R(SQRT(PREC(3.0)));
+    size_t l;
+
+
+    for (size_t i = 0; i < NPOINT; i += SIMD_SIZE * SIMD_BLOCK_S)
+    {
+        for (l = 0; l < SIMD_BLOCK_S; l++)
+        {
+            tv[l]  = LOAD_R(&t[i + l * SIMD_SIZE]);
+            y[l]   = SET1_R(PREC(1.0));
+            x[l]   = MUL_R(root3, tv[l]);
+            sum[l] = FMA_R(SET1_R(c[1]), x[l], SET1_R(c[0]));
+        }
+
+
+        for (unsigned long n = 2; n <= nmax; n++)
+        {
+            anms = SET1_R(a[n]);
+            bnms = SET1_R(b[n]);
+            cn   = SET1_R(c[n]);
+            for (l = 0; l < SIMD_BLOCK_S; l++)
+            {
+                PNM_RECURRENCE(x[l], y[l], pnm2[l], tv[l], anms, bnms);
+                sum[l] = FMA_R(cn, pnm2[l], sum[l]);
+                RECURRENCE_NEXT_ITER(y[l], x[l], pnm2[l]);
+            }
+        }
+
+
+        for (l = 0; l < SIMD_BLOCK_S; l++)
+            STORE_R(&f[i + l * SIMD_SIZE], sum[l]);
+    }
+
+
+    return;
+}
+
+
+
+
+
+
+int main(void)
+{
+    /* Maximum harmonic degrees to benchmark CHarm */
+    unsigned long nmax_all[NMAX] = {   100,
+                                       250,
+                                       500,
+                                      1000,
+                                      2500,
+                                      5000
+                                   };
+    const unsigned long nmax_max = nmax_all[NMAX - 1];
+
+
+    /* Data folder to save the outputs of the benchmark */
+    char path[] = "../data/output";
+
+
+    /* Some variables to measure the execution time */
+#if HAVE_CLOCK_GETTIME
+    struct timespec t1, t2;
+    long sec, nsec;
+#endif
+    double elapsed, flops;
+
+
+    /* Open the file stream to save the outputs */
+#undef NSTR
+#define NSTR (2048)
+    char file_fma[NSTR];
+#undef FMA_FILE
+#if CHARM_FLOAT
+#   define FMA_FILE "%s/benchf-fma-%s.txt"
+#elif CHARM_QUAD
+#   define FMA_FILE "%s/benchq-fma-%s.txt"
+#else
+#   define FMA_FILE "%s/bench-fma-%s.txt"
+#endif
+#ifdef SIMD_FMA
+    snprintf(file_fma, NSTR, FMA_FILE, path, "on");
+#else
+    snprintf(file_fma, NSTR, FMA_FILE, path, "off");
+#endif
+    FILE *fid_fma = fopen(file_fma, "w");
+    if (fid_fma == NULL)
+    {
+        fprintf(stderr, "Failed to open the output file.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Evaluation points, recurrence coefficients and random coefficients of
+     * the sum */
+    REAL *t = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, NPOINT,
+                                            sizeof(REAL));
+    REAL *f = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, NPOINT,
+                                            sizeof(REAL));
+    REAL *a = (REAL *)malloc((nmax_max + 1) * sizeof(REAL));
+    REAL *b = (REAL *)malloc((nmax_max + 1) * sizeof(REAL));
+    REAL *c = (REAL *)malloc((nmax_max + 1) * sizeof(REAL));
+    REAL_REF *a_ref = (REAL_REF *)malloc((nmax_max + 1) * sizeof(REAL_REF));
+    REAL_REF *b_ref = (REAL_REF *)malloc((nmax_max + 1) * sizeof(REAL_REF));
+    if (t == NULL || f == NULL || a == NULL || b == NULL || c == NULL ||
+        a_ref == NULL || b_ref == NULL)
+    {
+        fprintf(stderr, "malloc failure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    for (size_t i = 0; i < NPOINT; i++)
+        t[i] = PREC(-1.0) + PREC(2.0) * ((REAL)i + PREC(0.5)) / (REAL)NPOINT;
+
+
+    /* The seed is fixed, so that the accuracy obtained with different builds
+     * of CHarm can be compared */
+    srand(1);
+    for (unsigned long n = 0; n <= nmax_max; n++)
+    {
+        c[n] = PREC(-1.0) + (REAL)rand() / ((REAL)RAND_MAX / PREC(2.0));
+        if (n < 2)
+        {
+            a[n] = b[n] = PREC(0.0);
+            a_ref[n] = b_ref[n] = 0.0;
+            continue;
+        }
+
+
+        a_ref[n] = (REAL_REF)SQRT((REAL)((2 * n - 1) * (2 * n + 1))) /
+                   (REAL_REF)n;
+        b_ref[n] = (REAL_REF)(n - 1) / (REAL_REF)n *
+                   (REAL_REF)SQRT((REAL)(2 * n + 1) / (REAL)(2 * n - 3));
+        a[n] = (REAL)a_ref[n];
+        b[n] = (REAL)b_ref[n];
+    }
+
+
+    printf("\n\n");
+#ifdef SIMD_FMA
+    printf("Fused multiply-add instructions: enabled\n\n");
+#else
+    printf("Fused multiply-add instructions: disabled\n\n");
+#endif
+
+
+    /* Loop over all "nmax_all" degrees */
+    for (unsigned long nnmax = 0; nnmax < NMAX; nnmax++)
+    {
+        unsigned long nmax = nmax_all[nnmax];
+        printf("Maximum harmonic degree: %lu\n", nmax);
+
+
+        printf("    Evaluating the recurrence...\n");
+#if HAVE_CLOCK_GETTIME
+        clock_gettime(CLOCK_REALTIME, &t1);
+#endif
+        for (int rep = 0; rep < NREP; rep++)
+            lc_sum(t, a, b, c, nmax, f);
+#if HAVE_CLOCK_GETTIME
+        clock_gettime(CLOCK_REALTIME, &t2);
+        sec     = t2.tv_sec  - t1.tv_sec;
+        nsec    = t2.tv_nsec - t1.tv_nsec;
+        elapsed = (sec + nsec * 1.0e-9) / NREP;
+#else
+        elapsed = 0.0;
+#endif
+
+
+        /* Three multiplications and one subtraction in the recurrence, one
+         * multiplication and one addition in the sum */
+        flops = 6.0 * (double)(nmax - 1) * (double)NPOINT;
+
+
+        printf("    Evaluating accuracy...\n");
+        REAL maxe = PREC(0.0);
+        REAL maxf = PREC(0.0);
+        for (size_t i = 0; i < NPOINT; i++)
+        {
+            REAL_REF y   = 1.0;
+            REAL_REF x   = (REAL_REF)SQRT(PREC(3.0)) * (REAL_REF)t[i];
+            REAL_REF z;
+            REAL_REF sum = (REAL_REF)c[0] + (REAL_REF)c[1] * x;
+            for (unsigned long n = 2; n <= nmax; n++)
+            {
+                z   = a_ref[n] * (REAL_REF)t[i] * x - b_ref[n] * y;
+                sum = sum + (REAL_REF)c[n] * z;
+                y   = x;
+                x   = z;
+            }
+
+
+            if (FABS((REAL)sum) > maxf)
+                maxf = FABS((REAL)sum);
+            if (FABS(f[i] - (REAL)sum) > maxe)
+                maxe = FABS(f[i] - (REAL)sum);
+        }
+        maxe /= maxf;
+
+
+        printf("    Saving the outputs to %s...\n", file_fma);
+        fprintf(fid_fma, "%lu %0.17e %0.17e ", nmax, elapsed,
+                (elapsed > 0.0) ? flops / elapsed * 1.0e-9 : 0.0);
+        CHARM(misc_fprintf_real)(fid_fma, FORMAT, maxe);
+        fprintf(fid_fma, "\n");
+
+
+        printf("\n\n");
+    }
+
+
+    fclose(fid_fma);
+    CHARM(free_aligned)(t);
+    CHARM(free_aligned)(f);
+    free(a);
+    free(b);
+    free(c);
+    free(a_ref);
+    free(b_ref);
+
+
+    printf("Done.\n");
+#if !HAVE_CLOCK_GETTIME
+    printf("WARNING: The \"clock_gettime\" function was not found "
+           "during the compilation of CHarm, so the benchmark "
+           "program couldn't measure the computation time.  The only relevant "
+           "output is therefore the computational accuracy.\n");
+#endif
+    return 0;
+}
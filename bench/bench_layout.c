@@ -0,0 +1,236 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../src/prec.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* This program measures the wall-clock time of "charm_shs_point" and
+ * "charm_shs_point_grad1" at "NPOINT" scattered points for a model with random
+ * coefficients up to the maximum degrees in "NMAX".  Compared are
+ *
+ * * "separate": the synthesis reads the coefficients directly from the
+ *   separate "C" and "S" arrays of "charm_shc"
+ *   ("charm_glob_shs_point_interleave_nmax = 0"),
+ *
+ * * "interleaved": the synthesis copies the coefficients first to the
+ *   interleaved and aligned layout already multiplied by "mu / r" (see
+ *   "charm_glob_shs_point_interleave_nmax").  The time includes the copy.
+ *
+ * The outputs are saved to "data/output/bench-layout.txt" (double precision),
+ * "benchf-layout.txt" (single precision) or "benchq-layout.txt" (quadruple
+ * precision).  The columns are the quantity ("0" for "charm_shs_point" and
+ * "1" for "charm_shs_point_grad1"), the maximum harmonic degree, the
+ * wall-clock times of "separate" and "interleaved" and the speedup of the
+ * latter. */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Number of scattered points */
+#undef NPOINT
+#define NPOINT (10000UL)
+
+
+/* Tested maximum harmonic degrees */
+#undef NNMAX
+#define NNMAX (5)
+const unsigned long NMAX[NNMAX] = {10, 50, 100, 200, 500};
+
+
+/* Number of repetitions of each test.  The shortest time is taken. */
+#undef NREP
+#define NREP 3
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns the wall-clock time of the synthesis of "shcs" up to degree "nmax"
+ * at "pnt" with "interleave_nmax" assigned to
+ * "charm_glob_shs_point_interleave_nmax" */
+static double time_synthesis(const CHARM(point) *pnt,
+                             const CHARM(shc) *shcs,
+                             unsigned long nmax,
+                             int grad,
+                             unsigned long interleave_nmax,
+                             REAL **f,
+                             CHARM(err) *err)
+{
+#if HAVE_CLOCK_GETTIME
+    struct timespec t1, t2;
+#endif
+    double elapsed, best = -1.0;
+
+
+    CHARM(glob_shs_point_interleave_nmax) = interleave_nmax;
+    for (int rep = 0; rep < NREP; rep++)
+    {
+#if HAVE_CLOCK_GETTIME
+        clock_gettime(CLOCK_REALTIME, &t1);
+#endif
+        if (grad)
+            CHARM(shs_point_grad1)(pnt, shcs, nmax, f, err);
+        else
+            CHARM(shs_point)(pnt, shcs, nmax, f[0], err);
+        CHARM(err_handler)(err, 1);
+#if HAVE_CLOCK_GETTIME
+        clock_gettime(CLOCK_REALTIME, &t2);
+        elapsed = (double)(t2.tv_sec - t1.tv_sec) +
+                  (double)(t2.tv_nsec - t1.tv_nsec) * 1.0e-9;
+#else
+        elapsed = 0.0;
+#endif
+        if (best < 0.0 || elapsed < best)
+            best = elapsed;
+    }
+
+
+    return best;
+}
+
+
+
+
+
+
+int main(void)
+{
+    /* Data folder to save the outputs of the benchmark */
+    char path[] = "../data/output";
+
+
+    /* Initialize the error structure */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the error structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Open the file stream to save the outputs */
+#undef NSTR
+#define NSTR (2048)
+    char file_layout[NSTR];
+#undef LAYOUT_FILE
+#if CHARM_FLOAT
+#   define LAYOUT_FILE "%s/benchf-layout.txt"
+#elif CHARM_QUAD
+#   define LAYOUT_FILE "%s/benchq-layout.txt"
+#else
+#   define LAYOUT_FILE "%s/bench-layout.txt"
+#endif
+    snprintf(file_layout, NSTR, LAYOUT_FILE, path);
+    FILE *fid_layout = fopen(file_layout, "w");
+    if (fid_layout == NULL)
+    {
+        fprintf(stderr, "Failed to open the output file.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Random coefficients with "mu / r" different from "1" so that the
+     * scaling folded into the interleaved layout is not trivial */
+    unsigned long nmax_max = NMAX[NNMAX - 1];
+    CHARM(shc) *shcs = CHARM(shc_malloc)(nmax_max, PREC(2.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the shc structure.\n");
+        exit(CHARM_FAILURE);
+    }
+    srand(1);
+    for (size_t i = 0; i < shcs->nc; i++)
+    {
+        shcs->c[0][i] = (REAL)rand() / (REAL)RAND_MAX - PREC(0.5);
+        shcs->s[0][i] = (REAL)rand() / (REAL)RAND_MAX - PREC(0.5);
+    }
+
+
+    /* Random scattered points above the reference sphere */
+    CHARM(point) *pnt = CHARM(crd_point_malloc)(CHARM_CRD_POINT_SCATTERED,
+                                                NPOINT, NPOINT);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the point structure.\n");
+        exit(CHARM_FAILURE);
+    }
+    for (size_t i = 0; i < NPOINT; i++)
+    {
+        pnt->lat[i] = (REAL)rand() / (REAL)RAND_MAX * PI - PI_2;
+        pnt->lon[i] = (REAL)rand() / (REAL)RAND_MAX * PREC(2.0) * PI;
+        pnt->r[i]   = shcs->r + PREC(0.001);
+    }
+
+
+    REAL *f[3];
+    for (int p = 0; p < 3; p++)
+    {
+        f[p] = (REAL *)malloc(NPOINT * sizeof(REAL));
+        if (f[p] == NULL)
+        {
+            fprintf(stderr, "Failed to initialize an array.\n");
+            exit(CHARM_FAILURE);
+        }
+    }
+
+
+    unsigned long interleave_nmax = CHARM(glob_shs_point_interleave_nmax);
+
+
+    printf("\n\n");
+    printf("Number of scattered points: %lu\n\n", NPOINT);
+
+
+    const char *grad_str[2] = {"shs_point", "shs_point_grad1"};
+    for (int grad = 0; grad < 2; grad++)
+    {
+        for (size_t i = 0; i < NNMAX; i++)
+        {
+            double t_sep = time_synthesis(pnt, shcs, NMAX[i], grad, 0, f,
+                                          err);
+            double t_int = time_synthesis(pnt, shcs, NMAX[i], grad,
+                                          NMAX[i] + 1, f, err);
+
+
+            printf("    %-15s nmax: %5lu, separate: %0.6e s, "
+                   "interleaved: %0.6e s, speedup: %0.2f\n",
+                   grad_str[grad], NMAX[i], t_sep, t_int,
+                   (t_int > 0.0) ? t_sep / t_int : 0.0);
+            fprintf(fid_layout, "%d %lu %0.17e %0.17e %0.17e\n", grad,
+                    NMAX[i], t_sep, t_int,
+                    (t_int > 0.0) ? t_sep / t_int : 0.0);
+        }
+    }
+
+
+    CHARM(glob_shs_point_interleave_nmax) = interleave_nmax;
+    for (int p = 0; p < 3; p++)
+        free(f[p]);
+    fclose(fid_layout);
+    CHARM(crd_point_free)(pnt);
+    CHARM(shc_free)(shcs);
+    CHARM(err_free)(err);
+
+
+    printf("Done.\n");
+#if !HAVE_CLOCK_GETTIME
+    printf("WARNING: The \"clock_gettime\" function was not found "
+           "during the compilation of CHarm, so the benchmark "
+           "program couldn't measure the computation time.\n");
+#endif
+    return 0;
+}
@@ -0,0 +1,192 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../src/prec.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* This program measures the wall-clock time of "charm_leg_pnmj_coeffs" for
+ * several maximum harmonic degrees and numbers of OpenMP threads.  The number
+ * of threads is doubled from "1" up to the default number of threads of the
+ * OpenMP runtime (e.g., "OMP_NUM_THREADS"), which is always included.
+ *
+ * The outputs are saved to "data/output/bench-pnmj.txt" (double precision),
+ * "benchf-pnmj.txt" (single precision) or "benchq-pnmj.txt" (quadruple
+ * precision).  The columns are the maximum harmonic degree, the number of
+ * threads, the wall-clock time and the speedup with respect to a single
+ * thread. */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Total number of maximum harmonic degrees, for which the program is
+ * executed.  Note that the memory requirements grow with the third power of
+ * the maximum harmonic degree. */
+#undef NMAX
+#define NMAX 4
+
+
+/* Number of repetitions of each test.  The shortest time is taken. */
+#undef NREP
+#define NREP 3
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+int main(void)
+{
+    /* Maximum harmonic degrees to benchmark CHarm */
+    unsigned long nmax_all[NMAX] = {100,
+                                    200,
+                                    400,
+                                    600
+                                   };
+
+
+    /* Data folder to save the outputs of the benchmark */
+    char path[] = "../data/output";
+
+
+    /* Some variables to measure the execution time */
+#if HAVE_CLOCK_GETTIME
+    struct timespec t1, t2;
+#endif
+    double elapsed, best, best1 = 0.0;
+
+
+    /* Maximum number of OpenMP threads */
+#if HAVE_OPENMP
+    int nthreads_max = omp_get_max_threads();
+#else
+    int nthreads_max = 1;
+#endif
+
+
+    /* Initialize the error structure */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the error structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Open the file stream to save the outputs */
+#undef NSTR
+#define NSTR (2048)
+    char file_pnmj[NSTR];
+#undef PNMJ_FILE
+#if CHARM_FLOAT
+#   define PNMJ_FILE "%s/benchf-pnmj.txt"
+#elif CHARM_QUAD
+#   define PNMJ_FILE "%s/benchq-pnmj.txt"
+#else
+#   define PNMJ_FILE "%s/bench-pnmj.txt"
+#endif
+    snprintf(file_pnmj, NSTR, PNMJ_FILE, path);
+    FILE *fid_pnmj = fopen(file_pnmj, "w");
+    if (fid_pnmj == NULL)
+    {
+        fprintf(stderr, "Failed to open the output file.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    printf("\n\n");
+    printf("Maximum number of OpenMP threads: %d\n\n", nthreads_max);
+
+
+    /* Loop over all "nmax_all" degrees */
+    for (int i = 0; i < NMAX; i++)
+    {
+        unsigned long nmax = nmax_all[i];
+        printf("Maximum harmonic degree: %lu\n", nmax);
+
+
+        CHARM(pnmj) *pnmj = CHARM(leg_pnmj_malloc)(nmax, CHARM_LEG_PMNJ);
+        if (pnmj == NULL)
+        {
+            fprintf(stderr, "Failed to initialize the pnmj structure.\n");
+            exit(CHARM_FAILURE);
+        }
+
+
+        for (int nthreads = 1; ; nthreads *= 2)
+        {
+            if (nthreads > nthreads_max)
+                nthreads = nthreads_max;
+#if HAVE_OPENMP
+            omp_set_num_threads(nthreads);
+#endif
+
+
+            best = -1.0;
+            for (int rep = 0; rep < NREP; rep++)
+            {
+#if HAVE_CLOCK_GETTIME
+                clock_gettime(CLOCK_REALTIME, &t1);
+#endif
+                CHARM(leg_pnmj_coeffs)(pnmj, nmax, err);
+                CHARM(err_handler)(err, 1);
+#if HAVE_CLOCK_GETTIME
+                clock_gettime(CLOCK_REALTIME, &t2);
+                elapsed = (double)(t2.tv_sec - t1.tv_sec) +
+                          (double)(t2.tv_nsec - t1.tv_nsec) * 1.0e-9;
+#else
+                elapsed = 0.0;
+#endif
+                if (best < 0.0 || elapsed < best)
+                    best = elapsed;
+            }
+            if (nthreads == 1)
+                best1 = best;
+
+
+            printf("    Threads: %3d, time: %0.6e s, speedup: %0.2f\n",
+                   nthreads, best, (best > 0.0) ? best1 / best : 0.0);
+            fprintf(fid_pnmj, "%lu %d %0.17e %0.17e\n", nmax, nthreads, best,
+                    (best > 0.0) ? best1 / best : 0.0);
+
+
+            if (nthreads == nthreads_max)
+                break;
+        }
+
+
+        CHARM(leg_pnmj_free)(pnmj);
+        printf("\n\n");
+    }
+
+
+#if HAVE_OPENMP
+    omp_set_num_threads(nthreads_max);
+#endif
+    fclose(fid_pnmj);
+    CHARM(err_free)(err);
+
+
+    printf("Done.\n");
+#if !HAVE_CLOCK_GETTIME
+    printf("WARNING: The \"clock_gettime\" function was not found "
+           "during the compilation of CHarm, so the benchmark "
+           "program couldn't measure the computation time.\n");
+#endif
+    return 0;
+}
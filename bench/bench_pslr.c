@@ -0,0 +1,329 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../src/prec.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* This program measures the wall-clock time of "charm_shs_point" at grids with
+ * "NLAT" latitudes and the numbers of longitudes from "NLON" for a model with
+ * random coefficients up to the maximum degrees in "NMAX".  First, the grids
+ * cover the full circle, so they allow FFT along the latitude parallels.
+ * Compared are
+ *
+ * * "fft": the synthesis transforms all the latitudes by FFT
+ *   ("charm_glob_shs_grd_pslr_factor = 0"),
+ *
+ * * "pslr": the synthesis transforms all the latitudes by the PSLR algorithm
+ *   (a huge "charm_glob_shs_grd_pslr_factor").
+ *
+ * For each case, printed is also "(nmax + 1) / log2(nlon)".  A suitable
+ * value of "charm_glob_shs_grd_pslr_factor" on your hardware is the largest
+ * such value, for which "pslr" is faster than "fft" (or zero if "pslr" is
+ * always slower).
+ *
+ * Then, the same numbers of longitudes cover only half of the circle, so FFT
+ * cannot be applied.  Compared are
+ *
+ * * "czt": the synthesis transforms all the latitudes by the chirp-z
+ *   transform (a tiny "charm_glob_shs_grd_czt_factor"),
+ *
+ * * "pslr": the synthesis transforms all the latitudes by the PSLR algorithm
+ *   ("charm_glob_shs_grd_czt_factor = 0").
+ *
+ * For each case, printed is also "(nmax + 1) * nlon / (log2(len) * len)"
+ * with "len = nlon + nmax", which approximates the length of the FFTs of the
+ * chirp-z transform.  A suitable value of "charm_glob_shs_grd_czt_factor" on
+ * your hardware is the smallest such value, for which "czt" is faster than
+ * "pslr".
+ *
+ * The outputs are saved to "data/output/bench-pslr.txt" (double precision),
+ * "benchf-pslr.txt" (single precision) or "benchq-pslr.txt" (quadruple
+ * precision).  The columns are the number of longitudes, the maximum harmonic
+ * degree, "(nmax + 1) / log2(nlon)", the wall-clock times of "fft" and
+ * "pslr" and the speedup of the latter.  The rows of the regional grids
+ * follow with the columns "nlon", "nmax", "(nmax + 1) * nlon / (log2(len) *
+ * len)", the wall-clock times of "czt" and "pslr" and the speedup of the
+ * former. */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Number of grid latitudes */
+#undef NLAT
+#define NLAT (64UL)
+
+
+/* Tested numbers of grid longitudes */
+#undef NNLON
+#define NNLON (4)
+const size_t NLON[NNLON] = {256, 1024, 4096, 16384};
+
+
+/* Tested maximum harmonic degrees */
+#undef NNMAX
+#define NNMAX (6)
+const unsigned long NMAX[NNMAX] = {2, 5, 10, 20, 40, 80};
+
+
+/* Number of repetitions of each test.  The shortest time is taken. */
+#undef NREP
+#define NREP 3
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns "floor(log2(n))" */
+static unsigned long log2_int(size_t n)
+{
+    unsigned long l = 0;
+    for (; n > 1; n /= 2)
+        l++;
+
+
+    return l;
+}
+
+
+
+
+
+
+/* Returns the wall-clock time of the synthesis of "shcs" up to degree "nmax"
+ * at "pnt" with "pslr_factor" and "czt_factor" assigned to
+ * "charm_glob_shs_grd_pslr_factor" and "charm_glob_shs_grd_czt_factor",
+ * respectively */
+static double time_synthesis(const CHARM(point) *pnt,
+                             const CHARM(shc) *shcs,
+                             unsigned long nmax,
+                             REAL pslr_factor,
+                             REAL czt_factor,
+                             REAL *f,
+                             CHARM(err) *err)
+{
+#if HAVE_CLOCK_GETTIME
+    struct timespec t1, t2;
+#endif
+    double elapsed, best = -1.0;
+
+
+    CHARM(glob_shs_grd_pslr_factor) = pslr_factor;
+    CHARM(glob_shs_grd_czt_factor)  = czt_factor;
+    for (int rep = 0; rep < NREP; rep++)
+    {
+#if HAVE_CLOCK_GETTIME
+        clock_gettime(CLOCK_REALTIME, &t1);
+#endif
+        CHARM(shs_point)(pnt, shcs, nmax, f, err);
+        CHARM(err_handler)(err, 1);
+#if HAVE_CLOCK_GETTIME
+        clock_gettime(CLOCK_REALTIME, &t2);
+        elapsed = (double)(t2.tv_sec - t1.tv_sec) +
+                  (double)(t2.tv_nsec - t1.tv_nsec) * 1.0e-9;
+#else
+        elapsed = 0.0;
+#endif
+        if (best < 0.0 || elapsed < best)
+            best = elapsed;
+    }
+
+
+    return best;
+}
+
+
+
+
+
+
+int main(void)
+{
+    /* Data folder to save the outputs of the benchmark */
+    char path[] = "../data/output";
+
+
+    /* Initialize the error structure */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the error structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Open the file stream to save the outputs */
+#undef NSTR
+#define NSTR (2048)
+    char file_pslr[NSTR];
+#undef PSLR_FILE
+#if CHARM_FLOAT
+#   define PSLR_FILE "%s/benchf-pslr.txt"
+#elif CHARM_QUAD
+#   define PSLR_FILE "%s/benchq-pslr.txt"
+#else
+#   define PSLR_FILE "%s/bench-pslr.txt"
+#endif
+    snprintf(file_pslr, NSTR, PSLR_FILE, path);
+    FILE *fid_pslr = fopen(file_pslr, "w");
+    if (fid_pslr == NULL)
+    {
+        fprintf(stderr, "Failed to open the output file.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Random coefficients */
+    unsigned long nmax_max = NMAX[NNMAX - 1];
+    CHARM(shc) *shcs = CHARM(shc_malloc)(nmax_max, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the shc structure.\n");
+        exit(CHARM_FAILURE);
+    }
+    srand(1);
+    for (size_t i = 0; i < shcs->nc; i++)
+    {
+        shcs->c[0][i] = (REAL)rand() / (REAL)RAND_MAX - PREC(0.5);
+        shcs->s[0][i] = (REAL)rand() / (REAL)RAND_MAX - PREC(0.5);
+    }
+
+
+    REAL *f = (REAL *)malloc(NLAT * NLON[NNLON - 1] * sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "Failed to initialize an array.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    REAL pslr_factor = CHARM(glob_shs_grd_pslr_factor);
+    REAL czt_factor  = CHARM(glob_shs_grd_czt_factor);
+
+
+    printf("\n\n");
+    printf("Number of grid latitudes: %lu\n\n", NLAT);
+
+
+    for (size_t j = 0; j < NNLON; j++)
+    {
+        /* Grid with equally spaced longitudes over the full circle, so that
+         * FFT can be applied */
+        CHARM(point) *pnt = CHARM(crd_point_malloc)(CHARM_CRD_POINT_GRID,
+                                                    NLAT, NLON[j]);
+        if (pnt == NULL)
+        {
+            fprintf(stderr, "Failed to initialize the point structure.\n");
+            exit(CHARM_FAILURE);
+        }
+        for (size_t i = 0; i < NLAT; i++)
+        {
+            pnt->lat[i] = PI_2 - (REAL)(i + 1) * PI / (REAL)(NLAT + 1);
+            pnt->r[i]   = shcs->r;
+        }
+        for (size_t i = 0; i < NLON[j]; i++)
+            pnt->lon[i] = (REAL)i * PREC(2.0) * PI / (REAL)NLON[j];
+
+
+        unsigned long log2_nlon = log2_int(NLON[j]);
+
+
+        for (size_t i = 0; i < NNMAX; i++)
+        {
+            double t_fft  = time_synthesis(pnt, shcs, NMAX[i], PREC(0.0),
+                                           PREC(0.0), f, err);
+            double t_pslr = time_synthesis(pnt, shcs, NMAX[i], PREC(1.0e9),
+                                           PREC(0.0), f, err);
+            double ratio  = (double)(NMAX[i] + 1) / (double)log2_nlon;
+
+
+            printf("    nlon: %6zu, nmax: %3lu, (nmax + 1) / log2(nlon): "
+                   "%5.2f, fft: %0.6e s, pslr: %0.6e s, speedup: %0.2f\n",
+                   NLON[j], NMAX[i], ratio, t_fft, t_pslr,
+                   (t_pslr > 0.0) ? t_fft / t_pslr : 0.0);
+            fprintf(fid_pslr, "%zu %lu %0.17e %0.17e %0.17e %0.17e\n",
+                    NLON[j], NMAX[i], ratio, t_fft, t_pslr,
+                    (t_pslr > 0.0) ? t_fft / t_pslr : 0.0);
+        }
+
+
+        CHARM(crd_point_free)(pnt);
+    }
+
+
+    printf("\n");
+    for (size_t j = 0; j < NNLON; j++)
+    {
+        /* Grid with equally spaced longitudes over half of the circle, so
+         * that FFT cannot be applied */
+        CHARM(point) *pnt = CHARM(crd_point_malloc)(CHARM_CRD_POINT_GRID,
+                                                    NLAT, NLON[j]);
+        if (pnt == NULL)
+        {
+            fprintf(stderr, "Failed to initialize the point structure.\n");
+            exit(CHARM_FAILURE);
+        }
+        for (size_t i = 0; i < NLAT; i++)
+        {
+            pnt->lat[i] = PI_2 - (REAL)(i + 1) * PI / (REAL)(NLAT + 1);
+            pnt->r[i]   = shcs->r;
+        }
+        for (size_t i = 0; i < NLON[j]; i++)
+            pnt->lon[i] = (REAL)i * PI / (REAL)NLON[j];
+
+
+        for (size_t i = 0; i < NNMAX; i++)
+        {
+            size_t len    = NLON[j] + NMAX[i];
+            double t_czt  = time_synthesis(pnt, shcs, NMAX[i], PREC(0.0),
+                                           PREC(1.0e-9), f, err);
+            double t_pslr = time_synthesis(pnt, shcs, NMAX[i], PREC(0.0),
+                                           PREC(0.0), f, err);
+            double ratio  = (double)(NMAX[i] + 1) * (double)NLON[j] /
+                            ((double)log2_int(len) * (double)len);
+
+
+            printf("    nlon: %6zu, nmax: %3lu, (nmax + 1) * nlon / "
+                   "(log2(len) * len): %5.2f, czt: %0.6e s, "
+                   "pslr: %0.6e s, speedup: %0.2f\n",
+                   NLON[j], NMAX[i], ratio, t_czt, t_pslr,
+                   (t_czt > 0.0) ? t_pslr / t_czt : 0.0);
+            fprintf(fid_pslr, "%zu %lu %0.17e %0.17e %0.17e %0.17e\n",
+                    NLON[j], NMAX[i], ratio, t_czt, t_pslr,
+                    (t_czt > 0.0) ? t_pslr / t_czt : 0.0);
+        }
+
+
+        CHARM(crd_point_free)(pnt);
+    }
+
+
+    CHARM(glob_shs_grd_pslr_factor) = pslr_factor;
+    CHARM(glob_shs_grd_czt_factor)  = czt_factor;
+    free(f);
+    fclose(fid_pslr);
+    CHARM(shc_free)(shcs);
+    CHARM(err_free)(err);
+
+
+    printf("Done.\n");
+#if !HAVE_CLOCK_GETTIME
+    printf("WARNING: The \"clock_gettime\" function was not found "
+           "during the compilation of CHarm, so the benchmark "
+           "program couldn't measure the computation time.\n");
+#endif
+    return 0;
+}
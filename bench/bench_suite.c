@@ -0,0 +1,811 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../src/prec.h"
+#include "../src/misc/misc_fprintf_real.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* This program benchmarks the public transforms of CHarm and saves the results
+ * in a machine-readable JSON file, so that the performance can be tracked
+ * across releases of CHarm (see "compare-bench-suite.py").
+ *
+ * Benchmarked are
+ *
+ * * "charm_shs_point" with scattered points,
+ *
+ * * "charm_shs_point_grad1" and "charm_shs_point_grad2" with scattered
+ *   points,
+ *
+ * * "charm_shs_cell" and "charm_sha_cell" with a grid of cells,
+ *
+ * * "charm_shs_cell_isurf",
+ *
+ * * "charm_gfm_global_density_const",
+ *
+ * * "charm_leg_pnmj_coeffs",
+ *
+ * * "charm_shc_read_bin", "charm_shc_read_tbl", "charm_shc_read_dov",
+ *   "charm_shc_read_mtx" and "charm_shc_read_gfc".
+ *
+ * Each function is executed "NREP" times and the shortest wall-clock time is
+ * taken.  The functions that are parallelized using OpenMP are timed with the
+ * number of threads doubled from "1" up to the default number of threads of
+ * the OpenMP runtime (e.g., "OMP_NUM_THREADS"), which is always included.
+ * The readers of spherical harmonic coefficients are executed with a single
+ * thread only.
+ *
+ * For each run, the following is reported:
+ *
+ * * the wall-clock time,
+ *
+ * * the speedup with respect to a single thread,
+ *
+ * * an estimate of the floating point performance in GFLOP/s.  The number of
+ *   floating point operations is estimated from the dominating loops over
+ *   harmonic degrees and orders, so the value is a rough figure that is
+ *   useful to compare builds and releases of CHarm rather than an exact
+ *   measure.  For the functions without a meaningful estimate, "null" is
+ *   written,
+ *
+ * * the peak resident set size of the process in kiB.  On Linux, the peak is
+ *   reset before each function is executed if the kernel allows it, so the
+ *   value includes the input and output data of the benchmarked function,
+ *   but not the memory that was freed before.  On other systems, "null" is
+ *   written.
+ *
+ * The outputs are saved to "data/output/bench-suite.json" (double
+ * precision), "benchf-suite.json" (single precision) or "benchq-suite.json"
+ * (quadruple precision). */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Number of repetitions of each test.  The shortest time is taken. */
+#undef NREP
+#define NREP 3
+
+
+/* Maximum harmonic degrees and sizes of the problems */
+#undef NMAX_SCTR
+#define NMAX_SCTR (360UL)
+#undef NPOINT_SCTR
+#define NPOINT_SCTR (5000)
+#undef NMAX_GRAD
+#define NMAX_GRAD (180UL)
+#undef NPOINT_GRAD
+#define NPOINT_GRAD (2000)
+#undef NMAX_CELL
+#define NMAX_CELL (360UL)
+#undef NMAX_ISURF
+#define NMAX_ISURF (15UL)
+#undef NMAX_GFM
+#define NMAX_GFM (60UL)
+#undef PMAX_GFM
+#define PMAX_GFM (4U)
+#undef NMAX_PNMJ
+#define NMAX_PNMJ (300UL)
+#undef NMAX_SHC
+#define NMAX_SHC (500UL)
+
+
+/* Approximate numbers of floating point operations per harmonic degree and
+ * order and per point/latitude */
+#undef FLOP_POINT
+#define FLOP_POINT (8.0)
+#undef FLOP_GRAD1
+#define FLOP_GRAD1 (20.0)
+#undef FLOP_GRAD2
+#define FLOP_GRAD2 (36.0)
+#undef FLOP_CELL
+#define FLOP_CELL (16.0)
+
+
+/* Functions to be benchmarked */
+enum
+{
+    SHS_POINT_SCTR,
+    SHS_POINT_GRAD1,
+    SHS_POINT_GRAD2,
+    SHS_CELL,
+    SHA_CELL,
+    SHS_CELL_ISURF,
+    GFM_GLOBAL_DENSITY_CONST,
+    LEG_PNMJ_COEFFS,
+    SHC_READ_BIN,
+    SHC_READ_TBL,
+    SHC_READ_DOV,
+    SHC_READ_MTX,
+    SHC_READ_GFC,
+    NCASE
+};
+
+
+#undef NSTR
+#define NSTR (2048)
+
+
+#undef FORMAT
+#if CHARM_FLOAT
+#   define FORMAT "%0.8e"
+#elif CHARM_QUAD
+#   define FORMAT "%0.34Qe"
+#else
+#   define FORMAT "%0.17e"
+#endif
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Description of a benchmark case */
+typedef struct
+{
+    /* Name of the benchmarked function */
+    const char *name;
+
+
+    /* Maximum harmonic degree */
+    unsigned long nmax;
+
+
+    /* If non-zero, the function is parallelized using OpenMP */
+    int parallel;
+
+
+    /* Approximate number of floating point operations or a non-positive value
+     * if not available */
+    double flop;
+} bench_case;
+
+
+
+
+
+
+/* Inputs and outputs of the benchmarked functions */
+typedef struct
+{
+    CHARM(shc) *shcs_sctr;
+    CHARM(shc) *shcs_grad;
+    CHARM(shc) *shcs_cell;
+    CHARM(shc) *shcs_cell_out;
+    CHARM(shc) *shcs_isurf;
+    CHARM(shc) *shcs_topo;
+    CHARM(shc) *shcs_shape;
+    CHARM(shc) *shcs_gfm_out;
+    CHARM(shc) *shcs_file;
+    CHARM(point) *sctr;
+    CHARM(point) *sctr_grad;
+    CHARM(cell) *cell;
+    CHARM(cell) *cell_isurf;
+    CHARM(pnmj) *pnmj;
+    REAL *f_sctr;
+    REAL *f_grad[6];
+    REAL *f_cell;
+    REAL *f_isurf;
+    char file[5][NSTR];
+} bench_data;
+
+
+
+
+
+
+/* Returns the current wall-clock time in seconds */
+static double wtime(void)
+{
+#if HAVE_CLOCK_GETTIME
+    struct timespec t;
+    clock_gettime(CLOCK_REALTIME, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1.0e-9;
+#else
+    return 0.0;
+#endif
+}
+
+
+
+
+
+
+/* Resets the peak resident set size of the process if supported */
+static void peak_rss_reset(void)
+{
+#if defined(__linux__)
+    FILE *fid = fopen("/proc/self/clear_refs", "w");
+    if (fid == NULL)
+        return;
+    fprintf(fid, "5");
+    fclose(fid);
+#endif
+    return;
+}
+
+
+
+
+
+
+/* Returns the peak resident set size of the process in kiB or "-1" if not
+ * available */
+static long peak_rss(void)
+{
+    long rss = -1;
+
+
+#if defined(__linux__)
+    char line[NSTR];
+    FILE *fid = fopen("/proc/self/status", "r");
+    if (fid == NULL)
+        return rss;
+
+
+    while (fgets(line, NSTR, fid) != NULL)
+    {
+        if (strncmp(line, "VmHWM:", 6) == 0)
+        {
+            rss = strtol(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(fid);
+#endif
+
+
+    return rss;
+}
+
+
+
+
+
+
+/* Returns spherical harmonic coefficients with pseudo-random values that
+ * decrease with the harmonic degree.  The "c00" coefficient is set to "c00"
+ * and the amplitude of the remaining coefficients is controlled by
+ * "scale". */
+static CHARM(shc) *shc_random(unsigned long nmax,
+                              REAL c00,
+                              REAL scale)
+{
+    CHARM(shc) *shcs = CHARM(shc_calloc)(nmax, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the shc structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        for (unsigned long n = m; n <= nmax; n++)
+        {
+            REAL amp = scale / (REAL)((n + 1) * (n + 1));
+            shcs->c[m][n - m] = amp * (PREC(-1.0) + (REAL)rand() /
+                                       ((REAL)RAND_MAX / PREC(2.0)));
+            if (m > 0)
+                shcs->s[m][n - m] = amp * (PREC(-1.0) + (REAL)rand() /
+                                           ((REAL)RAND_MAX / PREC(2.0)));
+        }
+    }
+    shcs->c[0][0] = c00;
+
+
+    return shcs;
+}
+
+
+
+
+
+
+/* Returns a grid of cells covering the whole sphere */
+static CHARM(cell) *cell_grid(unsigned long nmax)
+{
+    size_t nlat = nmax + 1;
+    size_t nlon = 2 * nmax + 2;
+
+
+    CHARM(cell) *grd = CHARM(crd_cell_calloc)(CHARM_CRD_CELL_GRID, nlat,
+                                              nlon);
+    if (grd == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the cell structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    for (size_t i = 0; i < nlat; i++)
+    {
+        grd->latmin[i] = PI_2 - ((REAL)(i + 1) / (REAL)nlat) * PI;
+        grd->latmax[i] = PI_2 - ((REAL)i / (REAL)nlat) * PI;
+        grd->r[i]      = PREC(1.0);
+    }
+    for (size_t j = 0; j < nlon; j++)
+    {
+        grd->lonmin[j] = ((REAL)j / (REAL)nlon) * PREC(2.0) * PI;
+        grd->lonmax[j] = ((REAL)(j + 1) / (REAL)nlon) * PREC(2.0) * PI;
+    }
+
+
+    return grd;
+}
+
+
+
+
+
+
+/* Returns "npoint" pseudo-random scattered points on the unit sphere */
+static CHARM(point) *point_sctr(size_t npoint)
+{
+    CHARM(point) *sctr = CHARM(crd_point_calloc)(CHARM_CRD_POINT_SCATTERED,
+                                                 npoint, npoint);
+    if (sctr == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the point structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    for (size_t i = 0; i < npoint; i++)
+    {
+        sctr->lat[i] = PI_2 - PI * ((REAL)rand() / (REAL)RAND_MAX);
+        sctr->lon[i] = PREC(2.0) * PI * ((REAL)rand() / (REAL)RAND_MAX);
+        sctr->r[i]   = PREC(1.0);
+    }
+
+
+    return sctr;
+}
+
+
+
+
+
+
+/* Returns a pointer to an array of "n" "REAL"s */
+static REAL *real_malloc(size_t n)
+{
+    REAL *a = (REAL *)calloc(n, sizeof(REAL));
+    if (a == NULL)
+    {
+        fprintf(stderr, "calloc failure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    return a;
+}
+
+
+
+
+
+
+/* Writes "shcs" to a gfc file.  "charm_shc_write_*" does not support gfc
+ * files, so the file is written here. */
+static void shc_write_gfc(const CHARM(shc) *shcs,
+                          const char *pathname)
+{
+    FILE *fid = fopen(pathname, "w");
+    if (fid == NULL)
+    {
+        fprintf(stderr, "Failed to open the output file.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    fprintf(fid, "product_type              gravity_field\n");
+    fprintf(fid, "modelname                 bench-suite\n");
+    fprintf(fid, "earth_gravity_constant    ");
+    CHARM(misc_fprintf_real)(fid, FORMAT, shcs->mu);
+    fprintf(fid, "\nradius                    ");
+    CHARM(misc_fprintf_real)(fid, FORMAT, shcs->r);
+    fprintf(fid, "\n");
+    fprintf(fid, "max_degree                %lu\n", shcs->nmax);
+    fprintf(fid, "errors                    no\n");
+    fprintf(fid, "\n");
+    fprintf(fid, "key    L    M         C                   S\n");
+    fprintf(fid, "end_of_head =========================================\n");
+
+
+    for (unsigned long n = 0; n <= shcs->nmax; n++)
+    {
+        for (unsigned long m = 0; m <= n; m++)
+        {
+            fprintf(fid, "gfc %5lu %5lu ", n, m);
+            CHARM(misc_fprintf_real)(fid, FORMAT, shcs->c[m][n - m]);
+            fprintf(fid, " ");
+            CHARM(misc_fprintf_real)(fid, FORMAT, shcs->s[m][n - m]);
+            fprintf(fid, "\n");
+        }
+    }
+
+
+    fclose(fid);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Approximate number of floating point operations of
+ * "charm_leg_pnmj_coeffs" */
+static double flop_pnmj(unsigned long nmax)
+{
+    double flop = 0.0;
+    for (unsigned long n = 0; n <= nmax; n++)
+        flop += 4.0 * (double)(n + 1) * (double)(n / 2 + 1);
+
+
+    return flop;
+}
+
+
+
+
+
+
+/* Executes the benchmark case "id" */
+static void run(int id,
+                bench_data *d,
+                CHARM(err) *err)
+{
+    switch (id)
+    {
+    case SHS_POINT_SCTR:
+        CHARM(shs_point)(d->sctr, d->shcs_sctr, NMAX_SCTR, d->f_sctr, err);
+        break;
+    case SHS_POINT_GRAD1:
+        CHARM(shs_point_grad1)(d->sctr_grad, d->shcs_grad, NMAX_GRAD,
+                               d->f_grad, err);
+        break;
+    case SHS_POINT_GRAD2:
+        CHARM(shs_point_grad2)(d->sctr_grad, d->shcs_grad, NMAX_GRAD,
+                               d->f_grad, err);
+        break;
+    case SHS_CELL:
+        CHARM(shs_cell)(d->cell, d->shcs_cell, NMAX_CELL, d->f_cell, err);
+        break;
+    case SHA_CELL:
+        CHARM(sha_cell)(d->cell, d->f_cell, NMAX_CELL, CHARM_SHA_CELL_AQ,
+                        d->shcs_cell_out, err);
+        break;
+    case SHS_CELL_ISURF:
+        CHARM(shs_cell_isurf)(d->cell_isurf, d->shcs_isurf, NMAX_ISURF,
+                              d->shcs_topo, NMAX_ISURF, NMAX_ISURF,
+                              NMAX_ISURF, d->f_isurf, err);
+        break;
+    case GFM_GLOBAL_DENSITY_CONST:
+        CHARM(gfm_global_density_const)(d->shcs_shape, NMAX_GFM, PREC(1.0),
+                                        PREC(1.0), PREC(1.0), PREC(1.0), 1,
+                                        PMAX_GFM, NMAX_GFM, NULL, NULL, NULL,
+                                        d->shcs_gfm_out, err);
+        break;
+    case LEG_PNMJ_COEFFS:
+        CHARM(leg_pnmj_coeffs)(d->pnmj, NMAX_PNMJ, err);
+        break;
+    case SHC_READ_BIN:
+        CHARM(shc_read_bin)(d->file[0], NMAX_SHC, d->shcs_file, err);
+        break;
+    case SHC_READ_TBL:
+        CHARM(shc_read_tbl)(d->file[1], NMAX_SHC, d->shcs_file, err);
+        break;
+    case SHC_READ_DOV:
+        CHARM(shc_read_dov)(d->file[2], NMAX_SHC, d->shcs_file, err);
+        break;
+    case SHC_READ_MTX:
+        CHARM(shc_read_mtx)(d->file[3], NMAX_SHC, d->shcs_file, err);
+        break;
+    case SHC_READ_GFC:
+        CHARM(shc_read_gfc)(d->file[4], NMAX_SHC, NULL, d->shcs_file, err);
+        break;
+    default:
+        fprintf(stderr, "Unknown benchmark case.\n");
+        exit(CHARM_FAILURE);
+    }
+    CHARM(err_handler)(err, 1);
+
+
+    return;
+}
+
+
+
+
+
+
+int main(void)
+{
+    /* Data folder to save the outputs of the benchmark */
+    char path[] = "../data/output";
+
+
+    /* Maximum number of OpenMP threads */
+#if HAVE_OPENMP
+    int nthreads_max = omp_get_max_threads();
+#else
+    int nthreads_max = 1;
+#endif
+
+
+    /* Initialize the error structure */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the error structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Benchmark cases */
+    /* --------------------------------------------------------------------- */
+    double nm_sctr = (double)(NMAX_SCTR + 1) * (double)(NMAX_SCTR + 2) / 2.0;
+    double nm_grad = (double)(NMAX_GRAD + 1) * (double)(NMAX_GRAD + 2) / 2.0;
+    double nm_cell = (double)(NMAX_CELL + 1) * (double)(NMAX_CELL + 2) / 2.0;
+
+
+    bench_case cases[NCASE] =
+    {
+        {"shs_point_sctr", NMAX_SCTR, 1,
+         FLOP_POINT * nm_sctr * (double)NPOINT_SCTR},
+        {"shs_point_grad1", NMAX_GRAD, 1,
+         FLOP_GRAD1 * nm_grad * (double)NPOINT_GRAD},
+        {"shs_point_grad2", NMAX_GRAD, 1,
+         FLOP_GRAD2 * nm_grad * (double)NPOINT_GRAD},
+        {"shs_cell", NMAX_CELL, 1,
+         FLOP_CELL * nm_cell * (double)(NMAX_CELL + 1)},
+        {"sha_cell", NMAX_CELL, 1,
+         FLOP_CELL * nm_cell * (double)(NMAX_CELL + 1)},
+        {"shs_cell_isurf", NMAX_ISURF, 1, 0.0},
+        {"gfm_global_density_const", NMAX_GFM, 1, 0.0},
+        {"leg_pnmj_coeffs", NMAX_PNMJ, 1, flop_pnmj(NMAX_PNMJ)},
+        {"shc_read_bin", NMAX_SHC, 0, 0.0},
+        {"shc_read_tbl", NMAX_SHC, 0, 0.0},
+        {"shc_read_dov", NMAX_SHC, 0, 0.0},
+        {"shc_read_mtx", NMAX_SHC, 0, 0.0},
+        {"shc_read_gfc", NMAX_SHC, 0, 0.0}
+    };
+    /* --------------------------------------------------------------------- */
+
+
+    /* Prepare the inputs and outputs */
+    /* --------------------------------------------------------------------- */
+    bench_data d;
+    srand(1);
+
+
+    d.shcs_sctr     = shc_random(NMAX_SCTR, PREC(1.0), PREC(1.0));
+    d.shcs_grad     = shc_random(NMAX_GRAD, PREC(1.0), PREC(1.0));
+    d.shcs_cell     = shc_random(NMAX_CELL, PREC(1.0), PREC(1.0));
+    d.shcs_cell_out = shc_random(NMAX_CELL, PREC(1.0), PREC(0.0));
+    d.shcs_isurf    = shc_random(NMAX_ISURF, PREC(1.0), PREC(1.0));
+    d.shcs_topo     = shc_random(NMAX_ISURF, PREC(1.0), PREC(0.001));
+    d.shcs_shape    = shc_random(NMAX_GFM, PREC(1.0), PREC(0.001));
+    d.shcs_gfm_out  = shc_random(NMAX_GFM, PREC(1.0), PREC(0.0));
+    d.shcs_file     = shc_random(NMAX_SHC, PREC(1.0), PREC(1.0));
+
+
+    d.sctr      = point_sctr(NPOINT_SCTR);
+    d.sctr_grad = point_sctr(NPOINT_GRAD);
+    d.f_sctr    = real_malloc(NPOINT_SCTR);
+    for (int i = 0; i < 6; i++)
+        d.f_grad[i] = real_malloc(NPOINT_GRAD);
+
+
+    d.cell       = cell_grid(NMAX_CELL);
+    d.cell_isurf = cell_grid(NMAX_ISURF);
+    d.f_cell     = real_malloc(d.cell->ncell);
+    d.f_isurf    = real_malloc(d.cell_isurf->ncell);
+
+
+    d.pnmj = CHARM(leg_pnmj_malloc)(NMAX_PNMJ, CHARM_LEG_PMNJ);
+    if (d.pnmj == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the pnmj structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Files with spherical harmonic coefficients to be read */
+    const char *ext[5] = {"bin", "tbl", "dov", "mtx", "gfc"};
+    for (int i = 0; i < 5; i++)
+        snprintf(d.file[i], NSTR, "%s/bench-suite-shcs.%s", path, ext[i]);
+
+
+    CHARM(shc_write_bin)(d.shcs_file, NMAX_SHC, d.file[0], err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shc_write_tbl)(d.shcs_file, NMAX_SHC, FORMAT, CHARM_SHC_WRITE_N,
+                         d.file[1], err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shc_write_dov)(d.shcs_file, NMAX_SHC, FORMAT, CHARM_SHC_WRITE_N,
+                         d.file[2], err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shc_write_mtx)(d.shcs_file, NMAX_SHC, FORMAT, d.file[3], err);
+    CHARM(err_handler)(err, 1);
+    shc_write_gfc(d.shcs_file, d.file[4]);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Open the file stream to save the outputs */
+    /* --------------------------------------------------------------------- */
+    char file_json[NSTR];
+#undef JSON_FILE
+#if CHARM_FLOAT
+#   define JSON_FILE "%s/benchf-suite.json"
+#elif CHARM_QUAD
+#   define JSON_FILE "%s/benchq-suite.json"
+#else
+#   define JSON_FILE "%s/bench-suite.json"
+#endif
+    snprintf(file_json, NSTR, JSON_FILE, path);
+    FILE *fid_json = fopen(file_json, "w");
+    if (fid_json == NULL)
+    {
+        fprintf(stderr, "Failed to open the output file.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    fprintf(fid_json, "{\n");
+    fprintf(fid_json, "  \"version\": \"%s\",\n",
+            CHARM(misc_get_version)());
+    fprintf(fid_json, "  \"precision\": %d,\n",
+            CHARM(misc_buildopt_precision)());
+    fprintf(fid_json, "  \"simd\": %d,\n", CHARM(misc_buildopt_simd)());
+    fprintf(fid_json, "  \"simd_vector_size\": %d,\n",
+            CHARM(misc_buildopt_simd_vector_size)());
+    fprintf(fid_json, "  \"openmp\": %d,\n",
+            CHARM(misc_buildopt_omp_charm)());
+    fprintf(fid_json, "  \"mpi\": %d,\n", CHARM(misc_buildopt_mpi)());
+    fprintf(fid_json, "  \"max_threads\": %d,\n", nthreads_max);
+    fprintf(fid_json, "  \"repetitions\": %d,\n", NREP);
+    fprintf(fid_json, "  \"results\": [");
+    /* --------------------------------------------------------------------- */
+
+
+    printf("\n\n");
+    printf("Maximum number of OpenMP threads: %d\n\n", nthreads_max);
+
+
+    /* Loop over the benchmark cases */
+    /* --------------------------------------------------------------------- */
+    int first = 1;
+    for (int c = 0; c < NCASE; c++)
+    {
+        printf("%s (maximum harmonic degree %lu)\n", cases[c].name,
+               cases[c].nmax);
+
+
+        double best1 = 0.0;
+        for (int nthreads = 1; ; nthreads *= 2)
+        {
+            if (nthreads > nthreads_max)
+                nthreads = nthreads_max;
+#if HAVE_OPENMP
+            omp_set_num_threads(nthreads);
+#endif
+
+
+            peak_rss_reset();
+            double best = -1.0;
+            for (int rep = 0; rep < NREP; rep++)
+            {
+                double t1 = wtime();
+                run(c, &d, err);
+                double elapsed = wtime() - t1;
+                if (best < 0.0 || elapsed < best)
+                    best = elapsed;
+            }
+            long rss = peak_rss();
+            if (nthreads == 1)
+                best1 = best;
+
+
+            double speedup = (best > 0.0) ? best1 / best : 0.0;
+            double gflops  = (best > 0.0 && cases[c].flop > 0.0) ?
+                             cases[c].flop / best * 1.0e-9 : -1.0;
+
+
+            printf("    Threads: %3d, time: %0.6e s, speedup: %0.2f",
+                   nthreads, best, speedup);
+            if (gflops >= 0.0)
+                printf(", GFLOP/s: %0.3f", gflops);
+            if (rss >= 0)
+                printf(", peak RSS: %ld kiB", rss);
+            printf("\n");
+
+
+            fprintf(fid_json, "%s\n    {\"name\": \"%s\", \"nmax\": %lu, "
+                    "\"threads\": %d, \"time\": %0.9e, \"speedup\": %0.6f, ",
+                    first ? "" : ",", cases[c].name, cases[c].nmax, nthreads,
+                    best, speedup);
+            if (gflops >= 0.0)
+                fprintf(fid_json, "\"gflops\": %0.6f, ", gflops);
+            else
+                fprintf(fid_json, "\"gflops\": null, ");
+            if (rss >= 0)
+                fprintf(fid_json, "\"peak_rss_kib\": %ld}", rss);
+            else
+                fprintf(fid_json, "\"peak_rss_kib\": null}");
+            first = 0;
+
+
+            if (nthreads == nthreads_max || !cases[c].parallel)
+                break;
+        }
+
+
+        printf("\n");
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    fprintf(fid_json, "\n  ]\n}\n");
+    fclose(fid_json);
+
+
+    /* Free the memory */
+    /* --------------------------------------------------------------------- */
+#if HAVE_OPENMP
+    omp_set_num_threads(nthreads_max);
+#endif
+    for (int i = 0; i < 5; i++)
+        remove(d.file[i]);
+
+
+    CHARM(shc_free)(d.shcs_sctr);
+    CHARM(shc_free)(d.shcs_grad);
+    CHARM(shc_free)(d.shcs_cell);
+    CHARM(shc_free)(d.shcs_cell_out);
+    CHARM(shc_free)(d.shcs_isurf);
+    CHARM(shc_free)(d.shcs_topo);
+    CHARM(shc_free)(d.shcs_shape);
+    CHARM(shc_free)(d.shcs_gfm_out);
+    CHARM(shc_free)(d.shcs_file);
+    CHARM(crd_point_free)(d.sctr);
+    CHARM(crd_point_free)(d.sctr_grad);
+    CHARM(crd_cell_free)(d.cell);
+    CHARM(crd_cell_free)(d.cell_isurf);
+    CHARM(leg_pnmj_free)(d.pnmj);
+    free(d.f_sctr);
+    for (int i = 0; i < 6; i++)
+        free(d.f_grad[i]);
+    free(d.f_cell);
+    free(d.f_isurf);
+    CHARM(err_free)(err);
+    /* --------------------------------------------------------------------- */
+
+
+    printf("Saved the results to %s.\n", file_json);
+    printf("Done.\n");
+#if !HAVE_CLOCK_GETTIME
+    printf("WARNING: The \"clock_gettime\" function was not found "
+           "during the compilation of CHarm, so the benchmark "
+           "program couldn't measure the computation time.\n");
+#endif
+    return 0;
+}
@@ -0,0 +1,291 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../src/prec.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* This program measures the wall-clock time of "charm_shc_write_tbl" for
+ * a model up to degree "NMAX" with random coefficients.  Compared are
+ *
+ * * "fprintf": the coefficients are printed one by one by "fprintf" with the
+ *   "FORMAT" specifier (the approach of CHarm 0.4.8 and older),
+ *
+ * * "format": "charm_shc_write_tbl" with the "FORMAT" specifier,
+ *
+ * * "shortest": "charm_shc_write_tbl" with the "NULL" specifier, that is,
+ *   with the shortest representation of the coefficients that reads back to
+ *   the same numbers.
+ *
+ * The last two are executed with the number of threads doubled from "1" up
+ * to the default number of threads of the OpenMP runtime.
+ *
+ * The outputs are saved to "data/output/bench-write.txt" (double precision),
+ * "benchf-write.txt" (single precision) or "benchq-write.txt" (quadruple
+ * precision).  The columns are the method, the number of threads, the
+ * wall-clock time and the speedup with respect to "fprintf".
+ *
+ * The text file written by the benchmark has about 3.5 GB for "NMAX = 10800"
+ * and is deleted at the end. */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Maximum harmonic degree of the coefficients */
+#undef NMAX
+#define NMAX (10800UL)
+
+
+/* Number of repetitions of each test.  The shortest time is taken. */
+#undef NREP
+#define NREP 1
+
+
+/* Formatting specifier with enough digits for a round trip */
+#undef FORMAT
+#if CHARM_FLOAT
+#   define FORMAT "%0.8e"
+#elif CHARM_QUAD
+#   define FORMAT "%0.35Qe"
+#else
+#   define FORMAT "%0.16e"
+#endif
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Writes "shcs" in the "tbl" format by printing the coefficients one by one
+ * to the file stream */
+static void write_tbl_fprintf(const CHARM(shc) *shcs,
+                              const char *pathname)
+{
+    FILE *fptr = fopen(pathname, "w");
+    if (fptr == NULL)
+    {
+        fprintf(stderr, "Failed to open the output file.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+#if CHARM_QUAD
+    char cnm[128], snm[128], mu[128], r[128];
+    quadmath_snprintf(mu, sizeof(mu), FORMAT, shcs->mu);
+    quadmath_snprintf(r, sizeof(r), FORMAT, shcs->r);
+    fprintf(fptr, "%lu %s %s\n", shcs->nmax, mu, r);
+#else
+    fprintf(fptr, "%lu " FORMAT " " FORMAT "\n", shcs->nmax, shcs->mu,
+            shcs->r);
+#endif
+
+
+    for (unsigned long m = 0; m <= shcs->nmax; m++)
+    {
+        for (unsigned long n = m; n <= shcs->nmax; n++)
+        {
+            fprintf(fptr, "%lu ", n);
+            fprintf(fptr, "%lu ", m);
+#if CHARM_QUAD
+            quadmath_snprintf(cnm, sizeof(cnm), FORMAT, shcs->c[m][n - m]);
+            quadmath_snprintf(snm, sizeof(snm), FORMAT, shcs->s[m][n - m]);
+            fprintf(fptr, "%s", cnm);
+            fprintf(fptr, "%s", " ");
+            fprintf(fptr, "%s", snm);
+#else
+            fprintf(fptr, FORMAT, shcs->c[m][n - m]);
+            fprintf(fptr, "%s", " ");
+            fprintf(fptr, FORMAT, shcs->s[m][n - m]);
+#endif
+            fprintf(fptr, "%s", "\n");
+        }
+    }
+
+
+    fclose(fptr);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Returns the wall-clock time of writing "shcs" to "pathname" by "method"
+ * ("0" for "fprintf", "1" for "format" and "2" for "shortest") */
+static double time_write(const CHARM(shc) *shcs,
+                         int method,
+                         const char *pathname,
+                         CHARM(err) *err)
+{
+#if HAVE_CLOCK_GETTIME
+    struct timespec t1, t2;
+#endif
+    double elapsed, best = -1.0;
+
+
+    for (int rep = 0; rep < NREP; rep++)
+    {
+#if HAVE_CLOCK_GETTIME
+        clock_gettime(CLOCK_REALTIME, &t1);
+#endif
+        if (method == 0)
+            write_tbl_fprintf(shcs, pathname);
+        else
+        {
+            CHARM(shc_write_tbl)(shcs, shcs->nmax,
+                                 (method == 1) ? FORMAT : NULL,
+                                 CHARM_SHC_WRITE_N, pathname, err);
+            CHARM(err_handler)(err, 1);
+        }
+#if HAVE_CLOCK_GETTIME
+        clock_gettime(CLOCK_REALTIME, &t2);
+        elapsed = (double)(t2.tv_sec - t1.tv_sec) +
+                  (double)(t2.tv_nsec - t1.tv_nsec) * 1.0e-9;
+#else
+        elapsed = 0.0;
+#endif
+        if (best < 0.0 || elapsed < best)
+            best = elapsed;
+    }
+
+
+    return best;
+}
+
+
+
+
+
+
+int main(void)
+{
+    /* Data folder to save the outputs of the benchmark */
+    char path[] = "../data/output";
+
+
+    /* Maximum number of OpenMP threads */
+#if HAVE_OPENMP
+    int nthreads_max = omp_get_max_threads();
+#else
+    int nthreads_max = 1;
+#endif
+
+
+    /* Initialize the error structure */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the error structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Open the file stream to save the outputs */
+#undef NSTR
+#define NSTR (2048)
+    char file_write[NSTR], file_tbl[NSTR];
+#undef WRITE_FILE
+#if CHARM_FLOAT
+#   define WRITE_FILE "%s/benchf-write.txt"
+#elif CHARM_QUAD
+#   define WRITE_FILE "%s/benchq-write.txt"
+#else
+#   define WRITE_FILE "%s/bench-write.txt"
+#endif
+    snprintf(file_write, NSTR, WRITE_FILE, path);
+    snprintf(file_tbl, NSTR, "%s/bench-write-tmp.tbl", path);
+    FILE *fid_write = fopen(file_write, "w");
+    if (fid_write == NULL)
+    {
+        fprintf(stderr, "Failed to open the output file.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Random coefficients */
+    CHARM(shc) *shcs = CHARM(shc_malloc)(NMAX, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the shc structure.\n");
+        exit(CHARM_FAILURE);
+    }
+    srand(1);
+    for (size_t i = 0; i < shcs->nc; i++)
+    {
+        shcs->c[0][i] = (REAL)rand() / (REAL)RAND_MAX - PREC(0.5);
+        shcs->s[0][i] = (REAL)rand() / (REAL)RAND_MAX - PREC(0.5);
+    }
+
+
+    printf("\n\n");
+    printf("Maximum harmonic degree: %lu\n", NMAX);
+    printf("Maximum number of OpenMP threads: %d\n\n", nthreads_max);
+
+
+    const char *method_str[3] = {"fprintf", "format", "shortest"};
+    double best0 = 0.0;
+    for (int method = 0; method < 3; method++)
+    {
+        for (int nthreads = 1; ; nthreads *= 2)
+        {
+            if (nthreads > nthreads_max)
+                nthreads = nthreads_max;
+#if HAVE_OPENMP
+            omp_set_num_threads(nthreads);
+#endif
+
+
+            double best = time_write(shcs, method, file_tbl, err);
+            if (method == 0)
+                best0 = best;
+
+
+            printf("    %-8s threads: %3d, time: %0.6e s, speedup: %0.2f\n",
+                   method_str[method], nthreads, best,
+                   (best > 0.0) ? best0 / best : 0.0);
+            fprintf(fid_write, "%s %d %0.17e %0.17e\n", method_str[method],
+                    nthreads, best, (best > 0.0) ? best0 / best : 0.0);
+
+
+            /* "fprintf" is executed with one thread only */
+            if ((method == 0) || (nthreads == nthreads_max))
+                break;
+        }
+    }
+
+
+#if HAVE_OPENMP
+    omp_set_num_threads(nthreads_max);
+#endif
+    remove(file_tbl);
+    fclose(fid_write);
+    CHARM(shc_free)(shcs);
+    CHARM(err_free)(err);
+
+
+    printf("Done.\n");
+#if !HAVE_CLOCK_GETTIME
+    printf("WARNING: The \"clock_gettime\" function was not found "
+           "during the compilation of CHarm, so the benchmark "
+           "program couldn't measure the computation time.\n");
+#endif
+    return 0;
+}
@@ -0,0 +1,95 @@
+# Program to compare two outputs from the benchmark suite ("make
+# bench-suite"), for instance, from two releases of CHarm.
+
+
+# Import modules
+# -----------------------------------------------------------------------------
+import argparse
+import json
+import sys
+# -----------------------------------------------------------------------------
+
+
+# Parse input arguments
+# -----------------------------------------------------------------------------
+parser = argparse.ArgumentParser(description='Compares two outputs from '
+                                 'the benchmark suite and reports the '
+                                 'changes of the wall-clock times.')
+
+
+parser.add_argument('baseline',
+                    help='JSON file with the baseline results.')
+
+
+parser.add_argument('current',
+                    help='JSON file with the results to be compared with '
+                    'the baseline.')
+
+
+parser.add_argument('--threshold',
+                    '-t',
+                    type=float,
+                    default=0.1,
+                    help='Relative slowdown that is reported as a '
+                    'regression (default: 0.1, that is, 10 %%).')
+
+
+# Parse the arguments
+args = parser.parse_args()
+# -----------------------------------------------------------------------------
+
+
+# Load the results
+# -----------------------------------------------------------------------------
+def load(path):
+    with open(path, 'r') as f:
+        data = json.load(f)
+
+
+    results = {}
+    for r in data['results']:
+        results[(r['name'], r['nmax'], r['threads'])] = r
+
+
+    return data, results
+
+
+base, base_results = load(args.baseline)
+curr, curr_results = load(args.current)
+
+
+print(f'Baseline: version {base["version"]}, precision {base["precision"]}, '
+      f'SIMD {base["simd"]}, threads {base["max_threads"]}')
+print(f'Current:  version {curr["version"]}, precision {curr["precision"]}, '
+      f'SIMD {curr["simd"]}, threads {curr["max_threads"]}')
+print()
+# -----------------------------------------------------------------------------
+
+
+# Compare the wall-clock times
+# -----------------------------------------------------------------------------
+nregress = 0
+print(f'{"Function":<26} {"nmax":>6} {"threads":>7} {"baseline":>12} '
+      f'{"current":>12} {"ratio":>7}')
+for key, r in curr_results.items():
+    if key not in base_results:
+        continue
+
+
+    t0 = base_results[key]['time']
+    t1 = r['time']
+    ratio = t1 / t0 if t0 > 0.0 else float('nan')
+    flag = ''
+    if ratio > 1.0 + args.threshold:
+        flag = '  REGRESSION'
+        nregress += 1
+
+
+    print(f'{key[0]:<26} {key[1]:>6} {key[2]:>7} {t0:>12.4e} {t1:>12.4e} '
+          f'{ratio:>7.3f}{flag}')
+
+
+print()
+print(f'Number of regressions: {nregress}')
+sys.exit(1 if nregress > 0 else 0)
+# -----------------------------------------------------------------------------
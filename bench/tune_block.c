@@ -0,0 +1,317 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../src/prec.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* This program searches for the number of SIMD vectors in latitude blocks of
+ * spherical harmonic synthesis ("SIMD_BLOCK_S") and analysis ("SIMD_BLOCK_A")
+ * that gives the shortest computation time on the current hardware.  To this
+ * end, "charm_shs_point" and "charm_sha_point" are timed with Gauss--Legendre
+ * grids for several maximum harmonic degrees and for several values of
+ * "charm_glob_shs_block_lat_multiplier" and
+ * "charm_glob_sha_block_lat_multiplier".  For each value, the computation
+ * times are normalized by the shortest time obtained for the given maximum
+ * harmonic degree and summed over all the degrees.  The value with the
+ * smallest sum is the winner.
+ *
+ * The program requires CHarm to be compiled with "--enable-runtime-block" (or
+ * "--enable-mpi"), so that the block sizes can be changed at runtime.  The
+ * results are valid for the precision and the SIMD instruction set of the
+ * CHarm build that was used to run the program.  They are printed as the
+ * "--with-simd-block-a" and "--with-simd-block-s" options of the "configure"
+ * script, which write the values into "config.h".  After CHarm is
+ * reconfigured with these options (and, typically, without
+ * "--enable-runtime-block"), the tuned values become compile-time constants.
+ *
+ * The timings and the winning values are saved to
+ * "data/output/tune-block.txt" (double precision), "tune-blockf.txt" (single
+ * precision) or "tune-blockq.txt" (quadruple precision). */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Total number of maximum harmonic degrees, for which the program is
+ * executed. */
+#undef NMAX
+#define NMAX 4
+
+
+/* Total number of the tested block sizes */
+#undef NBLOCK
+#define NBLOCK 6
+
+
+/* Number of repetitions of each test.  The shortest time is taken. */
+#undef NREP
+#define NREP 3
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+#if HAVE_RUNTIME_BLOCK && HAVE_CLOCK_GETTIME
+/* Returns the wall-clock time in seconds of the fastest out of "NREP" runs of
+ * "charm_shs_point" (if "shs" is non-zero) or "charm_sha_point" (if "shs" is
+ * zero). */
+static double run(int shs,
+                  const CHARM(point) *grd,
+                  CHARM(shc) *shcs,
+                  unsigned long nmax,
+                  REAL *f,
+                  CHARM(err) *err)
+{
+    struct timespec t1, t2;
+    double elapsed, best = -1.0;
+
+
+    for (int rep = 0; rep < NREP; rep++)
+    {
+        clock_gettime(CLOCK_REALTIME, &t1);
+        if (shs)
+            CHARM(shs_point)(grd, shcs, nmax, f, err);
+        else
+            CHARM(sha_point)(grd, f, nmax, shcs, err);
+        CHARM(err_handler)(err, 1);
+        clock_gettime(CLOCK_REALTIME, &t2);
+
+
+        elapsed = (double)(t2.tv_sec - t1.tv_sec) +
+                  (double)(t2.tv_nsec - t1.tv_nsec) * 1.0e-9;
+        if (best < 0.0 || elapsed < best)
+            best = elapsed;
+    }
+
+
+    return best;
+}
+
+
+
+
+
+
+/* Returns the index of the block size from "block" with the smallest sum of
+ * normalized computation times "t" over all maximum harmonic degrees */
+static int best_block(double t[NMAX][NBLOCK])
+{
+    double score[NBLOCK] = {0.0};
+    double tmin;
+    int ibest = 0;
+
+
+    for (int i = 0; i < NMAX; i++)
+    {
+        tmin = t[i][0];
+        for (int j = 1; j < NBLOCK; j++)
+            if (t[i][j] < tmin)
+                tmin = t[i][j];
+
+
+        for (int j = 0; j < NBLOCK; j++)
+            score[j] += (tmin > 0.0) ? t[i][j] / tmin : 1.0;
+    }
+
+
+    for (int j = 1; j < NBLOCK; j++)
+        if (score[j] < score[ibest])
+            ibest = j;
+
+
+    return ibest;
+}
+#endif
+
+
+
+
+
+
+int main(void)
+{
+#if !HAVE_RUNTIME_BLOCK
+    printf("The sizes of latitude blocks of this CHarm build are "
+           "compile-time constants and cannot be tuned.  To tune them, "
+           "reconfigure CHarm with \"--enable-runtime-block\", run "
+           "\"make tune-block\" and then reconfigure CHarm again with the "
+           "printed \"--with-simd-block-a\" and \"--with-simd-block-s\" "
+           "options.\n");
+    return 0;
+#elif !HAVE_CLOCK_GETTIME
+    printf("The \"clock_gettime\" function was not found during the "
+           "compilation of CHarm, so the sizes of latitude blocks cannot be "
+           "tuned.\n");
+    return 0;
+#else
+    /* Maximum harmonic degrees, for which the block sizes are tuned */
+    unsigned long nmax_all[NMAX] = {  100,
+                                      250,
+                                      500,
+                                     1000
+                                   };
+
+
+    /* The tested numbers of SIMD vectors in latitude blocks */
+    size_t block[NBLOCK] = {1, 2, 4, 8, 16, 32};
+
+
+    /* Computation times of synthesis and analysis */
+    double t_shs[NMAX][NBLOCK], t_sha[NMAX][NBLOCK];
+
+
+    /* Data folder to save the outputs of the tuning */
+    char path[] = "../data/output";
+
+
+    /* Initialize the error structure */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "Failed to initialize the error structure.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Open the file stream to save the outputs */
+#undef NSTR
+#define NSTR (2048)
+    char file_tune[NSTR];
+#undef TUNE_FILE
+#if CHARM_FLOAT
+#   define TUNE_FILE "%s/tune-blockf.txt"
+#elif CHARM_QUAD
+#   define TUNE_FILE "%s/tune-blockq.txt"
+#else
+#   define TUNE_FILE "%s/tune-block.txt"
+#endif
+    snprintf(file_tune, NSTR, TUNE_FILE, path);
+    FILE *fid_tune = fopen(file_tune, "w");
+    if (fid_tune == NULL)
+    {
+        fprintf(stderr, "Failed to open the output file.\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* The default values of the block sizes to be restored at the end */
+    size_t block_s0 = CHARM(glob_shs_block_lat_multiplier);
+    size_t block_a0 = CHARM(glob_sha_block_lat_multiplier);
+
+
+    printf("\n\n");
+    printf("Precision: %d, SIMD instructions: %d, SIMD vector size: %d\n\n",
+           CHARM(misc_buildopt_precision)(), CHARM(misc_buildopt_simd)(),
+           CHARM(misc_buildopt_simd_vector_size)());
+    fprintf(fid_tune, "# precision %d simd %d simd_vector_size %d\n",
+            CHARM(misc_buildopt_precision)(), CHARM(misc_buildopt_simd)(),
+            CHARM(misc_buildopt_simd_vector_size)());
+    fprintf(fid_tune, "# nmax block time_shs time_sha\n");
+
+
+    /* Loop over all "nmax_all" degrees */
+    for (int i = 0; i < NMAX; i++)
+    {
+        unsigned long nmax = nmax_all[i];
+        printf("Maximum harmonic degree: %lu\n", nmax);
+
+
+        CHARM(shc) *shcs = CHARM(shc_calloc)(nmax, PREC(1.0), PREC(1.0));
+        if (shcs == NULL)
+        {
+            fprintf(stderr, "Failed to initialize the shc structure.\n");
+            exit(CHARM_FAILURE);
+        }
+        srand(1);
+        for (unsigned long m = 0; m <= nmax; m++)
+        {
+            for (unsigned long n = m; n <= nmax; n++)
+            {
+                shcs->c[m][n - m] = PREC(-1.0) + (REAL)rand() /
+                                    ((REAL)RAND_MAX / PREC(2.0));
+                if (m > 0)
+                    shcs->s[m][n - m] = PREC(-1.0) + (REAL)rand() /
+                                        ((REAL)RAND_MAX / PREC(2.0));
+            }
+        }
+
+
+        CHARM(point) *grd = CHARM(crd_point_gl)(nmax, PREC(1.0));
+        if (grd == NULL)
+        {
+            fprintf(stderr, "Failed to compute the Gauss--Legendre grid.\n");
+            exit(CHARM_FAILURE);
+        }
+
+
+        REAL *f = (REAL *)malloc(grd->npoint * sizeof(REAL));
+        if (f == NULL)
+        {
+            fprintf(stderr, "malloc failure.\n");
+            exit(CHARM_FAILURE);
+        }
+
+
+        for (int j = 0; j < NBLOCK; j++)
+        {
+            CHARM(glob_shs_block_lat_multiplier) = block[j];
+            CHARM(glob_sha_block_lat_multiplier) = block[j];
+
+
+            t_shs[i][j] = run(1, grd, shcs, nmax, f, err);
+            t_sha[i][j] = run(0, grd, shcs, nmax, f, err);
+
+
+            printf("    Block size %2zu: synthesis %0.6e s, "
+                   "analysis %0.6e s\n", block[j], t_shs[i][j],
+                   t_sha[i][j]);
+            fprintf(fid_tune, "%lu %zu %0.17e %0.17e\n", nmax, block[j],
+                    t_shs[i][j], t_sha[i][j]);
+        }
+
+
+        CHARM(shc_free)(shcs);
+        CHARM(crd_point_free)(grd);
+        free(f);
+
+
+        printf("\n\n");
+    }
+
+
+    size_t block_s = block[best_block(t_shs)];
+    size_t block_a = block[best_block(t_sha)];
+    fprintf(fid_tune,
+            "# best --with-simd-block-a=%zu --with-simd-block-s=%zu\n",
+            block_a, block_s);
+    fclose(fid_tune);
+
+
+    CHARM(glob_shs_block_lat_multiplier) = block_s0;
+    CHARM(glob_sha_block_lat_multiplier) = block_a0;
+    CHARM(err_free)(err);
+
+
+    printf("Saved the timings to %s.\n\n", file_tune);
+    printf("To write the tuned sizes of latitude blocks into \"config.h\", "
+           "reconfigure CHarm with the same options as the current build "
+           "(except for \"--enable-runtime-block\") and with\n\n"
+           "    --with-simd-block-a=%zu --with-simd-block-s=%zu\n\n",
+           block_a, block_s);
+    printf("Done.\n");
+    return 0;
+#endif
+}
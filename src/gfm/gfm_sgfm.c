@@ -24,6 +24,7 @@
 #include "../prec.h"
 #include "../shc/shc_reset_coeffs.h"
 #include "../shc/shc_check_distribution.h"
+#include "../shc/shc_check_map.h"
 #include "../misc/misc_is_nearly_equal.h"
 #include "../misc/misc_idx_4d.h"
 #include "../err/err_set.h"
@@ -392,6 +393,14 @@ CHARM_EXTERN void CHARM_CDECL
             CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
             return;
         }
+
+
+        CHARM(shc_check_map)(potential_shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return;
+        }
 #else
         for (unsigned k = kmin; k <= kmax; k++)
         {
@@ -401,6 +410,14 @@ CHARM_EXTERN void CHARM_CDECL
                 CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
                 return;
             }
+
+
+            CHARM(shc_check_map)(potential_shcs[k - kmin], err);
+            if (!CHARM(err_isempty)(err))
+            {
+                CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                return;
+            }
         }
 #endif
     }
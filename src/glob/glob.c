@@ -23,8 +23,35 @@ unsigned long CHARM(glob_polar_optimization_a1) = 100;
 REAL CHARM(glob_polar_optimization_a2)          = PREC(-1.0);
 
 
+/* Maximum degree, below which "shs_point" works with interleaved coefficients
+ * at scattered points ("0" means that the coefficients are never copied) */
+unsigned long CHARM(glob_shs_point_interleave_nmax) = 0;
+
+
+/* Latitude blocks of grids with less than "glob_shs_grd_pslr_factor *
+ * log2(nlon)" synthesized harmonic orders are transformed along the parallels
+ * by the PSLR algorithm instead of FFT */
+REAL CHARM(glob_shs_grd_pslr_factor) = PREC(0.0);
+
+
+/* Latitude blocks of grids that do not allow FFT are transformed along the
+ * parallels by the chirp-z transform instead of the PSLR algorithm if they
+ * have at least "glob_shs_grd_czt_factor * log2(len) * len / nlon"
+ * synthesized harmonic orders */
+REAL CHARM(glob_shs_grd_czt_factor) = PREC(4.0);
+
+
+/* Maximum memory in bytes occupied by the tiles of coefficients in
+ * "shs_cell_isurf" */
+size_t CHARM(glob_shs_cell_isurf_memory) = (size_t)1024 * 1024 * 1024;
+
+
 #if HAVE_MPI
 unsigned long CHARM(glob_shc_block_nmax_multiplier) = 1000;
+#endif
+
+
+#if HAVE_RUNTIME_BLOCK
 size_t CHARM(glob_sha_block_lat_multiplier) = SIMD_BLOCK_A;
 size_t CHARM(glob_shs_block_lat_multiplier) = SIMD_BLOCK_S;
 #endif
@@ -13,7 +13,7 @@
 
 size_t CHARM(glob_get_sha_block_lat_multiplier)(void)
 {
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
     size_t ret = CHARM(glob_sha_block_lat_multiplier);
 #else
     /* This case is for users only.  In the CHarm's source files, we always use
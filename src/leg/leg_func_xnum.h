@@ -27,20 +27,19 @@ extern "C"
 /* ------------------------------------------------------------------------- */
 /* Tesseral Legendre functions */
 #define PNM_RECURRENCE(x, y, pnm2, t, anms, bnms)                             \
-        (pnm2) = SUB_R(MUL_R(MUL_R((anms), (t)), (x)),                        \
-                       MUL_R((bnms), (y)));
+        (pnm2) = FNMA_R((bnms), (y), MUL_R(MUL_R((anms), (t)), (x)));
 
 
 /* First-order derivatives of tesseral Legendre functions */
 #define DPNM_RECURRENCE(dpnm2, pnm1, pnm2, tu, u_rec, ns, enms)               \
-        (dpnm2) = SUB_R(MUL_R(MUL_R((enms), (u_rec)), (pnm1)),                \
-                        MUL_R(MUL_R((ns), (tu)), (pnm2)));
+        (dpnm2) = FNMA_R(MUL_R((ns), (tu)), (pnm2),                           \
+                         MUL_R(MUL_R((enms), (u_rec)), (pnm1)));
 
 
 /* Second-order derivative of tesseral legendre functions */
 #define DDPNM_RECURRENCE(ddpnm, dpnm, pnm, tu, u2_rec, m2s, nn1s)             \
-        (ddpnm) = ADD_R(MUL_R((tu), (dpnm)),                                  \
-                        MUL_R(SUB_R(MUL_R((m2s), (u2_rec)), (nn1s)), (pnm)));
+        (ddpnm) = FMA_R(SUB_R(MUL_R((m2s), (u2_rec)), (nn1s)), (pnm),         \
+                        MUL_R((tu), (dpnm)));
 
 
 /* Update the terms of a three-term recurrence */
@@ -56,6 +55,21 @@ extern "C"
 
 
 
+/* Index of the sectorial Legendre function of order "m" of the "l"th SIMD
+ * vector of a latitude block in the "ps" and "ips" arrays prepared by
+ * "leg_func_prepare" for the maximum harmonic degree "nmax".  The arrays are
+ * prepared in vectors of "SIMD_LAYOUT" elements, each of which is processed by
+ * the kernels as "SIMD_SPLIT" vectors of "SIMD_SIZE" elements (see
+ * "../simd/simd.h"). */
+#define PS_IDX(l, m, nmax) ((SIMD_LAYOUT * (nmax)) * ((l) / SIMD_SPLIT) +     \
+                            ((m) - 1) * SIMD_LAYOUT +                         \
+                            ((l) % SIMD_SPLIT) * SIMD_SIZE)
+
+
+
+
+
+
 #ifdef SIMD
     /* Macros to compute sectorial, semisectorial and tesseral Legendre
      * functions using a SIMD code */
@@ -221,8 +235,8 @@ extern "C"
                                                                               \
                                                                               \
     goto_label1:                                                              \
-               (z) = SUB_R(MUL_R(MUL_R((anms), (t)), (tmp1_r)),               \
-                           MUL_R((bnms), (tmp2_r)));                          \
+               (z) = FNMA_R((bnms), (tmp2_r),                                 \
+                            MUL_R(MUL_R((anms), (t)), (tmp1_r)));             \
                                                                               \
                                                                               \
                (w)     = ABS_R((z));                                          \
@@ -3,6 +3,9 @@
 #include <config.h>
 #include <stdlib.h>
 #include <string.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
 #include "../prec.h"
 #include "leg_pnmj_leq4.h"
 #include "leg_pnmj_dpeven.h"
@@ -21,6 +24,42 @@
 
 
 
+/* Macros */
+/* ------------------------------------------------------------------------- */
+/* Stores "P_{n, n, j}" and "P_{n, n - 1, j}" from "xp", "ip", "xp1" and "ip1"
+ * to "pnmj" and keeps their X-numbers for the recurrences over harmonic
+ * orders */
+#undef LEG_PNMJ_DP_STORE
+#define LEG_PNMJ_DP_STORE(n, jmax)                                            \
+        for (unsigned long j = 0; j <= (jmax); j++)                           \
+        {                                                                     \
+            tmp1 = CHARM(xnum_x2f)(xp[j],  ip[j]);                            \
+            tmp2 = CHARM(xnum_x2f)(xp1[j], ip1[j]);                           \
+            if (pnmj->ordering == CHARM_LEG_PMNJ)                             \
+            {                                                                 \
+                pnmj->pnmj[(n)][0][j]     = tmp1;                             \
+                pnmj->pnmj[(n) - 1][1][j] = tmp2;                             \
+            }                                                                 \
+            else if (pnmj->ordering == CHARM_LEG_PMJN)                        \
+            {                                                                 \
+                pnmj->pnmj[(n)][j][0] = tmp1;                                 \
+                pnmj->pnmj[(n) - 1][j][(n) - CHARM_MAX(2 * j, (n) - 1)] =     \
+                                                                     tmp2;    \
+            }                                                                 \
+                                                                              \
+                                                                              \
+            sx[soff[(n)] + j]  = xp[j];                                       \
+            si[soff[(n)] + j]  = ip[j];                                       \
+            sx1[soff[(n)] + j] = xp1[j];                                      \
+            si1[soff[(n)] + j] = ip1[j];                                      \
+        }
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
 void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
                             unsigned long nmax,
                             CHARM(err) *err)
@@ -63,16 +102,27 @@ void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
 
     REAL *xp    = NULL;
     REAL *xpold = NULL;
-    REAL *xp0   = NULL;
     REAL *xp1   = NULL;
-    REAL *xp2   = NULL;
 
 
     int *ip    = NULL;
     int *ipold = NULL;
-    int *ip0   = NULL;
     int *ip1   = NULL;
-    int *ip2   = NULL;
+
+
+    /* X-numbers of "P_{n, n, j}" ("sx", "si") and "P_{n, n - 1, j}" ("sx1",
+     * "si1") of all degrees "n".  They are computed serially and then used to
+     * start the recurrences over harmonic orders, which are independent for
+     * each "n" and are therefore computed in parallel.  The X-numbers of
+     * degree "n" start at "soff[n]". */
+    size_t *soff = NULL;
+    REAL *sx     = NULL;
+    REAL *sx1    = NULL;
+    int *si      = NULL;
+    int *si1     = NULL;
+
+
+    int FAILURE_glob = 0;
 
 
     xp    = (REAL *)calloc(nmaxp1, sizeof(REAL));
@@ -89,13 +139,6 @@ void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
                        CHARM_ERR_MALLOC_FAILURE);
         goto FAILURE;
     }
-    xp0   = (REAL *)calloc(nmaxp1, sizeof(REAL));
-    if (xp0 == NULL)
-    {
-        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
-                       CHARM_ERR_MALLOC_FAILURE);
-        goto FAILURE;
-    }
     xp1   = (REAL *)calloc(nmaxp1, sizeof(REAL));
     if (xp1 == NULL)
     {
@@ -103,13 +146,6 @@ void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
                        CHARM_ERR_MALLOC_FAILURE);
         goto FAILURE;
     }
-    xp2   = (REAL *)calloc(nmaxp1, sizeof(REAL));
-    if (xp2 == NULL)
-    {
-        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
-                       CHARM_ERR_MALLOC_FAILURE);
-        goto FAILURE;
-    }
 
 
     ip    = (int *)calloc(nmaxp1, sizeof(int));
@@ -126,22 +162,32 @@ void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
                        CHARM_ERR_MALLOC_FAILURE);
         goto FAILURE;
     }
-    ip0   = (int *)calloc(nmaxp1, sizeof(int));
-    if (ip0 == NULL)
+    ip1   = (int *)calloc(nmaxp1, sizeof(int));
+    if (ip1 == NULL)
     {
         CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
                        CHARM_ERR_MALLOC_FAILURE);
         goto FAILURE;
     }
-    ip1   = (int *)calloc(nmaxp1, sizeof(int));
-    if (ip1 == NULL)
+
+
+    soff = (size_t *)malloc((nmaxp1 + 1) * sizeof(size_t));
+    if (soff == NULL)
     {
         CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
                        CHARM_ERR_MALLOC_FAILURE);
         goto FAILURE;
     }
-    ip2   = (int *)calloc(nmaxp1, sizeof(int));
-    if (ip2 == NULL)
+    soff[0] = 0;
+    for (unsigned long n = 0; n <= nmax; n++)
+        soff[n + 1] = soff[n] + n / 2 + 1;
+
+
+    sx  = (REAL *)malloc(soff[nmaxp1] * sizeof(REAL));
+    sx1 = (REAL *)malloc(soff[nmaxp1] * sizeof(REAL));
+    si  = (int *)malloc(soff[nmaxp1] * sizeof(int));
+    si1 = (int *)malloc(soff[nmaxp1] * sizeof(int));
+    if ((sx == NULL) || (sx1 == NULL) || (si == NULL) || (si1 == NULL))
     {
         CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
                        CHARM_ERR_MALLOC_FAILURE);
@@ -200,7 +246,9 @@ void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
 
 
 
-    /* Even harmonic degrees from "n = 6" up to "n == nmax" */
+    /* Fourier coefficients of "P_{n, n}" and "P_{n, n - 1}" of even harmonic
+     * degrees from "n = 6" up to "n == nmax".  This recurrence over degrees
+     * is inherently serial. */
     /* --------------------------------------------------------------------- */
     for (unsigned long n = 6; n <= nmax; n += 2)
     {
@@ -220,60 +268,7 @@ void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
 
 
         jmax = n / 2;
-        for (unsigned long j = 0; j <= jmax; j++)
-        {
-            tmp1 = CHARM(xnum_x2f)(xp[j],  ip[j]);
-            tmp2 = CHARM(xnum_x2f)(xp1[j], ip1[j]);
-            if (pnmj->ordering == CHARM_LEG_PMNJ)
-            {
-                pnmj->pnmj[n][0][j]     = tmp1;
-                pnmj->pnmj[n - 1][1][j] = tmp2;
-            }
-            else if (pnmj->ordering == CHARM_LEG_PMJN)
-            {
-                pnmj->pnmj[n][j][0]                               = tmp1;
-                pnmj->pnmj[n - 1][j][n - CHARM_MAX(2 * j, n - 1)] = tmp2;
-            }
-
-
-            xp2[j] = xp[j];
-            ip2[j] = ip[j];
-        }
-
-
-        /* The loop can alternatively be designed as
-         *
-         *      for (unsigned long m = n - 2; m != (unsigned long)-1; m--)
-         *
-         * but the current form seems to be more robust. */
-        for (unsigned long m = n - 1; m-- > 0;)
-        {
-            CHARM(leg_pnmj_gpeven)(jmax, n, m, xp2, xp1, xp0, ip2, ip1,
-                                   ip0, err);
-            if (!CHARM(err_isempty)(err))
-            {
-                CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
-                goto FAILURE;
-            }
-
-
-            for (unsigned long j = 0; j <= jmax; j++)
-            {
-                tmp1 = CHARM(xnum_x2f)(xp0[j], ip0[j]);
-                if (pnmj->ordering == CHARM_LEG_PMNJ)
-                    pnmj->pnmj[m][n - m][j] = tmp1;
-                else if (pnmj->ordering == CHARM_LEG_PMJN)
-                    pnmj->pnmj[m][j][n - CHARM_MAX(m, 2 * j)] = tmp1;
-
-
-                xp2[j] = xp1[j];
-                ip2[j] = ip1[j];
-
-
-                xp1[j] = xp0[j];
-                ip1[j] = ip0[j];
-            }
-        }
+        LEG_PNMJ_DP_STORE(n, jmax);
     }
     /* --------------------------------------------------------------------- */
 
@@ -318,7 +313,8 @@ void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
 
 
 
-    /* Odd harmonic degrees from "n == 5" up to "n == nmax" */
+    /* Fourier coefficients of "P_{n, n}" and "P_{n, n - 1}" of odd harmonic
+     * degrees from "n == 5" up to "n == nmax" */
     /* --------------------------------------------------------------------- */
     for (unsigned long n = 5; n <= nmax; n += 2)
     {
@@ -338,60 +334,122 @@ void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
 
 
         jmax = (n - 1) / 2;
-        for (unsigned long j = 0; j <= jmax; j++)
-        {
-            tmp1 = CHARM(xnum_x2f)(xp[j],  ip[j]);
-            tmp2 = CHARM(xnum_x2f)(xp1[j], ip1[j]);
-            if (pnmj->ordering == CHARM_LEG_PMNJ)
-            {
-                pnmj->pnmj[n][0][j]     = tmp1;
-                pnmj->pnmj[n - 1][1][j] = tmp2;
-            }
-            else if (pnmj->ordering == CHARM_LEG_PMJN)
-            {
-                pnmj->pnmj[n][j][0]                               = tmp1;
-                pnmj->pnmj[n - 1][j][n - CHARM_MAX(2 * j, n - 1)] = tmp2;
-            }
+        LEG_PNMJ_DP_STORE(n, jmax);
+    }
+    /* --------------------------------------------------------------------- */
 
 
-            xp2[j] = xp[j];
-            ip2[j] = ip[j];
-        }
 
 
-        /* The loop can alternatively be designed as
-         *
-         *      for (unsigned long m = n - 2; m != (unsigned long)-1; m--)
-         *
-         * but the current form seems to be more robust. */
+
+
+    /* The remaining orders "m = n - 2, n - 3, ..., 0" of all degrees from
+     * "n == 5" up to "n == nmax".  The recurrences over orders are
+     * independent for each degree, so the degrees are distributed among
+     * OpenMP threads.  The amount of work for degree "n" is proportional to
+     * "n * n", so the degrees are processed from the highest one to the
+     * lowest one with a dynamic schedule to balance the load. */
+    /* --------------------------------------------------------------------- */
+#if HAVE_OPENMP
+#pragma omp parallel default(none) \
+shared(pnmj, nmax, nmaxp1, soff, sx, sx1, si, si1, FAILURE_glob, err)
+#endif
+    {
+    int FAILURE_priv = 0;
+
+
+    REAL *xpp = (REAL *)calloc(nmaxp1, sizeof(REAL));
+    int *ipp  = (int *)calloc(nmaxp1, sizeof(int));
+    CHARM(err) *err_priv = CHARM(err_init)();
+    if ((xpp == NULL) || (ipp == NULL) || (err_priv == NULL))
+        FAILURE_priv = 1;
+
+
+    REAL *xp0, *xp1p, *xp2, *xtmp;
+    int *ip0, *ip1p, *ip2, *itmp;
+    unsigned long n, jmax;
+    REAL tmp;
+
+
+#if HAVE_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for (unsigned long i = 5; i <= nmax; i++)
+    {
+        if (FAILURE_priv)
+            continue;
+
+
+        n    = nmax + 5 - i;
+        jmax = (n % 2) ? (n - 1) / 2 : n / 2;
+
+
+        /* The serially computed "P_{n, n, j}" and "P_{n, n - 1, j}" are
+         * not needed anymore once the recurrence starts, so their memory is
+         * reused for the recurrence.  The pointers are rotated instead of
+         * copying the arrays. */
+        xp2  = sx  + soff[n];
+        ip2  = si  + soff[n];
+        xp1p = sx1 + soff[n];
+        ip1p = si1 + soff[n];
+        xp0  = xpp;
+        ip0  = ipp;
+
+
         for (unsigned long m = n - 1; m-- > 0;)
         {
-            CHARM(leg_pnmj_gpodd)(jmax, n, m, xp2, xp1, xp0, ip2, ip1, ip0,
-                                    err);
-            if (!CHARM(err_isempty)(err))
+            if (n % 2)
+                CHARM(leg_pnmj_gpodd)(jmax, n, m, xp2, xp1p, xp0, ip2, ip1p,
+                                      ip0, err_priv);
+            else
+                CHARM(leg_pnmj_gpeven)(jmax, n, m, xp2, xp1p, xp0, ip2,
+                                       ip1p, ip0, err_priv);
+            if (!CHARM(err_isempty)(err_priv))
             {
-                CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
-                goto FAILURE;
+                FAILURE_priv = 2;
+                break;
             }
 
 
             for (unsigned long j = 0; j <= jmax; j++)
             {
-                tmp1 = CHARM(xnum_x2f)(xp0[j], ip0[j]);
+                tmp = CHARM(xnum_x2f)(xp0[j], ip0[j]);
                 if (pnmj->ordering == CHARM_LEG_PMNJ)
-                    pnmj->pnmj[m][n - m][j] = tmp1;
+                    pnmj->pnmj[m][n - m][j] = tmp;
                 else if (pnmj->ordering == CHARM_LEG_PMJN)
-                    pnmj->pnmj[m][j][n - CHARM_MAX(m, 2 * j)] = tmp1;
+                    pnmj->pnmj[m][j][n - CHARM_MAX(m, 2 * j)] = tmp;
+            }
+
+
+            xtmp = xp2;
+            itmp = ip2;
+            xp2  = xp1p;
+            ip2  = ip1p;
+            xp1p = xp0;
+            ip1p = ip0;
+            xp0  = xtmp;
+            ip0  = itmp;
+        }
+    }
 
 
-                xp2[j] = xp1[j];
-                ip2[j] = ip1[j];
+#if HAVE_OPENMP
+#pragma omp critical
+#endif
+    {
+        if ((FAILURE_priv == 2) && (FAILURE_glob == 0))
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                           err_priv->code, err_priv->msg);
+        else if ((FAILURE_priv == 1) && (FAILURE_glob == 0))
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+        FAILURE_glob += FAILURE_priv;
+    }
 
 
-                xp1[j] = xp0[j];
-                ip1[j] = ip0[j];
-            }
-        }
+    free(xpp);
+    free(ipp);
+    CHARM(err_free)(err_priv);
     }
     /* --------------------------------------------------------------------- */
 
@@ -403,8 +461,9 @@ void CHARM(leg_pnmj_coeffs)(CHARM(pnmj) *pnmj,
     /* Free the heap memory */
     /* --------------------------------------------------------------------- */
 FAILURE:
-    free(xp); free(xpold); free(xp0); free(xp1); free(xp2);
-    free(ip); free(ipold); free(ip0); free(ip1); free(ip2);
+    free(xp); free(xpold); free(xp1);
+    free(ip); free(ipold); free(ip1);
+    free(soff); free(sx); free(sx1); free(si); free(si1);
     /* --------------------------------------------------------------------- */
 
 
@@ -0,0 +1,102 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "../xnum/xnum_xlsum2.h"
+#include "leg_pnmj_gp_xlsum2.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/**
+ * Evaluates the two-term linear sums of X-numbers
+ *
+ *      xp0[j] = ((a * j + b) * alpha) * xp1[j] + beta * xp2[j]
+ *
+ * for ``j = j0, j0 + 1, ..., jmax``, which are the recurrences over harmonic
+ * orders from Tables 5 and 6 of Fukushima (2018).
+ *
+ * With SIMD instructions, ``SIMD_SIZE`` values of ``j`` are processed at
+ * a time as long as all the input exponents are zero and the output
+ * significands do not need to be normalized.  This is the case for the vast
+ * majority of the coefficients, so that the ``xnum_xlsum2`` function is
+ * called only for the few remaining ones.
+ *
+ * */
+void CHARM(leg_pnmj_gp_xlsum2)(unsigned long j0, unsigned long jmax,
+                               unsigned long a, unsigned long b, REAL alpha,
+                               REAL beta, const REAL *xp2, const REAL *xp1,
+                               REAL *xp0, const int *ip2, const int *ip1,
+                               int *ip0)
+{
+    unsigned long j = j0;
+
+
+#ifdef SIMD
+    REAL jv[SIMD_SIZE];
+    for (size_t v = 0; v < SIMD_SIZE; v++)
+        jv[v] = (REAL)(a * (j0 + v) + b);
+
+
+    REAL_SIMD aj_r    = LOADU_R(&jv[0]);
+    REAL_SIMD step_r  = SET1_R((REAL)(a * SIMD_SIZE));
+    REAL_SIMD alpha_r = SET1_R(alpha);
+    REAL_SIMD beta_r  = SET1_R(beta);
+    REAL_SIMD BIGS_r  = SET1_R(BIGS);
+    REAL_SIMD BIGSI_r = SET1_R(BIGSI);
+    REAL_SIMD z, w;
+    int inz;
+    size_t v;
+
+
+    for (; j + SIMD_SIZE <= jmax + 1; j += SIMD_SIZE)
+    {
+        inz = 0;
+        for (v = 0; v < SIMD_SIZE; v++)
+            inz |= ip1[j + v] | ip2[j + v];
+
+
+        if (inz == 0)
+        {
+            z = FMA_R(MUL_R(aj_r, alpha_r), LOADU_R(&xp1[j]),
+                      MUL_R(beta_r, LOADU_R(&xp2[j])));
+            w = ABS_R(z);
+            if (!MASK_TRUE_ANY(GE_R(w, BIGS_r)) &&
+                !MASK_TRUE_ANY(LT_R(w, BIGSI_r)))
+            {
+                STOREU_R(&xp0[j], z);
+                for (v = 0; v < SIMD_SIZE; v++)
+                    ip0[j + v] = 0;
+
+
+                aj_r = ADD_R(aj_r, step_r);
+                continue;
+            }
+        }
+
+
+        /* Some of the X-numbers need their exponents, so let "xnum_xlsum2"
+         * do the job */
+        for (v = 0; v < SIMD_SIZE; v++)
+            CHARM(xnum_xlsum2)((REAL)(a * (j + v) + b) * alpha, xp1[j + v],
+                               beta, xp2[j + v], &xp0[j + v], ip1[j + v],
+                               ip2[j + v], &ip0[j + v]);
+
+
+        aj_r = ADD_R(aj_r, step_r);
+    }
+#endif
+
+
+    for (; j <= jmax; j++)
+        CHARM(xnum_xlsum2)((REAL)(a * j + b) * alpha, xp1[j], beta, xp2[j],
+                           &xp0[j], ip1[j], ip2[j], &ip0[j]);
+
+
+    return;
+}
@@ -0,0 +1,30 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __LEG_PNMJ_GP_XLSUM2_H__
+#define __LEG_PNMJ_GP_XLSUM2_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(leg_pnmj_gp_xlsum2)(unsigned long, unsigned long,
+                                      unsigned long, unsigned long, REAL,
+                                      REAL, const REAL *, const REAL *,
+                                      REAL *, const int *, const int *,
+                                      int *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -5,7 +5,7 @@
 #include <math.h>
 #include "../prec.h"
 #include "../xnum/xnum_xnorm.h"
-#include "../xnum/xnum_xlsum2.h"
+#include "leg_pnmj_gp_xlsum2.h"
 #include "../err/err_set.h"
 #include "leg_pnmj_gpeven.h"
 /* ------------------------------------------------------------------------- */
@@ -104,20 +104,11 @@ void CHARM(leg_pnmj_gpeven)(unsigned long jmax, unsigned long n,
     CHARM(xnum_xnorm)(&xp0[0], &ip0[0]);
 
 
-    if (modd == 0)
-        /* Eq. (76) -- Note that there appears to be a misprint for the
-         * condition on "j" right before this equation. Correctly, it should
-         * read (in C syntax) "j != 0". */
-        for (unsigned long j = 1; j <= jmax; j++)
-            CHARM(xnum_xlsum2)((REAL)(j) * alpha2, xp1[j], beta, xp2[j],
-                               &xp0[j], ip1[j], ip2[j], &ip0[j]);
-    else
-        /* Eq. (77) -- Note that there appears to be a misprint for the
-         * condition on "j" right before this equation. Correctly, it should
-         * read (in C syntax) "j != 0". */
-        for (unsigned long j = 1; j <= jmax; j++)
-            CHARM(xnum_xlsum2)(-(REAL)(j) * alpha2, xp1[j], beta, xp2[j],
-                               &xp0[j], ip1[j], ip2[j], &ip0[j]);
+    /* Eq. (76) -- Note that there appears to be a misprint for the condition
+     * on "j" right before this equation. Correctly, it should read (in
+     * C syntax) "j != 0".  Eq. (77) differs only in the sign of "alpha2". */
+    CHARM(leg_pnmj_gp_xlsum2)(1, jmax, 1, 0, (modd == 0) ? alpha2 : -alpha2,
+                              beta, xp2, xp1, xp0, ip2, ip1, ip0);
 
 
     return;
@@ -4,7 +4,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include "../prec.h"
-#include "../xnum/xnum_xlsum2.h"
+#include "leg_pnmj_gp_xlsum2.h"
 #include "../err/err_set.h"
 #include "leg_pnmj_gpodd.h"
 /* ------------------------------------------------------------------------- */
@@ -103,16 +103,10 @@ void CHARM(leg_pnmj_gpodd)(unsigned long jmax, unsigned long n,
     REAL beta = SQRT((REAL)(n - m1) * (REAL)(n + m2)) * u;
 
 
-    if (modd == 0)
-        /* Eq. (78) of Fukushima (2018) */
-        for (unsigned long j = 0; j <= jmax; j++)
-            CHARM(xnum_xlsum2)((REAL)(2 * j + 1) * alpha, xp1[j], beta,
-                               xp2[j], &xp0[j], ip1[j], ip2[j], &ip0[j]);
-    else
-        /* Eq. (79) */
-        for (unsigned long j = 0; j <= jmax; j++)
-            CHARM(xnum_xlsum2)(-(REAL)(2 * j + 1) * alpha, xp1[j], beta,
-                               xp2[j], &xp0[j], ip1[j], ip2[j], &ip0[j]);
+    /* Eq. (78) of Fukushima (2018).  Eq. (79) differs only in the sign of
+     * "alpha". */
+    CHARM(leg_pnmj_gp_xlsum2)(0, jmax, 2, 1, (modd == 0) ? alpha : -alpha,
+                              beta, xp2, xp1, xp0, ip2, ip1, ip0);
 
 
     return;
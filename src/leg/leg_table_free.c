@@ -0,0 +1,32 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "leg_table_struct.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(leg_table_free)(CHARM(leg_table) *table)
+{
+    if (table == NULL)
+        return;
+
+
+    for (unsigned d = 0; d <= LEG_TABLE_DLAT_MAX; d++)
+    {
+        free(table->pnm[d]);
+        free(table->pnmf[d]);
+    }
+
+
+    free(table);
+
+
+    return;
+}
@@ -0,0 +1,478 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../crd/crd_point_isGrid.h"
+#include "../crd/crd_point_isSctr.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+#include "../err/err_omp_mpi.h"
+#include "../misc/misc_is_nearly_equal.h"
+#include "../simd/simd.h"
+#include "../simd/calloc_aligned.h"
+#include "../simd/free_aligned.h"
+#include "leg_func_r_ri.h"
+#include "leg_func_dm.h"
+#include "leg_func_anm_bnm.h"
+#include "leg_func_enm.h"
+#include "leg_func_prepare.h"
+#include "leg_func_xnum.h"
+#include "leg_func_use_xnum.h"
+#include "leg_table_struct.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Macros */
+/* ------------------------------------------------------------------------- */
+/* Stores the Legendre function "pnm" of degree "n" to "pbuf" */
+#undef PBUF_STORE
+#define PBUF_STORE(n, pnm)                                                    \
+    STORE_R(&pbuf[((n) - m) * SIMD_SIZE], (pnm));
+
+
+/* Copies "x" computed for the harmonic order "m" and the latitudes "i", "i +
+ * 1", ..., "i + nv - 1" to the "d"th table */
+#undef TABLE_STORE
+#define TABLE_STORE(d, x)                                                     \
+    for (unsigned long n = m; n <= nmax; n++)                                 \
+    {                                                                         \
+        size_t idx = LEG_TABLE_IDX(nmax, n, m) * nlat + i;                    \
+        if (single)                                                           \
+        {                                                                     \
+            for (size_t v = 0; v < nv; v++)                                   \
+                table->pnmf[(d)][idx + v] =                                   \
+                                    (float)(x)[(n - m) * SIMD_SIZE + v];      \
+        }                                                                     \
+        else                                                                  \
+        {                                                                     \
+            for (size_t v = 0; v < nv; v++)                                   \
+                table->pnm[(d)][idx + v] = (x)[(n - m) * SIMD_SIZE + v];      \
+        }                                                                     \
+    }
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+CHARM(leg_table) *CHARM(leg_table_init)(const CHARM(point) *pnt,
+                                        unsigned long nmax,
+                                        unsigned dlat,
+                                        _Bool single,
+                                        size_t max_bytes,
+                                        CHARM(err) *err)
+{
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return NULL;
+    }
+
+
+    if (pnt->distributed)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Legendre tables cannot be created for distributed "
+                       "\"pnt\".");
+        return NULL;
+    }
+
+
+    if (!CHARM(crd_point_isGrid)(pnt->type) &&
+        !CHARM(crd_point_isSctr)(pnt->type))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Unsupported \"pnt->type\".");
+        return NULL;
+    }
+
+
+    if (dlat > LEG_TABLE_DLAT_MAX)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "\"dlat\" cannot be larger than \"2\".");
+        return NULL;
+    }
+
+
+    /* The latitudinal derivatives are singular at the poles */
+    if (dlat > 0)
+    {
+        for (size_t i = 0; i < pnt->nlat; i++)
+        {
+            if (CHARM(misc_is_nearly_equal)(FABS(pnt->lat[i]), PI_2,
+                                            CHARM(glob_threshold)))
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFUNCARG,
+                               "Latitudinal derivatives of Legendre functions "
+                               "cannot be tabulated at the poles.");
+                return NULL;
+            }
+        }
+    }
+
+
+    const size_t nbytes = CHARM(leg_table_nbytes)(pnt, nmax, dlat, single);
+    if ((max_bytes > 0) && (nbytes > max_bytes))
+    {
+        char err_msg[CHARM_ERR_MAX_MSG];
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                 "The table requires \"%zu\" bytes, which is more than "
+                 "\"max_bytes = %zu\".", nbytes, max_bytes);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        return NULL;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Allocate the table */
+    /* --------------------------------------------------------------------- */
+    REAL *r  = NULL;
+    REAL *ri = NULL;
+    REAL *dm = NULL;
+    int err_glob = 0;
+
+
+    CHARM(leg_table) *table = (CHARM(leg_table) *)calloc(1,
+                                                   sizeof(CHARM(leg_table)));
+    if (table == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        return NULL;
+    }
+
+
+    const size_t nlat = pnt->nlat;
+    table->pnt        = pnt;
+    table->nmax       = nmax;
+    table->dlat       = dlat;
+    table->single     = single;
+    table->nlat       = nlat;
+    table->nnm        = ((size_t)nmax + 1) * ((size_t)nmax + 2) / 2;
+
+
+    for (unsigned d = 0; d <= dlat; d++)
+    {
+        if (single)
+            table->pnmf[d] = (float *)malloc(table->nnm * nlat *
+                                             sizeof(float));
+        else
+            table->pnm[d] = (REAL *)malloc(table->nnm * nlat * sizeof(REAL));
+
+
+        if ((table->pnmf[d] == NULL) && (table->pnm[d] == NULL))
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto FAILURE;
+        }
+    }
+
+
+    /* Coefficients for the recurrence relations of Legendre functions */
+    r  = (REAL *)calloc(2 * nmax + 4, sizeof(REAL));
+    ri = (REAL *)calloc(2 * nmax + 4, sizeof(REAL));
+    dm = (REAL *)calloc(nmax + 1, sizeof(REAL));
+    if ((r == NULL) || (ri == NULL) || (dm == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE;
+    }
+    CHARM(leg_func_r_ri)(nmax, r, ri);
+    CHARM(leg_func_dm)(nmax, r, ri, dm);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Tabulate the Legendre functions.  Each OpenMP thread processes
+     * "SIMD_SIZE" latitudes at a time, for which it computes the Legendre
+     * functions of all degrees and orders exactly as "sha_point" and
+     * "shs_point" do. */
+    /* --------------------------------------------------------------------- */
+#if HAVE_OPENMP
+#pragma omp parallel default(none) \
+shared(pnt, table, nmax, dlat, single, nlat, r, ri, dm, err_glob, err)
+#endif
+    {
+    int err_priv = 0;
+
+
+    REAL *anm  = (REAL *)calloc(nmax + 1, sizeof(REAL));
+    REAL *bnm  = (REAL *)calloc(nmax + 1, sizeof(REAL));
+    REAL *enm  = (REAL *)calloc(nmax + 1, sizeof(REAL));
+    REAL *tv   = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                               sizeof(REAL));
+    REAL *uv   = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                               sizeof(REAL));
+    REAL *ps   = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                               (nmax + 1) * SIMD_SIZE,
+                                               sizeof(REAL));
+    INT *ips   = (INT *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                              (nmax + 1) * SIMD_SIZE,
+                                              sizeof(INT));
+    REAL *pbuf = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                               (nmax + 1) * SIMD_SIZE,
+                                               sizeof(REAL));
+    REAL *dbuf = (REAL *)calloc((nmax + 1) * SIMD_SIZE, sizeof(REAL));
+    REAL *ddbuf = (REAL *)calloc((nmax + 1) * SIMD_SIZE, sizeof(REAL));
+    if ((anm == NULL) || (bnm == NULL) || (enm == NULL) || (tv == NULL) ||
+        (uv == NULL) || (ps == NULL) || (ips == NULL) || (pbuf == NULL) ||
+        (dbuf == NULL) || (ddbuf == NULL))
+        err_priv = 1;
+
+
+    if (CHARM(err_omp_mpi)(&err_glob, &err_priv, CHARM_ERR_MALLOC_FAILURE,
+                           CHARM_EMEM, err))
+        goto FAILURE_PARALLEL;
+
+
+    REAL_SIMD t, x, y, z, pnm0, pnm1, pnm2, anms, bnms, w;
+    RI_SIMD ix, iy, iz, ixy;
+    _Bool ds;
+    REAL_SIMD ROOT3_r = SET1_R(ROOT3);
+#ifdef SIMD
+    RI_SIMD    zero_ri = SET_ZERO_RI;
+    RI_SIMD    one_ri  = SET1_RI(1);
+    RI_SIMD    mone_ri = SET1_RI(-1);
+    REAL_SIMD  zero_r  = SET_ZERO_R;
+    REAL_SIMD  BIG_r   = SET1_R(BIG);
+    REAL_SIMD  BIGI_r  = SET1_R(BIGI);
+    REAL_SIMD  BIGS_r  = SET1_R(BIGS);
+    REAL_SIMD  BIGSI_r = SET1_R(BIGSI);
+    REAL_SIMD  tmp1_r,  tmp2_r;
+    MASK_SIMD  mask1, mask2;
+    MASK2_SIMD mask3;
+#endif
+
+
+    /* Loop over latitude blocks */
+#if HAVE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (size_t i = 0; i < nlat; i += SIMD_SIZE)
+    {
+        /* Number of valid latitudes in this block */
+        size_t nv = CHARM_MIN(SIMD_SIZE, nlat - i);
+
+
+        for (size_t v = 0; v < SIMD_SIZE; v++)
+        {
+            tv[v] = (v < nv) ? SIN(pnt->lat[i + v]) : PREC(0.0);
+            uv[v] = (v < nv) ? COS(pnt->lat[i + v]) : PREC(0.0);
+        }
+        t = LOAD_R(&tv[0]);
+
+
+        CHARM(leg_func_prepare)(uv, ps, ips, dm, nmax);
+
+
+        for (unsigned long m = 0; m <= nmax; m++)
+        {
+            CHARM(leg_func_anm_bnm)(nmax, m, r, ri, anm, bnm);
+
+
+            /* Legendre functions */
+            /* ------------------------------------------------------------- */
+            if (m == 0)
+            {
+                pnm0 = SET1_R(PREC(1.0));
+                PBUF_STORE(0, pnm0);
+
+
+                if (nmax >= 1)
+                {
+                    pnm1 = MUL_R(ROOT3_r, t);
+                    PBUF_STORE(1, pnm1);
+                }
+
+
+                for (unsigned long n = 2; n <= nmax; n++)
+                {
+                    anms = SET1_R(anm[n]);
+                    bnms = SET1_R(bnm[n]);
+                    PNM_RECURRENCE(pnm1, pnm0, pnm2, t, anms, bnms);
+                    RECURRENCE_NEXT_ITER(pnm0, pnm1, pnm2);
+                    PBUF_STORE(n, pnm2);
+                }
+            }
+            else
+            {
+#ifdef SIMD
+                PNM_SECTORIAL_XNUM_SIMD(x, ix, ps[(m - 1) * SIMD_SIZE],
+                                        ips[(m - 1) * SIMD_SIZE], pnm0,
+                                        BIG_r, zero_r, zero_ri, mone_ri,
+                                        mask1, mask2, SECTORIALS);
+#else
+                PNM_SECTORIAL_XNUM(x, ix, ps[(m - 1) * SIMD_SIZE],
+                                   ips[(m - 1) * SIMD_SIZE], pnm0);
+#endif
+                PBUF_STORE(m, pnm0);
+
+
+                if (m < nmax)
+                {
+                    anms = SET1_R(anm[m + 1]);
+#ifdef SIMD
+                    PNM_SEMISECTORIAL_XNUM_SIMD(x, y, ix, iy, w, t, anms,
+                                                pnm1, mask1, mask2, mask3,
+                                                zero_r, zero_ri, mone_ri,
+                                                BIG_r, BIGS_r, BIGI_r,
+                                                SEMISECTORIALS);
+#else
+                    PNM_SEMISECTORIAL_XNUM(x, y, ix, iy, w, t, anms, pnm1);
+#endif
+                    PBUF_STORE(m + 1, pnm1);
+
+
+                    ds = 0;
+                    unsigned long n;
+                    for (n = m + 2;
+                         CHARM(leg_func_use_xnum)(&ds, 1) && n <= nmax;
+                         n++)
+                    {
+                        anms = SET1_R(anm[n]);
+                        bnms = SET1_R(bnm[n]);
+#ifdef SIMD
+                        PNM_TESSERAL_XNUM_SIMD(x, y, z, ix, iy, iz, ixy, w,
+                                               t, anms, bnms, pnm2,
+                                               tmp1_r, tmp2_r, mask1, mask2,
+                                               mask3, zero_r, zero_ri,
+                                               one_ri, BIG_r, BIGI_r,
+                                               BIGS_r, BIGSI_r, TESSERALS1,
+                                               TESSERALS2, ds);
+#else
+                        PNM_TESSERAL_XNUM(x, y, z, ix, iy, iz, ixy, w, t,
+                                          anms, bnms, pnm2, ds);
+#endif
+                        PBUF_STORE(n, pnm2);
+                    }
+
+
+                    /* From now on, "F"-numbers can be used instead of the
+                     * "X"-numbers */
+                    for (; n <= nmax; n++)
+                    {
+                        anms = SET1_R(anm[n]);
+                        bnms = SET1_R(bnm[n]);
+                        PNM_RECURRENCE(x, y, pnm2, t, anms, bnms);
+                        RECURRENCE_NEXT_ITER(y, x, pnm2);
+                        PBUF_STORE(n, pnm2);
+                    }
+                }
+            }
+            TABLE_STORE(0, pbuf);
+            /* ------------------------------------------------------------- */
+
+
+            /* Latitudinal derivatives of Legendre functions.  The same
+             * formulae as in "shs_point_kernel.c" are used, but in a scalar
+             * form. */
+            /* ------------------------------------------------------------- */
+            if (dlat == 0)
+                continue;
+
+
+            CHARM(leg_func_enm)(nmax, m, r, ri, enm);
+
+
+            for (size_t v = 0; v < nv; v++)
+            {
+                REAL u_rec  = PREC(1.0) / uv[v];
+                REAL tu     = tv[v] * u_rec;
+                REAL u2_rec = u_rec * u_rec;
+                REAL m2     = (REAL)m * (REAL)m;
+                REAL pnm_prev = PREC(0.0);  /* "P_{n - 1, m}" */
+
+
+                for (unsigned long n = m; n <= nmax; n++)
+                {
+                    REAL pnm = pbuf[(n - m) * SIMD_SIZE + v];
+                    REAL dpnm;
+                    if (n == 0)
+                        dpnm = PREC(0.0);
+                    else if ((m == 0) && (n == 1))
+                        dpnm = ROOT3 * uv[v];
+                    else
+                        dpnm = (enm[n] * u_rec) * pnm_prev -
+                               ((REAL)n * tu) * pnm;
+
+
+                    dbuf[(n - m) * SIMD_SIZE + v]  = dpnm;
+                    ddbuf[(n - m) * SIMD_SIZE + v] = tu * dpnm +
+                                      (m2 * u2_rec - (REAL)(n * (n + 1))) *
+                                      pnm;
+                    pnm_prev = pnm;
+                }
+            }
+
+
+            TABLE_STORE(1, dbuf);
+            if (dlat > 1)
+            {
+                TABLE_STORE(2, ddbuf);
+            }
+            /* ------------------------------------------------------------- */
+        }
+    }
+
+
+FAILURE_PARALLEL:
+    free(anm);
+    free(bnm);
+    free(enm);
+    CHARM(free_aligned)(tv);
+    CHARM(free_aligned)(uv);
+    CHARM(free_aligned)(ps);
+    CHARM(free_aligned)(ips);
+    CHARM(free_aligned)(pbuf);
+    free(dbuf);
+    free(ddbuf);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    if (!CHARM(err_isempty)(err))
+        goto FAILURE;
+
+
+    free(r);
+    free(ri);
+    free(dm);
+
+
+    return table;
+
+
+FAILURE:
+    free(r);
+    free(ri);
+    free(dm);
+    CHARM(leg_table_free)(table);
+    return NULL;
+}
@@ -0,0 +1,29 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "leg_table_struct.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+size_t CHARM(leg_table_nbytes)(const CHARM(point) *pnt,
+                               unsigned long nmax,
+                               unsigned dlat,
+                               _Bool single)
+{
+    if (dlat > LEG_TABLE_DLAT_MAX)
+        return 0;
+
+
+    /* Number of Legendre functions per latitude */
+    size_t nnm = ((size_t)nmax + 1) * ((size_t)nmax + 2) / 2;
+
+
+    return (size_t)(dlat + 1) * nnm * pnt->nlat *
+           ((single) ? sizeof(float) : sizeof(REAL));
+}
@@ -0,0 +1,59 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __LEG_TABLE_STRUCT_H__
+#define __LEG_TABLE_STRUCT_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+/* Maximum order of the latitudinal derivative of Legendre functions that can
+ * be tabulated */
+#undef LEG_TABLE_DLAT_MAX
+#define LEG_TABLE_DLAT_MAX (2)
+
+
+/* Index of the Legendre function of degree "n" and order "m" in a table up to
+ * degree "nmax".  The ordering is the same as that of "shcs->c[0]" of
+ * a "charm_shc" structure, that is, order-wise with the degrees running
+ * fastest. */
+#undef LEG_TABLE_IDX
+#define LEG_TABLE_IDX(nmax, n, m)                                             \
+    ((m) * ((nmax) + 1) - ((m) * ((m) - 1)) / 2 + ((n) - (m)))
+
+
+/* Structure holding pre-tabulated Legendre functions.  The structure is
+ * opaque to the user ("charm_leg_table"). */
+struct CHARM(leg_table)
+{
+    /* Points, maximum harmonic degree and the maximum order of the
+     * latitudinal derivative the table was created for */
+    const CHARM(point) *pnt;
+    unsigned long nmax;
+    unsigned dlat;
+
+
+    /* If "1", the values are stored in single precision in "pnmf".
+     * Otherwise, they are stored in "pnm". */
+    _Bool single;
+
+
+    /* Number of latitudes of "pnt" and the number of Legendre functions per
+     * latitude */
+    size_t nlat;
+    size_t nnm;
+
+
+    /* The "d"th latitudinal derivative of the Legendre function of degree "n"
+     * and order "m" at the "i"th latitude of "pnt" is stored in
+     * "pnm[d][LEG_TABLE_IDX(nmax, n, m) * nlat + i]" (or "pnmf[d][...]"), "d
+     * = 0, 1, ..., dlat".  The latitudes are thus running fastest, so that
+     * the consumers of the table can vectorize over the latitudes. */
+    REAL *pnm[LEG_TABLE_DLAT_MAX + 1];
+    float *pnmf[LEG_TABLE_DLAT_MAX + 1];
+};
+
+
+#endif
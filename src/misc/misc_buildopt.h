@@ -74,6 +74,11 @@ extern "C"
 #define BUILDOPT_SIMD_SSE41 5
 
 
+/* Signalizes the feature is available.  Must be non-zero. */
+#undef BUILDOPT_SIMD_DISPATCH
+#define BUILDOPT_SIMD_DISPATCH 1
+
+
 #undef LIB_NA_STR
 #define LIB_NA_STR "n/a"
 
@@ -3,6 +3,7 @@
 #include <config.h>
 #include <stdio.h>
 #include "../prec.h"
+#include "../simd/simd_dispatch.h"
 #include "misc_buildopt.h"
 /* ------------------------------------------------------------------------- */
 
@@ -13,7 +14,9 @@
 
 int CHARM(misc_buildopt_simd)(void)
 {
-#if HAVE_AVX
+#if HAVE_SIMD_DISPATCH
+    return CHARM(simd_dispatch_isa);
+#elif HAVE_AVX
     return BUILDOPT_SIMD_AVX;
 #elif HAVE_AVX2
     return BUILDOPT_SIMD_AVX2;
@@ -0,0 +1,21 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "misc_buildopt.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+int CHARM(misc_buildopt_simd_dispatch)(void)
+{
+#if HAVE_SIMD_DISPATCH
+    return BUILDOPT_SIMD_DISPATCH;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,53 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "misc_buildopt.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* The CPU features are queried by "cpuid" through the GCC built-in functions,
+ * which are available also in clang and in the Intel compilers.  With other
+ * compilers on x86_64, no SIMD support is reported. */
+#undef CPU_X86
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#   define CPU_X86 1
+#endif
+
+
+
+
+
+
+int CHARM(misc_cpu_simd)(void)
+{
+#if CPU_X86
+    __builtin_cpu_init();
+
+
+    /* "--enable-avx-512" compiles CHarm with "-mavx512f -mavx512dq" */
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512dq"))
+        return BUILDOPT_SIMD_AVX512;
+    /* "--enable-avx2" compiles CHarm with "-mavx2 -mfma" */
+    else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return BUILDOPT_SIMD_AVX2;
+    else if (__builtin_cpu_supports("avx"))
+        return BUILDOPT_SIMD_AVX;
+    else if (__builtin_cpu_supports("sse4.1"))
+        return BUILDOPT_SIMD_SSE41;
+    else
+        return BUILDOPT_SIMD_NONE;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    /* NEON is a mandatory part of ARMv8-A */
+    return BUILDOPT_SIMD_NEON;
+#else
+    return BUILDOPT_SIMD_NONE;
+#endif
+}
@@ -0,0 +1,55 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "misc_buildopt.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns the rank of the x86_64 SIMD instructions "simd", so that the
+ * instructions of a lower rank are a subset of those of a higher rank.  For
+ * NEON, "-1" is returned. */
+static int simd_rank(int simd)
+{
+    if (simd == BUILDOPT_SIMD_NONE)
+        return 0;
+    else if (simd == BUILDOPT_SIMD_SSE41)
+        return 1;
+    else if (simd == BUILDOPT_SIMD_AVX)
+        return 2;
+    else if (simd == BUILDOPT_SIMD_AVX2)
+        return 3;
+    else if (simd == BUILDOPT_SIMD_AVX512)
+        return 4;
+    else
+        return -1;
+}
+
+
+
+
+
+
+int CHARM(misc_cpu_simd_check)(void)
+{
+    const int simd_build = CHARM(misc_buildopt_simd)();
+    const int simd_cpu   = CHARM(misc_cpu_simd)();
+
+
+    if ((simd_build == BUILDOPT_SIMD_NONE) || (simd_build == simd_cpu))
+        return 1;
+
+
+    int rank_build = simd_rank(simd_build);
+    int rank_cpu   = simd_rank(simd_cpu);
+    if ((rank_build < 0) || (rank_cpu < 0))
+        return 0;
+
+
+    return rank_build <= rank_cpu;
+}
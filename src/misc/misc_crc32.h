@@ -0,0 +1,30 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_CRC32_H__
+#define __MISC_CRC32_H__
+
+
+#include <config.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern uint32_t CHARM(misc_crc32)(uint32_t,
+                                  const void *,
+                                  size_t);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,32 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_DTOA_H__
+#define __MISC_DTOA_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+/* Minimum size of the buffer for "misc_dtoa", including the terminating null
+ * character */
+#define MISC_DTOA_NBUF 64
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern int CHARM(misc_dtoa)(REAL,
+                            char *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
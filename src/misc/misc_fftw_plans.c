@@ -0,0 +1,76 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "misc_fftw_plans.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Number of FFTW plans that are stored in plan objects returned to the user
+ * (e.g., "charm_shs_plan").  As long as there is at least one such plan, we
+ * must not call "fftw_cleanup", as it would make these plans undefined. */
+static size_t nplans = 0;
+
+
+
+
+
+
+/* Registers a FFTW plan that lives longer than a single CHarm function
+ * call. */
+void CHARM(misc_fftw_plans_add)(void)
+{
+#if HAVE_OPENMP
+#pragma omp atomic
+#endif
+    nplans++;
+
+
+    return;
+}
+
+
+
+
+
+
+/* Unregisters a FFTW plan registered by "misc_fftw_plans_add". */
+void CHARM(misc_fftw_plans_remove)(void)
+{
+#if HAVE_OPENMP
+#pragma omp atomic
+#endif
+    nplans--;
+
+
+    return;
+}
+
+
+
+
+
+
+/* Frees all memory allocated internally by FFTW, but only if there are no
+ * FFTW plans registered by "misc_fftw_plans_add". */
+void CHARM(misc_fftw_cleanup)(void)
+{
+    if (nplans > 0)
+        return;
+
+
+#if HAVE_OPENMP && FFTW3_OMP
+    FFTW(cleanup_threads)();
+#else
+    FFTW(cleanup)();
+#endif
+
+
+    return;
+}
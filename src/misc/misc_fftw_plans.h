@@ -0,0 +1,32 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_FFTW_PLANS_H__
+#define __MISC_FFTW_PLANS_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(misc_fftw_plans_add)(void);
+
+
+extern void CHARM(misc_fftw_plans_remove)(void);
+
+
+extern void CHARM(misc_fftw_cleanup)(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,164 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#if HAVE_MMAP
+#   include <sys/types.h>
+#   include <sys/stat.h>
+#   include <sys/mman.h>
+#endif
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "misc_fmap.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Initial size of the buffer in bytes if the file is read by "fread".  The
+ * buffer is doubled whenever needed. */
+#undef FMAP_BUFFER
+#define FMAP_BUFFER (1 << 20)
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns the content of the file "fptr" from the current position of the
+ * stream to the end of the file.  After the call, the position of "fptr" is
+ * unspecified.
+ *
+ * If "mmap" is available, regular files are memory-mapped, so that the data
+ * are loaded by the operating system on demand and no copy of the file is
+ * created in the heap.  If "mmap" is not available or fails, the rest of the
+ * file is read by "fread" to a heap-allocated buffer, which works with any
+ * stream.
+ *
+ * The returned structure must be released by "misc_funmap".  On error, "NULL"
+ * is returned and "err" is set. */
+CHARM(fmap) *CHARM(misc_fmap)(FILE *fptr,
+                              CHARM(err) *err)
+{
+    CHARM(fmap) *fmap = (CHARM(fmap) *)malloc(sizeof(CHARM(fmap)));
+    if (fmap == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        return NULL;
+    }
+    fmap->data     = NULL;
+    fmap->size     = 0;
+    fmap->mapped   = 0;
+    fmap->map      = NULL;
+    fmap->map_size = 0;
+
+
+#if HAVE_MMAP
+    /* Memory-mapping of regular files */
+    /* --------------------------------------------------------------------- */
+    struct stat sb;
+#   if HAVE_FSEEKO
+    off_t pos = ftello(fptr);
+#   else
+    long pos = ftell(fptr);
+#   endif
+    if ((pos >= 0) && (fstat(fileno(fptr), &sb) == 0) &&
+        S_ISREG(sb.st_mode) && ((uintmax_t)sb.st_size <= SIZE_MAX) &&
+        ((uintmax_t)pos <= (uintmax_t)sb.st_size))
+    {
+        if ((uintmax_t)pos == (uintmax_t)sb.st_size)
+            /* Nothing to be read */
+            return fmap;
+
+
+        void *addr = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE,
+                          fileno(fptr), 0);
+        if (addr != MAP_FAILED)
+        {
+#   ifdef MADV_SEQUENTIAL
+            /* Only a hint to the kernel, so the return value is ignored */
+            madvise(addr, (size_t)sb.st_size, MADV_SEQUENTIAL);
+#   endif
+            fmap->map      = addr;
+            fmap->map_size = (size_t)sb.st_size;
+            fmap->data     = (const char *)addr + pos;
+            fmap->size     = (size_t)sb.st_size - (size_t)pos;
+            fmap->mapped   = 1;
+
+
+            return fmap;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+#endif
+
+
+    /* Reading the rest of the file to a buffer */
+    /* --------------------------------------------------------------------- */
+    size_t nbuf = FMAP_BUFFER;
+    size_t size = 0;
+    char *buf   = NULL;
+    char *tmp;
+    for (;;)
+    {
+        tmp = (char *)realloc(buf, nbuf * sizeof(char));
+        if (tmp == NULL)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto FAILURE;
+        }
+        buf = tmp;
+
+
+        size += fread(buf + size, sizeof(char), nbuf - size, fptr);
+        if (size < nbuf)
+            break;
+
+
+        if (nbuf > SIZE_MAX / 2)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           "The file is too large to be read to the memory.");
+            goto FAILURE;
+        }
+        nbuf *= 2;
+    }
+
+
+    if (ferror(fptr))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to read the file.");
+        goto FAILURE;
+    }
+
+
+    if (size == 0)
+    {
+        free(buf);
+        return fmap;
+    }
+
+
+    fmap->data = buf;
+    fmap->size = size;
+
+
+    return fmap;
+    /* --------------------------------------------------------------------- */
+
+
+FAILURE:
+    free(buf);
+    free(fmap);
+    return NULL;
+}
@@ -0,0 +1,29 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_FMAP_H__
+#define __MISC_FMAP_H__
+
+
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "misc_fmap_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern CHARM(fmap) *CHARM(misc_fmap)(FILE *,
+                                     CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
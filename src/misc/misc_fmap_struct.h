@@ -0,0 +1,39 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_FMAP_STRUCT_H__
+#define __MISC_FMAP_STRUCT_H__
+
+
+#include <config.h>
+#include <stddef.h>
+#include "../prec.h"
+
+
+/* Structure to store the content of a file (from a given position to the end
+ * of the file) that is either memory-mapped or read to a heap-allocated
+ * buffer */
+typedef struct
+{
+    /* Content of the file (not null-terminated).  "NULL" if there are no
+     * data to be read. */
+    const char *data;
+
+
+    /* Number of bytes in "data" */
+    size_t size;
+
+
+    /* "1" if "data" is memory-mapped, "0" if it was read by "fread" to
+     * a buffer allocated by "malloc" */
+    _Bool mapped;
+
+
+    /* If "mapped" is "1", the address and the number of bytes of the whole
+     * memory-mapped file.  "data" points to somewhere inside this region. */
+    void *map;
+    size_t map_size;
+} CHARM(fmap);
+
+
+#endif
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "../prec.h"
+#include "misc_dtoa.h"
 #include "misc_fprintf_real.h"
 /* ------------------------------------------------------------------------- */
 
@@ -12,10 +13,19 @@
 
 
 
-/* A small function to print a floating point number to a text file.  Not
- * a part of the CHarm's API. */
+/* A small function to print a floating point number to a text file.  If
+ * "format" is "NULL", the shortest representation that reads back to exactly
+ * the same number is printed.  Not a part of the CHarm's API. */
 int CHARM(misc_fprintf_real)(FILE *stream, const char *format, REAL c)
 {
+    if (format == NULL)
+    {
+        char buf[MISC_DTOA_NBUF];
+        CHARM(misc_dtoa)(c, buf);
+        return fprintf(stream, "%s", buf);
+    }
+
+
 #if CHARM_QUAD
 
 
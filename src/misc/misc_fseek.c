@@ -0,0 +1,53 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+#if HAVE_FSEEKO
+#   include <sys/types.h>
+#endif
+#include "../prec.h"
+#include "misc_fseek.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Sets the position of "fptr" to "offset" bytes from the beginning of the
+ * file.  Unlike "fseek", the offset is not limited by the range of "long" if
+ * "fseeko" or "_fseeki64" is available (on 32-bit systems, "configure"
+ * enables the 64-bit "off_t" for "fseeko").  Returns "0" on success and
+ * a non-zero value if "offset" cannot be represented or if the seek
+ * fails. */
+int CHARM(misc_fseek)(FILE *fptr,
+                      uint64_t offset)
+{
+#if HAVE_FSEEKO
+    /* "off_t" is a signed integer type, so its maximum is "2^(b - 1) - 1",
+     * where "b" is the number of its bits */
+    const uint64_t off_max = (sizeof(off_t) >= sizeof(uint64_t)) ?
+                             (uint64_t)INT64_MAX :
+                             ((uint64_t)1 << (sizeof(off_t) * CHAR_BIT - 1))
+                             - 1;
+    if (offset > off_max)
+        return 1;
+
+
+    return fseeko(fptr, (off_t)offset, SEEK_SET);
+#elif HAVE__FSEEKI64
+    if (offset > (uint64_t)INT64_MAX)
+        return 1;
+
+
+    return _fseeki64(fptr, (__int64)offset, SEEK_SET);
+#else
+    if (offset > (uint64_t)LONG_MAX)
+        return 1;
+
+
+    return fseek(fptr, (long)offset, SEEK_SET);
+#endif
+}
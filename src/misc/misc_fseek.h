@@ -0,0 +1,28 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_FSEEK_H__
+#define __MISC_FSEEK_H__
+
+
+#include <config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern int CHARM(misc_fseek)(FILE *, uint64_t);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
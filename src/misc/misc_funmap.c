@@ -0,0 +1,37 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE_MMAP
+#   include <sys/mman.h>
+#endif
+#include "../prec.h"
+#include "misc_funmap.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Releases "fmap" returned by "misc_fmap".  "fmap" may be "NULL". */
+void CHARM(misc_funmap)(CHARM(fmap) *fmap)
+{
+    if (fmap == NULL)
+        return;
+
+
+#if HAVE_MMAP
+    if (fmap->mapped)
+        munmap(fmap->map, fmap->map_size);
+    else
+#endif
+        free((void *)fmap->data);
+
+
+    free(fmap);
+
+
+    return;
+}
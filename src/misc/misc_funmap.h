@@ -0,0 +1,27 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_FUNMAP_H__
+#define __MISC_FUNMAP_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "misc_fmap_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(misc_funmap)(CHARM(fmap) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -72,10 +72,32 @@ void CHARM(misc_print_info)(void)
         printf("sse4.1");
     else
         printf("unsupported value, recompile CHarm");
+    if (CHARM(misc_buildopt_simd_dispatch)())
+        printf(" (selected at runtime)");
     printf(" (vector size %d)", CHARM(misc_buildopt_simd_vector_size)());
     printf("\n");
 
 
+    printf("SIMD supported by the CPU: ");
+    ret = CHARM(misc_cpu_simd)();
+    if (ret == BUILDOPT_SIMD_NONE)
+        printf("none");
+    else if (ret == BUILDOPT_SIMD_AVX)
+        printf("avx");
+    else if (ret == BUILDOPT_SIMD_AVX2)
+        printf("avx2");
+    else if (ret == BUILDOPT_SIMD_AVX512)
+        printf("avx-512");
+    else if (ret == BUILDOPT_SIMD_NEON)
+        printf("neon");
+    else if (ret == BUILDOPT_SIMD_SSE41)
+        printf("sse4.1");
+    if (!CHARM(misc_cpu_simd_check)())
+        printf(" (WARNING: the SIMD instructions of this build are not "
+               "supported)");
+    printf("\n");
+
+
     printf("OpenMP in CHarm: ");
     if (CHARM(misc_buildopt_omp_charm)())
         printf("enabled");
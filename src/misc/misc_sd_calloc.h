@@ -1,7 +1,8 @@
 /* This header file is not a part of API.
  *
  * The macros allocate arrays either statically or dynamically, depending on
- * whether or not we are compiling with MPI support.
+ * whether or not the latitude blocks are set at runtime ("HAVE_RUNTIME_BLOCK";
+ * with MPI or "--enable-runtime-block").
  *
  * */
 
@@ -20,7 +21,7 @@
 /* Initializations */
 /* ------------------------------------------------------------------------- */
 #undef MISC_SD_CALLOC_REAL_SIMD_INIT
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_CALLOC_REAL_SIMD_INIT(x) REAL_SIMD *(x) = NULL;
 #else
 #   define MISC_SD_CALLOC_REAL_SIMD_INIT(x)
@@ -28,7 +29,7 @@
 
 
 #undef MISC_SD_CALLOC_RI_SIMD_INIT
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_CALLOC_RI_SIMD_INIT(x) RI_SIMD *(x) = NULL;
 #else
 #   define MISC_SD_CALLOC_RI_SIMD_INIT(x)
@@ -36,7 +37,7 @@
 
 
 #undef MISC_SD_CALLOC__BOOL_INIT
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_CALLOC__BOOL_INIT(x) _Bool *(x) = NULL;
 #else
 #   define MISC_SD_CALLOC__BOOL_INIT(x)
@@ -47,7 +48,7 @@
 /* Allocation using the error structure */
 /* ------------------------------------------------------------------------- */
 #undef MISC_SD_CALLOC_REAL_SIMD_ERR
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_CALLOC_REAL_SIMD_ERR(x, size_dyn, size_stat, err,          \
                                         goto_label)                           \
     (x) = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN, (size_dyn),       \
@@ -66,7 +67,7 @@
 
 
 #undef MISC_SD_CALLOC_RI_SIMD_ERR
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_CALLOC_RI_SIMD_ERR(x, size_dyn, size_stat, err,            \
                                       goto_label)                             \
     (x) = (RI_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN, (size_dyn),         \
@@ -84,7 +85,7 @@
 
 
 #undef MISC_SD_CALLOC__BOOL_ERR
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_CALLOC__BOOL_ERR(x, size_dyn, size_stat, err, goto_label)  \
     (x) = (_Bool *)CHARM(calloc_aligned)(SIMD_MEMALIGN, (size_dyn),           \
                                          sizeof(RI_SIMD));                    \
@@ -104,7 +105,7 @@
 /* Allocation using the error structure */
 /* ------------------------------------------------------------------------- */
 #undef MISC_SD_CALLOC_REAL_SIMD_E
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_CALLOC_REAL_SIMD_E(x, size_dyn, size_stat, e,              \
                                           goto_label)                         \
     (x) = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN, (size_dyn),       \
@@ -120,7 +121,7 @@
 
 
 #undef MISC_SD_CALLOC_RI_SIMD_E
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_CALLOC_RI_SIMD_E(x, size_dyn, size_stat, e, goto_label)    \
     (x) = (RI_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN, (size_dyn),         \
                                            sizeof(RI_SIMD));                  \
@@ -135,7 +136,7 @@
 
 
 #undef MISC_SD_CALLOC__BOOL_E
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_CALLOC__BOOL_E(x, size_dyn, size_stat, e, goto_label)      \
     (x) = (_Bool *)CHARM(calloc_aligned)(SIMD_MEMALIGN, (size_dyn),           \
                                          sizeof(RI_SIMD));                    \
@@ -153,7 +154,7 @@
 /* Freeing the memory.  The same macro is used for all data types */
 /* ------------------------------------------------------------------------- */
 #undef MISC_SD_FREE
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 #   define MISC_SD_FREE(x) CHARM(free_aligned)(x);
 #else
 #   define MISC_SD_FREE(x)
@@ -0,0 +1,47 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include "../prec.h"
+#include "misc_dtoa.h"
+#include "misc_sprint_real.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Prints "x" to "buf" of "size" characters using "format".  If "format" is
+ * "NULL", the shortest representation that reads back to exactly the same
+ * "x" is used (see "misc_dtoa").  Returned is the same value as from
+ * "snprintf", that is, the number of characters that would have been written
+ * if "size" was large enough, or a negative value on error. */
+int CHARM(misc_sprint_real)(char *buf,
+                            size_t size,
+                            const char *format,
+                            REAL x)
+{
+    if (format == NULL)
+    {
+        if (size >= MISC_DTOA_NBUF)
+            return CHARM(misc_dtoa)(x, buf);
+
+
+        char tmp[MISC_DTOA_NBUF];
+        int n = CHARM(misc_dtoa)(x, tmp);
+        if ((n >= 0) && ((size_t)n < size))
+            memcpy(buf, tmp, (size_t)n + 1);
+
+
+        return n;
+    }
+
+
+#if CHARM_QUAD
+    return quadmath_snprintf(buf, size, format, 70, x);
+#else
+    return snprintf(buf, size, format, x);
+#endif
+}
@@ -0,0 +1,29 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_SPRINT_REAL_H__
+#define __MISC_SPRINT_REAL_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern int CHARM(misc_sprint_real)(char *,
+                                   size_t,
+                                   const char *,
+                                   REAL);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
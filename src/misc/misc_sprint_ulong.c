@@ -0,0 +1,41 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include "../prec.h"
+#include "misc_sprint_ulong.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Prints "x" to "buf" of "size" characters as "snprintf(buf, size, "%lu", x)"
+ * does, but faster.  Returned is the number of characters that would have
+ * been written if "size" was large enough. */
+int CHARM(misc_sprint_ulong)(char *buf,
+                             size_t size,
+                             unsigned long x)
+{
+    /* The digits are first written from the end of "tmp" */
+    char tmp[3 * sizeof(unsigned long)];
+    char *p = tmp + sizeof(tmp);
+    do
+    {
+        *--p = (char)('0' + x % 10);
+        x /= 10;
+    } while (x > 0);
+
+
+    size_t n = (size_t)(tmp + sizeof(tmp) - p);
+    if (n < size)
+    {
+        memcpy(buf, p, n);
+        buf[n] = '\0';
+    }
+
+
+    return (int)n;
+}
@@ -0,0 +1,28 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_SPRINT_ULONG_H__
+#define __MISC_SPRINT_ULONG_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern int CHARM(misc_sprint_ulong)(char *,
+                                    size_t,
+                                    unsigned long);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
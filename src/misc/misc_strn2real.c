@@ -0,0 +1,267 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <float.h>
+#include "../prec.h"
+#include "misc_scanf.h"
+#include "misc_strn2real.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* "MANT_MAX" is the largest integer, up to which all integers are exactly
+ * representable in "REAL" (and in "uint64_t").  "POW10_MAX" is the largest
+ * "k", for which "10^k" is exactly representable in "REAL". */
+#undef MANT_MAX
+#undef POW10_MAX
+#if CHARM_FLOAT
+#   define MANT_MAX (UINT64_C(1) << 24)
+#   define POW10_MAX 10
+#elif CHARM_QUAD
+#   define MANT_MAX UINT64_MAX
+#   define POW10_MAX 48
+#else
+#   define MANT_MAX (UINT64_C(1) << 53)
+#   define POW10_MAX 22
+#endif
+
+
+/* Maximum number of significant digits that are accumulated in "uint64_t"
+ * without an overflow */
+#undef NDIGITS_MAX
+#define NDIGITS_MAX 19
+
+
+/* The fast path relies on the floating point operations to be evaluated in
+ * the precision of their operands */
+#undef FAST_PATH
+#if CHARM_QUAD || (defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0))
+#   define FAST_PATH 1
+#else
+#   define FAST_PATH 0
+#endif
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Converts the first "len" characters of "str" to "REAL".  "str" does not have
+ * to be null-terminated and must not contain any white-space characters.  The
+ * accepted strings and the results are the same as with "misc_str2real"
+ * (including the Fortran's "d" and "D" decimal exponents).  If the conversion
+ * fails, "fail" is set to "1".  Otherwise, "fail" is not modified.
+ *
+ * Decimal numbers with at most "NDIGITS_MAX" significant digits that are
+ * exactly representable as "w * 10^e", where "w" and "10^|e|" are exactly
+ * representable in "REAL", are converted by a single floating point
+ * multiplication or division, so the result is correctly rounded as with
+ * "strtod".  This covers the vast majority of coefficients in "gfc" files.
+ * All other strings (more digits, larger exponents, "inf", "nan", hexadecimal
+ * numbers, etc.) are converted by "strtod" (or its variant for the precision
+ * used).
+ *
+ * The function does not need an error structure, so it is cheap enough to be
+ * called for every entry of huge text files and it is thread-safe. */
+REAL CHARM(misc_strn2real)(const char *str,
+                           size_t len,
+                           int *fail)
+{
+#if FAST_PATH
+    /* Exact powers of ten */
+    static const REAL tens[POW10_MAX + 1] =
+    {
+        PREC(1e0),  PREC(1e1),  PREC(1e2),  PREC(1e3),  PREC(1e4),
+        PREC(1e5),  PREC(1e6),  PREC(1e7),  PREC(1e8),  PREC(1e9),
+        PREC(1e10),
+#   if !CHARM_FLOAT
+                    PREC(1e11), PREC(1e12), PREC(1e13), PREC(1e14),
+        PREC(1e15), PREC(1e16), PREC(1e17), PREC(1e18), PREC(1e19),
+        PREC(1e20), PREC(1e21), PREC(1e22),
+#   endif
+#   if CHARM_QUAD
+                                            PREC(1e23), PREC(1e24),
+        PREC(1e25), PREC(1e26), PREC(1e27), PREC(1e28), PREC(1e29),
+        PREC(1e30), PREC(1e31), PREC(1e32), PREC(1e33), PREC(1e34),
+        PREC(1e35), PREC(1e36), PREC(1e37), PREC(1e38), PREC(1e39),
+        PREC(1e40), PREC(1e41), PREC(1e42), PREC(1e43), PREC(1e44),
+        PREC(1e45), PREC(1e46), PREC(1e47), PREC(1e48)
+#   endif
+    };
+
+
+    const char *p   = str;
+    const char *end = str + len;
+
+
+    /* Sign */
+    _Bool neg = 0;
+    if ((p < end) && ((*p == '+') || (*p == '-')))
+    {
+        neg = (*p == '-');
+        p++;
+    }
+
+
+    /* Significand "w" and the decimal exponent "e".  Zeros that follow
+     * a non-zero digit are not added to "w" until another non-zero digit is
+     * found ("nzero" counts them), so that trailing zeros do not count as
+     * significant digits. */
+    uint64_t w = 0;
+    long e = 0;
+    int nsig = 0;
+    int nzero = 0;
+    int ndigits = 0;
+    unsigned d;
+
+
+    _Bool dot = 0;
+    for (; p < end; p++)
+    {
+        if ((*p == '.') && !dot)
+        {
+            dot = 1;
+            continue;
+        }
+
+
+        d = (unsigned)(*p - '0');
+        if (d > 9)
+            break;
+
+
+        ndigits++;
+        if (dot)
+            e--;
+
+
+        if (d == 0)
+        {
+            if (w != 0)
+                nzero++;
+            continue;
+        }
+
+
+        nsig += nzero + 1;
+        if (nsig > NDIGITS_MAX)
+            goto SLOW_PATH;
+        for (; nzero > 0; nzero--)
+            w *= 10;
+        w = 10 * w + d;
+    }
+    e += nzero;
+
+
+    /* No digits at all, e.g., "inf" or "nan" */
+    if (ndigits == 0)
+        goto SLOW_PATH;
+
+
+    /* Exponent */
+    if ((p < end) && ((*p == 'e') || (*p == 'E') || (*p == 'd') ||
+                      (*p == 'D')))
+    {
+        p++;
+        _Bool eneg = 0;
+        if ((p < end) && ((*p == '+') || (*p == '-')))
+        {
+            eneg = (*p == '-');
+            p++;
+        }
+
+
+        if ((p == end) || ((unsigned)(*p - '0') > 9))
+            goto SLOW_PATH;
+
+
+        long ex = 0;
+        for (; (p < end) && ((d = (unsigned)(*p - '0')) <= 9); p++)
+            if (ex < 100000)
+                ex = 10 * ex + (long)d;
+
+
+        e += eneg ? -ex : ex;
+    }
+
+
+    /* Trailing characters */
+    if (p != end)
+        goto SLOW_PATH;
+
+
+    if (w == 0)
+        return neg ? PREC(-0.0) : PREC(0.0);
+
+
+    /* Move a part of a too large positive exponent to the significand if
+     * possible */
+    while ((e > POW10_MAX) && (w <= MANT_MAX / 10))
+    {
+        w *= 10;
+        e--;
+    }
+
+
+    if ((w > MANT_MAX) || (e > POW10_MAX) || (e < -POW10_MAX))
+        goto SLOW_PATH;
+
+
+    REAL r = (REAL)w;
+    r = (e < 0) ? r / tens[-e] : r * tens[e];
+
+
+    return neg ? -r : r;
+
+
+SLOW_PATH:
+#endif
+    if (len >= SCANF_BUFFER)
+        goto FAILURE;
+
+
+    char buf[SCANF_BUFFER];
+    memcpy(buf, str, len);
+    buf[len] = '\0';
+
+
+    /* The "d" and "D" decimal exponents (see "misc_str2real") */
+    char *match = strchr(buf, 'D');
+    if (match != NULL)
+        *match = 'E';
+    match = strchr(buf, 'd');
+    if (match != NULL)
+        *match = 'e';
+
+
+    char *end_ptr;
+    errno = 0;
+    REAL r_slow = STR2REAL(buf, &end_ptr);
+    if ((end_ptr == buf) || errno)
+        goto FAILURE;
+
+
+    while (*end_ptr != '\0')
+        if (!isspace(*end_ptr++))
+            goto FAILURE;
+
+
+    return r_slow;
+
+
+FAILURE:
+    *fail = 1;
+    return PREC(0.0);
+}
@@ -0,0 +1,64 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <limits.h>
+#include "../prec.h"
+#include "misc_strn2ul.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Converts the first "len" characters of "str" to "unsigned long".  "str" does
+ * not have to be null-terminated and must not contain any white-space
+ * characters.  The accepted strings are the same as those accepted by
+ * "misc_str2ul", that is, an optional plus sign followed by decimal digits.
+ * If the conversion fails, "fail" is set to "1".  Otherwise, "fail" is not
+ * modified.
+ *
+ * Unlike "misc_str2ul", the function does not call "strtoul" and does not
+ * need an error structure, so it is cheap enough to be called for every
+ * entry of huge text files and it is thread-safe. */
+unsigned long CHARM(misc_strn2ul)(const char *str,
+                                  size_t len,
+                                  int *fail)
+{
+    if (len == 0)
+        return 0;
+
+
+    size_t i = 0;
+    if (str[0] == '+')
+        i++;
+    if (i == len)
+        goto FAILURE;
+
+
+    unsigned long ul = 0;
+    unsigned long d;
+    for (; i < len; i++)
+    {
+        d = (unsigned long)((unsigned char)str[i] - '0');
+        if (d > 9)
+            goto FAILURE;
+
+
+        if (ul > (ULONG_MAX - d) / 10)
+            /* Overflow */
+            goto FAILURE;
+
+
+        ul = 10 * ul + d;
+    }
+
+
+    return ul;
+
+
+FAILURE:
+    *fail = 1;
+    return 0;
+}
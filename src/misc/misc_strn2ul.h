@@ -0,0 +1,28 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_STRN2UL_H__
+#define __MISC_STRN2UL_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern unsigned long CHARM(misc_strn2ul)(const char *,
+                                         size_t,
+                                         int *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
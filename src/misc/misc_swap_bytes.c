@@ -0,0 +1,37 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "misc_swap_bytes.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Reverses the order of bytes of each of the "n" elements of the array "x",
+ * each element having "size" bytes.  Useful to convert data between the
+ * little and big endian byte orders. */
+void CHARM(misc_swap_bytes)(void *x,
+                            size_t size,
+                            size_t n)
+{
+    unsigned char *b = (unsigned char *)x;
+    unsigned char tmp;
+
+
+    for (size_t i = 0; i < n; i++, b += size)
+    {
+        for (size_t j = 0; j < size / 2; j++)
+        {
+            tmp             = b[j];
+            b[j]            = b[size - 1 - j];
+            b[size - 1 - j] = tmp;
+        }
+    }
+
+
+    return;
+}
@@ -0,0 +1,29 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MISC_SWAP_BYTES_H__
+#define __MISC_SWAP_BYTES_H__
+
+
+#include <config.h>
+#include <stddef.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(misc_swap_bytes)(void *,
+                                   size_t,
+                                   size_t);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
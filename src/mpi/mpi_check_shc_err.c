@@ -0,0 +1,55 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#if HAVE_MPI
+#   include <mpi.h>
+#else
+#   error "mpi.h required"
+#endif
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "mpi_two_comm_match.h"
+#include "mpi_check_shc_err.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Checks that both "shcs" and "err" are distributed over the same MPI
+ * communicator */
+void CHARM(mpi_check_shc_err)(const CHARM(shc) *shcs,
+                              CHARM(err) *err)
+{
+    if (!shcs->distributed)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "\"shcs\" must be distributed.");
+        return;
+    }
+
+
+    if (!err->distributed)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "\"err\" must be distributed if \"shcs\" is "
+                       "distributed.");
+        return;
+    }
+
+
+    if (!CHARM(mpi_two_comm_match)(shcs->comm, err->comm))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "The MPI communicators \"shcs->comm\" "
+                       "and \"err->comm\" must be "
+                       "identical or congruent (\"MPI_IDENT\" or "
+                       "\"MPI_CONGRUENT\").");
+        return;
+    }
+
+
+    return;
+}
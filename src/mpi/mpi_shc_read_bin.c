@@ -0,0 +1,180 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE_MPI
+#   include <mpi.h>
+#else
+#   error "mpi.h required"
+#endif
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../shc/shc_bin.h"
+#include "../shc/shc_bin_open.h"
+#include "../shc/shc_bin_read_orders.h"
+#include "../shc/shc_read_nmax_only.h"
+#include "../shc/shc_reset_coeffs.h"
+#include "mpi_check_shc_err.h"
+#include "mpi_err_gather.h"
+#include "mpi_err_isdistributed.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+unsigned long CHARM(mpi_shc_read_bin)(const char *pathname,
+                                      unsigned long nmax,
+                                      CHARM(shc) *shcs,
+                                      CHARM(err) *err)
+{
+    /* ===================================================================== */
+    unsigned long nmax_file = CHARM_SHC_NMAX_ERROR;
+    unsigned long *order    = NULL;
+    FILE *fptr              = NULL;
+
+
+    if (!CHARM(mpi_err_isdistributed)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto BARRIER;
+    }
+
+
+    _Bool nmax_only = CHARM(shc_read_nmax_only)(nmax, shcs);
+    if (!nmax_only)
+    {
+        CHARM(mpi_check_shc_err)(shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto BARRIER;
+        }
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Each process opens "pathname" and reads its header */
+    /* ===================================================================== */
+    CHARM(shc_bin_header) hdr;
+    fptr = CHARM(shc_bin_open)(pathname, &hdr, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto BARRIER;
+    }
+
+
+    nmax_file = (unsigned long)hdr.nmax;
+    if (nmax_only)
+        goto BARRIER;
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Check the input parameters */
+    /* ===================================================================== */
+    if (hdr.prec != SHC_BIN_PREC)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "The precision of the coefficients in the binary "
+                       "file differs from the precision, in which CHarm "
+                       "was compiled.");
+        goto BARRIER;
+    }
+
+
+    if (nmax > nmax_file)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Not enough coefficients in the input file "
+                       "for the maximum harmonic degree \"nmax\".");
+        goto BARRIER;
+    }
+
+
+    if (shcs->nmax < nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Too low maximum degree \"shcs->nmax\" to read "
+                       "coefficients up to degree \"nmax\".");
+        goto BARRIER;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Read only the local chunks of orders.  The local chunks may contain
+     * orders above "nmax", so they are clipped to "nmax" and the coefficients
+     * not present in the file remain zero. */
+    /* ===================================================================== */
+    CHARM(shc_reset_coeffs)(shcs);
+
+
+    order = (unsigned long *)malloc((2 * shcs->local_nchunk + 1) *
+                                    sizeof(unsigned long));
+    if (order == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER;
+    }
+
+
+    size_t nchunk = 0;
+    for (size_t j = 0; j < shcs->local_nchunk; j++)
+    {
+        if (shcs->local_order[2 * j] > nmax)
+            continue;
+
+
+        order[2 * nchunk]     = shcs->local_order[2 * j];
+        order[2 * nchunk + 1] = CHARM_MIN(shcs->local_order[2 * j + 1], nmax);
+        nchunk++;
+    }
+
+
+    if (nchunk > 0)
+    {
+        CHARM(shc_bin_read_orders)(fptr, &hdr, nmax, nchunk, order, shcs,
+                                   err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto BARRIER;
+        }
+    }
+
+
+    /* Note that we do not touch "shcs->nmax", "shcs->nc" and "shcs->ns" */
+    shcs->mu = hdr.mu;
+    shcs->r  = hdr.r;
+    /* ===================================================================== */
+
+
+
+
+
+
+BARRIER:
+    if (fptr != NULL)
+        fclose(fptr);
+    free(order);
+    CHARM(mpi_err_gather)(err);
+
+
+    return nmax_file;
+}
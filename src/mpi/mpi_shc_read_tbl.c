@@ -0,0 +1,33 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#if HAVE_MPI
+#   include <mpi.h>
+#else
+#   error "mpi.h required"
+#endif
+#include "../prec.h"
+#include "../err/err_propagate.h"
+#include "mpi_shc_read_text.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+unsigned long CHARM(mpi_shc_read_tbl)(const char *pathname,
+                                      unsigned long nmax,
+                                      CHARM(shc) *shcs,
+                                      CHARM(err) *err)
+{
+    unsigned long nmax_file = CHARM(mpi_shc_read_text)(MPI_SHC_READ_TEXT_TBL,
+                                                       pathname, nmax, NULL,
+                                                       shcs, err);
+    if (!CHARM(err_isempty)(err))
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+    return nmax_file;
+}
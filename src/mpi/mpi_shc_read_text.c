@@ -0,0 +1,1442 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#if HAVE_FSEEKO
+#   include <sys/types.h>
+#endif
+#if HAVE_MPI
+#   include <mpi.h>
+#else
+#   error "mpi.h required"
+#endif
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../misc/misc_scanf.h"
+#include "../misc/misc_strn2ul.h"
+#include "../misc/misc_str2real.h"
+#include "../misc/misc_fseek.h"
+#include "../shc/shc_read_nmax_only.h"
+#include "../shc/shc_read_mtdt.h"
+#include "../shc/shc_reset_coeffs.h"
+#include "../shc/shc_read_gfc.h"
+#include "../shc/shc_ranges_struct.h"
+#include "../shc/shc_read_tbl_core.h"
+#include "../shc/shc_read_dov_core.h"
+#include "../shc/shc_read_gfc_core.h"
+#include "mpi_check_shc_err.h"
+#include "mpi_err_gather.h"
+#include "mpi_err_isdistributed.h"
+#include "mpi_real.h"
+#include "mpi_shc_read_text.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Maximum number of entries of a line that are needed to find the MPI process
+ * that reads the line */
+#undef NTOKENS
+#define NTOKENS (4)
+
+
+/* Initial number of byte ranges that can be stored by a process.  If needed,
+ * the number is doubled. */
+#undef NRANGES_INIT
+#define NRANGES_INIT (1024)
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Calls the reader of the text file "pathname" of the "format".  "ranges" are
+ * ignored with "mtx" files. */
+static unsigned long read_text(int format,
+                               const char *pathname,
+                               unsigned long nmax,
+                               const char *epoch,
+                               const CHARM(shc_ranges) *ranges,
+                               CHARM(shc) *shcs,
+                               CHARM(err) *err)
+{
+    switch (format)
+    {
+    case MPI_SHC_READ_TEXT_MTX:
+        return CHARM(shc_read_mtx)(pathname, nmax, shcs, err);
+    case MPI_SHC_READ_TEXT_TBL:
+        return CHARM(shc_read_tbl_core)(pathname, nmax, ranges, shcs, err);
+    case MPI_SHC_READ_TEXT_DOV:
+        return CHARM(shc_read_dov_core)(pathname, nmax, ranges, shcs, err);
+    default:
+        return CHARM(shc_read_gfc_core)(pathname, nmax, epoch, ranges, shcs,
+                                        NULL, err);
+    }
+}
+
+
+
+
+
+
+/* Copies the error stored in the non-distributed "err_loc" to "err" */
+static void copy_err(const CHARM(err) *err_loc,
+                     CHARM(err) *err)
+{
+    CHARM(err_set)(err, err_loc->file[0], err_loc->line[0], err_loc->func[0],
+                   err_loc->code, err_loc->msg);
+    for (size_t i = 1; i < err_loc->level; i++)
+        CHARM(err_propagate)(err, err_loc->file[i], err_loc->line[i],
+                             err_loc->func[i]);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Returns the size of the file "fptr" in bytes or "UINT64_MAX" if the size
+ * cannot be determined */
+static uint64_t file_size(FILE *fptr)
+{
+#if HAVE_FSEEKO
+    if (fseeko(fptr, 0, SEEK_END) != 0)
+        return UINT64_MAX;
+    off_t pos = ftello(fptr);
+#elif HAVE__FSEEKI64
+    if (_fseeki64(fptr, 0, SEEK_END) != 0)
+        return UINT64_MAX;
+    __int64 pos = _ftelli64(fptr);
+#else
+    if (fseek(fptr, 0, SEEK_END) != 0)
+        return UINT64_MAX;
+    long pos = ftell(fptr);
+#endif
+
+
+    return (pos < 0) ? UINT64_MAX : (uint64_t)pos;
+}
+
+
+
+
+
+
+/* Returns the offset of the "k"th of the "size" slices of a file of "fsize"
+ * bytes.  The lengths of the slices differ at most by one byte. */
+static uint64_t slice_start(uint64_t fsize,
+                            int size,
+                            int k)
+{
+    uint64_t q = fsize / (uint64_t)size;
+    uint64_t r = fsize % (uint64_t)size;
+
+
+    return q * (uint64_t)k + CHARM_MIN((uint64_t)k, r);
+}
+
+
+
+
+
+
+/* Reads the lines of the text file "fptr" of "fsize" bytes that belong to the
+ * calling process of "comm".
+ *
+ * The file is split into "size" byte slices of nearly equal lengths (see
+ * "slice_start") and each line belongs to the process, the slice of which
+ * holds the first character of the line.  Each process reads only its slice.
+ * The bytes of the slice up to the first new line character are the end of
+ * a line of some previous process, so they are sent to that process.  The
+ * line of the process that crosses the end of the slice is in turn completed
+ * by the bytes received from the next processes.
+ *
+ * On return, "*lines" points to "*nlines" bytes of the complete lines of the
+ * process, which start at the offset "*off" of the file.  "*buf" must be
+ * freed by the caller. */
+static void read_lines(FILE *fptr,
+                       uint64_t fsize,
+                       MPI_Comm comm,
+                       char **buf,
+                       const char **lines,
+                       size_t *nlines,
+                       uint64_t *off,
+                       CHARM(err) *err)
+{
+    /* --------------------------------------------------------------------- */
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+
+    *buf    = NULL;
+    *lines  = NULL;
+    *nlines = 0;
+    *off    = 0;
+
+
+    uint64_t *info   = NULL;
+    MPI_Request *req = NULL;
+
+
+    const uint64_t lo = slice_start(fsize, size, rank);
+    const uint64_t hi = slice_start(fsize, size, rank + 1);
+
+
+    /* The byte preceding the slice tells whether a line starts at "lo" */
+    const uint64_t lo0 = (lo > 0) ? lo - 1 : 0;
+    const size_t nslice = (size_t)(hi - lo0);
+    const size_t nbytes = (size_t)(hi - lo);
+
+
+    info = (uint64_t *)malloc(2 * size * sizeof(uint64_t));
+    req  = (MPI_Request *)malloc(size * sizeof(MPI_Request));
+    if ((info == NULL) || (req == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER;
+    }
+
+
+    if ((uint64_t)nslice != hi - lo0)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Too large input file to be read by this number of "
+                       "MPI processes.");
+        goto BARRIER;
+    }
+
+
+    *buf = (char *)malloc(nslice + 1);
+    if (*buf == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER;
+    }
+
+
+    if ((nslice > 0) && (CHARM(misc_fseek)(fptr, lo0) ||
+                         (fread(*buf, sizeof(char), nslice, fptr) != nslice)))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to read the input file.");
+        goto BARRIER;
+    }
+
+
+BARRIER:
+    if (!CHARM(mpi_err_isempty)(err))
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Tell all processes whether a line starts in the slice ("info[2 * i]")
+     * and the number of bytes before the first line starting in the slice
+     * ("info[2 * i + 1]") */
+    /* --------------------------------------------------------------------- */
+    const char *slice = *buf + (lo - lo0);
+    uint64_t head = 0;
+    if ((lo > 0) && ((*buf)[0] != '\n'))
+    {
+        const char *nl = (const char *)memchr(slice, '\n', nbytes);
+        head = (nl == NULL) ? nbytes : (uint64_t)(nl + 1 - slice);
+    }
+
+
+    uint64_t loc[2] = {(head < nbytes) ? 1 : 0, head};
+    MPI_Allgather(loc, 2, MPI_UINT64_T, info, 2, MPI_UINT64_T, comm);
+
+
+    for (int i = 0; i < size; i++)
+    {
+        if (info[2 * i + 1] > INT_MAX)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Too long line of the input file to be sent "
+                           "to another MPI process.");
+            goto EXIT;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Exchange the lines crossing the ends of the slices.  The end of the
+     * line that crosses the end of the slice is held by the next processes up
+     * to the first one, in which a line starts. */
+    /* --------------------------------------------------------------------- */
+    size_t nin = 0;
+    int nreq   = 0;
+    if (loc[0])
+    {
+        for (int j = rank + 1; j < size; j++)
+        {
+            nin += (size_t)info[2 * j + 1];
+            if (info[2 * j])
+                break;
+        }
+    }
+
+
+    if (nin > 0)
+    {
+        char *tmp = (char *)realloc(*buf, nslice + nin);
+        if (tmp == NULL)
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+        else
+        {
+            *buf  = tmp;
+            slice = *buf + (lo - lo0);
+        }
+    }
+    if (!CHARM(mpi_err_isempty)(err))
+        goto EXIT;
+
+
+    if (loc[0])
+    {
+        char *dst = *buf + nslice;
+        for (int j = rank + 1; j < size; j++)
+        {
+            if (info[2 * j + 1] > 0)
+            {
+                MPI_Irecv(dst, (int)info[2 * j + 1], MPI_CHAR, j, 0, comm,
+                          &req[nreq++]);
+                dst += info[2 * j + 1];
+            }
+            if (info[2 * j])
+                break;
+        }
+    }
+
+
+    /* The bytes before the first line starting in the slice are sent to the
+     * last previous process, in which a line starts.  This is at latest the
+     * root process, the slice of which starts with the first line. */
+    if (head > 0)
+    {
+        int i = rank - 1;
+        while (!info[2 * i])
+            i--;
+        MPI_Isend(slice, (int)head, MPI_CHAR, i, 0, comm, &req[nreq++]);
+    }
+
+
+    MPI_Waitall(nreq, req, MPI_STATUSES_IGNORE);
+
+
+    if (loc[0])
+    {
+        *lines  = slice + head;
+        *nlines = nbytes - (size_t)head + nin;
+        *off    = lo + head;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+EXIT:
+    free(info);
+    free(req);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Splits the line "line" of "len" characters into at most "NTOKENS" entries
+ * separated by white-space characters in the same way as "sscanf" with the
+ * "SCANF_SFS(SCANF_WIDTH)" conversion specifiers does.  Pointers to the
+ * entries and their lengths are stored in "str" and "nstr", respectively.
+ * Returned is the number of the entries found. */
+static int split_line(const char *line,
+                      size_t len,
+                      const char **str,
+                      size_t *nstr)
+{
+    const char *p   = line;
+    const char *end = line + len;
+    int ns = 0;
+
+
+    while (ns < NTOKENS)
+    {
+        while ((p < end) && isspace((unsigned char)*p))
+            p++;
+        if ((p == end) || (*p == '\0'))
+            break;
+
+
+        str[ns] = p;
+        while ((p < end) && (*p != '\0') && !isspace((unsigned char)*p) &&
+               ((size_t)(p - str[ns]) < SCANF_WIDTH))
+            p++;
+        nstr[ns] = (size_t)(p - str[ns]);
+        ns++;
+    }
+
+
+    return ns;
+}
+
+
+
+
+
+
+/* Returns "1" if the first "nstr" characters of "str" are equal to the
+ * null-terminated string "key" and "0" otherwise */
+static _Bool str_is(const char *str,
+                    size_t nstr,
+                    const char *key)
+{
+    return (strlen(key) == nstr) && (memcmp(str, key, nstr) == 0);
+}
+
+
+
+
+
+
+/* Returns the MPI process that reads the line "line" of "len" characters from
+ * the data section of a "tbl", "dov" or "gfc" file, that is, the owner of the
+ * order of the line as given by "owner".
+ *
+ * Returned is "-1" if the line is not to be read by any process.  These are
+ * lines of degrees above "nmax", which are skipped by the readers anyway, and
+ * comments of "gfc" files.  Lines that cannot be assigned to an order are
+ * assigned to the root process, so that its reader reports the error. */
+static int line_owner(int format,
+                      const char *line,
+                      size_t len,
+                      unsigned long nmax,
+                      unsigned long nmax_shcs,
+                      const int *owner)
+{
+    const char *str[NTOKENS];
+    size_t nstr[NTOKENS];
+    int ns = split_line(line, len, str, nstr);
+
+
+    /* Index of the entry with the harmonic degree and the minimum number of
+     * entries of valid lines */
+    int in    = 0;
+    int ns_ok = 3;
+    if (format == MPI_SHC_READ_TEXT_GFC)
+    {
+        if ((ns == 0) ||
+            (!str_is(str[0], nstr[0], SHC_READ_GFC_GFC) &&
+             !str_is(str[0], nstr[0], SHC_READ_GFC_GFCT) &&
+             !str_is(str[0], nstr[0], SHC_READ_GFC_TRND) &&
+             !str_is(str[0], nstr[0], SHC_READ_GFC_DOT) &&
+             !str_is(str[0], nstr[0], SHC_READ_GFC_ASIN) &&
+             !str_is(str[0], nstr[0], SHC_READ_GFC_ACOS)))
+            /* Comment */
+            return -1;
+
+
+        in    = 1;
+        ns_ok = 4;
+    }
+    if (ns < ns_ok)
+        return 0;
+
+
+    int fail        = 0;
+    unsigned long n = CHARM(misc_strn2ul)(str[in], nstr[in], &fail);
+    if (fail)
+        return 0;
+    if (n > nmax)
+        return -1;
+
+
+    /* The orders of the "snm" coefficients in "dov" files are negative.  As
+     * in "shc_read_dov_core", the first minus sign is replaced by the plus
+     * sign. */
+    const char *m_str = str[in + 1];
+    char m_buf[SCANF_BUFFER];
+    if (format == MPI_SHC_READ_TEXT_DOV)
+    {
+        memcpy(m_buf, m_str, nstr[in + 1]);
+        char *m_sign = (char *)memchr(m_buf, '-', nstr[in + 1]);
+        if (m_sign != NULL)
+            *m_sign = '+';
+        m_str = m_buf;
+    }
+
+
+    unsigned long m = CHARM(misc_strn2ul)(m_str, nstr[in + 1], &fail);
+    if (fail || (m > nmax_shcs))
+        return 0;
+
+
+    return owner[m];
+}
+
+
+
+
+
+
+/* Splits the lines "lines" of "nlines" bytes, which start at the offset "off"
+ * of a "tbl", "dov" or "gfc" file, into byte ranges of neighbouring lines of
+ * the same owner of the order as given by "owner" (see "line_owner").  The
+ * ranges are sent to their owners and the ranges received by the calling
+ * process are stored in "ranges".  The ranges of each process are ordered as
+ * in the file. */
+static void scatter_ranges(int format,
+                           const char *lines,
+                           size_t nlines,
+                           uint64_t off,
+                           unsigned long nmax,
+                           unsigned long nmax_shcs,
+                           const int *owner,
+                           MPI_Comm comm,
+                           CHARM(shc_ranges) *ranges,
+                           CHARM(err) *err)
+{
+    /* --------------------------------------------------------------------- */
+    int size;
+    MPI_Comm_size(comm, &size);
+
+
+    uint64_t *run_off  = NULL;
+    int *run_rank      = NULL;
+    uint64_t *sbuf     = NULL;
+    int *scnt          = NULL;
+    int *sdispls       = NULL;
+    int *rcnt          = NULL;
+    int *rdispls       = NULL;
+    size_t nruns       = 0;
+    size_t nruns_max   = NRANGES_INIT;
+    const char *end    = lines + nlines;
+    const char *p, *nl, *next;
+
+
+    run_off  = (uint64_t *)malloc(2 * nruns_max * sizeof(uint64_t));
+    run_rank = (int *)malloc(nruns_max * sizeof(int));
+    scnt     = (int *)calloc(size, sizeof(int));
+    sdispls  = (int *)malloc(size * sizeof(int));
+    rcnt     = (int *)malloc(size * sizeof(int));
+    rdispls  = (int *)malloc(size * sizeof(int));
+    if ((run_off == NULL) || (run_rank == NULL) || (scnt == NULL) ||
+        (sdispls == NULL) || (rcnt == NULL) || (rdispls == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER_1;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Find the end of the header.  The header of "tbl" and "dov" files is the
+     * first line of the file.  The header of "gfc" files ends with the first
+     * line starting with the "SHC_READ_GFC_EOH" keyword. */
+    /* --------------------------------------------------------------------- */
+    uint64_t eoh = UINT64_MAX;
+    for (p = lines; p < end; p = next)
+    {
+        nl   = (const char *)memchr(p, '\n', (size_t)(end - p));
+        next = (nl == NULL) ? end : nl + 1;
+
+
+        if (format == MPI_SHC_READ_TEXT_GFC)
+        {
+            const char *str[NTOKENS];
+            size_t nstr[NTOKENS];
+            if ((split_line(p, (size_t)(next - p), str, nstr) > 0) &&
+                str_is(str[0], nstr[0], SHC_READ_GFC_EOH))
+            {
+                eoh = off + (uint64_t)(next - lines);
+                break;
+            }
+        }
+        else
+        {
+            if (off == 0)
+                eoh = (uint64_t)(next - lines);
+            break;
+        }
+    }
+
+
+BARRIER_1:
+    if (!CHARM(mpi_err_isempty)(err))
+        goto EXIT;
+
+
+    MPI_Allreduce(MPI_IN_PLACE, &eoh, 1, MPI_UINT64_T, MPI_MIN, comm);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Each line of the data section is assigned to the owner of its order.
+     * Neighbouring lines of the same owner make a single byte range
+     * ("run"). */
+    /* --------------------------------------------------------------------- */
+    for (p = lines; p < end; p = next)
+    {
+        nl   = (const char *)memchr(p, '\n', (size_t)(end - p));
+        next = (nl == NULL) ? end : nl + 1;
+
+
+        uint64_t begin = off + (uint64_t)(p - lines);
+        if (begin < eoh)
+            continue;
+
+
+        int i = line_owner(format, p, (size_t)(next - p), nmax, nmax_shcs,
+                           owner);
+        if (i < 0)
+            continue;
+
+
+        if ((nruns > 0) && (run_rank[nruns - 1] == i) &&
+            (run_off[2 * nruns - 1] == begin))
+        {
+            run_off[2 * nruns - 1] = off + (uint64_t)(next - lines);
+            continue;
+        }
+
+
+        if (nruns == nruns_max)
+        {
+            nruns_max *= 2;
+            uint64_t *tmp_off = (uint64_t *)realloc(run_off, 2 * nruns_max *
+                                                    sizeof(uint64_t));
+            if (tmp_off == NULL)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                               CHARM_ERR_MALLOC_FAILURE);
+                goto BARRIER_2;
+            }
+            run_off = tmp_off;
+
+
+            int *tmp_rank = (int *)realloc(run_rank, nruns_max * sizeof(int));
+            if (tmp_rank == NULL)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                               CHARM_ERR_MALLOC_FAILURE);
+                goto BARRIER_2;
+            }
+            run_rank = tmp_rank;
+        }
+
+
+        run_off[2 * nruns]     = begin;
+        run_off[2 * nruns + 1] = off + (uint64_t)(next - lines);
+        run_rank[nruns]        = i;
+        nruns++;
+    }
+
+
+    /* Sort the runs by the processes, keeping the order of the file */
+    for (size_t k = 0; k < nruns; k++)
+    {
+        if (scnt[run_rank[k]] > INT_MAX - 2)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Too many byte ranges of the input file to be "
+                           "sent to an MPI process.");
+            goto BARRIER_2;
+        }
+        scnt[run_rank[k]] += 2;
+    }
+
+
+    size_t displ = 0;
+    for (int i = 0; i < size; i++)
+    {
+        sdispls[i] = (int)displ;
+        displ     += (size_t)scnt[i];
+        if (displ > INT_MAX)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Too many byte ranges of the input file to be "
+                           "sent to MPI processes.");
+            goto BARRIER_2;
+        }
+    }
+
+
+    sbuf = (uint64_t *)malloc((2 * nruns + 1) * sizeof(uint64_t));
+    if (sbuf == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER_2;
+    }
+
+
+    /* "sdispls" is used as the position of the next range of the processes
+     * and is restored afterwards */
+    for (size_t k = 0; k < nruns; k++)
+    {
+        int i = run_rank[k];
+        sbuf[sdispls[i]]     = run_off[2 * k];
+        sbuf[sdispls[i] + 1] = run_off[2 * k + 1];
+        sdispls[i] += 2;
+    }
+    for (int i = 0; i < size; i++)
+        sdispls[i] -= scnt[i];
+
+
+BARRIER_2:
+    if (!CHARM(mpi_err_isempty)(err))
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Send the runs to their owners */
+    /* --------------------------------------------------------------------- */
+    MPI_Alltoall(scnt, 1, MPI_INT, rcnt, 1, MPI_INT, comm);
+
+
+    displ = 0;
+    for (int i = 0; i < size; i++)
+    {
+        rdispls[i] = (int)displ;
+        displ     += (size_t)rcnt[i];
+        if (displ > INT_MAX)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Too many byte ranges of the input file to be "
+                           "received by an MPI process.");
+            goto BARRIER_3;
+        }
+    }
+
+
+    ranges->n   = displ / 2;
+    ranges->off = (uint64_t *)malloc((displ + 1) * sizeof(uint64_t));
+    if (ranges->off == NULL)
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+
+
+BARRIER_3:
+    if (!CHARM(mpi_err_isempty)(err))
+        goto EXIT;
+
+
+    MPI_Alltoallv(sbuf, scnt, sdispls, MPI_UINT64_T, ranges->off, rcnt,
+                  rdispls, MPI_UINT64_T, comm);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+EXIT:
+    free(run_off);
+    free(run_rank);
+    free(sbuf);
+    free(scnt);
+    free(sdispls);
+    free(rcnt);
+    free(rdispls);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Returns the order of the entry in the "col"th column of the "row"th row of
+ * "mtx" files.  The "row"th row holds the "cnm" coefficients of the orders
+ * "0, 1, ..., row" and the "snm" coefficients of the order "row + 1". */
+static unsigned long mtx_order(unsigned long row,
+                               unsigned long col)
+{
+    return (row >= col) ? col : row + 1;
+}
+
+
+
+
+
+
+/* Reads the "mtx" file "fptr" up to degree "nmax" to the view "shcs" of
+ * a distributed structure (see "mpi_shc_read_text").  "lines" of "nlines"
+ * bytes are the lines of the calling process that start at the offset "off"
+ * of the file (see "read_lines").
+ *
+ * Each row of "mtx" files holds coefficients of many orders, so no byte ranges
+ * of the local orders exist.  Instead, each process parses the rows among its
+ * lines, that is, up to the first row of the next process, and sends the
+ * coefficients to the owners of their orders as given by "owner".  Returned
+ * is the maximum harmonic degree of the file. */
+static unsigned long read_mtx(FILE *fptr,
+                              const char *lines,
+                              size_t nlines,
+                              uint64_t off,
+                              unsigned long nmax,
+                              const int *owner,
+                              MPI_Comm comm,
+                              CHARM(shc) *shcs,
+                              CHARM(err) *err)
+{
+    /* --------------------------------------------------------------------- */
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+
+    unsigned long nmax_file = CHARM_SHC_NMAX_ERROR;
+    REAL mu_file, r_file;
+    uint64_t *nrows_all = NULL;
+    REAL *sbuf          = NULL;
+    REAL *rbuf          = NULL;
+    int *scnt           = NULL;
+    int *sdispls        = NULL;
+    int *rcnt           = NULL;
+    int *rdispls        = NULL;
+    const char *end     = lines + nlines;
+    const char *p, *nl, *next;
+
+
+    nrows_all = (uint64_t *)malloc(size * sizeof(uint64_t));
+    scnt      = (int *)malloc(size * sizeof(int));
+    sdispls   = (int *)malloc(size * sizeof(int));
+    rcnt      = (int *)malloc(size * sizeof(int));
+    rdispls   = (int *)malloc(size * sizeof(int));
+    if ((nrows_all == NULL) || (scnt == NULL) || (sdispls == NULL) ||
+        (rcnt == NULL) || (rdispls == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER_1;
+    }
+
+
+    /* The metadata are in the first line of the file */
+    if (CHARM(misc_fseek)(fptr, 0))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to seek in the \"mtx\" file.");
+        goto BARRIER_1;
+    }
+
+
+    CHARM(shc_read_mtdt)(fptr, &nmax_file, &mu_file, &r_file, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto BARRIER_1;
+    }
+
+
+    if (shcs->nmax < nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Too low maximum degree \"shcs->nmax\" to read "
+                       "coefficients up to degree \"nmax\".");
+        goto BARRIER_1;
+    }
+
+
+    if (nmax_file < nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Too low maximum degree inside the input file to read "
+                       "coefficients up to degree \"nmax\".");
+        goto BARRIER_1;
+    }
+
+
+BARRIER_1:
+    if (!CHARM(mpi_err_isempty)(err))
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* The rows of the matrix are the non-empty lines after the first line.
+     * The processes get the number of the rows of all processes, so that each
+     * process knows which rows are parsed by which process. */
+    /* --------------------------------------------------------------------- */
+    uint64_t nrows = 0;
+    for (p = lines; p < end; p = next)
+    {
+        nl   = (const char *)memchr(p, '\n', (size_t)(end - p));
+        next = (nl == NULL) ? end : nl + 1;
+
+
+        const char *str[NTOKENS];
+        size_t nstr[NTOKENS];
+        if (((off > 0) || (p > lines)) &&
+            (split_line(p, (size_t)(next - p), str, nstr) > 0))
+            nrows++;
+    }
+
+
+    MPI_Allgather(&nrows, 1, MPI_UINT64_T, nrows_all, 1, MPI_UINT64_T, comm);
+
+
+    uint64_t row0 = 0, nrows_sum = 0;
+    for (int i = 0; i < size; i++)
+    {
+        if (i == rank)
+            row0 = nrows_sum;
+        nrows_sum += nrows_all[i];
+    }
+
+
+    if (nrows_sum <= nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Too few rows in the input file to read spherical "
+                       "harmonic coefficients up to degree \"nmax\".");
+        goto EXIT;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Count the coefficients to be sent to the processes */
+    /* --------------------------------------------------------------------- */
+    for (int i = 0; i < size; i++)
+        scnt[i] = 0;
+
+
+    size_t displ = 0;
+    for (uint64_t row = row0; (row < row0 + nrows) && (row <= nmax); row++)
+    {
+        for (unsigned long col = 0; col <= nmax; col++)
+        {
+            int i = owner[mtx_order(row, col)];
+            if (scnt[i] == INT_MAX)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO,
+                               "Too many coefficients to be sent to an MPI "
+                               "process.");
+                goto BARRIER_2;
+            }
+            scnt[i]++;
+        }
+    }
+
+
+    for (int i = 0; i < size; i++)
+    {
+        sdispls[i] = (int)displ;
+        displ     += (size_t)scnt[i];
+        if (displ > INT_MAX)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Too many coefficients to be sent to MPI "
+                           "processes.");
+            goto BARRIER_2;
+        }
+    }
+
+
+    sbuf = (REAL *)malloc((displ + 1) * sizeof(REAL));
+    if (sbuf == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER_2;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Parse the rows up to degree "nmax".  "sdispls" is used as the position
+     * of the next coefficient of the processes and is restored afterwards. */
+    /* --------------------------------------------------------------------- */
+    char entry[SCANF_BUFFER];
+    uint64_t row = row0;
+    for (p = lines; (p < end) && (row <= nmax); p = next)
+    {
+        nl   = (const char *)memchr(p, '\n', (size_t)(end - p));
+        next = (nl == NULL) ? end : nl + 1;
+
+
+        const char *str[NTOKENS];
+        size_t nstr[NTOKENS];
+        if (((off == 0) && (p == lines)) ||
+            (split_line(p, (size_t)(next - p), str, nstr) == 0))
+            continue;
+
+
+        const char *q = p;
+        for (unsigned long col = 0; col <= nmax; col++)
+        {
+            while ((q < next) && isspace((unsigned char)*q))
+                q++;
+            if (q == next)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO,
+                               "Too few columns to read spherical harmonic "
+                               "coefficients up to degree \"nmax\".");
+                goto BARRIER_2;
+            }
+
+
+            size_t len = 0;
+            while ((q < next) && !isspace((unsigned char)*q) &&
+                   (len < SCANF_WIDTH))
+                entry[len++] = *q++;
+            entry[len] = '\0';
+            if ((q < next) && !isspace((unsigned char)*q))
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO,
+                               "Too long entry in the input file.");
+                goto BARRIER_2;
+            }
+
+
+            int i = owner[mtx_order(row, col)];
+            sbuf[sdispls[i]++] = CHARM(misc_str2real)(entry, "Failed to "
+                                                      "convert an entry from "
+                                                      "the input file to the "
+                                                      "\"REAL\" data format.",
+                                                      err);
+            if (!CHARM(err_isempty)(err))
+            {
+                CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                goto BARRIER_2;
+            }
+        }
+
+
+        row++;
+    }
+    for (int i = 0; i < size; i++)
+        sdispls[i] -= scnt[i];
+
+
+BARRIER_2:
+    if (!CHARM(mpi_err_isempty)(err))
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Send the coefficients to the owners of their orders */
+    /* --------------------------------------------------------------------- */
+    MPI_Alltoall(scnt, 1, MPI_INT, rcnt, 1, MPI_INT, comm);
+
+
+    displ = 0;
+    for (int i = 0; i < size; i++)
+    {
+        rdispls[i] = (int)displ;
+        displ     += (size_t)rcnt[i];
+    }
+
+
+    rbuf = (REAL *)malloc((displ + 1) * sizeof(REAL));
+    if (rbuf == NULL)
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+    if (!CHARM(mpi_err_isempty)(err))
+        goto EXIT;
+
+
+    MPI_Alltoallv(sbuf, scnt, sdispls, CHARM_MPI_REAL, rbuf, rcnt, rdispls,
+                  CHARM_MPI_REAL, comm);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Store the received coefficients.  The coefficients from each process
+     * are ordered by the rows and the columns of the matrix. */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc_reset_coeffs)(shcs);
+    shcs->mu = mu_file;
+    shcs->r  = r_file;
+
+
+    size_t k     = 0;
+    uint64_t row_i = 0;
+    for (int i = 0; i < size; i++)
+    {
+        for (row = row_i; (row < row_i + nrows_all[i]) && (row <= nmax);
+             row++)
+        {
+            for (unsigned long col = 0; col <= nmax; col++)
+            {
+                if (owner[mtx_order(row, col)] != rank)
+                    continue;
+
+
+                if (row >= col)
+                    shcs->c[col][row - col] = rbuf[k++];
+                else
+                    shcs->s[row + 1][col - row - 1] = rbuf[k++];
+            }
+        }
+
+
+        row_i += nrows_all[i];
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+EXIT:
+    free(nrows_all);
+    free(sbuf);
+    free(rbuf);
+    free(scnt);
+    free(sdispls);
+    free(rcnt);
+    free(rdispls);
+
+
+    return nmax_file;
+}
+
+
+
+
+
+
+/* Reads the text file "pathname" of the "format" to the distributed "shcs".
+ *
+ * Text files have no index, so the file is split into byte slices of nearly
+ * equal lengths and each process scans the lines starting in its slice (see
+ * "read_lines").  The lines of "tbl", "dov" and "gfc" files are assigned to
+ * the owners of their orders and each process receives the byte ranges of its
+ * lines from all processes.  Each process then parses only its own ranges by
+ * the serial reader, which is given a non-distributed view of "shcs".  The
+ * orders that are not stored locally are "NULL" in the view and are skipped
+ * by the reader.
+ *
+ * Each row of "mtx" files holds coefficients of many orders, so each process
+ * parses the rows in its slice and sends the coefficients to the owners of
+ * their orders (see "read_mtx").
+ *
+ * No process therefore reads the whole file (except for the header) and the
+ * memory requirements scale with the number of processes. */
+unsigned long CHARM(mpi_shc_read_text)(int format,
+                                       const char *pathname,
+                                       unsigned long nmax,
+                                       const char *epoch,
+                                       CHARM(shc) *shcs,
+                                       CHARM(err) *err)
+{
+    /* ===================================================================== */
+    unsigned long nmax_file  = CHARM_SHC_NMAX_ERROR;
+    CHARM(err) *err_loc      = NULL;
+    int *nchunk_all          = NULL;
+    int *cnt                 = NULL;
+    int *displs              = NULL;
+    unsigned long *order_all = NULL;
+    int *owner               = NULL;
+    FILE *fptr               = NULL;
+    char *buf                = NULL;
+    CHARM(shc_ranges) ranges;
+    ranges.n                 = 0;
+    ranges.off               = NULL;
+
+
+    if (!CHARM(mpi_err_isdistributed)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto BARRIER;
+    }
+
+
+    _Bool nmax_only = CHARM(shc_read_nmax_only)(nmax, shcs);
+    if (!nmax_only)
+    {
+        CHARM(mpi_check_shc_err)(shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto BARRIER;
+        }
+    }
+
+
+    /* The serial readers require a non-distributed "err" */
+    err_loc = CHARM(err_init)();
+    if (err_loc == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Query the maximum harmonic degree only */
+    /* ===================================================================== */
+    if (nmax_only)
+    {
+        nmax_file = read_text(format, pathname, nmax, epoch, NULL, NULL,
+                              err_loc);
+        if (!CHARM(err_isempty)(err_loc))
+        {
+            copy_err(err_loc, err);
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        }
+
+
+        goto BARRIER;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Gather the chunks of orders of all processes at all processes and find
+     * the owners of the orders */
+    /* ===================================================================== */
+    MPI_Comm comm = shcs->comm;
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+
+    if (shcs->local_nchunk > INT_MAX / 2)
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Too many local chunks of orders.");
+    int nchunk = (int)shcs->local_nchunk;
+
+
+    nchunk_all = (int *)malloc(size * sizeof(int));
+    cnt        = (int *)malloc(size * sizeof(int));
+    displs     = (int *)malloc(size * sizeof(int));
+    owner      = (int *)calloc(shcs->nmax + 1, sizeof(int));
+    if ((nchunk_all == NULL) || (cnt == NULL) || (displs == NULL) ||
+        (owner == NULL))
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+    if (!CHARM(mpi_err_isempty)(err))
+        goto BARRIER;
+
+
+    MPI_Allgather(&nchunk, 1, MPI_INT, nchunk_all, 1, MPI_INT, comm);
+
+
+    size_t nchunk_sum = 0;
+    for (int i = 0; i < size; i++)
+    {
+        cnt[i]      = 2 * nchunk_all[i];
+        displs[i]   = (int)(2 * nchunk_sum);
+        nchunk_sum += (size_t)nchunk_all[i];
+    }
+
+
+    if (2 * nchunk_sum > INT_MAX)
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Too many chunks of orders.");
+    else
+    {
+        order_all = (unsigned long *)malloc((2 * nchunk_sum + 1) *
+                                            sizeof(unsigned long));
+        if (order_all == NULL)
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+    }
+    if (!CHARM(mpi_err_isempty)(err))
+        goto BARRIER;
+
+
+    MPI_Allgatherv(shcs->local_order, 2 * nchunk, MPI_UNSIGNED_LONG,
+                   order_all, cnt, displs, MPI_UNSIGNED_LONG, comm);
+
+
+    size_t ichunk = 0;
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < nchunk_all[i]; j++, ichunk++)
+            for (unsigned long m = order_all[2 * ichunk];
+                 m <= order_all[2 * ichunk + 1]; m++)
+                owner[m] = i;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Each process reads the lines of its slice of the file */
+    /* ===================================================================== */
+    fptr = fopen(pathname, "r");
+    if (fptr == NULL)
+    {
+        char msg[CHARM_ERR_MAX_MSG];
+        snprintf(msg, CHARM_ERR_MAX_MSG, "Couldn't open \"%s\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO, msg);
+    }
+    uint64_t fsize = (fptr == NULL) ? 0 : file_size(fptr);
+    if ((fptr != NULL) && (fsize == UINT64_MAX))
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to get the size of the input file.");
+    if (!CHARM(mpi_err_isempty)(err))
+        goto BARRIER;
+
+
+    const char *lines;
+    size_t nlines;
+    uint64_t off;
+    read_lines(fptr, fsize, comm, &buf, &lines, &nlines, &off, err);
+    if (!CHARM(err_isempty)(err))
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+    if (!CHARM(mpi_err_isempty)(err))
+        goto BARRIER;
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* The view shares all its members with "shcs", including the arrays of
+     * pointers "c" and "s", so the non-local orders are "NULL" in the view.
+     * Resetting the coefficients of the view with MPI support affects only
+     * the local chunks of "view". */
+    /* ===================================================================== */
+    CHARM(shc) view  = *shcs;
+    view.distributed = 0;
+    view.owner       = 0;
+    view.map         = NULL;
+    view.lazy        = NULL;
+    view.view        = NULL;
+
+
+    if (format == MPI_SHC_READ_TEXT_MTX)
+    {
+        nmax_file = read_mtx(fptr, lines, nlines, off, nmax, owner, comm,
+                             &view, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto BARRIER;
+        }
+    }
+    else
+    {
+        scatter_ranges(format, lines, nlines, off, nmax, shcs->nmax, owner,
+                       comm, &ranges, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto BARRIER;
+        }
+
+
+        /* The lines are no longer needed, as the serial reader reads the
+         * ranges from the file */
+        free(buf);
+        buf = NULL;
+        fclose(fptr);
+        fptr = NULL;
+
+
+        nmax_file = read_text(format, pathname, nmax, epoch, &ranges, &view,
+                              err_loc);
+        if (!CHARM(err_isempty)(err_loc))
+        {
+            copy_err(err_loc, err);
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto BARRIER;
+        }
+    }
+
+
+    shcs->mu = view.mu;
+    shcs->r  = view.r;
+    /* ===================================================================== */
+
+
+
+
+
+
+BARRIER:
+    free(nchunk_all);
+    free(cnt);
+    free(displs);
+    free(order_all);
+    free(owner);
+    free(buf);
+    free(ranges.off);
+    if (fptr != NULL)
+        fclose(fptr);
+    CHARM(err_free)(err_loc);
+    CHARM(mpi_err_gather)(err);
+
+
+    return nmax_file;
+}
@@ -0,0 +1,38 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __MPI_SHC_READ_TEXT_H__
+#define __MPI_SHC_READ_TEXT_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+/* Formats of text files with spherical harmonic coefficients */
+#define MPI_SHC_READ_TEXT_MTX 0
+#define MPI_SHC_READ_TEXT_TBL 1
+#define MPI_SHC_READ_TEXT_DOV 2
+#define MPI_SHC_READ_TEXT_GFC 3
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern unsigned long CHARM(mpi_shc_read_text)(int,
+                                              const char *,
+                                              unsigned long,
+                                              const char *,
+                                              CHARM(shc) *,
+                                              CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -10,6 +10,7 @@
 #include "../prec.h"
 #include "../shc/shc_reset_coeffs.h"
 #include "../shc/shc_check_distribution.h"
+#include "../shc/shc_check_map.h"
 #include "../shs/shs_cell_check_grd_lons.h"
 #include "../leg/leg_func_anm_bnm.h"
 #include "../leg/leg_func_dm.h"
@@ -27,6 +28,7 @@
 #include "../misc/misc_is_nearly_equal.h"
 #include "../misc/misc_polar_optimization_threshold.h"
 #include "../misc/misc_polar_optimization_apply.h"
+#include "../misc/misc_fftw_plans.h"
 #if HAVE_OPENMP
 #   include <omp.h>
 #endif
@@ -65,6 +67,14 @@ void CHARM(sha_cell)(const CHARM(cell) *cell,
     }
 
 
+    CHARM(shc_check_map)(shcs, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
     if (method != CHARM_SHA_CELL_AQ)
     {
         CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
@@ -1412,12 +1422,7 @@ FAILURE:
 
     free(r); free(ri); free(dm); free(en); free(fn); free(gm); free(hm);
     FFTW(destroy_plan)(plan);
-    FFTW(cleanup)();
-#if HAVE_OPENMP && FFTW3_OMP
-    FFTW(cleanup_threads)();
-#else
-    FFTW(cleanup)();
-#endif
+    CHARM(misc_fftw_cleanup)();
 
 
     if (FAILURE_glob != 0)
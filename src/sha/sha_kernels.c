@@ -0,0 +1,19 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "sha_kernels.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+const CHARM(sha_kernels_table) SIMD_ISA_NAME(sha_kernels) =
+{
+    SIMD_ISA_NAME(sha_point_kernel),
+    SIMD_ISA_NAME(sha_point_kernel_batch)
+};
@@ -0,0 +1,90 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHA_KERNELS_H__
+#define __SHA_KERNELS_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "../shc/shc_block_struct.h"
+#include "sha_point_kernel.h"
+#include "sha_point_kernel_batch.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/* Table of the kernels of spherical harmonic analysis compiled for a single
+ * instruction set.  Like with "CHARM(shs_kernels_table)", the kernels accept
+ * only pointers to "REAL_SIMD", so the tables of all instruction sets are
+ * binary compatible. */
+typedef struct
+{
+    _Bool (*sha_point_kernel)(unsigned long,
+                              unsigned long,
+                              CHARM(shc_block) *,
+                              const REAL *,
+                              const REAL *,
+                              const REAL_SIMD *,
+                              const REAL_SIMD *,
+                              const REAL_SIMD *,
+                              const REAL *,
+                              const INT *,
+                              const REAL *,
+                              const REAL *,
+                              const REAL *,
+                              const REAL *,
+                              size_t);
+
+
+    _Bool (*sha_point_kernel_batch)(unsigned long,
+                                    unsigned long,
+                                    CHARM(shc_block) **,
+                                    size_t,
+                                    const REAL *,
+                                    const REAL *,
+                                    const REAL_SIMD *,
+                                    const REAL_SIMD *,
+                                    const REAL_SIMD *,
+                                    const REAL *,
+                                    const INT *,
+                                    const REAL *,
+                                    const REAL *,
+                                    const REAL *,
+                                    const REAL *,
+                                    size_t,
+                                    size_t,
+                                    REAL_SIMD *);
+} CHARM(sha_kernels_table);
+
+
+extern const CHARM(sha_kernels_table) SIMD_ISA_NAME(sha_kernels);
+
+
+/* "SHA_KERNEL(x)" is the kernel "x" to be called by the analysis, see
+ * "SHS_KERNEL" in "../shs/shs_kernels.h" */
+#if HAVE_SIMD_DISPATCH
+extern const CHARM(sha_kernels_table) *CHARM(simd_dispatch_sha);
+#   undef SHA_KERNEL
+#   define SHA_KERNEL(x) (CHARM(simd_dispatch_sha)->x)
+#   undef SHA_KERNEL_VARS
+#   define SHA_KERNEL_VARS shared(CHARM(simd_dispatch_sha))
+#else
+#   undef SHA_KERNEL
+#   define SHA_KERNEL(x) CHARM(x)
+#   undef SHA_KERNEL_VARS
+#   define SHA_KERNEL_VARS
+#endif
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,477 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <fftw3.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../crd/crd_point_quad_equator.h"
+#include "../crd/crd_point_quad_get_nmax_from_nlat.h"
+#include "../crd/crd_point_isDHGrid.h"
+#include "../crd/crd_point_isQuadGrid.h"
+#include "../crd/crd_point_get_local_nlat.h"
+#include "../crd/crd_point_get_local_nlon.h"
+#include "../crd/crd_point_get_local_0_start.h"
+#include "../leg/leg_func_dm.h"
+#include "../leg/leg_func_r_ri.h"
+#include "../shs/shs_get_imax.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_isempty_all_mpi_processes.h"
+#include "../misc/misc_is_nearly_equal.h"
+#include "../misc/misc_fftw_plans.h"
+#include "../glob/glob_get_sha_block_lat_multiplier.h"
+#include "../simd/simd.h"
+#include "../simd/calloc_aligned.h"
+#include "sha_plan_struct.h"
+#include "sha_point_block.h"
+#include "sha_plan_create.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Macros */
+/* ------------------------------------------------------------------------- */
+#undef CHECK_NULL
+#define CHECK_NULL(x, barrier)                                                \
+        if ((x) == NULL)                                                      \
+        {                                                                     \
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,     \
+                           CHARM_ERR_MALLOC_FAILURE);                         \
+            goto barrier;                                                     \
+        }
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to create a plan for the analysis of point values.  All
+ * quantities that do not depend on the input signal are computed here.
+ * "nsignals" is the number of signals to be analysed at once (see
+ * "sha_point_batch_exec").  "fftw_flags" are passed to the FFTW planner.  If
+ * "cache" is "1", the latitude-dependent quantities are computed for all
+ * latitude blocks and stored in the plan.  Otherwise, they are computed later
+ * for each block separately in "sha_point_exec". */
+CHARM(sha_plan) *CHARM(sha_plan_create)(const CHARM(point) *pnt,
+                                        unsigned long nmax,
+                                        size_t nsignals,
+                                        unsigned fftw_flags,
+                                        _Bool cache,
+                                        CHARM(err) *err)
+{
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    const int pnt_type = pnt->type;
+    if (!CHARM(crd_point_isQuadGrid)(pnt_type))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Unsupported \"pnt->type\" for spherical "
+                       "harmonic analysis of point data values.");
+        return NULL;
+    }
+
+
+    /* ..................................................................... */
+    size_t pnt_nlat = CHARM(crd_point_get_local_nlat)(pnt);
+    const size_t local_0_start = CHARM(crd_point_get_local_0_start)(pnt);
+
+
+    /* Get the radius of the sphere "r0", on which the analysis will be
+     * performed.  This loop must be executed before "pnt_nlat" is modified, as
+     * it happens with the Driscoll--Healy grids below. */
+    const REAL r0 = pnt->r[0];
+    for (size_t i = 1; i < pnt_nlat; i++)
+    {
+        if (!CHARM(misc_is_nearly_equal)(pnt->r[i], r0, CHARM(glob_threshold)))
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           "All spherical radii in \"pnt->r\" must be "
+                           "equal.");
+            return NULL;
+        }
+    }
+
+
+    /* Get the maximum degree for which the grid in "pnt" was created. */
+    const unsigned long nmax_grd =
+                  CHARM(crd_point_quad_get_nmax_from_nlat)(pnt_type,
+                                                           pnt->nlat);
+
+
+    if (CHARM(crd_point_isDHGrid)(pnt_type) && (local_0_start == 0))
+        /* See "shs_plan_create.c" for details on this */
+        pnt_nlat += 1;
+
+
+    /* Now we check whether the maximum harmonic degree "nmax_grd" is large
+     * enough to recover harmonics up to degree "nmax" entered by the user. */
+    if (nmax > nmax_grd)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "The input data grid \"pnt\" was "
+                       "created for a maximum degree that "
+                       "is not high enough to recover harmonics up "
+                       "to the specified maximum degree of the "
+                       "analysis.");
+        return NULL;
+    }
+    /* ..................................................................... */
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(sha_plan) *plan = (CHARM(sha_plan) *)calloc(1,
+                                                     sizeof(CHARM(sha_plan)));
+    if (plan == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER_1;
+    }
+
+
+#if HAVE_RUNTIME_BLOCK
+    size_t BLOCK_A = CHARM(glob_get_sha_block_lat_multiplier)();
+    plan->block_a  = BLOCK_A;
+#else
+#   define BLOCK_A SIMD_BLOCK_A
+#endif
+
+
+    plan->pnt           = pnt;
+    plan->nmax          = nmax;
+    plan->nsignals      = nsignals;
+    plan->cache         = cache;
+    plan->pnt_type      = pnt_type;
+    plan->pnt_nlat      = pnt_nlat;
+    plan->pnt_nlon      = CHARM(crd_point_get_local_nlon)(pnt);
+    plan->pnt_nlon_fft  = plan->pnt_nlon / 2 + 1;
+    plan->local_0_start = local_0_start;
+    plan->r0            = r0;
+
+
+    /* Get the index of the equator for quadrature grids */
+    plan->equator = CHARM(crd_point_quad_equator)(pnt->type, nmax_grd);
+
+
+    plan->even   = !(pnt_nlat % 2);
+    plan->nlatdo = (pnt_nlat + 1 - plan->even) / 2;
+    plan->imax   = CHARM(shs_get_imax)(plan->nlatdo, BLOCK_A, pnt);
+    plan->istep  = SIMD_SIZE * BLOCK_A;
+
+
+    /* Number of latitude blocks to be stored in the plan */
+    size_t nslots = (cache) ? (plan->imax + plan->istep - 1) / plan->istep : 1;
+    if (nslots == 0)
+        nslots = 1;
+    plan->nslots = nslots;
+
+
+    /* Auxiliary variable entering the computation of the lumped coefficients.
+     * Here, we have to use the maximum degree "nmax_grd" for which the input
+     * grid in "pnt" was created.  The "4pi" normalization and the
+     * normalization to "r0" and "shcs->mu" are applied in "sha_point_exec",
+     * as "shcs->mu" is not known at this point. */
+    plan->c = PREC(0.0);
+    if ((pnt_type == CHARM_CRD_POINT_GRID_GL) ||
+        (pnt_type == CHARM_CRD_POINT_GRID_DH1))
+        plan->c = PI / (REAL)(nmax_grd + 1);
+    else if (pnt_type == CHARM_CRD_POINT_GRID_DH2)
+        plan->c = PI / (REAL)(2 * nmax_grd + 2);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Initializations for recurrence relations to compute Legendre functions
+     * */
+    /* --------------------------------------------------------------------- */
+    /* Prepare some variables to compute coefficients the "anm" and "bnm"
+     * coefficients for the Legendre functions recurrences */
+    plan->r = (REAL *)calloc(2 * nmax + 4, sizeof(REAL));
+    CHECK_NULL(plan->r, BARRIER_1);
+
+
+    plan->ri = (REAL *)calloc(2 * nmax + 4, sizeof(REAL));
+    CHECK_NULL(plan->ri, BARRIER_1);
+
+
+    CHARM(leg_func_r_ri)(nmax, plan->r, plan->ri);
+
+
+    /* "dm" coefficients for sectorial Legendre functions */
+    plan->dm = (REAL *)calloc(nmax + 1, sizeof(REAL));
+    CHECK_NULL(plan->dm, BARRIER_1);
+
+
+    CHARM(leg_func_dm)(nmax, plan->r, plan->ri, plan->dm);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Create a plan for FFT */
+    /* --------------------------------------------------------------------- */
+    {
+#if HAVE_OPENMP && FFTW3_OMP
+        if (FFTW(init_threads)() == 0)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFFTWINIT,
+                           CHARM_ERR_FFTW_INIT_FAILURE);
+            goto BARRIER_1;
+        }
+
+
+        FFTW(plan_with_nthreads)(omp_get_max_threads());
+#endif
+
+
+        REAL *x1           = NULL;
+        FFTWC(complex) *x2 = NULL;
+
+
+        x1 = (REAL *)FFTW(malloc)(nsignals * plan->pnt_nlon * sizeof(REAL));
+        CHECK_NULL(x1, BARRIER_FFTW);
+
+
+        x2 = (FFTWC(complex) *)FFTW(malloc)(nsignals * plan->pnt_nlon_fft *
+                                            sizeof(FFTWC(complex)));
+        CHECK_NULL(x2, BARRIER_FFTW);
+
+
+        if (nsignals == 1)
+            plan->plan = FFTW(plan_dft_r2c_1d)(plan->pnt_nlon, x1, x2,
+                                               fftw_flags);
+        else
+        {
+            /* A single plan transforms the latitude parallels of all the
+             * "nsignals" signals, which are stored one after another in
+             * "ftmp_in" and "ftmp_out" */
+            int n = (int)plan->pnt_nlon;
+            plan->plan = FFTW(plan_many_dft_r2c)(1, &n, (int)nsignals,
+                                                 x1, NULL, 1,
+                                                 (int)plan->pnt_nlon,
+                                                 x2, NULL, 1,
+                                                 (int)plan->pnt_nlon_fft,
+                                                 fftw_flags);
+        }
+        if (plan->plan == NULL)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto BARRIER_FFTW;
+        }
+
+
+        /* The FFTW plan lives as long as "plan", so "fftw_cleanup" must not
+         * be called in the meantime */
+        if (cache)
+            CHARM(misc_fftw_plans_add)();
+
+
+BARRIER_FFTW:
+        FFTW(free)(x1);
+        FFTW(free)(x2);
+
+
+        if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+            goto BARRIER_1;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    plan->ips = (INT *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                             nslots * SIMD_SIZE * BLOCK_A *
+                                             nmax,
+                                             sizeof(INT));
+    CHECK_NULL(plan->ips, BARRIER_1);
+
+
+    plan->ps = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                             nslots * SIMD_SIZE * BLOCK_A *
+                                             nmax,
+                                             sizeof(REAL));
+    CHECK_NULL(plan->ps, BARRIER_1);
+
+
+    plan->symmv = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                nslots * SIMD_SIZE * BLOCK_A,
+                                                sizeof(REAL));
+    CHECK_NULL(plan->symmv, BARRIER_1);
+
+
+    plan->latsinv = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                  nslots * SIMD_SIZE *
+                                                  BLOCK_A,
+                                                  sizeof(REAL));
+    CHECK_NULL(plan->latsinv, BARRIER_1);
+
+
+    plan->t = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                 nslots * BLOCK_A,
+                                                 sizeof(REAL_SIMD));
+    CHECK_NULL(plan->t, BARRIER_1);
+
+
+    plan->u = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                 nslots * BLOCK_A,
+                                                 sizeof(REAL_SIMD));
+    CHECK_NULL(plan->u, BARRIER_1);
+
+
+    plan->symm = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                    nslots * BLOCK_A,
+                                                    sizeof(REAL_SIMD));
+    CHECK_NULL(plan->symm, BARRIER_1);
+
+
+    plan->latsin = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                      nslots * BLOCK_A,
+                                                      sizeof(REAL_SIMD));
+    CHECK_NULL(plan->latsin, BARRIER_1);
+
+
+    plan->tv = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                             sizeof(REAL));
+    CHECK_NULL(plan->tv, BARRIER_1);
+
+
+    plan->uv = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                             sizeof(REAL));
+    CHECK_NULL(plan->uv, BARRIER_1);
+
+
+    plan->a = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                            nsignals * SIMD_SIZE * BLOCK_A *
+                                            plan->pnt_nlon_fft, sizeof(REAL));
+    CHECK_NULL(plan->a, BARRIER_1);
+
+
+    plan->b = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                            nsignals * SIMD_SIZE * BLOCK_A *
+                                            plan->pnt_nlon_fft, sizeof(REAL));
+    CHECK_NULL(plan->b, BARRIER_1);
+
+
+    plan->a2 = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                             nsignals * SIMD_SIZE * BLOCK_A *
+                                             plan->pnt_nlon_fft, sizeof(REAL));
+    CHECK_NULL(plan->a2, BARRIER_1);
+
+
+    plan->b2 = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                             nsignals * SIMD_SIZE * BLOCK_A *
+                                             plan->pnt_nlon_fft, sizeof(REAL));
+    CHECK_NULL(plan->b2, BARRIER_1);
+
+
+    plan->ftmp_in = (REAL *)FFTW(malloc)(nsignals * plan->pnt_nlon *
+                                         sizeof(REAL));
+    CHECK_NULL(plan->ftmp_in, BARRIER_1);
+
+
+    plan->ftmp_out = (FFTWC(complex) *)FFTW(malloc)(nsignals *
+                                                  plan->pnt_nlon_fft *
+                                                  sizeof(FFTWC(complex)));
+    CHECK_NULL(plan->ftmp_out, BARRIER_1);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Arrays private to OpenMP threads */
+    /* --------------------------------------------------------------------- */
+#if HAVE_OPENMP
+    plan->nthreads = omp_get_max_threads();
+#else
+    plan->nthreads = 1;
+#endif
+
+
+    plan->anm = (REAL **)calloc(plan->nthreads, sizeof(REAL *));
+    CHECK_NULL(plan->anm, BARRIER_1);
+
+
+    plan->bnm = (REAL **)calloc(plan->nthreads, sizeof(REAL *));
+    CHECK_NULL(plan->bnm, BARRIER_1);
+
+
+    plan->leg = (REAL_SIMD **)calloc(plan->nthreads, sizeof(REAL_SIMD *));
+    CHECK_NULL(plan->leg, BARRIER_1);
+
+
+    for (int j = 0; j < plan->nthreads; j++)
+    {
+        plan->anm[j] = (REAL *)calloc(nmax + 1, sizeof(REAL));
+        CHECK_NULL(plan->anm[j], BARRIER_1);
+
+
+        plan->bnm[j] = (REAL *)calloc(nmax + 1, sizeof(REAL));
+        CHECK_NULL(plan->bnm[j], BARRIER_1);
+
+
+        if (nsignals > 1)
+        {
+            plan->leg[j] = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                          (nmax + 1) * BLOCK_A,
+                                                          sizeof(REAL_SIMD));
+            CHECK_NULL(plan->leg[j], BARRIER_1);
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Latitude-dependent quantities for all latitude blocks */
+    /* --------------------------------------------------------------------- */
+    if (cache)
+    {
+        for (size_t i = 0; i < plan->imax; i += plan->istep)
+            CHARM(sha_point_block)(plan, i, i / plan->istep);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+BARRIER_1:
+    if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+    {
+        CHARM(sha_plan_free)(plan);
+        return NULL;
+    }
+
+
+    return plan;
+    /* --------------------------------------------------------------------- */
+}
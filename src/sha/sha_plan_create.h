@@ -0,0 +1,31 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHA_PLAN_CREATE_H__
+#define __SHA_PLAN_CREATE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern CHARM(sha_plan) *CHARM(sha_plan_create)(const CHARM(point) *,
+                                               unsigned long,
+                                               size_t,
+                                               unsigned,
+                                               _Bool,
+                                               CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,114 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_isempty_all_mpi_processes.h"
+#include "../shc/shc_check_lazy.h"
+#include "../shc/shc_check_view.h"
+#include "../shc/shc_check_map.h"
+#include "sha_plan_struct.h"
+#include "sha_point_exec.h"
+#if HAVE_MPI
+#   include "../mpi/mpi_check_point_shc_err.h"
+#   include "../mpi/mpi_err_gather.h"
+#endif
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(sha_plan_execute)(CHARM(sha_plan) *plan,
+                             const REAL *f,
+                             CHARM(shc) *shcs,
+                             CHARM(err) *err)
+{
+    char err_msg[CHARM_ERR_MAX_MSG];
+
+
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    if (plan == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "\"plan\" cannot be \"NULL\".");
+        goto BARRIER;
+    }
+
+
+    if (plan->nmax > shcs->nmax)
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Maximum harmonic degree of the analysis "
+                         "\"nmax = %lu\" cannot be larger than maximum "
+                         "harmonic degree of spherical harmonic "
+                         "coefficients \"shcs->nmax = %lu\".",
+                         plan->nmax, shcs->nmax);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto BARRIER;
+    }
+
+
+    if (CHARM(shc_check_lazy)(shcs, err) ||
+        CHARM(shc_check_view)(shcs, err) ||
+        CHARM(shc_check_map)(shcs, err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto BARRIER;
+    }
+
+
+#if HAVE_MPI
+    CHARM(mpi_check_point_shc_err)(plan->pnt, shcs, err);
+    if (!CHARM(mpi_err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto BARRIER;
+    }
+#endif
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+BARRIER:
+    if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Now do the analysis */
+    /* --------------------------------------------------------------------- */
+    CHARM(sha_point_exec)(plan, f, shcs, err);
+    if (!CHARM(err_isempty)(err))
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+EXIT:
+#if HAVE_MPI
+    CHARM(mpi_err_gather)(err);
+#endif
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
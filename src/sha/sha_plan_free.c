@@ -0,0 +1,72 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../simd/free_aligned.h"
+#include "../misc/misc_fftw_plans.h"
+#include "sha_plan_struct.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(sha_plan_free)(CHARM(sha_plan) *plan)
+{
+    if (plan == NULL)
+        return;
+
+
+    free(plan->r);
+    free(plan->ri);
+    free(plan->dm);
+    CHARM(free_aligned)(plan->ips);
+    CHARM(free_aligned)(plan->ps);
+    CHARM(free_aligned)(plan->symmv);
+    CHARM(free_aligned)(plan->latsinv);
+    CHARM(free_aligned)(plan->t);
+    CHARM(free_aligned)(plan->u);
+    CHARM(free_aligned)(plan->symm);
+    CHARM(free_aligned)(plan->latsin);
+    CHARM(free_aligned)(plan->tv);
+    CHARM(free_aligned)(plan->uv);
+    CHARM(free_aligned)(plan->a);
+    CHARM(free_aligned)(plan->b);
+    CHARM(free_aligned)(plan->a2);
+    CHARM(free_aligned)(plan->b2);
+    FFTW(free)(plan->ftmp_in);
+    FFTW(free)(plan->ftmp_out);
+
+
+    for (int j = 0; j < plan->nthreads; j++)
+    {
+        if (plan->anm != NULL)
+            free(plan->anm[j]);
+        if (plan->bnm != NULL)
+            free(plan->bnm[j]);
+        if (plan->leg != NULL)
+            CHARM(free_aligned)(plan->leg[j]);
+    }
+    free(plan->anm);
+    free(plan->bnm);
+    free(plan->leg);
+
+
+    if (plan->plan != NULL)
+    {
+        FFTW(destroy_plan)(plan->plan);
+        if (plan->cache)
+            CHARM(misc_fftw_plans_remove)();
+        CHARM(misc_fftw_cleanup)();
+    }
+
+
+    free(plan);
+
+
+    return;
+}
@@ -0,0 +1,54 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "sha_plan_create.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+CHARM(sha_plan) *CHARM(sha_plan_init)(const CHARM(point) *pnt,
+                                      unsigned long nmax,
+                                      int flags,
+                                      CHARM(err) *err)
+{
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    unsigned fftw_flags;
+    if (flags == CHARM_SHA_PLAN_ESTIMATE)
+        fftw_flags = FFTW_ESTIMATE;
+    else if (flags == CHARM_SHA_PLAN_MEASURE)
+        fftw_flags = FFTW_MEASURE;
+    else if (flags == CHARM_SHA_PLAN_PATIENT)
+        fftw_flags = FFTW_PATIENT;
+    else
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Unsupported value of \"flags\".");
+        return NULL;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(sha_plan) *plan = CHARM(sha_plan_create)(pnt, nmax, 1, fftw_flags, 1,
+                                                   err);
+    if (!CHARM(err_isempty)(err))
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+    return plan;
+    /* --------------------------------------------------------------------- */
+}
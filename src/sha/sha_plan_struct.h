@@ -0,0 +1,104 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHA_PLAN_STRUCT_H__
+#define __SHA_PLAN_STRUCT_H__
+
+
+#include <config.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+
+
+/* Structure holding everything that is needed to perform the analysis of point
+ * values and that does not depend on the input signal.  The structure is
+ * opaque to the user ("charm_sha_plan"). */
+struct CHARM(sha_plan)
+{
+    /* Evaluation points and maximum harmonic degree the plan was created for
+     * */
+    const CHARM(point) *pnt;
+    unsigned long nmax;
+
+
+    /* Number of signals that are analysed at once ("1" except for
+     * "sha_point_batch_exec").  The lumped coefficients and the FFT input and
+     * output arrays are "nsignals" times longer. */
+    size_t nsignals;
+
+
+    /* If "1", the latitude-dependent quantities are computed once for all
+     * latitude blocks and kept in the plan.  If "0", they are computed on the
+     * fly for each latitude block, so that only one block is stored at
+     * a time (internal one-shot analysis with "sha_point"). */
+    _Bool cache;
+
+
+    /* Grid related constants, see "sha_plan_create.c" */
+    int pnt_type;
+    size_t pnt_nlat;
+    size_t pnt_nlon;
+    size_t pnt_nlon_fft;
+    size_t local_0_start;
+    size_t equator;
+    size_t nlatdo;
+    _Bool even;
+    REAL r0;
+    REAL c;
+    size_t imax;
+    size_t istep;
+#if HAVE_RUNTIME_BLOCK
+    size_t block_a;
+#endif
+
+
+    /* Number of latitude blocks stored in the plan ("1" if "cache == 0") */
+    size_t nslots;
+
+
+    /* Coefficients for the recurrence relations of Legendre functions */
+    REAL *r;
+    REAL *ri;
+    REAL *dm;
+
+
+    /* FFT plan */
+    FFTW(plan) plan;
+
+
+    /* Latitude-dependent quantities for "nslots" latitude blocks */
+    INT *ips;
+    REAL *ps;
+    REAL *symmv;
+    REAL *latsinv;
+    REAL_SIMD *t;
+    REAL_SIMD *u;
+    REAL_SIMD *symm;
+    REAL_SIMD *latsin;
+
+
+    /* Scratch arrays to prepare the latitude blocks */
+    REAL *tv;
+    REAL *uv;
+
+
+    /* Lumped coefficients and the FFT input and output arrays */
+    REAL *a;
+    REAL *b;
+    REAL *a2;
+    REAL *b2;
+    REAL *ftmp_in;
+    FFTWC(complex) *ftmp_out;
+
+
+    /* Per-thread arrays.  With "nsignals > 1", "leg" stores the Legendre
+     * functions of a single order (see "sha_point_batch_exec"). */
+    int nthreads;
+    REAL **anm;
+    REAL **bnm;
+    REAL_SIMD **leg;
+};
+
+
+#endif
@@ -0,0 +1,166 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../shc/shc_check_lazy.h"
+#include "../shc/shc_check_view.h"
+#include "../shc/shc_check_map.h"
+#if HAVE_MPI
+#   include "../mpi/mpi_err_gather.h"
+#   include "../mpi/mpi_check_point_shc_err.h"
+#endif
+#include "sha_plan_create.h"
+#include "sha_point_batch_exec.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(sha_point_batch)(const CHARM(point) *pnt,
+                            REAL **f,
+                            size_t nsignals,
+                            unsigned long nmax,
+                            CHARM(shc) **shcs,
+                            CHARM(err) *err)
+{
+    CHARM(sha_plan) *plan = NULL;
+    char err_msg[CHARM_ERR_MAX_MSG];
+
+
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    for (size_t k = 0; k < nsignals; k++)
+    {
+        if (nmax > shcs[k]->nmax)
+        {
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                             "Maximum harmonic degree of the analysis "
+                             "\"nmax = %lu\" cannot be larger than maximum "
+                             "harmonic degree of spherical harmonic "
+                             "coefficients \"shcs[%zu]->nmax = %lu\".",
+                             nmax, k, shcs[k]->nmax);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           err_msg);
+            goto EXIT;
+        }
+
+
+        if (CHARM(shc_check_lazy)(shcs[k], err) ||
+            CHARM(shc_check_view)(shcs[k], err) ||
+            CHARM(shc_check_map)(shcs[k], err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT;
+        }
+    }
+
+
+#if HAVE_MPI
+    for (size_t k = 0; k < nsignals; k++)
+    {
+        CHARM(mpi_check_point_shc_err)(pnt, shcs[k], err);
+        if (!CHARM(mpi_err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT;
+        }
+    }
+#endif
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Do nothing if there are no signals, which is a valid case */
+    /* --------------------------------------------------------------------- */
+    if (nsignals == 0)
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Distributed structures and a single signal are analysed one by one with
+     * "sha_point" */
+    /* --------------------------------------------------------------------- */
+    _Bool batch = (nsignals > 1) && !pnt->distributed;
+    for (size_t k = 0; k < nsignals; k++)
+        batch = batch && !shcs[k]->distributed;
+
+
+    if (!batch)
+    {
+        for (size_t k = 0; k < nsignals; k++)
+        {
+            CHARM(sha_point)(pnt, f[k], nmax, shcs[k], err);
+            if (!CHARM(err_isempty)(err))
+            {
+                CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                break;
+            }
+        }
+
+
+        /* "sha_point" already gathered the errors from all MPI processes */
+        return;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Prepare everything that does not depend on "f".  As in "sha_point", the
+     * latitude-dependent quantities are computed on the fly for each latitude
+     * block. */
+    /* --------------------------------------------------------------------- */
+    plan = CHARM(sha_plan_create)(pnt, nmax, nsignals, FFTW_ESTIMATE, 0, err);
+    if (plan == NULL)
+    {
+        if (!CHARM(err_isempty)(err))
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(sha_point_batch_exec)(plan, f, shcs, err);
+    if (!CHARM(err_isempty)(err))
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+EXIT:
+    CHARM(sha_plan_free)(plan);
+
+
+#if HAVE_MPI
+    CHARM(mpi_err_gather)(err);
+#endif
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
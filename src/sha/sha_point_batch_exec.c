@@ -0,0 +1,345 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fftw3.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../shc/shc_reset_coeffs.h"
+#include "../shc/shc_block_struct.h"
+#include "../shc/shc_block_init.h"
+#include "../shc/shc_block_free.h"
+#include "../leg/leg_func_anm_bnm.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_isempty_all_mpi_processes.h"
+#include "../misc/misc_is_nearly_equal.h"
+#include "../misc/misc_polar_optimization_threshold.h"
+#include "../misc/misc_polar_optimization_apply.h"
+#include "../simd/simd.h"
+#include "sha_plan_struct.h"
+#include "sha_point_block.h"
+#include "sha_kernels.h"
+#include "sha_point_batch_exec.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to perform the analysis of "plan->nsignals" signals "f[0],
+ * f[1], ..." using a plan created by "sha_plan_create".  The coefficients of
+ * the "k"th signal are stored in "shcs[k]".  The FFT of a latitude parallel is
+ * computed for all the signals by a single FFTW plan.  For each harmonic order
+ * and each latitude block, the Legendre functions are first stored in
+ * "plan->leg" and are then used for all the signals.  The arithmetic
+ * operations are the same as in "sha_point_exec".  Distributed structures are
+ * not supported. */
+void CHARM(sha_point_batch_exec)(CHARM(sha_plan) *plan,
+                                 REAL **f,
+                                 CHARM(shc) **shcs,
+                                 CHARM(err) *err)
+{
+    /* Some useful constants */
+    /* --------------------------------------------------------------------- */
+    const CHARM(point) *pnt   = plan->pnt;
+    const unsigned long nmax  = plan->nmax;
+    const size_t nsignals     = plan->nsignals;
+    const size_t pnt_nlat     = plan->pnt_nlat;
+    const size_t pnt_nlon     = plan->pnt_nlon;
+    const size_t pnt_nlon_fft = plan->pnt_nlon_fft;
+    const REAL r0             = plan->r0;
+    REAL *r                   = plan->r;
+    REAL *ri                  = plan->ri;
+    REAL *a                   = plan->a;
+    REAL *b                   = plan->b;
+    REAL *a2                  = plan->a2;
+    REAL *b2                  = plan->b2;
+    REAL *ftmp_in             = plan->ftmp_in;
+    FFTWC(complex) *ftmp_out  = plan->ftmp_out;
+    REAL_SIMD pt = CHARM(misc_polar_optimization_threshold)(nmax);
+#if HAVE_RUNTIME_BLOCK
+    size_t BLOCK_A = plan->block_a;
+#else
+#   define BLOCK_A SIMD_BLOCK_A
+#endif
+
+
+    /* Number of lumped coefficients of a single signal */
+    const size_t nab = SIMD_SIZE * BLOCK_A * pnt_nlon_fft;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Initialize blocks of spherical harmonic coefficients and the "4pi"
+     * normalization and normalization to "r0" and "shcs[k]->mu" scaling
+     * constants */
+    /* --------------------------------------------------------------------- */
+    REAL *c = (REAL *)malloc(nsignals * sizeof(REAL));
+    CHARM(shc_block) **shcs_blocks =
+                (CHARM(shc_block) **)calloc(nsignals,
+                                            sizeof(CHARM(shc_block) *));
+    if ((c == NULL) || (shcs_blocks == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE_1;
+    }
+
+
+    for (size_t k = 0; k < nsignals; k++)
+    {
+        c[k]  = plan->c;
+        c[k] *= PREC(1.0) / (PREC(4.0) * PI) * (r0 / shcs[k]->mu);
+
+
+        shcs_blocks[k] = CHARM(shc_block_init)(shcs[k]);
+        if (shcs_blocks[k] == NULL)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto FAILURE_1;
+        }
+
+
+        /* Set all coefficients in "shcs[k]" to zero */
+        CHARM(shc_reset_coeffs)(shcs[k]);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    REAL cw;
+    size_t l, ipv; /* "i + v" */
+    unsigned long kernel_err_glob = 0;
+
+
+    /* Loop over latitudes */
+    for (size_t i = 0; i < plan->imax; i += plan->istep)
+    {
+        /* Latitude-dependent quantities of this latitude block */
+        /* ----------------------------------------------------------------- */
+        size_t slot;
+        if (plan->cache)
+            slot = i / plan->istep;
+        else
+        {
+            slot = 0;
+            CHARM(sha_point_block)(plan, i, slot);
+        }
+
+
+        REAL *symmv       = plan->symmv + slot * SIMD_SIZE * BLOCK_A;
+        REAL *latsinv     = plan->latsinv + slot * SIMD_SIZE * BLOCK_A;
+        REAL_SIMD *t      = plan->t + slot * BLOCK_A;
+        REAL_SIMD *u      = plan->u + slot * BLOCK_A;
+        REAL_SIMD *symm   = plan->symm + slot * BLOCK_A;
+        REAL_SIMD *latsin = plan->latsin + slot * BLOCK_A;
+        REAL *ps          = plan->ps + slot * nmax * SIMD_SIZE * BLOCK_A;
+        INT *ips          = plan->ips + slot * nmax * SIMD_SIZE * BLOCK_A;
+        /* ----------------------------------------------------------------- */
+
+
+        for (l = 0; l < BLOCK_A; l++)
+        {
+            for (size_t v = 0; v < SIMD_SIZE; v++)
+            {
+                ipv = i + l * SIMD_SIZE + v;
+                if (latsinv[l * SIMD_SIZE + v] != 1)
+                    continue;
+
+
+                /* Lumped coefficients for the southern hemisphere
+                 * (including the equator) */
+                /* ----------------------------------------------------- */
+                for (size_t k = 0; k < nsignals; k++)
+                    memcpy(ftmp_in + k * pnt_nlon, f[k] + ipv * pnt_nlon,
+                           pnt_nlon * sizeof(REAL));
+                FFTW(execute_dft_r2c)(plan->plan, ftmp_in, ftmp_out);
+
+
+                for (size_t k = 0; k < nsignals; k++)
+                {
+                    cw = c[k] * pnt->w[ipv];
+                    for (size_t j = 0; j < pnt_nlon_fft; j++)
+                    {
+                        a[k * nab + j * (SIMD_SIZE * BLOCK_A) +
+                          l * SIMD_SIZE + v] =
+                                 cw * ftmp_out[k * pnt_nlon_fft + j][0];
+                        b[k * nab + j * (SIMD_SIZE * BLOCK_A) +
+                          l * SIMD_SIZE + v] =
+                                -cw * ftmp_out[k * pnt_nlon_fft + j][1];
+                    }
+                }
+                /* ----------------------------------------------------- */
+
+
+                /* Lumped coefficients for the northern hemisphere */
+                /* ----------------------------------------------------- */
+                if (symmv[l * SIMD_SIZE + v])
+                {
+                    for (size_t k = 0; k < nsignals; k++)
+                        memcpy(ftmp_in + k * pnt_nlon,
+                               f[k] + (pnt_nlat - ipv - 1) * pnt_nlon,
+                               pnt_nlon * sizeof(REAL));
+                    FFTW(execute_dft_r2c)(plan->plan, ftmp_in, ftmp_out);
+
+
+                    for (size_t k = 0; k < nsignals; k++)
+                    {
+                        cw = c[k] * pnt->w[pnt_nlat - ipv - 1];
+                        for (size_t j = 0; j < pnt_nlon_fft; j++)
+                        {
+                            a2[k * nab + j * (SIMD_SIZE * BLOCK_A) +
+                               l * SIMD_SIZE + v] =
+                                 cw * ftmp_out[k * pnt_nlon_fft + j][0];
+                            b2[k * nab + j * (SIMD_SIZE * BLOCK_A) +
+                               l * SIMD_SIZE + v] =
+                                -cw * ftmp_out[k * pnt_nlon_fft + j][1];
+                        }
+                    }
+                }
+                /* ----------------------------------------------------- */
+            }
+        }
+
+
+        /* ------------------------------------------------------------- */
+#if HAVE_OPENMP
+
+
+#   undef SIMD_VARS
+#   if HAVE_RUNTIME_BLOCK
+#       define SIMD_VARS shared(BLOCK_A)
+#   else
+#       define SIMD_VARS
+#   endif
+
+
+#pragma omp parallel default(none) num_threads(plan->nthreads) \
+shared(plan, nmax, nsignals, nab, symm, r, ri, a, b, a2, b2, shcs_blocks) \
+shared(t, u, ps, ips, latsin, pt, kernel_err_glob) SIMD_VARS SHA_KERNEL_VARS
+#endif
+        {
+        unsigned long kernel_err_priv = 0;
+
+
+#if HAVE_OPENMP
+        int tid = omp_get_thread_num();
+#else
+        int tid = 0;
+#endif
+        REAL *anm      = plan->anm[tid];
+        REAL *bnm      = plan->bnm[tid];
+        REAL_SIMD *leg = plan->leg[tid];
+
+
+        /* Loop over harmonic orders */
+        /* ------------------------------------------------------------- */
+#if HAVE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (unsigned long m = 0; m <= nmax; m++)
+        {
+            /* Apply polar optimization if asked to do so */
+            if (CHARM(misc_polar_optimization_apply)(m, nmax, &u[0],
+                                                     BLOCK_A, pt))
+                continue;
+
+
+            /* Computation of "anm" and "bnm" coefficients for Legendre
+             * recurrence relations */
+            CHARM(leg_func_anm_bnm)(nmax, m, r, ri, anm, bnm);
+
+
+            /* Legendre functions and the spherical harmonic coefficients
+             * of all signals */
+            size_t ab = (SIMD_SIZE * BLOCK_A) * m;
+            if (SHA_KERNEL(sha_point_kernel_batch)(nmax, m, shcs_blocks,
+                                                   nsignals, anm, bnm, t,
+                                                   symm, latsin, ps, ips,
+                                                   a + ab, b + ab, a2 + ab,
+                                                   b2 + ab, nab, BLOCK_A,
+                                                   leg))
+                kernel_err_priv += 1;
+
+
+        } /* End of the loop over harmonic orders */
+        /* ------------------------------------------------------------- */
+
+
+#if HAVE_OPENMP
+#pragma omp atomic
+#endif
+        kernel_err_glob += kernel_err_priv;
+        }
+        /* ------------------------------------------------------------- */
+
+
+        if (kernel_err_glob)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto FAILURE_1;
+        }
+
+
+    } /* End of the loop over latitude parallels */
+    /* ----------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Rescale the coefficients to the sphere of radius "shcs[k]->r" */
+    /* --------------------------------------------------------------------- */
+    for (size_t k = 0; k < nsignals; k++)
+    {
+        if (CHARM(misc_is_nearly_equal)(shcs[k]->r, r0,
+                                        CHARM(glob_threshold)))
+            continue;
+
+
+        /* See "sha_point_exec" for the rational here */
+        const REAL rtmp = shcs[k]->r;
+        shcs[k]->r = r0;
+        CHARM(shc_rescale)(shcs[k], shcs[k]->mu, rtmp, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto FAILURE_1;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+FAILURE_1:
+    if (shcs_blocks != NULL)
+        for (size_t k = 0; k < nsignals; k++)
+            CHARM(shc_block_free)(shcs_blocks[k]);
+    free(shcs_blocks);
+    free(c);
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
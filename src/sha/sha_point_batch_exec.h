@@ -0,0 +1,29 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHA_POINT_BATCH_EXEC_H__
+#define __SHA_POINT_BATCH_EXEC_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(sha_point_batch_exec)(CHARM(sha_plan) *,
+                                        REAL **,
+                                        CHARM(shc) **,
+                                        CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,89 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <math.h>
+#include "../prec.h"
+#include "../crd/crd_grd_check_symm.h"
+#include "../leg/leg_func_prepare.h"
+#include "../simd/simd.h"
+#include "sha_plan_struct.h"
+#include "sha_point_block.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to compute latitude-dependent quantities of the latitude
+ * block starting at the "i"th latitude.  The results are stored in the
+ * "slot"th latitude block of "plan". */
+void CHARM(sha_point_block)(CHARM(sha_plan) *plan,
+                            size_t i,
+                            size_t slot)
+{
+    const CHARM(point) *pnt = plan->pnt;
+    const unsigned long nmax = plan->nmax;
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_A = plan->block_a;
+#else
+#   define BLOCK_A SIMD_BLOCK_A
+#endif
+
+
+    REAL *tv = plan->tv;
+    REAL *uv = plan->uv;
+
+
+    REAL *symmv       = plan->symmv + slot * SIMD_SIZE * BLOCK_A;
+    REAL *latsinv     = plan->latsinv + slot * SIMD_SIZE * BLOCK_A;
+    REAL_SIMD *t      = plan->t + slot * BLOCK_A;
+    REAL_SIMD *u      = plan->u + slot * BLOCK_A;
+    REAL_SIMD *symm   = plan->symm + slot * BLOCK_A;
+    REAL_SIMD *latsin = plan->latsin + slot * BLOCK_A;
+    REAL *ps          = plan->ps + slot * nmax * SIMD_SIZE * BLOCK_A;
+    INT *ips          = plan->ips + slot * nmax * SIMD_SIZE * BLOCK_A;
+
+
+    size_t ipv;
+    for (size_t l = 0; l < BLOCK_A; l++)
+    {
+        for (size_t v = 0; v < SIMD_SIZE; v++)
+        {
+            /* Check whether the symmetry property of LFs needs to be
+             * applied */
+            /* ------------------------------------------------------------- */
+            ipv = i + l * SIMD_SIZE + v;
+            CHARM(crd_grd_check_symm)(ipv, v, plan->local_0_start,
+                                      plan->equator, plan->pnt_type,
+                                      plan->nlatdo, 0, plan->even,
+                                      symmv + l * SIMD_SIZE,
+                                      latsinv + l * SIMD_SIZE);
+            if (latsinv[l * SIMD_SIZE + v] == 1)
+            {
+                tv[v] = SIN(pnt->lat[ipv]);
+                uv[v] = COS(pnt->lat[ipv]);
+            }
+            else
+                tv[v] = uv[v] = PREC(0.0);
+            /* ------------------------------------------------------------- */
+        }
+
+
+        t[l]      = LOAD_R(&tv[0]);
+        u[l]      = LOAD_R(&uv[0]);
+        symm[l]   = LOAD_R(&symmv[l * SIMD_SIZE]);
+        latsin[l] = LOAD_R(&latsinv[l * SIMD_SIZE]);
+
+
+        /* Prepare arrays for sectorial Legendre functions */
+        /* ----------------------------------------------------------------- */
+        CHARM(leg_func_prepare)(uv, ps + l * SIMD_SIZE * nmax,
+                                ips + l * SIMD_SIZE * nmax, plan->dm, nmax);
+        /* ----------------------------------------------------------------- */
+    }
+
+
+    return;
+}
@@ -0,0 +1,28 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHA_POINT_BLOCK_H__
+#define __SHA_POINT_BLOCK_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(sha_point_block)(CHARM(sha_plan) *,
+                                   size_t,
+                                   size_t);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
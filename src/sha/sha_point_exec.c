@@ -0,0 +1,402 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <fftw3.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../shc/shc_reset_coeffs.h"
+#include "../shc/shc_block_struct.h"
+#include "../shc/shc_block_init.h"
+#include "../shc/shc_block_free.h"
+#include "../shc/shc_block_set_coeffs.h"
+#include "../shc/shc_block_reset_coeffs.h"
+#include "../shc/shc_block_set_mfirst.h"
+#include "../leg/leg_func_anm_bnm.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_isempty_all_mpi_processes.h"
+#include "../err/err_omp_mpi.h"
+#include "../misc/misc_is_nearly_equal.h"
+#include "../misc/misc_polar_optimization_threshold.h"
+#include "../misc/misc_polar_optimization_apply.h"
+#include "../simd/simd.h"
+#include "sha_plan_struct.h"
+#include "sha_point_block.h"
+#include "sha_kernels.h"
+#include "sha_point_exec.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to perform the analysis of point values "f" using a plan
+ * created by "sha_plan_create". */
+void CHARM(sha_point_exec)(CHARM(sha_plan) *plan,
+                           const REAL *f,
+                           CHARM(shc) *shcs,
+                           CHARM(err) *err)
+{
+    /* Some useful constants */
+    /* --------------------------------------------------------------------- */
+    const CHARM(point) *pnt   = plan->pnt;
+    const unsigned long nmax  = plan->nmax;
+    const size_t pnt_nlat     = plan->pnt_nlat;
+    const size_t pnt_nlon     = plan->pnt_nlon;
+    const size_t pnt_nlon_fft = plan->pnt_nlon_fft;
+    const REAL r0             = plan->r0;
+    REAL *r                   = plan->r;
+    REAL *ri                  = plan->ri;
+    REAL *a                   = plan->a;
+    REAL *b                   = plan->b;
+    REAL *a2                  = plan->a2;
+    REAL *b2                  = plan->b2;
+    REAL *ftmp_in             = plan->ftmp_in;
+    FFTWC(complex) *ftmp_out  = plan->ftmp_out;
+    REAL_SIMD pt = CHARM(misc_polar_optimization_threshold)(nmax);
+#if HAVE_RUNTIME_BLOCK
+    size_t BLOCK_A = plan->block_a;
+#else
+#   define BLOCK_A SIMD_BLOCK_A
+#endif
+
+
+    /* "4pi" normalization and normalization to "r0" and "shcs->mu" scaling
+     * constants */
+    REAL c = plan->c;
+    c *= PREC(1.0) / (PREC(4.0) * PI) * (r0 / shcs->mu);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Initialize block of spherical harmonic coefficients */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc_block) *shcs_block = CHARM(shc_block_init)(shcs);
+    if (shcs_block == NULL)
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+
+
+    if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+        goto FAILURE_1;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    /* Set all coefficients in "shcs" to zero */
+    CHARM(shc_reset_coeffs)(shcs);
+
+
+    REAL cw;
+    size_t l, ipv; /* "i + v" */
+    int err_glob = 0;
+    unsigned long kernel_err_glob = 0;
+
+
+    /* Loop over latitudes */
+    for (size_t i = 0; i < plan->imax; i += plan->istep)
+    {
+        /* Latitude-dependent quantities of this latitude block */
+        /* ----------------------------------------------------------------- */
+        size_t slot;
+        if (plan->cache)
+            slot = i / plan->istep;
+        else
+        {
+            slot = 0;
+            CHARM(sha_point_block)(plan, i, slot);
+        }
+
+
+        REAL *symmv       = plan->symmv + slot * SIMD_SIZE * BLOCK_A;
+        REAL *latsinv     = plan->latsinv + slot * SIMD_SIZE * BLOCK_A;
+        REAL_SIMD *t      = plan->t + slot * BLOCK_A;
+        REAL_SIMD *u      = plan->u + slot * BLOCK_A;
+        REAL_SIMD *symm   = plan->symm + slot * BLOCK_A;
+        REAL_SIMD *latsin = plan->latsin + slot * BLOCK_A;
+        REAL *ps          = plan->ps + slot * nmax * SIMD_SIZE * BLOCK_A;
+        INT *ips          = plan->ips + slot * nmax * SIMD_SIZE * BLOCK_A;
+        /* ----------------------------------------------------------------- */
+
+
+        for (l = 0; l < BLOCK_A; l++)
+        {
+            for (size_t v = 0; v < SIMD_SIZE; v++)
+            {
+                ipv = i + l * SIMD_SIZE + v;
+                if (latsinv[l * SIMD_SIZE + v] != 1)
+                    continue;
+
+
+                /* Lumped coefficients for the southern hemisphere
+                 * (including the equator) */
+                /* ----------------------------------------------------- */
+                memcpy(ftmp_in, f + ipv * pnt_nlon, pnt_nlon * sizeof(REAL));
+                FFTW(execute_dft_r2c)(plan->plan, ftmp_in, ftmp_out);
+
+
+                cw = c * pnt->w[ipv];
+                for (size_t j = 0; j < pnt_nlon_fft; j++)
+                {
+                    a[j * (SIMD_SIZE * BLOCK_A) +
+                      l * SIMD_SIZE + v]  =  cw * ftmp_out[j][0];
+                    b[j * (SIMD_SIZE * BLOCK_A) +
+                      l * SIMD_SIZE + v]  = -cw * ftmp_out[j][1];
+                }
+                /* ----------------------------------------------------- */
+
+
+                /* Lumped coefficients for the northern hemisphere */
+                /* ----------------------------------------------------- */
+                if (symmv[l * SIMD_SIZE + v])
+                {
+                    memcpy(ftmp_in, f + (pnt_nlat - ipv - 1) * pnt_nlon,
+                           pnt_nlon * sizeof(REAL));
+                    FFTW(execute_dft_r2c)(plan->plan, ftmp_in, ftmp_out);
+
+
+                    cw = c * pnt->w[pnt_nlat - ipv - 1];
+                    for (size_t j = 0; j < pnt_nlon_fft; j++)
+                    {
+                        a2[j * (SIMD_SIZE * BLOCK_A) +
+                           l * SIMD_SIZE + v]  =  cw * ftmp_out[j][0];
+                        b2[j * (SIMD_SIZE * BLOCK_A) +
+                           l * SIMD_SIZE + v]  = -cw * ftmp_out[j][1];
+                    }
+                }
+                /* ----------------------------------------------------- */
+            }
+        }
+
+
+        /* ------------------------------------------------------------- */
+#if HAVE_OPENMP
+
+
+#   undef SIMD_VARS
+#   if HAVE_RUNTIME_BLOCK
+#       define SIMD_VARS shared(BLOCK_A)
+#   else
+#       define SIMD_VARS
+#   endif
+
+
+#pragma omp parallel default(none) num_threads(plan->nthreads) \
+shared(plan, nmax, symm, r, ri, a, b, a2, b2, shcs, shcs_block, t, u) \
+shared(ps, ips) \
+shared(latsin, pt, err_glob, kernel_err_glob, err) SIMD_VARS SHA_KERNEL_VARS
+#endif
+        {
+        int err_priv = 0;
+        unsigned long kernel_err_priv = 0;
+
+
+#if HAVE_OPENMP
+        int tid = omp_get_thread_num();
+#else
+        int tid = 0;
+#endif
+        REAL *anm = plan->anm[tid];
+        REAL *bnm = plan->bnm[tid];
+
+
+        /* ............................................................. */
+#if HAVE_MPI
+        if (shcs_block->distributed)
+        {
+            CHARM(shc_block_reset_coeffs)(shcs_block);
+            CHARM(shc_block_set_mfirst)(shcs_block, shcs, 0, err);
+            if (!CHARM(err_isempty)(err))
+            {
+                err_priv = 1;
+                goto BARRIER_2;
+            }
+        }
+#endif
+        /* ............................................................. */
+
+
+        /* ............................................................. */
+#if HAVE_MPI
+BARRIER_2:
+#endif
+        if (CHARM(err_omp_mpi)(&err_glob, &err_priv, CHARM_ERR_MALLOC_FAILURE,
+                               CHARM_EMEM, err))
+        {
+#if HAVE_OPENMP
+#pragma omp master
+#endif
+            if (!CHARM(err_isempty)(err))
+                CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+#if HAVE_OPENMP
+#pragma omp barrier
+#endif
+            goto FAILURE_2;
+        }
+        /* ............................................................. */
+
+
+        /* Loop over harmonic orders */
+        /* ------------------------------------------------------------- */
+        /* For a more detailed description of the rational behind this block,
+         * see "shs_point_sctr.c" */
+        unsigned long m = shcs_block->mfirst;
+
+
+        do
+        {
+            /* The minimum and the maximum orders of the loop are the same for
+             * all OpenMP threads */
+            unsigned long mmin = shcs_block->mfirst;
+            unsigned long mmax = CHARM_MIN(shcs_block->mlast, nmax);
+
+
+#if HAVE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for (m = mmin; m <= mmax; m++)
+            {
+                /* Apply polar optimization if asked to do so */
+                if (CHARM(misc_polar_optimization_apply)(m, nmax, &u[0],
+                                                         BLOCK_A, pt))
+                    continue;
+
+
+                /* Computation of "anm" and "bnm" coefficients for Legendre
+                 * recurrence relations */
+                CHARM(leg_func_anm_bnm)(nmax, m, r, ri, anm, bnm);
+
+
+                /* Computation of spherical harmonic coefficients */
+                size_t ab = (SIMD_SIZE * BLOCK_A) * m;
+                if (SHA_KERNEL(sha_point_kernel)(nmax, m, shcs_block, anm, bnm,
+                                                 t, symm, latsin, ps, ips,
+                                                 a + ab, b + ab, a2 + ab,
+                                                 b2 + ab, BLOCK_A))
+                    kernel_err_priv += 1;
+
+
+            } /* End of the loop over harmonic orders */
+
+
+            /* See "shs_point_sctr.c" for the rational here */
+            m = mmax + 1;
+
+
+#if HAVE_MPI
+            /* Now that we have processed all harmonic degree "mmin", ...,
+             * "mmax", it is time to sum the contributions from the MPI
+             * processes and send the result to the processes holding this
+             * chunk of coefficients */
+            CHARM(shc_block_set_coeffs)(shcs, shcs_block, mmin, mmax, err);
+            /* Only the master thread in "shc_block_set_coeffs" modifies "err",
+             * so we do not need below "CHARM(err_omp_mpi)" */
+            if (CHARM(err_omp_mpi)(&err_glob, &err_priv,
+                                   CHARM_ERR_MALLOC_FAILURE, CHARM_EMEM, err))
+            {
+#   if HAVE_OPENMP
+#pragma omp master
+#   endif
+                if (!CHARM(err_isempty)(err))
+                    CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+#   if HAVE_OPENMP
+#pragma omp barrier
+#   endif
+                goto FAILURE_2;
+            }
+#endif
+        }
+        while (m <= nmax);
+        /* ------------------------------------------------------------- */
+
+
+#if HAVE_OPENMP
+#pragma omp atomic
+#endif
+        kernel_err_glob += kernel_err_priv;
+
+
+FAILURE_2:
+        ;
+        }
+        /* ------------------------------------------------------------- */
+
+
+    } /* End of the loop over latitude parallels */
+
+
+    if (kernel_err_glob)
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+    /* ----------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+FAILURE_1:
+    CHARM(shc_block_free)(shcs_block);
+
+
+    if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+        return;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Rescale the coefficients to the sphere of radius "shcs->r0" */
+    /* --------------------------------------------------------------------- */
+    if (!CHARM(misc_is_nearly_equal)(shcs->r, r0, CHARM(glob_threshold)))
+    {
+        /* This is the desired radius to scale the output coefficients */
+        const REAL rtmp = shcs->r;
+
+
+        /* Now set the "shcs->r" to "r0", since the analysis was conducted on
+         * a sphere with the radius "r0", which is different from "shcs->r"
+         * (otherwise, the program would not enter this "if" condition). */
+        shcs->r = r0;
+
+
+        /* And now rescale the coefficients from "r0", for which the analysis
+         * was done, to the desired "rtmp" */
+        CHARM(shc_rescale)(shcs, shcs->mu, rtmp, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    return;
+}
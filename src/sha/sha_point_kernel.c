@@ -0,0 +1,399 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../prec.h"
+#include "../shc/shc_block_struct.h"
+#include "../shc/shc_block_get_idx.h"
+#include "../leg/leg_func_xnum.h"
+#include "../leg/leg_func_use_xnum.h"
+#include "../misc/misc_sd_calloc.h"
+#include "../simd/simd.h"
+#include "sha_point_kernel.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Macros */
+/* ------------------------------------------------------------------------- */
+#define CS_SUM(cs, pnm, ab)                                                   \
+    cs_sum = SET_ZERO_R;                                                      \
+    for (l = 0; l < BLOCK_A; l++)                                             \
+    {                                                                         \
+        cs_sum = FMA_R((pnm)[l], (ab)[l], cs_sum);                            \
+    }                                                                         \
+    (cs) += SUM_R(cs_sum);
+
+
+
+
+
+
+#define LOOP_ITER(n, a, b)                                                    \
+    anms = SET1_R(anm[(n)]);                                                  \
+    bnms = SET1_R(bnm[(n)]);                                                  \
+                                                                              \
+                                                                              \
+    for (l = 0; l < BLOCK_A; l++)                                             \
+    {                                                                         \
+        PNM_RECURRENCE(x[l], y[l], pnm2[l], t[l], anms, bnms);                \
+        RECURRENCE_NEXT_ITER(y[l], x[l], pnm2[l]);                            \
+    }                                                                         \
+                                                                              \
+                                                                              \
+    CS_SUM(shcs_block->c[idx], pnm2, a);                                      \
+    CS_SUM(shcs_block->s[idx++], pnm2, b);
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Adds the contributions of a latitude block to the spherical harmonic
+ * coefficients of order "m" in "shcs_block".  "a", "b", "a2" and "b2" are the
+ * lumped coefficients of order "m" of the latitude block.  Returns "1" if
+ * memory allocation failed and "0" otherwise. */
+_Bool SIMD_ISA_NAME(sha_point_kernel)(unsigned long nmax,
+                                      unsigned long m,
+                                      CHARM(shc_block) *shcs_block,
+                                      const REAL *anm,
+                                      const REAL *bnm,
+                                      const REAL_SIMD *t,
+                                      const REAL_SIMD *symm,
+                                      const REAL_SIMD *latsin,
+                                      const REAL *ps,
+                                      const INT *ips,
+                                      const REAL *a,
+                                      const REAL *b,
+                                      const REAL *a2,
+                                      const REAL *b2,
+                                      size_t block_a)
+{
+    /* --------------------------------------------------------------------- */
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_A = block_a * SIMD_SPLIT;
+#else
+    (void)block_a;
+#   define BLOCK_A SIMD_BLOCK_A
+#endif
+
+
+    _Bool error = 0;
+
+
+    MISC_SD_CALLOC_REAL_SIMD_INIT(pnm0);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(pnm1);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(pnm2);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(x);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(y);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(z);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(amp);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(amm);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(bmp);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(bmm);
+    MISC_SD_CALLOC_RI_SIMD_INIT(ix);
+    MISC_SD_CALLOC_RI_SIMD_INIT(iy);
+    MISC_SD_CALLOC_RI_SIMD_INIT(iz);
+    MISC_SD_CALLOC_RI_SIMD_INIT(ixy);
+    MISC_SD_CALLOC__BOOL_INIT(ds);
+
+
+    MISC_SD_CALLOC_REAL_SIMD_E(pnm0, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(pnm1, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(pnm2, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(x, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(y, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(z, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(amp, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(amm, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(bmp, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(bmm, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(ix, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(iy, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(iz, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(ixy, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC__BOOL_E(ds, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+
+
+#if HAVE_RUNTIME_BLOCK
+BARRIER_1:
+    if (error)
+        goto FAILURE_1;
+#endif
+    /* --------------------------------------------------------------------- */
+
+
+    /* --------------------------------------------------------------------- */
+    const REAL_SIMD ROOT3_r = SET1_R(ROOT3);
+#ifdef SIMD
+    const RI_SIMD    zero_ri = SET_ZERO_RI;
+    const RI_SIMD    one_ri  = SET1_RI(1);
+    const RI_SIMD    mone_ri = SET1_RI(-1);
+    const REAL_SIMD  zero_r  = SET_ZERO_R;
+    const REAL_SIMD  BIG_r   = SET1_R(BIG);
+    const REAL_SIMD  BIGI_r  = SET1_R(BIGI);
+    const REAL_SIMD  BIGS_r  = SET1_R(BIGS);
+    const REAL_SIMD  BIGSI_r = SET1_R(BIGSI);
+    REAL_SIMD  tmp1_r,  tmp2_r;
+    MASK_SIMD  mask1, mask2;
+    MASK2_SIMD mask3;
+#endif
+
+
+    REAL_SIMD anms, bnms;
+    REAL_SIMD wlf;
+    _Bool npm_even; /* True if "n + m" is even */
+    size_t l;
+    REAL_SIMD cs_sum;
+    REAL_SIMD am, bm, a2m, b2m;
+    /* --------------------------------------------------------------------- */
+
+
+    /* Some useful substitutions */
+    /* --------------------------------------------------------------------- */
+    for (l = 0; l < BLOCK_A; l++)
+    {
+        am  = LOAD_R(&a[l * SIMD_SIZE]);
+        bm  = LOAD_R(&b[l * SIMD_SIZE]);
+        a2m = LOAD_R(&a2[l * SIMD_SIZE]);
+        b2m = LOAD_R(&b2[l * SIMD_SIZE]);
+
+
+        amp[l] = MUL_R(ADD_R(am, MUL_R(symm[l], a2m)), latsin[l]);
+        amm[l] = MUL_R(SUB_R(am, MUL_R(symm[l], a2m)), latsin[l]);
+        bmp[l] = MUL_R(ADD_R(bm, MUL_R(symm[l], b2m)), latsin[l]);
+        bmm[l] = MUL_R(SUB_R(bm, MUL_R(symm[l], b2m)), latsin[l]);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    unsigned long idx = CHARM(shc_block_get_idx)(shcs_block, m);
+
+
+    /* Computation of spherical harmonic coefficients */
+    if (m == 0)
+    {
+        /* Zonal harmonics */
+        /* ----------------------------------------------------------------- */
+
+        /* P00 */
+        for (l = 0; l < BLOCK_A; l++)
+            pnm0[l] = SET1_R(PREC(1.0));
+        /* C00 */
+        CS_SUM(shcs_block->c[idx++], pnm0, amp);
+
+
+        if (nmax >= 1)
+        {
+            /* P10 */
+            for (l = 0; l < BLOCK_A; l++)
+                pnm1[l] = MUL_R(ROOT3_r, t[l]);
+            /* C10 */
+            CS_SUM(shcs_block->c[idx++], pnm1, amm);
+        }
+
+
+        /* P20, P30, ..., Pnmax,0 */
+        if (nmax >= 2)
+        {
+            /* Is "n + m" even?  Since we start the loop with "n = 2" and "m
+             * = 0", then the parity of the first "n + m" is always even.
+             * Then, it changes with every loop iteration. */
+            npm_even = 1;
+
+
+            for (unsigned long n = 2; n <= nmax; n++, npm_even = !npm_even)
+            {
+                anms = SET1_R(anm[n]);
+                bnms = SET1_R(bnm[n]);
+
+
+                for (l = 0; l < BLOCK_A; l++)
+                {
+                    pnm2[l] = FNMA_R(bnms, pnm0[l],
+                                     MUL_R(MUL_R(anms, t[l]), pnm1[l]));
+                    pnm0[l] = pnm1[l];
+                    pnm1[l] = pnm2[l];
+                }
+
+
+                /* C20, C30, ..., Cnmax,0 */
+                CS_SUM(shcs_block->c[idx++], pnm2, npm_even ? amp : amm);
+            }
+        }
+        /* ----------------------------------------------------------------- */
+
+    }
+    else /* Non-zonal harmonics */
+    {
+
+        /* Sectorial harmonics */
+        /* ----------------------------------------------------------------- */
+        for (l = 0; l < BLOCK_A; l++)
+        {
+#ifdef SIMD
+            PNM_SECTORIAL_XNUM_SIMD(x[l], ix[l], ps[PS_IDX(l, m, nmax)],
+                                    ips[PS_IDX(l, m, nmax)], pnm0[l],
+                                    BIG_r, zero_r, zero_ri, mone_ri, mask1,
+                                    mask2, SECTORIALS);
+#else
+            PNM_SECTORIAL_XNUM(x[l], ix[l], ps[PS_IDX(l, m, nmax)],
+                               ips[PS_IDX(l, m, nmax)], pnm0[l]);
+#endif
+        }
+
+
+        /* Cm,m; Sm,m */
+        CS_SUM(shcs_block->c[idx], pnm0, amp);
+        CS_SUM(shcs_block->s[idx++], pnm0, bmp);
+        /* ----------------------------------------------------------------- */
+
+
+        /* Tesseral harmonics */
+        /* ----------------------------------------------------------------- */
+        if (m < nmax)
+        {
+            anms = SET1_R(anm[m + 1]);
+            bnms = SET1_R(bnm[m + 1]);
+
+
+            for (l = 0; l < BLOCK_A; l++)
+            {
+#ifdef SIMD
+                PNM_SEMISECTORIAL_XNUM_SIMD(x[l], y[l], ix[l], iy[l], wlf,
+                                            t[l], anms, pnm1[l], mask1, mask2,
+                                            mask3, zero_r, zero_ri, mone_ri,
+                                            BIG_r, BIGS_r,  BIGI_r,
+                                            SEMISECTORIALS);
+#else
+                PNM_SEMISECTORIAL_XNUM(x[l], y[l], ix[l], iy[l], wlf, t[l],
+                                       anms, pnm1[l]);
+#endif
+            }
+
+
+            /* Cm+1,m; Sm+1,m */
+            CS_SUM(shcs_block->c[idx], pnm1, amm);
+            CS_SUM(shcs_block->s[idx++], pnm1, bmm);
+
+
+            /* Loop over degrees */
+            /* ------------------------------------------------------------- */
+            for (l = 0; l < BLOCK_A; l++)
+                ds[l] = 0;
+
+
+            /* Is "n + m" even?  Since we start the loop with "n = m + 2",
+             * then the parity of the first "m + 2 + m" is always even.  Then,
+             * it changes with every loop iteration. */
+            npm_even = 1;
+
+
+            unsigned long n;
+            for (n = (m + 2);
+                 CHARM(leg_func_use_xnum(ds, BLOCK_A)) && n <= nmax;
+                 n++, npm_even = !npm_even)
+            {
+                anms = SET1_R(anm[n]);
+                bnms = SET1_R(bnm[n]);
+
+
+                /* Compute tesseral Legendre function */
+                for (l = 0; l < BLOCK_A; l++)
+                {
+#ifdef SIMD
+                    PNM_TESSERAL_XNUM_SIMD(x[l], y[l], z[l], ix[l], iy[l],
+                                           iz[l], ixy[l], wlf, t[l], anms,
+                                           bnms, pnm2[l], tmp1_r, tmp2_r,
+                                           mask1, mask2, mask3, zero_r,
+                                           zero_ri, one_ri, BIG_r, BIGI_r,
+                                           BIGS_r, BIGSI_r, TESSERALS1,
+                                           TESSERALS2, ds[l]);
+#else
+                    PNM_TESSERAL_XNUM(x[l], y[l], z[l], ix[l], iy[l], iz[l],
+                                      ixy[l], wlf, t[l], anms, bnms, pnm2[l],
+                                      ds[l]);
+#endif
+                }
+
+
+                /* Cm+2,m, Cm+3,m, ... and Sm+2,m, Sm+3,m, ... */
+                CS_SUM(shcs_block->c[idx], pnm2, npm_even ? amp : amm);
+                CS_SUM(shcs_block->s[idx++], pnm2, npm_even ? bmp : bmm);
+            }
+
+
+            /* From now on, "F"-numbers can be used instead of the "X"-numbers
+             * to gain some speed */
+            if (n <= nmax)
+            {
+                /* We want to unroll the loop that follows.  To do that, we
+                 * need to make sure that the loop starts with an even value of
+                 * "n + m".  So if "n + m" is odd, we need to hard code one
+                 * iteration. */
+                if (!npm_even)
+                {
+                    LOOP_ITER(n, amm, bmm);
+                    n++;
+                }
+
+
+                /* Now safely compute the rest of the loop (if any) using the
+                 * "F"-numbers */
+                for (; (n + 1) <= nmax; n += 2)
+                {
+                    LOOP_ITER(n,     amp, bmp);
+                    LOOP_ITER(n + 1, amm, bmm);
+                }
+
+
+                if (n <= nmax)
+                {
+                    LOOP_ITER(n, amp, bmp);
+                }
+            }
+            /* ------------------------------------------------------------- */
+
+
+        } /* End of computation of tesseral harmonics */
+        /* ----------------------------------------------------------------- */
+
+
+    } /* End of computation of spherical harmonic coefficients */
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+#if HAVE_RUNTIME_BLOCK
+FAILURE_1:
+#endif
+    MISC_SD_FREE(pnm0);
+    MISC_SD_FREE(pnm1);
+    MISC_SD_FREE(pnm2);
+    MISC_SD_FREE(x);
+    MISC_SD_FREE(y);
+    MISC_SD_FREE(z);
+    MISC_SD_FREE(amp);
+    MISC_SD_FREE(amm);
+    MISC_SD_FREE(bmp);
+    MISC_SD_FREE(bmm);
+    MISC_SD_FREE(ix);
+    MISC_SD_FREE(iy);
+    MISC_SD_FREE(iz);
+    MISC_SD_FREE(ixy);
+    MISC_SD_FREE(ds);
+
+
+    return error;
+    /* --------------------------------------------------------------------- */
+}
@@ -0,0 +1,352 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../prec.h"
+#include "../shc/shc_block_struct.h"
+#include "../shc/shc_block_get_idx.h"
+#include "../leg/leg_func_xnum.h"
+#include "../leg/leg_func_use_xnum.h"
+#include "../misc/misc_sd_calloc.h"
+#include "../simd/simd.h"
+#include "sha_point_kernel_batch.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Macros */
+/* ------------------------------------------------------------------------- */
+#define CS_SUM(cs, pnm, ab)                                                   \
+    cs_sum = SET_ZERO_R;                                                      \
+    for (l = 0; l < BLOCK_A; l++)                                             \
+    {                                                                         \
+        cs_sum = FMA_R((pnm)[l], (ab)[l], cs_sum);                            \
+    }                                                                         \
+    (cs) += SUM_R(cs_sum);
+
+
+/* Stores the Legendre function "pnm" of degree "n" to "leg" */
+#define LEG_STORE(n, pnm)                                                     \
+    for (l = 0; l < BLOCK_A; l++)                                             \
+        leg[((n) - m) * BLOCK_A + l] = (pnm)[l];
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Adds the contributions of a latitude block to the spherical harmonic
+ * coefficients of order "m" of "nsignals" signals in "shcs_blocks".  The
+ * Legendre functions of degrees "m", "m + 1", ..., "nmax" are first stored in
+ * "leg" and are then used for all the signals.  "a", "b", "a2" and "b2" are
+ * the lumped coefficients of order "m" of the first signal, the lumped
+ * coefficients of the "k"th signal are shifted by "k * nab" elements.
+ * Returns "1" if memory allocation failed and "0" otherwise. */
+_Bool SIMD_ISA_NAME(sha_point_kernel_batch)(unsigned long nmax,
+                                            unsigned long m,
+                                            CHARM(shc_block) **shcs_blocks,
+                                            size_t nsignals,
+                                            const REAL *anm,
+                                            const REAL *bnm,
+                                            const REAL_SIMD *t,
+                                            const REAL_SIMD *symm,
+                                            const REAL_SIMD *latsin,
+                                            const REAL *ps,
+                                            const INT *ips,
+                                            const REAL *a,
+                                            const REAL *b,
+                                            const REAL *a2,
+                                            const REAL *b2,
+                                            size_t nab,
+                                            size_t block_a,
+                                            REAL_SIMD *leg)
+{
+    /* --------------------------------------------------------------------- */
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_A = block_a * SIMD_SPLIT;
+#else
+    (void)block_a;
+#   define BLOCK_A SIMD_BLOCK_A
+#endif
+
+
+    _Bool error = 0;
+
+
+    MISC_SD_CALLOC_REAL_SIMD_INIT(pnm0);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(pnm1);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(pnm2);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(x);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(y);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(z);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(amp);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(amm);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(bmp);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(bmm);
+    MISC_SD_CALLOC_RI_SIMD_INIT(ix);
+    MISC_SD_CALLOC_RI_SIMD_INIT(iy);
+    MISC_SD_CALLOC_RI_SIMD_INIT(iz);
+    MISC_SD_CALLOC_RI_SIMD_INIT(ixy);
+    MISC_SD_CALLOC__BOOL_INIT(ds);
+
+
+    MISC_SD_CALLOC_REAL_SIMD_E(pnm0, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(pnm1, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(pnm2, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(x, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(y, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(z, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(amp, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(amm, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(bmp, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(bmm, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(ix, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(iy, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(iz, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(ixy, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+    MISC_SD_CALLOC__BOOL_E(ds, BLOCK_A, SIMD_BLOCK_A, error, BARRIER_1);
+
+
+#if HAVE_RUNTIME_BLOCK
+BARRIER_1:
+    if (error)
+        goto FAILURE_1;
+#endif
+    /* --------------------------------------------------------------------- */
+
+
+    /* --------------------------------------------------------------------- */
+    const REAL_SIMD ROOT3_r = SET1_R(ROOT3);
+#ifdef SIMD
+    const RI_SIMD    zero_ri = SET_ZERO_RI;
+    const RI_SIMD    one_ri  = SET1_RI(1);
+    const RI_SIMD    mone_ri = SET1_RI(-1);
+    const REAL_SIMD  zero_r  = SET_ZERO_R;
+    const REAL_SIMD  BIG_r   = SET1_R(BIG);
+    const REAL_SIMD  BIGI_r  = SET1_R(BIGI);
+    const REAL_SIMD  BIGS_r  = SET1_R(BIGS);
+    const REAL_SIMD  BIGSI_r = SET1_R(BIGSI);
+    REAL_SIMD  tmp1_r,  tmp2_r;
+    MASK_SIMD  mask1, mask2;
+    MASK2_SIMD mask3;
+#endif
+
+
+    REAL_SIMD anms, bnms;
+    REAL_SIMD wlf;
+    _Bool npm_even; /* True if "n + m" is even */
+    size_t l;
+    REAL_SIMD cs_sum;
+    REAL_SIMD am, bm, a2m, b2m;
+    /* --------------------------------------------------------------------- */
+
+
+    /* Legendre functions of degrees "m", "m + 1", ..., "nmax" */
+    /* --------------------------------------------------------------------- */
+    if (m == 0)
+    {
+        /* P00 */
+        for (l = 0; l < BLOCK_A; l++)
+            pnm0[l] = SET1_R(PREC(1.0));
+        LEG_STORE(0, pnm0);
+
+
+        if (nmax >= 1)
+        {
+            /* P10 */
+            for (l = 0; l < BLOCK_A; l++)
+                pnm1[l] = MUL_R(ROOT3_r, t[l]);
+            LEG_STORE(1, pnm1);
+        }
+
+
+        /* P20, P30, ..., Pnmax,0 */
+        for (unsigned long n = 2; n <= nmax; n++)
+        {
+            anms = SET1_R(anm[n]);
+            bnms = SET1_R(bnm[n]);
+
+
+            for (l = 0; l < BLOCK_A; l++)
+            {
+                pnm2[l] = FNMA_R(bnms, pnm0[l],
+                                 MUL_R(MUL_R(anms, t[l]), pnm1[l]));
+                pnm0[l] = pnm1[l];
+                pnm1[l] = pnm2[l];
+            }
+            LEG_STORE(n, pnm2);
+        }
+    }
+    else
+    {
+        /* Sectorial Legendre functions */
+        for (l = 0; l < BLOCK_A; l++)
+        {
+#ifdef SIMD
+            PNM_SECTORIAL_XNUM_SIMD(x[l], ix[l], ps[PS_IDX(l, m, nmax)],
+                                    ips[PS_IDX(l, m, nmax)], pnm0[l],
+                                    BIG_r, zero_r, zero_ri, mone_ri, mask1,
+                                    mask2, SECTORIALS);
+#else
+            PNM_SECTORIAL_XNUM(x[l], ix[l], ps[PS_IDX(l, m, nmax)],
+                               ips[PS_IDX(l, m, nmax)], pnm0[l]);
+#endif
+        }
+        LEG_STORE(m, pnm0);
+
+
+        /* Tesseral Legendre functions */
+        if (m < nmax)
+        {
+            anms = SET1_R(anm[m + 1]);
+            bnms = SET1_R(bnm[m + 1]);
+
+
+            for (l = 0; l < BLOCK_A; l++)
+            {
+#ifdef SIMD
+                PNM_SEMISECTORIAL_XNUM_SIMD(x[l], y[l], ix[l], iy[l], wlf,
+                                            t[l], anms, pnm1[l], mask1, mask2,
+                                            mask3, zero_r, zero_ri, mone_ri,
+                                            BIG_r, BIGS_r,  BIGI_r,
+                                            SEMISECTORIALS);
+#else
+                PNM_SEMISECTORIAL_XNUM(x[l], y[l], ix[l], iy[l], wlf, t[l],
+                                       anms, pnm1[l]);
+#endif
+            }
+            LEG_STORE(m + 1, pnm1);
+
+
+            for (l = 0; l < BLOCK_A; l++)
+                ds[l] = 0;
+
+
+            unsigned long n;
+            for (n = (m + 2);
+                 CHARM(leg_func_use_xnum(ds, BLOCK_A)) && n <= nmax;
+                 n++)
+            {
+                anms = SET1_R(anm[n]);
+                bnms = SET1_R(bnm[n]);
+
+
+                for (l = 0; l < BLOCK_A; l++)
+                {
+#ifdef SIMD
+                    PNM_TESSERAL_XNUM_SIMD(x[l], y[l], z[l], ix[l], iy[l],
+                                           iz[l], ixy[l], wlf, t[l], anms,
+                                           bnms, pnm2[l], tmp1_r, tmp2_r,
+                                           mask1, mask2, mask3, zero_r,
+                                           zero_ri, one_ri, BIG_r, BIGI_r,
+                                           BIGS_r, BIGSI_r, TESSERALS1,
+                                           TESSERALS2, ds[l]);
+#else
+                    PNM_TESSERAL_XNUM(x[l], y[l], z[l], ix[l], iy[l], iz[l],
+                                      ixy[l], wlf, t[l], anms, bnms, pnm2[l],
+                                      ds[l]);
+#endif
+                }
+                LEG_STORE(n, pnm2);
+            }
+
+
+            /* From now on, "F"-numbers can be used instead of the
+             * "X"-numbers */
+            for (; n <= nmax; n++)
+            {
+                anms = SET1_R(anm[n]);
+                bnms = SET1_R(bnm[n]);
+
+
+                for (l = 0; l < BLOCK_A; l++)
+                {
+                    PNM_RECURRENCE(x[l], y[l], pnm2[l], t[l], anms, bnms);
+                    RECURRENCE_NEXT_ITER(y[l], x[l], pnm2[l]);
+                }
+                LEG_STORE(n, pnm2);
+            }
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* Spherical harmonic coefficients of all signals */
+    /* --------------------------------------------------------------------- */
+    for (size_t k = 0; k < nsignals; k++)
+    {
+        const REAL *ak  = a + k * nab;
+        const REAL *bk  = b + k * nab;
+        const REAL *a2k = a2 + k * nab;
+        const REAL *b2k = b2 + k * nab;
+
+
+        for (l = 0; l < BLOCK_A; l++)
+        {
+            am  = LOAD_R(&ak[l * SIMD_SIZE]);
+            bm  = LOAD_R(&bk[l * SIMD_SIZE]);
+            a2m = LOAD_R(&a2k[l * SIMD_SIZE]);
+            b2m = LOAD_R(&b2k[l * SIMD_SIZE]);
+
+
+            amp[l] = MUL_R(ADD_R(am, MUL_R(symm[l], a2m)), latsin[l]);
+            amm[l] = MUL_R(SUB_R(am, MUL_R(symm[l], a2m)), latsin[l]);
+            bmp[l] = MUL_R(ADD_R(bm, MUL_R(symm[l], b2m)), latsin[l]);
+            bmm[l] = MUL_R(SUB_R(bm, MUL_R(symm[l], b2m)), latsin[l]);
+        }
+
+
+        CHARM(shc_block) *shcs_block = shcs_blocks[k];
+        unsigned long idx = CHARM(shc_block_get_idx)(shcs_block, m);
+
+
+        npm_even = 1;
+        for (unsigned long n = m; n <= nmax; n++, npm_even = !npm_even)
+        {
+            CS_SUM(shcs_block->c[idx], leg + (n - m) * BLOCK_A,
+                   npm_even ? amp : amm);
+            if (m > 0)
+            {
+                CS_SUM(shcs_block->s[idx], leg + (n - m) * BLOCK_A,
+                       npm_even ? bmp : bmm);
+            }
+            idx++;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+#if HAVE_RUNTIME_BLOCK
+FAILURE_1:
+#endif
+    MISC_SD_FREE(pnm0);
+    MISC_SD_FREE(pnm1);
+    MISC_SD_FREE(pnm2);
+    MISC_SD_FREE(x);
+    MISC_SD_FREE(y);
+    MISC_SD_FREE(z);
+    MISC_SD_FREE(amp);
+    MISC_SD_FREE(amm);
+    MISC_SD_FREE(bmp);
+    MISC_SD_FREE(bmm);
+    MISC_SD_FREE(ix);
+    MISC_SD_FREE(iy);
+    MISC_SD_FREE(iz);
+    MISC_SD_FREE(ixy);
+    MISC_SD_FREE(ds);
+
+
+    return error;
+    /* --------------------------------------------------------------------- */
+}
@@ -0,0 +1,45 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHA_POINT_KERNEL_BATCH_H__
+#define __SHA_POINT_KERNEL_BATCH_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "../shc/shc_block_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern _Bool SIMD_ISA_NAME(sha_point_kernel_batch)(unsigned long,
+                                                   unsigned long,
+                                                   CHARM(shc_block) **,
+                                                   size_t,
+                                                   const REAL *,
+                                                   const REAL *,
+                                                   const REAL_SIMD *,
+                                                   const REAL_SIMD *,
+                                                   const REAL_SIMD *,
+                                                   const REAL *,
+                                                   const INT *,
+                                                   const REAL *,
+                                                   const REAL *,
+                                                   const REAL *,
+                                                   const REAL *,
+                                                   size_t,
+                                                   size_t,
+                                                   REAL_SIMD *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
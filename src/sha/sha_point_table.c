@@ -0,0 +1,303 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fftw3.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../crd/crd_point_isQuadGrid.h"
+#include "../crd/crd_point_quad_get_nmax_from_nlat.h"
+#include "../shc/shc_reset_coeffs.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+#include "../misc/misc_is_nearly_equal.h"
+#include "../misc/misc_fftw_plans.h"
+#include "../leg/leg_table_struct.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Macros */
+/* ------------------------------------------------------------------------- */
+/* Dot product of the Legendre functions "p" of degree "n" and order "m" with
+ * the lumped coefficients "am" and "bm" of all latitudes */
+#undef CS_SUM
+#define CS_SUM(p)                                                             \
+    for (size_t i = 0; i < nlat; i++)                                         \
+    {                                                                         \
+        cnm += (REAL)(p)[i] * am[i];                                          \
+        snm += (REAL)(p)[i] * bm[i];                                          \
+    }
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(sha_point_table)(const CHARM(leg_table) *table,
+                            const REAL *f,
+                            unsigned long nmax,
+                            CHARM(shc) *shcs,
+                            CHARM(err) *err)
+{
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
+    if (shcs->distributed)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Distributed \"shcs\" are not supported.");
+        return;
+    }
+
+
+    const CHARM(point) *pnt = table->pnt;
+    if (!CHARM(crd_point_isQuadGrid)(pnt->type))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Unsupported \"pnt->type\" for spherical "
+                       "harmonic analysis of point data values.");
+        return;
+    }
+
+
+    if (nmax > shcs->nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Maximum harmonic degree of the analysis (\"nmax\") "
+                       "cannot be larger than "
+                       "maximum harmonic degree of spherical harmonic "
+                       "coefficients (\"shcs->nmax\").");
+        return;
+    }
+
+
+    if (nmax > table->nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Maximum harmonic degree of the analysis (\"nmax\") "
+                       "cannot be larger than maximum harmonic degree of "
+                       "the table.");
+        return;
+    }
+
+
+    const unsigned long nmax_grd =
+                  CHARM(crd_point_quad_get_nmax_from_nlat)(pnt->type,
+                                                           pnt->nlat);
+    if (nmax > nmax_grd)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "The input data grid \"pnt\" was "
+                       "created for a maximum degree that "
+                       "is not high enough to recover harmonics up "
+                       "to the specified maximum degree of the "
+                       "analysis.");
+        return;
+    }
+
+
+    const REAL r0 = pnt->r[0];
+    for (size_t i = 1; i < pnt->nlat; i++)
+    {
+        if (!CHARM(misc_is_nearly_equal)(pnt->r[i], r0, CHARM(glob_threshold)))
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           "All spherical radii in \"pnt->r\" must be "
+                           "equal.");
+            return;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    const size_t nlat  = table->nlat;
+    const size_t nlon  = pnt->nlon;
+    const size_t nfc   = nlon / 2 + 1;
+    const size_t tnmax = table->nmax;
+    const _Bool single = table->single;
+    const size_t mmax  = CHARM_MIN(nmax, nfc - 1);
+
+
+    REAL *a    = NULL;
+    REAL *b    = NULL;
+    REAL *ftmp = NULL;
+    FFTWC(complex) *fc = NULL;
+    FFTW(plan) plan = NULL;
+
+
+    /* "4pi" normalization and normalization to "r0" and "shcs->mu", see
+     * "sha_plan_create" and "sha_point_exec" */
+    REAL c = PREC(0.0);
+    if ((pnt->type == CHARM_CRD_POINT_GRID_GL) ||
+        (pnt->type == CHARM_CRD_POINT_GRID_DH1))
+        c = PI / (REAL)(nmax_grd + 1);
+    else if (pnt->type == CHARM_CRD_POINT_GRID_DH2)
+        c = PI / (REAL)(2 * nmax_grd + 2);
+    c *= PREC(1.0) / (PREC(4.0) * PI) * (r0 / shcs->mu);
+
+
+    /* Lumped coefficients of the order "m" and the "i"th latitude are stored
+     * in "a[m * nlat + i]" and "b[m * nlat + i]" */
+    a    = (REAL *)malloc((nmax + 1) * nlat * sizeof(REAL));
+    b    = (REAL *)malloc((nmax + 1) * nlat * sizeof(REAL));
+    ftmp = (REAL *)FFTW(malloc)(nlon * sizeof(REAL));
+    fc   = (FFTWC(complex) *)FFTW(malloc)(nfc * sizeof(FFTWC(complex)));
+    if ((a == NULL) || (b == NULL) || (ftmp == NULL) || (fc == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto EXIT;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Lumped coefficients */
+    /* --------------------------------------------------------------------- */
+#if HAVE_OPENMP && FFTW3_OMP
+    if (FFTW(init_threads)() == 0)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFFTWINIT,
+                       CHARM_ERR_FFTW_INIT_FAILURE);
+        goto EXIT;
+    }
+    FFTW(plan_with_nthreads)(omp_get_max_threads());
+#endif
+    plan = FFTW(plan_dft_r2c_1d)(nlon, ftmp, fc, FFTW_ESTIMATE);
+    if (plan == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto EXIT;
+    }
+
+
+    for (size_t i = 0; i < nlat; i++)
+    {
+        memcpy(ftmp, f + i * nlon, nlon * sizeof(REAL));
+        FFTW(execute_dft_r2c)(plan, ftmp, fc);
+
+
+        REAL cw = c * pnt->w[i];
+        for (size_t m = 0; m <= nmax; m++)
+        {
+            a[m * nlat + i] = (m <= mmax) ?  cw * fc[m][0] : PREC(0.0);
+            b[m * nlat + i] = (m <= mmax) ? -cw * fc[m][1] : PREC(0.0);
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Spherical harmonic coefficients.  Instead of the recurrence relations,
+     * the Legendre functions are taken from the table. */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc_reset_coeffs)(shcs);
+
+
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) schedule(dynamic) \
+shared(table, shcs, nmax, nlat, tnmax, single, a, b)
+#endif
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        const REAL *am = a + m * nlat;
+        const REAL *bm = b + m * nlat;
+
+
+        for (unsigned long n = m; n <= nmax; n++)
+        {
+            REAL cnm = PREC(0.0);
+            REAL snm = PREC(0.0);
+
+
+            size_t idx = LEG_TABLE_IDX(tnmax, n, m) * nlat;
+            if (single)
+            {
+                const float *p = table->pnmf[0] + idx;
+                CS_SUM(p);
+            }
+            else
+            {
+                const REAL *p = table->pnm[0] + idx;
+                CS_SUM(p);
+            }
+
+
+            shcs->c[m][n - m] = cnm;
+            if (m > 0)
+                shcs->s[m][n - m] = snm;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Rescale the coefficients to the sphere of radius "shcs->r0" */
+    /* --------------------------------------------------------------------- */
+    if (!CHARM(misc_is_nearly_equal)(shcs->r, r0, CHARM(glob_threshold)))
+    {
+        const REAL rtmp = shcs->r;
+        shcs->r = r0;
+        CHARM(shc_rescale)(shcs, shcs->mu, rtmp, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+EXIT:
+    if (plan != NULL)
+    {
+        FFTW(destroy_plan)(plan);
+        CHARM(misc_fftw_cleanup)();
+    }
+    FFTW(free)(ftmp);
+    FFTW(free)(fc);
+    free(a);
+    free(b);
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
@@ -9,6 +9,7 @@
 #include "../err/err_check_distribution.h"
 #include "../misc/misc_is_nearly_equal.h"
 #include "shc_check_distribution.h"
+#include "shc_check_map.h"
 #include "shc_arithmetics_checks.h"
 /* ------------------------------------------------------------------------- */
 
@@ -40,6 +41,14 @@ void CHARM(shc_arithmetics_checks)(CHARM(shc) *rop,
     }
 
 
+    CHARM(shc_check_map)(rop, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
     CHARM(shc_check_distribution)(op1, err);
     if (!CHARM(err_isempty)(err))
     {
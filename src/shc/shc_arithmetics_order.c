@@ -0,0 +1,103 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "shc_arithmetics_row.h"
+#include "shc_arithmetics_order.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Computes the coefficients of order "m" and degrees "max(nmin, m)" to "nmax"
+ * of "rop" as "op1 op op2", where "op" is "SHC_ROW_ADD", "SHC_ROW_SUB",
+ * "SHC_ROW_MUL" or "SHC_ROW_DIV".  The coefficients beyond "op1->nmax" and
+ * "op2->nmax" are treated as zeros.  With "SHC_ROW_DIV", the "s"
+ * coefficients of order "0" within the maximum degrees of "op1" and "op2"
+ * are not touched.
+ *
+ * The degrees are split into three intervals: the degrees available in both
+ * operands, the degrees available in only one of them and the degrees
+ * available in none of them.  Each interval is a contiguous part of the order
+ * in "charm_shc", so it is processed by "shc_arithmetics_row". */
+void CHARM(shc_arithmetics_order)(int op,
+                                  const CHARM(shc) *op1,
+                                  const CHARM(shc) *op2,
+                                  unsigned long m,
+                                  unsigned long nmin,
+                                  unsigned long nmax,
+                                  CHARM(shc) *rop)
+{
+    const unsigned long n0 = CHARM_MAX(nmin, m);
+    if (n0 > nmax)
+        return;
+
+
+    /* The last degree available in both operands and in at least one of
+     * them */
+    const unsigned long nb = CHARM_MIN(nmax, CHARM_MIN(op1->nmax,
+                                                       op2->nmax));
+    const unsigned long n1 = CHARM_MIN(nmax, CHARM_MAX(op1->nmax,
+                                                       op2->nmax));
+    unsigned long nstart = n0;
+
+
+    /* Degrees available in both operands */
+    /* --------------------------------------------------------------------- */
+    if (n0 <= nb)
+    {
+        size_t len  = nb - n0 + 1;
+        size_t nmm0 = n0 - m;
+        CHARM(shc_arithmetics_row)(op, len, op1->c[m] + nmm0,
+                                   op2->c[m] + nmm0, PREC(0.0),
+                                   rop->c[m] + nmm0);
+        if ((op != SHC_ROW_DIV) || (m > 0))
+            CHARM(shc_arithmetics_row)(op, len, op1->s[m] + nmm0,
+                                       op2->s[m] + nmm0, PREC(0.0),
+                                       rop->s[m] + nmm0);
+        nstart = nb + 1;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* Degrees available in one of the operands only.  With "SHC_ROW_ADD" and
+     * "SHC_ROW_SUB", the missing operand is zero, so the available one is
+     * copied (negated if it is "op2" in "SHC_ROW_SUB").  With "SHC_ROW_MUL"
+     * and "SHC_ROW_DIV", the result is zero as in the last interval. */
+    /* --------------------------------------------------------------------- */
+    if ((nstart <= n1) && ((op == SHC_ROW_ADD) || (op == SHC_ROW_SUB)))
+    {
+        size_t len  = n1 - nstart + 1;
+        size_t nmm0 = nstart - m;
+        _Bool is_op1 = op1->nmax > op2->nmax;
+        const CHARM(shc) *x = is_op1 ? op1 : op2;
+        int op_one = (!is_op1 && (op == SHC_ROW_SUB)) ? SHC_ROW_MULS :
+                                                        SHC_ROW_COPY;
+        CHARM(shc_arithmetics_row)(op_one, len, x->c[m] + nmm0, NULL,
+                                   PREC(-1.0), rop->c[m] + nmm0);
+        CHARM(shc_arithmetics_row)(op_one, len, x->s[m] + nmm0, NULL,
+                                   PREC(-1.0), rop->s[m] + nmm0);
+        nstart = n1 + 1;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* Degrees available in none of the operands */
+    /* --------------------------------------------------------------------- */
+    if (nstart <= nmax)
+    {
+        size_t len  = nmax - nstart + 1;
+        size_t nmm0 = nstart - m;
+        CHARM(shc_arithmetics_row)(SHC_ROW_ZERO, len, NULL, NULL, PREC(0.0),
+                                   rop->c[m] + nmm0);
+        CHARM(shc_arithmetics_row)(SHC_ROW_ZERO, len, NULL, NULL, PREC(0.0),
+                                   rop->s[m] + nmm0);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    return;
+}
@@ -0,0 +1,32 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_ARITHMETICS_ORDER_H__
+#define __SHC_ARITHMETICS_ORDER_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_arithmetics_order)(int,
+                                         const CHARM(shc) *,
+                                         const CHARM(shc) *,
+                                         unsigned long,
+                                         unsigned long,
+                                         unsigned long,
+                                         CHARM(shc) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
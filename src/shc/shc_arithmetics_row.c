@@ -0,0 +1,86 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "shc_arithmetics_row.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Loop over "n" elements of a row of coefficients.  The first loop processes
+ * "SIMD_SIZE" elements at once, the second one the remaining elements.
+ * Unaligned loads and stores are used, because orders of "charm_shc" do not
+ * start at aligned addresses. */
+#undef ROW_LOOP
+#define ROW_LOOP(OP_SIMD, OP)                                                 \
+        for (; i + SIMD_SIZE <= n; i += SIMD_SIZE)                            \
+            STOREU_R(&z[i], OP_SIMD);                                         \
+        for (; i < n; i++)                                                    \
+            z[i] = OP;
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Performs "op" (one of "SHC_ROW_*") on "n" elements of "x" and "y" (or "x"
+ * and "a") and stores the result to "z".  "z" may be the same array as "x"
+ * or "y" but must not overlap with them otherwise.  "y" is not accessed
+ * unless "op" is "SHC_ROW_ADD", "SHC_ROW_SUB", "SHC_ROW_MUL" or
+ * "SHC_ROW_DIV", "x" is not accessed if "op" is "SHC_ROW_ZERO".
+ *
+ * The operations are performed element-wise in the same way with and without
+ * the SIMD support, so the results do not depend on it. */
+void CHARM(shc_arithmetics_row)(int op,
+                                size_t n,
+                                const REAL *x,
+                                const REAL *y,
+                                REAL a,
+                                REAL *z)
+{
+    size_t i = 0;
+    REAL_SIMD as = SET1_R(a);
+
+
+    switch (op)
+    {
+    case SHC_ROW_ADD:
+        ROW_LOOP(ADD_R(LOADU_R(&x[i]), LOADU_R(&y[i])), x[i] + y[i]);
+        break;
+    case SHC_ROW_SUB:
+        ROW_LOOP(SUB_R(LOADU_R(&x[i]), LOADU_R(&y[i])), x[i] - y[i]);
+        break;
+    case SHC_ROW_MUL:
+        ROW_LOOP(MUL_R(LOADU_R(&x[i]), LOADU_R(&y[i])), x[i] * y[i]);
+        break;
+    case SHC_ROW_DIV:
+        ROW_LOOP(DIV_R(LOADU_R(&x[i]), LOADU_R(&y[i])), x[i] / y[i]);
+        break;
+    case SHC_ROW_MULS:
+        ROW_LOOP(MUL_R(LOADU_R(&x[i]), as), x[i] * a);
+        break;
+    case SHC_ROW_DIVS:
+        ROW_LOOP(DIV_R(LOADU_R(&x[i]), as), x[i] / a);
+        break;
+    case SHC_ROW_COPY:
+        if (z != x)
+            memcpy(z, x, n * sizeof(REAL));
+        break;
+    case SHC_ROW_ZERO:
+        for (; i < n; i++)
+            z[i] = PREC(0.0);
+        break;
+    default:
+        break;
+    }
+
+
+    return;
+}
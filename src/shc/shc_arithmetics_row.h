@@ -0,0 +1,50 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_ARITHMETICS_ROW_H__
+#define __SHC_ARITHMETICS_ROW_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+/* Operations of "shc_arithmetics_row" */
+#undef SHC_ROW_ADD
+#undef SHC_ROW_SUB
+#undef SHC_ROW_MUL
+#undef SHC_ROW_DIV
+#undef SHC_ROW_MULS
+#undef SHC_ROW_DIVS
+#undef SHC_ROW_COPY
+#undef SHC_ROW_ZERO
+#define SHC_ROW_ADD  (0)  /* z = x + y */
+#define SHC_ROW_SUB  (1)  /* z = x - y */
+#define SHC_ROW_MUL  (2)  /* z = x * y */
+#define SHC_ROW_DIV  (3)  /* z = x / y */
+#define SHC_ROW_MULS (4)  /* z = x * a */
+#define SHC_ROW_DIVS (5)  /* z = x / a */
+#define SHC_ROW_COPY (6)  /* z = x */
+#define SHC_ROW_ZERO (7)  /* z = 0 */
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_arithmetics_row)(int,
+                                       size_t,
+                                       const REAL *,
+                                       const REAL *,
+                                       REAL,
+                                       REAL *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
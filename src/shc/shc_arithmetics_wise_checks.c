@@ -8,6 +8,7 @@
 #include "../err/err_propagate.h"
 #include "../err/err_check_distribution.h"
 #include "shc_check_distribution.h"
+#include "shc_check_map.h"
 #include "shc_arithmetics_wise_checks.h"
 /* ------------------------------------------------------------------------- */
 
@@ -37,6 +38,14 @@ void CHARM(shc_arithmetics_wise_checks)(CHARM(shc) *shcs,
     }
 
 
+    CHARM(shc_check_map)(shcs, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
     if (nmin > nmax)
     {
         CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
@@ -0,0 +1,138 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BIN_H__
+#define __SHC_BIN_H__
+
+
+#include <config.h>
+#include <stdint.h>
+#include "../prec.h"
+
+
+/* Symbolic constants of the versioned binary format of spherical harmonic
+ * coefficients written by "shc_write_bin".  The file starts with a header of
+ * "SHC_BIN_HEADER" bytes:
+ *
+ *      offset  size  content
+ *           0     8  "SHC_BIN_MAGIC"
+ *           8     4  version of the format ("uint32_t")
+ *          12     4  "SHC_BIN_ENDIAN" to detect the byte order ("uint32_t")
+ *          16     4  precision of the coefficients, "SHC_BIN_PREC_*"
+ *                    ("uint32_t")
+ *          20     4  size of the floating point data type in bytes
+ *                    ("uint32_t")
+ *          24     4  alignment of the blocks of coefficients in bytes
+ *                    ("uint32_t")
+ *          28     4  flags, "SHC_BIN_FLAG_*" ("uint32_t", version 2)
+ *          32     8  maximum harmonic degree ("uint64_t")
+ *          40     8  offset of the "C" coefficients in bytes ("uint64_t")
+ *          48     8  offset of the "S" coefficients in bytes ("uint64_t")
+ *          56     8  offset of the index in bytes ("uint64_t", version 2)
+ *          64    16  scaling parameter "mu" (floating point, zero-padded)
+ *          80    16  radius "r" (floating point, zero-padded)
+ *          96    32  reserved (zero)
+ *
+ * All values are stored in the byte order of the machine that wrote the file.
+ * The "C" and "S" coefficients are stored in the same order as in the
+ * "charm_shc" structure (order-wise, starting with "C_{0,0}") and both blocks
+ * are aligned to "SHC_BIN_ALIGN" bytes from the beginning of the file, so
+ * that they can be memory-mapped.
+ *
+ * Since version 2, the file ends with an index aligned to "SHC_BIN_ALIGN"
+ * bytes.  For each order "m = 0, 1, ..., nmax", the index stores an entry of
+ * "SHC_BIN_INDEX_ENTRY" bytes:
+ *
+ *      offset  size  content
+ *           0     8  offset of "C_{m,m}" in bytes ("uint64_t")
+ *           8     8  offset of "S_{m,m}" in bytes ("uint64_t")
+ *          16     4  CRC-32 of "C_{m,m}, ..., C_{nmax,m}" ("uint32_t")
+ *          20     4  CRC-32 of "S_{m,m}, ..., S_{nmax,m}" ("uint32_t")
+ *
+ * The checksums are computed from the bytes as they are stored in the file
+ * and are valid only if the "SHC_BIN_FLAG_CRC" flag is set.  With the index,
+ * the coefficients of any order can be read without reading the rest of the
+ * file.  In version 1, the offsets are computed from "nmax" and there are no
+ * checksums. */
+#undef SHC_BIN_MAGIC
+#define SHC_BIN_MAGIC "CHARMSHC"
+
+
+#undef SHC_BIN_NMAGIC
+#define SHC_BIN_NMAGIC (8)
+
+
+#undef SHC_BIN_VERSION
+#define SHC_BIN_VERSION (2)
+
+
+#undef SHC_BIN_ENDIAN
+#define SHC_BIN_ENDIAN (UINT32_C(0x01020304))
+
+
+#undef SHC_BIN_HEADER
+#define SHC_BIN_HEADER (128)
+
+
+#undef SHC_BIN_ALIGN
+#define SHC_BIN_ALIGN (64)
+
+
+#undef SHC_BIN_INDEX_ENTRY
+#define SHC_BIN_INDEX_ENTRY (24)
+
+
+/* The index stores the CRC-32 checksums of the orders */
+#undef SHC_BIN_FLAG_CRC
+#define SHC_BIN_FLAG_CRC (UINT32_C(1))
+
+
+#undef SHC_BIN_PREC_FLOAT
+#undef SHC_BIN_PREC_DOUBLE
+#undef SHC_BIN_PREC_QUAD
+#define SHC_BIN_PREC_FLOAT (1)
+#define SHC_BIN_PREC_DOUBLE (2)
+#define SHC_BIN_PREC_QUAD (3)
+
+
+/* Precision, in which CHarm is compiled */
+#undef SHC_BIN_PREC
+#if CHARM_FLOAT
+#   define SHC_BIN_PREC SHC_BIN_PREC_FLOAT
+#elif CHARM_QUAD
+#   define SHC_BIN_PREC SHC_BIN_PREC_QUAD
+#else
+#   define SHC_BIN_PREC SHC_BIN_PREC_DOUBLE
+#endif
+
+
+/* Decoded header of the versioned binary file */
+typedef struct
+{
+    uint32_t version;
+
+
+    /* "1" if the byte order of the file differs from that of the machine */
+    _Bool swap;
+
+
+    uint32_t prec;
+    uint32_t real_size;
+    uint32_t align;
+    uint64_t nmax;
+    uint64_t offset_c;
+    uint64_t offset_s;
+
+
+    /* "0" with version 1 */
+    uint32_t flags;
+    uint64_t offset_idx;
+
+
+    /* Valid only if "prec" is "SHC_BIN_PREC" */
+    REAL mu;
+    REAL r;
+} CHARM(shc_bin_header);
+
+
+#endif
@@ -0,0 +1,148 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../misc/misc_swap_bytes.h"
+#include "shc_bin.h"
+#include "shc_bin_header_decode.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Decodes the header of the versioned binary file with spherical harmonic
+ * coefficients from "buf" of "SHC_BIN_HEADER" bytes (see "shc_bin.h") to
+ * "hdr".  Files written in a different byte order are accepted ("hdr->swap"
+ * is then "1"), but files written in a different precision are not rejected
+ * here, so that callers can at least get the maximum harmonic degree.  The
+ * "hdr->mu" and "hdr->r" values are valid only if "hdr->prec" is
+ * "SHC_BIN_PREC". */
+void CHARM(shc_bin_header_decode)(const unsigned char *buf,
+                                  CHARM(shc_bin_header) *hdr,
+                                  CHARM(err) *err)
+{
+    if (memcmp(buf, SHC_BIN_MAGIC, SHC_BIN_NMAGIC) != 0)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Not a versioned binary file with spherical harmonic "
+                       "coefficients.");
+        return;
+    }
+
+
+    uint32_t endian;
+    memcpy(&endian, buf + 12, sizeof(uint32_t));
+    if (endian == SHC_BIN_ENDIAN)
+        hdr->swap = 0;
+    else
+    {
+        CHARM(misc_swap_bytes)(&endian, sizeof(uint32_t), 1);
+        if (endian != SHC_BIN_ENDIAN)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Unknown byte order of the binary file.");
+            return;
+        }
+        hdr->swap = 1;
+    }
+
+
+    memcpy(&hdr->version,    buf + 8,  sizeof(uint32_t));
+    memcpy(&hdr->prec,       buf + 16, sizeof(uint32_t));
+    memcpy(&hdr->real_size,  buf + 20, sizeof(uint32_t));
+    memcpy(&hdr->align,      buf + 24, sizeof(uint32_t));
+    memcpy(&hdr->flags,      buf + 28, sizeof(uint32_t));
+    memcpy(&hdr->nmax,       buf + 32, sizeof(uint64_t));
+    memcpy(&hdr->offset_c,   buf + 40, sizeof(uint64_t));
+    memcpy(&hdr->offset_s,   buf + 48, sizeof(uint64_t));
+    memcpy(&hdr->offset_idx, buf + 56, sizeof(uint64_t));
+    if (hdr->swap)
+    {
+        CHARM(misc_swap_bytes)(&hdr->version,    sizeof(uint32_t), 1);
+        CHARM(misc_swap_bytes)(&hdr->prec,       sizeof(uint32_t), 1);
+        CHARM(misc_swap_bytes)(&hdr->real_size,  sizeof(uint32_t), 1);
+        CHARM(misc_swap_bytes)(&hdr->align,      sizeof(uint32_t), 1);
+        CHARM(misc_swap_bytes)(&hdr->flags,      sizeof(uint32_t), 1);
+        CHARM(misc_swap_bytes)(&hdr->nmax,       sizeof(uint64_t), 1);
+        CHARM(misc_swap_bytes)(&hdr->offset_c,   sizeof(uint64_t), 1);
+        CHARM(misc_swap_bytes)(&hdr->offset_s,   sizeof(uint64_t), 1);
+        CHARM(misc_swap_bytes)(&hdr->offset_idx, sizeof(uint64_t), 1);
+    }
+
+
+    char err_msg[CHARM_ERR_MAX_MSG];
+    if ((hdr->version < 1) || (hdr->version > SHC_BIN_VERSION))
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                 "Unsupported version \"%lu\" of the binary file.  This "
+                 "version of CHarm supports versions up to \"%d\".",
+                 (unsigned long)hdr->version, SHC_BIN_VERSION);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       err_msg);
+        return;
+    }
+
+
+    if (!((hdr->prec == SHC_BIN_PREC_FLOAT  && hdr->real_size == 4) ||
+          (hdr->prec == SHC_BIN_PREC_DOUBLE && hdr->real_size == 8) ||
+          (hdr->prec == SHC_BIN_PREC_QUAD   && hdr->real_size == 16)))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Unknown precision of the binary file.");
+        return;
+    }
+
+
+    /* Check the maximum harmonic degree (which must fit into "unsigned long"
+     * on all platforms) and the offsets of the blocks of coefficients, so
+     * that they do not overlap */
+    uint64_t ncs = ((hdr->nmax + 2) * (hdr->nmax + 1)) / 2;
+    if ((hdr->nmax >= UINT32_MAX) || (hdr->offset_c < SHC_BIN_HEADER) ||
+        (ncs > (UINT64_MAX - hdr->offset_c) / hdr->real_size) ||
+        (hdr->offset_s < hdr->offset_c + ncs * hdr->real_size) ||
+        (ncs > (UINT64_MAX - hdr->offset_s) / hdr->real_size))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Invalid maximum harmonic degree or offsets of the "
+                       "coefficients in the binary file.");
+        return;
+    }
+
+
+    /* Version 1 has no index, so the reserved fields are ignored */
+    if (hdr->version < 2)
+    {
+        hdr->flags      = 0;
+        hdr->offset_idx = 0;
+    }
+    else if ((hdr->offset_idx < hdr->offset_s + ncs * hdr->real_size) ||
+             (hdr->nmax + 1 > (UINT64_MAX - hdr->offset_idx) /
+                              SHC_BIN_INDEX_ENTRY))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Invalid offset of the index in the binary file.");
+        return;
+    }
+
+
+    hdr->mu = hdr->r = PREC(0.0);
+    if (hdr->prec == SHC_BIN_PREC)
+    {
+        memcpy(&hdr->mu, buf + 64, sizeof(REAL));
+        memcpy(&hdr->r,  buf + 80, sizeof(REAL));
+        if (hdr->swap)
+        {
+            CHARM(misc_swap_bytes)(&hdr->mu, sizeof(REAL), 1);
+            CHARM(misc_swap_bytes)(&hdr->r,  sizeof(REAL), 1);
+        }
+    }
+
+
+    return;
+}
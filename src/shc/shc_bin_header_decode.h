@@ -0,0 +1,29 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BIN_HEADER_DECODE_H__
+#define __SHC_BIN_HEADER_DECODE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shc_bin.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_bin_header_decode)(const unsigned char *,
+                                         CHARM(shc_bin_header) *,
+                                         CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,69 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "../prec.h"
+#include "shc_bin.h"
+#include "shc_bin_header_encode.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Writes the header of the versioned binary file with spherical harmonic
+ * coefficients up to degree "nmax" with the scaling parameter "mu" and the
+ * radius "r" to "buf" of "SHC_BIN_HEADER" bytes (see "shc_bin.h").  The
+ * decoded header, including the offsets of the blocks of coefficients and of
+ * the index, is returned in "hdr".  The index is announced to store the
+ * checksums, so the caller must write them. */
+void CHARM(shc_bin_header_encode)(unsigned long nmax,
+                                  REAL mu,
+                                  REAL r,
+                                  unsigned char *buf,
+                                  CHARM(shc_bin_header) *hdr)
+{
+    /* Number of "C" (or "S") coefficients */
+    uint64_t ncs = (((uint64_t)nmax + 2) * ((uint64_t)nmax + 1)) / 2;
+
+
+    hdr->version    = SHC_BIN_VERSION;
+    hdr->swap       = 0;
+    hdr->prec       = SHC_BIN_PREC;
+    hdr->real_size  = (uint32_t)sizeof(REAL);
+    hdr->align      = SHC_BIN_ALIGN;
+    hdr->nmax       = (uint64_t)nmax;
+    hdr->offset_c   = SHC_BIN_HEADER;
+    hdr->offset_s   = hdr->offset_c + ncs * sizeof(REAL);
+    hdr->offset_s   = ((hdr->offset_s + SHC_BIN_ALIGN - 1) / SHC_BIN_ALIGN) *
+                      SHC_BIN_ALIGN;
+    hdr->flags      = SHC_BIN_FLAG_CRC;
+    hdr->offset_idx = hdr->offset_s + ncs * sizeof(REAL);
+    hdr->offset_idx = ((hdr->offset_idx + SHC_BIN_ALIGN - 1) /
+                       SHC_BIN_ALIGN) * SHC_BIN_ALIGN;
+    hdr->mu         = mu;
+    hdr->r          = r;
+
+
+    uint32_t endian = SHC_BIN_ENDIAN;
+    memset(buf, 0, SHC_BIN_HEADER);
+    memcpy(buf,      SHC_BIN_MAGIC,    SHC_BIN_NMAGIC);
+    memcpy(buf + 8,  &hdr->version,    sizeof(uint32_t));
+    memcpy(buf + 12, &endian,          sizeof(uint32_t));
+    memcpy(buf + 16, &hdr->prec,       sizeof(uint32_t));
+    memcpy(buf + 20, &hdr->real_size,  sizeof(uint32_t));
+    memcpy(buf + 24, &hdr->align,      sizeof(uint32_t));
+    memcpy(buf + 28, &hdr->flags,      sizeof(uint32_t));
+    memcpy(buf + 32, &hdr->nmax,       sizeof(uint64_t));
+    memcpy(buf + 40, &hdr->offset_c,   sizeof(uint64_t));
+    memcpy(buf + 48, &hdr->offset_s,   sizeof(uint64_t));
+    memcpy(buf + 56, &hdr->offset_idx, sizeof(uint64_t));
+    memcpy(buf + 64, &mu,              sizeof(REAL));
+    memcpy(buf + 80, &r,               sizeof(REAL));
+
+
+    return;
+}
@@ -0,0 +1,31 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BIN_HEADER_ENCODE_H__
+#define __SHC_BIN_HEADER_ENCODE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shc_bin.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_bin_header_encode)(unsigned long,
+                                         REAL,
+                                         REAL,
+                                         unsigned char *,
+                                         CHARM(shc_bin_header) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
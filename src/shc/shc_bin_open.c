@@ -0,0 +1,131 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "shc_bin.h"
+#include "shc_bin_header_decode.h"
+#include "shc_bin_open.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Opens the binary file "pathname" with spherical harmonic coefficients and
+ * decodes its header to "hdr".
+ *
+ * Versioned files are decoded by "shc_bin_header_decode".  Unversioned files
+ * written by CHarm 0.4.8 or older start with "nmax", "mu" and "r"
+ * immediately followed by the coefficients.  For these files, "hdr->version"
+ * is "0" and the other members of "hdr" are set as if the file was a version
+ * 1 file written on this machine.
+ *
+ * Returned is the stream of the opened file, which must be closed by the
+ * caller.  On error, "NULL" is returned and "err" is set. */
+FILE *CHARM(shc_bin_open)(const char *pathname,
+                          CHARM(shc_bin_header) *hdr,
+                          CHARM(err) *err)
+{
+    FILE *fptr = fopen(pathname, "rb");
+    if (fptr == NULL)
+    {
+        char msg[CHARM_ERR_MAX_MSG];
+        snprintf(msg, CHARM_ERR_MAX_MSG, "Couldn't open \"%s\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFILEIO, msg);
+        return NULL;
+    }
+
+
+    unsigned char header[SHC_BIN_HEADER];
+    size_t nheader = fread(header, sizeof(unsigned char), SHC_BIN_HEADER,
+                           fptr);
+    if ((nheader >= SHC_BIN_NMAGIC) &&
+        (memcmp(header, SHC_BIN_MAGIC, SHC_BIN_NMAGIC) == 0))
+    {
+        /* Versioned binary file (see "shc_bin.h") */
+        /* ----------------------------------------------------------------- */
+        if (nheader != SHC_BIN_HEADER)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Failed to read the header.");
+            goto FAILURE;
+        }
+
+
+        CHARM(shc_bin_header_decode)(header, hdr, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto FAILURE;
+        }
+
+
+        return fptr;
+        /* ----------------------------------------------------------------- */
+    }
+
+
+    /* Unversioned binary file */
+    /* --------------------------------------------------------------------- */
+    unsigned long nmax;
+    if (fseek(fptr, 0, SEEK_SET))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to seek the beginning of the file.");
+        goto FAILURE;
+    }
+
+
+    if (fread(&nmax, sizeof(unsigned long), 1, fptr) != 1)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to read the maximum harmonic degree.");
+        goto FAILURE;
+    }
+
+
+    if (fread(&hdr->mu, sizeof(REAL), 1, fptr) != 1)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to read the scaling parameter.");
+        goto FAILURE;
+    }
+
+
+    if (fread(&hdr->r, sizeof(REAL), 1, fptr) != 1)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to read the radius of the reference sphere.");
+        goto FAILURE;
+    }
+
+
+    uint64_t ncs = (((uint64_t)nmax + 2) * ((uint64_t)nmax + 1)) / 2;
+    hdr->version    = 0;
+    hdr->swap       = 0;
+    hdr->prec       = SHC_BIN_PREC;
+    hdr->real_size  = (uint32_t)sizeof(REAL);
+    hdr->align      = 1;
+    hdr->nmax       = (uint64_t)nmax;
+    hdr->offset_c   = sizeof(unsigned long) + 2 * sizeof(REAL);
+    hdr->offset_s   = hdr->offset_c + ncs * sizeof(REAL);
+    hdr->flags      = 0;
+    hdr->offset_idx = 0;
+
+
+    return fptr;
+    /* --------------------------------------------------------------------- */
+
+
+FAILURE:
+    fclose(fptr);
+    return NULL;
+}
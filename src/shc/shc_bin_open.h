@@ -0,0 +1,30 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BIN_OPEN_H__
+#define __SHC_BIN_OPEN_H__
+
+
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "shc_bin.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern FILE *CHARM(shc_bin_open)(const char *,
+                                 CHARM(shc_bin_header) *,
+                                 CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
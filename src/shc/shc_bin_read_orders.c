@@ -0,0 +1,217 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../misc/misc_crc32.h"
+#include "../misc/misc_swap_bytes.h"
+#include "../misc/misc_fseek.h"
+#include "shc_bin.h"
+#include "shc_bin_read_orders.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Function prototypes */
+/* ------------------------------------------------------------------------- */
+static int read_row(FILE *,
+                    uint64_t,
+                    size_t,
+                    REAL *);
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Reads the coefficients of degrees "m, m + 1, ..., nmax" for all orders "m"
+ * of the "nchunk" chunks given by "order" (see "charm_shc_read_bin_chunk")
+ * from the binary file "fptr" described by "hdr" (see "shc_bin_open") to
+ * "shcs->c[m]" and "shcs->s[m]".  The coefficients of these orders beyond
+ * degree "nmax" are set to zero.  Other coefficients of "shcs" are not
+ * touched.
+ *
+ * The caller is responsible for checking that the precision of the file is
+ * the same as that of the library, that "nmax <= hdr->nmax",
+ * "nmax <= shcs->nmax" and that "order" is valid up to degree "nmax".
+ *
+ * Each order is read by one "misc_fseek" and one "fread" call per "C" and
+ * "S", the offsets being taken from the index of the file (version 2) or
+ * computed (older files).  If the index stores the checksums, the checksums of the
+ * orders are verified when the orders are read completely, that is, if
+ * "nmax == hdr->nmax". */
+void CHARM(shc_bin_read_orders)(FILE *fptr,
+                                const CHARM(shc_bin_header) *hdr,
+                                unsigned long nmax,
+                                size_t nchunk,
+                                const unsigned long *order,
+                                CHARM(shc) *shcs,
+                                CHARM(err) *err)
+{
+    _Bool index = hdr->version >= 2;
+    _Bool crc   = index && (hdr->flags & SHC_BIN_FLAG_CRC) &&
+                  ((uint64_t)nmax == hdr->nmax);
+    unsigned char *entries = NULL;
+
+
+    for (size_t j = 0; j < nchunk; j++)
+    {
+        unsigned long mmin = order[2 * j];
+        unsigned long mmax = order[2 * j + 1];
+
+
+        /* Read the entries of the index of this chunk at once */
+        /* ----------------------------------------------------------------- */
+        if (index)
+        {
+            size_t nentries = (size_t)(mmax - mmin + 1) * SHC_BIN_INDEX_ENTRY;
+            unsigned char *tmp = (unsigned char *)realloc(entries, nentries);
+            if (tmp == NULL)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                               CHARM_ERR_MALLOC_FAILURE);
+                goto EXIT;
+            }
+            entries = tmp;
+
+
+            uint64_t offset = hdr->offset_idx +
+                              (uint64_t)mmin * SHC_BIN_INDEX_ENTRY;
+            if (CHARM(misc_fseek)(fptr, offset) ||
+                (fread(entries, sizeof(unsigned char), nentries, fptr) !=
+                 nentries))
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO,
+                               "Failed to read the index of the binary "
+                               "file.");
+                goto EXIT;
+            }
+        }
+        /* ----------------------------------------------------------------- */
+
+
+        for (unsigned long m = mmin; m <= mmax; m++)
+        {
+            /* Offsets and checksums of the "C" and "S" coefficients of
+             * order "m" */
+            /* ------------------------------------------------------------- */
+            uint64_t offset_c, offset_s;
+            uint32_t crc_c = 0, crc_s = 0;
+            if (index)
+            {
+                const unsigned char *e = entries + (size_t)(m - mmin) *
+                                                   SHC_BIN_INDEX_ENTRY;
+                memcpy(&offset_c, e,      sizeof(uint64_t));
+                memcpy(&offset_s, e + 8,  sizeof(uint64_t));
+                memcpy(&crc_c,    e + 16, sizeof(uint32_t));
+                memcpy(&crc_s,    e + 20, sizeof(uint32_t));
+                if (hdr->swap)
+                {
+                    CHARM(misc_swap_bytes)(&offset_c, sizeof(uint64_t), 1);
+                    CHARM(misc_swap_bytes)(&offset_s, sizeof(uint64_t), 1);
+                    CHARM(misc_swap_bytes)(&crc_c,    sizeof(uint32_t), 1);
+                    CHARM(misc_swap_bytes)(&crc_s,    sizeof(uint32_t), 1);
+                }
+            }
+            else
+            {
+                /* Number of coefficients of orders "0, 1, ..., m - 1" */
+                uint64_t nprev = (uint64_t)m * (hdr->nmax + 1) -
+                                 ((uint64_t)m * (m - 1)) / 2;
+                offset_c = hdr->offset_c + nprev * hdr->real_size;
+                offset_s = hdr->offset_s + nprev * hdr->real_size;
+            }
+            /* ------------------------------------------------------------- */
+
+
+            /* Read the coefficients */
+            /* ------------------------------------------------------------- */
+            size_t nread = (size_t)(nmax + 1 - m);
+            if (read_row(fptr, offset_c, nread, shcs->c[m]))
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO,
+                               "Failed to read the \"C\" coefficients.");
+                goto EXIT;
+            }
+
+
+            if (read_row(fptr, offset_s, nread, shcs->s[m]))
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO,
+                               "Failed to read the \"S\" coefficients.");
+                goto EXIT;
+            }
+            /* ------------------------------------------------------------- */
+
+
+            /* Verify the checksums before the byte order is changed */
+            /* ------------------------------------------------------------- */
+            if (crc &&
+                ((CHARM(misc_crc32)(0, shcs->c[m], nread * sizeof(REAL)) !=
+                  crc_c) ||
+                 (CHARM(misc_crc32)(0, shcs->s[m], nread * sizeof(REAL)) !=
+                  crc_s)))
+            {
+                char msg[CHARM_ERR_MAX_MSG];
+                snprintf(msg, CHARM_ERR_MAX_MSG,
+                         "Checksum mismatch of the coefficients of order "
+                         "\"%lu\".  The binary file is corrupted.", m);
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO, msg);
+                goto EXIT;
+            }
+
+
+            if (hdr->swap)
+            {
+                CHARM(misc_swap_bytes)(shcs->c[m], sizeof(REAL), nread);
+                CHARM(misc_swap_bytes)(shcs->s[m], sizeof(REAL), nread);
+            }
+
+
+            /* Coefficients beyond degree "nmax" */
+            for (unsigned long n = nmax + 1; n <= shcs->nmax; n++)
+                shcs->c[m][n - m] = shcs->s[m][n - m] = PREC(0.0);
+            /* ------------------------------------------------------------- */
+        }
+    }
+
+
+EXIT:
+    free(entries);
+    return;
+}
+
+
+
+
+
+
+/* Reads "n" coefficients starting at "offset" bytes from the beginning of
+ * "fptr" to "x" */
+static int read_row(FILE *fptr,
+                    uint64_t offset,
+                    size_t n,
+                    REAL *x)
+{
+    if (CHARM(misc_fseek)(fptr, offset))
+        return 1;
+
+
+    if (fread(x, sizeof(REAL), n, fptr) != n)
+        return 2;
+
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BIN_READ_ORDERS_H__
+#define __SHC_BIN_READ_ORDERS_H__
+
+
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "shc_bin.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_bin_read_orders)(FILE *,
+                                       const CHARM(shc_bin_header) *,
+                                       unsigned long,
+                                       size_t,
+                                       const unsigned long *,
+                                       CHARM(shc) *,
+                                       CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
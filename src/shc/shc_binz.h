@@ -0,0 +1,122 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BINZ_H__
+#define __SHC_BINZ_H__
+
+
+#include <config.h>
+#include <stdint.h>
+#include "../prec.h"
+#include "shc_bin.h"
+
+
+/* Symbolic constants of the compressed binary format of spherical harmonic
+ * coefficients written by "shc_write_binz".  The file starts with a header of
+ * "SHC_BINZ_HEADER" bytes:
+ *
+ *      offset  size  content
+ *           0     8  "SHC_BINZ_MAGIC"
+ *           8     4  version of the format ("uint32_t")
+ *          12     4  "SHC_BIN_ENDIAN" to detect the byte order ("uint32_t")
+ *          16     4  precision of the coefficients, "SHC_BIN_PREC_*"
+ *                    ("uint32_t")
+ *          20     4  size of the floating point data type in bytes
+ *                    ("uint32_t")
+ *          24     4  codec of the orders, "SHC_BINZ_CODEC_*" ("uint32_t")
+ *          28     4  reserved (zero)
+ *          32     8  maximum harmonic degree ("uint64_t")
+ *          40     8  offset of the index in bytes ("uint64_t")
+ *          48    16  reserved (zero)
+ *          64    16  scaling parameter "mu" (floating point, zero-padded)
+ *          80    16  radius "r" (floating point, zero-padded)
+ *          96    32  reserved (zero)
+ *
+ * The header is followed by the compressed orders "m = 0, 1, ..., nmax".
+ * Each order is stored as the compressed row "C_{m,m}, ..., C_{nmax,m}"
+ * immediately followed by the compressed row "S_{m,m}, ..., S_{nmax,m}".
+ * The orders are followed by the index, which stores for each order an entry
+ * of "SHC_BINZ_INDEX_ENTRY" bytes:
+ *
+ *      offset  size  content
+ *           0     8  offset of the compressed "C" row in bytes ("uint64_t")
+ *           8     8  size of the compressed "C" row in bytes ("uint64_t")
+ *          16     8  size of the compressed "S" row in bytes ("uint64_t")
+ *          24     4  CRC-32 of both compressed rows ("uint32_t")
+ *          28     4  reserved (zero)
+ *
+ * The header and the index are stored in the byte order of the machine that
+ * wrote the file.  The compressed rows do not depend on the byte order (see
+ * "shc_binz_encode_row"). */
+#undef SHC_BINZ_MAGIC
+#define SHC_BINZ_MAGIC "CHARMSHZ"
+
+
+#undef SHC_BINZ_VERSION
+#define SHC_BINZ_VERSION (1)
+
+
+#undef SHC_BINZ_HEADER
+#define SHC_BINZ_HEADER (128)
+
+
+#undef SHC_BINZ_INDEX_ENTRY
+#define SHC_BINZ_INDEX_ENTRY (32)
+
+
+/* Codec of the rows (see "shc_binz_encode_row") */
+#undef SHC_BINZ_CODEC_DELTA
+#define SHC_BINZ_CODEC_DELTA (1)
+
+
+/* The first byte of each compressed row */
+#undef SHC_BINZ_ROW_ZERO
+#undef SHC_BINZ_ROW_DELTA
+#define SHC_BINZ_ROW_ZERO (0)
+#define SHC_BINZ_ROW_DELTA (1)
+
+
+/* The maximum number of bytes of a compressed row of "n" coefficients */
+#undef SHC_BINZ_ROW_MAX
+#define SHC_BINZ_ROW_MAX(n) (1 + (n) * (sizeof(REAL) + 1))
+
+
+/* Decoded header and index of the compressed binary file */
+struct CHARM(shc_binz)
+{
+    /* Path to the file, so that it can be opened again when reading the
+     * orders */
+    char *pathname;
+
+
+    /* "1" if the byte order of the file differs from that of the machine */
+    _Bool swap;
+
+
+    uint32_t version;
+    uint32_t prec;
+    uint32_t real_size;
+    uint32_t codec;
+    uint64_t nmax;
+    uint64_t offset_idx;
+
+
+    /* Valid only if "prec" is "SHC_BIN_PREC" */
+    REAL mu;
+    REAL r;
+
+
+    /* The index.  Each array has "nmax + 1" elements.  The index is checked
+     * by "shc_binz_open", so the compressed orders are stored contiguously,
+     * that is, "offset[m + 1] == offset[m] + nbytes_c[m] + nbytes_s[m]". */
+    uint64_t *offset;
+    uint64_t *nbytes_c;
+    uint64_t *nbytes_s;
+    uint32_t *crc;
+};
+
+
+typedef struct CHARM(shc_binz) CHARM(shc_binz);
+
+
+#endif
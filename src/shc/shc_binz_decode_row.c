@@ -0,0 +1,112 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../misc/misc_swap_bytes.h"
+#include "shc_bin.h"
+#include "shc_binz.h"
+#include "shc_binz_decode_row.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Decompresses the row of "n" coefficients from "buf" of "nbytes" bytes
+ * written by "shc_binz_encode_row" to "x".  If "buf" is not a valid row of
+ * "n" coefficients, "err" is set. */
+void CHARM(shc_binz_decode_row)(const unsigned char *buf,
+                                size_t nbytes,
+                                size_t n,
+                                REAL *x,
+                                CHARM(err) *err)
+{
+    if ((nbytes == 1) && (buf[0] == SHC_BINZ_ROW_ZERO))
+    {
+        for (size_t i = 0; i < n; i++)
+            x[i] = PREC(0.0);
+
+
+        return;
+    }
+
+
+    if ((nbytes == 0) || (buf[0] != SHC_BINZ_ROW_DELTA))
+        goto CORRUPTED;
+
+
+    /* The byte order of the machine */
+    const uint32_t endian = SHC_BIN_ENDIAN;
+    unsigned char b0;
+    memcpy(&b0, &endian, 1);
+    _Bool swap = (b0 != 0x04);
+
+
+    size_t k = 1;
+    const size_t nlow = sizeof(REAL) - 2;
+    unsigned char b[sizeof(REAL)];
+    uint32_t hprev = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t z = 0;
+        unsigned shift = 0;
+        unsigned char byte;
+        do
+        {
+            if ((k >= nbytes) || (shift > 14))
+                goto CORRUPTED;
+
+
+            byte   = buf[k++];
+            z     |= (uint32_t)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+
+        uint32_t h;
+        if (z & 1)
+        {
+            if (((z + 1) >> 1) > hprev)
+                goto CORRUPTED;
+            h = hprev - ((z + 1) >> 1);
+        }
+        else
+            h = hprev + (z >> 1);
+        if (h > UINT32_C(0xffff))
+            goto CORRUPTED;
+        hprev = h;
+
+
+        if (nbytes - k < nlow)
+            goto CORRUPTED;
+        uint32_t hi = (h >> 1) | ((h & 1) << 15);
+        memcpy(b, buf + k, nlow);
+        k += nlow;
+        b[nlow]     = (unsigned char)(hi & 0xff);
+        b[nlow + 1] = (unsigned char)(hi >> 8);
+
+
+        if (swap)
+            CHARM(misc_swap_bytes)(b, sizeof(REAL), 1);
+        memcpy(x + i, b, sizeof(REAL));
+    }
+
+
+    if (k != nbytes)
+        goto CORRUPTED;
+
+
+    return;
+
+
+CORRUPTED:
+    CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                   "Failed to decompress the coefficients.  The compressed "
+                   "binary file is corrupted.");
+    return;
+}
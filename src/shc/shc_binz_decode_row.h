@@ -0,0 +1,31 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BINZ_DECODE_ROW_H__
+#define __SHC_BINZ_DECODE_ROW_H__
+
+
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_binz_decode_row)(const unsigned char *,
+                                       size_t,
+                                       size_t,
+                                       REAL *,
+                                       CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
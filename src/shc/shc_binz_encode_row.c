@@ -0,0 +1,99 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "../prec.h"
+#include "../misc/misc_swap_bytes.h"
+#include "shc_bin.h"
+#include "shc_binz.h"
+#include "shc_binz_encode_row.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Compresses the row of "n" coefficients "x" to "buf" of at least
+ * "SHC_BINZ_ROW_MAX(n)" bytes and returns the number of bytes written.
+ *
+ * If all bytes of "x" are zero, the row is written as a single
+ * "SHC_BINZ_ROW_ZERO" byte.  Otherwise, "SHC_BINZ_ROW_DELTA" is followed by
+ * the coefficients one after another.  The two most significant bytes of
+ * a coefficient (the sign, the exponent and, except for quadruple precision,
+ * the leading bits of the mantissa) change only slowly along the row of
+ * a typical model, so they are stored as the difference from the previous
+ * coefficient.  To keep the differences small for coefficients of both
+ * signs, the sign bit is moved to the least significant position first.  The
+ * difference is then written as a zigzag-encoded variable length integer of
+ * 7 bits per byte, usually a single byte.  The remaining "sizeof(REAL) - 2"
+ * bytes of the mantissa, which are nearly random, are copied from the least
+ * significant byte onwards, so the compressed row does not depend on the byte
+ * order of the machine. */
+size_t CHARM(shc_binz_encode_row)(const REAL *x,
+                                  size_t n,
+                                  unsigned char *buf)
+{
+    const unsigned char *xb = (const unsigned char *)x;
+    size_t i;
+    for (i = 0; i < n * sizeof(REAL); i++)
+        if (xb[i] != 0)
+            break;
+
+
+    if (i == n * sizeof(REAL))
+    {
+        buf[0] = SHC_BINZ_ROW_ZERO;
+        return 1;
+    }
+
+
+    /* The byte order of the machine */
+    const uint32_t endian = SHC_BIN_ENDIAN;
+    unsigned char b0;
+    memcpy(&b0, &endian, 1);
+    _Bool swap = (b0 != 0x04);
+
+
+    buf[0] = SHC_BINZ_ROW_DELTA;
+    size_t k = 1;
+    const size_t nlow = sizeof(REAL) - 2;
+    unsigned char b[sizeof(REAL)];
+    uint32_t hprev = 0;
+    for (i = 0; i < n; i++)
+    {
+        /* Bytes of "x[i]" from the least significant one */
+        memcpy(b, x + i, sizeof(REAL));
+        if (swap)
+            CHARM(misc_swap_bytes)(b, sizeof(REAL), 1);
+
+
+        uint32_t hi = ((uint32_t)b[nlow + 1] << 8) | (uint32_t)b[nlow];
+        uint32_t h  = ((hi & UINT32_C(0x7fff)) << 1) | (hi >> 15);
+
+
+        /* Zigzag encoding of the difference */
+        uint32_t z = (h >= hprev) ? (h - hprev) << 1 :
+                                    ((hprev - h) << 1) - 1;
+        hprev = h;
+
+
+        do
+        {
+            unsigned char byte = (unsigned char)(z & 0x7f);
+            z >>= 7;
+            if (z)
+                byte |= 0x80;
+            buf[k++] = byte;
+        } while (z);
+
+
+        memcpy(buf + k, b, nlow);
+        k += nlow;
+    }
+
+
+    return k;
+}
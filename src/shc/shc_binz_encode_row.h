@@ -0,0 +1,29 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BINZ_ENCODE_ROW_H__
+#define __SHC_BINZ_ENCODE_ROW_H__
+
+
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern size_t CHARM(shc_binz_encode_row)(const REAL *,
+                                         size_t,
+                                         unsigned char *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,31 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "shc_binz.h"
+#include "shc_binz_free.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(shc_binz_free)(CHARM(shc_binz) *binz)
+{
+    if (binz == NULL)
+        return;
+
+
+    free(binz->pathname);
+    free(binz->offset);
+    free(binz->nbytes_c);
+    free(binz->nbytes_s);
+    free(binz->crc);
+    free(binz);
+
+
+    return;
+}
@@ -0,0 +1,27 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BINZ_FREE_H__
+#define __SHC_BINZ_FREE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shc_binz.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_binz_free)(CHARM(shc_binz) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,245 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../misc/misc_swap_bytes.h"
+#include "../misc/misc_fseek.h"
+#include "shc_bin.h"
+#include "shc_binz.h"
+#include "shc_binz_free.h"
+#include "shc_binz_open.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Reads the header and the index of the compressed binary file "pathname"
+ * written by "shc_write_binz" (see "shc_binz.h").  Files written in
+ * a different byte order are accepted.  Files written in a different
+ * precision are not rejected here, so that callers can at least get the
+ * maximum harmonic degree; "binz->mu" and "binz->r" are then zero.
+ *
+ * The index is checked, so that the compressed orders are stored
+ * contiguously between the header and the index.  The file is closed before
+ * returning.  On error, "NULL" is returned and "err" is set. */
+CHARM(shc_binz) *CHARM(shc_binz_open)(const char *pathname,
+                                      CHARM(err) *err)
+{
+    char msg[CHARM_ERR_MAX_MSG];
+    unsigned char *entries = NULL;
+    CHARM(shc_binz) *binz  = NULL;
+
+
+    FILE *fptr = fopen(pathname, "rb");
+    if (fptr == NULL)
+    {
+        snprintf(msg, CHARM_ERR_MAX_MSG, "Couldn't open \"%s\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFILEIO, msg);
+        return NULL;
+    }
+
+
+    /* The header */
+    /* --------------------------------------------------------------------- */
+    unsigned char header[SHC_BINZ_HEADER];
+    if ((fread(header, sizeof(unsigned char), SHC_BINZ_HEADER, fptr) !=
+         SHC_BINZ_HEADER) ||
+        (memcmp(header, SHC_BINZ_MAGIC, SHC_BIN_NMAGIC) != 0))
+    {
+        snprintf(msg, CHARM_ERR_MAX_MSG,
+                 "\"%s\" is not a compressed binary file with spherical "
+                 "harmonic coefficients.", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO, msg);
+        goto FAILURE;
+    }
+
+
+    binz = (CHARM(shc_binz) *)calloc(1, sizeof(CHARM(shc_binz)));
+    if (binz == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE;
+    }
+
+
+    uint32_t endian;
+    memcpy(&endian, header + 12, sizeof(uint32_t));
+    if (endian != SHC_BIN_ENDIAN)
+    {
+        CHARM(misc_swap_bytes)(&endian, sizeof(uint32_t), 1);
+        if (endian != SHC_BIN_ENDIAN)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Unknown byte order of the compressed binary "
+                           "file.");
+            goto FAILURE;
+        }
+        binz->swap = 1;
+    }
+
+
+    memcpy(&binz->version,    header + 8,  sizeof(uint32_t));
+    memcpy(&binz->prec,       header + 16, sizeof(uint32_t));
+    memcpy(&binz->real_size,  header + 20, sizeof(uint32_t));
+    memcpy(&binz->codec,      header + 24, sizeof(uint32_t));
+    memcpy(&binz->nmax,       header + 32, sizeof(uint64_t));
+    memcpy(&binz->offset_idx, header + 40, sizeof(uint64_t));
+    if (binz->swap)
+    {
+        CHARM(misc_swap_bytes)(&binz->version,    sizeof(uint32_t), 1);
+        CHARM(misc_swap_bytes)(&binz->prec,       sizeof(uint32_t), 1);
+        CHARM(misc_swap_bytes)(&binz->real_size,  sizeof(uint32_t), 1);
+        CHARM(misc_swap_bytes)(&binz->codec,      sizeof(uint32_t), 1);
+        CHARM(misc_swap_bytes)(&binz->nmax,       sizeof(uint64_t), 1);
+        CHARM(misc_swap_bytes)(&binz->offset_idx, sizeof(uint64_t), 1);
+    }
+
+
+    if ((binz->version < 1) || (binz->version > SHC_BINZ_VERSION))
+    {
+        snprintf(msg, CHARM_ERR_MAX_MSG,
+                 "Unsupported version \"%lu\" of the compressed binary file.  "
+                 "This version of CHarm supports versions up to \"%d\".",
+                 (unsigned long)binz->version, SHC_BINZ_VERSION);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO, msg);
+        goto FAILURE;
+    }
+
+
+    if (!((binz->prec == SHC_BIN_PREC_FLOAT  && binz->real_size == 4) ||
+          (binz->prec == SHC_BIN_PREC_DOUBLE && binz->real_size == 8) ||
+          (binz->prec == SHC_BIN_PREC_QUAD   && binz->real_size == 16)))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Unknown precision of the compressed binary file.");
+        goto FAILURE;
+    }
+
+
+    if (binz->codec != SHC_BINZ_CODEC_DELTA)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Unknown codec of the compressed binary file.");
+        goto FAILURE;
+    }
+
+
+    if ((binz->nmax >= UINT32_MAX) || (binz->offset_idx < SHC_BINZ_HEADER) ||
+        (binz->nmax + 1 > SIZE_MAX / SHC_BINZ_INDEX_ENTRY))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Invalid maximum harmonic degree or offset of the "
+                       "index in the compressed binary file.");
+        goto FAILURE;
+    }
+
+
+    if (binz->prec == SHC_BIN_PREC)
+    {
+        memcpy(&binz->mu, header + 64, sizeof(REAL));
+        memcpy(&binz->r,  header + 80, sizeof(REAL));
+        if (binz->swap)
+        {
+            CHARM(misc_swap_bytes)(&binz->mu, sizeof(REAL), 1);
+            CHARM(misc_swap_bytes)(&binz->r,  sizeof(REAL), 1);
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* The index */
+    /* --------------------------------------------------------------------- */
+    size_t nmax1 = (size_t)binz->nmax + 1;
+    binz->offset   = (uint64_t *)malloc(nmax1 * sizeof(uint64_t));
+    binz->nbytes_c = (uint64_t *)malloc(nmax1 * sizeof(uint64_t));
+    binz->nbytes_s = (uint64_t *)malloc(nmax1 * sizeof(uint64_t));
+    binz->crc      = (uint32_t *)malloc(nmax1 * sizeof(uint32_t));
+    entries = (unsigned char *)malloc(nmax1 * SHC_BINZ_INDEX_ENTRY);
+    size_t len = strlen(pathname) + 1;
+    binz->pathname = (char *)malloc(len * sizeof(char));
+    if ((binz->offset == NULL) || (binz->nbytes_c == NULL) ||
+        (binz->nbytes_s == NULL) || (binz->crc == NULL) ||
+        (entries == NULL) || (binz->pathname == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE;
+    }
+    memcpy(binz->pathname, pathname, len);
+
+
+    if (CHARM(misc_fseek)(fptr, binz->offset_idx) ||
+        (fread(entries, SHC_BINZ_INDEX_ENTRY, nmax1, fptr) != nmax1))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to read the index of the compressed binary "
+                       "file.");
+        goto FAILURE;
+    }
+
+
+    uint64_t offset = SHC_BINZ_HEADER;
+    for (size_t m = 0; m < nmax1; m++)
+    {
+        const unsigned char *e = entries + m * SHC_BINZ_INDEX_ENTRY;
+        memcpy(binz->offset + m,   e,      sizeof(uint64_t));
+        memcpy(binz->nbytes_c + m, e + 8,  sizeof(uint64_t));
+        memcpy(binz->nbytes_s + m, e + 16, sizeof(uint64_t));
+        memcpy(binz->crc + m,      e + 24, sizeof(uint32_t));
+        if (binz->swap)
+        {
+            CHARM(misc_swap_bytes)(binz->offset + m,   sizeof(uint64_t), 1);
+            CHARM(misc_swap_bytes)(binz->nbytes_c + m, sizeof(uint64_t), 1);
+            CHARM(misc_swap_bytes)(binz->nbytes_s + m, sizeof(uint64_t), 1);
+            CHARM(misc_swap_bytes)(binz->crc + m,      sizeof(uint32_t), 1);
+        }
+
+
+        /* The maximum size of a compressed row of this order (see
+         * "SHC_BINZ_ROW_MAX") */
+        uint64_t nrow_max = 1 + (nmax1 - m) * ((uint64_t)binz->real_size + 1);
+        if ((binz->offset[m] != offset) ||
+            (binz->nbytes_c[m] > nrow_max) ||
+            (binz->nbytes_s[m] > nrow_max))
+        {
+            snprintf(msg, CHARM_ERR_MAX_MSG,
+                     "Invalid entry of order \"%lu\" in the index of the "
+                     "compressed binary file.", (unsigned long)m);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           msg);
+            goto FAILURE;
+        }
+        offset += binz->nbytes_c[m] + binz->nbytes_s[m];
+    }
+
+
+    if (offset > binz->offset_idx)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "The compressed orders overlap with the index of the "
+                       "compressed binary file.");
+        goto FAILURE;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+EXIT:
+    free(entries);
+    fclose(fptr);
+    return binz;
+
+
+FAILURE:
+    CHARM(shc_binz_free)(binz);
+    binz = NULL;
+    goto EXIT;
+}
@@ -0,0 +1,28 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BINZ_OPEN_H__
+#define __SHC_BINZ_OPEN_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shc_binz.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern CHARM(shc_binz) *CHARM(shc_binz_open)(const char *,
+                                             CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,110 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../misc/misc_crc32.h"
+#include "../misc/misc_fseek.h"
+#include "shc_binz.h"
+#include "shc_binz_decode_row.h"
+#include "shc_binz_read_orders.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Reads and decompresses the coefficients of orders "mfirst, mfirst + 1, ...,
+ * mlast" from the compressed binary file "fptr" described by "binz" (see
+ * "shc_binz_open").  The coefficients are stored in "c" and "s" in the same
+ * order as in the "charm_shc" structure, that is, "C_{mfirst,mfirst}, ...,
+ * C_{nmax,mfirst}, C_{mfirst + 1,mfirst + 1}, ..., C_{nmax,mlast}", where
+ * "nmax" is the maximum harmonic degree of the file.
+ *
+ * The caller is responsible for checking that the precision of the file is
+ * the same as that of the library and that "mfirst <= mlast <= binz->nmax".
+ *
+ * The orders are stored contiguously, so they are read by a single
+ * "misc_fseek" and "fread" call.  The checksum of each order is verified before it is
+ * decompressed. */
+void CHARM(shc_binz_read_orders)(FILE *fptr,
+                                 const CHARM(shc_binz) *binz,
+                                 unsigned long mfirst,
+                                 unsigned long mlast,
+                                 REAL *c,
+                                 REAL *s,
+                                 CHARM(err) *err)
+{
+    uint64_t offset = binz->offset[mfirst];
+    size_t nbytes   = (size_t)(binz->offset[mlast] + binz->nbytes_c[mlast] +
+                               binz->nbytes_s[mlast] - offset);
+
+
+    unsigned char *buf = (unsigned char *)malloc(nbytes);
+    if (buf == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        return;
+    }
+
+
+    if (CHARM(misc_fseek)(fptr, offset) ||
+        (fread(buf, sizeof(unsigned char), nbytes, fptr) != nbytes))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to read the compressed coefficients.");
+        goto EXIT;
+    }
+
+
+    size_t idx = 0;
+    for (unsigned long m = mfirst; m <= mlast; m++)
+    {
+        const unsigned char *row = buf + (size_t)(binz->offset[m] - offset);
+        size_t nbytes_c = (size_t)binz->nbytes_c[m];
+        size_t nbytes_s = (size_t)binz->nbytes_s[m];
+
+
+        if (CHARM(misc_crc32)(0, row, nbytes_c + nbytes_s) != binz->crc[m])
+        {
+            char msg[CHARM_ERR_MAX_MSG];
+            snprintf(msg, CHARM_ERR_MAX_MSG,
+                     "Checksum mismatch of the coefficients of order "
+                     "\"%lu\".  The compressed binary file is corrupted.", m);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           msg);
+            goto EXIT;
+        }
+
+
+        size_t n = (size_t)(binz->nmax + 1 - m);
+        CHARM(shc_binz_decode_row)(row, nbytes_c, n, c + idx, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT;
+        }
+
+
+        CHARM(shc_binz_decode_row)(row + nbytes_c, nbytes_s, n, s + idx, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT;
+        }
+
+
+        idx += n;
+    }
+
+
+EXIT:
+    free(buf);
+    return;
+}
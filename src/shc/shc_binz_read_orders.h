@@ -0,0 +1,34 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BINZ_READ_ORDERS_H__
+#define __SHC_BINZ_READ_ORDERS_H__
+
+
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "shc_binz.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_binz_read_orders)(FILE *,
+                                        const CHARM(shc_binz) *,
+                                        unsigned long,
+                                        unsigned long,
+                                        REAL *,
+                                        REAL *,
+                                        CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "../prec.h"
+#include "../simd/free_aligned.h"
 #include "shc_block_struct.h"
 #include "shc_block_free.h"
 /* ------------------------------------------------------------------------- */
@@ -19,11 +20,21 @@ void CHARM(shc_block_free)(CHARM(shc_block) *shcs_block)
         return;
 
 
-    if (shcs_block->owner)
+    if (shcs_block->cs != NULL)
+    {
+        /* "c" and "s" point to "cs" */
+        CHARM(free_aligned)(shcs_block->cs);
+        free(shcs_block->order_idx);
+    }
+    else if (shcs_block->owner)
     {
         free(shcs_block->c);
         free(shcs_block->s);
     }
+
+
+    if (shcs_block->fptr != NULL)
+        fclose(shcs_block->fptr);
 #if HAVE_MPI
     free(shcs_block->have_m_all);  /* Always freed, regardless of
                                     * "shcs_block->owner" */
@@ -10,10 +10,15 @@
 #   include "../mpi/mpi_count_aint.h"
 #   include "../mpi/mpi_ibcast.h"
 #endif
+#include "../err/err_set.h"
 #include "../err/err_propagate.h"
 #include "../err/err_isempty_all_mpi_processes.h"
+#include "shc_binz.h"
+#include "shc_binz_read_orders.h"
 #include "shc_block_struct.h"
 #include "shc_block_set_mfirst.h"
+#include "shc_view_get_range.h"
+#include "shc_view_is_sliced.h"
 #include "shc_block_get_coeffs.h"
 /* ------------------------------------------------------------------------- */
 
@@ -25,19 +30,133 @@
 /* Copies a block of coefficients of orders "mfirst", "mfirst + 1", ... from
  * the process, which stores these coefficients in "shcs", to "shcs_block" on
  * all processes.  The total number of orders that are gathered depends mostly
- * on the maximum order of the chunk, where "mfirst" is found. */
-void CHARM(shc_block_get_coeffs)(const CHARM(shc) *shcs
-#if HAVE_MPI
-                                 , CHARM(shc_block) *shcs_block,
+ * on the maximum order of the chunk, where "mfirst" is found.
+ *
+ * If "shcs" was returned by "shc_open_binz", the block of orders starting at
+ * "mfirst" is decompressed from the file to "shcs_block" instead.  If "shcs"
+ * is a sliced view returned by "shc_view", the block is copied from the
+ * structure that stores the coefficients. */
+void CHARM(shc_block_get_coeffs)(const CHARM(shc) *shcs,
+                                 CHARM(shc_block) *shcs_block,
                                  unsigned long mfirst,
-                                 CHARM(err) *err
-#endif
-                                )
+                                 CHARM(err) *err)
 {
-    /* There is nothing we can do for non-distributed "shcs" */
+    /* Non-distributed "shcs" are stored in "shcs_block" as a whole.  The same
+     * holds for blocks returned by "shc_block_init_interleaved". */
+    /* --------------------------------------------------------------------- */
+    _Bool sliced = CHARM(shc_view_is_sliced)(shcs);
+    if ((!shcs->distributed && (shcs->lazy == NULL) && !sliced) ||
+        (shcs_block->cs != NULL))
+        return;
+    /* --------------------------------------------------------------------- */
+
+
+    /* Sliced views returned by "shc_view".  The orders are copied from the
+     * structure that stores the coefficients and the coefficients outside
+     * the slice are set to zero. */
+    /* --------------------------------------------------------------------- */
+    if (sliced)
+    {
+#if HAVE_OPENMP
+#pragma omp master
+#endif
+        {
+        CHARM(shc_block_set_mfirst)(shcs_block, shcs, mfirst, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT_VIEW;
+        }
+
+
+        unsigned long nmin, mmin, mmax;
+        CHARM(shc_view_get_range)(shcs, &nmin, &mmin, &mmax);
+
+
+        REAL *c = shcs_block->c;
+        REAL *s = shcs_block->s;
+        for (unsigned long m = shcs_block->mfirst; m <= shcs_block->mlast;
+             m++)
+        {
+            size_t nm = shcs->nmax + 1 - m;
+            size_t nz = nm;
+            if ((m >= mmin) && (m <= mmax))
+                nz = (nmin > m) ? CHARM_MIN(nmin - m, nm) : 0;
+
+
+            memset(c, 0, nz * sizeof(REAL));
+            memset(s, 0, nz * sizeof(REAL));
+            memcpy(c + nz, shcs->c[m] + nz, (nm - nz) * sizeof(REAL));
+            memcpy(s + nz, shcs->s[m] + nz, (nm - nz) * sizeof(REAL));
+            c += nm;
+            s += nm;
+        }
+
+
+EXIT_VIEW:
+        ;
+        }
+#if HAVE_OPENMP
+#pragma omp barrier
+#endif
+
+
+        return;
+    }
     /* --------------------------------------------------------------------- */
-    if (!shcs->distributed)
+
+
+    /* "shcs" returned by "shc_open_binz" */
+    /* --------------------------------------------------------------------- */
+    if (shcs->lazy != NULL)
+    {
+#if HAVE_OPENMP
+#pragma omp master
+#endif
+        {
+        const CHARM(shc_binz) *binz = (const CHARM(shc_binz) *)shcs->lazy;
+
+
+        CHARM(shc_block_set_mfirst)(shcs_block, shcs, mfirst, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT_LAZY;
+        }
+
+
+        if (shcs_block->fptr == NULL)
+        {
+            shcs_block->fptr = fopen(binz->pathname, "rb");
+            if (shcs_block->fptr == NULL)
+            {
+                char msg[CHARM_ERR_MAX_MSG];
+                snprintf(msg, CHARM_ERR_MAX_MSG, "Couldn't open \"%s\".",
+                         binz->pathname);
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO, msg);
+                goto EXIT_LAZY;
+            }
+        }
+
+
+        CHARM(shc_binz_read_orders)(shcs_block->fptr, binz,
+                                    shcs_block->mfirst, shcs_block->mlast,
+                                    shcs_block->c, shcs_block->s, err);
+        if (!CHARM(err_isempty)(err))
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+EXIT_LAZY:
+        ;
+        }
+#if HAVE_OPENMP
+#pragma omp barrier
+#endif
+
+
         return;
+    }
     /* --------------------------------------------------------------------- */
 
 
@@ -16,13 +16,10 @@ extern "C"
 #endif
 
 
-extern void CHARM(shc_block_get_coeffs)(const CHARM(shc) *
-#if HAVE_MPI
-                                        , CHARM(shc_block) *,
+extern void CHARM(shc_block_get_coeffs)(const CHARM(shc) *,
+                                        CHARM(shc_block) *,
                                         unsigned long,
-                                        CHARM(err) *
-#endif
-                                       );
+                                        CHARM(err) *);
 
 
 #ifdef __cplusplus
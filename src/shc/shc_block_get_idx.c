@@ -14,10 +14,17 @@
 
 /* Returns an index of "C_{mcurr, mcurr}" and "S_{mcurr, mcurr}" in
  * "shcs_block->c" and "shcs_block->c" with respect to the chunk starting with
- * order "shcs_block_mfirst" with "mcurr >= shcs_block_mfirst". */
+ * order "shcs_block_mfirst" with "mcurr >= shcs_block_mfirst".  If the block
+ * was returned by "shc_block_init_interleaved", the index refers to
+ * "shcs_block->cs". */
 unsigned long CHARM(shc_block_get_idx)(const CHARM(shc_block) *shcs_block,
                                        unsigned long mcurr)
 {
+    if (shcs_block->order_idx != NULL)
+        return (unsigned long)shcs_block->order_idx[mcurr -
+                                                    shcs_block->mfirst];
+
+
     unsigned long nmaxp2 = shcs_block->nmax + 2;
     unsigned long idx = 0;
     for (unsigned long m = shcs_block->mfirst + 1; m <= mcurr; m++)
@@ -17,6 +17,7 @@
 #include "../err/err_isempty_all_mpi_processes.h"
 #include "shc_block_struct.h"
 #include "shc_block_nan.h"
+#include "shc_view_is_sliced.h"
 #include "shc_block_get_mlast_ncs_root.h"
 /* ------------------------------------------------------------------------- */
 
@@ -185,7 +186,31 @@ void CHARM(shc_block_get_mlast_ncs_root)(const CHARM(shc) *shcs,
 #endif
 
 
-    if (!shcs->distributed)
+    if (!shcs->distributed &&
+        ((shcs->lazy != NULL) || CHARM(shc_view_is_sliced)(shcs)))
+    {
+        /* Structure returned by "shc_open_binz" or a sliced view returned by
+         * "shc_view".  The block is filled by as many orders starting at
+         * "m_get" as "shcs_block->ncs_max" allows.
+         * Since "shcs_block->ncs_max >= shcs->nmax + 1", it is at least one
+         * order. */
+        unsigned long m;
+        size_t ncoeffs     = 0;
+        size_t ncoeffs_tmp = 0;
+        for (m = m_get; m <= shcs->nmax; m++)
+        {
+            ncoeffs_tmp = ncoeffs + (shcs->nmax - m) + 1;
+            if (ncoeffs_tmp > shcs_block->ncs_max)
+                break;
+            ncoeffs = ncoeffs_tmp;
+        }
+
+
+        *mlast = m - 1;
+        *ncs   = ncoeffs;
+        *root  = 0;
+    }
+    else if (!shcs->distributed)
     {
         *mlast = shcs->nmax;
         *ncs   = shcs->nc;  /* "shcs->nc == shcs->ns" */
@@ -12,6 +12,8 @@
 #include "../err/err_is_null_ptr.h"
 #include "../err/err_isempty_all_mpi_processes.h"
 #include "../glob/glob_get_shc_block_nmax_multiplier.h"
+#include "shc_view_info.h"
+#include "shc_view_is_sliced.h"
 #include "shc_block_free.h"
 #include "shc_block_get_mlast_ncs_root.h"
 #include "shc_block_init.h"
@@ -56,6 +58,10 @@ CHARM(shc_block) *CHARM(shc_block_init)(const CHARM(shc) *shcs)
 
     shcs_block->nmax = shcs->nmax;
     shcs_block->c = shcs_block->s = NULL;
+    shcs_block->fptr = NULL;
+    shcs_block->stride    = 1;
+    shcs_block->cs        = NULL;
+    shcs_block->order_idx = NULL;
     /* --------------------------------------------------------------------- */
 
 
@@ -117,13 +123,42 @@ BARRIER:
 #endif
 
 
+    /* "charm_shc" structure returned by "shc_open_binz" or a sliced view
+     * returned by "shc_view".  The coefficients are decompressed or copied to
+     * "shcs_block" by blocks of orders. */
+    if ((shcs->lazy != NULL) || CHARM(shc_view_is_sliced)(shcs))
+    {
+        size_t n = CHARM_MIN((size_t)SHC_BLOCK_PARTIAL * (shcs->nmax + 1),
+                             shcs->nc);
+        shcs_block->owner = 1;
+        shcs_block->c = (REAL *)calloc(n, sizeof(REAL));
+        shcs_block->s = (REAL *)calloc(n, sizeof(REAL));
+        if ((shcs_block->c == NULL) || (shcs_block->s == NULL))
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+        if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+            goto FAILURE;
+        shcs_block->ncs_max = n;
+    }
     /* Non-distributed "charm_shc" structure regardless of the MPI support. */
-    if (!shcs->distributed)
+    else if (!shcs->distributed)
     {
         shcs_block->c       = shcs->c[0];
         shcs_block->s       = shcs->s[0];
         shcs_block->ncs_max = shcs->nc;  /* "shcs->nc == shcs->ns" */
         shcs_block->owner   = 0;
+
+
+        /* Views that only truncate the coefficients to a lower degree use the
+         * coefficients of the structure that stores them directly, so the
+         * layout of "shcs_block" follows the maximum degree of the latter */
+        if (shcs->view != NULL)
+        {
+            const CHARM(shc_view_info) *view =
+                                  (const CHARM(shc_view_info) *)shcs->view;
+            shcs_block->nmax    = view->nmax_data;
+            shcs_block->ncs_max = view->nc_data;
+        }
     }
 
 
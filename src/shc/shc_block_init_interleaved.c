@@ -0,0 +1,116 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE_MPI
+#   include <mpi.h>
+#endif
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "../simd/calloc_aligned.h"
+#include "shc_view_get_range.h"
+#include "shc_block_free.h"
+#include "shc_block_init_interleaved.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns a block with all coefficients of "shcs" up to degree "nmax"
+ * multiplied by "scale".  Unlike "shc_block_init", the coefficients are
+ * stored as the pairs "C_{n, m}, S_{n, m}" in "shcs_block->cs" with each
+ * order starting at a boundary of "SHC_BLOCK_ALIGN" bytes (if compiled with
+ * the SIMD support), so that the synthesis kernels read a single contiguous
+ * stream per order (see "shc_block_struct.h").  Sliced views are handled by
+ * zeroing the coefficients outside the slice.
+ *
+ * "shcs" must be neither distributed nor returned by "shc_open_binz" and
+ * "nmax" must not be larger than "shcs->nmax".  On error, "NULL" is
+ * returned.  The call is local to the calling process. */
+CHARM(shc_block) *CHARM(shc_block_init_interleaved)(const CHARM(shc) *shcs,
+                                                    unsigned long nmax,
+                                                    REAL scale)
+{
+    CHARM(shc_block) *shcs_block = NULL;
+    if (shcs->distributed || (shcs->lazy != NULL) || (nmax > shcs->nmax))
+        return NULL;
+
+
+    shcs_block = (CHARM(shc_block) *)malloc(sizeof(CHARM(shc_block)));
+    if (shcs_block == NULL)
+        return NULL;
+
+
+    shcs_block->c = shcs_block->s = NULL;
+    shcs_block->cs        = NULL;
+    shcs_block->fptr      = NULL;
+    shcs_block->root      = 0;
+    shcs_block->nmax      = nmax;
+    shcs_block->mfirst    = 0;
+    shcs_block->mlast     = nmax;
+    shcs_block->owner     = 1;
+    shcs_block->stride    = 2;
+#if HAVE_MPI
+    shcs_block->have_m_all  = NULL;
+    shcs_block->distributed = 0;
+    shcs_block->comm        = MPI_COMM_NULL;
+#endif
+
+
+    shcs_block->order_idx = (size_t *)malloc((nmax + 1) * sizeof(size_t));
+    if (shcs_block->order_idx == NULL)
+        goto FAILURE;
+
+
+    /* Number of "REAL"s that fit in "SHC_BLOCK_ALIGN" bytes.  The size of the
+     * allocated memory is rounded to the multiples of this value for each
+     * order. */
+    const size_t pad = (SHC_BLOCK_ALIGN >= sizeof(REAL)) ?
+                       SHC_BLOCK_ALIGN / sizeof(REAL) : 1;
+    size_t ncs = 0;
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        shcs_block->order_idx[m] = ncs;
+        ncs += ((2 * ((size_t)nmax + 1 - m) + pad - 1) / pad) * pad;
+    }
+
+
+    /* Without the SIMD support, "calloc_aligned" accepts only the zero
+     * alignment, that is, that of "calloc" */
+    shcs_block->cs = (REAL *)CHARM(calloc_aligned)((SIMD_MEMALIGN > 0) ?
+                                                   SHC_BLOCK_ALIGN : 0,
+                                                   ncs, sizeof(REAL));
+    if (shcs_block->cs == NULL)
+        goto FAILURE;
+    shcs_block->c       = shcs_block->cs;
+    shcs_block->s       = shcs_block->cs + 1;
+    shcs_block->ncs_max = ncs;
+    shcs_block->nc      = ncs;
+    shcs_block->ns      = ncs;
+
+
+    /* Copy the coefficients.  The padding and the coefficients outside the
+     * slice of sliced views remain zero. */
+    unsigned long nmin, mmin, mmax;
+    CHARM(shc_view_get_range)(shcs, &nmin, &mmin, &mmax);
+    for (unsigned long m = mmin; m <= CHARM_MIN(mmax, nmax); m++)
+    {
+        REAL *cs = shcs_block->cs + shcs_block->order_idx[m];
+        for (unsigned long n = CHARM_MAX(m, nmin); n <= nmax; n++)
+        {
+            cs[2 * (n - m)]     = scale * shcs->c[m][n - m];
+            cs[2 * (n - m) + 1] = scale * shcs->s[m][n - m];
+        }
+    }
+
+
+    return shcs_block;
+
+
+FAILURE:
+    CHARM(shc_block_free)(shcs_block);
+    return NULL;
+}
@@ -0,0 +1,28 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_BLOCK_INIT_INTERLEAVED_H__
+#define __SHC_BLOCK_INIT_INTERLEAVED_H__
+
+
+#include "../prec.h"
+#include "shc_block_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern CHARM(shc_block) *CHARM(shc_block_init_interleaved)(const CHARM(shc) *,
+                                                           unsigned long,
+                                                           REAL);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
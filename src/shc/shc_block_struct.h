@@ -6,12 +6,26 @@
 
 
 #include <config.h>
+#include <stdio.h>
 #if HAVE_MPI
 #   include <mpi.h>
 #endif
 #include "../prec.h"
 
 
+/* The coefficients of "charm_shc" structures returned by "shc_open_binz" and
+ * of sliced views returned by "shc_view" are copied to blocks of at most
+ * "SHC_BLOCK_PARTIAL * (nmax + 1)" coefficients (see "shc_block_init") */
+#undef SHC_BLOCK_PARTIAL
+#define SHC_BLOCK_PARTIAL (64)
+
+
+/* Alignment in bytes of each order of blocks returned by
+ * "shc_block_init_interleaved" */
+#undef SHC_BLOCK_ALIGN
+#define SHC_BLOCK_ALIGN (64)
+
+
 /* Structure to store a block of spherical harmonic coefficients */
 typedef struct
 {
@@ -61,6 +75,34 @@ typedef struct
     _Bool owner;
 
 
+    /* Stream of the compressed binary file, from which the coefficients are
+     * decompressed if "charm_shc" was returned by "shc_open_binz".  The file
+     * is opened by the first call of "shc_block_get_coeffs" and closed by
+     * "shc_block_free".  "NULL" otherwise. */
+    FILE *fptr;
+
+
+    /* Distance between "C_{n, m}" and "C_{n + 1, m}" in "c" (and similarly
+     * for "s").  "1" if "c" and "s" are separate arrays and "2" if the
+     * coefficients are interleaved in "cs" */
+    unsigned long stride;
+
+
+    /* "C_{m, m}, S_{m, m}, C_{m + 1, m}, S_{m + 1, m}, ..., C_{nmax, m},
+     * S_{nmax, m}" for "m = mfirst, ..., mlast", where each order starts at
+     * a boundary of "SHC_BLOCK_ALIGN" bytes (if compiled with the SIMD
+     * support).  If not "NULL", "c" points to "cs" and "s" to "cs + 1".
+     * Created by "shc_block_init_interleaved" and always owned by the
+     * block. */
+    REAL *cs;
+
+
+    /* Index of "C_{m, m}" in "c" for "m = mfirst, ..., mlast".  Used instead
+     * of the closed-form index if the orders are padded (see "cs").  "NULL"
+     * otherwise. */
+    size_t *order_idx;
+
+
 #if HAVE_MPI
     /* Temporary array used to identify the MPI process, which stores
      * coefficients of some particular order "m" */
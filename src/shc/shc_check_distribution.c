@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include "../prec.h"
 #include "../err/err_set.h"
+#include "shc_check_lazy.h"
+#include "shc_check_view.h"
 #include "shc_check_distribution.h"
 /* ------------------------------------------------------------------------- */
 
@@ -24,5 +26,14 @@ _Bool CHARM(shc_check_distribution)(const CHARM(shc) *shcs,
 #endif
 
 
+    /* The coefficients of structures returned by "shc_open_binz" are not
+     * stored in the memory either and views returned by "shc_view" are
+     * supported by few functions only, which do not call this function with
+     * views */
+    if (!shcs->distributed && (CHARM(shc_check_lazy)(shcs, err) ||
+                               CHARM(shc_check_view)(shcs, err)))
+        return 1;
+
+
     return shcs->distributed;
 }
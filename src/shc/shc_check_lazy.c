@@ -0,0 +1,33 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "shc_check_lazy.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns "1" and sets "err" if the coefficients of "shcs" are not stored in
+ * the memory, because "shcs" was returned by "charm_shc_open_binz".  Returns
+ * "0" otherwise. */
+_Bool CHARM(shc_check_lazy)(const CHARM(shc) *shcs,
+                            CHARM(err) *err)
+{
+    if (shcs->lazy == NULL)
+        return 0;
+
+
+    CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                   "This function does not support \"charm" CHARM_SUFFIX
+                   "_shc\" structures returned by \"charm" CHARM_SUFFIX
+                   "_shc_open_binz\".  Read the coefficients by \"charm"
+                   CHARM_SUFFIX "_shc_read_binz\" instead.");
+
+
+    return 1;
+}
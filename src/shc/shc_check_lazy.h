@@ -0,0 +1,27 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_CHECK_LAZY_H__
+#define __SHC_CHECK_LAZY_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern _Bool CHARM(shc_check_lazy)(const CHARM(shc) *,
+                                   CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,32 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "shc_check_map.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns "1" and sets "err" if "shcs" was returned by "charm_shc_map_bin", so
+ * its coefficients are read-only.  Returns "0" otherwise. */
+_Bool CHARM(shc_check_map)(const CHARM(shc) *shcs,
+                           CHARM(err) *err)
+{
+    if (shcs->map == NULL)
+        return 0;
+
+
+    CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                   "The coefficients of \"charm" CHARM_SUFFIX "_shc\" "
+                   "structures returned by \"charm" CHARM_SUFFIX
+                   "_shc_map_bin\" are read-only.  Create a copy of the "
+                   "structure by \"charm" CHARM_SUFFIX "_shc_copy\" first.");
+
+
+    return 1;
+}
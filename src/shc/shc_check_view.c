@@ -0,0 +1,32 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "shc_check_view.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns "1" and sets "err" if "shcs" was returned by "charm_shc_view".
+ * Returns "0" otherwise. */
+_Bool CHARM(shc_check_view)(const CHARM(shc) *shcs,
+                            CHARM(err) *err)
+{
+    if (shcs->view == NULL)
+        return 0;
+
+
+    CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                   "This function does not support \"charm" CHARM_SUFFIX
+                   "_shc\" structures returned by \"charm" CHARM_SUFFIX
+                   "_shc_view\".  Create a copy of the view by \"charm"
+                   CHARM_SUFFIX "_shc_copy\" instead.");
+
+
+    return 1;
+}
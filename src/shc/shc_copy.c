@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "../prec.h"
+#include "shc_view_get_range.h"
 /* ------------------------------------------------------------------------- */
 
 
@@ -32,7 +33,7 @@ CHARM(shc) *CHARM(shc_copy)(const CHARM(shc) *shcs,
         return NULL;
 
 
-    if (shcs->distributed)
+    if (shcs->distributed || (shcs->lazy != NULL))
         return NULL;
 
 
@@ -41,8 +42,14 @@ CHARM(shc) *CHARM(shc_copy)(const CHARM(shc) *shcs,
         return NULL;
 
 
+    /* If "shcs" is a view, the coefficients outside its slice are zeros */
+    unsigned long nmin_view, mmin, mmax;
+    CHARM(shc_view_get_range)(shcs, &nmin_view, &mmin, &mmax);
+    nmin = CHARM_MAX(nmin, nmin_view);
+
+
     unsigned long nmm;
-    for (unsigned long m = 0; m <= nmax; m++)
+    for (unsigned long m = mmin; m <= CHARM_MIN(nmax, mmax); m++)
     {
         for (unsigned long n = CHARM_MAX(m, nmin); n <= nmax; n++)
         {
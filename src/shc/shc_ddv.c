@@ -9,6 +9,7 @@
 #include "../err/err_check_distribution.h"
 #include "../misc/misc_is_nearly_equal.h"
 #include "shc_check_distribution.h"
+#include "shc_dv_core.h"
 /* ------------------------------------------------------------------------- */
 
 
@@ -32,16 +33,16 @@ void CHARM(shc_ddv)(const CHARM(shc) *shcs1,
     }
 
 
-    CHARM(shc_check_distribution)(shcs1, err);
-    if (!CHARM(err_isempty)(err))
+    /* Views returned by "shc_view" are supported (they are never
+     * distributed), other structures must be non-distributed */
+    if ((shcs1->view == NULL) && CHARM(shc_check_distribution)(shcs1, err))
     {
         CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
         return;
     }
 
 
-    CHARM(shc_check_distribution)(shcs2, err);
-    if (!CHARM(err_isempty)(err))
+    if ((shcs2->view == NULL) && CHARM(shc_check_distribution)(shcs2, err))
     {
         CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
         return;
@@ -88,20 +89,11 @@ void CHARM(shc_ddv)(const CHARM(shc) *shcs1,
 
 
     /* --------------------------------------------------------------------- */
-    REAL ddvn, tmp_cnm, tmp_snm;
-    for (unsigned long n = 0; n <= nmax; n++)
-    {
-        ddvn = PREC(0.0);
-        for (unsigned long m = 0; m <= n; m++)
-        {
-            tmp_cnm = shcs1->c[m][n - m] - shcs2->c[m][n - m];
-            tmp_snm = shcs1->s[m][n - m] - shcs2->s[m][n - m];
-            ddvn += (tmp_cnm * tmp_cnm) + (tmp_snm * tmp_snm);
-        }
-
-
-        ddv[n] = ddvn;
-    }
+    /* Parallel computation with the compensated summation.  The coefficients
+     * outside the slice of views are zeros. */
+    CHARM(shc_dv_core)(shcs1, shcs2, nmax, ddv, err);
+    if (!CHARM(err_isempty)(err))
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
     /* --------------------------------------------------------------------- */
 
 
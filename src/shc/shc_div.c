@@ -8,6 +8,8 @@
 #include "../err/err_propagate.h"
 #include "../misc/misc_is_nearly_equal.h"
 #include "shc_arithmetics_checks.h"
+#include "shc_arithmetics_row.h"
+#include "shc_arithmetics_order.h"
 /* ------------------------------------------------------------------------- */
 
 
@@ -46,55 +48,51 @@ void CHARM(shc_div)(CHARM(shc) *rop,
 
     /* Check that none of the coefficients in "op2" are zero within our degree
      * range from "nmin" to "nmax". */
-    unsigned long nmm;
-    _Bool czero, szero;
+    long int nzero = 0;
+    const REAL threshold = CHARM(glob_threshold);
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) shared(op2, nmin, nmax, threshold) \
+schedule(dynamic) reduction(+:nzero)
+#endif
     for (unsigned long m = 0; m <= nmax; m++)
     {
+        _Bool czero, szero;
         for (unsigned long n = CHARM_MAX(nmin, m); n <= nmax; n++)
         {
-            nmm = n - m;
-
-
-            czero = CHARM(misc_is_nearly_equal)(op2->c[m][nmm], PREC(0.0),
-                                                CHARM(glob_threshold));
-            szero = CHARM(misc_is_nearly_equal)(op2->s[m][nmm], PREC(0.0),
-                                                CHARM(glob_threshold));
+            czero = CHARM(misc_is_nearly_equal)(op2->c[m][n - m], PREC(0.0),
+                                                threshold);
+            szero = CHARM(misc_is_nearly_equal)(op2->s[m][n - m], PREC(0.0),
+                                                threshold);
             if (czero || (szero && (m > 0)))
-            {
-                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
-                               CHARM_EFUNCARG,
-                               "The coefficients of \"op2\" must not be zero "
-                               "in order to avoid division by zero.  The only "
-                               "exceptions are the non-existing \"s\" "
-                               "coefficients of order \"0\".");
-                return;
-            }
+                nzero++;
         }
     }
+
+
+    if (nzero > 0)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFUNCARG,
+                       "The coefficients of \"op2\" must not be zero "
+                       "in order to avoid division by zero.  The only "
+                       "exceptions are the non-existing \"s\" "
+                       "coefficients of order \"0\".");
+        return;
+    }
     /* --------------------------------------------------------------------- */
 
 
     /* --------------------------------------------------------------------- */
+    /* The orders are independent of each other, so they are distributed among
+     * the threads.  The lengths of the orders decrease with "m", hence the
+     * dynamic schedule. */
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) shared(rop, op1, op2, nmin, nmax) \
+schedule(dynamic)
+#endif
     for (unsigned long m = 0; m <= nmax; m++)
-    {
-        for (unsigned long n = CHARM_MAX(nmin, m); n <= nmax; n++)
-        {
-            nmm = n - m;
-
-
-            if ((n <= op1->nmax) && (n <= op2->nmax))
-            {
-                rop->c[m][nmm] = op1->c[m][nmm] / op2->c[m][nmm];
-                if (m > 0)
-                    rop->s[m][nmm] = op1->s[m][nmm] / op2->s[m][nmm];
-            }
-            else
-            {
-                rop->c[m][nmm] = PREC(0.0);
-                rop->s[m][nmm] = PREC(0.0);
-            }
-        }
-    }
+        CHARM(shc_arithmetics_order)(SHC_ROW_DIV, op1, op2, m, nmin, nmax,
+                                     rop);
     /* --------------------------------------------------------------------- */
 
 
@@ -8,6 +8,7 @@
 #include "../err/err_propagate.h"
 #include "../misc/misc_is_nearly_equal.h"
 #include "shc_arithmetics_wise_checks.h"
+#include "shc_arithmetics_row.h"
 /* ------------------------------------------------------------------------- */
 
 
@@ -47,17 +48,21 @@ void CHARM(shc_div_order_wise)(CHARM(shc) *shcs,
 
 
     /* --------------------------------------------------------------------- */
-    unsigned long nmm;
-    REAL am;
+    /* The orders are distributed among the threads, each order is processed
+     * as a contiguous row of degrees "max(nmin, m), ..., nmax" */
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) shared(shcs, a, nmin, nmax) \
+schedule(dynamic)
+#endif
     for (unsigned long m = 0; m <= nmax; m++)
     {
-        am = a[m];
-        for (unsigned long n = CHARM_MAX(nmin, m); n <= nmax; n++)
-        {
-            nmm = n - m;
-            shcs->c[m][nmm] /= am;
-            shcs->s[m][nmm] /= am;
-        }
+        unsigned long n0 = CHARM_MAX(nmin, m);
+        size_t nmm0      = n0 - m;
+        size_t len       = nmax - n0 + 1;
+        CHARM(shc_arithmetics_row)(SHC_ROW_DIVS, len, shcs->c[m] + nmm0,
+                                   NULL, a[m], shcs->c[m] + nmm0);
+        CHARM(shc_arithmetics_row)(SHC_ROW_DIVS, len, shcs->s[m] + nmm0,
+                                   NULL, a[m], shcs->s[m] + nmm0);
     }
     /* --------------------------------------------------------------------- */
 
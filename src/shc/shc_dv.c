@@ -8,6 +8,7 @@
 #include "../err/err_propagate.h"
 #include "../err/err_check_distribution.h"
 #include "shc_check_distribution.h"
+#include "shc_dv_core.h"
 /* ------------------------------------------------------------------------- */
 
 
@@ -29,8 +30,9 @@ void CHARM(shc_dv)(const CHARM(shc) *shcs,
     }
 
 
-    CHARM(shc_check_distribution)(shcs, err);
-    if (!CHARM(err_isempty)(err))
+    /* Views returned by "shc_view" are supported (they are never
+     * distributed), other structures must be non-distributed */
+    if ((shcs->view == NULL) && CHARM(shc_check_distribution)(shcs, err))
     {
         CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
         return;
@@ -55,17 +57,11 @@ void CHARM(shc_dv)(const CHARM(shc) *shcs,
     /* --------------------------------------------------------------------- */
 
 
-    REAL dvn;
-    for (unsigned long n = 0; n <= nmax; n++)
-    {
-        dvn = PREC(0.0);
-        for (unsigned long m = 0; m <= n; m++)
-            dvn += shcs->c[m][n - m] * shcs->c[m][n - m] +
-                   shcs->s[m][n - m] * shcs->s[m][n - m];
-
-
-        dv[n] = dvn;
-    }
+    /* Parallel computation with the compensated summation.  The coefficients
+     * outside the slice of views are zeros. */
+    CHARM(shc_dv_core)(shcs, NULL, nmax, dv, err);
+    if (!CHARM(err_isempty)(err))
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
 
 
     return;
@@ -0,0 +1,264 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../simd/simd.h"
+#include "shc_view_get_range.h"
+#include "shc_arithmetics_row.h"
+#include "shc_dv_core.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Number of partial sums, to which the orders are distributed.  It must not
+ * depend on the number of threads, as it affects the rounding errors. */
+#undef NPART
+#define NPART (64)
+
+
+
+
+
+
+/* Adds "c[i]^2 + s[i]^2" to "sum[i]" for "i = 0, 1, ..., n - 1" using the
+ * compensated (Kahan) summation.  "comp" stores the compensation terms, so
+ * that the sum is "sum[i] - comp[i]". */
+static void accumulate(const REAL *c,
+                       const REAL *s,
+                       size_t n,
+                       REAL *sum,
+                       REAL *comp)
+{
+    size_t i = 0;
+    REAL_SIMD cv, sv, sumv, yv, tv;
+    for (; i + SIMD_SIZE <= n; i += SIMD_SIZE)
+    {
+        cv   = LOADU_R(&c[i]);
+        sv   = LOADU_R(&s[i]);
+        sumv = LOADU_R(&sum[i]);
+        yv   = SUB_R(ADD_R(MUL_R(cv, cv), MUL_R(sv, sv)), LOADU_R(&comp[i]));
+        tv   = ADD_R(sumv, yv);
+        STOREU_R(&comp[i], SUB_R(SUB_R(tv, sumv), yv));
+        STOREU_R(&sum[i], tv);
+    }
+
+
+    REAL y, t;
+    for (; i < n; i++)
+    {
+        y       = c[i] * c[i] + s[i] * s[i] - comp[i];
+        t       = sum[i] + y;
+        comp[i] = (t - sum[i]) - y;
+        sum[i]  = t;
+    }
+
+
+    return;
+}
+
+
+
+
+
+
+/* Adds "x" to "*sum" using the compensated (Neumaier) summation with the
+ * compensation "*comp".  The sum is "*sum + *comp". */
+static void neumaier(REAL x,
+                     REAL *sum,
+                     REAL *comp)
+{
+    REAL t = *sum + x;
+    if (FABS(*sum) >= FABS(x))
+        *comp += (*sum - t) + x;
+    else
+        *comp += (x - t) + *sum;
+    *sum = t;
+
+
+    return;
+}
+
+
+
+
+
+
+/* Stores the order "m" of "shcs" for degrees "m, ..., nmax" to "x" ("c"
+ * coefficients) and "y" ("s" coefficients).  The coefficients outside the
+ * range of "shcs" (see "shc_view_get_range") are set to zero. */
+static void get_order(const CHARM(shc) *shcs,
+                      unsigned long nmin,
+                      unsigned long mmin,
+                      unsigned long mmax,
+                      unsigned long m,
+                      unsigned long nmax,
+                      REAL *x,
+                      REAL *y)
+{
+    size_t len = nmax - m + 1;
+    size_t k   = (m >= mmin && m <= mmax) ?
+                 CHARM_MIN(CHARM_MAX(nmin, m) - m, len) : len;
+
+
+    CHARM(shc_arithmetics_row)(SHC_ROW_ZERO, k, NULL, NULL, PREC(0.0), x);
+    CHARM(shc_arithmetics_row)(SHC_ROW_ZERO, k, NULL, NULL, PREC(0.0), y);
+    CHARM(shc_arithmetics_row)(SHC_ROW_COPY, len - k, shcs->c[m] + k, NULL,
+                               PREC(0.0), x + k);
+    CHARM(shc_arithmetics_row)(SHC_ROW_COPY, len - k, shcs->s[m] + k, NULL,
+                               PREC(0.0), y + k);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Computes degree variances of "shcs1" up to degree "nmax" if "shcs2" is
+ * "NULL" and difference degree variances between "shcs1" and "shcs2"
+ * otherwise.  The coefficients outside the slice of views returned by
+ * "shc_view" are treated as zeros.  The input parameters must be checked by
+ * the caller.
+ *
+ * The order "m" is summed to the partial sum "m % NPART" using the
+ * compensated summation.  The partial sums are computed in parallel, each by
+ * a single thread in the ascending order of "m", and are finally summed in
+ * a fixed order, again with a compensated summation.  Therefore, the result
+ * depends neither on the number of threads nor on their scheduling and its
+ * rounding errors do not grow with the number of orders. */
+void CHARM(shc_dv_core)(const CHARM(shc) *shcs1,
+                        const CHARM(shc) *shcs2,
+                        unsigned long nmax,
+                        REAL *dv,
+                        CHARM(err) *err)
+{
+#if HAVE_OPENMP
+    const int nthreads = omp_get_max_threads();
+#else
+    const int nthreads = 1;
+#endif
+
+
+    /* Each partial sum needs the sums and the compensations for all degrees.
+     * With "shcs2", each thread needs, in addition, the differences of
+     * a single order. */
+    const size_t nmax1 = (size_t)nmax + 1;
+    const size_t npart = CHARM_MIN(NPART, nmax1);
+    const size_t nper  = 2 * nmax1;
+    const size_t ndiff = (shcs2 == NULL) ? 0 : 2 * nmax1;
+    REAL *buf = (REAL *)calloc(npart * nper + (size_t)nthreads * ndiff,
+                               sizeof(REAL));
+    if (buf == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        return;
+    }
+
+
+    unsigned long nmin1, mmin1, mmax1, nmin2 = 0, mmin2 = 0, mmax2 = 0;
+    CHARM(shc_view_get_range)(shcs1, &nmin1, &mmin1, &mmax1);
+    if (shcs2 != NULL)
+        CHARM(shc_view_get_range)(shcs2, &nmin2, &mmin2, &mmax2);
+
+
+#if HAVE_OPENMP
+#pragma omp parallel default(none) shared(shcs1, shcs2, nmax, nmax1, npart, \
+nper, ndiff, buf, nmin1, mmin1, mmax1, nmin2, mmin2, mmax2) \
+num_threads(nthreads)
+#endif
+    {
+#if HAVE_OPENMP
+        REAL *dc = buf + npart * nper + (size_t)omp_get_thread_num() * ndiff;
+#else
+        REAL *dc = buf + npart * nper;
+#endif
+        REAL *ds = dc + nmax1;
+
+
+#if HAVE_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+        for (size_t p = 0; p < npart; p++)
+        {
+            REAL *sum  = buf + p * nper;
+            REAL *comp = sum + nmax1;
+
+
+            for (unsigned long m = p; m <= nmax; m += npart)
+            {
+                if (shcs2 == NULL)
+                {
+                    if ((m < mmin1) || (m > mmax1))
+                        continue;
+
+
+                    unsigned long n0 = CHARM_MAX(nmin1, m);
+                    if (n0 > nmax)
+                        continue;
+
+
+                    accumulate(shcs1->c[m] + (n0 - m),
+                               shcs1->s[m] + (n0 - m), nmax - n0 + 1,
+                               sum + n0, comp + n0);
+                }
+                else
+                {
+                    /* "dc" and "ds" are the differences "shcs1 - shcs2" of
+                     * order "m" and degrees "m, ..., nmax" */
+                    size_t len = nmax - m + 1;
+                    get_order(shcs1, nmin1, mmin1, mmax1, m, nmax, dc, ds);
+                    if ((m >= mmin2) && (m <= mmax2))
+                    {
+                        size_t k = CHARM_MIN(CHARM_MAX(nmin2, m) - m, len);
+                        CHARM(shc_arithmetics_row)(SHC_ROW_SUB, len - k,
+                                                   dc + k, shcs2->c[m] + k,
+                                                   PREC(0.0), dc + k);
+                        CHARM(shc_arithmetics_row)(SHC_ROW_SUB, len - k,
+                                                   ds + k, shcs2->s[m] + k,
+                                                   PREC(0.0), ds + k);
+                    }
+
+
+                    accumulate(dc, ds, len, sum + m, comp + m);
+                }
+            }
+        }
+    }
+
+
+    /* Sum the partial sums */
+    REAL dvn, cn;
+    for (size_t n = 0; n < nmax1; n++)
+    {
+        dvn = cn = PREC(0.0);
+        for (size_t k = 0; k < npart; k++)
+        {
+            const REAL *sum  = buf + k * nper;
+            const REAL *comp = sum + nmax1;
+            neumaier(sum[n], &dvn, &cn);
+            neumaier(-comp[n], &dvn, &cn);
+        }
+
+
+        dv[n] = dvn + cn;
+    }
+
+
+    free(buf);
+
+
+    return;
+}
@@ -0,0 +1,30 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_DV_CORE_H__
+#define __SHC_DV_CORE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_dv_core)(const CHARM(shc) *,
+                               const CHARM(shc) *,
+                               unsigned long,
+                               REAL *,
+                               CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
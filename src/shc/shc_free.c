@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "../prec.h"
+#include "../misc/misc_funmap.h"
+#include "shc_binz_free.h"
 /* ------------------------------------------------------------------------- */
 
 
@@ -33,13 +35,23 @@ void CHARM(shc_free)(CHARM(shc) *shcs)
         free(shcs->s[0]);
 #endif
     }
+    /* Coefficients memory-mapped by "shc_map_bin" */
+    CHARM(misc_funmap)((CHARM(fmap) *)shcs->map);
+    /* Compressed file opened by "shc_open_binz" */
+    CHARM(shc_binz_free)((CHARM(shc_binz) *)shcs->lazy);
 #if HAVE_MPI
     /* "local_chunk" is always deallocated regardless of "shcs->owner" and
      * "shcs->distributed" */
     free(shcs->local_order);
 #endif
-    free(shcs->c);
-    free(shcs->s);
+    /* Views returned by "shc_view" share "shcs->c" and "shcs->s" with the
+     * structure that stores the coefficients */
+    if (shcs->view == NULL)
+    {
+        free(shcs->c);
+        free(shcs->s);
+    }
+    free(shcs->view);
     free(shcs);
 
 
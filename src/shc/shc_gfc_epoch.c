@@ -0,0 +1,292 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include "../prec.h"
+#include "../misc/misc_str2ul.h"
+#include "../err/err_set.h"
+#include "shc_read_gfc.h"
+#include "shc_gfc_epoch.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+#undef DAYS_PER_NONLEAP_YEAR
+#define DAYS_PER_NONLEAP_YEAR (PREC(365.0))
+
+
+#undef HOURS_PER_DAY
+#define HOURS_PER_DAY (PREC(24.0))
+
+
+#undef MINUTES_PER_HOUR
+#define MINUTES_PER_HOUR (PREC(60.0))
+
+
+#undef HOUR_MAX
+#define HOUR_MAX (24)
+
+
+#undef MINUTE_MAX
+#define MINUTE_MAX (60)
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Converts the epoch string "date" of the "yyyyMMdd" or "yyyyMMdd.hhmm"
+ * format from "gfc" files to the fraction of a year.  If "date" is "NULL",
+ * returned is "SHC_GFC_EPOCH_NULL".  On error, returned is
+ * "SHC_GFC_EPOCH_ERR" and the error is written to "err". */
+REAL_EPOCH CHARM(shc_gfc_epoch)(const char *date,
+                                CHARM(err) *err)
+{
+    if (date == NULL)
+        return SHC_GFC_EPOCH_NULL;
+
+
+    char err_msg[CHARM_ERR_MAX_MSG];
+
+
+    /* Let "date" to point to the first non-space character */
+    while (isspace(date[0]))
+        date++;
+
+
+    /* BC dates are not allowed */
+    if (date[0] == '-')
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG, "Negative epoch \"%s\".", date);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto FAILURE;
+    }
+
+
+    size_t ndate = strlen(date);
+    if (ndate < 8)
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Wrong format of the epoch string \"%s\".  "
+                         "Supported formats are \"yyyyMMdd\" and "
+                         "\"yyyyMMdd.hhmm\".", date);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto FAILURE;
+    }
+
+
+    /* The first value of the array is zero, because we have no zeroth month as
+     * would be nice to have, given the indexing in C.  Then, the total number
+     * of days per month (JAN, FEB, ..., DEC) follow. */
+    static const unsigned long monthdays[13] = {0, 31, 28, 31, 30, 31, 30,
+                                                31, 31, 30, 31, 30, 31};
+
+
+    /* Zero and then leap days for a given month. */
+    static const unsigned long leapdays[13] = {0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+                                               0, 0};
+
+
+    /* Zero and then the total number of days that have already passed before
+     * the first of JAN, FEB, ..., DEC follow.  We do not consider here leap
+     * years to allow the array to be static.  The leap years are treated
+     * later. */
+    static const REAL_EPOCH cumsumdays[13] = {PREC(0.0), PREC(0.0), PREC(31.0),
+                                              PREC(59.0), PREC(90.0),
+                                              PREC(120.0), PREC(151.0),
+                                              PREC(181.0), PREC(212.0),
+                                              PREC(243.0), PREC(273.0),
+                                              PREC(304.0), PREC(334.0)};
+
+
+    char yyyy[5], MM[3], dd[3], hh[3], mm[3];
+    yyyy[4] = MM[2] = dd[2] = hh[2] = mm[2] = '\0';
+
+
+    /* Split "date" to strings "yyyy", "MM", ... */
+    memcpy(yyyy, date, 4);
+    memcpy(MM,   date + 4, 2);
+    memcpy(dd,   date + 6, 2);
+
+
+    /* Convert "yyyy", etc to "REAL_EPOCH" or "unsigned long".  Instead of
+     * "unsigned long", "int" or "unsigned int" could be used.  But given that
+     * we already have a nice routine to convert a string to "unsigned long",
+     * we use "unsigned int". */
+    unsigned long year = CHARM(misc_str2ul)(yyyy, "", err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_reset)(err);
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Failed to convert the year value \"yyyy = %s\" of "
+                         "the epoch string \"%s\" to a floating point.", yyyy,
+                         date);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto FAILURE;
+    }
+
+
+    /* Is this a leap year? */
+    _Bool isleapyear = (!(year % 400) || (!(year % 4) && (year % 100))) ? 1
+                                                                        : 0;
+
+
+    unsigned long month = CHARM(misc_str2ul)(MM, "", err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_reset)(err);
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Failed to convert the month value \"MM = %s\" of "
+                         "the epoch string \"%s\" to a floating point.", MM,
+                         date);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto FAILURE;
+    }
+    if ((month < 1) || (month > 12))
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Invalid value of month \"MM = %02lu\" in the "
+                         "epoch string \"%s\".", month, date);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto FAILURE;
+    }
+
+
+    unsigned long day = CHARM(misc_str2ul)(dd, "", err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_reset)(err);
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Failed to convert the day value \"dd = %s\" in the "
+                         "epoch string \"%s\" to a floating point.", dd, date);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto FAILURE;
+    }
+    if ((day < 1) ||
+        (day > (monthdays[month] + isleapyear * leapdays[month])))
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Invalid value of day \"day = %02lu\" in the "
+                         "epoch string \"%s\".", day, date);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto FAILURE;
+    }
+
+
+    /* Check whether "date" is of "yyyyMMdd.hhmm" or "yyyyMMdd" structure */
+    unsigned long hour, min;
+    hour = min = 0;
+    /* If the character after "yyyyMMdd" is not a terminating byte, it must
+     * be ".", after which "hhmm" must follow. */
+    if (ndate > 8)
+    {
+        if ((ndate != 13) || (date[8] != '.'))
+        {
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                             "Wrong format of the epoch string \"%s\".  "
+                             "Supported formats are \"yyyyMMdd\" and "
+                             "\"yyyyMMdd.hhmm\".", date);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           err_msg);
+            goto FAILURE;
+        }
+
+
+        memcpy(hh, date + 9, 2);
+        hour = CHARM(misc_str2ul)(hh, "", err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_reset)(err);
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                             "Failed to convert the value of hours "
+                             "\"hh = %s\" in the epoch string string \"%s\" "
+                             "to a floating point.", hh, date);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           err_msg);
+            goto FAILURE;
+        }
+        if (hour > HOUR_MAX)
+        {
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                             "Invalid value of hour \"hh = %02lu\" in the "
+                             "epoch string \"%s\".", hour, date);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           err_msg);
+            goto FAILURE;
+        }
+
+
+        memcpy(mm, date + 11, 2);
+        min = CHARM(misc_str2ul)(mm, "", err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_reset)(err);
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                             "Failed to convert the value of minutes "
+                             "\"mm = %s\" in the epoch string string \"%s\" "
+                             "to a floating point.", mm, date);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           err_msg);
+            goto FAILURE;
+        }
+        if (min > MINUTE_MAX)
+        {
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                             "Invalid value of minutes \"mm = %02lu\" in the "
+                             "epoch string \"%s\".", min, date);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           err_msg);
+            goto FAILURE;
+        }
+    }
+
+
+    if ((hour == 24) && (min == 60))
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Invalid combination of hours and minutes "
+                         "in the epoch string \"%s\".  If by \"hh = %02lu\" "
+                         "and \"mm = %02lu\" you mean the beginning of the "
+                         "next day, use either \"%04lu%02lu%02lu.0000\" or "
+                         "\"%04lu%02lu%02lu.2400\".",
+                         date, hour, min, year, month, day + 1, year, month,
+                         day);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto FAILURE;
+    }
+
+
+    /* Day of year decreased by one */
+    REAL_EPOCH doy = (REAL_EPOCH)day + cumsumdays[month] - PREC(1.0);
+    if (isleapyear && (month > 2))
+        doy += PREC(1.0);
+
+
+    /* Total number of days in year */
+    REAL_EPOCH ndays = DAYS_PER_NONLEAP_YEAR + isleapyear;
+
+
+    return (REAL_EPOCH)year + (doy + ((REAL_EPOCH)hour +
+                                      (REAL_EPOCH)min / MINUTES_PER_HOUR) /
+                               HOURS_PER_DAY) / ndays;
+
+
+FAILURE:
+    return SHC_GFC_EPOCH_ERR;
+}
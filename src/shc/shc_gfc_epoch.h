@@ -0,0 +1,38 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_GFC_EPOCH_H__
+#define __SHC_GFC_EPOCH_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shc_read_gfc.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/* Returned by "shc_gfc_epoch" on error */
+#undef SHC_GFC_EPOCH_ERR
+#define SHC_GFC_EPOCH_ERR (PREC(-9999.0))
+
+
+/* Returned by "shc_gfc_epoch" if the epoch string is "NULL" */
+#undef SHC_GFC_EPOCH_NULL
+#define SHC_GFC_EPOCH_NULL (PREC(-8888.0))
+
+
+extern REAL_EPOCH CHARM(shc_gfc_epoch)(const char *,
+                                       CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -40,6 +40,9 @@ CHARM(shc) *CHARM(shc_init_chunk)(unsigned long nmax,
 
 
     shcs->c = shcs->s = NULL;
+    shcs->map = NULL;
+    shcs->lazy = NULL;
+    shcs->view = NULL;
 #if HAVE_MPI
     shcs->local_order = NULL;
 #endif
@@ -0,0 +1,156 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../misc/misc_fmap.h"
+#include "../misc/misc_funmap.h"
+#include "shc_bin.h"
+#include "shc_bin_header_decode.h"
+#include "shc_init_chunk.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+CHARM(shc) *CHARM(shc_map_bin)(const char *pathname,
+                               CHARM(err) *err)
+{
+    /* Open "pathname" to read */
+    /* ===================================================================== */
+    char msg[CHARM_ERR_MAX_MSG];
+    FILE *fptr = fopen(pathname, "rb");
+    if (fptr == NULL)
+    {
+        snprintf(msg, CHARM_ERR_MAX_MSG, "Couldn't open \"%s\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFILEIO, msg);
+        return NULL;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Map the whole file to the memory.  The mapping remains valid after the
+     * file is closed. */
+    /* ===================================================================== */
+    CHARM(shc) *shcs  = NULL;
+    CHARM(fmap) *fmap = CHARM(misc_fmap)(fptr, err);
+    fclose(fptr);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return NULL;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Check the header */
+    /* ===================================================================== */
+    if ((fmap->size < SHC_BIN_HEADER) ||
+        (memcmp(fmap->data, SHC_BIN_MAGIC, SHC_BIN_NMAGIC) != 0))
+    {
+        snprintf(msg, CHARM_ERR_MAX_MSG,
+                 "\"%s\" is not a versioned binary file with spherical "
+                 "harmonic coefficients.  Binary files written by CHarm 0.4.8 "
+                 "or older cannot be memory-mapped; read them with "
+                 "\"charm" CHARM_SUFFIX "_shc_read_bin\" and write them again "
+                 "with \"charm" CHARM_SUFFIX "_shc_write_bin\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO, msg);
+        goto FAILURE;
+    }
+
+
+    CHARM(shc_bin_header) hdr;
+    CHARM(shc_bin_header_decode)((const unsigned char *)fmap->data, &hdr,
+                                 err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto FAILURE;
+    }
+
+
+    /* The coefficients are used in place, so the file must have been written
+     * in the same precision and byte order */
+    if (hdr.prec != SHC_BIN_PREC)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "The precision of the coefficients in the binary file "
+                       "differs from the precision, in which CHarm was "
+                       "compiled.  Use \"charm" CHARM_SUFFIX "_shc_read_bin\" "
+                       "instead.");
+        goto FAILURE;
+    }
+
+
+    if (hdr.swap)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "The binary file was written on a machine with "
+                       "a different byte order, so it cannot be "
+                       "memory-mapped.  Use \"charm" CHARM_SUFFIX
+                       "_shc_read_bin\" instead.");
+        goto FAILURE;
+    }
+
+
+    size_t ncs = (((size_t)hdr.nmax + 2) * ((size_t)hdr.nmax + 1)) / 2;
+    if (((hdr.offset_c % sizeof(REAL)) != 0) ||
+        ((hdr.offset_s % sizeof(REAL)) != 0) ||
+        (hdr.offset_s + ncs * sizeof(REAL) > fmap->size))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "The binary file is truncated or its coefficients are "
+                       "not aligned.");
+        goto FAILURE;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Create the "charm_shc" structure pointing to the mapped coefficients */
+    /* ===================================================================== */
+    unsigned long nmax = (unsigned long)hdr.nmax;
+    unsigned long chunk[2] = {0, nmax};
+    shcs = CHARM(shc_init_chunk)(nmax, hdr.mu, hdr.r,
+                                 (REAL *)(fmap->data + hdr.offset_c),
+                                 (REAL *)(fmap->data + hdr.offset_s),
+                                 1, chunk, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto FAILURE;
+    }
+
+
+    /* "shcs->owner" is "0", so "shc_free" does not deallocate the
+     * coefficients, but it unmaps the file */
+    shcs->map = fmap;
+    /* ===================================================================== */
+
+
+    return shcs;
+
+
+FAILURE:
+    CHARM(shc_free)(shcs);
+    CHARM(misc_funmap)(fmap);
+    return NULL;
+}
@@ -7,6 +7,7 @@
 #include "../err/err_set.h"
 #include "../err/err_propagate.h"
 #include "shc_arithmetics_wise_checks.h"
+#include "shc_arithmetics_row.h"
 /* ------------------------------------------------------------------------- */
 
 
@@ -32,16 +33,23 @@ void CHARM(shc_mul_degree_wise)(CHARM(shc) *shcs,
 
 
     /* --------------------------------------------------------------------- */
-    unsigned long nmm, i;
+    /* The orders are distributed among the threads, each order is processed
+     * as a contiguous row of degrees "max(nmin, m), ..., nmax" */
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) shared(shcs, a, nmin, nmax) \
+schedule(dynamic)
+#endif
     for (unsigned long m = 0; m <= nmax; m++)
     {
-        for (unsigned long n = CHARM_MAX(nmin, m); n <= nmax; n++)
-        {
-            nmm = n - m;
-            i = n - nmin;
-            shcs->c[m][nmm] *= a[i];
-            shcs->s[m][nmm] *= a[i];
-        }
+        unsigned long n0 = CHARM_MAX(nmin, m);
+        size_t nmm0      = n0 - m;
+        size_t len       = nmax - n0 + 1;
+        CHARM(shc_arithmetics_row)(SHC_ROW_MUL, len, shcs->c[m] + nmm0,
+                                   a + (n0 - nmin), PREC(0.0),
+                                   shcs->c[m] + nmm0);
+        CHARM(shc_arithmetics_row)(SHC_ROW_MUL, len, shcs->s[m] + nmm0,
+                                   a + (n0 - nmin), PREC(0.0),
+                                   shcs->s[m] + nmm0);
     }
     /* --------------------------------------------------------------------- */
 
@@ -0,0 +1,120 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE_MPI
+#   include <mpi.h>
+#endif
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../misc/misc_check_radius.h"
+#include "shc_bin.h"
+#include "shc_binz.h"
+#include "shc_binz_open.h"
+#include "shc_binz_free.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+CHARM(shc) *CHARM(shc_open_binz)(const char *pathname,
+                                 CHARM(err) *err)
+{
+    /* Read the header and the index of "pathname" */
+    /* ===================================================================== */
+    CHARM(shc) *shcs = NULL;
+    CHARM(shc_binz) *binz = CHARM(shc_binz_open)(pathname, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return NULL;
+    }
+
+
+    /* The coefficients are decompressed directly to the memory, so the file
+     * must have been written in the same precision */
+    if (binz->prec != SHC_BIN_PREC)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "The precision of the coefficients in the compressed "
+                       "binary file differs from the precision, in which "
+                       "CHarm was compiled.");
+        goto FAILURE;
+    }
+
+
+    CHARM(misc_check_radius)(binz->r, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto FAILURE;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Create the "charm_shc" structure without the coefficients.  These are
+     * decompressed from the file by blocks of orders whenever needed (see
+     * "shc_block_get_coeffs"). */
+    /* ===================================================================== */
+    shcs = (CHARM(shc) *)malloc(sizeof(CHARM(shc)));
+    if (shcs == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE;
+    }
+
+
+    size_t nmax1 = (size_t)binz->nmax + 1;
+    shcs->nmax        = (unsigned long)binz->nmax;
+    shcs->mu          = binz->mu;
+    shcs->r           = binz->r;
+    shcs->nc          = ((nmax1 + 1) * nmax1) / 2;
+    shcs->ns          = shcs->nc;
+    shcs->c           = NULL;
+    shcs->s           = NULL;
+    shcs->owner       = 0;
+    shcs->distributed = 0;
+    shcs->map         = NULL;
+    shcs->lazy        = binz;
+    shcs->view        = NULL;
+#if HAVE_MPI
+    shcs->local_nc     = shcs->nc;
+    shcs->local_ns     = shcs->ns;
+    shcs->local_nchunk = 1;
+    shcs->comm         = MPI_COMM_NULL;
+    shcs->local_order  = (unsigned long *)malloc(2 * sizeof(unsigned long));
+    if (shcs->local_order == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE;
+    }
+    shcs->local_order[0] = 0;
+    shcs->local_order[1] = shcs->nmax;
+#endif
+    /* ===================================================================== */
+
+
+    return shcs;
+
+
+FAILURE:
+    if (shcs != NULL)
+    {
+#if HAVE_MPI
+        free(shcs->local_order);
+#endif
+        free(shcs);
+    }
+    CHARM(shc_binz_free)(binz);
+    return NULL;
+}
@@ -0,0 +1,70 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "../prec.h"
+#include "../misc/misc_fseek.h"
+#include "../err/err_set.h"
+#include "shc_ranges_struct.h"
+#include "shc_ranges_fgets.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Reads the next line of "fptr" to "line" of "nline" characters by "fgets".
+ *
+ * If "ranges" is "NULL", the function is only a wrapper around "fgets".
+ * Otherwise, only the lines inside "ranges" are read.  To this end, "ir" is
+ * the index of the next range and "left" is the number of bytes that are left
+ * in the current range.  Both must be set to zero before the first call.
+ *
+ * Returned is "line" or "NULL" if there are no more lines to be read.  If
+ * "NULL" is returned because seeking in the file failed, "err" is set. */
+char *CHARM(shc_ranges_fgets)(char *line,
+                              int nline,
+                              FILE *fptr,
+                              const CHARM(shc_ranges) *ranges,
+                              size_t *ir,
+                              uint64_t *left,
+                              CHARM(err) *err)
+{
+    if (ranges == NULL)
+        return fgets(line, nline, fptr);
+
+
+    while (*left == 0)
+    {
+        if (*ir == ranges->n)
+            return NULL;
+
+
+        if (CHARM(misc_fseek)(fptr, ranges->off[2 * *ir]))
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Failed to seek in the input file.");
+            return NULL;
+        }
+
+
+        *left = ranges->off[2 * *ir + 1] - ranges->off[2 * *ir];
+        (*ir)++;
+    }
+
+
+    if (fgets(line, nline, fptr) == NULL)
+        return NULL;
+
+
+    /* The ranges end after a new line character, so the lines read by "fgets"
+     * never cross the end of a range */
+    size_t len = strlen(line);
+    *left      = (len < *left) ? *left - len : 0;
+
+
+    return line;
+}
@@ -0,0 +1,35 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_RANGES_FGETS_H__
+#define __SHC_RANGES_FGETS_H__
+
+
+#include <config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "../prec.h"
+#include "shc_ranges_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern char *CHARM(shc_ranges_fgets)(char *,
+                                     int,
+                                     FILE *,
+                                     const CHARM(shc_ranges) *,
+                                     size_t *,
+                                     uint64_t *,
+                                     CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,32 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_RANGES_STRUCT_H__
+#define __SHC_RANGES_STRUCT_H__
+
+
+#include <config.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../prec.h"
+
+
+/* Byte ranges of the data section of a text file with spherical harmonic
+ * coefficients.  The internal readers of text files read only the lines inside
+ * the ranges, so that each MPI process parses only the lines of its local
+ * orders (see "mpi_shc_read_text"). */
+typedef struct
+{
+    /* Number of ranges */
+    size_t n;
+
+
+    /* Offsets from the beginning of the file in bytes.  The "i"th range starts
+     * at "off[2 * i]" and ends before "off[2 * i + 1]".  The ranges start at
+     * the beginning of a line and end after a new line character or at the end
+     * of the file. */
+    uint64_t *off;
+} CHARM(shc_ranges);
+
+
+#endif
@@ -0,0 +1,153 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+#include "shc_bin.h"
+#include "shc_bin_open.h"
+#include "shc_bin_read_orders.h"
+#include "shc_check_chunk_orders.h"
+#include "shc_check_distribution.h"
+#include "shc_check_map.h"
+#include "shc_read_nmax_only.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+unsigned long CHARM(shc_read_bin_chunk)(const char *pathname,
+                                        unsigned long nmax,
+                                        size_t nchunk,
+                                        const unsigned long *order,
+                                        CHARM(shc) *shcs,
+                                        CHARM(err) *err)
+{
+    /* ===================================================================== */
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return CHARM_SHC_NMAX_ERROR;
+    }
+
+
+    if (!CHARM(shc_read_nmax_only)(nmax, shcs))
+    {
+        CHARM(shc_check_distribution)(shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return CHARM_SHC_NMAX_ERROR;
+        }
+
+
+        CHARM(shc_check_map)(shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return CHARM_SHC_NMAX_ERROR;
+        }
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Open "pathname" and read its header */
+    /* ===================================================================== */
+    CHARM(shc_bin_header) hdr;
+    FILE *fptr = CHARM(shc_bin_open)(pathname, &hdr, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return CHARM_SHC_NMAX_ERROR;
+    }
+
+
+    unsigned long nmax_file = (unsigned long)hdr.nmax;
+    if (CHARM(shc_read_nmax_only)(nmax, shcs))
+        goto EXIT;
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Check the input parameters */
+    /* ===================================================================== */
+    if (hdr.prec != SHC_BIN_PREC)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "The precision of the coefficients in the binary "
+                       "file differs from the precision, in which CHarm "
+                       "was compiled.");
+        goto EXIT;
+    }
+
+
+    if (nmax > nmax_file)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFUNCARG,
+                       "Not enough coefficients in the input file "
+                       "for the maximum harmonic degree \"nmax\".");
+        goto EXIT;
+    }
+
+
+    if (shcs->nmax < nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFUNCARG,
+                       "Too low maximum degree \"shcs->nmax\" to read "
+                       "coefficients up to degree \"nmax\".");
+        goto EXIT;
+    }
+
+
+    CHARM(shc_check_chunk_orders)(nmax, nchunk, order, 0, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Read the coefficients of the chunks */
+    /* ===================================================================== */
+    CHARM(shc_bin_read_orders)(fptr, &hdr, nmax, nchunk, order, shcs, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
+    }
+
+
+    /* Note that we do not touch "shcs->nmax", "shcs->nc" and "shcs->ns" */
+    shcs->mu = hdr.mu;
+    shcs->r  = hdr.r;
+    /* ===================================================================== */
+
+
+
+
+
+
+EXIT:
+    fclose(fptr);
+    return nmax_file;
+}
@@ -0,0 +1,204 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+#include "shc_bin.h"
+#include "shc_binz.h"
+#include "shc_binz_open.h"
+#include "shc_binz_free.h"
+#include "shc_binz_read_orders.h"
+#include "shc_check_distribution.h"
+#include "shc_check_map.h"
+#include "shc_read_nmax_only.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+unsigned long CHARM(shc_read_binz)(const char *pathname,
+                                   unsigned long nmax,
+                                   CHARM(shc) *shcs,
+                                   CHARM(err) *err)
+{
+    /* ===================================================================== */
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return CHARM_SHC_NMAX_ERROR;
+    }
+
+
+    if (!CHARM(shc_read_nmax_only)(nmax, shcs))
+    {
+        CHARM(shc_check_distribution)(shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return CHARM_SHC_NMAX_ERROR;
+        }
+
+
+        CHARM(shc_check_map)(shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return CHARM_SHC_NMAX_ERROR;
+        }
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Read the header and the index of "pathname" */
+    /* ===================================================================== */
+    CHARM(shc_binz) *binz = CHARM(shc_binz_open)(pathname, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return CHARM_SHC_NMAX_ERROR;
+    }
+
+
+    FILE *fptr = NULL;
+    REAL *c    = NULL;
+    REAL *s    = NULL;
+    unsigned long nmax_file = (unsigned long)binz->nmax;
+    if (CHARM(shc_read_nmax_only)(nmax, shcs))
+        goto EXIT;
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Check the input parameters */
+    /* ===================================================================== */
+    if (binz->prec != SHC_BIN_PREC)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "The precision of the coefficients in the compressed "
+                       "binary file differs from the precision, in which "
+                       "CHarm was compiled.");
+        goto EXIT;
+    }
+
+
+    if (nmax > nmax_file)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFUNCARG,
+                       "Not enough coefficients in the input file "
+                       "for the maximum harmonic degree \"nmax\".");
+        goto EXIT;
+    }
+
+
+    if (shcs->nmax < nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFUNCARG,
+                       "Too low maximum degree \"shcs->nmax\" to read "
+                       "coefficients up to degree \"nmax\".");
+        goto EXIT;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Read the coefficients */
+    /* ===================================================================== */
+    fptr = fopen(pathname, "rb");
+    if (fptr == NULL)
+    {
+        char msg[CHARM_ERR_MAX_MSG];
+        snprintf(msg, CHARM_ERR_MAX_MSG, "Couldn't open \"%s\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO, msg);
+        goto EXIT;
+    }
+
+
+    if ((nmax == nmax_file) && (shcs->nmax == nmax_file))
+    {
+        /* The layout of the file and of "shcs" is the same, so all orders are
+         * decompressed directly to "shcs" */
+        CHARM(shc_binz_read_orders)(fptr, binz, 0, nmax, shcs->c[0],
+                                    shcs->s[0], err);
+        if (!CHARM(err_isempty)(err))
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
+    }
+
+
+    /* Otherwise, the orders are decompressed one by one to "c" and "s", from
+     * which the coefficients up to degree "nmax" are copied to "shcs" */
+    c = (REAL *)malloc(((size_t)nmax_file + 1) * sizeof(REAL));
+    s = (REAL *)malloc(((size_t)nmax_file + 1) * sizeof(REAL));
+    if ((c == NULL) || (s == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto EXIT;
+    }
+
+
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        CHARM(shc_binz_read_orders)(fptr, binz, m, m, c, s, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT;
+        }
+
+
+        memcpy(shcs->c[m], c, (nmax + 1 - m) * sizeof(REAL));
+        memcpy(shcs->s[m], s, (nmax + 1 - m) * sizeof(REAL));
+    }
+
+
+    /* The coefficients beyond degree "nmax" are set to zero */
+    for (unsigned long m = 0; m <= shcs->nmax; m++)
+    {
+        for (unsigned long n = CHARM_MAX(m, nmax + 1); n <= shcs->nmax; n++)
+            shcs->c[m][n - m] = shcs->s[m][n - m] = PREC(0.0);
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+EXIT:
+    if (CHARM(err_isempty)(err) && (shcs != NULL))
+    {
+        /* Note that we do not touch "shcs->nmax", "shcs->nc" and
+         * "shcs->ns" */
+        shcs->mu = binz->mu;
+        shcs->r  = binz->r;
+    }
+
+
+    free(c);
+    free(s);
+    if (fptr != NULL)
+        fclose(fptr);
+    CHARM(shc_binz_free)(binz);
+    return (CHARM(err_isempty)(err)) ? nmax_file : CHARM_SHC_NMAX_ERROR;
+}
@@ -0,0 +1,31 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_READ_DOV_CORE_H__
+#define __SHC_READ_DOV_CORE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shc_ranges_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern unsigned long CHARM(shc_read_dov_core)(const char *,
+                                              unsigned long,
+                                              const CHARM(shc_ranges) *,
+                                              CHARM(shc) *,
+                                              CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
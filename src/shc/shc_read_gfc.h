@@ -107,6 +107,20 @@ extern "C"
 #define SHC_READ_GFC_ACOS "acos"
 
 
+/* The data type to store the epoch as a fraction of year depends on the
+ * precision, in which CHarm is being compiled.  The reason is that if
+ * compiling in single precision, the range of the "float" data type may not be
+ * sufficient to store the fraction of a year value.  In that case, double
+ * precision is used.  When compiling CHarm in double or quadruple precision,
+ * used is double or quadruple precision, respectively. */
+#undef REAL_EPOCH
+#if CHARM_FLOAT
+#   define REAL_EPOCH double
+#else
+#   define REAL_EPOCH REAL
+#endif
+
+
 #ifdef __cplusplus
 }
 #endif
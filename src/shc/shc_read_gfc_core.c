@@ -0,0 +1,1600 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "shc_reset_coeffs.h"
+#include "shc_read_gfc.h"
+#include "shc_read_gfc_core.h"
+#include "shc_gfc_epoch.h"
+#include "shc_tv_struct.h"
+#include "shc_tv_add_term.h"
+#include "shc_read_nmax_only.h"
+#include "shc_check_distribution.h"
+#include "shc_check_map.h"
+#include "shc_ranges_struct.h"
+#include "../misc/misc_str2ul.h"
+#include "../misc/misc_str2real.h"
+#include "../misc/misc_strn2ul.h"
+#include "../misc/misc_strn2real.h"
+#include "../misc/misc_fmap.h"
+#include "../misc/misc_funmap.h"
+#include "../misc/misc_scanf.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Symbolic constants */
+/* ------------------------------------------------------------------------- */
+/* Suze of the char array to store a single line of the "gfc" file */
+#undef NLINE
+#define NLINE (12 * SCANF_BUFFER + 11)
+
+
+/* Maximum number of entries on a single line of the data section */
+#undef NENTRIES
+#define NENTRIES (12)
+
+
+/* The data section is scanned in batches.  Each thread scans approximately
+ * this number of bytes of a batch. */
+#undef CHUNK_SIZE
+#define CHUNK_SIZE (1 << 20)
+
+
+/* Initial number of lines that can be stored by a thread for a single batch.
+ * If needed, the number is increased. */
+#undef NLINES_INIT
+#define NLINES_INIT (1 << 14)
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Macros */
+/* ------------------------------------------------------------------------- */
+/* Read harmonic degree/order from a line */
+#define READ_DEG_ORD(val, str, degord, pathname)                              \
+        val = CHARM(misc_str2ul)(str, "", err);                               \
+        if (!CHARM(err_isempty)(err))                                         \
+        {                                                                     \
+            CHARM(err_reset)(err);                                            \
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,                              \
+                             "Failed to convert harmonic %s \"%s\" in \"%s\" "\
+                             "to the \"unsigned long int\" data format.",     \
+                    degord, str, pathname);                                   \
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,  \
+                           err_msg);                                          \
+            goto EXIT;                                                        \
+        }
+
+
+/* Read coefficients from a line */
+#define READ_CNM_SNM(val, str, type, n, m, pathname)                          \
+        val = CHARM(misc_str2real)(str, "", err);                             \
+        if (!CHARM(err_isempty)(err))                                         \
+        {                                                                     \
+            CHARM(err_reset)(err);                                            \
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,                              \
+                             "Failed to convert the \"%s\" coefficient "      \
+                             "\"%s\" of degree \"%lu\" and order \"%lu\" in " \
+                             "\"%s\" to the \"REAL\" data format.",           \
+                    type, str, n, m, pathname);                               \
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,  \
+                           err_msg);                                          \
+            goto EXIT;                                                        \
+        }
+
+
+/* Check the number of entries in a line */
+#define WRONG_NUMBER_OF_ENTRIES                                               \
+        remove_new_line_char(line);                                           \
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,                                  \
+                         "The following line of \"%s\" has an "               \
+                         "incorrect number of entries: \"%s\".",              \
+                pathname, line);                                              \
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,                     \
+                       CHARM_EFILEIO, err_msg);                               \
+        goto EXIT;
+
+
+/* In time variable models, checks whether degree and order of coefficients of
+ * the types "SHC_READ_GFC_TRND", "SHC_READ_GFC_DOT", "SHC_READ_GFC_ASIN" and
+ * "SHC_READ_GFC_ACOS" match their expected value. */
+#define EXPECTED_DEGREE_ORDER(type, n, m, pathname, n_tmp, m_tmp, cnm, snm)   \
+        if ((n_tmp != n) || (m_tmp != m))                                     \
+        {                                                                     \
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,                              \
+                             "Expected in file \"%s\" coefficients \"%s\" of "\
+                             "degree \"%lu\" and order \"%lu\", but "         \
+                             "found instead coefficients \"%s\" and \"%s\" "  \
+                             "of degree \"%lu\" and order \"%lu\".",          \
+                    pathname, type, n, m, cnm, snm, n_tmp, m_tmp);            \
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__,                 \
+                           CHARM_EFILEIO, err_msg);                           \
+            goto EXIT;                                                        \
+        }
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Data types */
+/* ------------------------------------------------------------------------- */
+/* A line from the data section of the "gfc" file */
+typedef struct
+{
+    /* Beginning of the line in the file and the number of its characters */
+    const char *line;
+    size_t len;
+
+
+    /* If "fast" is "1", the line starts with "SHC_READ_GFC_GFC", has enough
+     * entries and all its entries were successfully converted to "n", "m",
+     * "c" and "s".  If "0", the line has to be processed by the general
+     * (slow) code path. */
+    _Bool fast;
+    unsigned long n, m;
+    REAL c, s;
+} gfc_line;
+
+
+/* Lines found by a single thread in the current batch */
+typedef struct
+{
+    gfc_line *lines;
+    size_t nlines;
+    size_t nlines_max;
+
+
+    /* Set to "1" if the memory allocation for "lines" failed */
+    _Bool failed;
+} gfc_lines;
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Functions */
+/* ------------------------------------------------------------------------- */
+/* Returns true if "t0 <= t < t1" and false otherwise. */
+static _Bool is_within_time_period(REAL_EPOCH t,
+                                   REAL_EPOCH t0,
+                                   REAL_EPOCH t1)
+{
+    return (t >= t0) && (t < t1);
+}
+
+
+
+
+
+
+/* Computes the difference between two fractions of a year.  If needed (i.e.,
+ * when compiling CHarm in single precision), the output difference is type
+ * casted from "REAL_EPOCH" to "REAL". */
+static REAL epoch_diff(REAL_EPOCH t, REAL_EPOCH t0)
+{
+    return t - t0;
+}
+
+
+
+
+
+
+/* Removes the first new line character in input string */
+static void remove_new_line_char(char *str)
+{
+    char *replace = strchr(str, '\n');
+    if (replace != NULL)
+        replace[0] = '\0';
+
+
+    return;
+}
+
+
+
+
+
+
+/* Returns the number of characters of the line starting at "str" that would
+ * be read by "fgets" with the buffer of "NLINE" characters.  "end" points to
+ * the first character after the end of the data. */
+static size_t line_length(const char *str,
+                          const char *end)
+{
+    size_t len = (size_t)(end - str);
+    if (len > NLINE - 1)
+        len = NLINE - 1;
+
+
+    const char *nl = memchr(str, '\n', len);
+
+
+    return (nl == NULL) ? len : (size_t)(nl - str) + 1;
+}
+
+
+
+
+
+
+/* Splits the first "len" characters of "line" into at most "NENTRIES" entries
+ * separated by white-space characters in the same way as "sscanf" with
+ * "NENTRIES" conversion specifiers "SCANF_SFS(SCANF_WIDTH)" does.  Pointers to
+ * the entries and their lengths are stored in "str" and "nstr", respectively.
+ * Returned is the number of the entries found (zero for empty lines). */
+static int split_line(const char *line,
+                      size_t len,
+                      const char **str,
+                      size_t *nstr)
+{
+    const char *p   = line;
+    const char *end = line + len;
+    int ns = 0;
+
+
+    while (ns < NENTRIES)
+    {
+        while ((p < end) && isspace((unsigned char)*p))
+            p++;
+        if ((p == end) || (*p == '\0'))
+            break;
+
+
+        str[ns] = p;
+        while ((p < end) && (*p != '\0') && !isspace((unsigned char)*p) &&
+               ((size_t)(p - str[ns]) < SCANF_WIDTH))
+            p++;
+        nstr[ns] = (size_t)(p - str[ns]);
+        ns++;
+    }
+
+
+    return ns;
+}
+
+
+
+
+
+
+/* Returns "1" if the first "nstr" characters of "str" are equal to the
+ * null-terminated string "key" and "0" otherwise */
+static _Bool str_is(const char *str,
+                    size_t nstr,
+                    const char *key)
+{
+    return (strlen(key) == nstr) && (memcmp(str, key, nstr) == 0);
+}
+
+
+
+
+
+
+/* Scans the data section of "gfc" files from "begin" up to "end" (excluding)
+ * and stores the lines that start with one of the keywords of the data
+ * section to "out".  Other lines are comments and are skipped.  Lines starting
+ * with "SHC_READ_GFC_GFC" that have at least "ns_gfc" entries are converted to
+ * numbers right here, so that they do not have to be processed by the slow
+ * code path.  The function is thread-safe, so it can be called on different
+ * parts of the file in parallel. */
+static void scan_lines(const char *begin,
+                       const char *end,
+                       int ns_gfc,
+                       gfc_lines *out)
+{
+    const char *str[NENTRIES];
+    size_t nstr[NENTRIES];
+    const char *p = begin;
+    size_t len;
+    int ns, fail;
+    gfc_line *ln;
+
+
+    out->nlines = 0;
+    for (; p < end; p += len)
+    {
+        len = line_length(p, end);
+        ns  = split_line(p, len, str, nstr);
+        if (ns == 0)
+            /* Probably an empty line which is valid in "gfc" files */
+            continue;
+
+
+        _Bool is_gfc = str_is(str[0], nstr[0], SHC_READ_GFC_GFC);
+        if (!is_gfc &&
+            !str_is(str[0], nstr[0], SHC_READ_GFC_GFCT) &&
+            !str_is(str[0], nstr[0], SHC_READ_GFC_TRND) &&
+            !str_is(str[0], nstr[0], SHC_READ_GFC_DOT) &&
+            !str_is(str[0], nstr[0], SHC_READ_GFC_ASIN) &&
+            !str_is(str[0], nstr[0], SHC_READ_GFC_ACOS))
+            /* Comment */
+            continue;
+
+
+        if (out->nlines == out->nlines_max)
+        {
+            size_t nlines_max = 2 * out->nlines_max;
+            gfc_line *tmp = (gfc_line *)realloc(out->lines,
+                                                nlines_max *
+                                                sizeof(gfc_line));
+            if (tmp == NULL)
+            {
+                out->failed = 1;
+                return;
+            }
+            out->lines      = tmp;
+            out->nlines_max = nlines_max;
+        }
+
+
+        ln       = out->lines + out->nlines++;
+        ln->line = p;
+        ln->len  = len;
+        ln->fast = 0;
+
+
+        if (!is_gfc || (ns < ns_gfc))
+            continue;
+
+
+        fail  = 0;
+        ln->n = CHARM(misc_strn2ul)(str[1], nstr[1], &fail);
+        ln->m = CHARM(misc_strn2ul)(str[2], nstr[2], &fail);
+        ln->c = CHARM(misc_strn2real)(str[3], nstr[3], &fail);
+        if (ln->m == 0)
+            ln->s = PREC(0.0);
+        else if (ns < 5)
+            fail = 1;
+        else
+            ln->s = CHARM(misc_strn2real)(str[4], nstr[4], &fail);
+
+
+        ln->fast = !fail;
+    }
+
+
+    return;
+}
+
+
+
+
+
+
+/* Scans the next batch of the data section that starts at "batch" using
+ * "nthreads" threads.  The lines found by the "i"th thread are stored in
+ * "lines[i]".  Returned is the pointer to the beginning of the next batch.
+ * */
+static const char *scan_batch(const char *batch,
+                              const char *data_end,
+                              int ns_gfc,
+                              int nthreads,
+                              gfc_lines *lines)
+{
+    /* Split the batch into chunks, one for each thread.  The chunks must start
+     * at the beginning of a line. */
+    const char *chunk[nthreads + 1];
+    chunk[0] = batch;
+    for (int i = 1; i <= nthreads; i++)
+    {
+        const char *c = chunk[i - 1];
+        if ((size_t)(data_end - c) <= CHUNK_SIZE)
+            c = data_end;
+        else
+        {
+            c = memchr(c + CHUNK_SIZE, '\n',
+                       (size_t)(data_end - c) - CHUNK_SIZE);
+            c = (c == NULL) ? data_end : c + 1;
+        }
+        chunk[i] = c;
+    }
+
+
+#if HAVE_OPENMP
+#pragma omp parallel for default(shared)
+#endif
+    for (int i = 0; i < nthreads; i++)
+        scan_lines(chunk[i], chunk[i + 1], ns_gfc, lines + i);
+
+
+    return chunk[nthreads];
+}
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Reads the "gfc" file "pathname" up to degree "nmax" to "shcs" as described
+ * in "shc_read_gfc".
+ *
+ * If "tv" is not "NULL", "epoch" is ignored and only the time invariant
+ * coefficients are summed in "shcs".  The time variable terms are instead
+ * appended to "tv" in the order of the file, so that they can be evaluated
+ * later for any epoch without reading the file again.
+ *
+ * If "ranges" is not "NULL", only the lines inside "ranges" are read from the
+ * data section of the file.  Lines of orders with "NULL" rows in "shcs->c" are
+ * skipped.  Both are used by "mpi_shc_read_text", so that each MPI process
+ * parses only the lines of its local orders. */
+unsigned long CHARM(shc_read_gfc_core)(const char *pathname,
+                                       unsigned long nmax,
+                                       const char *epoch,
+                                       const CHARM(shc_ranges) *ranges,
+                                       CHARM(shc) *shcs,
+                                       CHARM(shc_tv) *tv,
+                                       CHARM(err) *err)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return CHARM_SHC_NMAX_ERROR;
+    }
+
+
+    if (!CHARM(shc_read_nmax_only)(nmax, shcs))
+    {
+        CHARM(shc_check_distribution)(shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return CHARM_SHC_NMAX_ERROR;
+        }
+
+
+        CHARM(shc_check_map)(shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return CHARM_SHC_NMAX_ERROR;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Open "pathname" to read */
+    /* --------------------------------------------------------------------- */
+    FILE *fptr = fopen(pathname, "r");
+    char err_msg[CHARM_ERR_MAX_MSG];
+    if (fptr == NULL)
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                          "Couldn't open \"%s\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       err_msg);
+        return CHARM_SHC_NMAX_ERROR;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    char line[NLINE];
+    char key_str[SCANF_BUFFER];
+    char val_str[SCANF_BUFFER];
+    REAL mu_file = PREC(0.0);
+    REAL r_file  = PREC(0.0);
+    unsigned long nmax_file = CHARM_SHC_NMAX_ERROR;
+
+
+    /* The data section of the file and the lines scanned by the individual
+     * threads */
+    CHARM(fmap) *fmap = NULL;
+    gfc_lines *lines  = NULL;
+#if HAVE_OPENMP
+    int nthreads = omp_get_max_threads();
+#else
+    int nthreads = 1;
+#endif
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Read the header of the "gfc" file */
+    /* --------------------------------------------------------------------- */
+    /* These variables are used to mark that a specific keyword of the "gfc"
+     * file has been found */
+    _Bool nmax_found, mu_found, r_found, errors_found, eoh_found, boh_found;
+    nmax_found = mu_found = r_found = errors_found = eoh_found = boh_found = 0;
+
+
+    /* These variables are set to true if the "begin_of_head" keyword was not
+     * found before reaching the keyword and an error was encountered when
+     * processing the value of that keyword.  This needed is because
+     * "begin_of_head" is not a mandatory keyword of "gfc" files, in which case
+     * the keywords have to be taken from the comments section.  But if
+     * "begin_of_head" will appear later, the error in conversion is not a real
+     * error, because it happened in the comments section. */
+    _Bool nmax_err, mu_err, r_err, errors_err, norm_err, format_err;
+    nmax_err = mu_err = r_err = errors_err = norm_err = format_err = 0;
+
+
+    /* These variables are used to store the value of the keyword that couldn't
+     * be processed if "nmax_err", "mu_err", ... are true */
+    char nmax_err_str[SCANF_BUFFER];
+    char mu_err_str[SCANF_BUFFER];
+    char r_err_str[SCANF_BUFFER];
+    char errors_err_str[SCANF_BUFFER];
+    char norm_err_str[SCANF_BUFFER];
+    char format_err_str[SCANF_BUFFER];
+
+
+    int ret;
+
+
+    /* Type of errors of "gfc" files. */
+    _Bool errors_no, errors_cal, errors_form, errors_cal_form;
+    errors_no = errors_cal = errors_form = errors_cal_form = 0;
+
+
+    _Bool icgem1d0, icgem2d0;
+    icgem1d0 = icgem2d0 = 0;
+
+
+    const char *wrong_value_of_keyword    = NULL;
+    const char *wrong_value_required_type = NULL;
+
+
+    do
+    {
+        /* Read a line of the file */
+        if (fgets(line, NLINE, fptr) == NULL)
+        {
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                             "Couldn't find the \"end_of_head\" keyword in "
+                             "\"%s\" or couldn't read the file.", pathname);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           err_msg);
+            goto EXIT;
+        }
+
+
+        /* Get the first two entries of "line" to test for the keywords of
+         * "gfc" files */
+        errno = 0;
+        ret = sscanf(line, SCANF_SFS(SCANF_WIDTH) " " SCANF_SFS(SCANF_WIDTH),
+                     key_str, val_str);
+        if (errno)
+        {
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                     "Couldn't read \"%s\" with \"sscanf\".", pathname);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           err_msg);
+            goto EXIT;
+        }
+
+
+        if ((ret == 0) || (ret == EOF))
+            continue;
+
+
+        /* Is this the line specifying the begin_of_head keyword? */
+        if (strcmp(key_str, SHC_READ_GFC_BOH) == 0)
+            boh_found = 1;
+        else
+            boh_found = 0;
+
+
+        /* Is this the line specifying the end_of_head keyword? */
+        if (strcmp(key_str, SHC_READ_GFC_EOH) == 0)
+            eoh_found = 1;
+        else
+            eoh_found = 0;
+
+
+        /* From now on, we are searching for a keyword and its value, so "ret"
+         * must be two */
+        if (ret != 2)
+            continue;
+
+
+        if (strcmp(key_str, SHC_READ_GFC_NMAX) == 0)
+        {
+            nmax_err  = 0;
+            nmax_file = CHARM(misc_str2ul)(val_str, "", err);
+            if (!CHARM(err_isempty)(err))
+            {
+                strcpy(nmax_err_str, val_str);
+                nmax_err = 1;
+                CHARM(err_reset)(err);
+            }
+
+
+            if (boh_found && nmax_err)
+            {
+FAILURE_NMAX:
+                wrong_value_required_type = "unsigned long int";
+                goto FAILURE_STR2NUM;
+            }
+            nmax_found = 1;
+        }
+        else if ((strcmp(key_str, SHC_READ_GFC_EARTH_GM) == 0) ||
+                 (strcmp(key_str, SHC_READ_GFC_GM) == 0))
+        {
+            mu_err   = 0;
+            mu_file  = CHARM(misc_str2real)(val_str, "", err);
+            if (!CHARM(err_isempty)(err))
+            {
+                strcpy(mu_err_str, val_str);
+                mu_err = 1;
+                CHARM(err_reset)(err);
+            }
+
+
+            if (boh_found && mu_err)
+            {
+FAILURE_MU:
+                wrong_value_required_type = "REAL";
+                goto FAILURE_STR2NUM;
+            }
+            mu_found = 1;
+        }
+        else if (strcmp(key_str, SHC_READ_GFC_R) == 0)
+        {
+            r_err   = 0;
+            r_file  = CHARM(misc_str2real)(val_str, "", err);
+            if (!CHARM(err_isempty)(err))
+            {
+                strcpy(r_err_str, val_str);
+                r_err = 1;
+                CHARM(err_reset)(err);
+            }
+
+
+            if (boh_found && r_err)
+            {
+FAILURE_R:
+                wrong_value_required_type = "REAL";
+                goto FAILURE_STR2NUM;
+            }
+            r_found = 1;
+        }
+        else if (strcmp(key_str, SHC_READ_GFC_ERRORS) == 0)
+        {
+            errors_err = 0;
+            if (strcmp(val_str, SHC_READ_GFC_ERRORS_NO) == 0)
+                errors_no = 1;
+            else if (strcmp(val_str, SHC_READ_GFC_ERRORS_CALIBRATED) == 0)
+                errors_cal = 1;
+            else if (strcmp(val_str, SHC_READ_GFC_ERRORS_FORMAL) == 0)
+                errors_form = 1;
+            else if (strcmp(val_str,
+                            SHC_READ_GFC_ERRORS_CALIBRATED_AND_FORMAL) == 0)
+                errors_cal_form = 1;
+            else
+            {
+                errors_err = 1;
+                strcpy(errors_err_str, val_str);
+                if (boh_found)
+                {
+FAILURE_ERRORS:
+                    wrong_value_of_keyword = SHC_READ_GFC_ERRORS;
+                    goto FAILURE_UNSUPPORTED_KEYWORD;
+                }
+            }
+            errors_found = 1;
+        }
+        else if (strcmp(key_str, SHC_READ_GFC_NORM) == 0)
+        {
+            norm_err = 0;
+            if (strcmp(val_str, SHC_READ_GFC_NORM_FULL) != 0)
+            {
+                norm_err = 1;
+                strcpy(norm_err_str, val_str);
+                if (boh_found)
+                {
+FAILURE_NORM:
+                    wrong_value_of_keyword = SHC_READ_GFC_NORM;
+                    goto FAILURE_UNSUPPORTED_KEYWORD;
+                }
+            }
+            /* "norm" is an optional keyword, so no "norm_found" here */
+        }
+        else if (strcmp(key_str, SHC_READ_GFC_FORMAT) == 0)
+        {
+            format_err = 0;
+            if (strcmp(val_str, SHC_READ_GFC_FORMAT1d0) == 0)
+                icgem1d0 = 1;
+            else if (strcmp(val_str, SHC_READ_GFC_FORMAT2d0) == 0)
+                icgem2d0 = 1;
+            else
+            {
+                format_err = 1;
+                strcpy(format_err_str, val_str);
+                if (boh_found)
+                {
+FAILURE_FORMAT:
+                    wrong_value_of_keyword = SHC_READ_GFC_FORMAT;
+                    goto FAILURE_UNSUPPORTED_KEYWORD;
+                }
+            }
+            /* "format" is an optional keyword, so no "format_found" here */
+        }
+
+    } while (!eoh_found);
+
+
+    /* Check whether all mandatory keywords were found */
+    const char *not_found_keyword = NULL;
+    if (!nmax_found)
+        not_found_keyword = SHC_READ_GFC_NMAX;
+    else if (!mu_found)
+        not_found_keyword = SHC_READ_GFC_ALL_GM_KEYWORDS;
+    else if (!r_found)
+        not_found_keyword = SHC_READ_GFC_R;
+    else if (!errors_found)
+        not_found_keyword = SHC_READ_GFC_ERRORS;
+    if (not_found_keyword != NULL)
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Couldn't find the \"%s\" keyword before reaching "
+                         "the \"%s\" keyword in \"%s\".",
+                not_found_keyword, SHC_READ_GFC_EOH, pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFILEIO, err_msg);
+        goto EXIT;
+    }
+
+
+    /* Now, after reading the comment and header sections, we have go back
+     * a bit and to check whether the values of the individual keywords were
+     * properly processed *if the "begin_of_head" keyword was *not* found*.
+     * This is because if "begin_of_head" was not found, we had to take the
+     * values from the comments section.  But in this case, we did not want to
+     * throw errors if the values were invalid, simply because the
+     * "begin_of_head" keyword might appear later, implying this was a comment
+     * section indeed.  This complicated procedure results from the definition
+     * of "gfc" files. */
+    if (!boh_found)
+    {
+        if (nmax_err)
+        {
+            strcpy(val_str, nmax_err_str);
+            strcpy(key_str, SHC_READ_GFC_NMAX);
+            goto FAILURE_NMAX;
+        }
+        else if (mu_err)
+        {
+            strcpy(val_str, mu_err_str);
+            strcpy(key_str, SHC_READ_GFC_ALL_GM_KEYWORDS);
+            goto FAILURE_MU;
+        }
+        else if (r_err)
+        {
+            strcpy(val_str, r_err_str);
+            strcpy(key_str, SHC_READ_GFC_R);
+            goto FAILURE_R;
+        }
+        else if (errors_err)
+        {
+            strcpy(val_str, errors_err_str);
+            strcpy(key_str, SHC_READ_GFC_ERRORS);
+            goto FAILURE_ERRORS;
+        }
+        else if (norm_err)
+        {
+            strcpy(val_str, norm_err_str);
+            strcpy(key_str, SHC_READ_GFC_NORM);
+            goto FAILURE_NORM;
+        }
+        else if (format_err)
+        {
+            strcpy(val_str, format_err_str);
+            strcpy(key_str, SHC_READ_GFC_FORMAT);
+            goto FAILURE_FORMAT;
+        }
+    }
+
+
+    if (CHARM(shc_read_nmax_only)(nmax, shcs))
+        goto EXIT;
+
+
+    shcs->mu = mu_file;
+    shcs->r  = r_file;
+
+
+    /* If "format" is not specified, default format is "icgem1.0" as per
+     * definition of "gfc". */
+    if (!icgem1d0 && !icgem2d0)
+        icgem1d0 = 1;
+
+
+    if (tv != NULL)
+        tv->icgem2d0 = icgem2d0;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Check "epoch" and convert it to a "REAL_EPOCH" data type */
+    /* --------------------------------------------------------------------- */
+    /* "epoch = NULL" is a valid input to "shc_gfc_epoch".  This case will be
+     * treated later. */
+    REAL_EPOCH t = CHARM(shc_gfc_epoch)(epoch, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+
+    /* Check maximum harmonic degrees */
+    /* --------------------------------------------------------------------- */
+    if (shcs->nmax < nmax)
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "\"shcs->nmax = %lu\" cannot be smaller than the "
+                         "input parameter \"nmax = %lu\".", shcs->nmax, nmax);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto EXIT;
+    }
+
+
+    if (nmax_file < nmax)
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Couldn't read coefficients up to degree "
+                         "\"nmax = %lu\", because the maximum degree in "
+                         "\"%s\" is \"%lu\" only.", nmax, pathname, nmax_file);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto EXIT;
+    }
+
+
+    if (icgem2d0 && (epoch == NULL) && (tv == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "\"epoch\" cannot be \"NULL\" for \"gfc\" files of the "
+                       "\"icgem2.0\" format.");
+        goto EXIT;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Read the table of spherical harmonic coefficients */
+    /* --------------------------------------------------------------------- */
+    int ns;
+    char s0[SCANF_BUFFER];
+    char s1[SCANF_BUFFER];
+    char s2[SCANF_BUFFER];
+    char s3[SCANF_BUFFER];
+    char s4[SCANF_BUFFER];
+    char s5[SCANF_BUFFER];
+    char s6[SCANF_BUFFER];
+    char s7[SCANF_BUFFER];
+    char s8[SCANF_BUFFER];
+    char s9[SCANF_BUFFER];
+    char s10[SCANF_BUFFER];
+    char s11[SCANF_BUFFER];
+
+
+    /* The "t0" and "t1" epochs loaded from the file as strings */
+    char *t0_str = NULL;
+    char *t1_str = NULL;
+
+
+    /* The "t0" and "t1" epochs as floating points */
+    REAL_EPOCH t0 = PREC(0.0);
+    REAL_EPOCH t1 = PREC(0.0);
+
+
+    /* The phase factor of the time variable coefficients as a floating point
+     * */
+    REAL p;
+
+
+    /* The phase factor of the time variable coefficients as a string */
+    char *p_str = NULL;
+
+
+    /* Useful substitutions */
+    const REAL twopi = PREC(2.0) * PI;
+    REAL tmp;
+    _Bool dot_found, trnd_found, asin_found, acos_found;
+    dot_found = trnd_found = asin_found = acos_found = 0;
+
+
+    /* If the format of the "gfc" file is "icgem1.0" and no epoch was specified
+     * by the user, then "icgem1d0_no_epoch" is set to true.  Otherwise, it is
+     * false.
+     *
+     * If "icgem1d0_no_epoch" is true, the default epoch for each coefficient
+     * is used */
+    _Bool icgem1d0_no_epoch = 0;
+    if (icgem1d0 && (epoch == NULL))
+        icgem1d0_no_epoch = 1;
+
+
+    /* At first, reset all coefficients in "shcs" to zero. */
+    CHARM(shc_reset_coeffs)(shcs);
+
+
+    unsigned long n, m, n_tmp, m_tmp;
+    n = m = n_tmp = m_tmp = 0;
+    REAL cnm, snm;
+    cnm = snm = PREC(0.0);
+
+
+    /* Type of the time variable term of the current line (see
+     * "shc_tv_struct.h") or "-1" for time invariant coefficients and the
+     * angular frequency of the "asin" and "acos" terms */
+    int term;
+    REAL omega = PREC(0.0);
+
+
+    /* The data section is memory-mapped (if possible) and processed in
+     * batches.  In each batch, the lines are at first scanned in parallel,
+     * which includes the conversion of the "SHC_READ_GFC_GFC" lines to
+     * numbers.  Then, the lines are processed serially in the order of the
+     * file, so that the checks of the time variable coefficients and the
+     * summation of the coefficients are the same as if the file was read line
+     * by line.  With "ranges", the whole file is mapped, so that the ranges
+     * can be located by their offsets from the beginning of the file. */
+    if (ranges != NULL)
+        rewind(fptr);
+    fmap = CHARM(misc_fmap)(fptr, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
+    }
+
+
+    lines = (gfc_lines *)calloc(nthreads, sizeof(gfc_lines));
+    if (lines == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto EXIT;
+    }
+    for (int i = 0; i < nthreads; i++)
+    {
+        lines[i].lines = (gfc_line *)malloc(NLINES_INIT * sizeof(gfc_line));
+        if (lines[i].lines == NULL)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto EXIT;
+        }
+        lines[i].nlines_max = NLINES_INIT;
+    }
+
+
+    /* Minimum number of entries of the "SHC_READ_GFC_GFC" lines to be
+     * processed by the fast code path (see the checks of the number of
+     * entries below) */
+    int ns_gfc = 4;
+    if (errors_cal || errors_form)
+        ns_gfc = 7;
+    if (errors_cal_form)
+        ns_gfc = 9;
+
+
+    /* Pointers to the entries of a line to be processed by the slow code
+     * path */
+    char *s_all[NENTRIES] = {s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10,
+                             s11};
+    const char *str[NENTRIES];
+    size_t nstr[NENTRIES];
+
+
+    const char *batch    = fmap->data;
+    const char *data_end = (batch == NULL) ? NULL : batch + fmap->size;
+    gfc_line *ln;
+
+
+    /* Index of the next range of "ranges".  With "ranges", the data section
+     * starts as empty, so that the first range is taken in the first loop
+     * run. */
+    size_t ir = 0;
+    if (ranges != NULL)
+        data_end = batch;
+
+
+    /* Index of the thread, the lines of which are being processed, and the
+     * index of the line */
+    int ith   = nthreads;
+    size_t il = 0;
+    for (;;)
+    {
+        /* Get the next line of the data section, scan the next batch if
+         * needed */
+        /* ----------------------------------------------------------------- */
+        while ((ith < nthreads) && (il == lines[ith].nlines))
+        {
+            ith++;
+            il = 0;
+        }
+
+
+        if (ith == nthreads)
+        {
+            if (batch == data_end)
+            {
+                if ((ranges == NULL) || (ir == ranges->n))
+                    break;
+
+
+                if (ranges->off[2 * ir + 1] > (uint64_t)fmap->size)
+                {
+                    CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                                   CHARM_EFILEIO,
+                                   "The byte range to be read exceeds the "
+                                   "size of the file.");
+                    goto EXIT;
+                }
+                batch    = fmap->data + ranges->off[2 * ir];
+                data_end = fmap->data + ranges->off[2 * ir + 1];
+                ir++;
+                continue;
+            }
+
+
+            batch = scan_batch(batch, data_end, ns_gfc, nthreads, lines);
+            for (int i = 0; i < nthreads; i++)
+            {
+                if (lines[i].failed)
+                {
+                    CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                                   CHARM_EMEM, CHARM_ERR_MALLOC_FAILURE);
+                    goto EXIT;
+                }
+            }
+
+
+            ith = 0;
+            il  = 0;
+            continue;
+        }
+
+
+        ln = lines[ith].lines + il++;
+        /* ----------------------------------------------------------------- */
+
+
+        if (ln->fast)
+        {
+            /* This code block does exactly the same as the slow code path
+             * below for "SHC_READ_GFC_GFC" lines, except that the entries
+             * have already been converted to numbers */
+            n = ln->n;
+            if (n > nmax)
+                continue;
+            m   = ln->m;
+            if (shcs->c[m] == NULL)
+                continue;
+            cnm = ln->c;
+            snm = ln->s;
+
+
+            shcs->c[m][n - m] += cnm;
+            shcs->s[m][n - m] += snm;
+            continue;
+        }
+
+
+        /* Copy the line and its entries to null-terminated strings */
+        memcpy(line, ln->line, ln->len);
+        line[ln->len] = '\0';
+        ns = split_line(line, ln->len, str, nstr);
+        for (int k = 0; k < ns; k++)
+        {
+            memcpy(s_all[k], str[k], nstr[k]);
+            s_all[k][nstr[k]] = '\0';
+        }
+
+
+        /* Check for the keyword and process "line" accordingly */
+        if (strcmp(s0, SHC_READ_GFC_GFC) == 0)
+        {
+            /* For "SHC_READ_GFC_GFC", the number of allowed values is 4, 6 or
+             * 8 according to the specification (5, 7 or 9 after adding the gfc
+             * keyword itself).  Interestingly, some older models available
+             * from "ICGEM" with "errors_no == 1" may have even only three
+             * values per line if "m == 0" which is why we accept "ns" to be
+             * also "4".  At this point, we do not know whether "m == 0" or "m
+             * != 0", so we have a wildcard for "ns != 4".  We do the check
+             * later because the value of "m" in "line" has not yet been
+             * determined. */
+            if ((errors_no && (ns < 4)) ||
+                ((errors_cal || errors_form) && (ns < 7)) ||
+                (errors_cal_form && (ns < 9)))
+            {
+                WRONG_NUMBER_OF_ENTRIES;
+            }
+
+
+            READ_DEG_ORD(n, s1, "degree", pathname);
+            if (n > nmax)
+                continue;
+            READ_DEG_ORD(m, s2, "order", pathname);
+            READ_CNM_SNM(cnm, s3, SHC_READ_GFC_GFC, n, m, pathname);
+            term = -1;
+            if (m == 0)
+                snm = PREC(0.0);
+            else
+            {
+                if (ns < 5)
+                {
+                    WRONG_NUMBER_OF_ENTRIES;
+                }
+
+
+                READ_CNM_SNM(snm, s4, SHC_READ_GFC_GFC, n, m, pathname);
+            }
+        }
+        else if (strcmp(s0, SHC_READ_GFC_GFCT) == 0)
+        {
+            if (icgem1d0)
+            {
+                if ((errors_no && (ns < 6)) ||
+                    ((errors_cal || errors_form) && (ns < 8)) ||
+                    (errors_cal_form && (ns < 10)))
+                {
+                    WRONG_NUMBER_OF_ENTRIES;
+                }
+            }
+            else if (icgem2d0)
+            {
+                if ((errors_no && (ns < 7)) ||
+                    ((errors_cal || errors_form) && (ns < 9)) ||
+                    (errors_cal_form && (ns < 11)))
+                {
+                    WRONG_NUMBER_OF_ENTRIES;
+                }
+            }
+
+
+            /* Get the degree and order values */
+            /* ------------------------------------------------------------- */
+            READ_DEG_ORD(n, s1, "degree", pathname);
+            if (n > nmax)
+                continue;
+            READ_DEG_ORD(m, s2, "order", pathname);
+            /* ------------------------------------------------------------- */
+
+
+            /* Get the epochs */
+            /* ------------------------------------------------------------- */
+            if (errors_no)
+                t0_str = s5;
+            else if (errors_cal || errors_form)
+                t0_str = s7;
+            else if (errors_cal_form)
+                t0_str = s9;
+
+
+            t0 = CHARM(shc_gfc_epoch)(t0_str, err);
+            if (!CHARM(err_isempty)(err))
+            {
+                CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                goto EXIT;
+            }
+
+
+            if (icgem2d0)
+            {
+                if (errors_no)
+                    t1_str = s6;
+                else if (errors_cal || errors_form)
+                    t1_str = s8;
+                else if (errors_cal_form)
+                    t1_str = s10;
+
+
+                t1 = CHARM(shc_gfc_epoch)(t1_str, err);
+                if (!CHARM(err_isempty)(err))
+                {
+                    CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                    goto EXIT;
+                }
+
+
+                if ((tv == NULL) && !is_within_time_period(t, t0, t1))
+                    continue;
+            }
+            /* ------------------------------------------------------------- */
+
+
+            /* This code block needs to be placed after the check
+             * "is_within_time_period" */
+            if (trnd_found && dot_found)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO, "");
+                goto EXIT;
+            }
+            else if ((trnd_found || dot_found) && asin_found && acos_found)
+                /* All keywords associated with "gfct" were found, so reset
+                 * reset some variables to false, so that we can continue
+                 * reading */
+                trnd_found = dot_found = asin_found = acos_found = 0;
+            else if (trnd_found || dot_found || asin_found || acos_found)
+            {
+                remove_new_line_char(line);
+                snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                        "Wrong format of \"%s\".  At least one of "
+                        "the following keywords was found before reaching the "
+                        "\"%s\" keyword or is missing: \"%s\", \"%s\", "
+                        "\"%s\", \"%s\".  Stopped reading at line: \"%s\".",
+                        pathname, SHC_READ_GFC_GFCT, SHC_READ_GFC_TRND,
+                        SHC_READ_GFC_DOT, SHC_READ_GFC_ASIN,
+                        SHC_READ_GFC_ACOS, line);
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO, err_msg);
+                goto EXIT;
+            }
+
+
+            /* Get the coefficients */
+            READ_CNM_SNM(cnm, s3, SHC_READ_GFC_GFCT, n, m, pathname);
+            READ_CNM_SNM(snm, s4, SHC_READ_GFC_GFCT, n, m, pathname);
+            term = (icgem2d0) ? SHC_TV_GFCT : -1;
+
+
+            trnd_found = dot_found = asin_found = acos_found = 0;
+        }
+        else if ((strcmp(s0, SHC_READ_GFC_TRND) == 0) ||
+                 (strcmp(s0, SHC_READ_GFC_DOT) == 0))
+        {
+            if (icgem1d0)
+            {
+                if ((errors_no && (ns < 5)) ||
+                    ((errors_cal || errors_form) && (ns < 7)) ||
+                    (errors_cal_form && (ns < 9)))
+                {
+                    WRONG_NUMBER_OF_ENTRIES;
+                }
+            }
+            else if (icgem2d0)
+            {
+                if ((errors_no && (ns < 7)) ||
+                    ((errors_cal || errors_form) && (ns < 9)) ||
+                    (errors_cal_form && (ns < 11)))
+                {
+                    WRONG_NUMBER_OF_ENTRIES;
+                }
+            }
+
+
+            /* Get the degree and order values */
+            /* ------------------------------------------------------------- */
+            READ_DEG_ORD(n_tmp, s1, "degree", pathname);
+            if (n_tmp > nmax)
+                continue;
+            READ_DEG_ORD(m_tmp, s2, "order", pathname);
+            EXPECTED_DEGREE_ORDER(s0, n, m, pathname, n_tmp, m_tmp, s3, s4);
+            /* ------------------------------------------------------------- */
+
+
+            /* Get the epoch.  For the "icgem1.0" format, the "t0" value is
+             * taken from the previous loop run.  For "icgem2.0", the "t0" and
+             * "t1" values are taken from the current line of the file. */
+            if (icgem2d0)
+            {
+                if (errors_no)
+                {
+                    t0_str = s5;
+                    t1_str = s6;
+                }
+                else if (errors_cal || errors_form)
+                {
+                    t0_str = s7;
+                    t1_str = s8;
+                }
+                else if (errors_cal_form)
+                {
+                    t0_str = s9;
+                    t1_str = s10;
+                }
+
+
+                t0 = CHARM(shc_gfc_epoch)(t0_str, err);
+                if (!CHARM(err_isempty)(err))
+                {
+                    CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                    goto EXIT;
+                }
+                t1 = CHARM(shc_gfc_epoch)(t1_str, err);
+                if (!CHARM(err_isempty)(err))
+                {
+                    CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                    goto EXIT;
+                }
+
+
+                if ((tv == NULL) && !is_within_time_period(t, t0, t1))
+                    continue;
+            }
+
+
+            if (strcmp(s0, SHC_READ_GFC_DOT) == 0)
+            {
+                READ_CNM_SNM(cnm, s3, SHC_READ_GFC_DOT, n, m, pathname);
+                READ_CNM_SNM(snm, s4, SHC_READ_GFC_DOT, n, m, pathname);
+            }
+            else
+            {
+                READ_CNM_SNM(cnm, s3, SHC_READ_GFC_TRND, n, m, pathname);
+                READ_CNM_SNM(snm, s4, SHC_READ_GFC_TRND, n, m, pathname);
+            }
+
+
+            term = SHC_TV_TRND;
+            if (tv == NULL)
+            {
+                if (icgem1d0_no_epoch)
+                    t = t0;
+                tmp  = epoch_diff(t, t0);
+                cnm *= tmp;
+                snm *= tmp;
+            }
+
+
+            if (strcmp(s0, SHC_READ_GFC_DOT) == 0)
+            {
+                /* The "dot" keyword is not associated with the "asin" and
+                 * "acos" terms.  Here, this can be easily solved if we pretend
+                 * that we have already found "asin" and "acos", so that we can
+                 * continue in reading the file */
+                dot_found = asin_found = acos_found = 1;
+            }
+            else
+                trnd_found = 1;
+        }
+        else if ((strcmp(s0, SHC_READ_GFC_ASIN) == 0) ||
+                 (strcmp(s0, SHC_READ_GFC_ACOS) == 0))
+        {
+            if (icgem1d0)
+            {
+                if ((errors_no && (ns < 6)) ||
+                    ((errors_cal || errors_form) && (ns < 8)) ||
+                    (errors_cal_form && (ns < 10)))
+                {
+                    WRONG_NUMBER_OF_ENTRIES;
+                }
+            }
+            else if (icgem2d0)
+            {
+                if ((errors_no && (ns < 8)) ||
+                    ((errors_cal || errors_form) && (ns < 10)) ||
+                    (errors_cal_form && (ns < 12)))
+                {
+                    WRONG_NUMBER_OF_ENTRIES;
+                }
+            }
+
+
+            /* Get the degree and order values */
+            /* ------------------------------------------------------------- */
+            READ_DEG_ORD(n_tmp, s1, "degree", pathname);
+            if (n_tmp > nmax)
+                continue;
+            READ_DEG_ORD(m_tmp, s2, "order", pathname);
+            EXPECTED_DEGREE_ORDER(s0, n, m, pathname, n_tmp, m_tmp, s3, s4);
+            /* ------------------------------------------------------------- */
+
+
+            /* Get the epoch.  For the "icgem1.0" format, the "t0" value is
+             * taken from the previous loop run.  For "icgem2.0", the "t0" and
+             * "t1" values are taken from the current line of the file. */
+            if (icgem2d0)
+            {
+                if (errors_no)
+                {
+                    t0_str = s5;
+                    t1_str = s6;
+                }
+                else if (errors_cal || errors_form)
+                {
+                    t0_str = s7;
+                    t1_str = s8;
+                }
+                else if (errors_cal_form)
+                {
+                    t0_str = s9;
+                    t1_str = s10;
+                }
+
+
+                t0 = CHARM(shc_gfc_epoch)(t0_str, err);
+                if (!CHARM(err_isempty)(err))
+                {
+                    CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                    goto EXIT;
+                }
+                t1 = CHARM(shc_gfc_epoch)(t1_str, err);
+                if (!CHARM(err_isempty)(err))
+                {
+                    CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                    goto EXIT;
+                }
+
+
+                if ((tv == NULL) && !is_within_time_period(t, t0, t1))
+                    continue;
+            }
+
+
+            if (strcmp(s0, SHC_READ_GFC_ASIN) == 0)
+            {
+                READ_CNM_SNM(cnm, s3, SHC_READ_GFC_ASIN, n, m, pathname);
+                READ_CNM_SNM(snm, s4, SHC_READ_GFC_ASIN, n, m, pathname);
+            }
+            else
+            {
+                READ_CNM_SNM(cnm, s3, SHC_READ_GFC_ACOS, n, m, pathname);
+                READ_CNM_SNM(snm, s4, SHC_READ_GFC_ACOS, n, m, pathname);
+            }
+
+
+            /* Get the phase factor */
+            if (icgem1d0)
+            {
+                if (errors_no)
+                    p_str = s5;
+                else if (errors_cal || errors_form)
+                    p_str = s7;
+                else if (errors_cal_form)
+                    p_str = s9;
+            }
+            else if (icgem2d0)
+            {
+                if (errors_no)
+                    p_str = s7;
+                else if (errors_cal || errors_form)
+                    p_str = s9;
+                else if (errors_cal_form)
+                    p_str = s11;
+            }
+            p = CHARM(misc_str2real)(p_str, "", err);
+            if (!CHARM(err_isempty)(err))
+            {
+                snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                                 "Failed to convert the phase factor \"%s\" "
+                                 "of time variable coefficients of degree "
+                                 "\"%lu\" and order \"%lu\" from \"%s\" "
+                                 "to a \"REAL\" data format.", p_str, n, m,
+                                 pathname);
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO, err_msg);
+                goto EXIT;
+            }
+
+
+            omega = twopi / p;
+            if (strcmp(s0, SHC_READ_GFC_ASIN) == 0)
+            {
+                term       = SHC_TV_ASIN;
+                asin_found = 1;
+            }
+            else
+            {
+                term       = SHC_TV_ACOS;
+                acos_found = 1;
+            }
+
+
+            if (tv == NULL)
+            {
+                if (icgem1d0_no_epoch)
+                    t = t0;
+                tmp = epoch_diff(t, t0);
+                tmp = omega * tmp;
+                tmp = (term == SHC_TV_ASIN) ? SIN(tmp) : COS(tmp);
+                cnm *= tmp;
+                snm *= tmp;
+            }
+        }
+        else
+            /* Lines starting with any other keyword are comments, so should be
+             * skipped */
+            continue;
+
+
+        if ((tv != NULL) && (term >= 0))
+        {
+            CHARM(shc_tv_add_term)(tv, (unsigned char)term, n, m, cnm, snm,
+                                   t0, t1, omega, err);
+            if (!CHARM(err_isempty)(err))
+            {
+                CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                goto EXIT;
+            }
+            continue;
+        }
+
+
+        if (shcs->c[m] == NULL)
+            continue;
+
+
+        shcs->c[m][n - m] += cnm;
+        shcs->s[m][n - m] += snm;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+EXIT:
+    if (lines != NULL)
+        for (int i = 0; i < nthreads; i++)
+            free(lines[i].lines);
+    free(lines);
+    CHARM(misc_funmap)(fmap);
+    fclose(fptr);
+    return nmax_file;
+
+
+FAILURE_STR2NUM:
+    CHARM(err_reset)(err);
+    snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                     "Failed to convert the \"%s\" value of the \"%s\" "
+                     "keyword from \"%s\" to the \"%s\" "
+                     "data format.", val_str, key_str, pathname,
+                     wrong_value_required_type);
+    CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO, err_msg);
+    goto EXIT;
+
+
+FAILURE_UNSUPPORTED_KEYWORD:
+    snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                     "\"%s\" is not a supported value of the \"%s\" keyword "
+                     "in \"%s\".", val_str, wrong_value_of_keyword, pathname);
+    CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                   CHARM_EFILEIO, err_msg);
+    goto EXIT;
+}
@@ -0,0 +1,33 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_READ_GFC_CORE_H__
+#define __SHC_READ_GFC_CORE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shc_ranges_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern unsigned long CHARM(shc_read_gfc_core)(const char *,
+                                              unsigned long,
+                                              const char *,
+                                              const CHARM(shc_ranges) *,
+                                              CHARM(shc) *,
+                                              CHARM(shc_tv) *,
+                                              CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
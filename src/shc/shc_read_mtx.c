@@ -9,6 +9,7 @@
 #include "shc_read_mtdt.h"
 #include "shc_read_nmax_only.h"
 #include "shc_check_distribution.h"
+#include "shc_check_map.h"
 #include "../misc/misc_scanf.h"
 #include "../misc/misc_str2real.h"
 #include "../err/err_set.h"
@@ -54,6 +55,14 @@ unsigned long CHARM(shc_read_mtx)(const char *pathname,
             CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
             return CHARM_SHC_NMAX_ERROR;
         }
+
+
+        CHARM(shc_check_map)(shcs, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return CHARM_SHC_NMAX_ERROR;
+        }
     }
     /* ===================================================================== */
 
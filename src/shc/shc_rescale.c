@@ -5,6 +5,11 @@
 #include <stdlib.h>
 #include "../prec.h"
 #include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "shc_check_lazy.h"
+#include "shc_check_view.h"
+#include "shc_check_map.h"
+#include "shc_arithmetics_row.h"
 /* ------------------------------------------------------------------------- */
 
 
@@ -26,6 +31,15 @@ void CHARM(shc_rescale)(CHARM(shc) *shcs,
                         REAL rnew,
                         CHARM(err) *err)
 {
+    if (CHARM(shc_check_lazy)(shcs, err) ||
+        CHARM(shc_check_view)(shcs, err) ||
+        CHARM(shc_check_map)(shcs, err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
     /* Pre-computations */
     /* --------------------------------------------------------------------- */
     const REAL mu_ratio = shcs->mu / munew;
@@ -64,13 +78,21 @@ void CHARM(shc_rescale)(CHARM(shc) *shcs,
 
     for (size_t k = 0; k < nchunk; k++)
     {
-        for (unsigned long m = orders[2 * k]; m <= orders[2 * k + 1]; m++)
+        /* Each order is a contiguous row of degrees "m, ..., nmax", which is
+         * multiplied by the corresponding part of "tmp" */
+        const unsigned long m0 = orders[2 * k];
+        const unsigned long m1 = orders[2 * k + 1];
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) shared(shcs, tmp, m0, m1) \
+schedule(dynamic)
+#endif
+        for (unsigned long m = m0; m <= m1; m++)
         {
-            for (unsigned long n = m; n <= shcs->nmax; n++)
-            {
-                shcs->c[m][n - m] *= tmp[n];
-                shcs->s[m][n - m] *= tmp[n];
-            }
+            size_t len = shcs->nmax - m + 1;
+            CHARM(shc_arithmetics_row)(SHC_ROW_MUL, len, shcs->c[m], tmp + m,
+                                       PREC(0.0), shcs->c[m]);
+            CHARM(shc_arithmetics_row)(SHC_ROW_MUL, len, shcs->s[m], tmp + m,
+                                       PREC(0.0), shcs->s[m]);
         }
     }
 
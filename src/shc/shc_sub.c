@@ -7,6 +7,8 @@
 #include "../err/err_set.h"
 #include "../err/err_propagate.h"
 #include "shc_arithmetics_checks.h"
+#include "shc_arithmetics_row.h"
+#include "shc_arithmetics_order.h"
 /* ------------------------------------------------------------------------- */
 
 
@@ -33,39 +35,16 @@ void CHARM(shc_sub)(CHARM(shc) *rop,
 
 
     /* --------------------------------------------------------------------- */
-    unsigned long nmm;
-    _Bool ngtop1, ngtop2;
+    /* The orders are independent of each other, so they are distributed among
+     * the threads.  The lengths of the orders decrease with "m", hence the
+     * dynamic schedule. */
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) shared(rop, op1, op2, nmin, nmax) \
+schedule(dynamic)
+#endif
     for (unsigned long m = 0; m <= nmax; m++)
-    {
-        for (unsigned long n = CHARM_MAX(nmin, m); n <= nmax; n++)
-        {
-            nmm = n - m;
-            ngtop1 = n > op1->nmax;
-            ngtop2 = n > op2->nmax;
-
-
-            if (ngtop1 && ngtop2)
-            {
-                rop->c[m][nmm] = PREC(0.0);
-                rop->s[m][nmm] = PREC(0.0);
-            }
-            else if (ngtop1)
-            {
-                rop->c[m][nmm] = -op2->c[m][nmm];
-                rop->s[m][nmm] = -op2->s[m][nmm];
-            }
-            else if (ngtop2)
-            {
-                rop->c[m][nmm] = op1->c[m][nmm];
-                rop->s[m][nmm] = op1->s[m][nmm];
-            }
-            else
-            {
-                rop->c[m][nmm] = op1->c[m][nmm] - op2->c[m][nmm];
-                rop->s[m][nmm] = op1->s[m][nmm] - op2->s[m][nmm];
-            }
-        }
-    }
+        CHARM(shc_arithmetics_order)(SHC_ROW_SUB, op1, op2, m, nmin, nmax,
+                                     rop);
     /* --------------------------------------------------------------------- */
 
 
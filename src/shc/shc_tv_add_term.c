@@ -0,0 +1,94 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "shc_read_gfc.h"
+#include "shc_tv_struct.h"
+#include "shc_tv_add_term.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Initial number of terms that can be stored in "charm_shc_tv".  If needed,
+ * the number is doubled. */
+#undef NTERMS_INIT
+#define NTERMS_INIT (1024)
+
+
+
+
+
+
+/* Reallocates "*ptr" to "n" elements of "size" bytes.  On failure, "*ptr" is
+ * not modified and "1" is returned. */
+static _Bool grow(void **ptr,
+                  size_t n,
+                  size_t size)
+{
+    void *tmp = realloc(*ptr, n * size);
+    if (tmp == NULL)
+        return 1;
+    *ptr = tmp;
+
+
+    return 0;
+}
+
+
+
+
+
+
+/* Appends the time variable term of the type "type" (see "shc_tv_struct.h")
+ * with the coefficients "c" and "s" of degree "n" and order "m" to "tv" */
+void CHARM(shc_tv_add_term)(CHARM(shc_tv) *tv,
+                            unsigned char type,
+                            unsigned long n,
+                            unsigned long m,
+                            REAL c,
+                            REAL s,
+                            REAL_EPOCH t0,
+                            REAL_EPOCH t1,
+                            REAL omega,
+                            CHARM(err) *err)
+{
+    if (tv->nterms == tv->nterms_max)
+    {
+        size_t nmax = (tv->nterms_max == 0) ? NTERMS_INIT :
+                                              2 * tv->nterms_max;
+        if (grow((void **)&tv->type,  nmax, sizeof(unsigned char)) ||
+            grow((void **)&tv->n,     nmax, sizeof(unsigned long)) ||
+            grow((void **)&tv->m,     nmax, sizeof(unsigned long)) ||
+            grow((void **)&tv->c,     nmax, sizeof(REAL)) ||
+            grow((void **)&tv->s,     nmax, sizeof(REAL)) ||
+            grow((void **)&tv->t0,    nmax, sizeof(REAL_EPOCH)) ||
+            grow((void **)&tv->t1,    nmax, sizeof(REAL_EPOCH)) ||
+            grow((void **)&tv->omega, nmax, sizeof(REAL)))
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            return;
+        }
+        tv->nterms_max = nmax;
+    }
+
+
+    size_t k     = tv->nterms++;
+    tv->type[k]  = type;
+    tv->n[k]     = n;
+    tv->m[k]     = m;
+    tv->c[k]     = c;
+    tv->s[k]     = s;
+    tv->t0[k]    = t0;
+    tv->t1[k]    = t1;
+    tv->omega[k] = omega;
+
+
+    return;
+}
@@ -0,0 +1,36 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_TV_ADD_TERM_H__
+#define __SHC_TV_ADD_TERM_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shc_read_gfc.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_tv_add_term)(CHARM(shc_tv) *,
+                                   unsigned char,
+                                   unsigned long,
+                                   unsigned long,
+                                   REAL,
+                                   REAL,
+                                   REAL_EPOCH,
+                                   REAL_EPOCH,
+                                   REAL,
+                                   CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,180 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+#include "shc_reset_coeffs.h"
+#include "shc_check_distribution.h"
+#include "shc_read_gfc.h"
+#include "shc_gfc_epoch.h"
+#include "shc_tv_struct.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Evaluates "tv" at the epoch "t" (fraction of a year) and stores the
+ * coefficients in "shcs".  If "no_epoch" is "1", each term is evaluated at
+ * its reference epoch (the "epoch = NULL" case of "icgem1.0" files in
+ * "shc_read_gfc").  The arithmetic operations are the same and in the same
+ * order as in "shc_read_gfc", so the coefficients are the same, too. */
+static void eval_epoch(const CHARM(shc_tv) *tv,
+                       REAL_EPOCH t,
+                       _Bool no_epoch,
+                       CHARM(shc) *shcs)
+{
+    const CHARM(shc) *shcs_tv = tv->shcs;
+    unsigned long nmax = shcs_tv->nmax;
+
+
+    CHARM(shc_reset_coeffs)(shcs);
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        memcpy(shcs->c[m], shcs_tv->c[m], (nmax + 1 - m) * sizeof(REAL));
+        memcpy(shcs->s[m], shcs_tv->s[m], (nmax + 1 - m) * sizeof(REAL));
+    }
+    shcs->mu = shcs_tv->mu;
+    shcs->r  = shcs_tv->r;
+
+
+    REAL cnm, snm, tmp;
+    REAL_EPOCH tk;
+    unsigned long n, m;
+    for (size_t k = 0; k < tv->nterms; k++)
+    {
+        if (tv->icgem2d0 && !((t >= tv->t0[k]) && (t < tv->t1[k])))
+            continue;
+
+
+        cnm = tv->c[k];
+        snm = tv->s[k];
+        if (tv->type[k] != SHC_TV_GFCT)
+        {
+            tk  = (no_epoch) ? tv->t0[k] : t;
+            tmp = (REAL)(tk - tv->t0[k]);
+            if (tv->type[k] == SHC_TV_ASIN)
+                tmp = SIN(tv->omega[k] * tmp);
+            else if (tv->type[k] == SHC_TV_ACOS)
+                tmp = COS(tv->omega[k] * tmp);
+            cnm *= tmp;
+            snm *= tmp;
+        }
+
+
+        n = tv->n[k];
+        m = tv->m[k];
+        shcs->c[m][n - m] += cnm;
+        shcs->s[m][n - m] += snm;
+    }
+
+
+    return;
+}
+
+
+
+
+
+
+void CHARM(shc_tv_eval)(const CHARM(shc_tv) *tv,
+                        const char **epochs,
+                        size_t nepochs,
+                        CHARM(shc) **shcs,
+                        CHARM(err) *err)
+{
+    /* Check the inputs */
+    /* --------------------------------------------------------------------- */
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
+    if (nepochs == 0)
+        return;
+
+
+    char err_msg[CHARM_ERR_MAX_MSG];
+    for (size_t k = 0; k < nepochs; k++)
+    {
+        if (CHARM(shc_check_distribution)(shcs[k], err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return;
+        }
+
+
+        if (shcs[k]->nmax < tv->shcs->nmax)
+        {
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                     "\"shcs[%zu]->nmax = %lu\" cannot be smaller than the "
+                     "maximum harmonic degree of the time variable model "
+                     "\"%lu\".", k, shcs[k]->nmax, tv->shcs->nmax);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           err_msg);
+            return;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* Convert the epochs to fractions of a year */
+    /* --------------------------------------------------------------------- */
+    REAL_EPOCH *t = (REAL_EPOCH *)malloc(nepochs * sizeof(REAL_EPOCH));
+    if (t == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        return;
+    }
+
+
+    for (size_t k = 0; k < nepochs; k++)
+    {
+        if (tv->icgem2d0 && (epochs[k] == NULL))
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           "\"epoch\" cannot be \"NULL\" for \"gfc\" files of "
+                           "the \"icgem2.0\" format.");
+            goto EXIT;
+        }
+
+
+        t[k] = CHARM(shc_gfc_epoch)(epochs[k], err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* The epochs are independent of each other, so they are evaluated in
+     * parallel */
+    /* --------------------------------------------------------------------- */
+#if HAVE_OPENMP
+#pragma omp parallel for default(shared) schedule(dynamic)
+#endif
+    for (size_t k = 0; k < nepochs; k++)
+        eval_epoch(tv, t[k], epochs[k] == NULL, shcs[k]);
+    /* --------------------------------------------------------------------- */
+
+
+EXIT:
+    free(t);
+    return;
+}
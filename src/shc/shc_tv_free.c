@@ -0,0 +1,34 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "shc_tv_struct.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(shc_tv_free)(CHARM(shc_tv) *tv)
+{
+    if (tv == NULL)
+        return;
+
+
+    CHARM(shc_free)(tv->shcs);
+    free(tv->type);
+    free(tv->n);
+    free(tv->m);
+    free(tv->c);
+    free(tv->s);
+    free(tv->t0);
+    free(tv->t1);
+    free(tv->omega);
+    free(tv);
+
+
+    return;
+}
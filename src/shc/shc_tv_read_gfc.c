@@ -0,0 +1,79 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+#include "shc_read_gfc_core.h"
+#include "shc_tv_struct.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+CHARM(shc_tv) *CHARM(shc_tv_read_gfc)(const char *pathname,
+                                      unsigned long nmax,
+                                      CHARM(err) *err)
+{
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return NULL;
+    }
+
+
+    /* Get the maximum harmonic degree of the file if requested */
+    if (nmax == CHARM_SHC_NMAX_MODEL)
+    {
+        nmax = CHARM(shc_read_gfc_core)(pathname, CHARM_SHC_NMAX_MODEL, NULL,
+                                        NULL, NULL, NULL, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return NULL;
+        }
+    }
+
+
+    CHARM(shc_tv) *tv = (CHARM(shc_tv) *)calloc(1, sizeof(CHARM(shc_tv)));
+    if (tv == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        return NULL;
+    }
+
+
+    tv->shcs = CHARM(shc_calloc)(nmax, PREC(1.0), PREC(1.0));
+    if (tv->shcs == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE;
+    }
+
+
+    /* Sum the time invariant coefficients in "tv->shcs" and collect the time
+     * variable terms */
+    CHARM(shc_read_gfc_core)(pathname, nmax, NULL, NULL, tv->shcs, tv,
+                             err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto FAILURE;
+    }
+
+
+    return tv;
+
+
+FAILURE:
+    CHARM(shc_tv_free)(tv);
+    return NULL;
+}
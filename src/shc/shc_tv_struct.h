@@ -0,0 +1,76 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_TV_STRUCT_H__
+#define __SHC_TV_STRUCT_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shc_read_gfc.h"
+
+
+/* Types of the time variable terms */
+/* ------------------------------------------------------------------------- */
+/* "gfct" coefficients valid within the "t0 <= t < t1" period ("icgem2.0"
+ * only; the "gfct" coefficients of "icgem1.0" are time invariant) */
+#undef SHC_TV_GFCT
+#define SHC_TV_GFCT (0)
+
+
+/* "trnd" or "dot" coefficients multiplied by "t - t0" */
+#undef SHC_TV_TRND
+#define SHC_TV_TRND (1)
+
+
+/* "asin" coefficients multiplied by "sin(omega * (t - t0))" */
+#undef SHC_TV_ASIN
+#define SHC_TV_ASIN (2)
+
+
+/* "acos" coefficients multiplied by "cos(omega * (t - t0))" */
+#undef SHC_TV_ACOS
+#define SHC_TV_ACOS (3)
+/* ------------------------------------------------------------------------- */
+
+
+/* Structure holding a time variable model of spherical harmonic coefficients
+ * parsed from a "gfc" file.  The structure is opaque to the user
+ * ("charm_shc_tv"). */
+struct CHARM(shc_tv)
+{
+    /* Sum of all time invariant coefficients ("gfc" and, in "icgem1.0",
+     * "gfct"), including "mu" and "r" */
+    CHARM(shc) *shcs;
+
+
+    /* "1" if the file is of the "icgem2.0" format, in which case the terms
+     * are valid only within the "t0[k] <= t < t1[k]" periods */
+    _Bool icgem2d0;
+
+
+    /* Number of the time variable terms and the number of terms that can be
+     * stored in the arrays below without reallocation */
+    size_t nterms;
+    size_t nterms_max;
+
+
+    /* The "k"th term is of the type "type[k]" (one of "SHC_TV_GFCT", ...),
+     * belongs to the coefficients of degree "n[k]" and order "m[k]", its
+     * coefficients are "c[k]" and "s[k]" and the reference epoch is "t0[k]".
+     * "t1[k]" is used in "icgem2.0" only and "omega[k]" (the angular frequency
+     * "2 * pi / period") with "SHC_TV_ASIN" and "SHC_TV_ACOS" only.  The terms
+     * are stored in the order of the file, so that they are summed in the
+     * same order as in "shc_read_gfc". */
+    unsigned char *type;
+    unsigned long *n;
+    unsigned long *m;
+    REAL *c;
+    REAL *s;
+    REAL_EPOCH *t0;
+    REAL_EPOCH *t1;
+    REAL *omega;
+};
+
+
+#endif
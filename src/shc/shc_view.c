@@ -0,0 +1,124 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE_MPI
+#   include <mpi.h>
+#endif
+#include "../prec.h"
+#include "shc_view_info.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+CHARM(shc) *CHARM(shc_view)(const CHARM(shc) *shcs,
+                            unsigned long nmin,
+                            unsigned long nmax,
+                            unsigned long mmin,
+                            unsigned long mmax)
+{
+    if (nmax > shcs->nmax)
+        return NULL;
+
+
+    if (nmin > nmax)
+        return NULL;
+
+
+    if (mmin > mmax)
+        return NULL;
+
+
+    if (mmax > nmax)
+        return NULL;
+
+
+    if (shcs->distributed || (shcs->lazy != NULL))
+        return NULL;
+
+
+    CHARM(shc) *view = (CHARM(shc) *)malloc(sizeof(CHARM(shc)));
+    if (view == NULL)
+        return NULL;
+
+
+    CHARM(shc_view_info) *info = (CHARM(shc_view_info) *)malloc(
+                                               sizeof(CHARM(shc_view_info)));
+    if (info == NULL)
+    {
+        free(view);
+        return NULL;
+    }
+
+
+    /* The view of a view refers directly to the structure that stores the
+     * coefficients and its slice is the intersection of both slices */
+    if (shcs->view != NULL)
+    {
+        const CHARM(shc_view_info) *parent =
+                                  (const CHARM(shc_view_info) *)shcs->view;
+        info->nmax_data = parent->nmax_data;
+        info->nc_data   = parent->nc_data;
+        info->nmin      = CHARM_MAX(nmin, parent->nmin);
+        info->mmin      = CHARM_MAX(mmin, parent->mmin);
+        info->mmax      = CHARM_MIN(mmax, parent->mmax);
+    }
+    else
+    {
+        info->nmax_data = shcs->nmax;
+        info->nc_data   = shcs->nc;
+        info->nmin      = nmin;
+        info->mmin      = mmin;
+        info->mmax      = mmax;
+    }
+
+
+    /* An empty intersection of the slices is rejected in the same way as an
+     * empty slice */
+    if ((info->nmin > nmax) || (info->mmin > info->mmax))
+    {
+        free(info);
+        free(view);
+        return NULL;
+    }
+
+
+    /* The pointer arrays "shcs->c" and "shcs->s" are shared with "shcs", so
+     * no coefficients are copied.  "view->c[m][n - m]" is therefore
+     * "shcs->c[m][n - m]" for all "m <= n <= nmax". */
+    size_t nmax1 = (size_t)nmax + 1;
+    view->nmax        = nmax;
+    view->mu          = shcs->mu;
+    view->r           = shcs->r;
+    view->nc          = ((nmax1 + 1) * nmax1) / 2;
+    view->ns          = view->nc;
+    view->c           = shcs->c;
+    view->s           = shcs->s;
+    view->owner       = 0;
+    view->distributed = 0;
+    view->map         = NULL;
+    view->lazy        = NULL;
+    view->view        = info;
+#if HAVE_MPI
+    view->local_nc     = view->nc;
+    view->local_ns     = view->ns;
+    view->local_nchunk = 1;
+    view->comm         = MPI_COMM_NULL;
+    view->local_order  = (unsigned long *)malloc(2 * sizeof(unsigned long));
+    if (view->local_order == NULL)
+    {
+        free(info);
+        free(view);
+        return NULL;
+    }
+    view->local_order[0] = 0;
+    view->local_order[1] = nmax;
+#endif
+
+
+    return view;
+}
@@ -0,0 +1,41 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "shc_view_info.h"
+#include "shc_view_get_range.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns the minimum degree "nmin", the minimum order "mmin" and the maximum
+ * order "mmax" of the coefficients of "shcs" that are not treated as zeros.
+ * Unless "shcs" was returned by "shc_view", these are "0", "0" and
+ * "shcs->nmax", respectively. */
+void CHARM(shc_view_get_range)(const CHARM(shc) *shcs,
+                               unsigned long *nmin,
+                               unsigned long *mmin,
+                               unsigned long *mmax)
+{
+    if (shcs->view == NULL)
+    {
+        *nmin = 0;
+        *mmin = 0;
+        *mmax = shcs->nmax;
+        return;
+    }
+
+
+    const CHARM(shc_view_info) *view =
+                                  (const CHARM(shc_view_info) *)shcs->view;
+    *nmin = view->nmin;
+    *mmin = view->mmin;
+    *mmax = view->mmax;
+
+
+    return;
+}
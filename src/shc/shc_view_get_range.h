@@ -0,0 +1,29 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_VIEW_GET_RANGE_H__
+#define __SHC_VIEW_GET_RANGE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_view_get_range)(const CHARM(shc) *,
+                                      unsigned long *,
+                                      unsigned long *,
+                                      unsigned long *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
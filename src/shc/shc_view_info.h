@@ -0,0 +1,39 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_VIEW_INFO_H__
+#define __SHC_VIEW_INFO_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+/* Slice of spherical harmonic coefficients returned by "shc_view".  The
+ * "charm_shc" structure of the view shares "shcs->c" and "shcs->s" with the
+ * structure that stores the coefficients, so "shcs->c[m][n - m]" of the view
+ * is the coefficient of the latter structure.  The coefficients outside the
+ * slice are treated as zeros by the functions supporting views. */
+struct CHARM(shc_view_info)
+{
+    /* Maximum harmonic degree and the number of coefficients of the structure
+     * that stores the coefficients.  If the view was created from another
+     * view, these are taken over from the latter, so they never refer to
+     * a view.  "shcs->c[0]" then has "nc_data" coefficients ordered with
+     * "nmax_data" as the maximum degree. */
+    unsigned long nmax_data;
+    size_t nc_data;
+
+
+    /* Only the coefficients of degrees "nmin <= n <= shcs->nmax" and orders
+     * "mmin <= m <= mmax" are non-zero */
+    unsigned long nmin;
+    unsigned long mmin;
+    unsigned long mmax;
+};
+
+
+typedef struct CHARM(shc_view_info) CHARM(shc_view_info);
+
+
+#endif
@@ -0,0 +1,30 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "shc_view_get_range.h"
+#include "shc_view_is_sliced.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns "1" if "shcs" is a view returned by "shc_view" that treats some of
+ * the coefficients up to degree "shcs->nmax" as zeros.  Returns "0"
+ * otherwise, that is, if "shcs" is not a view or if the view only truncates
+ * the coefficients to a lower maximum degree. */
+_Bool CHARM(shc_view_is_sliced)(const CHARM(shc) *shcs)
+{
+    if (shcs->view == NULL)
+        return 0;
+
+
+    unsigned long nmin, mmin, mmax;
+    CHARM(shc_view_get_range)(shcs, &nmin, &mmin, &mmax);
+
+
+    return (nmin > 0) || (mmin > 0) || (mmax < shcs->nmax);
+}
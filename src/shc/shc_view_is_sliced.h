@@ -0,0 +1,26 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_VIEW_IS_SLICED_H__
+#define __SHC_VIEW_IS_SLICED_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern _Bool CHARM(shc_view_is_sliced)(const CHARM(shc) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -3,7 +3,12 @@
 #include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include "../prec.h"
+#include "../misc/misc_crc32.h"
+#include "shc_bin.h"
+#include "shc_bin_header_encode.h"
 #include "shc_check_distribution.h"
 #include "../err/err_set.h"
 #include "../err/err_propagate.h"
@@ -20,6 +25,7 @@
 static int write_cnmsnm(const CHARM(shc) *,
                         unsigned long,
                         _Bool,
+                        uint32_t *,
                         FILE *);
 /* ------------------------------------------------------------------------- */
 
@@ -57,6 +63,10 @@ void CHARM(shc_write_bin)(const CHARM(shc) *shcs,
 
     /* Open "pathname" to write */
     /* ===================================================================== */
+    /* Checksums of the "C" and "S" coefficients of each order */
+    uint32_t *crc = NULL;
+
+
     FILE *fptr = fopen(pathname, "wb");
     if (fptr == NULL)
     {
@@ -89,34 +99,35 @@ void CHARM(shc_write_bin)(const CHARM(shc) *shcs,
 
 
 
-    /* Write the maximum harmonic degree, the scaling parameter and the radius
-     * of the reference sphere */
     /* ===================================================================== */
-    /* The maximum harmonic degree.  Note that written is the user-defined
-     * maximum harmonic degree "nmax" (not "shcs->nmax"), as this is what we
-     * are asked to do by the user. */
-    if (fwrite(&nmax, sizeof(unsigned long), 1, fptr) != 1)
+    crc = (uint32_t *)malloc(2 * ((size_t)nmax + 1) * sizeof(uint32_t));
+    if (crc == NULL)
     {
-        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
-                       "Failed to write the maximum harmonic degree.");
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
         goto EXIT;
     }
+    /* ===================================================================== */
+
 
 
-    /* The scaling parameter */
-    if (fwrite(&(shcs->mu), sizeof(REAL), 1, fptr) != 1)
-    {
-        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
-                       "Failed to write the scaling parameter.");
-        goto EXIT;
-    }
 
 
-    /* The scaling parameter */
-    if (fwrite(&(shcs->r), sizeof(REAL), 1, fptr) != 1)
+
+    /* Write the header with the maximum harmonic degree, the scaling
+     * parameter, the radius of the reference sphere and the information on
+     * the format of the data (see "shc_bin.h") */
+    /* ===================================================================== */
+    /* Note that written is the user-defined maximum harmonic degree "nmax"
+     * (not "shcs->nmax"), as this is what we are asked to do by the user. */
+    unsigned char header[SHC_BIN_HEADER];
+    CHARM(shc_bin_header) hdr;
+    CHARM(shc_bin_header_encode)(nmax, shcs->mu, shcs->r, header, &hdr);
+    if (fwrite(header, sizeof(unsigned char), SHC_BIN_HEADER, fptr) !=
+        SHC_BIN_HEADER)
     {
         CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
-                       "Failed to write the radius of the reference sphere.");
+                       "Failed to write the header.");
         goto EXIT;
     }
     /* ===================================================================== */
@@ -128,7 +139,7 @@ void CHARM(shc_write_bin)(const CHARM(shc) *shcs,
 
     /* Write the "shcs->c" coefficients */
     /* ===================================================================== */
-    if (write_cnmsnm(shcs, nmax, 0, fptr))
+    if (write_cnmsnm(shcs, nmax, 0, crc, fptr))
     {
         CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
                        "Failed to write the \"C\" coefficients).");
@@ -143,7 +154,19 @@ void CHARM(shc_write_bin)(const CHARM(shc) *shcs,
 
     /* Write the "shcs->s" coefficients */
     /* ===================================================================== */
-    if (write_cnmsnm(shcs, nmax, 1, fptr))
+    /* Zero padding to align the "S" coefficients */
+    size_t ncs  = (((size_t)nmax + 2) * ((size_t)nmax + 1)) / 2;
+    size_t npad = (size_t)(hdr.offset_s - hdr.offset_c) - ncs * sizeof(REAL);
+    unsigned char pad[SHC_BIN_ALIGN] = {0};
+    if (fwrite(pad, sizeof(unsigned char), npad, fptr) != npad)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to write the padding of the coefficients.");
+        goto EXIT;
+    }
+
+
+    if (write_cnmsnm(shcs, nmax, 1, crc + nmax + 1, fptr))
     {
         CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
                        "Failed to write the \"S\" coefficients).");
@@ -156,7 +179,47 @@ void CHARM(shc_write_bin)(const CHARM(shc) *shcs,
 
 
 
+    /* Write the index with the offsets and the checksums of the orders */
+    /* ===================================================================== */
+    npad = (size_t)(hdr.offset_idx - hdr.offset_s) - ncs * sizeof(REAL);
+    if (fwrite(pad, sizeof(unsigned char), npad, fptr) != npad)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to write the padding of the coefficients.");
+        goto EXIT;
+    }
+
+
+    unsigned char entry[SHC_BIN_INDEX_ENTRY];
+    uint64_t offset_c = hdr.offset_c;
+    uint64_t offset_s = hdr.offset_s;
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        memcpy(entry,      &offset_c,          sizeof(uint64_t));
+        memcpy(entry + 8,  &offset_s,          sizeof(uint64_t));
+        memcpy(entry + 16, crc + m,            sizeof(uint32_t));
+        memcpy(entry + 20, crc + nmax + 1 + m, sizeof(uint32_t));
+        if (fwrite(entry, sizeof(unsigned char), SHC_BIN_INDEX_ENTRY, fptr) !=
+            SHC_BIN_INDEX_ENTRY)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Failed to write the index.");
+            goto EXIT;
+        }
+
+
+        offset_c += (uint64_t)(nmax + 1 - m) * sizeof(REAL);
+        offset_s += (uint64_t)(nmax + 1 - m) * sizeof(REAL);
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
 EXIT:
+    free(crc);
     fclose(fptr);
     return;
 }
@@ -167,10 +230,12 @@ EXIT:
 
 
 /* Just a small function to write "Cnm" and "Snm" coefficients to the binary
- * file.  Hopefully, no detailed documentation is needed. */
+ * file.  The checksum of the coefficients of order "m" is returned in
+ * "crc[m]". */
 static int write_cnmsnm(const CHARM(shc) *shcs,
                         unsigned long nmax,
                         _Bool cnmsnm,
+                        uint32_t *crc,
                         FILE *fptr)
 {
     /* Loop over the harmonic orders */
@@ -180,6 +245,9 @@ static int write_cnmsnm(const CHARM(shc) *shcs,
         size_t nwrite = (size_t)(nmax + 1 - m);
         if (fwrite(cs, sizeof(REAL), nwrite, fptr) != nwrite)
             return 1;
+
+
+        crc[m] = CHARM(misc_crc32)(0, cs, nwrite * sizeof(REAL));
     }
 
 
@@ -0,0 +1,196 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../prec.h"
+#include "../misc/misc_crc32.h"
+#include "shc_bin.h"
+#include "shc_binz.h"
+#include "shc_binz_encode_row.h"
+#include "shc_check_distribution.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(shc_write_binz)(const CHARM(shc) *shcs,
+                           unsigned long nmax,
+                           const char *pathname,
+                           CHARM(err) *err)
+{
+    /* ===================================================================== */
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
+    CHARM(shc_check_distribution)(shcs, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
+    if (nmax > shcs->nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Not enough coefficients in \"shcs\" to write "
+                       "up to degree \"nmax\".");
+        return;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Open "pathname" to write */
+    /* ===================================================================== */
+    unsigned char *buf   = NULL;
+    unsigned char *index = NULL;
+
+
+    FILE *fptr = fopen(pathname, "wb");
+    if (fptr == NULL)
+    {
+        char msg[CHARM_ERR_MAX_MSG];
+        snprintf(msg, CHARM_ERR_MAX_MSG, "Couldn't create \"%s\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                       CHARM_EFILEIO, msg);
+        return;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* ===================================================================== */
+    size_t nmax1 = (size_t)nmax + 1;
+    buf   = (unsigned char *)malloc(2 * SHC_BINZ_ROW_MAX(nmax1));
+    index = (unsigned char *)calloc(nmax1, SHC_BINZ_INDEX_ENTRY);
+    if ((buf == NULL) || (index == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto EXIT;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Write the header (see "shc_binz.h").  The offset of the index is not
+     * known yet, so it is written after the coefficients. */
+    /* ===================================================================== */
+    unsigned char header[SHC_BINZ_HEADER] = {0};
+    uint32_t version   = SHC_BINZ_VERSION;
+    uint32_t endian    = SHC_BIN_ENDIAN;
+    uint32_t prec      = SHC_BIN_PREC;
+    uint32_t real_size = (uint32_t)sizeof(REAL);
+    uint32_t codec     = SHC_BINZ_CODEC_DELTA;
+    uint64_t nmax64    = (uint64_t)nmax;
+    memcpy(header,      SHC_BINZ_MAGIC, SHC_BIN_NMAGIC);
+    memcpy(header + 8,  &version,       sizeof(uint32_t));
+    memcpy(header + 12, &endian,        sizeof(uint32_t));
+    memcpy(header + 16, &prec,          sizeof(uint32_t));
+    memcpy(header + 20, &real_size,     sizeof(uint32_t));
+    memcpy(header + 24, &codec,         sizeof(uint32_t));
+    memcpy(header + 32, &nmax64,        sizeof(uint64_t));
+    memcpy(header + 64, &shcs->mu,      sizeof(REAL));
+    memcpy(header + 80, &shcs->r,       sizeof(REAL));
+    if (fwrite(header, sizeof(unsigned char), SHC_BINZ_HEADER, fptr) !=
+        SHC_BINZ_HEADER)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to write the header.");
+        goto EXIT;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Compress and write the orders */
+    /* ===================================================================== */
+    uint64_t offset = SHC_BINZ_HEADER;
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        size_t n = nmax1 - m;
+        uint64_t nbytes_c = CHARM(shc_binz_encode_row)(shcs->c[m], n, buf);
+        uint64_t nbytes_s = CHARM(shc_binz_encode_row)(shcs->s[m], n,
+                                                       buf + nbytes_c);
+        size_t nbytes = (size_t)(nbytes_c + nbytes_s);
+        if (fwrite(buf, sizeof(unsigned char), nbytes, fptr) != nbytes)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                           "Failed to write the compressed coefficients.");
+            goto EXIT;
+        }
+
+
+        uint32_t crc = CHARM(misc_crc32)(0, buf, nbytes);
+        unsigned char *e = index + m * SHC_BINZ_INDEX_ENTRY;
+        memcpy(e,      &offset,   sizeof(uint64_t));
+        memcpy(e + 8,  &nbytes_c, sizeof(uint64_t));
+        memcpy(e + 16, &nbytes_s, sizeof(uint64_t));
+        memcpy(e + 24, &crc,      sizeof(uint32_t));
+
+
+        offset += nbytes;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+    /* Write the index and its offset to the header */
+    /* ===================================================================== */
+    if (fwrite(index, SHC_BINZ_INDEX_ENTRY, nmax1, fptr) != nmax1)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to write the index.");
+        goto EXIT;
+    }
+
+
+    if (fseek(fptr, 40, SEEK_SET) ||
+        (fwrite(&offset, sizeof(uint64_t), 1, fptr) != 1))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO,
+                       "Failed to write the offset of the index.");
+        goto EXIT;
+    }
+    /* ===================================================================== */
+
+
+
+
+
+
+EXIT:
+    free(buf);
+    free(index);
+    fclose(fptr);
+    return;
+}
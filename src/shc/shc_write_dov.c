@@ -4,7 +4,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "../prec.h"
-#include "../misc/misc_fprintf_real.h"
+#include "../misc/misc_sprint_real.h"
+#include "../misc/misc_sprint_ulong.h"
+#include "shc_write_text.h"
 #include "shc_write_mtdt.h"
 #include "shc_check_distribution.h"
 #include "../err/err_set.h"
@@ -17,6 +19,113 @@
 
 
 
+/* Formats the lines "n  m cnm" and, if "m > 0", "n -m snm" to "buf" of
+ * "size" characters */
+static long dov_lines(unsigned long n,
+                      unsigned long m,
+                      REAL cnm,
+                      REAL snm,
+                      const char *format,
+                      char *buf,
+                      size_t size)
+{
+    size_t pos = 0;
+    int k;
+
+
+    k = CHARM(misc_sprint_ulong)(buf + pos, size - pos, n);
+    SHC_WRITE_TEXT_ADVANCE(k, pos, size);
+    SHC_WRITE_TEXT_CHAR(' ', buf, pos, size);
+    SHC_WRITE_TEXT_CHAR(' ', buf, pos, size);
+    k = CHARM(misc_sprint_ulong)(buf + pos, size - pos, m);
+    SHC_WRITE_TEXT_ADVANCE(k, pos, size);
+    SHC_WRITE_TEXT_CHAR(' ', buf, pos, size);
+    k = CHARM(misc_sprint_real)(buf + pos, size - pos, format, cnm);
+    SHC_WRITE_TEXT_ADVANCE(k, pos, size);
+    SHC_WRITE_TEXT_CHAR('\n', buf, pos, size);
+
+
+    if (m == 0)
+        return (long)pos;
+
+
+    k = CHARM(misc_sprint_ulong)(buf + pos, size - pos, n);
+    SHC_WRITE_TEXT_ADVANCE(k, pos, size);
+    SHC_WRITE_TEXT_CHAR(' ', buf, pos, size);
+    SHC_WRITE_TEXT_CHAR('-', buf, pos, size);
+    k = CHARM(misc_sprint_ulong)(buf + pos, size - pos, m);
+    SHC_WRITE_TEXT_ADVANCE(k, pos, size);
+    SHC_WRITE_TEXT_CHAR(' ', buf, pos, size);
+    k = CHARM(misc_sprint_real)(buf + pos, size - pos, format, snm);
+    SHC_WRITE_TEXT_ADVANCE(k, pos, size);
+    SHC_WRITE_TEXT_CHAR('\n', buf, pos, size);
+
+
+    return (long)pos;
+}
+
+
+
+
+
+
+/* Formats all lines of the order "m" (see "shc_write_text.h") */
+static long dov_n(const CHARM(shc) *shcs,
+                  unsigned long nmax,
+                  const char *format,
+                  unsigned long m,
+                  char *buf,
+                  size_t size)
+{
+    size_t pos = 0;
+    for (unsigned long n = m; n <= nmax; n++)
+    {
+        long k = dov_lines(n, m, shcs->c[m][n - m], shcs->s[m][n - m],
+                           format, buf + pos, size - pos);
+        if (k < 0)
+            return k;
+        pos += (size_t)k;
+    }
+
+
+    return (long)pos;
+}
+
+
+
+
+
+
+/* Formats all lines of the degree "n" (see "shc_write_text.h") */
+static long dov_m(const CHARM(shc) *shcs,
+                  unsigned long nmax,
+                  const char *format,
+                  unsigned long n,
+                  char *buf,
+                  size_t size)
+{
+    (void)nmax;
+
+
+    size_t pos = 0;
+    for (unsigned long m = 0; m <= n; m++)
+    {
+        long k = dov_lines(n, m, shcs->c[m][n - m], shcs->s[m][n - m],
+                           format, buf + pos, size - pos);
+        if (k < 0)
+            return k;
+        pos += (size_t)k;
+    }
+
+
+    return (long)pos;
+}
+
+
+
+
+
+
 void CHARM(shc_write_dov)(const CHARM(shc) *shcs,
                           unsigned long nmax,
                           const char *format,
@@ -85,64 +194,25 @@ void CHARM(shc_write_dov)(const CHARM(shc) *shcs,
 
     /* Write the spherical harmonic coefficients */
     /* --------------------------------------------------------------------- */
+    CHARM(shc_write_text_fmt) fmt;
     if (ordering == CHARM_SHC_WRITE_N)
-    {
-        for (unsigned long m = 0; m <= nmax; m++)
-        {
-            for (unsigned long n = m; n <= nmax; n++)
-            {
-                if ((fprintf(fptr, "%lu ", n) < 1) ||
-                    (fprintf(fptr, " %lu ", m) < 1) ||
-                    (CHARM(misc_fprintf_real)(fptr, format,
-                                              shcs->c[m][n - m]) < 1) ||
-                    (fprintf(fptr, "%s", "\n") < 1) ||
-                    ((m > 0) ? ((fprintf(fptr, "%lu ", n) < 1) ||
-                                (fprintf(fptr, "-%lu ", m) < 1) ||
-                                (CHARM(misc_fprintf_real)(fptr, format,
-                                                          shcs->s[m][n - m])
-                                                         < 1) ||
-                                (fprintf(fptr, "%s", "\n") < 1)) : 0))
-                {
-                    CHARM(err_set)(err, __FILE__, __LINE__, __func__,
-                                   CHARM_EFILEIO,
-                                   "Failed writing to the output file.");
-                    goto EXIT;
-                }
-            }
-        }
-    }
+        fmt = dov_n;
     else if (ordering == CHARM_SHC_WRITE_M)
-    {
-        for (unsigned long n = 0; n <= nmax; n++)
-        {
-            for (unsigned long m = 0; m <= n; m++)
-            {
-                if ((fprintf(fptr, "%lu ", n) < 1) ||
-                    (fprintf(fptr, " %lu ", m) < 1) ||
-                    (CHARM(misc_fprintf_real)(fptr, format,
-                                              shcs->c[m][n - m]) < 1) ||
-                    (fprintf(fptr, "%s", "\n") < 1) ||
-                    ((m > 0) ? ((fprintf(fptr, "%lu ", n) < 1) ||
-                                (fprintf(fptr, "-%lu ", m) < 1) ||
-                                (CHARM(misc_fprintf_real)(fptr, format,
-                                                          shcs->s[m][n - m])
-                                                         < 1) ||
-                                (fprintf(fptr, "%s", "\n") < 1)) : 0))
-                {
-                    CHARM(err_set)(err, __FILE__, __LINE__, __func__,
-                                   CHARM_EFILEIO,
-                                   "Failed writing to the output file.");
-                    goto EXIT;
-                }
-            }
-        }
-    }
+        fmt = dov_m;
     else
     {
         CHARM(err_set)(err, __FILE__, __LINE__, __func__,
                        CHARM_EFUNCARG, "Unsupported value of \"ordering\".");
         goto EXIT;
     }
+
+
+    CHARM(shc_write_text)(shcs, nmax, format, nmax + 1, fmt, fptr, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
+    }
     /* --------------------------------------------------------------------- */
 
 
@@ -4,7 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "../prec.h"
-#include "../misc/misc_fprintf_real.h"
+#include "../misc/misc_sprint_real.h"
+#include "shc_write_text.h"
 #include "shc_write_mtdt.h"
 #include "shc_check_distribution.h"
 #include "../err/err_set.h"
@@ -17,6 +18,50 @@
 
 
 
+/* Formats the row "row" of the output matrix (see "shc_write_text.h") */
+static long mtx_row(const CHARM(shc) *shcs,
+                    unsigned long nmax,
+                    const char *format,
+                    unsigned long row,
+                    char *buf,
+                    size_t size)
+{
+    size_t pos = 0;
+    int k;
+
+
+    /* A particular coefficient to be written to the text file, either
+     * "shcs->c" or "shcs->s" */
+    REAL coeff;
+
+
+    /* Loop over the columns of the output matrix */
+    for (unsigned long col = 0; col <= nmax; col++)
+    {
+        if (row >= col)
+            coeff = shcs->c[col][row - col];
+        else
+            coeff = shcs->s[row + 1][col - row - 1];
+
+
+        k = CHARM(misc_sprint_real)(buf + pos, size - pos, format, coeff);
+        SHC_WRITE_TEXT_ADVANCE(k, pos, size);
+
+
+        if (col < nmax)
+            SHC_WRITE_TEXT_CHAR(' ', buf, pos, size);
+    }
+    SHC_WRITE_TEXT_CHAR('\n', buf, pos, size);
+
+
+    return (long)pos;
+}
+
+
+
+
+
+
 void CHARM(shc_write_mtx)(const CHARM(shc) *shcs,
                           unsigned long nmax,
                           const char *format,
@@ -82,46 +127,13 @@ void CHARM(shc_write_mtx)(const CHARM(shc) *shcs,
     }
 
 
-    /* Write the spherical harmonic coefficients */
+    /* Write the spherical harmonic coefficients row by row */
     /* --------------------------------------------------------------------- */
-    /* A particular coefficient to be written to the text file, either
-     * "shcs->c" or "shcs->s" */
-    REAL coeff;
-
-
-    /* Loop over the rows of the output matrix */
-    for (unsigned long row = 0; row <= nmax; row++)
+    CHARM(shc_write_text)(shcs, nmax, format, nmax + 1, mtx_row, fptr, err);
+    if (!CHARM(err_isempty)(err))
     {
-        /* Loop over the columns of the output matrix */
-        for (unsigned long col = 0; col <= nmax; col++)
-        {
-            if (row >= col)
-                coeff = shcs->c[col][row - col];
-            else
-                coeff = shcs->s[row + 1][col - row - 1];
-
-
-            if (CHARM(misc_fprintf_real)(fptr, format, coeff) < 1)
-            {
-                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
-                               CHARM_EFILEIO,
-                               "Failed to write to the output file.");
-                goto EXIT;
-            }
-
-
-            if (col < nmax)
-                fprintf(fptr, "%s", " ");
-        }
-
-
-        if (fprintf(fptr, "%s", "\n") < 1)
-        {
-            CHARM(err_set)(err, __FILE__, __LINE__, __func__,
-                           CHARM_EFILEIO,
-                           "Failed to write to the output file.");
-            goto EXIT;
-        }
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
     }
     /* --------------------------------------------------------------------- */
 
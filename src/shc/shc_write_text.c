@@ -0,0 +1,209 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "shc_write_text.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Initial size of the buffer of each thread in bytes */
+#undef NBUF_INIT
+#define NBUF_INIT (1UL << 16)
+
+
+/* Approximate number of lines formatted by one thread before the buffers are
+ * written to the file */
+#undef NLINES
+#define NLINES (1UL << 14)
+
+
+/* Status of the threads */
+#undef STATUS_OK
+#define STATUS_OK 0
+#undef STATUS_EMEM
+#define STATUS_EMEM 1
+#undef STATUS_EFORMAT
+#define STATUS_EFORMAT 2
+
+
+
+
+
+
+/* Writes the text lines of the iterations "0, 1, ..., nouter - 1" of the
+ * outer loop of a writer to "fptr".  The lines of each iteration are
+ * formatted by "fmt" to memory buffers, so that the file is written in large
+ * blocks.  With OpenMP, consecutive blocks of iterations are formatted in
+ * parallel and then written to the file in the original order, so the output
+ * does not depend on the number of threads. */
+void CHARM(shc_write_text)(const CHARM(shc) *shcs,
+                           unsigned long nmax,
+                           const char *format,
+                           unsigned long nouter,
+                           CHARM(shc_write_text_fmt) fmt,
+                           FILE *fptr,
+                           CHARM(err) *err)
+{
+    /* --------------------------------------------------------------------- */
+#if HAVE_OPENMP
+    int nthreads = omp_get_max_threads();
+#else
+    int nthreads = 1;
+#endif
+
+
+    char **buf   = (char **)calloc((size_t)nthreads, sizeof(char *));
+    size_t *size = (size_t *)malloc((size_t)nthreads * sizeof(size_t));
+    size_t *len  = (size_t *)malloc((size_t)nthreads * sizeof(size_t));
+    int *status  = (int *)malloc((size_t)nthreads * sizeof(int));
+    if ((buf == NULL) || (size == NULL) || (len == NULL) || (status == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto EXIT;
+    }
+
+
+    for (int t = 0; t < nthreads; t++)
+    {
+        size[t] = NBUF_INIT;
+        buf[t]  = (char *)malloc(size[t]);
+        if (buf[t] == NULL)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto EXIT;
+        }
+    }
+
+
+    /* Number of iterations of the outer loop formatted by one thread at
+     * a time.  A single iteration typically produces up to "nmax + 1"
+     * lines. */
+    unsigned long nblock = NLINES / (nmax + 1);
+    if (nblock == 0)
+        nblock = 1;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    for (unsigned long i0 = 0; i0 < nouter;
+         i0 += (unsigned long)nthreads * nblock)
+    {
+        /* Format "nthreads" consecutive blocks of iterations */
+        /* ................................................................. */
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) \
+shared(shcs, nmax, format, nouter, fmt, buf, size, len, status, nthreads, \
+       nblock, i0) schedule(static, 1)
+#endif
+        for (int t = 0; t < nthreads; t++)
+        {
+            len[t]    = 0;
+            status[t] = STATUS_OK;
+
+
+            unsigned long istart = i0 + (unsigned long)t * nblock;
+            unsigned long iend   = istart + nblock;
+            if (iend > nouter)
+                iend = nouter;
+
+
+            for (unsigned long i = istart; i < iend; i++)
+            {
+                long n;
+                while ((n = fmt(shcs, nmax, format, i, buf[t] + len[t],
+                                size[t] - len[t])) == SHC_WRITE_TEXT_ESIZE)
+                {
+                    /* The buffer is too small, so enlarge it and try again */
+                    char *tmp = (char *)realloc(buf[t], 2 * size[t]);
+                    if (tmp == NULL)
+                    {
+                        status[t] = STATUS_EMEM;
+                        break;
+                    }
+                    buf[t]   = tmp;
+                    size[t] *= 2;
+                }
+
+
+                if (status[t] != STATUS_OK)
+                    break;
+
+
+                if (n < 0)
+                {
+                    status[t] = STATUS_EFORMAT;
+                    break;
+                }
+
+
+                len[t] += (size_t)n;
+            }
+        }
+        /* ................................................................. */
+
+
+        /* Write the buffers in the order of the blocks */
+        /* ................................................................. */
+        for (int t = 0; t < nthreads; t++)
+        {
+            if (status[t] == STATUS_EMEM)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                               CHARM_ERR_MALLOC_FAILURE);
+                goto EXIT;
+            }
+            else if (status[t] == STATUS_EFORMAT)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO,
+                               "Failed to format a number.");
+                goto EXIT;
+            }
+
+
+            if ((len[t] > 0) && (fwrite(buf[t], sizeof(char), len[t], fptr)
+                                 != len[t]))
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__,
+                               CHARM_EFILEIO,
+                               "Failed writing to the output file.");
+                goto EXIT;
+            }
+        }
+        /* ................................................................. */
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+EXIT:
+    if (buf != NULL)
+    {
+        for (int t = 0; t < nthreads; t++)
+            free(buf[t]);
+    }
+    free(buf);
+    free(size);
+    free(len);
+    free(status);
+    return;
+}
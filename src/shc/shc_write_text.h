@@ -0,0 +1,73 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHC_WRITE_TEXT_H__
+#define __SHC_WRITE_TEXT_H__
+
+
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+
+
+/* Values returned by "shc_write_text_fmt" on failure */
+#define SHC_WRITE_TEXT_ESIZE   (-1L)
+#define SHC_WRITE_TEXT_EFORMAT (-2L)
+
+
+/* Formats the lines of a text file that are associated with the index "i" of
+ * the outer loop of a writer (e.g., a harmonic order) to "buf" of "size"
+ * characters.  Returned is the number of characters written,
+ * "SHC_WRITE_TEXT_ESIZE" if "size" is too small or "SHC_WRITE_TEXT_EFORMAT"
+ * if a number could not be formatted. */
+typedef long (*CHARM(shc_write_text_fmt))(const CHARM(shc) *,
+                                          unsigned long,
+                                          const char *,
+                                          unsigned long,
+                                          char *,
+                                          size_t);
+
+
+/* Advances "pos" by "k" characters that were written by an "snprintf"-like
+ * function to "buf + pos" of "size - pos" characters.  On failure, returns
+ * from the calling "shc_write_text_fmt" function. */
+#define SHC_WRITE_TEXT_ADVANCE(k, pos, size)                                  \
+        {                                                                     \
+            if ((k) < 0)                                                      \
+                return SHC_WRITE_TEXT_EFORMAT;                                \
+            if ((size_t)(k) >= (size) - (pos))                                \
+                return SHC_WRITE_TEXT_ESIZE;                                  \
+            (pos) += (size_t)(k);                                             \
+        }
+
+
+/* Writes the character "c" to "buf + pos" and advances "pos" */
+#define SHC_WRITE_TEXT_CHAR(c, buf, pos, size)                                \
+        {                                                                     \
+            if ((size) - (pos) < 2)                                           \
+                return SHC_WRITE_TEXT_ESIZE;                                  \
+            (buf)[(pos)++] = (c);                                             \
+        }
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shc_write_text)(const CHARM(shc) *,
+                                  unsigned long,
+                                  const char *,
+                                  unsigned long,
+                                  CHARM(shc_write_text_fmt),
+                                  FILE *,
+                                  CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
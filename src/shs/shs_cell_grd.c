@@ -8,7 +8,7 @@
 #include <math.h>
 #include <fftw3.h>
 #include "../prec.h"
-#include "shs_cell_kernel.h"
+#include "shs_kernels.h"
 #include "shs_grd_lr.h"
 #include "shs_grd_lr2.h"
 #include "shs_grd_cell_fft_check.h"
@@ -31,6 +31,7 @@
 #include "../misc/misc_is_nearly_equal.h"
 #include "../misc/misc_polar_optimization_threshold.h"
 #include "../misc/misc_polar_optimization_apply.h"
+#include "../misc/misc_fftw_plans.h"
 #include "../simd/simd.h"
 #include "../simd/calloc_aligned.h"
 #include "../simd/free_aligned.h"
@@ -331,7 +332,7 @@ void CHARM(shs_cell_grd)(const CHARM(cell) *cell, const CHARM(shc) *shcs,
 #pragma omp parallel default(none) \
 shared(f, shcs, nmax, cell, cell_nlat, cell_nlon, dm, en, fn, gm, hm, r, ri) \
 shared(nlatdo, lon0, deltalon, even, symm, FAILURE_glob, mur, err, cell_type) \
-shared(pt, nfc, plan, use_fft, rref, lc_err_glob)
+shared(pt, nfc, plan, use_fft, rref, lc_err_glob) SHS_KERNEL_VARS
 #endif
     {
         /* ................................................................. */
@@ -370,7 +371,7 @@ shared(pt, nfc, plan, use_fft, rref, lc_err_glob)
         REAL *cell_r2v      = NULL;
 
 
-        lc = CHARM(shs_lc_init)();
+        lc = CHARM(shs_lc_init)(SIMD_BLOCK_S);
         if (lc == NULL)
         {
             FAILURE_priv = 1;
@@ -747,18 +748,18 @@ FAILURE_1_parallel:
 
 
                 /* Summation over harmonic degrees */
-                CHARM(shs_cell_kernel)(nmax, m, shcs, anm, bnm,
-                                       latmin, latmax,
-                                       t1, t2,
-                                       u1, u2,
-                                       ps1, ps2,
-                                       ips1, ips2,
-                                       &imm0, &imm1, &imm2,
-                                       en, fn, gm, hm, ri,
-                                       ratio, ratio2,
-                                       ratiom, ratio2m,
-                                       symm_simd,
-                                       &a, &b, &a2, &b2);
+                SHS_KERNEL(shs_cell_kernel)(nmax, m, shcs, anm, bnm,
+                                            &latmin, &latmax,
+                                            &t1, &t2,
+                                            &u1, &u2,
+                                            ps1, ps2,
+                                            ips1, ips2,
+                                            &imm0, &imm1, &imm2,
+                                            en, fn, gm, hm, ri,
+                                            &ratio, &ratio2,
+                                            &ratiom, &ratio2m,
+                                            &symm_simd,
+                                            &a, &b, &a2, &b2);
 
 
                 /* The two function calls that follow require "CHARM(lc)" as an
@@ -782,10 +783,12 @@ FAILURE_1_parallel:
                 if (use_fft)
                     CHARM(shs_grd_fft_lc)(m, deltalon, 0, lc,
                                           symm, &symm_simd, cell_type,
-                                          nfc, fc_simd, fc2_simd);
+                                          nfc, SIMD_BLOCK_S, fc_simd,
+                                          fc2_simd);
                 else
                     CHARM(shs_grd_lr)(m, lon0, deltalon, cell_nlon, cell_type,
-                                      0, nfi, lc, symm, fi, fi2);
+                                      0, nfi, SIMD_BLOCK_S, lc, symm, fi,
+                                      fi2);
 
 
                 if (lc->error)
@@ -807,11 +810,13 @@ UPDATE_RATIOS:
                 CHARM(shs_grd_fft)(i, cell_type, cell_nlat, cell_nlon,
                                    latsinv, latminv, latmaxv, deltalon,
                                    fc, fc2, nfc, fc_simd, fc2_simd,
-                                   mur, plan, symmv, ftmp, f);
+                                   mur, plan, symmv, SIMD_BLOCK_S, ftmp,
+                                   f);
             else
                 CHARM(shs_grd_lr2)(i, latsinv,
                                    cell_type, cell_nlat, cell_nlon,
-                                   symmv, mur, latminv, latmaxv, deltalon,
+                                   symmv, SIMD_BLOCK_S, mur, latminv,
+                                   latmaxv, deltalon,
                                    fi, fi2, f);
 
 
@@ -871,7 +876,7 @@ FAILURE:
     if (use_fft)
     {
         FFTW(destroy_plan)(plan);
-        FFTW(cleanup)();
+        CHARM(misc_fftw_cleanup)();
     }
     /* --------------------------------------------------------------------- */
 
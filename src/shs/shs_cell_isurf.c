@@ -6,13 +6,12 @@
 #include <string.h>
 #include <math.h>
 #include "../prec.h"
+#include "shs_cell_isurf_prep.h"
 #include "shs_cell_isurf_coeffs.h"
 #include "shs_cell_isurf_lr.h"
 #include "shs_cell_check_grd_lons.h"
-#include "../integ/integ_ccs.h"
-#include "../integ/integ_css.h"
-#include "../integ/integ_scs.h"
-#include "../integ/integ_sss.h"
+#include "../integ/integ_cs.h"
+#include "../integ/integ_ss.h"
 #include "../crd/crd_check_cells.h"
 #include "../crd/crd_cell_isGrid.h"
 #include "../shc/shc_check_distribution.h"
@@ -31,6 +30,105 @@
 
 
 
+/* Computes the trigonometric integrals "ipt_ccs", "ipt_css", "ipt_scs" and
+ * "ipt_sss" related to the integrals of associated Legendre functions for the
+ * latitude cells "i, i + 1, ..., i + SIMD_SIZE - 1".  The co-latitudes of the
+ * cells are returned in "clt1v" and "clt2v" and their differences in
+ * "dcltv".
+ *
+ * All the four integrals of "k1" and "k3" are linear combinations of the
+ * integrals "CHARM(integ_cs)" and "CHARM(integ_ss)" of "k1 - k3" and "k1 +
+ * k3" (see "CHARM(integ_ccs)", etc.).  These are therefore computed only once
+ * for each "k = -nmax3, ..., nmax1 + nmax3" and stored in the arrays "ics" and
+ * "iss" of "nmax1 + 2 * nmax3 + 1" elements.  The results are the same as
+ * with "CHARM(integ_ccs)", etc. */
+static void ipt_lat(const CHARM(cell) *cell,
+                    size_t i,
+                    unsigned long nmax1,
+                    unsigned long nmax3,
+                    REAL *clt1v,
+                    REAL *clt2v,
+                    REAL *dcltv,
+                    REAL *ics,
+                    REAL *iss,
+                    REAL *ipt_ccs,
+                    REAL *ipt_css,
+                    REAL *ipt_scs,
+                    REAL *ipt_sss)
+{
+    /* Transformation of latitudes into co-latitudes */
+    size_t ipv;
+    for (size_t v = 0; v < SIMD_SIZE; v++)
+    {
+        ipv = i + v;
+        if (ipv < cell->nlat)
+        {
+            clt1v[v] = PI_2 - cell->latmax[ipv];
+            clt2v[v] = PI_2 - cell->latmin[ipv];
+        }
+        else
+        {
+            clt1v[v] = clt2v[v] = PREC(0.0);
+            continue;
+        }
+
+
+        dcltv[v] = clt2v[v] - clt1v[v];
+    }
+
+
+    /* "ics[nmax3 + k]" and "iss[nmax3 + k]" refer to the integer "k" */
+    REAL *ics0 = ics + nmax3;
+    REAL *iss0 = iss + nmax3;
+    long int k1l, k3l;
+    size_t idx2;
+
+
+    for (size_t v = 0; v < SIMD_SIZE; v++)
+    {
+        for (long int k = -(long int)nmax3; k <= (long int)(nmax1 + nmax3);
+             k++)
+        {
+            CHARM(integ_cs)(clt1v[v], dcltv[v], 1, (REAL)k, PREC(1.0),
+                            ics0 + k);
+            CHARM(integ_ss)(clt1v[v], dcltv[v], 1, (REAL)k, PREC(1.0),
+                            iss0 + k);
+        }
+
+
+        idx2 = v;
+        for (unsigned long k1 = 0; k1 <= nmax1; k1++)
+        {
+            k1l = (long int)k1;
+            for (unsigned long k3 = 0; k3 <= nmax3; k3++)
+            {
+                k3l = (long int)k3;
+
+
+                ipt_ccs[idx2] = (ics0[k1l - k3l] + ics0[k1l + k3l]) /
+                                PREC(2.0);
+                ipt_css[idx2] = (iss0[k1l + k3l] - iss0[k1l - k3l]) /
+                                PREC(2.0);
+                ipt_scs[idx2] = (iss0[k3l + k1l] - iss0[k3l - k1l]) /
+                                PREC(2.0);
+                ipt_sss[idx2] = (ics0[k1l - k3l] - ics0[k1l + k3l]) /
+                                PREC(2.0);
+
+
+                idx2 += SIMD_SIZE;
+            }
+        }
+    }
+
+
+    return;
+}
+
+
+
+
+
+
 void CHARM(shs_cell_isurf)(const CHARM(cell) *cell,
                            const CHARM(shc) *shcs1,
                            unsigned long nmax1,
@@ -148,11 +246,16 @@ void CHARM(shs_cell_isurf)(const CHARM(cell) *cell,
 
     /* --------------------------------------------------------------------- */
     int FAILURE_glob = 0;
-    REAL *cnm1cnm3 = NULL;
-    REAL *cnm1snm3 = NULL;
-    REAL *snm1cnm3 = NULL;
-    REAL *snm1snm3 = NULL;
-    REAL *DELTAlon = NULL;
+    CHARM(pnmj) *pnmj     = NULL;
+    CHARM(pnmj) *cnm1pnmj = NULL;
+    CHARM(pnmj) *snm1pnmj = NULL;
+    REAL *cnm3pnmj_sum    = NULL;
+    REAL *snm3pnmj_sum    = NULL;
+    REAL *cnm1cnm3        = NULL;
+    REAL *cnm1snm3        = NULL;
+    REAL *snm1cnm3        = NULL;
+    REAL *snm1snm3        = NULL;
+    REAL *DELTAlon        = NULL;
     /* --------------------------------------------------------------------- */
 
 
@@ -160,50 +263,124 @@ void CHARM(shs_cell_isurf)(const CHARM(cell) *cell,
 
 
 
-    /* Computation of the coefficients related to the potential on the
-     * irregular surface */
+    /* Preparation of the quantities, from which the coefficients related to
+     * the potential on the irregular surface are computed */
     /* --------------------------------------------------------------------- */
-    /* Allocation of the coefficients */
-    size_t size = (nmax3 + 1) * (nmax3 + 1) * (nmax1 + 1) * (nmax1 + 1);
-    cnm1cnm3 = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, size,
-                                             sizeof(REAL));
-    if (cnm1cnm3 == NULL)
+    /* Fourier coefficients of Legendre functions */
+    unsigned long nmax = CHARM_MAX(nmax1, nmax3);
+    pnmj = CHARM(leg_pnmj_calloc)(nmax, CHARM_LEG_PMJN);
+    if (pnmj == NULL)
     {
         FAILURE_glob = 1;
         goto FAILURE;
     }
-    cnm1snm3 = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, size,
-                                             sizeof(REAL));
-    if (cnm1snm3 == NULL)
+
+
+    CHARM(leg_pnmj_coeffs)(pnmj, nmax, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto FAILURE;
+    }
+
+
+    /* Products of "shcs1" with "pnmj" */
+    cnm1pnmj = CHARM(leg_pnmj_calloc)(nmax1, CHARM_LEG_PMJN);
+    if (cnm1pnmj == NULL)
     {
         FAILURE_glob = 1;
         goto FAILURE;
     }
-    snm1cnm3 = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, size,
-                                             sizeof(REAL));
-    if (snm1cnm3 == NULL)
+    snm1pnmj = CHARM(leg_pnmj_calloc)(nmax1, CHARM_LEG_PMJN);
+    if (snm1pnmj == NULL)
     {
         FAILURE_glob = 1;
         goto FAILURE;
     }
-    snm1snm3 = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, size,
-                                             sizeof(REAL));
-    if (snm1snm3 == NULL)
+
+
+    /* Sums over "n3" for all "n1" */
+    size_t size = (size_t)(nmax1 + 1) * (nmax3 + 1) * (nmax3 + 1);
+    cnm3pnmj_sum = (REAL *)malloc(size * sizeof(REAL));
+    if (cnm3pnmj_sum == NULL)
+    {
+        FAILURE_glob = 1;
+        goto FAILURE;
+    }
+    snm3pnmj_sum = (REAL *)malloc(size * sizeof(REAL));
+    if (snm3pnmj_sum == NULL)
     {
         FAILURE_glob = 1;
         goto FAILURE;
     }
 
 
-    CHARM(shs_cell_isurf_coeffs)(shcs1, nmax1, shcs2,
-                                 nmax2, nmax3, nmax4,
-                                 cnm1cnm3, cnm1snm3,
-                                 snm1cnm3, snm1snm3, err);
+    CHARM(shs_cell_isurf_prep)(shcs1, nmax1, shcs2, nmax2, nmax3, nmax4,
+                               pnmj, cnm1pnmj, snm1pnmj,
+                               cnm3pnmj_sum, snm3pnmj_sum, err);
     if (!CHARM(err_isempty)(err))
     {
         CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
         goto FAILURE;
     }
+
+
+    /* "pnmj" is no longer needed, so release the memory before allocating
+     * the tiles */
+    CHARM(leg_pnmj_free)(pnmj);
+    pnmj = NULL;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Allocation of the coefficients related to the potential on the
+     * irregular surface.  All orders "m1" would require "4 * (nmax1 + 1)^2 *
+     * (nmax3 + 1)^2" floating points, so the coefficients are computed and
+     * consumed by tiles of "nm1" orders "m1" that fit into
+     * "CHARM(glob_shs_cell_isurf_memory)".  At least one order is always
+     * held in the memory. */
+    /* --------------------------------------------------------------------- */
+    size_t size_m1 = (size_t)(nmax3 + 1) * (nmax3 + 1) * (nmax1 + 1);
+    size_t nm1     = CHARM(glob_shs_cell_isurf_memory) /
+                     (4 * size_m1 * sizeof(REAL));
+    if (nm1 < 1)
+        nm1 = 1;
+    else if (nm1 > nmax1 + 1)
+        nm1 = nmax1 + 1;
+
+
+    size = nm1 * size_m1;
+    cnm1cnm3 = (REAL *)CHARM(malloc_aligned)(SIMD_MEMALIGN,
+                                             size * sizeof(REAL));
+    if (cnm1cnm3 == NULL)
+    {
+        FAILURE_glob = 1;
+        goto FAILURE;
+    }
+    cnm1snm3 = (REAL *)CHARM(malloc_aligned)(SIMD_MEMALIGN,
+                                             size * sizeof(REAL));
+    if (cnm1snm3 == NULL)
+    {
+        FAILURE_glob = 1;
+        goto FAILURE;
+    }
+    snm1cnm3 = (REAL *)CHARM(malloc_aligned)(SIMD_MEMALIGN,
+                                             size * sizeof(REAL));
+    if (snm1cnm3 == NULL)
+    {
+        FAILURE_glob = 1;
+        goto FAILURE;
+    }
+    snm1snm3 = (REAL *)CHARM(malloc_aligned)(SIMD_MEMALIGN,
+                                             size * sizeof(REAL));
+    if (snm1snm3 == NULL)
+    {
+        FAILURE_glob = 1;
+        goto FAILURE;
+    }
     /* --------------------------------------------------------------------- */
 
 
@@ -212,7 +389,9 @@ void CHARM(shs_cell_isurf)(const CHARM(cell) *cell,
 
 
     /* Synthesis of the mean values on the irregular surface.  No polar
-     * optimization is used here. */
+     * optimization is used here.  The contributions of the tiles are
+     * accumulated in "f", which is scaled to the mean values after the last
+     * tile. */
     /* --------------------------------------------------------------------- */
     REAL lon0 = cell->lonmin[0];
     DELTAlon = (REAL *)malloc(cell_nlon * sizeof(REAL));
@@ -225,15 +404,28 @@ void CHARM(shs_cell_isurf)(const CHARM(cell) *cell,
         DELTAlon[j] = cell->lonmax[j] - cell->lonmin[j];
 
 
-    REAL mur = shcs1->mu / shcs1->r;
+    memset(f, 0, cell->ncell * sizeof(REAL));
+
+
+    for (unsigned long m1min = 0; m1min <= nmax1; m1min += nm1)
+    {
+    unsigned long m1max = CHARM_MIN(m1min + nm1 - 1, nmax1);
+
+
+    CHARM(shs_cell_isurf_coeffs)(cnm1pnmj, snm1pnmj,
+                                 cnm3pnmj_sum, snm3pnmj_sum,
+                                 nmax1, nmax3, m1min, m1max,
+                                 cnm1cnm3, cnm1snm3, snm1cnm3, snm1snm3);
+
+
     size = (nmax1 + 1) * (nmax3 + 1) * SIMD_SIZE;
 
 
 #if HAVE_OPENMP
 #pragma omp parallel default(none) \
-shared(cell, DELTAlon, lon0, deltalon, cell_nlat, cell_nlon) \
+shared(cell, lon0, deltalon, cell_nlat, cell_nlon, m1min, m1max) \
 shared(nmax1, nmax3, f, cnm1cnm3, cnm1snm3, snm1cnm3, snm1snm3) \
-shared(FAILURE_glob, mur, size, err)
+shared(FAILURE_glob, size, err)
 #endif
     {
     /* ..................................................................... */
@@ -250,6 +442,8 @@ shared(FAILURE_glob, mur, size, err)
     REAL   *clt1v = NULL;
     REAL   *clt2v = NULL;
     REAL   *dcltv = NULL;
+    REAL     *ics = NULL;
+    REAL     *iss = NULL;
 
 
     /* Synthesized mean values for the "i"th grid row */
@@ -317,6 +511,22 @@ shared(FAILURE_glob, mur, size, err)
     }
 
 
+    /* Arrays to store the integrals "integ_cs" and "integ_ss" for a single
+     * latitude cell (see "ipt_lat") */
+    ics = (REAL *)malloc((nmax1 + 2 * nmax3 + 1) * sizeof(REAL));
+    if (ics == NULL)
+    {
+        FAILURE_priv = 1;
+        goto FAILURE_1_parallel;
+    }
+    iss = (REAL *)malloc((nmax1 + 2 * nmax3 + 1) * sizeof(REAL));
+    if (iss == NULL)
+    {
+        FAILURE_priv = 1;
+        goto FAILURE_1_parallel;
+    }
+
+
 FAILURE_1_parallel:
 #if HAVE_OPENMP
 #pragma omp critical
@@ -365,7 +575,6 @@ FAILURE_1_parallel:
     /* Useful substitutions */
     unsigned int parity;
     unsigned int rem_m1_2, rem_m3_2;
-    REAL dsigma;
     size_t row, ipv;
     size_t idx, idx2;
     REAL_SIMD tmp;
@@ -379,26 +588,6 @@ FAILURE_1_parallel:
     for (i = 0; i < SIMD_MULTIPLE(cell_nlat, SIMD_SIZE);
          i += SIMD_SIZE)
     {
-        /* Transformation of latitudes into co-latitudes */
-        for (size_t v = 0; v < SIMD_SIZE; v++)
-        {
-            ipv = i + v;
-            if (ipv < cell_nlat)
-            {
-                clt1v[v] = PI_2 - cell->latmax[ipv];
-                clt2v[v] = PI_2 - cell->latmin[ipv];
-            }
-            else
-            {
-                clt1v[v] = clt2v[v] = PREC(0.0);
-                continue;
-            }
-
-
-            dcltv[v] = clt2v[v] - clt1v[v];
-        }
-
-
         /* Reset "fi" to zeros */
         memset(fi, 0, cell_nlon * SIMD_SIZE * sizeof(REAL));
 
@@ -408,38 +597,8 @@ FAILURE_1_parallel:
 
 
         /* Pre-computation of the trigonometric integrals */
-        /* ----------------------------------------------------------------- */
-        idx2 = 0;
-
-
-        {
-        REAL k1d, k3d;
-        for (unsigned long k1 = 0; k1 <= nmax1; k1++)
-        {
-            k1d = (REAL)k1;
-            for (unsigned long k3 = 0; k3 <= nmax3; k3++)
-            {
-                k3d = (REAL)k3;
-
-
-                for (size_t v = 0; v < SIMD_SIZE; v++)
-                {
-                    ipt_ccs[idx2] = CHARM(integ_ccs)(clt1v[v], dcltv[v], k1d,
-                                                     k3d);
-                    ipt_css[idx2] = CHARM(integ_css)(clt1v[v], dcltv[v], k1d,
-                                                     k3d);
-                    ipt_scs[idx2] = CHARM(integ_scs)(clt1v[v], dcltv[v], k1d,
-                                                     k3d);
-                    ipt_sss[idx2] = CHARM(integ_sss)(clt1v[v], dcltv[v], k1d,
-                                                     k3d);
-
-
-                    idx2++;
-                }
-            }
-        }
-        }
-        /* ----------------------------------------------------------------- */
+        ipt_lat(cell, i, nmax1, nmax3, clt1v, clt2v, dcltv, ics, iss,
+                ipt_ccs, ipt_css, ipt_scs, ipt_sss);
 
 
 
@@ -448,7 +607,7 @@ FAILURE_1_parallel:
 
         /* Loop over the harmonic orders of the first spherical harmonic
          * function */
-        for (unsigned long m1 = 0; m1 <= nmax1; m1++)
+        for (unsigned long m1 = m1min; m1 <= m1max; m1++)
         {
             rem_m1_2 = m1 % 2;
 
@@ -491,10 +650,10 @@ FAILURE_1_parallel:
                 for (unsigned long k3 = 0; k3 <= nmax3; k3++)
                 {
                     tmp = LOAD_R(&ipt_ccs[idx2]);
-                    lc00 = ADD_R(lc00, MUL_R(tmp, SET1_R(cnm1cnm3[idx])));
-                    lc01 = ADD_R(lc01, MUL_R(tmp, SET1_R(cnm1snm3[idx])));
-                    lc10 = ADD_R(lc10, MUL_R(tmp, SET1_R(snm1cnm3[idx])));
-                    lc11 = ADD_R(lc11, MUL_R(tmp, SET1_R(snm1snm3[idx])));
+                    lc00 = FMA_R(tmp, SET1_R(cnm1cnm3[idx]), lc00);
+                    lc01 = FMA_R(tmp, SET1_R(cnm1snm3[idx]), lc01);
+                    lc10 = FMA_R(tmp, SET1_R(snm1cnm3[idx]), lc10);
+                    lc11 = FMA_R(tmp, SET1_R(snm1snm3[idx]), lc11);
 
 
                     idx++;
@@ -510,10 +669,10 @@ FAILURE_1_parallel:
                 for (unsigned long k3 = 0; k3 <= nmax3; k3++)
                 {
                     tmp = LOAD_R(&ipt_css[idx2]);
-                    lc00 = ADD_R(lc00, MUL_R(tmp, SET1_R(cnm1cnm3[idx])));
-                    lc01 = ADD_R(lc01, MUL_R(tmp, SET1_R(cnm1snm3[idx])));
-                    lc10 = ADD_R(lc10, MUL_R(tmp, SET1_R(snm1cnm3[idx])));
-                    lc11 = ADD_R(lc11, MUL_R(tmp, SET1_R(snm1snm3[idx])));
+                    lc00 = FMA_R(tmp, SET1_R(cnm1cnm3[idx]), lc00);
+                    lc01 = FMA_R(tmp, SET1_R(cnm1snm3[idx]), lc01);
+                    lc10 = FMA_R(tmp, SET1_R(snm1cnm3[idx]), lc10);
+                    lc11 = FMA_R(tmp, SET1_R(snm1snm3[idx]), lc11);
 
 
                     idx++;
@@ -529,10 +688,10 @@ FAILURE_1_parallel:
                 for (unsigned long k3 = 0; k3 <= nmax3; k3++)
                 {
                     tmp = LOAD_R(&ipt_scs[idx2]);
-                    lc00 = ADD_R(lc00, MUL_R(tmp, SET1_R(cnm1cnm3[idx])));
-                    lc01 = ADD_R(lc01, MUL_R(tmp, SET1_R(cnm1snm3[idx])));
-                    lc10 = ADD_R(lc10, MUL_R(tmp, SET1_R(snm1cnm3[idx])));
-                    lc11 = ADD_R(lc11, MUL_R(tmp, SET1_R(snm1snm3[idx])));
+                    lc00 = FMA_R(tmp, SET1_R(cnm1cnm3[idx]), lc00);
+                    lc01 = FMA_R(tmp, SET1_R(cnm1snm3[idx]), lc01);
+                    lc10 = FMA_R(tmp, SET1_R(snm1cnm3[idx]), lc10);
+                    lc11 = FMA_R(tmp, SET1_R(snm1snm3[idx]), lc11);
 
 
                     idx++;
@@ -548,10 +707,10 @@ FAILURE_1_parallel:
                 for (unsigned long k3 = 0; k3 <= nmax3; k3++)
                 {
                     tmp = LOAD_R(&ipt_sss[idx2]);
-                    lc00 = ADD_R(lc00, MUL_R(tmp, SET1_R(cnm1cnm3[idx])));
-                    lc01 = ADD_R(lc01, MUL_R(tmp, SET1_R(cnm1snm3[idx])));
-                    lc10 = ADD_R(lc10, MUL_R(tmp, SET1_R(snm1cnm3[idx])));
-                    lc11 = ADD_R(lc11, MUL_R(tmp, SET1_R(snm1snm3[idx])));
+                    lc00 = FMA_R(tmp, SET1_R(cnm1cnm3[idx]), lc00);
+                    lc01 = FMA_R(tmp, SET1_R(cnm1snm3[idx]), lc01);
+                    lc10 = FMA_R(tmp, SET1_R(snm1cnm3[idx]), lc10);
+                    lc11 = FMA_R(tmp, SET1_R(snm1snm3[idx]), lc11);
 
 
                     idx++;
@@ -570,7 +729,7 @@ FAILURE_1_parallel:
         }  /* End of the loop over "m1" */
 
 
-        /* Final synthesis */
+        /* Add the contribution of the tile */
         /* --------------------------------------------------------- */
         for (size_t v = 0; v < SIMD_SIZE; v++)
         {
@@ -580,18 +739,8 @@ FAILURE_1_parallel:
 
 
             row = ipv * cell_nlon;
-            dcltv[v] = COS(clt1v[v]) - COS(clt2v[v]);
-
-
             for (size_t j = 0; j < cell_nlon; j++)
-            {
-                /* Compute the area of the cells on the unit sphere */
-                dsigma = dcltv[v] * DELTAlon[j];
-
-
-                /* Final synthesis */
-                f[row + j] = (mur / dsigma) * fi[j * SIMD_SIZE + v];
-            }
+                f[row + j] += fi[j * SIMD_SIZE + v];
         }
         /* --------------------------------------------------------- */
 
@@ -610,9 +759,44 @@ FAILURE_2_parallel:
     CHARM(free_aligned)(clt1v);
     CHARM(free_aligned)(clt2v);
     CHARM(free_aligned)(dcltv);
+    free(ics);
+    free(iss);
+    /* --------------------------------------------------------------------- */
+
+
+    }
+
+
+    if (FAILURE_glob > 0)
+        goto FAILURE;
+    }  /* End of the loop over the tiles */
+
+
+    /* Final synthesis */
     /* --------------------------------------------------------------------- */
+    REAL mur = shcs1->mu / shcs1->r;
 
 
+    size_t i;
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) \
+shared(cell, DELTAlon, cell_nlat, cell_nlon, f, mur) private(i)
+#endif
+    for (i = 0; i < cell_nlat; i++)
+    {
+        size_t row = i * cell_nlon;
+        REAL dclt = COS(PI_2 - cell->latmax[i]) - COS(PI_2 - cell->latmin[i]);
+
+
+        for (size_t j = 0; j < cell_nlon; j++)
+        {
+            /* Compute the area of the cells on the unit sphere */
+            REAL dsigma = dclt * DELTAlon[j];
+
+
+            /* Final synthesis */
+            f[row + j] = (mur / dsigma) * f[row + j];
+        }
     }
     /* --------------------------------------------------------------------- */
 
@@ -630,6 +814,11 @@ FAILURE:
 
 
     free(DELTAlon);
+    CHARM(leg_pnmj_free)(pnmj);
+    CHARM(leg_pnmj_free)(cnm1pnmj);
+    CHARM(leg_pnmj_free)(snm1pnmj);
+    free(cnm3pnmj_sum);
+    free(snm3pnmj_sum);
     CHARM(free_aligned)(cnm1cnm3);
     CHARM(free_aligned)(cnm1snm3);
     CHARM(free_aligned)(snm1cnm3);
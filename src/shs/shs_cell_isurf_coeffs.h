@@ -15,11 +15,12 @@ extern "C"
 #endif
 
 
-extern void CHARM(shs_cell_isurf_coeffs)(const CHARM(shc) *, unsigned long,
-                                         const CHARM(shc) *, unsigned long,
+extern void CHARM(shs_cell_isurf_coeffs)(const CHARM(pnmj) *,
+                                         const CHARM(pnmj) *,
+                                         const REAL *, const REAL *,
                                          unsigned long, unsigned long,
-                                         REAL *, REAL *, REAL *,
-                                         REAL *, CHARM(err) *);
+                                         unsigned long, unsigned long,
+                                         REAL *, REAL *, REAL *, REAL *);
 
 
 #ifdef __cplusplus
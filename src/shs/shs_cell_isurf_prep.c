@@ -0,0 +1,346 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "shs_cell_isurf_prep.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(shs_cell_isurf_prep)(const CHARM(shc) *shcs1,
+                                unsigned long nmax1,
+                                const CHARM(shc) *shcs2,
+                                unsigned long nmax2,
+                                unsigned long nmax3,
+                                unsigned long nmax4,
+                                const CHARM(pnmj) *pnmj,
+                                CHARM(pnmj) *cnm1pnmj,
+                                CHARM(pnmj) *snm1pnmj,
+                                REAL *cnm3pnmj_sum,
+                                REAL *snm3pnmj_sum,
+                                CHARM(err) *err)
+/*
+ * ============================================================================
+ *
+ * DESCRIPTION: Prepares the quantities, from which the coefficients of the
+ *              potential on the irregular surface are assembled by
+ *              "CHARM(shs_cell_isurf_coeffs)".  Unlike the coefficients, the
+ *              quantities prepared here require only
+ *              "O((nmax1 + 1) * (nmax3 + 1)^2)" of memory.
+ *
+ *
+ * INPUTS: "shcs1", ..., "nmax4" -- All variables have the same meaning
+ *                                  as in "CHARM(shs_cell_isurf)", where
+ *                                  further details can be found.
+ *
+ *         "pnmj" -- Fourier coefficients of Legendre functions up to degree
+ *                   "CHARM_MAX(nmax1, nmax3)" ("CHARM_LEG_PMJN" ordering).
+ *
+ *
+ * OUTPUTS: "cnm1pnmj", "snm1pnmj" -- Products of "shcs1->c" and "shcs1->s"
+ *                        with "pnmj->pnmj".  Both structures must be
+ *                        initialized by "CHARM(leg_pnmj_calloc)" up to degree
+ *                        "nmax1" with the "CHARM_LEG_PMJN" ordering.
+ *
+ *          "cnm3pnmj_sum", "snm3pnmj_sum" -- Sums over "n3" of the products
+ *                        of "pnmj->pnmj" with the spherical harmonic
+ *                        coefficients of "(shcs1->r / r)^(n1 + 1)" for "n1 =
+ *                        0, 1, ..., nmax1".  The sums are stored in 3D arrays
+ *                        of dimensions "(nmax1 + 1) * (nmax3 + 1) * (nmax3 +
+ *                        1)".  The element "(n1, m3, k3)" holds the sum that
+ *                        contributes to the coefficients of "k3" in
+ *                        "CHARM(shs_cell_isurf_coeffs)", so that these can be
+ *                        computed by contiguous loops over "k3".  Sums that do
+ *                        not contribute to any "k3" are zero.
+ *
+ * ============================================================================
+ *
+ * */
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(point) *glg = NULL;
+    CHARM(shc) *shcs3 = NULL;
+    REAL *r           = NULL;
+    REAL *r_pow       = NULL;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Prepare the Gauss--Legendre grid */
+    /* --------------------------------------------------------------------- */
+    glg = CHARM(crd_point_gl)(nmax4, PREC(1.0));
+    if (glg == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       "Failed to initialize the Gauss--Legendre grid.");
+        goto FAILURE;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Synthesize the topography at the nodes of the Gauss--Legendre grid */
+    /* --------------------------------------------------------------------- */
+    r = (REAL *)malloc(glg->npoint * sizeof(REAL));
+    if (r == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE;
+    }
+
+
+    CHARM(shs_point)(glg, shcs2, nmax2, r, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto FAILURE;
+    }
+
+
+    /* "shcs1->r / r" */
+    size_t i;
+#if HAVE_OPENMP
+#pragma omp parallel for default(shared) private(i)
+#endif
+    for (i = 0; i < glg->npoint; i++)
+        r[i] = shcs1->r / r[i];
+
+
+    /* Array to store the "n + 1"th power of "shcs1->r / r" for "n = 0, 1, ...,
+     * nmax1" */
+    r_pow = (REAL *)malloc(glg->npoint * sizeof(REAL));
+    if (r_pow == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE;
+    }
+#if HAVE_OPENMP
+#pragma omp parallel for default(shared) private(i)
+#endif
+    for (i = 0; i < glg->npoint; i++)
+        r_pow[i] = PREC(1.0);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Initialize the spherical harmonic coefficients for the "n + 1"th power
+     * */
+    /* --------------------------------------------------------------------- */
+    shcs3 = CHARM(shc_calloc)(nmax3, PREC(1.0), PREC(1.0));
+    if (shcs3 == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       "Failed to initialize the \"shc\" structure.");
+        goto FAILURE;
+    }
+
+
+    REAL *cnm3_m3, *snm3_m3;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Useful substitutions */
+    /* --------------------------------------------------------------------- */
+    unsigned long j3pj3, k3;
+    unsigned long nmax3_2 = nmax3 / 2;
+    unsigned long max_m1_j1, max_m3_j3;
+    size_t nsum = (size_t)(nmax3 + 1) * (nmax3 + 1);
+    REAL *pnmj_m1_j1, *pnmj_m3_j3;
+    REAL **cnm1pnmj_m1, *cnm1pnmj_m1_j1;
+    REAL **snm1pnmj_m1, *snm1pnmj_m1_j1;
+    REAL *cnm3pnmj_sum_n1, *snm3pnmj_sum_n1;
+    REAL c_sum1, c_sum2, s_sum1, s_sum2;
+    size_t row;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Products of "shcs1" with the Fourier coefficients of Legendre functions
+     * */
+    /* --------------------------------------------------------------------- */
+    unsigned long m1;
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) \
+shared(shcs1, cnm1pnmj, snm1pnmj, pnmj, nmax1) \
+private(cnm1pnmj_m1, cnm1pnmj_m1_j1, snm1pnmj_m1, snm1pnmj_m1_j1) \
+private(m1, pnmj_m1_j1, max_m1_j1)
+#endif
+    for (m1 = 0; m1 <= nmax1; m1++)
+    {
+        cnm1pnmj_m1 = cnm1pnmj->pnmj[m1];
+        snm1pnmj_m1 = snm1pnmj->pnmj[m1];
+
+
+        for (unsigned long j1 = 0; j1 <= (nmax1 / 2); j1++)
+        {
+            max_m1_j1 = CHARM_MAX(m1, j1 + j1);
+
+
+            cnm1pnmj_m1_j1 = cnm1pnmj_m1[j1];
+            snm1pnmj_m1_j1 = snm1pnmj_m1[j1];
+            pnmj_m1_j1     = pnmj->pnmj[m1][j1];
+
+
+            for (unsigned long n1 = max_m1_j1; n1 <= nmax1; n1++)
+            {
+                cnm1pnmj_m1_j1[n1 - max_m1_j1] = shcs1->c[m1][n1 - m1] *
+                                                 pnmj_m1_j1[n1 - max_m1_j1];
+                snm1pnmj_m1_j1[n1 - max_m1_j1] = shcs1->s[m1][n1 - m1] *
+                                                 pnmj_m1_j1[n1 - max_m1_j1];
+            }
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Sums over "n3" for all "n1" */
+    /* --------------------------------------------------------------------- */
+    for (unsigned long n1 = 0; n1 <= nmax1; n1++)
+    {
+        /* Compute the "n1 + 1"th power of the topographic surface and its
+         * spherical harmonic coefficients */
+        /* ................................................................. */
+#if HAVE_OPENMP
+#pragma omp parallel for default(shared) private(i)
+#endif
+        for (i = 0; i < glg->npoint; i++)
+            r_pow[i] *= r[i];
+
+
+        CHARM(sha_point)(glg, r_pow, nmax3, shcs3, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto FAILURE;
+        }
+        /* ................................................................. */
+
+
+        /* Pre-compute the summation over "n3" */
+        /* ................................................................. */
+        cnm3pnmj_sum_n1 = cnm3pnmj_sum + n1 * nsum;
+        snm3pnmj_sum_n1 = snm3pnmj_sum + n1 * nsum;
+
+
+        unsigned long m3;
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) \
+shared(nmax3, nmax3_2, pnmj, shcs3, cnm3pnmj_sum_n1, snm3pnmj_sum_n1) \
+private(j3pj3, k3, max_m3_j3, row, pnmj_m3_j3) \
+private(c_sum1, c_sum2, s_sum1, s_sum2, m3, cnm3_m3, snm3_m3)
+#endif
+        for (m3 = 0; m3 <= nmax3; m3++)
+        {
+            cnm3_m3 = shcs3->c[m3];
+            snm3_m3 = shcs3->s[m3];
+            row     = m3 * (nmax3 + 1);
+
+
+            for (k3 = 0; k3 <= nmax3; k3++)
+                cnm3pnmj_sum_n1[row + k3] = snm3pnmj_sum_n1[row + k3] =
+                    PREC(0.0);
+
+
+            for (unsigned long j3 = 0; j3 <= nmax3_2; j3++)
+            {
+                j3pj3     = j3 + j3;
+                max_m3_j3 = CHARM_MAX(m3, j3pj3);
+
+
+                c_sum1 = c_sum2 = PREC(0.0);
+                s_sum1 = s_sum2 = PREC(0.0);
+                pnmj_m3_j3      = pnmj->pnmj[m3][j3];
+
+
+                {
+                unsigned long n3;
+                for (n3 = max_m3_j3; n3 < nmax3; n3 += 2)
+                {
+                    c_sum1 += cnm3_m3[n3 - m3] * pnmj_m3_j3[n3 - max_m3_j3];
+                    s_sum1 += snm3_m3[n3 - m3] * pnmj_m3_j3[n3 - max_m3_j3];
+
+
+                    c_sum2 += cnm3_m3[n3 + 1 - m3] *
+                              pnmj_m3_j3[n3 + 1 - max_m3_j3];
+                    s_sum2 += snm3_m3[n3 + 1 - m3] *
+                              pnmj_m3_j3[n3 + 1 - max_m3_j3];
+                }
+
+
+                if (n3 == nmax3)
+                {
+                    c_sum1 += cnm3_m3[n3 - m3] * pnmj_m3_j3[n3 - max_m3_j3];
+                    s_sum1 += snm3_m3[n3 - m3] * pnmj_m3_j3[n3 - max_m3_j3];
+                }
+                }
+
+
+                /* The first sum contributes to "k3", the second one to
+                 * "k3 - 1" or "k3 + 1" */
+                k3 = (max_m3_j3 % 2) + j3pj3;
+                cnm3pnmj_sum_n1[row + k3] = c_sum1;
+                snm3pnmj_sum_n1[row + k3] = s_sum1;
+
+
+                if (max_m3_j3 < nmax3)
+                {
+                    k3 = (k3 % 2) ? k3 - 1 : k3 + 1;
+                    cnm3pnmj_sum_n1[row + k3] = c_sum2;
+                    snm3pnmj_sum_n1[row + k3] = s_sum2;
+                }
+            }
+        }
+        /* ................................................................. */
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Free the heap memory */
+    /* --------------------------------------------------------------------- */
+FAILURE:
+    CHARM(crd_point_free)(glg);
+    free(r);
+    free(r_pow);
+    CHARM(shc_free)(shcs3);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    return;
+}
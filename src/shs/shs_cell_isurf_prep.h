@@ -0,0 +1,31 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_CELL_ISURF_PREP_H__
+#define __SHS_CELL_ISURF_PREP_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shs_cell_isurf_prep)(const CHARM(shc) *, unsigned long,
+                                       const CHARM(shc) *, unsigned long,
+                                       unsigned long, unsigned long,
+                                       const CHARM(pnmj) *,
+                                       CHARM(pnmj) *, CHARM(pnmj) *,
+                                       REAL *, REAL *, CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -17,40 +17,40 @@
 
 
 /* Returns summations over harmonic degrees, "a", "b", "a2" and "b2", for
- * synthesis with mean values.  The function also updates "imm0", "imm1" and
- * "imm2". */
-void CHARM(shs_cell_kernel)(unsigned long nmax,
-                            unsigned long m,
-                            const CHARM(shc) *shcs,
-                            const REAL *anm,
-                            const REAL *bnm,
-                            REAL_SIMD latmin,
-                            REAL_SIMD latmax,
-                            REAL_SIMD t1,
-                            REAL_SIMD t2,
-                            REAL_SIMD u1,
-                            REAL_SIMD u2,
-                            const REAL *ps1,
-                            const REAL *ps2,
-                            const INT *ips1,
-                            const INT *ips2,
-                            REAL_SIMD *imm0,
-                            REAL_SIMD *imm1,
-                            REAL_SIMD *imm2,
-                            const REAL *en,
-                            const REAL *fn,
-                            const REAL *gm,
-                            const REAL *hm,
-                            const REAL *ri,
-                            REAL_SIMD ratio,
-                            REAL_SIMD ratio2,
-                            REAL_SIMD ratiom,
-                            REAL_SIMD ratio2m,
-                            REAL_SIMD symm_simd,
-                            REAL_SIMD *a,
-                            REAL_SIMD *b,
-                            REAL_SIMD *a2,
-                            REAL_SIMD *b2)
+ * synthesis with mean values for a single vector of "SIMD_SIZE" latitudes.
+ * The function also updates "imm0", "imm1" and "imm2". */
+static void cell_kernel(unsigned long nmax,
+                        unsigned long m,
+                        const CHARM(shc) *shcs,
+                        const REAL *anm,
+                        const REAL *bnm,
+                        REAL_SIMD latmin,
+                        REAL_SIMD latmax,
+                        REAL_SIMD t1,
+                        REAL_SIMD t2,
+                        REAL_SIMD u1,
+                        REAL_SIMD u2,
+                        const REAL *ps1,
+                        const REAL *ps2,
+                        const INT *ips1,
+                        const INT *ips2,
+                        REAL_SIMD *imm0,
+                        REAL_SIMD *imm1,
+                        REAL_SIMD *imm2,
+                        const REAL *en,
+                        const REAL *fn,
+                        const REAL *gm,
+                        const REAL *hm,
+                        const REAL *ri,
+                        REAL_SIMD ratio,
+                        REAL_SIMD ratio2,
+                        REAL_SIMD ratiom,
+                        REAL_SIMD ratio2m,
+                        REAL_SIMD symm_simd,
+                        REAL_SIMD *a,
+                        REAL_SIMD *b,
+                        REAL_SIMD *a2,
+                        REAL_SIMD *b2)
 {
     REAL_SIMD w;
     REAL_SIMD x1, x2, y1, y2, z1, z2;
@@ -82,7 +82,7 @@ void CHARM(shs_cell_kernel)(unsigned long nmax,
 
     _Bool npm_even; /* True if "n + m" is even */
     unsigned long nmm; /* "n - m" */
-    _Bool symm = CHARM(shs_check_symm_simd)(symm_simd);
+    _Bool symm = SIMD_ISA_NAME(shs_check_symm_simd)(symm_simd);
     _Bool ds1, ds2; /* Dynamical switching */
 
 
@@ -156,12 +156,12 @@ void CHARM(shs_cell_kernel)(unsigned long nmax,
                  * Legendre polynomials. These are needed to get the integrals
                  * of fully-normalized Legendre polynomials */
                 /* ......................................................... */
-                pnm2_latmin = SUB_R(MUL_R(SET1_R(en[n + 1]),
-                                          MUL_R(t1, pnm1_latmin)),
-                                    MUL_R(SET1_R(fn[n + 1]), pnm0_latmin));
-                pnm2_latmax = SUB_R(MUL_R(SET1_R(en[n + 1]),
-                                          MUL_R(t2, pnm1_latmax)),
-                                    MUL_R(SET1_R(fn[n + 1]), pnm0_latmax));
+                pnm2_latmin = FNMA_R(SET1_R(fn[n + 1]), pnm0_latmin,
+                                     MUL_R(SET1_R(en[n + 1]),
+                                           MUL_R(t1, pnm1_latmin)));
+                pnm2_latmax = FNMA_R(SET1_R(fn[n + 1]), pnm0_latmax,
+                                     MUL_R(SET1_R(en[n + 1]),
+                                           MUL_R(t2, pnm1_latmax)));
                 /* ......................................................... */
 
 
@@ -177,15 +177,15 @@ void CHARM(shs_cell_kernel)(unsigned long nmax,
                 /* Lumped coefficients */
                 /* ......................................................... */
                 inm_cnm = MUL_R(in0, SET1_R(shcs->c[0][n]));
-                *a      = ADD_R(*a, MUL_R(ration, inm_cnm));
+                *a      = FMA_R(ration, inm_cnm, *a);
                 ration  = MUL_R(ration, ratio);
 
                 if (symm)
                 {
                     if (npm_even)
-                        *a2 = ADD_R(*a2, MUL_R(ratio2n, inm_cnm));
+                        *a2 = FMA_R(ratio2n, inm_cnm, *a2);
                     else
-                        *a2 = SUB_R(*a2, MUL_R(ratio2n, inm_cnm));
+                        *a2 = FNMA_R(ratio2n, inm_cnm, *a2);
 
 
                     ratio2n = MUL_R(ratio2n, ratio2);
@@ -215,8 +215,8 @@ void CHARM(shs_cell_kernel)(unsigned long nmax,
 
         /* Pmm for "latmin" */
 #ifdef SIMD
-        PNM_SECTORIAL_XNUM_SIMD(x1, ix1, ps1[(m - 1) * SIMD_SIZE],
-                                ips1[(m - 1) * SIMD_SIZE], pnm0_latmin,
+        PNM_SECTORIAL_XNUM_SIMD(x1, ix1, ps1[(m - 1) * SIMD_LAYOUT],
+                                ips1[(m - 1) * SIMD_LAYOUT], pnm0_latmin,
                                 BIG_r, zero_r, zero_ri, mone_ri, mask1, mask2,
                                 SECTORIALS1);
 #else
@@ -226,8 +226,8 @@ void CHARM(shs_cell_kernel)(unsigned long nmax,
 
         /* Pmm for "latmax" */
 #ifdef SIMD
-        PNM_SECTORIAL_XNUM_SIMD(x2, ix2, ps2[(m - 1) * SIMD_SIZE],
-                                ips2[(m - 1) * SIMD_SIZE], pnm0_latmax,
+        PNM_SECTORIAL_XNUM_SIMD(x2, ix2, ps2[(m - 1) * SIMD_LAYOUT],
+                                ips2[(m - 1) * SIMD_LAYOUT], pnm0_latmax,
                                 BIG_r, zero_r, zero_ri, mone_ri, mask1, mask2,
                                 SECTORIALS2);
 #else
@@ -342,15 +342,15 @@ void CHARM(shs_cell_kernel)(unsigned long nmax,
             inm_snm = MUL_R(inm1, SET1_R(shcs->s[m][1]));
 
 
-            *a     = ADD_R(*a, MUL_R(ration, inm_cnm));
-            *b     = ADD_R(*b, MUL_R(ration, inm_snm));
+            *a     = FMA_R(ration, inm_cnm, *a);
+            *b     = FMA_R(ration, inm_snm, *b);
             ration = MUL_R(ration, ratio);
 
 
             if (symm)
             {
-                *a2     = SUB_R(*a2, MUL_R(ratio2n, inm_cnm));
-                *b2     = SUB_R(*b2, MUL_R(ratio2n, inm_snm));
+                *a2     = FNMA_R(ratio2n, inm_cnm, *a2);
+                *b2     = FNMA_R(ratio2n, inm_snm, *b2);
                 ratio2n = MUL_R(ratio2n, ratio2);
             }
             /* ............................................................. */
@@ -427,8 +427,8 @@ void CHARM(shs_cell_kernel)(unsigned long nmax,
                 inm_snm = MUL_R(inm2, SET1_R(shcs->s[m][nmm]));
 
 
-                *a     = ADD_R(*a, MUL_R(ration, inm_cnm));
-                *b     = ADD_R(*b, MUL_R(ration, inm_snm));
+                *a     = FMA_R(ration, inm_cnm, *a);
+                *b     = FMA_R(ration, inm_snm, *b);
                 ration = MUL_R(ration, ratio);
 
 
@@ -436,13 +436,13 @@ void CHARM(shs_cell_kernel)(unsigned long nmax,
                 {
                     if (npm_even)
                     {
-                        *a2 = ADD_R(*a2, MUL_R(ratio2n, inm_cnm));
-                        *b2 = ADD_R(*b2, MUL_R(ratio2n, inm_snm));
+                        *a2 = FMA_R(ratio2n, inm_cnm, *a2);
+                        *b2 = FMA_R(ratio2n, inm_snm, *b2);
                     }
                     else
                     {
-                        *a2 = SUB_R(*a2, MUL_R(ratio2n, inm_cnm));
-                        *b2 = SUB_R(*b2, MUL_R(ratio2n, inm_snm));
+                        *a2 = FNMA_R(ratio2n, inm_cnm, *a2);
+                        *b2 = FNMA_R(ratio2n, inm_snm, *b2);
                     }
 
 
@@ -474,3 +474,66 @@ void CHARM(shs_cell_kernel)(unsigned long nmax,
     return;
 }
 
+
+
+
+
+
+/* Returns summations over harmonic degrees, "a", "b", "a2" and "b2", for
+ * synthesis with mean values.  The function also updates "imm0", "imm1" and
+ * "imm2".
+ *
+ * The latitude-dependent variables are passed by pointers, so that the
+ * function can be called from a translation unit compiled for another
+ * instruction set.  Their "SIMD_LAYOUT" elements are processed as
+ * "SIMD_SPLIT" vectors of "SIMD_SIZE" elements. */
+void SIMD_ISA_NAME(shs_cell_kernel)(unsigned long nmax,
+                                    unsigned long m,
+                                    const CHARM(shc) *shcs,
+                                    const REAL *anm,
+                                    const REAL *bnm,
+                                    const REAL_SIMD *latmin,
+                                    const REAL_SIMD *latmax,
+                                    const REAL_SIMD *t1,
+                                    const REAL_SIMD *t2,
+                                    const REAL_SIMD *u1,
+                                    const REAL_SIMD *u2,
+                                    const REAL *ps1,
+                                    const REAL *ps2,
+                                    const INT *ips1,
+                                    const INT *ips2,
+                                    REAL_SIMD *imm0,
+                                    REAL_SIMD *imm1,
+                                    REAL_SIMD *imm2,
+                                    const REAL *en,
+                                    const REAL *fn,
+                                    const REAL *gm,
+                                    const REAL *hm,
+                                    const REAL *ri,
+                                    const REAL_SIMD *ratio,
+                                    const REAL_SIMD *ratio2,
+                                    const REAL_SIMD *ratiom,
+                                    const REAL_SIMD *ratio2m,
+                                    const REAL_SIMD *symm_simd,
+                                    REAL_SIMD *a,
+                                    REAL_SIMD *b,
+                                    REAL_SIMD *a2,
+                                    REAL_SIMD *b2)
+{
+    for (size_t j = 0; j < SIMD_SPLIT; j++)
+        cell_kernel(nmax, m, shcs, anm, bnm,
+                    latmin[j], latmax[j],
+                    t1[j], t2[j],
+                    u1[j], u2[j],
+                    ps1 + j * SIMD_SIZE, ps2 + j * SIMD_SIZE,
+                    ips1 + j * SIMD_SIZE, ips2 + j * SIMD_SIZE,
+                    imm0 + j, imm1 + j, imm2 + j,
+                    en, fn, gm, hm, ri,
+                    ratio[j], ratio2[j],
+                    ratiom[j], ratio2m[j],
+                    symm_simd[j],
+                    a + j, b + j, a2 + j, b2 + j);
+
+
+    return;
+}
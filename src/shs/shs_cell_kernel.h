@@ -16,37 +16,37 @@ extern "C"
 #endif
 
 
-extern void CHARM(shs_cell_kernel)(unsigned long, unsigned long,
-                                   const CHARM(shc) *,
-                                   const REAL *,
-                                   const REAL *,
-                                   REAL_SIMD,
-                                   REAL_SIMD,
-                                   REAL_SIMD,
-                                   REAL_SIMD,
-                                   REAL_SIMD,
-                                   REAL_SIMD,
-                                   const REAL *,
-                                   const REAL *,
-                                   const INT *,
-                                   const INT *,
-                                   REAL_SIMD *,
-                                   REAL_SIMD *,
-                                   REAL_SIMD *,
-                                   const REAL *,
-                                   const REAL *,
-                                   const REAL *,
-                                   const REAL *,
-                                   const REAL *,
-                                   REAL_SIMD,
-                                   REAL_SIMD,
-                                   REAL_SIMD,
-                                   REAL_SIMD,
-                                   REAL_SIMD,
-                                   REAL_SIMD *,
-                                   REAL_SIMD *,
-                                   REAL_SIMD *,
-                                   REAL_SIMD *);
+extern void SIMD_ISA_NAME(shs_cell_kernel)(unsigned long, unsigned long,
+                                           const CHARM(shc) *,
+                                           const REAL *,
+                                           const REAL *,
+                                           const REAL_SIMD *,
+                                           const REAL_SIMD *,
+                                           const REAL_SIMD *,
+                                           const REAL_SIMD *,
+                                           const REAL_SIMD *,
+                                           const REAL_SIMD *,
+                                           const REAL *,
+                                           const REAL *,
+                                           const INT *,
+                                           const INT *,
+                                           REAL_SIMD *,
+                                           REAL_SIMD *,
+                                           REAL_SIMD *,
+                                           const REAL *,
+                                           const REAL *,
+                                           const REAL *,
+                                           const REAL *,
+                                           const REAL *,
+                                           const REAL_SIMD *,
+                                           const REAL_SIMD *,
+                                           const REAL_SIMD *,
+                                           const REAL_SIMD *,
+                                           const REAL_SIMD *,
+                                           REAL_SIMD *,
+                                           REAL_SIMD *,
+                                           REAL_SIMD *,
+                                           REAL_SIMD *);
 
 
 #ifdef __cplusplus
@@ -5,7 +5,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include "../prec.h"
-#include "shs_cell_kernel.h"
+#include "shs_kernels.h"
 #include "shs_sctr_mulc.h"
 #include "../leg/leg_func_anm_bnm.h"
 #include "../leg/leg_func_dm.h"
@@ -169,7 +169,7 @@ void CHARM(shs_cell_sctr)(const CHARM(cell) *cell, const CHARM(shc) *shcs,
 #if HAVE_OPENMP
 #pragma omp parallel default(none) \
 shared(f, shcs, nmax, cell, dm, en, fn, gm, hm, r, ri, pt) \
-shared(ncell, FAILURE_glob, mur, err, rref)
+shared(ncell, FAILURE_glob, mur, err, rref) SHS_KERNEL_VARS
 #endif
     {
         /* ................................................................. */
@@ -381,6 +381,11 @@ FAILURE_1_parallel:
         ratio = ratiom = SET_ZERO_R;
 
 
+        /* The symmetry of Legendre functions cannot be utilized with
+         * scattered cells, hence "zero" for the symmetry-related variables */
+        const REAL_SIMD zero = SET_ZERO_R;
+
+
         REAL_SIMD a, b, a2, b2;
         a = b = a2 = b2 = SET_ZERO_R;
         REAL_SIMD imm0, imm1, imm2;
@@ -464,18 +469,18 @@ FAILURE_1_parallel:
 
 
                 /* Summation over harmonic degrees */
-                CHARM(shs_cell_kernel)(nmax, m, shcs, anm, bnm,
-                                       latmin, latmax,
-                                       t1, t2,
-                                       u1, u2,
-                                       ps1, ps2,
-                                       ips1, ips2,
-                                       &imm0, &imm1, &imm2,
-                                       en, fn, gm, hm, ri,
-                                       ratio, SET_ZERO_R,
-                                       ratiom, SET_ZERO_R,
-                                       SET_ZERO_R,
-                                       &a, &b, &a2, &b2);
+                SHS_KERNEL(shs_cell_kernel)(nmax, m, shcs, anm, bnm,
+                                            &latmin, &latmax,
+                                            &t1, &t2,
+                                            &u1, &u2,
+                                            ps1, ps2,
+                                            ips1, ips2,
+                                            &imm0, &imm1, &imm2,
+                                            en, fn, gm, hm, ri,
+                                            &ratio, &zero,
+                                            &ratiom, &zero,
+                                            &zero,
+                                            &a, &b, &a2, &b2);
 
 
                 /* The longitudinal part of the synthesis */
@@ -525,7 +530,8 @@ UPDATE_RATIOS:
 
 
             fi = DIV_R(fi, dsigma);
-            CHARM(shs_sctr_mulc)(i, ncell, cell->type, mur, tmp, tmpv, &fi, f);
+            CHARM(shs_sctr_mulc)(i, ncell, SIMD_BLOCK_S, cell->type, mur, tmp,
+                                 tmpv, &fi, f);
             /* ------------------------------------------------------------- */
 
 
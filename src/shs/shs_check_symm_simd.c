@@ -15,7 +15,7 @@
 /* An internal function to determine whether or not the symmetry of Legendre
  * functions has to be applied for a given SIMD vector (or a scalar, depending
  * on the "SIMD_REAL" macro). */
-_Bool CHARM(shs_check_symm_simd)(REAL_SIMD v)
+_Bool SIMD_ISA_NAME(shs_check_symm_simd)(REAL_SIMD v)
 {
     if (!MASK_TRUE_ALL((EQ_R(v, SET_ZERO_R))))
         return 1;
@@ -16,7 +16,7 @@ extern "C"
 #endif
 
 
-extern _Bool CHARM(shs_check_symm_simd)(REAL_SIMD);
+extern _Bool SIMD_ISA_NAME(shs_check_symm_simd)(REAL_SIMD);
 
 
 #ifdef __cplusplus
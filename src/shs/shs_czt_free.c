@@ -0,0 +1,51 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../misc/misc_fftw_plans.h"
+#include "shs_czt_struct.h"
+#include "shs_czt_free.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to free a "CHARM(shs_czt)" structure.  No operation is
+ * performed if "czt" is "NULL". */
+void CHARM(shs_czt_free)(CHARM(shs_czt) *czt)
+{
+    if (czt == NULL)
+        return;
+
+
+    FFTW(free)(czt->pre);
+    FFTW(free)(czt->post);
+    FFTW(free)(czt->kernel);
+    FFTW(free)(czt->tmp);
+
+
+    if ((czt->plan_fwd != NULL) || (czt->plan_bwd != NULL))
+    {
+        if (czt->plan_fwd != NULL)
+            FFTW(destroy_plan)(czt->plan_fwd);
+        if (czt->plan_bwd != NULL)
+            FFTW(destroy_plan)(czt->plan_bwd);
+        if (czt->cache)
+        {
+            CHARM(misc_fftw_plans_remove)();
+            CHARM(misc_fftw_plans_remove)();
+        }
+        CHARM(misc_fftw_cleanup)();
+    }
+
+
+    free(czt);
+
+
+    return;
+}
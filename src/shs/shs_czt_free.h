@@ -0,0 +1,27 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_CZT_FREE_H__
+#define __SHS_CZT_FREE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shs_czt_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shs_czt_free)(CHARM(shs_czt) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
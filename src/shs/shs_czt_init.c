@@ -0,0 +1,148 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../misc/misc_fftw_plans.h"
+#include "shs_czt_struct.h"
+#include "shs_czt_free.h"
+#include "shs_czt_len.h"
+#include "shs_czt_init.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns "exp(i * phase)" */
+static void cexpi(REAL phase,
+                  FFTWC(complex) z)
+{
+    z[0] = COS(phase);
+    z[1] = SIN(phase);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Internal function to prepare the chirp-z transform from the orders "m = 0,
+ * 1, ..., nmax" to "nlon" longitudes "lon0 + j * deltalon" (see
+ * "shs_czt_struct.h").  "fftw_flags" is the planning rigor of the FFTW plans.
+ * With "cache == 1", the FFTW plans are registered by "misc_fftw_plans_add",
+ * so that they survive "misc_fftw_cleanup" calls.  Returns "NULL" on
+ * failure. */
+CHARM(shs_czt) *CHARM(shs_czt_init)(unsigned long nmax,
+                                    size_t nlon,
+                                    REAL lon0,
+                                    REAL deltalon,
+                                    unsigned fftw_flags,
+                                    _Bool cache)
+{
+    CHARM(shs_czt) *czt = (CHARM(shs_czt) *)calloc(1, sizeof(CHARM(shs_czt)));
+    if (czt == NULL)
+        return NULL;
+
+
+    const size_t len = CHARM(shs_czt_len)(nmax, nlon);
+    czt->nmax        = nmax;
+    czt->nlon        = nlon;
+    czt->len         = len;
+
+
+    czt->pre    = (FFTWC(complex) *)FFTW(malloc)((nmax + 1) *
+                                                 sizeof(FFTWC(complex)));
+    czt->post   = (FFTWC(complex) *)FFTW(malloc)(nlon *
+                                                 sizeof(FFTWC(complex)));
+    czt->kernel = (FFTWC(complex) *)FFTW(malloc)(len *
+                                                 sizeof(FFTWC(complex)));
+    czt->tmp    = (FFTWC(complex) *)FFTW(malloc)(len *
+                                                 sizeof(FFTWC(complex)));
+    if ((czt->pre == NULL) || (czt->post == NULL) || (czt->kernel == NULL) ||
+        (czt->tmp == NULL))
+        goto FAILURE;
+
+
+    /* The planning may overwrite "tmp", so the plans are created before
+     * anything is stored in it */
+    czt->plan_fwd = FFTW(plan_dft_1d)((int)len, czt->tmp, czt->tmp,
+                                      FFTW_FORWARD, fftw_flags);
+    czt->plan_bwd = FFTW(plan_dft_1d)((int)len, czt->tmp, czt->tmp,
+                                      FFTW_BACKWARD, fftw_flags);
+    if ((czt->plan_fwd == NULL) || (czt->plan_bwd == NULL))
+        goto FAILURE;
+    if (cache)
+    {
+        CHARM(misc_fftw_plans_add)();
+        CHARM(misc_fftw_plans_add)();
+        czt->cache = 1;
+    }
+
+
+    /* The squares of the integers are exact, so the phases are accurate up
+     * to the rounding of the final product */
+    const REAL dl2 = deltalon / PREC(2.0);
+    REAL k2;
+
+
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        k2 = (REAL)m * (REAL)m;
+        cexpi((REAL)m * lon0 + dl2 * k2, czt->pre[m]);
+        if (m > 0)
+        {
+            czt->pre[m][0] *= PREC(2.0);
+            czt->pre[m][1] *= PREC(2.0);
+        }
+    }
+
+
+    for (size_t j = 0; j < nlon; j++)
+    {
+        k2 = (REAL)j * (REAL)j;
+        cexpi(dl2 * k2, czt->post[j]);
+    }
+
+
+    /* The kernel "exp(-i * deltalon * k^2 / 2)" is stored in the cyclic
+     * order, that is, "k = 0, ..., nlon - 1" at the beginning of "tmp" and
+     * "k = -nmax, ..., -1" at its end */
+    for (size_t k = 0; k < len; k++)
+        czt->tmp[k][0] = czt->tmp[k][1] = PREC(0.0);
+    for (size_t k = 0; k < nlon; k++)
+    {
+        k2 = (REAL)k * (REAL)k;
+        cexpi(-dl2 * k2, czt->tmp[k]);
+    }
+    for (unsigned long k = 1; k <= nmax; k++)
+    {
+        k2 = (REAL)k * (REAL)k;
+        cexpi(-dl2 * k2, czt->tmp[len - k]);
+    }
+
+
+    FFTW(execute)(czt->plan_fwd);
+    const REAL leni = PREC(1.0) / (REAL)len;
+    for (size_t k = 0; k < len; k++)
+    {
+        czt->kernel[k][0] = czt->tmp[k][0] * leni;
+        czt->kernel[k][1] = czt->tmp[k][1] * leni;
+    }
+
+
+    return czt;
+
+
+FAILURE:
+    CHARM(shs_czt_free)(czt);
+    return NULL;
+}
+
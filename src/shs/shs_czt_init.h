@@ -0,0 +1,32 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_CZT_INIT_H__
+#define __SHS_CZT_INIT_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shs_czt_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern CHARM(shs_czt) *CHARM(shs_czt_init)(unsigned long,
+                                           size_t,
+                                           REAL,
+                                           REAL,
+                                           unsigned,
+                                           _Bool);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,38 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "shs_czt_len.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns the length of the FFTs of the chirp-z transform from the orders "m
+ * = 0, 1, ..., nmax" to "nlon" longitudes.  This is the smallest integer
+ * larger than or equal to "nlon + nmax" that has no prime factors other than
+ * "2", "3", "5" and "7", for which FFTW is the most efficient. */
+size_t CHARM(shs_czt_len)(unsigned long nmax,
+                          size_t nlon)
+{
+    size_t len, n;
+    for (len = nlon + nmax; ; len++)
+    {
+        n = len;
+        while (n % 2 == 0)
+            n /= 2;
+        while (n % 3 == 0)
+            n /= 3;
+        while (n % 5 == 0)
+            n /= 5;
+        while (n % 7 == 0)
+            n /= 7;
+
+
+        if (n == 1)
+            return len;
+    }
+}
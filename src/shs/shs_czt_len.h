@@ -0,0 +1,27 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_CZT_LEN_H__
+#define __SHS_CZT_LEN_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern size_t CHARM(shs_czt_len)(unsigned long,
+                                 size_t);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,57 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_CZT_STRUCT_H__
+#define __SHS_CZT_STRUCT_H__
+
+
+#include <config.h>
+#include <fftw3.h>
+#include "../prec.h"
+
+
+/* Structure to synthesize a signal at "nlon" equally spaced longitudes "lon0 +
+ * j * deltalon", "j = 0, 1, ..., nlon - 1", from the lumped coefficients of
+ * orders "m = 0, 1, ..., nmax" by the chirp-z transform (Bluestein's
+ * algorithm).  With "m * j = (m^2 + j^2 - (j - m)^2) / 2", the sum over the
+ * orders becomes a convolution, which is evaluated by FFT of the length
+ * "len >= nlon + nmax".  Unlike the plain FFT, the longitudes need not to
+ * cover the full circle and their number need not to be related to "nmax".
+ * See "shs_czt_init" and "shs_grd_czt". */
+typedef struct
+{
+    unsigned long nmax;
+    size_t nlon;
+    size_t len;
+
+
+    /* "pre[m] = k * exp(i * m * lon0) * exp(i * deltalon * m^2 / 2)" for "m =
+     * 0, 1, ..., nmax", where "k = 1" for "m = 0" and "k = 2" otherwise.  The
+     * factor "k" converts the lumped coefficients prepared by
+     * "shs_grd_fft_lc" for the real-to-complex FFT. */
+    FFTWC(complex) *pre;
+
+
+    /* "post[j] = exp(i * deltalon * j^2 / 2)" for "j = 0, 1, ..., nlon - 1"
+     * */
+    FFTWC(complex) *post;
+
+
+    /* Forward FFT of "exp(-i * deltalon * k^2 / 2)", "k = -nmax, ..., nlon -
+     * 1", divided by "len" */
+    FFTWC(complex) *kernel;
+
+
+    /* Working array of "len" elements and the in-place FFTW plans working
+     * with it */
+    FFTWC(complex) *tmp;
+    FFTW(plan) plan_fwd;
+    FFTW(plan) plan_bwd;
+
+
+    /* "1" if the FFTW plans are registered by "misc_fftw_plans_add" */
+    _Bool cache;
+} CHARM(shs_czt);
+
+
+#endif
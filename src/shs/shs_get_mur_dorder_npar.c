@@ -26,7 +26,9 @@
  * * the order of the potential derivative ("dorder"; "0" for potential, "1"
  *   for first-order derivative(s), "2" for second-order derivative(s)), and
  *
- * * the number of parameters/quantities to be synthesized ("npar"). */
+ * * the number of parameters/quantities to be synthesized ("npar").
+ *
+ * If "shcs" is "NULL", "mur" is not computed. */
 void CHARM(shs_get_mur_dorder_npar)(const CHARM(shc) *shcs,
                                     int dr,
                                     int dlat,
@@ -66,6 +68,10 @@ void CHARM(shs_get_mur_dorder_npar)(const CHARM(shc) *shcs,
     }
 
 
+    if (shcs == NULL)
+        return;
+
+
     REAL rpow = shcs->r;
     for (unsigned i = 1; i <= *dorder; i++)
         rpow *= shcs->r;
@@ -0,0 +1,129 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "shs_czt_struct.h"
+#include "shs_grd_czt.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Synthesizes "f[j]", "j = 0, 1, ..., czt->nlon - 1", from the lumped
+ * coefficients of the "lssv"th latitude of the latitude block "fc_tmp" and
+ * multiplies them by "c" */
+static void czt_lat(const REAL *fc_tmp,
+                    size_t lssv,
+                    size_t size_blk,
+                    REAL c,
+                    CHARM(shs_czt) *czt,
+                    REAL *f)
+{
+    FFTWC(complex) *tmp    = czt->tmp;
+    FFTWC(complex) *pre    = czt->pre;
+    FFTWC(complex) *post   = czt->post;
+    FFTWC(complex) *kernel = czt->kernel;
+    size_t idx;
+    REAL re, im;
+
+
+    /* Lumped coefficients multiplied by the chirp */
+    for (unsigned long m = 0; m <= czt->nmax; m++)
+    {
+        idx       = m * 2 * size_blk + lssv;
+        re        = fc_tmp[idx];
+        im        = fc_tmp[idx + size_blk];
+        tmp[m][0] = re * pre[m][0] - im * pre[m][1];
+        tmp[m][1] = re * pre[m][1] + im * pre[m][0];
+    }
+    for (size_t k = czt->nmax + 1; k < czt->len; k++)
+        tmp[k][0] = tmp[k][1] = PREC(0.0);
+
+
+    /* Convolution with the conjugate chirp */
+    FFTW(execute)(czt->plan_fwd);
+    for (size_t k = 0; k < czt->len; k++)
+    {
+        re        = tmp[k][0];
+        im        = tmp[k][1];
+        tmp[k][0] = re * kernel[k][0] - im * kernel[k][1];
+        tmp[k][1] = re * kernel[k][1] + im * kernel[k][0];
+    }
+    FFTW(execute)(czt->plan_bwd);
+
+
+    /* Real part of the convolution multiplied by the chirp */
+    for (size_t j = 0; j < czt->nlon; j++)
+        f[j] = c * (post[j][0] * tmp[j][0] - post[j][1] * tmp[j][1]);
+
+
+    return;
+}
+
+
+
+
+
+
+/* An internal function to perform the chirp-z transform-based synthesis along
+ * the latitude grid parallels.  This is an alternative to "shs_grd_fft" for
+ * grids of points with equally spaced longitudes, which do not satisfy the
+ * requirements of the plain FFT. */
+void CHARM(shs_grd_czt)(size_t i,
+                        size_t nlat,
+                        size_t nlon,
+                        const REAL *latsinv,
+                        const REAL *fc_tmp,
+                        const REAL *fc2_tmp,
+                        REAL mur,
+                        const REAL *symmv,
+                        size_t block_s,
+                        CHARM(shs_czt) *czt,
+                        REAL *f)
+{
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = block_s;
+#else
+    (void)block_s;
+#   define BLOCK_S SIMD_BLOCK_S
+#endif
+
+
+    size_t ipv, lssv;
+    size_t size_blk = SIMD_SIZE * BLOCK_S;
+
+
+    for (size_t l = 0; l < BLOCK_S; l++)
+    {
+        for (size_t v = 0; v < SIMD_SIZE; v++)
+        {
+            /* The local index relative to "i" of the latitude parallel that
+             * we are processing */
+            lssv = l * SIMD_SIZE + v;
+
+
+            if (latsinv[lssv] == 0)
+                continue;
+
+
+            /* The global index of the latitude parallel */
+            ipv = i + lssv;
+
+
+            czt_lat(fc_tmp, lssv, size_blk, mur, czt, &f[ipv * nlon]);
+
+
+            if (symmv[lssv])
+                czt_lat(fc2_tmp, lssv, size_blk, mur, czt,
+                        &f[(nlat - ipv - 1) * nlon]);
+        }
+    }
+
+
+    return;
+}
@@ -0,0 +1,37 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_GRD_CZT_H__
+#define __SHS_GRD_CZT_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "shs_czt_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shs_grd_czt)(size_t,
+                               size_t,
+                               size_t,
+                               const REAL *,
+                               const REAL *,
+                               const REAL *,
+                               REAL,
+                               const REAL *,
+                               size_t,
+                               CHARM(shs_czt) *,
+                               REAL *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
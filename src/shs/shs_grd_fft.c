@@ -7,7 +7,6 @@
 #include "../prec.h"
 #include "../simd/simd.h"
 #include "../crd/crd_cell_isGrid.h"
-#include "../glob/glob_get_shs_block_lat_multiplier.h"
 #include "shs_grd_fft.h"
 /* ------------------------------------------------------------------------- */
 
@@ -36,12 +35,14 @@ void CHARM(shs_grd_fft)(size_t i,
                         REAL mur,
                         const FFTW(plan) plan,
                         const REAL *symmv,
+                        size_t block_s,
                         REAL *ftmp,
                         REAL *f)
 {
-#if HAVE_MPI
-    const size_t BLOCK_S = CHARM(glob_get_shs_block_lat_multiplier)();
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = block_s;
 #else
+    (void)block_s;
 #   define BLOCK_S SIMD_BLOCK_S
 #endif
 
@@ -33,6 +33,7 @@ extern void CHARM(shs_grd_fft)(size_t,
                                REAL,
                                const FFTW(plan),
                                const REAL *,
+                               size_t,
                                REAL *,
                                REAL *);
 
@@ -7,7 +7,6 @@
 #include "../simd/simd.h"
 #include "../crd/crd_point_isGrid.h"
 #include "../crd/crd_cell_isGrid.h"
-#include "../glob/glob_get_shs_block_lat_multiplier.h"
 #include "shs_lc_struct.h"
 #include "shs_max_npar.h"
 #include "shs_point_gradn.h"
@@ -59,12 +58,14 @@ void CHARM(shs_grd_fft_lc)(unsigned long m,
                            REAL_SIMD *symm_simd,
                            int grd_type,
                            size_t nfc,
+                           size_t block_s,
                            REAL *fc_tmp,
                            REAL *fc2_tmp)
 {
-#if HAVE_MPI
-    const size_t BLOCK_S = CHARM(glob_get_shs_block_lat_multiplier)();
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = block_s;
 #else
+    (void)block_s;
 #   define BLOCK_S SIMD_BLOCK_S
 #endif
 
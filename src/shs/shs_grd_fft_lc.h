@@ -26,6 +26,7 @@ extern void CHARM(shs_grd_fft_lc)(unsigned long,
                                   REAL_SIMD *,
                                   int,
                                   size_t,
+                                  size_t,
                                   REAL *,
                                   REAL *);
 
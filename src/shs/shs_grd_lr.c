@@ -7,7 +7,6 @@
 #include "../simd/simd.h"
 #include "../crd/crd_cell_isGrid.h"
 #include "../misc/misc_sd_calloc.h"
-#include "../glob/glob_get_shs_block_lat_multiplier.h"
 #include "shs_lc_struct.h"
 #include "shs_grd_lr.h"
 #include "shs_max_npar.h"
@@ -28,7 +27,7 @@
     {                                                                         \
         lss = l * SIMD_SIZE;                                                  \
         CAT2(dm, term, i)[par_simd_blk + l] =                                 \
-                                 ADD_R(MUL_R(lc->CAT2(a, x, i)[l], clontmp),  \
+                                 FMA_R(lc->CAT2(a, x, i)[l], clontmp,         \
                                        MUL_R(lc->CAT2(b, x, i)[l], slontmp)); \
         STORE_R(&CAT(fi, i)[par_nfi_1par + lss],                              \
                 ADD_R(LOAD_R(&CAT(fi, i)[par_nfi_1par + lss]),                \
@@ -69,14 +68,16 @@ void CHARM(shs_grd_lr)(unsigned long m,
                        int grd_type,
                        int grad,
                        size_t nfi_1par,
+                       size_t block_s,
                        CHARM(lc) *lc,
                        _Bool symm,
                        REAL *fi,
                        REAL *fi2)
 {
-#if HAVE_MPI
-    const size_t BLOCK_S = CHARM(glob_get_shs_block_lat_multiplier)();
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = block_s;
 #else
+    (void)block_s;
 #   define BLOCK_S SIMD_BLOCK_S
 #endif
 
@@ -164,7 +165,7 @@ void CHARM(shs_grd_lr)(unsigned long m,
                                SHS_MAX_NPAR * SIMD_BLOCK_S,
                                lc->error,
                                BARRIER);
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 BARRIER:
     if (lc->error)
         goto EXIT;
@@ -24,6 +24,7 @@ extern void CHARM(shs_grd_lr)(unsigned long,
                               int,
                               int,
                               size_t,
+                              size_t,
                               CHARM(lc) *,
                               _Bool,
                               REAL *,
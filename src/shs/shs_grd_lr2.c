@@ -6,7 +6,6 @@
 #include "../prec.h"
 #include "../simd/simd.h"
 #include "../crd/crd_cell_isGrid.h"
-#include "../glob/glob_get_shs_block_lat_multiplier.h"
 #include "shs_grd_lr2.h"
 /* ------------------------------------------------------------------------- */
 
@@ -38,6 +37,7 @@ void CHARM(shs_grd_lr2)(size_t i,
                         size_t nlat,
                         size_t nlon,
                         const REAL *symmv,
+                        size_t block_s,
                         REAL c,
                         const REAL *latminv,
                         const REAL *latmaxv,
@@ -46,9 +46,10 @@ void CHARM(shs_grd_lr2)(size_t i,
                         const REAL *fi2,
                         REAL *f)
 {
-#if HAVE_MPI
-    const size_t BLOCK_S = CHARM(glob_get_shs_block_lat_multiplier)();
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = block_s;
 #else
+    (void)block_s;
 #   define BLOCK_S SIMD_BLOCK_S
 #endif
 
@@ -16,8 +16,9 @@ extern "C"
 
 
 extern void CHARM(shs_grd_lr2)(size_t, const REAL *, int, size_t, size_t,
+                               const REAL *, size_t, REAL, const REAL *,
                                const REAL *, REAL, const REAL *, const REAL *,
-                               REAL, const REAL *, const REAL *, REAL *);
+                               REAL *);
 
 
 #ifdef __cplusplus
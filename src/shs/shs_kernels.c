@@ -0,0 +1,31 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "shs_kernels.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+const CHARM(shs_kernels_table) SIMD_ISA_NAME(shs_kernels) =
+{
+    SIMD_ISA_NAME(shs_point_kernel_dr0_dlat0_dlon0),
+    SIMD_ISA_NAME(shs_point_kernel_dr1_dlat0_dlon0),
+    SIMD_ISA_NAME(shs_point_kernel_dr2_dlat0_dlon0),
+    SIMD_ISA_NAME(shs_point_kernel_dr0_dlat1_dlon0),
+    SIMD_ISA_NAME(shs_point_kernel_dr0_dlat2_dlon0),
+    SIMD_ISA_NAME(shs_point_kernel_dr0_dlat0_dlon1),
+    SIMD_ISA_NAME(shs_point_kernel_dr0_dlat0_dlon2),
+    SIMD_ISA_NAME(shs_point_kernel_dr1_dlat1_dlon0),
+    SIMD_ISA_NAME(shs_point_kernel_dr1_dlat0_dlon1),
+    SIMD_ISA_NAME(shs_point_kernel_dr0_dlat1_dlon1),
+    SIMD_ISA_NAME(shs_point_kernel_grad1),
+    SIMD_ISA_NAME(shs_point_kernel_grad2),
+    SIMD_ISA_NAME(shs_point_kernel_batch),
+    SIMD_ISA_NAME(shs_cell_kernel)
+};
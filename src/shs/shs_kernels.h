@@ -0,0 +1,124 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_KERNELS_H__
+#define __SHS_KERNELS_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "../shc/shc_block_struct.h"
+#include "shs_lc_struct.h"
+#include "shs_point_kernels.h"
+#include "shs_point_kernel_batch.h"
+#include "shs_cell_kernel.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/* Table of the kernels of spherical harmonic synthesis compiled for a single
+ * instruction set.
+ *
+ * "REAL_SIMD" is a different data type in each translation unit of the
+ * kernels compiled for another instruction set, but the kernels accept only
+ * pointers to "REAL_SIMD", so the tables are binary compatible. */
+typedef struct
+{
+    void (*shs_point_kernel_dr0_dlat0_dlon0) IO_PARS;
+    void (*shs_point_kernel_dr1_dlat0_dlon0) IO_PARS;
+    void (*shs_point_kernel_dr2_dlat0_dlon0) IO_PARS;
+    void (*shs_point_kernel_dr0_dlat1_dlon0) IO_PARS;
+    void (*shs_point_kernel_dr0_dlat2_dlon0) IO_PARS;
+    void (*shs_point_kernel_dr0_dlat0_dlon1) IO_PARS;
+    void (*shs_point_kernel_dr0_dlat0_dlon2) IO_PARS;
+    void (*shs_point_kernel_dr1_dlat1_dlon0) IO_PARS;
+    void (*shs_point_kernel_dr1_dlat0_dlon1) IO_PARS;
+    void (*shs_point_kernel_dr0_dlat1_dlon1) IO_PARS;
+    void (*shs_point_kernel_grad1) IO_PARS;
+    void (*shs_point_kernel_grad2) IO_PARS;
+
+
+    void (*shs_point_kernel_batch)(unsigned long,
+                                   unsigned long,
+                                   CHARM(shc_block) **,
+                                   size_t,
+                                   _Bool,
+                                   const REAL *,
+                                   const REAL *,
+                                   const REAL_SIMD *,
+                                   const REAL *,
+                                   const INT *,
+                                   REAL_SIMD *,
+                                   REAL_SIMD *,
+                                   const REAL_SIMD *,
+                                   size_t,
+                                   REAL_SIMD *,
+                                   CHARM(lc) **);
+
+
+    void (*shs_cell_kernel)(unsigned long, unsigned long,
+                            const CHARM(shc) *,
+                            const REAL *,
+                            const REAL *,
+                            const REAL_SIMD *,
+                            const REAL_SIMD *,
+                            const REAL_SIMD *,
+                            const REAL_SIMD *,
+                            const REAL_SIMD *,
+                            const REAL_SIMD *,
+                            const REAL *,
+                            const REAL *,
+                            const INT *,
+                            const INT *,
+                            REAL_SIMD *,
+                            REAL_SIMD *,
+                            REAL_SIMD *,
+                            const REAL *,
+                            const REAL *,
+                            const REAL *,
+                            const REAL *,
+                            const REAL *,
+                            const REAL_SIMD *,
+                            const REAL_SIMD *,
+                            const REAL_SIMD *,
+                            const REAL_SIMD *,
+                            const REAL_SIMD *,
+                            REAL_SIMD *,
+                            REAL_SIMD *,
+                            REAL_SIMD *,
+                            REAL_SIMD *);
+} CHARM(shs_kernels_table);
+
+
+extern const CHARM(shs_kernels_table) SIMD_ISA_NAME(shs_kernels);
+
+
+/* "SHS_KERNEL(x)" is the kernel "x" to be called by the synthesis.  With
+ * "HAVE_SIMD_DISPATCH", the kernel is taken from the table selected at
+ * runtime, see "simd_dispatch.c".  "SHS_KERNEL_VARS" must be appended to the
+ * OpenMP parallel regions that call "SHS_KERNEL". */
+#if HAVE_SIMD_DISPATCH
+extern const CHARM(shs_kernels_table) *CHARM(simd_dispatch_shs);
+#   undef SHS_KERNEL
+#   define SHS_KERNEL(x) (CHARM(simd_dispatch_shs)->x)
+#   undef SHS_KERNEL_VARS
+#   define SHS_KERNEL_VARS shared(CHARM(simd_dispatch_shs))
+#else
+#   undef SHS_KERNEL
+#   define SHS_KERNEL(x) CHARM(x)
+#   undef SHS_KERNEL_VARS
+#   define SHS_KERNEL_VARS
+#endif
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
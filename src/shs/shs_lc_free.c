@@ -19,7 +19,7 @@ void CHARM(shs_lc_free)(CHARM(lc) *x)
         return;
 
 
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
     CHARM(free_aligned)(x->_all);
 #endif
     CHARM(free_aligned)(x);
@@ -7,7 +7,6 @@
 #include "../simd/simd.h"
 #include "../simd/calloc_aligned.h"
 #include "../simd/free_aligned.h"
-#include "../glob/glob_get_shs_block_lat_multiplier.h"
 #include "shs_lc_struct.h"
 #include "shs_lc_init.h"
 /* ------------------------------------------------------------------------- */
@@ -20,7 +19,7 @@
 /* Internal function to properly set up a "CHARM(lc)" struct.  It *must* be
  * called after the "CHARM(lc)" structure is declared and before it is used for
  * the first time. */
-CHARM(lc) *CHARM(shs_lc_init)(void)
+CHARM(lc) *CHARM(shs_lc_init)(size_t block_s)
 {
     CHARM(lc) *x = (CHARM(lc) *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
                                                       1,
@@ -29,14 +28,15 @@ CHARM(lc) *CHARM(shs_lc_init)(void)
         return NULL;
 
 
-#if HAVE_MPI
-    const size_t BLOCK_S = CHARM(glob_get_shs_block_lat_multiplier)();
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = block_s;
     x->_all = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
                                                  LC_BLOCKS * BLOCK_S,
                                                  sizeof(REAL_SIMD));
     if (x->_all == NULL)
         goto FAILURE;
 #else
+    (void)block_s;
 #   define BLOCK_S SIMD_BLOCK_S
     /* In this case, "x->_all" is allocated statically.  See also the note in
      * "shs_lc_struct.c". */
@@ -15,7 +15,7 @@ extern "C"
 #endif
 
 
-extern CHARM(lc) *CHARM(shs_lc_init)(void);
+extern CHARM(lc) *CHARM(shs_lc_init)(size_t);
 
 
 #ifdef __cplusplus
@@ -16,7 +16,7 @@
 /* Structure to store the lumped coefficients. */
 typedef struct
 {
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
     /* In this case, the memory will be allocated and freed dynamically */
     REAL_SIMD *_all;
 #else
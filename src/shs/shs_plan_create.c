@@ -0,0 +1,794 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fftw3.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../crd/crd_point_isDHGrid.h"
+#include "../crd/crd_point_isGrid.h"
+#include "../crd/crd_point_quad_equator.h"
+#include "../crd/crd_point_quad_get_nmax_from_nlat.h"
+#include "../crd/crd_point_isQuadGrid.h"
+#include "../crd/crd_point_isCustGrid.h"
+#include "../crd/crd_point_get_local_nlat.h"
+#include "../crd/crd_point_get_local_nlon.h"
+#include "../crd/crd_point_get_local_0_start.h"
+#include "../leg/leg_func_dm.h"
+#include "../leg/leg_func_r_ri.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_isempty_all_mpi_processes.h"
+#include "../misc/misc_arr_chck_lin_incr.h"
+#include "../misc/misc_arr_chck_symm.h"
+#include "../misc/misc_fftw_plans.h"
+#include "../simd/simd.h"
+#include "../simd/calloc_aligned.h"
+#include "../glob/glob_get_shs_block_lat_multiplier.h"
+#include "shs_grd_point_fft_check.h"
+#include "shs_get_mur_dorder_npar.h"
+#include "shs_point_gradn.h"
+#include "shs_lc_struct.h"
+#include "shs_lc_init.h"
+#include "shs_get_imax.h"
+#include "shs_plan_struct.h"
+#include "shs_point_grd_block.h"
+#include "shs_czt_len.h"
+#include "shs_czt_init.h"
+#include "shs_plan_create.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Macros */
+/* ------------------------------------------------------------------------- */
+#undef CHECK_NULL
+#define CHECK_NULL(x, barrier)                                                \
+        if ((x) == NULL)                                                      \
+        {                                                                     \
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,     \
+                           CHARM_ERR_MALLOC_FAILURE);                         \
+            goto barrier;                                                     \
+        }
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Returns the integer part of "log2(n)" */
+static unsigned long log2_int(size_t n)
+{
+    unsigned long l = 0;
+    for (; n > 1; n /= 2)
+        l++;
+
+
+    return l;
+}
+
+
+
+
+
+
+/* Internal function to create a plan for the synthesis of point values.  All
+ * quantities that do not depend on spherical harmonic coefficients are
+ * computed here.  "nmodels" is the number of sets of spherical harmonic
+ * coefficients to be synthesized at once (see "shs_point_grd_batch").
+ * "fftw_flags" are passed to the FFTW planner.  If "cache" is
+ * "1", the latitude-dependent quantities are computed for all latitude blocks
+ * and stored in the plan.  Otherwise, they are computed later for each block
+ * separately in "shs_point_grd_exec". */
+CHARM(shs_plan) *CHARM(shs_plan_create)(const CHARM(point) *pnt,
+                                        unsigned long nmax,
+                                        int dr,
+                                        int dlat,
+                                        int dlon,
+                                        size_t nmodels,
+                                        unsigned fftw_flags,
+                                        _Bool cache,
+                                        CHARM(err) *err)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(shs_plan) *plan = (CHARM(shs_plan) *)calloc(1,
+                                                     sizeof(CHARM(shs_plan)));
+    if (plan == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto BARRIER_1;
+    }
+
+
+    plan->pnt     = pnt;
+    plan->nmax    = nmax;
+    plan->dr      = dr;
+    plan->dlat    = dlat;
+    plan->dlon    = dlon;
+    plan->cache   = cache;
+    plan->nmodels = nmodels;
+
+
+    CHARM(shs_get_mur_dorder_npar)(NULL, dr, dlat, dlon, NULL,
+                                   &plan->dorder, &plan->npar, err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto BARRIER_1;
+    }
+
+
+    if ((dr == GRAD_1) && (dlat == GRAD_1) && (dlon == GRAD_1))
+        plan->grad = 1;
+    else if ((dr == GRAD_2) && (dlat == GRAD_2) && (dlon == GRAD_2))
+        plan->grad = 2;
+    else
+        plan->grad = 0;
+
+
+    plan->grd = CHARM(crd_point_isGrid)(pnt->type) && (pnt->npoint > 0);
+    if (!plan->grd)
+        /* Scattered points or no points at all, so there is nothing to be
+         * prepared */
+        goto BARRIER_1;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Check the latitudes */
+    /* --------------------------------------------------------------------- */
+
+    /* Check whether the number of latitudes is even or odd */
+    /* ..................................................................... */
+    int pnt_type = pnt->type;
+    size_t pnt_nlat = CHARM(crd_point_get_local_nlat)(pnt);
+    const size_t local_0_start = CHARM(crd_point_get_local_0_start)(pnt);
+
+
+    /* For the full Driscoll--Healy grids, "pnt_nlat" is always an even number
+     * and the grid is not symmetric in terms of our definition (the north pole
+     * does not have its negative counterpart -- the south pole).  However, we
+     * know that except for the north pole, the Driscoll--Healy grids *are*
+     * symmetric, so the symmetry property of Legendre functions could be used
+     * if the north pole is treated properly.  To this end, let's increase the
+     * number of points in "pnt_nlat", so that we can apply our algorithm for
+     * symmetric grids.  After increasing "pnt_nlat", its value is odd, so set
+     * "even" to zero.
+     *
+     * With MPI, we have to increase "pnt_nlat" only for the chunk that has
+     * the north pole, which is always the one with "local_0_start == 0" due to
+     * our restrictions. */
+    if (CHARM(crd_point_isDHGrid)(pnt_type) && (local_0_start == 0))
+        pnt_nlat += 1;
+
+
+    const _Bool even = !(pnt_nlat % 2);
+    /* ..................................................................... */
+
+
+    /* Determine whether the latitudes are symmetric with respect to the
+     * equator */
+    /* ..................................................................... */
+    /* If the grid is symmetric with respect to the equator, then "symm = 1",
+     * otherwise "symm = 0".  If "symm == 1", the function automatically
+     * exploits the symmetry property of Legendre functions in order to
+     * accelerate the computation. */
+    _Bool symm;
+    int err_tmp;
+    if (pnt_nlat == 1)
+        /* The grid is automatically considered as non-symmetric if there is
+         * only a single latitude */
+        symm = 0;
+    else if (CHARM(crd_point_isQuadGrid)(pnt_type))
+    {
+        /* The Driscoll--Healy grids or the Gauss--Legendre grid.
+         *
+         * The Gauss--Legendre grid is symmetric by definition, so no check is
+         * needed.
+         *
+         * The Driscoll--Healy grids do not meet our conditions for grids to be
+         * symmetric (the south pole is missing).  However, we know that if we
+         * omit their north pole, they become symmetric, too.  So let's
+         * consider the Driscoll--Healy grids as symmetric by treating the
+         * north pole separately later. */
+        symm = 1;
+    }
+    else
+    {
+        /* User-defined grid, let's do the check */
+        err_tmp = CHARM(misc_arr_chck_symm)(pnt->lat, pnt_nlat, PREC(0.0),
+                                            CHARM(glob_threshold2), err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto BARRIER_1;
+        }
+
+
+        symm = (err_tmp == 0) ? 1 : 0;
+    }
+    /* ..................................................................... */
+
+
+    /* Get the index of the equator for quadrature grids */
+    /* ..................................................................... */
+    const unsigned long nmax_grd =
+                CHARM(crd_point_quad_get_nmax_from_nlat)(pnt->type, pnt->nlat);
+    const size_t equator = CHARM(crd_point_quad_equator)(pnt->type, nmax_grd);
+    /* ..................................................................... */
+
+
+    /* Finally, if the grid is symmetric, we modify the number of latitudes
+     * "pnt_nlat" to be equal to the number of latitudes on one hemisphere
+     * only (including the equator if present). This is because the
+     * time-consuming "for loop" over evaluation points now needs to run for
+     * one hemisphere only, while the results for the other hemisphere are
+     * obtained by exploiting the symmetry property of Legendre functions. This
+     * reduces the number of Legendre functions that need to be evaluated by
+     * a factor of ~2, so saves some computational time */
+    const size_t nlatdo = (symm) ? (pnt_nlat + 1 - even) / 2 : pnt_nlat;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Check the longitudes.  If possible, FFT is employed along the
+     * latitudinal parallels.  Otherwise, the chirp-z transform or the PSLR
+     * algorithm is used.  These are slower, but can be used for any grid with
+     * a constant longitudinal sampling.  Below, we determined whether FFT can
+     * be applied or not. */
+    /* --------------------------------------------------------------------- */
+    size_t pnt_nlon = CHARM(crd_point_get_local_nlon)(pnt);
+
+
+    /* If "pnt" is a user-defined grid with more than one longitude, we have to
+     * check whether the longitudinal step is constant.  For quadrature grids,
+     * the longitudinal step is constant by definition, so no check is
+     * needed. */
+    if (CHARM(crd_point_isCustGrid)(pnt->type) && (pnt_nlon > 1))
+    {
+        err_tmp = CHARM(misc_arr_chck_lin_incr)(pnt->lon, pnt_nlon,
+                                                0, 1, CHARM(glob_threshold2),
+                                                err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto BARRIER_1;
+        }
+
+
+        if (err_tmp != 0)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__,  __func__,
+                           CHARM_EFUNCARG,
+                           "\"pnt->lon\" is not a linearly increasing "
+                           "array within the \"threshold2\".");
+            goto BARRIER_1;
+        }
+    }
+
+
+    /* Get the longitudinal step of the grid.  At this point, we know the
+     * longitudinal step is constant over each latitude parallel, so let's get
+     * the step from, say, the first two longitudes. */
+    REAL deltalon = (pnt_nlon > 1) ? pnt->lon[1] - pnt->lon[0] : PREC(0.0);
+
+
+    /* Get the origin of the longitude "pnt->lon" vector (will be necessary
+     * later for the PSLR algorithm) */
+    REAL lon0 = pnt->lon[0];
+
+
+    /* Length of the lumped coefficients arrays in case FFT will be applied */
+    size_t nfc = pnt_nlon / 2 + 1;
+
+
+    _Bool use_fft = CHARM(shs_grd_point_fft_check)(pnt, deltalon, nmax);
+
+
+    /* Even if FFT can be applied, the PSLR algorithm is cheaper at latitude
+     * blocks with only a few harmonic orders to be synthesized.  The FFT
+     * requires "O(pnt_nlon * log2(pnt_nlon))" operations per latitude, the
+     * PSLR algorithm "O(pnt_nlon * nm)", where "nm" is the number of
+     * synthesized orders.  Both costs scale equally with the number of
+     * synthesized quantities "npar", so PSLR is used whenever "nm <
+     * glob_shs_grd_pslr_factor * log2(pnt_nlon)".  Without the polar
+     * optimization, this happens only if "nmax" is very low with respect to
+     * "pnt_nlon".  With the polar optimization, it may happen close to the
+     * poles, where the higher orders are skipped.
+     *
+     * If FFT cannot be applied (e.g., the longitudes do not cover the full
+     * circle or there are too few of them), the chirp-z transform can be
+     * used instead (see "shs_czt_struct.h").  It requires "O(len *
+     * log2(len))" operations per latitude, where "len >= pnt_nlon + nmax" is
+     * the length of its FFTs, so it replaces the PSLR algorithm at latitude
+     * blocks with "nm >= glob_shs_grd_czt_factor * log2(len) * len /
+     * pnt_nlon". */
+    _Bool use_czt = 0;
+    REAL pslr_nm  = PREC(0.0);
+    if (use_fft && (CHARM(glob_shs_grd_pslr_factor) > PREC(0.0)))
+        pslr_nm = CHARM(glob_shs_grd_pslr_factor) * (REAL)log2_int(pnt_nlon);
+    else if (!use_fft && (pnt_nlon > 1) &&
+             (CHARM(glob_shs_grd_czt_factor) > PREC(0.0)))
+    {
+        size_t len = CHARM(shs_czt_len)(nmax, pnt_nlon);
+        pslr_nm    = CHARM(glob_shs_grd_czt_factor) * (REAL)log2_int(len) *
+                     (REAL)len / (REAL)pnt_nlon;
+
+
+        /* If not even all orders are cheaper with the chirp-z transform, it
+         * is not worth it */
+        if (pslr_nm < (REAL)nmax + PREC(1.0))
+        {
+            use_czt = 1;
+            use_fft = 1;
+            nfc     = nmax + 1;
+        }
+        else
+            pslr_nm = PREC(0.0);
+    }
+
+
+    if (pslr_nm > PREC(0.0))
+    {
+        /* The orders "m <= threshold" are never skipped by the polar
+         * optimization, so there is no need to allocate the PSLR arrays if
+         * not even these orders are cheaper with PSLR */
+        REAL nm_min = (REAL)nmax + PREC(1.0);
+        if (CHARM(glob_polar_optimization_a2) >= PREC(0.0))
+        {
+            REAL pt = CHARM_MAX((REAL)CHARM(glob_polar_optimization_a1),
+                                CHARM(glob_polar_optimization_a2) * nmax);
+            nm_min = CHARM_MIN(nm_min,
+                               (REAL)((unsigned long)pt) + PREC(1.0));
+        }
+        if (pslr_nm <= nm_min)
+            pslr_nm = PREC(0.0);
+    }
+    _Bool use_pslr = !use_fft || (pslr_nm > PREC(0.0));
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+#if HAVE_RUNTIME_BLOCK
+    size_t BLOCK_S = CHARM(glob_get_shs_block_lat_multiplier)();
+    plan->block_s  = BLOCK_S;
+#else
+#   define BLOCK_S SIMD_BLOCK_S
+#endif
+    const size_t npar     = plan->npar;
+    const size_t nfi_1par = pnt_nlon * SIMD_SIZE * BLOCK_S;
+    const size_t nfi      = npar * nfi_1par;
+    const size_t imax     = CHARM(shs_get_imax)(nlatdo, BLOCK_S, pnt);
+    const size_t istep    = SIMD_SIZE * BLOCK_S;
+
+
+    plan->pnt_type      = pnt_type;
+    plan->pnt_nlat      = pnt_nlat;
+    plan->pnt_nlon      = pnt_nlon;
+    plan->local_0_start = local_0_start;
+    plan->equator       = equator;
+    plan->nlatdo        = nlatdo;
+    plan->even          = even;
+    plan->symm          = symm;
+    plan->use_fft       = use_fft;
+    plan->pslr_nm       = pslr_nm;
+    plan->deltalon      = deltalon;
+    plan->lon0          = lon0;
+    plan->nfc           = nfc;
+    plan->nfi_1par      = nfi_1par;
+    plan->nfi           = nfi;
+    plan->imax          = imax;
+    plan->istep         = istep;
+
+
+    /* Number of latitude blocks to be stored in the plan */
+    size_t nslots = (cache) ? (imax + istep - 1) / istep : 1;
+    if (nslots == 0)
+        nslots = 1;
+    plan->nslots = nslots;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Initializations for recurrence relations to compute Legendre
+     * functions. */
+    /* --------------------------------------------------------------------- */
+    /* Prepare some variables to compute coefficients the "anm" and "bnm"
+     * coefficients for the Legendre functions recurrences */
+    plan->r = (REAL *)calloc(2 * nmax + 4, sizeof(REAL));
+    CHECK_NULL(plan->r, BARRIER_1);
+
+
+    plan->ri = (REAL *)calloc(2 * nmax + 4, sizeof(REAL));
+    CHECK_NULL(plan->ri, BARRIER_1);
+
+
+    CHARM(leg_func_r_ri)(nmax, plan->r, plan->ri);
+
+
+    /* "dm" coefficients for sectorial Legendre functions */
+    plan->dm = (REAL *)calloc(nmax + 1, sizeof(REAL));
+    CHECK_NULL(plan->dm, BARRIER_1);
+
+
+    CHARM(leg_func_dm)(nmax, plan->r, plan->ri, plan->dm);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Create a FFT plan */
+    /* --------------------------------------------------------------------- */
+    if (use_fft)
+    {
+#if HAVE_OPENMP && FFTW3_OMP
+        if (FFTW(init_threads)() == 0)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFFTWINIT,
+                           CHARM_ERR_FFTW_INIT_FAILURE);
+            goto BARRIER_1;
+        }
+
+
+        FFTW(plan_with_nthreads)(omp_get_max_threads());
+#endif
+
+
+        if (use_czt)
+        {
+            plan->czt = CHARM(shs_czt_init)(nmax, pnt_nlon, lon0, deltalon,
+                                            fftw_flags, cache);
+            CHECK_NULL(plan->czt, BARRIER_1);
+        }
+        else
+        {
+            REAL *x1           = NULL;
+            FFTWC(complex) *x2 = NULL;
+
+
+            x1 = (REAL *)FFTW(malloc)(pnt_nlon * sizeof(REAL));
+            CHECK_NULL(x1, BARRIER_FFTW);
+
+
+            x2 = (FFTWC(complex) *)FFTW(malloc)(nfc *
+                                                sizeof(FFTWC(complex)));
+            CHECK_NULL(x2, BARRIER_FFTW);
+
+
+            plan->plan = FFTW(plan_dft_c2r_1d)(pnt_nlon, x2, x1,
+                                               fftw_flags);
+            if (plan->plan == NULL)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                               CHARM_ERR_MALLOC_FAILURE);
+                goto BARRIER_FFTW;
+            }
+
+
+            /* The FFTW plan lives as long as "plan", so "fftw_cleanup" must
+             * not be called in the meantime */
+            if (cache)
+                CHARM(misc_fftw_plans_add)();
+
+
+BARRIER_FFTW:
+            FFTW(free)(x1);
+            FFTW(free)(x2);
+
+
+            if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+                goto BARRIER_1;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    plan->ips = (INT *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                             nslots * nmax * SIMD_SIZE *
+                                             BLOCK_S,
+                                             sizeof(INT));
+    CHECK_NULL(plan->ips, BARRIER_1);
+
+
+    plan->ps = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                             nslots * nmax * SIMD_SIZE *
+                                             BLOCK_S,
+                                             sizeof(REAL));
+    CHECK_NULL(plan->ps, BARRIER_1);
+
+
+    plan->symmv = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                nslots * SIMD_SIZE * BLOCK_S,
+                                                sizeof(REAL));
+    CHECK_NULL(plan->symmv, BARRIER_1);
+
+
+    plan->latsinv = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                  nslots * SIMD_SIZE *
+                                                  BLOCK_S,
+                                                  sizeof(REAL));
+    CHECK_NULL(plan->latsinv, BARRIER_1);
+
+
+    plan->t = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                 nslots * BLOCK_S,
+                                                 sizeof(REAL_SIMD));
+    CHECK_NULL(plan->t, BARRIER_1);
+
+
+    plan->u = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                 nslots * BLOCK_S,
+                                                 sizeof(REAL_SIMD));
+    CHECK_NULL(plan->u, BARRIER_1);
+
+
+    plan->symm_simd = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                         nslots * BLOCK_S,
+                                                         sizeof(REAL_SIMD));
+    CHECK_NULL(plan->symm_simd, BARRIER_1);
+
+
+    plan->pnt_r = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                     nslots * BLOCK_S,
+                                                     sizeof(REAL_SIMD));
+    CHECK_NULL(plan->pnt_r, BARRIER_1);
+
+
+    plan->tv = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                             sizeof(REAL));
+    CHECK_NULL(plan->tv, BARRIER_1);
+
+
+    plan->uv = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                             sizeof(REAL));
+    CHECK_NULL(plan->uv, BARRIER_1);
+
+
+    plan->pnt_rv = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                                 sizeof(REAL));
+    CHECK_NULL(plan->pnt_rv, BARRIER_1);
+
+
+    if (use_fft)
+    {
+        plan->ftmp = (REAL *)FFTW(malloc)(pnt_nlon * sizeof(REAL));
+        CHECK_NULL(plan->ftmp, BARRIER_1);
+
+
+        plan->fc = (FFTWC(complex) *)FFTW(malloc)(nfc *
+                                                  sizeof(FFTWC(complex)));
+        CHECK_NULL(plan->fc, BARRIER_1);
+        memset(plan->fc, 0, nfc * sizeof(FFTWC(complex)));
+
+
+        plan->fc_simd = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                      nmodels * npar * nfc *
+                                                      SIMD_SIZE * BLOCK_S * 2,
+                                                      sizeof(REAL));
+        CHECK_NULL(plan->fc_simd, BARRIER_1);
+    }
+
+
+    if (use_pslr)
+    {
+        plan->fi = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                 nmodels * nfi,
+                                                 sizeof(REAL));
+        CHECK_NULL(plan->fi, BARRIER_1);
+    }
+
+
+    if (symm)
+    {
+        plan->pnt_r2v = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                      SIMD_SIZE, sizeof(REAL));
+        CHECK_NULL(plan->pnt_r2v, BARRIER_1);
+
+
+        plan->pnt_r2 = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                          nslots * BLOCK_S,
+                                                          sizeof(REAL_SIMD));
+        CHECK_NULL(plan->pnt_r2, BARRIER_1);
+
+
+        if (use_fft)
+        {
+            plan->fc2 = (FFTWC(complex) *)FFTW(malloc)(nfc *
+                                                     sizeof(FFTWC(complex)));
+            CHECK_NULL(plan->fc2, BARRIER_1);
+            memset(plan->fc2, 0, nfc * sizeof(FFTWC(complex)));
+
+
+            plan->fc2_simd = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                           nmodels * npar *
+                                                           nfc * SIMD_SIZE *
+                                                           BLOCK_S * 2,
+                                                           sizeof(REAL));
+            CHECK_NULL(plan->fc2_simd, BARRIER_1);
+        }
+
+
+        if (use_pslr)
+        {
+            plan->fi2 = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                      nmodels * nfi,
+                                                      sizeof(REAL));
+            CHECK_NULL(plan->fi2, BARRIER_1);
+        }
+    }
+
+
+    plan->nrpows = BLOCK_S * (nmax + 2 + plan->dorder);
+    plan->rpows = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                     nslots * plan->nrpows,
+                                                     sizeof(REAL_SIMD));
+    CHECK_NULL(plan->rpows, BARRIER_1);
+    for (size_t i = 0; i < nslots * plan->nrpows; i++)
+        plan->rpows[i] = SET1_R(PREC(1.0));
+
+
+    if (symm)
+    {
+        plan->rpows2 = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                          nslots *
+                                                          plan->nrpows,
+                                                          sizeof(REAL_SIMD));
+        CHECK_NULL(plan->rpows2, BARRIER_1);
+        for (size_t i = 0; i < nslots * plan->nrpows; i++)
+            plan->rpows2[i] = SET1_R(PREC(1.0));
+    }
+    plan->rpows_ones = 1;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Arrays private to OpenMP threads */
+    /* --------------------------------------------------------------------- */
+#if HAVE_OPENMP
+    plan->nthreads = omp_get_max_threads();
+#else
+    plan->nthreads = 1;
+#endif
+
+
+    plan->lc = (CHARM(lc) **)calloc(plan->nthreads * nmodels,
+                                    sizeof(CHARM(lc) *));
+    CHECK_NULL(plan->lc, BARRIER_1);
+
+
+    plan->leg = (REAL_SIMD **)calloc(plan->nthreads, sizeof(REAL_SIMD *));
+    CHECK_NULL(plan->leg, BARRIER_1);
+
+    plan->anm = (REAL **)calloc(plan->nthreads, sizeof(REAL *));
+    CHECK_NULL(plan->anm, BARRIER_1);
+
+
+    plan->bnm = (REAL **)calloc(plan->nthreads, sizeof(REAL *));
+    CHECK_NULL(plan->bnm, BARRIER_1);
+
+
+    plan->enm = (REAL **)calloc(plan->nthreads, sizeof(REAL *));
+    CHECK_NULL(plan->enm, BARRIER_1);
+
+
+    plan->fi_thread = (REAL **)calloc(plan->nthreads, sizeof(REAL *));
+    CHECK_NULL(plan->fi_thread, BARRIER_1);
+
+
+    plan->fi2_thread = (REAL **)calloc(plan->nthreads, sizeof(REAL *));
+    CHECK_NULL(plan->fi2_thread, BARRIER_1);
+
+
+    for (int j = 0; j < plan->nthreads; j++)
+    {
+        for (size_t k = 0; k < nmodels; k++)
+        {
+            plan->lc[j * nmodels + k] = CHARM(shs_lc_init)(BLOCK_S);
+            CHECK_NULL(plan->lc[j * nmodels + k], BARRIER_1);
+        }
+
+
+        if (nmodels > 1)
+        {
+            plan->leg[j] = (REAL_SIMD *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                          (nmax + 1) * BLOCK_S,
+                                                          sizeof(REAL_SIMD));
+            CHECK_NULL(plan->leg[j], BARRIER_1);
+        }
+
+
+        plan->anm[j] = (REAL *)calloc(nmax + 1, sizeof(REAL));
+        CHECK_NULL(plan->anm[j], BARRIER_1);
+
+
+        plan->bnm[j] = (REAL *)calloc(nmax + 1, sizeof(REAL));
+        CHECK_NULL(plan->bnm[j], BARRIER_1);
+
+
+        if (plan->dorder > 0)
+        {
+            plan->enm[j] = (REAL *)calloc(nmax + 1, sizeof(REAL));
+            CHECK_NULL(plan->enm[j], BARRIER_1);
+        }
+
+
+        if (use_pslr)
+        {
+            plan->fi_thread[j] = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                               nmodels * nfi,
+                                                               sizeof(REAL));
+            CHECK_NULL(plan->fi_thread[j], BARRIER_1);
+
+
+            plan->fi2_thread[j] = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN,
+                                                                nmodels * nfi,
+                                                                sizeof(REAL));
+            CHECK_NULL(plan->fi2_thread[j], BARRIER_1);
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Latitude-dependent quantities for all latitude blocks */
+    /* --------------------------------------------------------------------- */
+    if (cache)
+    {
+        for (size_t i = 0; i < imax; i += istep)
+            CHARM(shs_point_grd_block)(plan, i, i / istep);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+BARRIER_1:
+    if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+    {
+        CHARM(shs_plan_free)(plan);
+        return NULL;
+    }
+
+
+    return plan;
+    /* --------------------------------------------------------------------- */
+}
@@ -0,0 +1,34 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_PLAN_CREATE_H__
+#define __SHS_PLAN_CREATE_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern CHARM(shs_plan) *CHARM(shs_plan_create)(const CHARM(point) *,
+                                               unsigned long,
+                                               int,
+                                               int,
+                                               int,
+                                               size_t,
+                                               unsigned,
+                                               _Bool,
+                                               CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
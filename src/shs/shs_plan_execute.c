@@ -0,0 +1,163 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_isempty_all_mpi_processes.h"
+#include "shs_plan_struct.h"
+#include "shs_point_sctr.h"
+#include "shs_point_grd_exec.h"
+#include "shs_point_gradn.h"
+#if HAVE_MPI
+#   include "../mpi/mpi_check_point_shc_err.h"
+#   include "../mpi/mpi_err_gather.h"
+#endif
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(shs_plan_execute)(CHARM(shs_plan) *plan,
+                             const CHARM(shc) *shcs,
+                             REAL **f,
+                             CHARM(err) *err)
+{
+    char err_msg[CHARM_ERR_MAX_MSG];
+
+
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    if (plan == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "\"plan\" cannot be \"NULL\".");
+        goto BARRIER;
+    }
+
+
+    if (plan->nmax > shcs->nmax)
+    {
+        snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                         "Maximum harmonic degree of the synthesis "
+                         "\"nmax = %lu\" cannot be larger than maximum "
+                         "harmonic degree of spherical harmonic "
+                         "coefficients \"shcs->nmax = %lu\".",
+                         plan->nmax, shcs->nmax);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       err_msg);
+        goto BARRIER;
+    }
+
+
+#if HAVE_MPI
+    CHARM(mpi_check_point_shc_err)(plan->pnt, shcs, err);
+    if (!CHARM(mpi_err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto BARRIER;
+    }
+#endif
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Do nothing if the total number of points in "pnt" is zero, which is
+     * a valid case */
+    /* --------------------------------------------------------------------- */
+    if (plan->pnt->npoint == 0)
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+BARRIER:
+    if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Now do the synthesis */
+    /* --------------------------------------------------------------------- */
+    if (plan->grd)
+        CHARM(shs_point_grd_exec)(plan, shcs, f, err);
+    else
+        CHARM(shs_point_sctr)(plan->pnt, shcs, plan->nmax, plan->dr,
+                              plan->dlat, plan->dlon, f, err);
+
+
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Reorder the gradient elements in "f" in the same way as in
+     * "shs_point_gradn" */
+    /* --------------------------------------------------------------------- */
+    if (plan->grad == 1)
+    {
+        REAL *fx = f[GRAD_P];
+        REAL *fy = f[GRAD_L];
+        REAL *fz = f[GRAD_R];
+
+
+        f[0] = fx;
+        f[1] = fy;
+        f[2] = fz;
+    }
+    else if (plan->grad == 2)
+    {
+        REAL *fxx = f[GRAD_PP];
+        REAL *fxy = f[GRAD_LP];
+        REAL *fxz = f[GRAD_RP];
+        REAL *fyy = f[GRAD_LL];
+        REAL *fyz = f[GRAD_LR];
+        REAL *fzz = f[GRAD_RR];
+
+
+        f[0] = fxx;
+        f[1] = fxy;
+        f[2] = fxz;
+        f[3] = fyy;
+        f[4] = fyz;
+        f[5] = fzz;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+EXIT:
+#if HAVE_MPI
+    CHARM(mpi_err_gather)(err);
+#endif
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
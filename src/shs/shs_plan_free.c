@@ -0,0 +1,98 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../simd/free_aligned.h"
+#include "../misc/misc_fftw_plans.h"
+#include "shs_lc_free.h"
+#include "shs_plan_struct.h"
+#include "shs_czt_free.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(shs_plan_free)(CHARM(shs_plan) *plan)
+{
+    if (plan == NULL)
+        return;
+
+
+    free(plan->r);
+    free(plan->ri);
+    free(plan->dm);
+    CHARM(free_aligned)(plan->ips);
+    CHARM(free_aligned)(plan->ps);
+    CHARM(free_aligned)(plan->symmv);
+    CHARM(free_aligned)(plan->latsinv);
+    CHARM(free_aligned)(plan->t);
+    CHARM(free_aligned)(plan->u);
+    CHARM(free_aligned)(plan->symm_simd);
+    CHARM(free_aligned)(plan->pnt_r);
+    CHARM(free_aligned)(plan->pnt_r2);
+    CHARM(free_aligned)(plan->rpows);
+    CHARM(free_aligned)(plan->rpows2);
+    CHARM(free_aligned)(plan->tv);
+    CHARM(free_aligned)(plan->uv);
+    CHARM(free_aligned)(plan->pnt_rv);
+    CHARM(free_aligned)(plan->pnt_r2v);
+    FFTW(free)(plan->ftmp);
+    FFTW(free)(plan->fc);
+    FFTW(free)(plan->fc2);
+    CHARM(free_aligned)(plan->fc_simd);
+    CHARM(free_aligned)(plan->fc2_simd);
+    CHARM(free_aligned)(plan->fi);
+    CHARM(free_aligned)(plan->fi2);
+
+
+    if (plan->lc != NULL)
+        for (size_t j = 0; j < (size_t)plan->nthreads * plan->nmodels; j++)
+            CHARM(shs_lc_free)(plan->lc[j]);
+
+
+    for (int j = 0; j < plan->nthreads; j++)
+    {
+        if (plan->leg != NULL)
+            CHARM(free_aligned)(plan->leg[j]);
+        if (plan->anm != NULL)
+            free(plan->anm[j]);
+        if (plan->bnm != NULL)
+            free(plan->bnm[j]);
+        if (plan->enm != NULL)
+            free(plan->enm[j]);
+        if (plan->fi_thread != NULL)
+            CHARM(free_aligned)(plan->fi_thread[j]);
+        if (plan->fi2_thread != NULL)
+            CHARM(free_aligned)(plan->fi2_thread[j]);
+    }
+    free(plan->lc);
+    free(plan->leg);
+    free(plan->anm);
+    free(plan->bnm);
+    free(plan->enm);
+    free(plan->fi_thread);
+    free(plan->fi2_thread);
+
+
+    if (plan->plan != NULL)
+    {
+        FFTW(destroy_plan)(plan->plan);
+        if (plan->cache)
+            CHARM(misc_fftw_plans_remove)();
+        CHARM(misc_fftw_cleanup)();
+    }
+
+
+    CHARM(shs_czt_free)(plan->czt);
+
+
+    free(plan);
+
+
+    return;
+}
@@ -0,0 +1,79 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../crd/crd_point_isSctr.h"
+#include "../crd/crd_point_isGrid.h"
+#include "shs_plan_create.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+CHARM(shs_plan) *CHARM(shs_plan_init)(const CHARM(point) *pnt,
+                                      unsigned long nmax,
+                                      int dr,
+                                      int dlat,
+                                      int dlon,
+                                      int flags,
+                                      CHARM(err) *err)
+{
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    if (CHARM(crd_point_isSctr)(pnt->type))
+    {
+        if (pnt->nlat != pnt->nlon)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           "The number of latitudes and longitudes in the "
+                           "\"pnt\" structure must be the same to "
+                           "perform point-wise spherical harmonic synthesis.");
+            return NULL;
+        }
+    }
+    else if (!CHARM(crd_point_isGrid)(pnt->type))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Unsupported \"pnt->type\" for spherical harmonic "
+                       "synthesis of point values.");
+        return NULL;
+    }
+
+
+    unsigned fftw_flags;
+    if (flags == CHARM_SHS_PLAN_ESTIMATE)
+        fftw_flags = FFTW_ESTIMATE;
+    else if (flags == CHARM_SHS_PLAN_MEASURE)
+        fftw_flags = FFTW_MEASURE;
+    else if (flags == CHARM_SHS_PLAN_PATIENT)
+        fftw_flags = FFTW_PATIENT;
+    else
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Unsupported value of \"flags\".");
+        return NULL;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(shs_plan) *plan = CHARM(shs_plan_create)(pnt, nmax, dr, dlat, dlon,
+                                                   1, fftw_flags, 1, err);
+    if (!CHARM(err_isempty)(err))
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+    return plan;
+    /* --------------------------------------------------------------------- */
+}
@@ -0,0 +1,32 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "shs_plan_struct.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(shs_plan_nblocks)(const CHARM(shs_plan) *plan,
+                             size_t *nfft,
+                             size_t *npslr)
+{
+    if ((plan == NULL) || !plan->grd)
+    {
+        *nfft  = 0;
+        *npslr = 0;
+        return;
+    }
+
+
+    *nfft  = plan->nblocks_fft;
+    *npslr = plan->nblocks_pslr;
+
+
+    return;
+}
@@ -0,0 +1,175 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_PLAN_STRUCT_H__
+#define __SHS_PLAN_STRUCT_H__
+
+
+#include <config.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "shs_lc_struct.h"
+#include "shs_czt_struct.h"
+
+
+/* Structure holding everything that is needed to perform the synthesis of
+ * point values and that does not depend on spherical harmonic coefficients.
+ * The structure is opaque to the user ("charm_shs_plan"). */
+struct CHARM(shs_plan)
+{
+    /* Evaluation points, maximum harmonic degree and derivatives (including
+     * "GRAD_1" and "GRAD_2") the plan was created for */
+    const CHARM(point) *pnt;
+    unsigned long nmax;
+    int dr;
+    int dlat;
+    int dlon;
+
+
+    /* "0" for potential, "1" for first-order derivatives and "2" for
+     * second-order derivatives */
+    unsigned dorder;
+
+
+    /* Number of quantities to be synthesized */
+    size_t npar;
+
+
+    /* Number of sets of spherical harmonic coefficients that are synthesized
+     * at once ("1" except for "shs_point_grd_batch").  The arrays of the
+     * lumped coefficients and of the synthesized signal along the latitude
+     * parallels are "nmodels" times longer. */
+    size_t nmodels;
+
+
+    /* "1" for "GRAD_1", "2" for "GRAD_2" and "0" otherwise */
+    int grad;
+
+
+    /* "1" if "pnt" is a grid with at least one point.  Only in that case, the
+     * members below are used.  Otherwise, the synthesis is passed directly to
+     * "shs_point_sctr". */
+    _Bool grd;
+
+
+    /* If "1", the latitude-dependent quantities are computed once for all
+     * latitude blocks and kept in the plan.  If "0", they are computed on the
+     * fly for each latitude block, so that only one block is stored at
+     * a time (internal one-shot synthesis with "shs_point_grd"). */
+    _Bool cache;
+
+
+    /* Grid related constants, see "shs_plan_create.c" */
+    int pnt_type;
+    size_t pnt_nlat;
+    size_t pnt_nlon;
+    size_t local_0_start;
+    size_t equator;
+    size_t nlatdo;
+    _Bool even;
+    _Bool symm;
+    _Bool use_fft;
+    REAL deltalon;
+    REAL lon0;
+    size_t nfc;
+    size_t nfi_1par;
+    size_t nfi;
+    size_t imax;
+    size_t istep;
+#if HAVE_RUNTIME_BLOCK
+    size_t block_s;
+#endif
+
+
+    /* With "use_fft == 1", latitude blocks with less than "pslr_nm"
+     * synthesized harmonic orders are transformed along the parallels by the
+     * PSLR algorithm instead of FFT (see "shs_point_grd_use_fft").  Zero if
+     * FFT is applied to all latitude blocks. */
+    REAL pslr_nm;
+
+
+    /* Chirp-z transform applied instead of FFT if the grid does not allow
+     * FFT (see "shs_czt_struct.h"), otherwise "NULL".  In that case,
+     * "use_fft == 1", but "plan" is "NULL". */
+    CHARM(shs_czt) *czt;
+
+
+    /* Number of latitude blocks transformed by FFT and by PSLR during the
+     * last execution of the plan */
+    size_t nblocks_fft;
+    size_t nblocks_pslr;
+
+
+    /* Number of latitude blocks stored in the plan ("1" if "cache == 0") */
+    size_t nslots;
+
+
+    /* Coefficients for the recurrence relations of Legendre functions */
+    REAL *r;
+    REAL *ri;
+    REAL *dm;
+
+
+    /* FFT plan */
+    FFTW(plan) plan;
+
+
+    /* Latitude-dependent quantities for "nslots" latitude blocks */
+    INT *ips;
+    REAL *ps;
+    REAL *symmv;
+    REAL *latsinv;
+    REAL_SIMD *t;
+    REAL_SIMD *u;
+    REAL_SIMD *symm_simd;
+    REAL_SIMD *pnt_r;
+    REAL_SIMD *pnt_r2;
+
+
+    /* Powers of "shcs->r / pnt->r" for "nslots" latitude blocks.  With
+     * "cache == 1", "rpows_set" indicates that the powers are available for
+     * "shcs->r == rpows_rref".  "rpows_ones" indicates that all the powers
+     * are equal to one, which is required if "pnt->r == shcs->r". */
+    size_t nrpows;
+    REAL_SIMD *rpows;
+    REAL_SIMD *rpows2;
+    REAL rpows_rref;
+    _Bool rpows_set;
+    _Bool rpows_ones;
+
+
+    /* Scratch arrays to prepare the latitude blocks */
+    REAL *tv;
+    REAL *uv;
+    REAL *pnt_rv;
+    REAL *pnt_r2v;
+
+
+    /* Lumped coefficients and the synthesized signal along the latitude
+     * parallels */
+    REAL *ftmp;
+    FFTWC(complex) *fc;
+    FFTWC(complex) *fc2;
+    REAL *fc_simd;
+    REAL *fc2_simd;
+    REAL *fi;
+    REAL *fi2;
+
+
+    /* Per-thread arrays.  "lc" has "nthreads * nmodels" elements, the
+     * lumped coefficients of the "k"th model are in "lc[tid * nmodels + k]".
+     * With "nmodels > 1", "leg" stores the Legendre functions of a single
+     * order (see "shs_point_kernel_batch"). */
+    int nthreads;
+    CHARM(lc) **lc;
+    REAL_SIMD **leg;
+    REAL **anm;
+    REAL **bnm;
+    REAL **enm;
+    REAL **fi_thread;
+    REAL **fi2_thread;
+};
+
+
+#endif
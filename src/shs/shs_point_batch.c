@@ -0,0 +1,172 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../prec.h"
+#include "shs_point_grd.h"
+#include "shs_point_sctr.h"
+#include "shs_point_grd_batch.h"
+#include "shs_point_gradn.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_isempty_all_mpi_processes.h"
+#include "../crd/crd_point_isSctr.h"
+#include "../crd/crd_point_isGrid.h"
+#include "../shc/shc_view_is_sliced.h"
+#if HAVE_MPI
+#   include "../mpi/mpi_check_point_shc_err.h"
+#   include "../mpi/mpi_err_gather.h"
+#endif
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(shs_point_batch)(const CHARM(point) *pnt,
+                            CHARM(shc) **shcs,
+                            size_t nmodels,
+                            unsigned long nmax,
+                            REAL **f,
+                            CHARM(err) *err)
+{
+    char err_msg[CHARM_ERR_MAX_MSG];
+
+
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    for (size_t k = 0; k < nmodels; k++)
+    {
+        if (nmax > shcs[k]->nmax)
+        {
+            snprintf(err_msg, CHARM_ERR_MAX_MSG,
+                             "Maximum harmonic degree of the synthesis "
+                             "\"nmax = %lu\" cannot be larger than maximum "
+                             "harmonic degree of spherical harmonic "
+                             "coefficients \"shcs[%zu]->nmax = %lu\".",
+                             nmax, k, shcs[k]->nmax);
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           err_msg);
+            goto BARRIER;
+        }
+
+
+        if (shcs[k]->r != shcs[0]->r)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           "All spherical harmonic coefficients must be "
+                           "associated with the same radius of the reference "
+                           "sphere \"shcs[k]->r\".");
+            goto BARRIER;
+        }
+    }
+
+
+    if (!CHARM(crd_point_isSctr)(pnt->type) &&
+        !CHARM(crd_point_isGrid)(pnt->type))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Unsupported \"pnt->type\" for spherical harmonic "
+                       "synthesis of point values.");
+        goto BARRIER;
+    }
+
+
+#if HAVE_MPI
+    for (size_t k = 0; k < nmodels; k++)
+    {
+        CHARM(mpi_check_point_shc_err)(pnt, shcs[k], err);
+        if (!CHARM(mpi_err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto BARRIER;
+        }
+    }
+#endif
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Do nothing if there are no models or if the total number of points in
+     * "pnt" is zero, which are valid cases */
+    /* --------------------------------------------------------------------- */
+    if ((nmodels == 0) || (pnt->npoint == 0))
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+BARRIER:
+    if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Now do the synthesis.  Only grids of non-distributed structures with
+     * the coefficients in the memory (including views that only truncate the
+     * coefficients) are synthesized in a single sweep over the Legendre
+     * functions.  In all other cases, the models are synthesized
+     * one by one. */
+    /* --------------------------------------------------------------------- */
+    _Bool batch = CHARM(crd_point_isGrid)(pnt->type) && (nmodels > 1) &&
+                  !pnt->distributed;
+    for (size_t k = 0; k < nmodels; k++)
+        batch = batch && !shcs[k]->distributed && (shcs[k]->lazy == NULL) &&
+                !CHARM(shc_view_is_sliced)(shcs[k]);
+
+
+    if (batch)
+        CHARM(shs_point_grd_batch)(pnt, shcs, nmodels, nmax, f, err);
+    else
+    {
+        for (size_t k = 0; k < nmodels; k++)
+        {
+            if (CHARM(crd_point_isSctr)(pnt->type))
+                CHARM(shs_point_sctr)(pnt, shcs[k], nmax, GRAD_0, GRAD_0,
+                                      GRAD_0, &f[k], err);
+            else
+                CHARM(shs_point_grd)(pnt, shcs[k], nmax, GRAD_0, GRAD_0,
+                                     GRAD_0, &f[k], err);
+
+
+            if (!CHARM(err_isempty)(err))
+                break;
+        }
+    }
+
+
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto EXIT;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+EXIT:
+#if HAVE_MPI
+    CHARM(mpi_err_gather)(err);
+#endif
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
@@ -0,0 +1,416 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fftw3.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../shc/shc_block_struct.h"
+#include "../shc/shc_block_init.h"
+#include "../shc/shc_block_free.h"
+#include "../shc/shc_block_get_coeffs.h"
+#include "../leg/leg_func_anm_bnm.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_isempty_all_mpi_processes.h"
+#include "../misc/misc_polar_optimization_threshold.h"
+#include "../misc/misc_polar_optimization_apply.h"
+#include "../simd/simd.h"
+#include "shs_grd_fft.h"
+#include "shs_grd_fft_lc.h"
+#include "shs_grd_czt.h"
+#include "shs_grd_lr.h"
+#include "shs_grd_lr2.h"
+#include "shs_r_eq_rref.h"
+#include "shs_get_mur_dorder_npar.h"
+#include "shs_point_gradn.h"
+#include "shs_lc_struct.h"
+#include "shs_rpows.h"
+#include "shs_plan_struct.h"
+#include "shs_plan_create.h"
+#include "shs_point_grd_block.h"
+#include "shs_point_grd_use_fft.h"
+#include "shs_kernels.h"
+#include "shs_point_grd_batch.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to perform the synthesis of point values (no derivatives)
+ * at grids with "nmodels" sets of spherical harmonic coefficients "shcs[0]",
+ * "shcs[1]", ..., "shcs[nmodels - 1]" at once.  All the coefficients must be
+ * associated with the same "shcs[k]->r", must not be distributed and must be
+ * stored in the memory as a whole (not returned by "shc_open_binz" and not
+ * a sliced view returned by "shc_view").  The output of the "k"th model is
+ * stored in "f[k]". */
+void CHARM(shs_point_grd_batch)(const CHARM(point) *pnt,
+                                CHARM(shc) **shcs,
+                                size_t nmodels,
+                                unsigned long nmax,
+                                REAL **f,
+                                CHARM(err) *err)
+{
+    /* Prepare everything that does not depend on "shcs" */
+    /* --------------------------------------------------------------------- */
+    REAL *mur                      = NULL;
+    CHARM(shc_block) **shcs_blocks = NULL;
+
+
+    CHARM(shs_plan) *plan = CHARM(shs_plan_create)(pnt, nmax, GRAD_0, GRAD_0,
+                                                   GRAD_0, nmodels,
+                                                   FFTW_ESTIMATE, 0, err);
+    if (plan == NULL)
+    {
+        /* With MPI, "err" may be empty if the failure occurred on some other
+         * MPI process */
+        if (!CHARM(err_isempty)(err))
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        goto FAILURE_1;
+    }
+
+
+    int pnt_type        = plan->pnt_type;
+    size_t pnt_nlat     = plan->pnt_nlat;
+    size_t pnt_nlon     = plan->pnt_nlon;
+    _Bool symm          = plan->symm;
+    REAL deltalon       = plan->deltalon;
+    REAL lon0           = plan->lon0;
+    size_t nfc          = plan->nfc;
+    size_t nfi_1par     = plan->nfi_1par;
+    size_t nfi          = plan->nfi;
+    REAL *r             = plan->r;
+    REAL *ri            = plan->ri;
+    FFTWC(complex) *fc  = plan->fc;
+    FFTWC(complex) *fc2 = plan->fc2;
+    REAL *fc_simd       = plan->fc_simd;
+    REAL *fc2_simd      = plan->fc2_simd;
+    REAL *fi            = plan->fi;
+    REAL *fi2           = plan->fi2;
+#if HAVE_RUNTIME_BLOCK
+    size_t BLOCK_S = plan->block_s;
+#else
+#   define BLOCK_S SIMD_BLOCK_S
+#endif
+    const size_t size_blk2 = SIMD_SIZE * BLOCK_S * 2;
+
+
+    /* "shcs[k]->mu / shcs[k]->r" of all models */
+    mur = (REAL *)malloc(nmodels * sizeof(REAL));
+    if (mur == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE_1;
+    }
+
+
+    unsigned dorder;
+    size_t npar;
+    for (size_t k = 0; k < nmodels; k++)
+    {
+        CHARM(shs_get_mur_dorder_npar)(shcs[k], GRAD_0, GRAD_0, GRAD_0,
+                                       &mur[k], &dorder, &npar, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto FAILURE_1;
+        }
+    }
+
+
+    /* All models share "shcs[k]->r", so the powers of "shcs[0]->r / pnt->r"
+     * are valid for all of them */
+    _Bool r_eq_rref = CHARM(shs_r_eq_rref)(pnt, shcs[0]);
+    const REAL_SIMD rref = SET1_R(shcs[0]->r);
+
+
+    shcs_blocks = (CHARM(shc_block) **)calloc(nmodels,
+                                              sizeof(CHARM(shc_block) *));
+    if (shcs_blocks == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto FAILURE_1;
+    }
+
+
+    for (size_t k = 0; k < nmodels; k++)
+    {
+        shcs_blocks[k] = CHARM(shc_block_init)(shcs[k]);
+        if (shcs_blocks[k] == NULL)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto FAILURE_1;
+        }
+
+
+        CHARM(shc_block_get_coeffs)(shcs[k], shcs_blocks[k], 0, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto FAILURE_1;
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Loop over grid latitudes */
+    /* --------------------------------------------------------------------- */
+    size_t l;
+    unsigned long lc_err_glob = 0;
+
+
+    /* Get the polar optimization threshold */
+    REAL_SIMD pt = CHARM(misc_polar_optimization_threshold)(nmax);
+
+
+    plan->nblocks_fft  = 0;
+    plan->nblocks_pslr = 0;
+
+
+    for (size_t i = 0; i < plan->imax; i += plan->istep)
+    {
+        /* Latitude-dependent quantities of this latitude block */
+        /* ----------------------------------------------------------------- */
+        CHARM(shs_point_grd_block)(plan, i, 0);
+
+
+        REAL *symmv          = plan->symmv;
+        REAL *latsinv        = plan->latsinv;
+        REAL_SIMD *t         = plan->t;
+        REAL_SIMD *u         = plan->u;
+        REAL_SIMD *symm_simd = plan->symm_simd;
+        REAL *ps             = plan->ps;
+        INT *ips             = plan->ips;
+        REAL_SIMD *rpows     = plan->rpows;
+        REAL_SIMD *rpows2    = plan->rpows2;
+
+
+        if (!r_eq_rref)
+        {
+            for (l = 0; l < BLOCK_S; l++)
+            {
+                CHARM(shs_rpows)(plan->pnt_r[l], rref, nmax + 1, BLOCK_S,
+                                 rpows + l);
+
+
+                if (symm)
+                    CHARM(shs_rpows)(plan->pnt_r2[l], rref, nmax + 1,
+                                     BLOCK_S, rpows2 + l);
+            }
+        }
+
+
+        /* Transform this latitude block along the parallels either by FFT
+         * or by the PSLR algorithm */
+        _Bool use_fft = CHARM(shs_point_grd_use_fft)(plan, u, pt);
+        if (use_fft)
+            plan->nblocks_fft++;
+        else
+            plan->nblocks_pslr++;
+
+
+        if (use_fft)
+        {
+            /* The orders skipped by the polar optimization are not written to
+             * "fc_simd" and "fc2_simd", so these must not keep the values
+             * from the previous latitude block */
+            memset(fc, 0, nfc * sizeof(FFTWC(complex)));
+            memset(fc_simd, 0, nmodels * nfc * size_blk2 * sizeof(REAL));
+            if (symm)
+            {
+                memset(fc2, 0, nfc * sizeof(FFTWC(complex)));
+                memset(fc2_simd, 0, nmodels * nfc * size_blk2 * sizeof(REAL));
+            }
+        }
+        else
+        {
+            memset(fi, 0, nmodels * nfi * sizeof(REAL));
+            if (symm)
+                memset(fi2, 0, nmodels * nfi * sizeof(REAL));
+        }
+        /* ----------------------------------------------------------------- */
+
+
+        /* ----------------------------------------------------------------- */
+#undef MPI_VARS
+#if HAVE_RUNTIME_BLOCK
+#   define MPI_VARS shared(BLOCK_S)
+#else
+#   define MPI_VARS
+#endif
+
+
+#if HAVE_OPENMP
+#pragma omp parallel default(none) num_threads(plan->nthreads) \
+shared(plan, nmax, nmodels, pt, t, u, ri, r, ips, ps, symm_simd, rpows) \
+shared(rpows2, r_eq_rref, shcs_blocks, use_fft, nfc, symm, fi, fi2, nfi) \
+shared(nfi_1par, pnt_type, pnt_nlon, deltalon, lon0, fc_simd, fc2_simd) \
+shared(lc_err_glob, size_blk2) private(l) MPI_VARS SHS_KERNEL_VARS
+#endif
+        {
+        unsigned long lc_err_priv = 0;
+
+
+#if HAVE_OPENMP
+        int tid = omp_get_thread_num();
+#else
+        int tid = 0;
+#endif
+        CHARM(lc) **lc   = plan->lc + tid * nmodels;
+        REAL *anm        = plan->anm[tid];
+        REAL *bnm        = plan->bnm[tid];
+        REAL_SIMD *leg   = plan->leg[tid];
+        REAL *fi_thread  = plan->fi_thread[tid];
+        REAL *fi2_thread = plan->fi2_thread[tid];
+
+
+        for (size_t k = 0; k < nmodels; k++)
+            lc[k]->error = 0;
+        if (!use_fft)
+        {
+            memset(fi_thread, 0, nmodels * nfi * sizeof(REAL));
+            memset(fi2_thread, 0, nmodels * nfi * sizeof(REAL));
+        }
+
+
+#if HAVE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (unsigned long m = 0; m <= nmax; m++)
+        {
+            /* Apply polar optimization if asked to do so */
+            if (CHARM(misc_polar_optimization_apply)(m, nmax, &u[0], BLOCK_S,
+                                                     pt))
+                continue;
+
+
+            CHARM(leg_func_anm_bnm)(nmax, m, r, ri, anm, bnm);
+
+
+            /* Lumped coefficients of all models */
+            SHS_KERNEL(shs_point_kernel_batch)(nmax, m, shcs_blocks, nmodels,
+                                               r_eq_rref, anm, bnm, &t[0], ps,
+                                               ips, &rpows[0], rpows2,
+                                               &symm_simd[0], BLOCK_S, leg,
+                                               lc);
+            if (lc[0]->error)
+            {
+                lc_err_priv += 1;
+                continue;
+            }
+
+
+            for (size_t k = 0; k < nmodels; k++)
+            {
+                if (use_fft)
+                    CHARM(shs_grd_fft_lc)(m, deltalon, 0, lc[k], symm,
+                                          &symm_simd[0], pnt_type, nfc,
+                                          BLOCK_S,
+                                          fc_simd + k * nfc * size_blk2,
+                                          (symm) ?
+                                          fc2_simd + k * nfc * size_blk2 :
+                                          NULL);
+                else
+                    CHARM(shs_grd_lr)(m, lon0, deltalon, pnt_nlon, pnt_type,
+                                      0, nfi_1par, BLOCK_S, lc[k], symm,
+                                      fi_thread + k * nfi,
+                                      fi2_thread + k * nfi);
+
+
+                if (lc[k]->error)
+                    lc_err_priv += 1;
+            }
+        }
+
+
+        if (!use_fft)
+        {
+#if HAVE_OPENMP
+#pragma omp critical
+#endif
+            {
+            for (l = 0; l < nmodels * nfi; l++)
+                fi[l] += fi_thread[l];
+
+
+            if (symm)
+                for (l = 0; l < nmodels * nfi; l++)
+                    fi2[l] += fi2_thread[l];
+            }
+        }
+
+
+#if HAVE_OPENMP
+#pragma omp atomic
+#endif
+        lc_err_glob += lc_err_priv;
+        }  /* End of parallel block */
+        /* ----------------------------------------------------------------- */
+
+
+        for (size_t k = 0; k < nmodels; k++)
+        {
+            if (use_fft && (plan->czt != NULL))
+                /* Chirp-z transform along the latitude parallels */
+                CHARM(shs_grd_czt)(i, pnt_nlat, pnt_nlon, latsinv,
+                                   fc_simd + k * nfc * size_blk2,
+                                   (symm) ? fc2_simd + k * nfc * size_blk2 :
+                                            NULL,
+                                   mur[k], symmv, BLOCK_S, plan->czt,
+                                   f[k]);
+            else if (use_fft)
+                /* Fourier transform along the latitude parallels */
+                CHARM(shs_grd_fft)(i, pnt_type, pnt_nlat, pnt_nlon,
+                                   latsinv, NULL, NULL, PREC(0.0),
+                                   fc, fc2, nfc,
+                                   fc_simd + k * nfc * size_blk2,
+                                   (symm) ? fc2_simd + k * nfc * size_blk2 :
+                                            NULL,
+                                   mur[k], plan->plan, symmv, BLOCK_S,
+                                   plan->ftmp, f[k]);
+            else
+                CHARM(shs_grd_lr2)(i, latsinv, pnt_type, pnt_nlat,
+                                   pnt_nlon, symmv, BLOCK_S, mur[k],
+                                   NULL, NULL, PREC(0.0), fi + k * nfi,
+                                   (symm) ? fi2 + k * nfi : NULL, f[k]);
+        }
+    } /* End of the loop over latitude parallels */
+
+
+    if (lc_err_glob)
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+FAILURE_1:
+    if (shcs_blocks != NULL)
+        for (size_t k = 0; k < nmodels; k++)
+            CHARM(shc_block_free)(shcs_blocks[k]);
+    free(shcs_blocks);
+    free(mur);
+    CHARM(shs_plan_free)(plan);
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
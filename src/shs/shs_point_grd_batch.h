@@ -0,0 +1,31 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_POINT_GRD_BATCH_H__
+#define __SHS_POINT_GRD_BATCH_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shs_point_grd_batch)(const CHARM(point) *,
+                                       CHARM(shc) **,
+                                       size_t,
+                                       unsigned long,
+                                       REAL **,
+                                       CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
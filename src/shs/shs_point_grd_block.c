@@ -0,0 +1,122 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <math.h>
+#include "../prec.h"
+#include "../crd/crd_point_isDHGrid.h"
+#include "../crd/crd_grd_check_symm.h"
+#include "../leg/leg_func_prepare.h"
+#include "../simd/simd.h"
+#include "shs_plan_struct.h"
+#include "shs_point_grd_block.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to compute latitude-dependent quantities of the latitude
+ * block starting at the "i"th latitude.  The results are stored in the
+ * "slot"th latitude block of "plan". */
+void CHARM(shs_point_grd_block)(CHARM(shs_plan) *plan,
+                                size_t i,
+                                size_t slot)
+{
+    const CHARM(point) *pnt    = plan->pnt;
+    const unsigned long nmax   = plan->nmax;
+    const int pnt_type         = plan->pnt_type;
+    const size_t pnt_nlat      = plan->pnt_nlat;
+    const size_t local_0_start = plan->local_0_start;
+    const _Bool symm           = plan->symm;
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = plan->block_s;
+#else
+#   define BLOCK_S SIMD_BLOCK_S
+#endif
+
+
+    REAL *tv      = plan->tv;
+    REAL *uv      = plan->uv;
+    REAL *pnt_rv  = plan->pnt_rv;
+    REAL *pnt_r2v = plan->pnt_r2v;
+
+
+    REAL *symmv          = plan->symmv + slot * SIMD_SIZE * BLOCK_S;
+    REAL *latsinv        = plan->latsinv + slot * SIMD_SIZE * BLOCK_S;
+    REAL_SIMD *t         = plan->t + slot * BLOCK_S;
+    REAL_SIMD *u         = plan->u + slot * BLOCK_S;
+    REAL_SIMD *symm_simd = plan->symm_simd + slot * BLOCK_S;
+    REAL_SIMD *pnt_r     = plan->pnt_r + slot * BLOCK_S;
+    REAL_SIMD *pnt_r2    = (symm) ? plan->pnt_r2 + slot * BLOCK_S : NULL;
+    REAL *ps             = plan->ps + slot * nmax * SIMD_SIZE * BLOCK_S;
+    INT *ips             = plan->ips + slot * nmax * SIMD_SIZE * BLOCK_S;
+
+
+    size_t ipv;
+    for (size_t l = 0; l < BLOCK_S; l++)
+    {
+        for (size_t v = 0; v < SIMD_SIZE; v++)
+        {
+            /* Check whether the symmetry property of LFs can be applied */
+            /* ------------------------------------------------------------- */
+            ipv = i + l * SIMD_SIZE + v;
+            CHARM(crd_grd_check_symm)(ipv, v, local_0_start, plan->equator,
+                                      pnt_type,
+                                      plan->nlatdo, symm, plan->even,
+                                      symmv + l * SIMD_SIZE,
+                                      latsinv + l * SIMD_SIZE);
+
+
+            if (latsinv[l * SIMD_SIZE + v] == 1)
+            {
+                tv[v]     = SIN(pnt->lat[ipv]);
+                uv[v]     = COS(pnt->lat[ipv]);
+                pnt_rv[v] = pnt->r[ipv];
+
+
+                if (symm)
+                {
+                    if (CHARM(crd_point_isDHGrid)(pnt_type) &&
+                        ((ipv + local_0_start) == 0))
+                        /* For the Driscoll--Healy grids, we increased
+                         * "pnt_nlat" by one, so to ensure we won't read
+                         * outside the bounds of "pnt->r", we set now the
+                         * non-existing radius at the south pole to zero. */
+                        pnt_r2v[v] = PREC(0.0);
+                    else
+                        pnt_r2v[v] = pnt->r[pnt_nlat - ipv - 1];
+                }
+            }
+            else
+            {
+                tv[v] = uv[v] = pnt_rv[v] = PREC(0.0);
+                if (symm)
+                    pnt_r2v[v] = PREC(0.0);
+
+
+                continue;
+            }
+            /* ------------------------------------------------------------- */
+        }
+
+
+        t[l]         = LOAD_R(&tv[0]);
+        u[l]         = LOAD_R(&uv[0]);
+        pnt_r[l]     = LOAD_R(&pnt_rv[0]);
+        symm_simd[l] = LOAD_R(&symmv[l * SIMD_SIZE]);
+        if (symm)
+            pnt_r2[l] = LOAD_R(&pnt_r2v[0]);
+
+
+        /* Prepare arrays for sectorial Legendre functions */
+        /* ----------------------------------------------------------------- */
+        CHARM(leg_func_prepare)(uv, ps + l * SIMD_SIZE * nmax,
+                                ips + l * SIMD_SIZE * nmax, plan->dm, nmax);
+        /* ----------------------------------------------------------------- */
+    }
+
+
+    return;
+}
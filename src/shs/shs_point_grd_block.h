@@ -0,0 +1,28 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_POINT_GRD_BLOCK_H__
+#define __SHS_POINT_GRD_BLOCK_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shs_point_grd_block)(CHARM(shs_plan) *,
+                                       size_t,
+                                       size_t);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,596 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fftw3.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#if HAVE_MPI
+#   include <mpi.h>
+#endif
+#include "../prec.h"
+#include "../shc/shc_block_struct.h"
+#include "../shc/shc_block_init.h"
+#include "../shc/shc_block_free.h"
+#include "../shc/shc_block_have_order.h"
+#include "../shc/shc_block_get_coeffs.h"
+#include "../leg/leg_func_anm_bnm.h"
+#include "../leg/leg_func_enm.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_isempty_all_mpi_processes.h"
+#include "../err/err_omp_mpi.h"
+#include "../misc/misc_polar_optimization_threshold.h"
+#include "../misc/misc_polar_optimization_apply.h"
+#include "../simd/simd.h"
+#include "shs_grd_fft.h"
+#include "shs_grd_fft_lc.h"
+#include "shs_grd_czt.h"
+#include "shs_grd_lr.h"
+#include "shs_grd_lr2.h"
+#include "shs_kernels.h"
+#include "shs_r_eq_rref.h"
+#include "shs_get_mur_dorder_npar.h"
+#include "shs_point_gradn.h"
+#include "shs_lc_struct.h"
+#include "shs_rpows.h"
+#include "shs_plan_struct.h"
+#include "shs_point_grd_block.h"
+#include "shs_point_grd_use_fft.h"
+#include "shs_point_grd_exec.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to perform the synthesis of point values at grids using
+ * a plan created by "shs_plan_create". */
+void CHARM(shs_point_grd_exec)(CHARM(shs_plan) *plan,
+                               const CHARM(shc) *shcs,
+                               REAL **f,
+                               CHARM(err) *err)
+{
+    /* Get some constants */
+    /* --------------------------------------------------------------------- */
+    unsigned long nmax  = plan->nmax;
+    int dr              = plan->dr;
+    int dlat            = plan->dlat;
+    int dlon            = plan->dlon;
+    unsigned dorder     = plan->dorder;
+    size_t npar         = plan->npar;
+    int grad            = plan->grad;
+    int pnt_type        = plan->pnt_type;
+    size_t pnt_nlat     = plan->pnt_nlat;
+    size_t pnt_nlon     = plan->pnt_nlon;
+    _Bool symm          = plan->symm;
+    REAL deltalon       = plan->deltalon;
+    REAL lon0           = plan->lon0;
+    size_t nfc          = plan->nfc;
+    size_t nfi_1par     = plan->nfi_1par;
+    size_t nfi          = plan->nfi;
+    REAL *r             = plan->r;
+    REAL *ri            = plan->ri;
+    FFTWC(complex) *fc  = plan->fc;
+    FFTWC(complex) *fc2 = plan->fc2;
+    REAL *fc_simd       = plan->fc_simd;
+    REAL *fc2_simd      = plan->fc2_simd;
+    REAL *fi            = plan->fi;
+    REAL *fi2           = plan->fi2;
+#if HAVE_RUNTIME_BLOCK
+    size_t BLOCK_S = plan->block_s;
+#else
+#   define BLOCK_S SIMD_BLOCK_S
+#endif
+
+
+    REAL mur;  /* "(shcs->mu / shcs->r)^dorder" */
+    CHARM(shs_get_mur_dorder_npar)(shcs, dr, dlat, dlon, &mur, &dorder, &npar,
+                                   err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
+    /* Check whether all values of "pnt->r" are equal to "shcs->r".  If true,
+     * a faster code can be used inside "shs_point_kernel".  */
+    _Bool r_eq_rref = CHARM(shs_r_eq_rref)(plan->pnt, shcs);
+
+
+    /* The powers of "shcs->r / pnt->r" that are stored in "plan" can be
+     * reused only if they were computed for the same "shcs->r" */
+    _Bool rpows_set = plan->cache && plan->rpows_set &&
+                      (plan->rpows_rref == shcs->r);
+    if (plan->cache)
+        plan->rpows_set = 0;
+
+
+    /* If "r_eq_rref" is true, the kernels expect the powers to be equal to
+     * one, so restore them if some previous execution of "plan" overwrote
+     * them */
+    if (r_eq_rref && !plan->rpows_ones)
+    {
+        for (size_t i = 0; i < plan->nslots * plan->nrpows; i++)
+            plan->rpows[i] = SET1_R(PREC(1.0));
+
+
+        if (plan->symm)
+            for (size_t i = 0; i < plan->nslots * plan->nrpows; i++)
+                plan->rpows2[i] = SET1_R(PREC(1.0));
+    }
+    plan->rpows_ones = r_eq_rref;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(shc_block) *shcs_block = NULL;
+    shcs_block = CHARM(shc_block_init)(shcs);
+    if (shcs_block == NULL)
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+
+
+    if (!CHARM_ERR_ISEMPTY_ALL_MPI_PROCESSES(err))
+        goto FAILURE_1;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Loop over grid latitudes */
+    /* --------------------------------------------------------------------- */
+    size_t l;
+    int err_glob = 0;
+    unsigned long lc_err_glob = 0;
+    const size_t size_blk2 = SIMD_SIZE * BLOCK_S * 2;
+
+
+    /* Get the polar optimization threshold */
+    REAL_SIMD pt = CHARM(misc_polar_optimization_threshold)(nmax);
+
+
+    /* Radius of the reference sphere that is associated with the spherical
+     * harmonic coefficients */
+    const REAL_SIMD rref = SET1_R(shcs->r);
+
+
+    plan->nblocks_fft  = 0;
+    plan->nblocks_pslr = 0;
+
+
+    for (size_t i = 0; i < plan->imax; i += plan->istep)
+    {
+        /* Latitude-dependent quantities of this latitude block */
+        /* ----------------------------------------------------------------- */
+        size_t slot;
+        if (plan->cache)
+            slot = i / plan->istep;
+        else
+        {
+            slot = 0;
+            CHARM(shs_point_grd_block)(plan, i, slot);
+        }
+
+
+        REAL *symmv          = plan->symmv + slot * SIMD_SIZE * BLOCK_S;
+        REAL *latsinv        = plan->latsinv + slot * SIMD_SIZE * BLOCK_S;
+        REAL_SIMD *t         = plan->t + slot * BLOCK_S;
+        REAL_SIMD *u         = plan->u + slot * BLOCK_S;
+        REAL_SIMD *symm_simd = plan->symm_simd + slot * BLOCK_S;
+        REAL *ps             = plan->ps + slot * nmax * SIMD_SIZE * BLOCK_S;
+        INT *ips             = plan->ips + slot * nmax * SIMD_SIZE * BLOCK_S;
+        REAL_SIMD *rpows     = plan->rpows + slot * plan->nrpows;
+        REAL_SIMD *rpows2    = (symm) ? plan->rpows2 + slot * plan->nrpows :
+                                        plan->rpows2;
+
+
+        if (!r_eq_rref && !rpows_set)
+        {
+            for (l = 0; l < BLOCK_S; l++)
+            {
+                CHARM(shs_rpows)(plan->pnt_r[slot * BLOCK_S + l], rref,
+                                 nmax + 1 + dorder, BLOCK_S, rpows + l);
+
+
+                if (symm)
+                    CHARM(shs_rpows)(plan->pnt_r2[slot * BLOCK_S + l], rref,
+                                     nmax + 1 + dorder, BLOCK_S, rpows2 + l);
+            }
+        }
+        /* ----------------------------------------------------------------- */
+
+
+        /* Transform this latitude block along the parallels either by FFT
+         * or by the PSLR algorithm */
+        _Bool use_fft = CHARM(shs_point_grd_use_fft)(plan, u, pt);
+        if (use_fft)
+            plan->nblocks_fft++;
+        else
+            plan->nblocks_pslr++;
+
+
+        if (use_fft)
+        {
+            /* Reset the lumped coefficients.  Required in some cases.  The
+             * orders skipped by the polar optimization are not written to
+             * "fc_simd" and "fc2_simd", so these must not keep the values
+             * from the previous latitude block. */
+            /* ------------------------------------------------------------- */
+            memset(fc, 0, nfc * sizeof(FFTWC(complex)));
+            memset(fc_simd, 0, npar * nfc * size_blk2 * sizeof(REAL));
+
+
+            if (symm)
+            {
+                memset(fc2, 0, nfc * sizeof(FFTWC(complex)));
+                memset(fc2_simd, 0, npar * nfc * size_blk2 * sizeof(REAL));
+            }
+            /* ------------------------------------------------------------- */
+        }
+        else
+        {
+            /* The "fi" vector represents the synthesized quantity "f" for the
+             * "ipv"th latitude parallel. Therefore, it needs to be
+             * reinitialized to zero for each "ith" latitude. The same holds
+             * true for "fi2" in case of symmetric grids. */
+            /* ------------------------------------------------------------- */
+            memset(fi, 0, nfi * sizeof(REAL));
+
+
+            if (symm)
+                memset(fi2, 0, nfi * sizeof(REAL));
+            /* ------------------------------------------------------------- */
+        }
+
+
+        /* ------------------------------------------------------------- */
+        _Bool have_order;
+#undef MPI_VARS
+#if HAVE_MPI || HAVE_RUNTIME_BLOCK
+#   define MPI_VARS shared(have_order, BLOCK_S)
+#else
+#   define MPI_VARS shared(have_order)
+#endif
+
+
+#if HAVE_OPENMP
+#pragma omp parallel default(none) num_threads(plan->nthreads) \
+shared(plan, nmax, err, dorder, pt, t, u, ri, r, ips, ps, dr, dlat, dlon) \
+shared(symm_simd, rpows, rpows2, r_eq_rref, shcs, shcs_block) \
+shared(use_fft, nfc, symm, grad, fi, fi2, nfi, nfi_1par) \
+shared(pnt_type, pnt_nlon, deltalon, lon0, fc_simd, fc2_simd, err_glob) \
+shared(lc_err_glob) \
+private(l) MPI_VARS SHS_KERNEL_VARS
+#endif
+        {
+        /* ------------------------------------------------------------- */
+        int err_priv = 0;
+        unsigned long lc_err_priv = 0;
+
+
+#if HAVE_OPENMP
+        int tid = omp_get_thread_num();
+#else
+        int tid = 0;
+#endif
+        CHARM(lc) *lc    = plan->lc[tid];
+        REAL *anm        = plan->anm[tid];
+        REAL *bnm        = plan->bnm[tid];
+        REAL *enm        = plan->enm[tid];
+        REAL *fi_thread  = plan->fi_thread[tid];
+        REAL *fi2_thread = plan->fi2_thread[tid];
+
+
+        lc->error = 0;
+        if (!use_fft)
+        {
+            memset(fi_thread, 0, nfi * sizeof(REAL));
+            memset(fi2_thread, 0, nfi * sizeof(REAL));
+        }
+        /* ------------------------------------------------------------- */
+
+
+        /* Feed "shcs_block" starting with order "0" */
+        /* ------------------------------------------------------------- */
+        CHARM(shc_block_get_coeffs)(shcs, shcs_block, 0, err);
+        if (!CHARM(err_isempty)(err))
+        {
+#if HAVE_OPENMP
+#pragma omp master
+#endif
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+#if HAVE_OPENMP
+#pragma omp barrier
+#endif
+            goto BARRIER_2;
+        }
+        /* ------------------------------------------------------------- */
+
+
+        /* Loop over harmonic orders */
+        /* ------------------------------------------------------------- */
+        /* For a more detailed description of the rational behind this block,
+         * see "shs_point_sctr.c" */
+        unsigned long m = shcs_block->mfirst;
+
+
+        do
+        {
+#if HAVE_OPENMP
+#pragma omp master
+#endif
+            have_order = CHARM(shc_block_have_order)(shcs_block, m);
+
+
+#if HAVE_OPENMP
+#pragma omp barrier
+#endif
+
+            /* Distributed structures, structures returned by
+             * "shc_open_binz" and sliced views store only some of the orders
+             * in "shcs_block", so the next block of orders is gathered,
+             * decompressed or copied here.  Other structures have all orders
+             * in "shcs_block", so "have_order" is always "1". */
+            if (!have_order)
+            {
+                CHARM(shc_block_get_coeffs)(shcs, shcs_block, m, err);
+                if (!CHARM(err_isempty)(err))
+                {
+                    /* "err" is shared, so only one thread may propagate */
+#if HAVE_OPENMP
+#pragma omp master
+#endif
+                    CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+#if HAVE_OPENMP
+#pragma omp barrier
+#endif
+                    goto BARRIER_2;
+                }
+            }
+
+
+            /* ............................................................. */
+BARRIER_2:
+            if (CHARM(err_omp_mpi)(&err_glob, &err_priv,
+                                   CHARM_ERR_MALLOC_FAILURE, CHARM_EMEM, err))
+            {
+#if HAVE_OPENMP
+#pragma omp master
+#endif
+                if (!CHARM(err_isempty)(err))
+                    CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+#if HAVE_OPENMP
+#pragma omp barrier
+#endif
+                goto FAILURE_2;
+            }
+            /* ............................................................. */
+
+
+            /* The minimum and the maximum orders of the loop are the same for
+             * all OpenMP threads */
+            unsigned long mmin = shcs_block->mfirst;
+            unsigned long mmax = CHARM_MIN(shcs_block->mlast, nmax);
+
+
+#if HAVE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for (m = mmin; m <= mmax; m++)
+            {
+                /* Apply polar optimization if asked to do so */
+                if (CHARM(misc_polar_optimization_apply)(m, nmax, &u[0],
+                                                         BLOCK_S, pt))
+                    continue;
+
+
+                /* "anm" and "bnm" coefficients for Legendre recurrence
+                 * relations and for their derivatives */
+                CHARM(leg_func_anm_bnm)(nmax, m, r, ri, anm, bnm);
+                if (dorder > 0)
+                    CHARM(leg_func_enm)(nmax, m, r, ri, enm);
+
+
+                /* Computation of the lumped coefficients */
+                /* --------------------------------------------------------- */
+#undef KERNEL_IO_PARS
+#define KERNEL_IO_PARS (nmax, m, shcs_block, r_eq_rref, anm, bnm, enm,        \
+                        &t[0], &u[0], ps, ips,                                \
+                        &rpows[0], &rpows2[0],                                \
+                        &symm_simd[0], dorder, BLOCK_S, lc);
+                if ((dr == 0) && (dlat == 0) && (dlon == 0))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat0_dlon0)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == 1) && (dlat == 0) && (dlon == 0))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr1_dlat0_dlon0)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == 2) && (dlat == 0) && (dlon == 0))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr2_dlat0_dlon0)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == 0) && (dlat == 1) && (dlon == 0))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat1_dlon0)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == 0) && (dlat == 2) && (dlon == 0))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat2_dlon0)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == 0) && (dlat == 0) && (dlon == 1))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat0_dlon1)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == 0) && (dlat == 0) && (dlon == 2))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat0_dlon2)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == 1) && (dlat == 1) && (dlon == 0))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr1_dlat1_dlon0)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == 1) && (dlat == 0) && (dlon == 1))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr1_dlat0_dlon1)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == 0) && (dlat == 1) && (dlon == 1))
+                {
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat1_dlon1)
+                        KERNEL_IO_PARS;
+                }
+                else if ((dr == GRAD_1) && (dlat == GRAD_1) &&
+                         (dlon == GRAD_1))
+                {
+                    SHS_KERNEL(shs_point_kernel_grad1) KERNEL_IO_PARS;
+                }
+                else if ((dr == GRAD_2) && (dlat == GRAD_2) &&
+                         (dlon == GRAD_2))
+                {
+                    SHS_KERNEL(shs_point_kernel_grad2) KERNEL_IO_PARS;
+                }
+
+
+                if (lc->error)
+                    lc_err_priv += 1;
+                /* --------------------------------------------------------- */
+
+
+                /* --------------------------------------------------------- */
+                if (use_fft)
+                    CHARM(shs_grd_fft_lc)(m, deltalon, grad, lc,
+                                          symm, &symm_simd[0], pnt_type,
+                                          nfc, BLOCK_S, fc_simd, fc2_simd);
+                else
+                    CHARM(shs_grd_lr)(m, lon0, deltalon, pnt_nlon, pnt_type,
+                                      grad, nfi_1par, BLOCK_S, lc, symm,
+                                      fi_thread, fi2_thread);
+
+
+                if (lc->error)
+                    lc_err_priv += 1;
+                /* --------------------------------------------------------- */
+
+
+            } /* End of the loop over harmonic orders */
+
+
+            /* See "shs_point_sctr.c" for the rational here */
+            m = mmax + 1;
+        }
+        while (m <= nmax);
+
+
+        /* With the Chebyshev recurrences, we must gather the results from
+         * threads and combine them */
+        if (!use_fft)
+        {
+#if HAVE_OPENMP
+#pragma omp critical
+#endif
+            {
+            for (l = 0; l < nfi; l++)
+                fi[l] += fi_thread[l];
+
+
+            lc_err_glob += lc_err_priv;
+            }
+
+            if (symm)
+            {
+#if HAVE_OPENMP
+#pragma omp critical
+#endif
+                for (l = 0; l < nfi; l++)
+                    fi2[l] += fi2_thread[l];
+            }
+        }
+
+
+FAILURE_2:
+        ;
+        }  /* End of parallel block */
+        /* ------------------------------------------------------------- */
+
+
+        for (size_t p = 0; p < npar; p++)
+        {
+            if (use_fft && (plan->czt != NULL))
+                /* Chirp-z transform along the latitude parallels */
+                CHARM(shs_grd_czt)(i, pnt_nlat, pnt_nlon, latsinv,
+                                   &fc_simd[p * nfc * size_blk2],
+                                   &fc2_simd[p * nfc * size_blk2],
+                                   mur, symmv, BLOCK_S, plan->czt,
+                                   f[p]);
+            else if (use_fft)
+                /* Fourier transform along the latitude parallels */
+                CHARM(shs_grd_fft)(i, pnt_type, pnt_nlat, pnt_nlon,
+                                   latsinv, NULL, NULL, PREC(0.0),
+                                   fc, fc2, nfc,
+                                   &fc_simd[p * nfc * size_blk2],
+                                   &fc2_simd[p * nfc * size_blk2],
+                                   mur, plan->plan, symmv, BLOCK_S,
+                                   plan->ftmp, f[p]);
+            else
+                CHARM(shs_grd_lr2)(i, latsinv, pnt_type, pnt_nlat,
+                                   pnt_nlon, symmv, BLOCK_S, mur, NULL,
+                                   NULL, PREC(0.0),
+                                   &fi[p * nfi_1par], &fi2[p * nfi_1par],
+                                   f[p]);
+        }
+
+
+    } /* End of the loop over latitude parallels */
+
+
+    if (lc_err_glob)
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+    else if (plan->cache && !r_eq_rref)
+    {
+        plan->rpows_rref = shcs->r;
+        plan->rpows_set  = 1;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+FAILURE_1:
+    CHARM(shc_block_free)(shcs_block);
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
@@ -0,0 +1,29 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_POINT_GRD_EXEC_H__
+#define __SHS_POINT_GRD_EXEC_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void CHARM(shs_point_grd_exec)(CHARM(shs_plan) *,
+                                      const CHARM(shc) *,
+                                      REAL **,
+                                      CHARM(err) *);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,58 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "../misc/misc_polar_optimization_apply.h"
+#include "../simd/simd.h"
+#include "shs_plan_struct.h"
+#include "shs_point_grd_use_fft.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to decide whether the latitude block with the cosines of
+ * the latitudes "u" is transformed along the parallels by FFT or by the
+ * chirp-z transform if "plan->czt != NULL" ("1") or by the PSLR algorithm
+ * ("0").  "pt" is the polar optimization threshold.
+ *
+ * FFT is used whenever it can be applied, unless the number of harmonic
+ * orders, which are not skipped by the polar optimization at this latitude
+ * block, is smaller than "plan->pslr_nm" (see "shs_plan_create.c"). */
+_Bool CHARM(shs_point_grd_use_fft)(const CHARM(shs_plan) *plan,
+                                   REAL_SIMD *u,
+                                   REAL_SIMD pt)
+{
+    if (!plan->use_fft)
+        return 0;
+    if (plan->pslr_nm <= PREC(0.0))
+        return 1;
+
+
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = plan->block_s;
+#else
+#   define BLOCK_S SIMD_BLOCK_S
+#endif
+
+
+    /* If the polar optimization skips the order "m", it skips all the higher
+     * orders, too, so "m" is the number of the synthesized orders */
+    unsigned long m;
+    for (m = 0; m <= plan->nmax; m++)
+    {
+        if ((REAL)m >= plan->pslr_nm)
+            return 1;
+
+
+        if (CHARM(misc_polar_optimization_apply)(m, plan->nmax, &u[0],
+                                                 BLOCK_S, pt))
+            break;
+    }
+
+
+    return ((REAL)m >= plan->pslr_nm);
+}
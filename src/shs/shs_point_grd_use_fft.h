@@ -0,0 +1,29 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_POINT_GRD_USE_FFT_H__
+#define __SHS_POINT_GRD_USE_FFT_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern _Bool CHARM(shs_point_grd_use_fft)(const CHARM(shs_plan) *,
+                                          REAL_SIMD *,
+                                          REAL_SIMD);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -64,7 +64,6 @@
 #include "../leg/leg_func_xnum.h"
 #include "../leg/leg_func_use_xnum.h"
 #include "../misc/misc_sd_calloc.h"
-#include "../glob/glob_get_shs_block_lat_multiplier.h"
 #include "shs_check_symm_simd.h"
 #include "shs_point_gradn.h"
 #include "shs_lc_struct.h"
@@ -289,6 +288,17 @@
 #endif
 
 
+/* "PM_MUL_R(PM_R, x, y, z)" computes "PM_R(z, MUL_R(x, y))", where "PM_R" is
+ * either "ADD_R" or "SUB_R".  The product is accumulated by the fused
+ * multiply-add instructions whenever these are available. */
+#undef FMA_ADD_R
+#undef FMA_SUB_R
+#undef PM_MUL_R
+#define FMA_ADD_R(x, y, z)        FMA_R((x), (y), (z))
+#define FMA_SUB_R(x, y, z)        FNMA_R((x), (y), (z))
+#define PM_MUL_R(PM_R, x, y, z)   CAT(FMA_, PM_R)((x), (y), (z))
+
+
 /* Lumped coefficients for "grad0" */
 #undef GRAD0_LC
 #undef GRAD0_LC_R1
@@ -297,9 +307,9 @@
 #   define GRAD0_LC(PM_R, ab, i, cs)                                          \
            for (l = 0; l < BLOCK_S; l++)                                      \
            {                                                                  \
-               lc->CAT(ab, i)[l] = PM_R(lc->CAT(ab, i)[l],                    \
-                                        MUL_R(CAT2(rpows, i, _m)[l],          \
-                                              CAT2(leg_, cs, nm)[l]));        \
+               lc->CAT(ab, i)[l] = PM_MUL_R(PM_R, CAT2(rpows, i, _m)[l],      \
+                                            CAT2(leg_, cs, nm)[l],            \
+                                            lc->CAT(ab, i)[l]);               \
            }
 
 #   define GRAD0_LC_R1(PM_R, ab, i, cs)                                       \
@@ -322,21 +332,21 @@
 #   define GRAD1_LC(PM1_R, PM2_R, ab, i, cs)                                  \
            for (l = 0; l < BLOCK_S; l++)                                      \
            {                                                                  \
-               lc->CAT(ab, i)[l] = PM1_R(lc->CAT(ab, i)[l],                   \
-                                         MUL_R(CAT2(rpows, i, _m)[l],         \
-                                               CAT2(leg_, cs, nm)[l]));       \
+               lc->CAT(ab, i)[l] = PM_MUL_R(PM1_R, CAT2(rpows, i, _m)[l],     \
+                                            CAT2(leg_, cs, nm)[l],            \
+                                            lc->CAT(ab, i)[l]);               \
            }                                                                  \
            for (l = 0; l < BLOCK_S; l++)                                      \
            {                                                                  \
-               lc->CAT2(ab, r, i)[l] = PM1_R(lc->CAT2(ab, r, i)[l],           \
-                                             MUL_R(CAT2(rpows, i, _m)[l],     \
-                                                   CAT2(leg_, cs, nm_r)[l])); \
+               lc->CAT2(ab, r, i)[l] = PM_MUL_R(PM1_R, CAT2(rpows, i, _m)[l], \
+                                                CAT2(leg_, cs, nm_r)[l],      \
+                                                lc->CAT2(ab, r, i)[l]);       \
            }                                                                  \
            for (l = 0; l < BLOCK_S; l++)                                      \
            {                                                                  \
-               lc->CAT2(ab, p, i)[l] = PM2_R(lc->CAT2(ab, p, i)[l],           \
-                                             MUL_R(CAT2(rpows, i, _m)[l],     \
-                                                   CAT2(leg_, cs, nm_p)[l])); \
+               lc->CAT2(ab, p, i)[l] = PM_MUL_R(PM2_R, CAT2(rpows, i, _m)[l], \
+                                                CAT2(leg_, cs, nm_p)[l],      \
+                                                lc->CAT2(ab, p, i)[l]);       \
            }
 
 #   define GRAD1_LC_R1(PM1_R, PM2_R, ab, i, cs)                               \
@@ -369,21 +379,21 @@
 #   define GRAD2_LC(PM1_R, PM2_R, ab, i, cs)                                  \
            for (l = 0; l < BLOCK_S; l++)                                      \
            {                                                                  \
-               lc->CAT2(ab, rr, i)[l] = PM1_R(lc->CAT2(ab, rr, i)[l],         \
-                                              MUL_R(CAT2(rpows, i, _m)[l],    \
-                                                  CAT2(leg_, cs, nm_rr)[l])); \
+               lc->CAT2(ab, rr, i)[l] = PM_MUL_R(PM1_R, CAT2(rpows, i, _m)[l],\
+                                                 CAT2(leg_, cs, nm_rr)[l],    \
+                                                 lc->CAT2(ab, rr, i)[l]);     \
            }                                                                  \
            for (l = 0; l < BLOCK_S; l++)                                      \
            {                                                                  \
-               lc->CAT2(ab, rp, i)[l] = PM2_R(lc->CAT2(ab, rp, i)[l],         \
-                                              MUL_R(CAT2(rpows, i, _m)[l],    \
-                                                  CAT2(leg_, cs, nm_rp)[l])); \
+               lc->CAT2(ab, rp, i)[l] = PM_MUL_R(PM2_R, CAT2(rpows, i, _m)[l],\
+                                                 CAT2(leg_, cs, nm_rp)[l],    \
+                                                 lc->CAT2(ab, rp, i)[l]);     \
            }                                                                  \
            for (l = 0; l < BLOCK_S; l++)                                      \
            {                                                                  \
-               lc->CAT2(ab, pp, i)[l] = PM1_R(lc->CAT2(ab, pp, i)[l],         \
-                                              MUL_R(CAT2(rpows, i, _m)[l],    \
-                                                  CAT2(leg_, cs, nm_pp)[l])); \
+               lc->CAT2(ab, pp, i)[l] = PM_MUL_R(PM1_R, CAT2(rpows, i, _m)[l],\
+                                                 CAT2(leg_, cs, nm_pp)[l],    \
+                                                 lc->CAT2(ab, pp, i)[l]);     \
            }
 
 #   define GRAD2_LC_R1(PM1_R, PM2_R, ab, i, cs)                               \
@@ -603,13 +613,13 @@
 #define LOOP_ITER(n, PM1_R, PM2_R)                                            \
     LEG_CS((n))                                                               \
     LCAB((n), PM1_R, PM2_R)                                                   \
-    idx++;
+    idx += stride;
 
 
 #define LOOP_ITER_R1(n, PM1_R, PM2_R)                                         \
     LEG_CS((n))                                                               \
     LCAB_R1(PM1_R, PM2_R)                                                     \
-    idx++;
+    idx += stride;
 /* ------------------------------------------------------------------------- */
 
 
@@ -744,32 +754,32 @@ static inline void dlon2(REAL_SIMD *a,
  * values */
 #if KERNEL_GRAD == 0
 #   if   (DR == 0) && (DLAT == 0) && (DLON == 0)
-void CHARM(shs_point_kernel_dr0_dlat0_dlon0)
+void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat0_dlon0)
 #   elif (DR == 1) && (DLAT == 0) && (DLON == 0)
-void CHARM(shs_point_kernel_dr1_dlat0_dlon0)
+void SIMD_ISA_NAME(shs_point_kernel_dr1_dlat0_dlon0)
 #   elif (DR == 2) && (DLAT == 0) && (DLON == 0)
-void CHARM(shs_point_kernel_dr2_dlat0_dlon0)
+void SIMD_ISA_NAME(shs_point_kernel_dr2_dlat0_dlon0)
 #   elif (DR == 0) && (DLAT == 1) && (DLON == 0)
-void CHARM(shs_point_kernel_dr0_dlat1_dlon0)
+void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat1_dlon0)
 #   elif (DR == 0) && (DLAT == 2) && (DLON == 0)
-void CHARM(shs_point_kernel_dr0_dlat2_dlon0)
+void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat2_dlon0)
 #   elif (DR == 0) && (DLAT == 0) && (DLON == 1)
-void CHARM(shs_point_kernel_dr0_dlat0_dlon1)
+void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat0_dlon1)
 #   elif (DR == 0) && (DLAT == 0) && (DLON == 2)
-void CHARM(shs_point_kernel_dr0_dlat0_dlon2)
+void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat0_dlon2)
 #   elif (DR == 1) && (DLAT == 1) && (DLON == 0)
-void CHARM(shs_point_kernel_dr1_dlat1_dlon0)
+void SIMD_ISA_NAME(shs_point_kernel_dr1_dlat1_dlon0)
 #   elif (DR == 1) && (DLAT == 0) && (DLON == 1)
-void CHARM(shs_point_kernel_dr1_dlat0_dlon1)
+void SIMD_ISA_NAME(shs_point_kernel_dr1_dlat0_dlon1)
 #   elif (DR == 0) && (DLAT == 1) && (DLON == 1)
-void CHARM(shs_point_kernel_dr0_dlat1_dlon1)
+void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat1_dlon1)
 #   else
 #       error "Wrong combination of DR, DLAT and DLON."
 #   endif
 #elif KERNEL_GRAD == 1
-void CHARM(shs_point_kernel_grad1)
+void SIMD_ISA_NAME(shs_point_kernel_grad1)
 #elif KERNEL_GRAD == 2
-void CHARM(shs_point_kernel_grad2)
+void SIMD_ISA_NAME(shs_point_kernel_grad2)
 #else
 #   error "Wrong value of KERNEL_GRAD."
 #endif
@@ -788,12 +798,14 @@ void CHARM(shs_point_kernel_grad2)
                              REAL_SIMD *rpows2,
                              const REAL_SIMD *symm_simd,
                              unsigned dorder,
+                             size_t block_s,
                              CHARM(lc) *lc)
 {
     /* --------------------------------------------------------------------- */
-#if HAVE_MPI
-    const size_t BLOCK_S = CHARM(glob_get_shs_block_lat_multiplier)();
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = block_s * SIMD_SPLIT;
 #else
+    (void)block_s;
 #   define BLOCK_S SIMD_BLOCK_S
 #endif
 
@@ -914,7 +926,7 @@ void CHARM(shs_point_kernel_grad2)
 #endif
 
 
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 BARRIER_1:
     if (lc->error)
         goto FAILURE_1;
@@ -963,12 +975,13 @@ BARRIER_1:
     _Bool npm_even; /* True if "n + m" is even */
     _Bool symm = 0;
     for (l = 0; l < BLOCK_S; l++)
-        symm = symm || CHARM(shs_check_symm_simd)(symm_simd[l]);
+        symm = symm || SIMD_ISA_NAME(shs_check_symm_simd)(symm_simd[l]);
 
 
     /* Get the index of "Cmm" and "Smm" in "shcs_block->c" and "shcs_block->s"
-     * */
+     * and the distance between two successive degrees of the same order */
     unsigned long idx = CHARM(shc_block_get_idx)(shcs_block, m);
+    const unsigned long stride = shcs_block->stride;
 
 
     REAL_SIMD *rpows_m;
@@ -1017,7 +1030,7 @@ BARRIER_1:
         /* ----------------------------------------------------- */
         /* P00 */
         cnm = SET1_R(shcs_block->c[idx]);
-        idx++;
+        idx += stride;
         AMPL(0);
 
 
@@ -1094,7 +1107,7 @@ BARRIER_1:
         if (nmax >= 1)
         {
             cnm = SET1_R(shcs_block->c[idx]);
-            idx++;
+            idx += stride;
             AMPL(1);
 
 
@@ -1168,7 +1181,7 @@ BARRIER_1:
                 nn1s = SET1_R((REAL)(n * (n + 1)));
 #endif
                 cnm  = SET1_R(shcs_block->c[idx]);
-                idx++;
+                idx += stride;
                 AMPL(n);
 
 
@@ -1253,7 +1266,7 @@ BARRIER_1:
         /* ----------------------------------------------------- */
         cnm = SET1_R(shcs_block->c[idx]);
         snm = SET1_R(shcs_block->s[idx]);
-        idx++;
+        idx += stride;
 #if DLAT > 0
         enms = SET1_R(enm[m]);
         ns   = SET1_R((REAL)m);
@@ -1267,19 +1280,13 @@ BARRIER_1:
         for (l = 0; l < BLOCK_S; l++)
         {
 #ifdef SIMD
-            PNM_SECTORIAL_XNUM_SIMD(x[l], ix[l],
-                                    ps[(SIMD_SIZE * nmax) * l + (m - 1) *
-                                       SIMD_SIZE],
-                                    ips[(SIMD_SIZE * nmax) * l + (m - 1) *
-                                        SIMD_SIZE],
+            PNM_SECTORIAL_XNUM_SIMD(x[l], ix[l], ps[PS_IDX(l, m, nmax)],
+                                    ips[PS_IDX(l, m, nmax)],
                                     pnm0[l], BIG_r, zero_r, zero_ri, mone_ri,
                                     mask1, mask2, SECTORIALS);
 #else
-            PNM_SECTORIAL_XNUM(x[l], ix[l],
-                               ps[(SIMD_SIZE * nmax) * l + (m - 1) *
-                                  SIMD_SIZE],
-                               ips[(SIMD_SIZE * nmax) * l + (m - 1) *
-                                   SIMD_SIZE], pnm0[l]);
+            PNM_SECTORIAL_XNUM(x[l], ix[l], ps[PS_IDX(l, m, nmax)],
+                               ips[PS_IDX(l, m, nmax)], pnm0[l]);
 #endif
         }
 #if DLAT > 0
@@ -1372,7 +1379,7 @@ BARRIER_1:
 #endif
             cnm  = SET1_R(shcs_block->c[idx]);
             snm  = SET1_R(shcs_block->s[idx]);
-            idx++;
+            idx += stride;
             AMPL(m + 1);
 
 
@@ -1476,7 +1483,7 @@ BARRIER_1:
 #endif
                 cnm  = SET1_R(shcs_block->c[idx]);
                 snm  = SET1_R(shcs_block->s[idx]);
-                idx++;
+                idx += stride;
                 AMPL(n);
 
 
@@ -1810,7 +1817,7 @@ DR_DERIVATIVE:
                                BARRIER_2);
 
 
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 BARRIER_2:
     if (lc->error)
         goto FAILURE_2;
@@ -1934,7 +1941,7 @@ BARRIER_2:
     /* ..................................................................... */
 
 
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 FAILURE_2:
 #endif
     MISC_SD_FREE(a_);
@@ -1952,7 +1959,7 @@ FAILURE_2:
 
 
     /* --------------------------------------------------------------------- */
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
 FAILURE_1:
 #endif
     MISC_SD_FREE(x);
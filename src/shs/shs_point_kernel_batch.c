@@ -0,0 +1,388 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../prec.h"
+#include "../shc/shc_block_struct.h"
+#include "../shc/shc_block_get_idx.h"
+#include "../simd/simd.h"
+#include "../leg/leg_func_xnum.h"
+#include "../leg/leg_func_use_xnum.h"
+#include "../misc/misc_sd_calloc.h"
+#include "shs_check_symm_simd.h"
+#include "shs_lc_struct.h"
+#include "shs_point_kernel_batch.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Macros */
+/* ------------------------------------------------------------------------- */
+/* Stores the Legendre function "pnm" of degree "n" to "leg" */
+#undef LEG_STORE
+#define LEG_STORE(n, pnm)                                                     \
+    for (l = 0; l < BLOCK_S; l++)                                             \
+        leg[((n) - m) * BLOCK_S + l] = (pnm)[l];
+
+
+/* Lumped coefficients "lcx" (latitude "\varphi") and "lcx2" (latitude
+ * "-\varphi") from the Legendre functions in "leg" and the coefficients
+ * "cs".  The products are evaluated in the same order as in
+ * "shs_point_kernel", so that the results are the same. */
+#undef LC_SUM
+#define LC_SUM(lcx, lcx2, cs)                                                 \
+    for (l = 0; l < BLOCK_S; l++)                                             \
+        (lcx)[l] = SET_ZERO_R;                                                \
+    if (symm)                                                                 \
+        for (l = 0; l < BLOCK_S; l++)                                         \
+            (lcx2)[l] = SET_ZERO_R;                                           \
+                                                                              \
+                                                                              \
+    for (n = m; n <= nmax; n++)                                               \
+    {                                                                         \
+        csn   = SET1_R((cs)[n - m]);                                          \
+        leg_n = leg + (n - m) * BLOCK_S;                                      \
+        for (l = 0; l < BLOCK_S; l++)                                         \
+            leg_cs[l] = MUL_R(leg_n[l], csn);                                 \
+                                                                              \
+                                                                              \
+        if (is_ratio_one)                                                     \
+        {                                                                     \
+            for (l = 0; l < BLOCK_S; l++)                                     \
+                (lcx)[l] = ADD_R((lcx)[l], leg_cs[l]);                        \
+        }                                                                     \
+        else                                                                  \
+        {                                                                     \
+            rpows_m = rpows + (n + 1) * BLOCK_S;                              \
+            for (l = 0; l < BLOCK_S; l++)                                     \
+                (lcx)[l] = FMA_R(rpows_m[l], leg_cs[l], (lcx)[l]);            \
+        }                                                                     \
+                                                                              \
+                                                                              \
+        if (symm)                                                             \
+        {                                                                     \
+            rpows2_m = rpows2 + (n + 1) * BLOCK_S;                            \
+            if ((n + m) % 2)                                                  \
+            {                                                                 \
+                for (l = 0; l < BLOCK_S; l++)                                 \
+                    (lcx2)[l] = FNMA_R(rpows2_m[l], leg_cs[l], (lcx2)[l]);    \
+            }                                                                 \
+            else                                                              \
+            {                                                                 \
+                for (l = 0; l < BLOCK_S; l++)                                 \
+                    (lcx2)[l] = FMA_R(rpows2_m[l], leg_cs[l], (lcx2)[l]);     \
+            }                                                                 \
+        }                                                                     \
+    }
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Internal function to compute the lumped coefficients of the harmonic order
+ * "m" for "nmodels" sets of spherical harmonic coefficients at once.  Unlike
+ * "shs_point_kernel_dr0_dlat0_dlon0", the Legendre functions of all degrees
+ * are first computed and stored in "leg" ("(nmax + 1) * BLOCK_S" elements).
+ * Then, they are contracted with the coefficients of each model, so that the
+ * recurrences are evaluated only once regardless of "nmodels".  Only the
+ * potential (no derivatives) is supported.  The lumped coefficients of the
+ * "k"th model are stored in "lc[k]". */
+void SIMD_ISA_NAME(shs_point_kernel_batch)(unsigned long nmax,
+                                           unsigned long m,
+                                           CHARM(shc_block) **shcs_block,
+                                           size_t nmodels,
+                                           _Bool is_ratio_one,
+                                           const REAL *anm,
+                                           const REAL *bnm,
+                                           const REAL_SIMD *t,
+                                           const REAL *ps,
+                                           const INT *ips,
+                                           REAL_SIMD *rpows,
+                                           REAL_SIMD *rpows2,
+                                           const REAL_SIMD *symm_simd,
+                                           size_t block_s,
+                                           REAL_SIMD *leg,
+                                           CHARM(lc) **lc)
+{
+    /* --------------------------------------------------------------------- */
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = block_s * SIMD_SPLIT;
+#else
+    (void)block_s;
+#   define BLOCK_S SIMD_BLOCK_S
+#endif
+
+
+    MISC_SD_CALLOC_REAL_SIMD_INIT(x);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(y);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(z);
+    MISC_SD_CALLOC_RI_SIMD_INIT(ix);
+    MISC_SD_CALLOC_RI_SIMD_INIT(iy);
+    MISC_SD_CALLOC_RI_SIMD_INIT(iz);
+    MISC_SD_CALLOC_RI_SIMD_INIT(ixy);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(pnm0);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(pnm1);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(pnm2);
+    MISC_SD_CALLOC_REAL_SIMD_INIT(leg_cs);
+    MISC_SD_CALLOC__BOOL_INIT(ds);
+
+
+    MISC_SD_CALLOC_REAL_SIMD_E(x, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                               BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(y, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                               BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(z, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                               BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(ix, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                             BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(iy, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                             BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(iz, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                             BARRIER_1);
+    MISC_SD_CALLOC_RI_SIMD_E(ixy, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                             BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(pnm0, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                               BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(pnm1, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                               BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(pnm2, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                               BARRIER_1);
+    MISC_SD_CALLOC_REAL_SIMD_E(leg_cs, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                               BARRIER_1);
+    MISC_SD_CALLOC__BOOL_E(ds, BLOCK_S, SIMD_BLOCK_S, lc[0]->error,
+                           BARRIER_1);
+
+
+#if HAVE_RUNTIME_BLOCK
+BARRIER_1:
+    if (lc[0]->error)
+        goto FAILURE_1;
+#endif
+    /* --------------------------------------------------------------------- */
+
+
+    REAL_SIMD w;
+#ifdef SIMD
+    const RI_SIMD    zero_ri = SET_ZERO_RI;
+    const RI_SIMD    one_ri  = SET1_RI(1);
+    const RI_SIMD    mone_ri = SET1_RI(-1);
+    const REAL_SIMD  zero_r  = SET_ZERO_R;
+    const REAL_SIMD  BIG_r   = SET1_R(BIG);
+    const REAL_SIMD  BIGI_r  = SET1_R(BIGI);
+    const REAL_SIMD  BIGS_r  = SET1_R(BIGS);
+    const REAL_SIMD  BIGSI_r = SET1_R(BIGSI);
+    REAL_SIMD  tmp1_r,  tmp2_r;
+    MASK_SIMD  mask1, mask2;
+    MASK2_SIMD mask3;
+#endif
+    const REAL_SIMD one     = SET1_R(PREC(1.0));
+    const REAL_SIMD ROOT3_r = SET1_R(ROOT3);
+
+
+    size_t l;
+    _Bool symm = 0;
+    for (l = 0; l < BLOCK_S; l++)
+        symm = symm || SIMD_ISA_NAME(shs_check_symm_simd)(symm_simd[l]);
+
+
+    REAL_SIMD *rpows_m;
+    REAL_SIMD *rpows2_m;
+    REAL_SIMD anms, bnms;
+    unsigned long n;
+
+
+
+
+
+
+    /* Legendre functions of degrees "m", "m + 1", ..., "nmax" */
+    /* --------------------------------------------------------------------- */
+    if (m == 0)
+    {
+        /* P00 */
+        for (l = 0; l < BLOCK_S; l++)
+            pnm0[l] = one;
+        LEG_STORE(0, pnm0);
+
+
+        /* P10 */
+        if (nmax >= 1)
+        {
+            for (l = 0; l < BLOCK_S; l++)
+                pnm1[l] = MUL_R(ROOT3_r, t[l]);
+            LEG_STORE(1, pnm1);
+        }
+
+
+        /* P20, P30, ..., Pnmax,0 */
+        for (n = 2; n <= nmax; n++)
+        {
+            anms = SET1_R(anm[n]);
+            bnms = SET1_R(bnm[n]);
+
+
+            for (l = 0; l < BLOCK_S; l++)
+                PNM_RECURRENCE(pnm1[l], pnm0[l], pnm2[l], t[l], anms, bnms);
+            LEG_STORE(n, pnm2);
+
+
+            for (l = 0; l < BLOCK_S; l++)
+                RECURRENCE_NEXT_ITER(pnm0[l], pnm1[l], pnm2[l]);
+        }
+    }
+    else
+    {
+        /* Sectorial Legendre functions */
+        for (l = 0; l < BLOCK_S; l++)
+        {
+#ifdef SIMD
+            PNM_SECTORIAL_XNUM_SIMD(x[l], ix[l], ps[PS_IDX(l, m, nmax)],
+                                    ips[PS_IDX(l, m, nmax)],
+                                    pnm0[l], BIG_r, zero_r, zero_ri, mone_ri,
+                                    mask1, mask2, SECTORIALS);
+#else
+            PNM_SECTORIAL_XNUM(x[l], ix[l], ps[PS_IDX(l, m, nmax)],
+                               ips[PS_IDX(l, m, nmax)], pnm0[l]);
+#endif
+        }
+        LEG_STORE(m, pnm0);
+
+
+        if (m < nmax)
+        {
+            /* Semi-sectorial Legendre functions */
+            anms = SET1_R(anm[m + 1]);
+            for (l = 0; l < BLOCK_S; l++)
+            {
+#ifdef SIMD
+                PNM_SEMISECTORIAL_XNUM_SIMD(x[l], y[l], ix[l], iy[l], w, t[l],
+                                            anms,
+                                            pnm1[l], mask1, mask2, mask3,
+                                            zero_r, zero_ri, mone_ri, BIG_r,
+                                            BIGS_r,  BIGI_r, SEMISECTORIALS);
+#else
+                PNM_SEMISECTORIAL_XNUM(x[l], y[l], ix[l], iy[l], w, t[l],
+                                       anms, pnm1[l]);
+#endif
+            }
+            LEG_STORE(m + 1, pnm1);
+
+
+            /* Tesseral Legendre functions with the "X"-numbers */
+            for (l = 0; l < BLOCK_S; l++)
+                ds[l] = 0;
+
+
+            for (n = m + 2;
+                 CHARM(leg_func_use_xnum(ds, BLOCK_S)) && n <= nmax; n++)
+            {
+                anms = SET1_R(anm[n]);
+                bnms = SET1_R(bnm[n]);
+
+
+                for (l = 0; l < BLOCK_S; l++)
+                {
+#ifdef SIMD
+                    PNM_TESSERAL_XNUM_SIMD(x[l], y[l], z[l],
+                                           ix[l], iy[l], iz[l], ixy[l],
+                                           w, t[l], anms, bnms, pnm2[l],
+                                           tmp1_r, tmp2_r, mask1, mask2,
+                                           mask3, zero_r, zero_ri, one_ri,
+                                           BIG_r, BIGI_r, BIGS_r, BIGSI_r,
+                                           TESSERALS1, TESSERALS2, ds[l]);
+#else
+                    PNM_TESSERAL_XNUM(x[l], y[l], z[l], ix[l], iy[l], iz[l],
+                                      ixy[l], w, t[l], anms, bnms, pnm2[l],
+                                      ds[l]);
+#endif
+                }
+                LEG_STORE(n, pnm2);
+            }
+
+
+            /* Tesseral Legendre functions with the "F"-numbers */
+            for (; n <= nmax; n++)
+            {
+                anms = SET1_R(anm[n]);
+                bnms = SET1_R(bnm[n]);
+
+
+                for (l = 0; l < BLOCK_S; l++)
+                {
+                    PNM_RECURRENCE(x[l], y[l], pnm2[l], t[l], anms, bnms);
+                    RECURRENCE_NEXT_ITER(y[l], x[l], pnm2[l]);
+                }
+                LEG_STORE(n, pnm2);
+            }
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Lumped coefficients of all models */
+    /* --------------------------------------------------------------------- */
+    REAL_SIMD csn;
+    REAL_SIMD *leg_n;
+
+
+    for (size_t k = 0; k < nmodels; k++)
+    {
+        unsigned long idx = CHARM(shc_block_get_idx)(shcs_block[k], m);
+        const REAL *c = shcs_block[k]->c + idx;
+        const REAL *s = shcs_block[k]->s + idx;
+
+
+        LC_SUM(lc[k]->a, lc[k]->a2, c);
+        if (m == 0)
+        {
+            for (l = 0; l < BLOCK_S; l++)
+                lc[k]->b[l] = lc[k]->b2[l] = SET_ZERO_R;
+        }
+        else
+        {
+            LC_SUM(lc[k]->b, lc[k]->b2, s);
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+#if HAVE_RUNTIME_BLOCK
+FAILURE_1:
+#endif
+    MISC_SD_FREE(x);
+    MISC_SD_FREE(y);
+    MISC_SD_FREE(z);
+    MISC_SD_FREE(ix);
+    MISC_SD_FREE(iy);
+    MISC_SD_FREE(iz);
+    MISC_SD_FREE(ixy);
+    MISC_SD_FREE(pnm0);
+    MISC_SD_FREE(pnm1);
+    MISC_SD_FREE(pnm2);
+    MISC_SD_FREE(leg_cs);
+    MISC_SD_FREE(ds);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    return;
+}
@@ -0,0 +1,44 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SHS_POINT_KERNEL_BATCH_H__
+#define __SHS_POINT_KERNEL_BATCH_H__
+
+
+#include <config.h>
+#include "../prec.h"
+#include "../simd/simd.h"
+#include "../shc/shc_block_struct.h"
+#include "shs_lc_struct.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern void SIMD_ISA_NAME(shs_point_kernel_batch)(unsigned long,
+                                                  unsigned long,
+                                                  CHARM(shc_block) **,
+                                                  size_t,
+                                                  _Bool,
+                                                  const REAL *,
+                                                  const REAL *,
+                                                  const REAL_SIMD *,
+                                                  const REAL *,
+                                                  const INT *,
+                                                  REAL_SIMD *,
+                                                  REAL_SIMD *,
+                                                  const REAL_SIMD *,
+                                                  size_t,
+                                                  REAL_SIMD *,
+                                                  CHARM(lc) **);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -34,21 +34,22 @@ extern "C"
                  REAL_SIMD *rpows2,                                           \
                  const REAL_SIMD *symm_simd,                                  \
                  unsigned dorder,                                             \
+                 size_t block_s,                                              \
                  CHARM(lc) *lc)
 
 
-extern void CHARM(shs_point_kernel_dr0_dlat0_dlon0) IO_PARS;
-extern void CHARM(shs_point_kernel_dr1_dlat0_dlon0) IO_PARS;
-extern void CHARM(shs_point_kernel_dr2_dlat0_dlon0) IO_PARS;
-extern void CHARM(shs_point_kernel_dr0_dlat1_dlon0) IO_PARS;
-extern void CHARM(shs_point_kernel_dr0_dlat2_dlon0) IO_PARS;
-extern void CHARM(shs_point_kernel_dr0_dlat0_dlon1) IO_PARS;
-extern void CHARM(shs_point_kernel_dr0_dlat0_dlon2) IO_PARS;
-extern void CHARM(shs_point_kernel_dr1_dlat1_dlon0) IO_PARS;
-extern void CHARM(shs_point_kernel_dr1_dlat0_dlon1) IO_PARS;
-extern void CHARM(shs_point_kernel_dr0_dlat1_dlon1) IO_PARS;
-extern void CHARM(shs_point_kernel_grad1) IO_PARS;
-extern void CHARM(shs_point_kernel_grad2) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat0_dlon0) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr1_dlat0_dlon0) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr2_dlat0_dlon0) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat1_dlon0) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat2_dlon0) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat0_dlon1) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat0_dlon2) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr1_dlat1_dlon0) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr1_dlat0_dlon1) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_dr0_dlat1_dlon1) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_grad1) IO_PARS;
+extern void SIMD_ISA_NAME(shs_point_kernel_grad2) IO_PARS;
 
 
 #ifdef __cplusplus
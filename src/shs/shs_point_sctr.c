@@ -10,6 +10,7 @@
 #include "../prec.h"
 #include "../shc/shc_block_struct.h"
 #include "../shc/shc_block_init.h"
+#include "../shc/shc_block_init_interleaved.h"
 #include "../shc/shc_block_free.h"
 #include "../shc/shc_block_have_order.h"
 #include "../shc/shc_block_get_coeffs.h"
@@ -31,7 +32,7 @@
 #include "../simd/calloc_aligned.h"
 #include "../simd/free_aligned.h"
 #include "../glob/glob_get_shs_block_lat_multiplier.h"
-#include "shs_point_kernels.h"
+#include "shs_kernels.h"
 #include "shs_sctr_mulc.h"
 #include "shs_r_eq_rref.h"
 #include "shs_lc_struct.h"
@@ -54,9 +55,9 @@
 /* ------------------------------------------------------------------------- */
 #undef LC_CS
 #define LC_CS(x)                                                              \
-        fi_thread[idx] = ADD_R(fi_thread[idx],                                \
-                               ADD_R(MUL_R(lc->CAT(a, x)[l], clonim),         \
-                                     MUL_R(lc->CAT(b, x)[l], slonim)));
+        fi_thread[idx] = FMA_R(lc->CAT(a, x)[l], clonim,                      \
+                               FMA_R(lc->CAT(b, x)[l], slonim,                \
+                                     fi_thread[idx]));
 
 
 #undef CHECK_NULL
@@ -128,7 +129,7 @@ void CHARM(shs_point_sctr)(const CHARM(point) *pnt,
     _Bool r_eq_rref = CHARM(shs_r_eq_rref)(pnt, shcs);
 
 
-#if HAVE_MPI
+#if HAVE_RUNTIME_BLOCK
     size_t BLOCK_S = CHARM(glob_get_shs_block_lat_multiplier)();
 #else
 #   define BLOCK_S SIMD_BLOCK_S
@@ -219,7 +220,18 @@ void CHARM(shs_point_sctr)(const CHARM(point) *pnt,
 
 
     /* ................................................................. */
-    shcs_block = CHARM(shc_block_init)(shcs);
+    /* At low degrees, the coefficients are copied to an interleaved block,
+     * in which they are already multiplied by "mur", so that the kernel reads
+     * a single aligned stream per order.  "mur" is then applied only once
+     * here. */
+    if (!shcs->distributed && (shcs->lazy == NULL) &&
+        (nmax < CHARM(glob_shs_point_interleave_nmax)))
+    {
+        shcs_block = CHARM(shc_block_init_interleaved)(shcs, nmax, mur);
+        mur        = PREC(1.0);
+    }
+    else
+        shcs_block = CHARM(shc_block_init)(shcs);
     CHECK_NULL(shcs_block, BARRIER_1);
 
 
@@ -336,12 +348,12 @@ BARRIER_1:
         /* ------------------------------------------------------------- */
 
 
-#undef MPI_VARS
-#if HAVE_MPI
         _Bool have_order;
+#undef MPI_VARS
+#if HAVE_MPI || HAVE_RUNTIME_BLOCK
 #   define MPI_VARS shared(have_order, BLOCK_S)
 #else
-#   define MPI_VARS
+#   define MPI_VARS shared(have_order)
 #endif
 
 
@@ -350,7 +362,7 @@ BARRIER_1:
 shared(nmax, err, pt, t, u, rpows, ri, r, ips, ps, dorder, dr, dlat, dlon) \
 shared(grad, r_eq_rref, shcs, shcs_block, lonv, fi, npar) \
 shared(err_glob, lc_err_glob) \
-private(l, idx) MPI_VARS
+private(l, idx) MPI_VARS SHS_KERNEL_VARS
 #endif
         {
         /* ------------------------------------------------------------- */
@@ -376,20 +388,15 @@ private(l, idx) MPI_VARS
 
 
         /* Fill "shcs_block" with coefficients starting at degree "0".  If
-         * compiling without the MPI support, "shc_block_get_coeffs" needs to
-         * be called only once, so no further calls in relation to the
+         * compiling without the MPI support and if "shcs" is neither returned
+         * by "shc_open_binz" nor a sliced view, "shc_block_get_coeffs" needs
+         * to be called only once, so no further calls in relation to the
          * order-dependent loop are necessary.  "CHARM(shc_block_get_coeffs)"
          * is a collective call if compiled with MPI support, so should be
          * executed before the "anm", etc allocations.  Otherwise, a new
          * barrier would be needed. */
         /* ------------------------------------------------------------- */
-        CHARM(shc_block_get_coeffs)(shcs
-#if HAVE_MPI
-                                    , shcs_block,
-                                    0,
-                                    err
-#endif
-                                   );
+        CHARM(shc_block_get_coeffs)(shcs, shcs_block, 0, err);
         if (!CHARM(err_isempty)(err))
         {
 #if HAVE_OPENMP
@@ -407,7 +414,7 @@ private(l, idx) MPI_VARS
 
 
         /* ------------------------------------------------------------- */
-        lc = CHARM(shs_lc_init)();
+        lc = CHARM(shs_lc_init)(BLOCK_S);
         CHECK_NULL_OMP(lc, err_priv, BARRIER_2);
 
 
@@ -459,7 +466,6 @@ private(l, idx) MPI_VARS
 
         do
         {
-#if HAVE_MPI
 #if HAVE_OPENMP
 #pragma omp master
 #endif
@@ -469,16 +475,29 @@ private(l, idx) MPI_VARS
 #if HAVE_OPENMP
 #pragma omp barrier
 #endif
-            if (shcs->distributed && !have_order)
+            /* Distributed structures, structures returned by
+             * "shc_open_binz" and sliced views store only some of the orders
+             * in "shcs_block", so the next block of orders is gathered,
+             * decompressed or copied here.  Other structures have all orders
+             * in "shcs_block", so "have_order" is always "1". */
+            if (!have_order)
             {
                 CHARM(shc_block_get_coeffs)(shcs, shcs_block, m, err);
                 if (!CHARM(err_isempty)(err))
                 {
+                    /* "err" is shared, so only one thread may propagate */
+#if HAVE_OPENMP
+#pragma omp master
+#endif
                     CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+#if HAVE_OPENMP
+#pragma omp barrier
+#endif
                     goto BARRIER_2;
                 }
             }
-#endif
 
 
             /* ............................................................. */
@@ -536,56 +555,66 @@ BARRIER_2:
 #undef KERNEL_IO_PARS
 #define KERNEL_IO_PARS (nmax, m, shcs_block, r_eq_rref, anm, bnm, enm,        \
                         &t[0], &u[0], ps, ips, &rpows[0], &zeros[0],          \
-                        &zeros[0], dorder, lc)
+                        &zeros[0], dorder, BLOCK_S, lc)
                 if ((dr == 0) && (dlat == 0) && (dlon == 0))
                 {
-                    CHARM(shs_point_kernel_dr0_dlat0_dlon0) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat0_dlon0)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == 1) && (dlat == 0) && (dlon == 0))
                 {
-                    CHARM(shs_point_kernel_dr1_dlat0_dlon0) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr1_dlat0_dlon0)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == 2) && (dlat == 0) && (dlon == 0))
                 {
-                    CHARM(shs_point_kernel_dr2_dlat0_dlon0) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr2_dlat0_dlon0)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == 0) && (dlat == 1) && (dlon == 0))
                 {
-                    CHARM(shs_point_kernel_dr0_dlat1_dlon0) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat1_dlon0)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == 0) && (dlat == 2) && (dlon == 0))
                 {
-                    CHARM(shs_point_kernel_dr0_dlat2_dlon0) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat2_dlon0)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == 0) && (dlat == 0) && (dlon == 1))
                 {
-                    CHARM(shs_point_kernel_dr0_dlat0_dlon1) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat0_dlon1)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == 0) && (dlat == 0) && (dlon == 2))
                 {
-                    CHARM(shs_point_kernel_dr0_dlat0_dlon2) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat0_dlon2)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == 1) && (dlat == 1) && (dlon == 0))
                 {
-                    CHARM(shs_point_kernel_dr1_dlat1_dlon0) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr1_dlat1_dlon0)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == 1) && (dlat == 0) && (dlon == 1))
                 {
-                    CHARM(shs_point_kernel_dr1_dlat0_dlon1) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr1_dlat0_dlon1)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == 0) && (dlat == 1) && (dlon == 1))
                 {
-                    CHARM(shs_point_kernel_dr0_dlat1_dlon1) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_dr0_dlat1_dlon1)
+                        KERNEL_IO_PARS;
                 }
                 else if ((dr == GRAD_1) && (dlat == GRAD_1) &&
                          (dlon == GRAD_1))
                 {
-                    CHARM(shs_point_kernel_grad1) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_grad1) KERNEL_IO_PARS;
                 }
                 else if ((dr == GRAD_2) && (dlat == GRAD_2) &&
                          (dlon == GRAD_2))
                 {
-                    CHARM(shs_point_kernel_grad2) KERNEL_IO_PARS;
+                    SHS_KERNEL(shs_point_kernel_grad2) KERNEL_IO_PARS;
                 }
 
 
@@ -682,7 +711,7 @@ FAILURE_2:
 
         /* Final part of the synthesis */
         for (size_t p = 0; p < npar; p++)
-            CHARM(shs_sctr_mulc)(i, npnt, pnt->type, mur, tmp, tmpv,
+            CHARM(shs_sctr_mulc)(i, npnt, BLOCK_S, pnt->type, mur, tmp, tmpv,
                                  &fi[p * BLOCK_S], f[p]);
 
 
@@ -0,0 +1,423 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fftw3.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../prec.h"
+#include "../crd/crd_point_isGrid.h"
+#include "../crd/crd_point_isCustGrid.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+#include "../shc/shc_check_lazy.h"
+#include "../shc/shc_check_view.h"
+#include "../err/err_omp_mpi.h"
+#include "../misc/misc_arr_chck_lin_incr.h"
+#include "../misc/misc_fftw_plans.h"
+#include "../leg/leg_table_struct.h"
+#include "shs_grd_point_fft_check.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Macros */
+/* ------------------------------------------------------------------------- */
+/* Adds the contribution of the Legendre functions "p" of degree "n" and order
+ * "m" to the lumped coefficients "am" and "bm" of all latitudes */
+#undef LC_SUM
+#define LC_SUM(p)                                                             \
+    for (size_t i = 0; i < nlat; i++)                                         \
+    {                                                                         \
+        REAL prp = (REAL)(p)[i] * rp[i];                                      \
+        am[i] += prp * cnm;                                                   \
+        bm[i] += prp * snm;                                                   \
+        rp[i] *= q[i];                                                        \
+    }
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+void CHARM(shs_point_table)(const CHARM(leg_table) *table,
+                            const CHARM(shc) *shcs,
+                            unsigned long nmax,
+                            unsigned dlat,
+                            REAL *f,
+                            CHARM(err) *err)
+{
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
+    if (shcs->distributed)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Distributed \"shcs\" are not supported.");
+        return;
+    }
+
+
+    if (CHARM(shc_check_lazy)(shcs, err) ||
+        CHARM(shc_check_view)(shcs, err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
+    if (nmax > shcs->nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Maximum harmonic degree of the synthesis (\"nmax\") "
+                       "cannot be larger than maximum harmonic degree of "
+                       "spherical harmonic coefficients (\"shcs->nmax\").");
+        return;
+    }
+
+
+    if (nmax > table->nmax)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Maximum harmonic degree of the synthesis (\"nmax\") "
+                       "cannot be larger than maximum harmonic degree of "
+                       "the table.");
+        return;
+    }
+
+
+    if (dlat > table->dlat)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "The table does not contain the latitudinal "
+                       "derivatives of order \"dlat\".");
+        return;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    const CHARM(point) *pnt = table->pnt;
+    const size_t nlat       = table->nlat;
+    const size_t tnmax      = table->nmax;
+    const _Bool single      = table->single;
+    const _Bool grd         = CHARM(crd_point_isGrid)(pnt->type);
+    const size_t nlon       = (grd) ? pnt->nlon : 1;
+
+
+    if (pnt->npoint == 0)
+        return;
+
+
+    REAL *a  = NULL;
+    REAL *b  = NULL;
+    REAL *q  = NULL;
+    REAL *cosml = NULL;
+    REAL *sinml = NULL;
+    REAL *ftmp = NULL;
+    FFTWC(complex) *fc = NULL;
+    FFTW(plan) plan = NULL;
+    int err_glob = 0;
+
+
+    /* Lumped coefficients of the order "m" and the "i"th latitude are stored
+     * in "a[m * nlat + i]" and "b[m * nlat + i]" */
+    a = (REAL *)calloc((nmax + 1) * nlat, sizeof(REAL));
+    b = (REAL *)calloc((nmax + 1) * nlat, sizeof(REAL));
+    q = (REAL *)malloc(nlat * sizeof(REAL));
+    if ((a == NULL) || (b == NULL) || (q == NULL))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto EXIT;
+    }
+
+
+    for (size_t i = 0; i < nlat; i++)
+        q[i] = shcs->r / pnt->r[i];
+
+
+    /* "mu / R^(dlat + 1)", see "shs_get_mur_dorder_npar" */
+    REAL mur = shcs->r;
+    for (unsigned d = 1; d <= dlat; d++)
+        mur *= shcs->r;
+    mur = shcs->mu / mur;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Lumped coefficients.  Instead of the recurrence relations, the Legendre
+     * functions are taken from the table. */
+    /* --------------------------------------------------------------------- */
+#if HAVE_OPENMP
+#pragma omp parallel default(none) \
+shared(table, shcs, nmax, dlat, nlat, tnmax, single, a, b, q, mur) \
+shared(err_glob, err)
+#endif
+    {
+    int err_priv = 0;
+
+
+    /* Powers of "shcs->r / pnt->r[i]" */
+    REAL *rp = (REAL *)malloc(nlat * sizeof(REAL));
+    if (rp == NULL)
+        err_priv = 1;
+
+
+    if (CHARM(err_omp_mpi)(&err_glob, &err_priv, CHARM_ERR_MALLOC_FAILURE,
+                           CHARM_EMEM, err))
+        goto FAILURE_PARALLEL;
+
+
+#if HAVE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        REAL *am = a + m * nlat;
+        REAL *bm = b + m * nlat;
+
+
+        for (size_t i = 0; i < nlat; i++)
+            rp[i] = POW(q[i], (REAL)(m + 1 + dlat));
+
+
+        for (unsigned long n = m; n <= nmax; n++)
+        {
+            REAL cnm = shcs->c[m][n - m];
+            REAL snm = (m > 0) ? shcs->s[m][n - m] : PREC(0.0);
+
+
+            size_t idx = LEG_TABLE_IDX(tnmax, n, m) * nlat;
+            if (single)
+            {
+                const float *p = table->pnmf[dlat] + idx;
+                LC_SUM(p);
+            }
+            else
+            {
+                const REAL *p = table->pnm[dlat] + idx;
+                LC_SUM(p);
+            }
+        }
+
+
+        for (size_t i = 0; i < nlat; i++)
+        {
+            am[i] *= mur;
+            bm[i] *= mur;
+        }
+    }
+
+
+FAILURE_PARALLEL:
+    free(rp);
+    }
+
+
+    if (!CHARM(err_isempty)(err))
+        goto EXIT;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Synthesis along the latitude parallels */
+    /* --------------------------------------------------------------------- */
+    if (!grd)
+    {
+        /* Scattered points */
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) shared(pnt, nmax, nlat, a, b, f)
+#endif
+        for (size_t i = 0; i < nlat; i++)
+        {
+            REAL fi = PREC(0.0);
+            for (unsigned long m = 0; m <= nmax; m++)
+            {
+                REAL mlon = (REAL)m * pnt->lon[i];
+                fi += a[m * nlat + i] * COS(mlon) +
+                      b[m * nlat + i] * SIN(mlon);
+            }
+            f[i] = fi;
+        }
+
+
+        goto EXIT;
+    }
+
+
+    /* For grids, FFT is used whenever possible (see "shs_plan_create") */
+    if (CHARM(crd_point_isCustGrid)(pnt->type) && (nlon > 1))
+    {
+        int err_tmp = CHARM(misc_arr_chck_lin_incr)(pnt->lon, nlon, 0, 1,
+                                                    CHARM(glob_threshold2),
+                                                    err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT;
+        }
+
+
+        if (err_tmp != 0)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__,  __func__,
+                           CHARM_EFUNCARG,
+                           "\"pnt->lon\" is not a linearly increasing "
+                           "array within the \"threshold2\".");
+            goto EXIT;
+        }
+    }
+
+
+    REAL deltalon = (nlon > 1) ? pnt->lon[1] - pnt->lon[0] : PREC(0.0);
+    _Bool use_fft = CHARM(shs_grd_point_fft_check)(pnt, deltalon, nmax);
+
+
+    if (use_fft)
+    {
+        const size_t nfc = nlon / 2 + 1;
+        ftmp = (REAL *)FFTW(malloc)(nlon * sizeof(REAL));
+        fc   = (FFTWC(complex) *)FFTW(malloc)(nfc * sizeof(FFTWC(complex)));
+        if ((ftmp == NULL) || (fc == NULL))
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto EXIT;
+        }
+
+
+#if HAVE_OPENMP && FFTW3_OMP
+        if (FFTW(init_threads)() == 0)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFFTWINIT,
+                           CHARM_ERR_FFTW_INIT_FAILURE);
+            goto EXIT;
+        }
+        FFTW(plan_with_nthreads)(omp_get_max_threads());
+#endif
+        plan = FFTW(plan_dft_c2r_1d)(nlon, fc, ftmp, FFTW_ESTIMATE);
+        if (plan == NULL)
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto EXIT;
+        }
+
+
+        for (size_t i = 0; i < nlat; i++)
+        {
+            fc[0][0] = a[i];
+            fc[0][1] = PREC(0.0);
+            for (size_t m = 1; m < nfc; m++)
+            {
+                if (m <= nmax)
+                {
+                    fc[m][0] =  PREC(0.5) * a[m * nlat + i];
+                    fc[m][1] = -PREC(0.5) * b[m * nlat + i];
+                }
+                else
+                    fc[m][0] = fc[m][1] = PREC(0.0);
+            }
+
+
+            FFTW(execute_dft_c2r)(plan, fc, ftmp);
+            memcpy(f + i * nlon, ftmp, nlon * sizeof(REAL));
+        }
+    }
+    else
+    {
+        /* Direct summation for grids, at which FFT cannot be applied */
+        cosml = (REAL *)malloc((nmax + 1) * nlon * sizeof(REAL));
+        sinml = (REAL *)malloc((nmax + 1) * nlon * sizeof(REAL));
+        if ((cosml == NULL) || (sinml == NULL))
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                           CHARM_ERR_MALLOC_FAILURE);
+            goto EXIT;
+        }
+
+
+        for (unsigned long m = 0; m <= nmax; m++)
+        {
+            for (size_t j = 0; j < nlon; j++)
+            {
+                cosml[m * nlon + j] = COS((REAL)m * pnt->lon[j]);
+                sinml[m * nlon + j] = SIN((REAL)m * pnt->lon[j]);
+            }
+        }
+
+
+#if HAVE_OPENMP
+#pragma omp parallel for default(none) \
+shared(nmax, nlat, nlon, a, b, f, cosml, sinml)
+#endif
+        for (size_t i = 0; i < nlat; i++)
+        {
+            REAL *fi = f + i * nlon;
+            for (size_t j = 0; j < nlon; j++)
+                fi[j] = PREC(0.0);
+
+
+            for (unsigned long m = 0; m <= nmax; m++)
+            {
+                REAL am = a[m * nlat + i];
+                REAL bm = b[m * nlat + i];
+                for (size_t j = 0; j < nlon; j++)
+                    fi[j] += am * cosml[m * nlon + j] +
+                             bm * sinml[m * nlon + j];
+            }
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+EXIT:
+    if (plan != NULL)
+    {
+        FFTW(destroy_plan)(plan);
+        CHARM(misc_fftw_cleanup)();
+    }
+    FFTW(free)(ftmp);
+    FFTW(free)(fc);
+    free(cosml);
+    free(sinml);
+    free(a);
+    free(b);
+    free(q);
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
@@ -0,0 +1,359 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fftw3.h>
+#include "../prec.h"
+#include "../crd/crd_point_isGrid.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../err/err_check_distribution.h"
+#include "../misc/misc_arr_chck_symm.h"
+#include "shs_point_gradn.h"
+#include "shs_plan_struct.h"
+#include "shs_plan_create.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Passes the rows "k0, k0 + 1, ..., k0 + nrows - 1" of the band "fb" to
+ * "tile" by tiles of "nlat_tile" times "nlon_tile" points.  The row "k0" of
+ * the band is the row "i0" of the whole grid.  Returns the value returned by
+ * "tile" if non-zero, otherwise "0". */
+static int emit_tiles(const REAL *fb,
+                      size_t k0,
+                      size_t i0,
+                      size_t nrows,
+                      size_t nlon,
+                      size_t nlat_tile,
+                      size_t nlon_tile,
+                      REAL *ft,
+                      int (*tile)(size_t, size_t, size_t, size_t,
+                                  const REAL *, void *),
+                      void *data)
+{
+    size_t nr, nc;
+    const REAL *fr;
+    int ret;
+
+
+    for (size_t r = 0; r < nrows; r += nlat_tile)
+    {
+        nr = CHARM_MIN(nlat_tile, nrows - r);
+        fr = fb + (k0 + r) * nlon;
+
+
+        for (size_t j0 = 0; j0 < nlon; j0 += nlon_tile)
+        {
+            nc = CHARM_MIN(nlon_tile, nlon - j0);
+
+
+            /* Tiles of full rows are already contiguous in the band */
+            if (nc == nlon)
+                ret = tile(i0 + r, j0, nr, nc, fr, data);
+            else
+            {
+                for (size_t i = 0; i < nr; i++)
+                    memcpy(ft + i * nc, fr + i * nlon + j0,
+                           nc * sizeof(REAL));
+
+
+                ret = tile(i0 + r, j0, nr, nc, ft, data);
+            }
+
+
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+
+    return 0;
+}
+
+
+
+
+
+
+void CHARM(shs_point_tiles)(const CHARM(point) *pnt,
+                            const CHARM(shc) *shcs,
+                            unsigned long nmax,
+                            size_t nlat_tile,
+                            size_t nlon_tile,
+                            int (*tile)(size_t, size_t, size_t, size_t,
+                                        const REAL *, void *),
+                            void *data,
+                            CHARM(err) *err)
+{
+    /* Some trivial initial error checks */
+    /* --------------------------------------------------------------------- */
+    CHARM(err_check_distribution)(err);
+    if (!CHARM(err_isempty)(err))
+    {
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+        return;
+    }
+
+
+    if (!CHARM(crd_point_isGrid)(pnt->type))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "\"pnt->type\" must be a point grid.");
+        return;
+    }
+
+
+    if (pnt->distributed || shcs->distributed)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "Distributed \"pnt\" and \"shcs\" are not supported.");
+        return;
+    }
+
+
+    if ((nlat_tile == 0) || (nlon_tile == 0))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "\"nlat_tile\" and \"nlon_tile\" must be larger than "
+                       "zero.");
+        return;
+    }
+
+
+    if (tile == NULL)
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                       "\"tile\" cannot be \"NULL\".");
+        return;
+    }
+
+
+    if (pnt->npoint == 0)
+        return;
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* If the grid is symmetric with respect to the equator, each band of
+     * latitudes on the northern hemisphere is synthesized together with its
+     * mirrored band on the southern hemisphere, so that the Legendre
+     * functions are evaluated only once for both bands */
+    /* --------------------------------------------------------------------- */
+    const size_t nlat = pnt->nlat;
+    const size_t nlon = pnt->nlon;
+
+
+    _Bool symm = 0;
+    if (nlat > 1)
+    {
+        int err_tmp = CHARM(misc_arr_chck_symm)(pnt->lat, nlat, PREC(0.0),
+                                                CHARM(glob_threshold2), err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            return;
+        }
+
+
+        symm = (err_tmp == 0);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* The bands are synthesized by two plans, one for the bands of
+     * "nlat_full" latitudes and one for the last band if it is smaller.  The
+     * plans do not store the latitude-dependent quantities, so the latitudes
+     * and the radii of the next band are simply copied to "lat_band" and
+     * "r_band" that are shared by both "band" structures. */
+    /* --------------------------------------------------------------------- */
+    CHARM(point) *band[2]    = {NULL, NULL};
+    CHARM(shs_plan) *plan[2] = {NULL, NULL};
+    REAL *lat_band     = NULL;
+    REAL *r_band       = NULL;
+    REAL *fb           = NULL;
+    REAL *ft           = NULL;
+
+
+    /* Number of latitudes in all bands but the last one and the maximum
+     * number of latitudes in a band */
+    const size_t nlat_full = (symm) ? 2 * nlat_tile : nlat_tile;
+    const size_t nlat_band = (symm) ? nlat_full + 1 : nlat_full;
+
+
+    lat_band = (REAL *)malloc(nlat_band * sizeof(REAL));
+    r_band   = (REAL *)malloc(nlat_band * sizeof(REAL));
+    fb       = (REAL *)malloc(nlat_band * nlon * sizeof(REAL));
+    if (nlon_tile < nlon)
+        ft = (REAL *)malloc(nlat_tile * nlon_tile * sizeof(REAL));
+    if ((lat_band == NULL) || (r_band == NULL) || (fb == NULL) ||
+        ((nlon_tile < nlon) && (ft == NULL)))
+    {
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                       CHARM_ERR_MALLOC_FAILURE);
+        goto EXIT;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Loop over the bands.  Each band consists of the rows "i0, i0 + 1, ...,
+     * i0 + na - 1" of the grid and, with symmetric grids, of the mirrored rows
+     * "ib, ib + 1, ..., ib + nb - 1". */
+    /* --------------------------------------------------------------------- */
+    const size_t mid = nlat / 2;
+    size_t i0 = 0, i1, ib = 0, na, nb, k;
+    _Bool last;
+
+
+    for (;;)
+    {
+        if (symm)
+        {
+            i1 = CHARM_MIN(i0 + nlat_tile, mid);
+            if (i1 == mid)
+            {
+                /* The last band includes the equator, so it is a contiguous
+                 * block of rows */
+                na   = nlat - 2 * i0;
+                nb   = 0;
+                last = 1;
+            }
+            else
+            {
+                na   = i1 - i0;
+                ib   = nlat - i1;
+                nb   = na;
+                last = 0;
+            }
+        }
+        else
+        {
+            na   = CHARM_MIN(nlat_tile, nlat - i0);
+            nb   = 0;
+            last = (i0 + na == nlat);
+        }
+
+
+        memcpy(lat_band, pnt->lat + i0, na * sizeof(REAL));
+        memcpy(r_band, pnt->r + i0, na * sizeof(REAL));
+        memcpy(lat_band + na, pnt->lat + ib, nb * sizeof(REAL));
+        memcpy(r_band + na, pnt->r + ib, nb * sizeof(REAL));
+
+
+        k = (na + nb == nlat_full) ? 0 : 1;
+        if (band[k] == NULL)
+        {
+            band[k] = CHARM(crd_point_init)(CHARM_CRD_POINT_GRID, na + nb,
+                                            nlon, lat_band, pnt->lon,
+                                            r_band);
+            if (band[k] == NULL)
+            {
+                CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EMEM,
+                               "Failed to initialize the \"point\" "
+                               "structure.");
+                goto EXIT;
+            }
+        }
+
+
+        /* The plan exploits the symmetry of the band if its latitudes are
+         * symmetric with respect to the equator.  With non-symmetric grids,
+         * this may hold for some bands only, so the plan is created again
+         * without the symmetry once a non-symmetric band is met. */
+        if ((plan[k] != NULL) && !symm && plan[k]->symm)
+        {
+            int err_tmp = CHARM(misc_arr_chck_symm)(lat_band, na + nb,
+                                                    PREC(0.0),
+                                                    CHARM(glob_threshold2),
+                                                    err);
+            if (!CHARM(err_isempty)(err))
+            {
+                CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                goto EXIT;
+            }
+
+
+            if (err_tmp != 0)
+            {
+                CHARM(shs_plan_free)(plan[k]);
+                plan[k] = NULL;
+            }
+        }
+
+
+        if (plan[k] == NULL)
+        {
+            plan[k] = CHARM(shs_plan_create)(band[k], nmax, GRAD_0, GRAD_0,
+                                             GRAD_0, 1, FFTW_ESTIMATE, 0,
+                                             err);
+            if (plan[k] == NULL)
+            {
+                if (!CHARM(err_isempty)(err))
+                    CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+                goto EXIT;
+            }
+        }
+
+
+        CHARM(shs_plan_execute)(plan[k], shcs, &fb, err);
+        if (!CHARM(err_isempty)(err))
+        {
+            CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+            goto EXIT;
+        }
+
+
+        if (emit_tiles(fb, 0, i0, na, nlon, nlat_tile, nlon_tile, ft, tile,
+                       data) ||
+            emit_tiles(fb, na, ib, nb, nlon, nlat_tile, nlon_tile, ft, tile,
+                       data))
+        {
+            CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFUNCARG,
+                           "\"tile\" returned a non-zero value.");
+            goto EXIT;
+        }
+
+
+        if (last)
+            break;
+        i0 += na;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+EXIT:
+    for (size_t j = 0; j < 2; j++)
+    {
+        CHARM(shs_plan_free)(plan[j]);
+        CHARM(crd_point_free)(band[j]);
+    }
+    free(lat_band);
+    free(r_band);
+    free(fb);
+    free(ft);
+
+
+    return;
+    /* --------------------------------------------------------------------- */
+}
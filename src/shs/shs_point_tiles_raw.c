@@ -0,0 +1,109 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../prec.h"
+#include "../err/err_set.h"
+#include "../err/err_propagate.h"
+#include "../misc/misc_fseek.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* The file to write the tiles to, the number of grid longitudes and "1" if
+ * writing failed */
+typedef struct
+{
+    FILE *fptr;
+    size_t nlon;
+    _Bool failed;
+} raw_file;
+
+
+
+
+
+
+/* Writes the tile to the "i0"th row of the raw file.  The tiles are always
+ * made of full rows (see "shs_point_tiles_raw"), so each tile is
+ * a contiguous block of the file. */
+static int write_tile(size_t i0,
+                      size_t j0,
+                      size_t nlat,
+                      size_t nlon,
+                      const REAL *f,
+                      void *data)
+{
+    raw_file *raw = (raw_file *)data;
+    size_t n      = nlat * nlon;
+
+
+    if (CHARM(misc_fseek)(raw->fptr,
+                          ((uint64_t)i0 * raw->nlon + j0) * sizeof(REAL)) ||
+        (fwrite(f, sizeof(REAL), n, raw->fptr) != n))
+    {
+        raw->failed = 1;
+        return 1;
+    }
+
+
+    return 0;
+}
+
+
+
+
+
+
+void CHARM(shs_point_tiles_raw)(const CHARM(point) *pnt,
+                                const CHARM(shc) *shcs,
+                                unsigned long nmax,
+                                size_t nlat_tile,
+                                const char *pathname,
+                                CHARM(err) *err)
+{
+    char msg[CHARM_ERR_MAX_MSG];
+
+
+    raw_file raw;
+    raw.nlon   = pnt->nlon;
+    raw.failed = 0;
+    raw.fptr   = fopen(pathname, "wb");
+    if (raw.fptr == NULL)
+    {
+        snprintf(msg, CHARM_ERR_MAX_MSG, "Couldn't create \"%s\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO, msg);
+        return;
+    }
+
+
+    /* The tiles are made of full rows, so that they are contiguous in the
+     * file */
+    CHARM(shs_point_tiles)(pnt, shcs, nmax, nlat_tile,
+                           CHARM_MAX(pnt->nlon, 1), write_tile, &raw, err);
+    if (raw.failed)
+    {
+        /* Replace the generic error message of "shs_point_tiles" */
+        CHARM(err_reset)(err);
+        snprintf(msg, CHARM_ERR_MAX_MSG, "Failed to write to \"%s\".",
+                 pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO, msg);
+    }
+    else if (!CHARM(err_isempty)(err))
+        CHARM(err_propagate)(err, __FILE__, __LINE__, __func__);
+
+
+    if ((fclose(raw.fptr) == EOF) && CHARM(err_isempty)(err))
+    {
+        snprintf(msg, CHARM_ERR_MAX_MSG, "Couldn't close \"%s\".", pathname);
+        CHARM(err_set)(err, __FILE__, __LINE__, __func__, CHARM_EFILEIO, msg);
+    }
+
+
+    return;
+}
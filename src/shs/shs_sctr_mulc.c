@@ -5,7 +5,6 @@
 #include "../prec.h"
 #include "../simd/simd.h"
 #include "../crd/crd_cell_isSctr.h"
-#include "../glob/glob_get_shs_block_lat_multiplier.h"
 #include "shs_sctr_mulc.h"
 /* ------------------------------------------------------------------------- */
 
@@ -16,6 +15,7 @@
 
 void CHARM(shs_sctr_mulc)(size_t i,
                           size_t n,
+                          size_t block_s,
                           int type,
                           REAL mur,
                           REAL_SIMD tmp,
@@ -23,9 +23,10 @@ void CHARM(shs_sctr_mulc)(size_t i,
                           REAL_SIMD *fi,
                           REAL *f)
 {
-#if HAVE_MPI
-    const size_t BLOCK_S = CHARM(glob_get_shs_block_lat_multiplier)();
+#if HAVE_RUNTIME_BLOCK
+    const size_t BLOCK_S = block_s;
 #else
+    (void)block_s;
 #   define BLOCK_S SIMD_BLOCK_S
 #endif
 
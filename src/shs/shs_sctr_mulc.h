@@ -17,6 +17,7 @@ extern "C"
 
 
 extern void CHARM(shs_sctr_mulc)(size_t,
+                                 size_t,
                                  size_t,
                                  int,
                                  REAL,
@@ -22,6 +22,43 @@
 
 
 
+/* With "HAVE_SIMD_DISPATCH", CHarm is compiled with the baseline instruction
+ * set of the compiler, using the generic SIMD vectors of the GCC vector
+ * extensions.  In addition, the kernels of spherical harmonic transforms are
+ * compiled once more for each of the instruction sets SSE4.1, AVX, AVX2 and
+ * AVX-512 (see "Makefile.am" in "../shs" and "../sha") and the fastest kernels
+ * supported by the CPU are selected at runtime (see "simd_dispatch.c").  When
+ * compiling the kernels for an instruction set, one of the "SIMD_ISA_*" macros
+ * is defined and the respective "HAVE_*" macro is set here. */
+#if HAVE_SIMD_DISPATCH
+#   if HAVE_SSE41 || HAVE_AVX || HAVE_AVX2 || HAVE_AVX512F || HAVE_NEON
+#       error "HAVE_SIMD_DISPATCH cannot be combined with other SIMD macros."
+#   endif
+#   undef SIMD_ISA_SUFFIX
+#   if defined(SIMD_ISA_SSE41)
+#       undef HAVE_SSE41
+#       define HAVE_SSE41 1
+#       define SIMD_ISA_SUFFIX _sse41
+#   elif defined(SIMD_ISA_AVX)
+#       undef HAVE_AVX
+#       define HAVE_AVX 1
+#       define SIMD_ISA_SUFFIX _avx
+#   elif defined(SIMD_ISA_AVX2)
+#       undef HAVE_AVX2
+#       define HAVE_AVX2 1
+#       define SIMD_ISA_SUFFIX _avx2
+#   elif defined(SIMD_ISA_AVX512)
+#       undef HAVE_AVX512F
+#       define HAVE_AVX512F 1
+#       define SIMD_ISA_SUFFIX _avx512
+#   endif
+#endif
+
+
+
+
+
+
 /* At first, let's check if one type of SIMD instruction only is defined in
  * "config.h".  The configure script does not allow this, but if CHarm is
  * compiled without the autotools, this might perhaps happen. */
@@ -38,7 +75,12 @@
 
 
 #undef SIMD
+#undef SIMD_GENERIC
 #undef SIMD_SIZE
+#undef SIMD_LAYOUT
+#undef SIMD_SPLIT
+#undef SIMD_ISA_NAME
+#undef SIMD_ISA_NAME_
 #undef SIMD_BLOCK_A
 #undef SIMD_BLOCK_S
 #undef SIMD_MEMALIGN
@@ -59,6 +101,9 @@
 #undef ADD_R
 #undef ADD_RI
 #undef SUB_R
+#undef FMA_R
+#undef FNMA_R
+#undef SIMD_FMA
 #undef SUB_RI
 #undef NEG_R
 #undef SIGNBIT
@@ -104,17 +149,25 @@
 
 
 
-#if HAVE_SSE41 || HAVE_AVX || HAVE_AVX2 || HAVE_AVX512F || HAVE_NEON
+#if HAVE_SSE41 || HAVE_AVX || HAVE_AVX2 || HAVE_AVX512F || HAVE_NEON || \
+    HAVE_SIMD_DISPATCH
     /* If "SIMD" is defined, CHarm is being compiled with SIMD support. */
 #   define SIMD
 #endif
 
 
+#if HAVE_SIMD_DISPATCH && !defined(SIMD_ISA_SUFFIX)
+    /* If "SIMD_GENERIC" is defined, the generic SIMD vectors are used instead
+     * of the intrinsics of some instruction set. */
+#   define SIMD_GENERIC
+#endif
+
+
 
 
 
 
-#ifdef SIMD
+#if defined(SIMD) && !defined(SIMD_GENERIC)
 
 
 #   if CHARM_QUAD
@@ -295,21 +348,32 @@
 #   endif
 
 
-    /* The "SIMD_BLOCK_A" and "SIMD_BLOCK_S" values can be played with.  They
-     * have no effect on the accuracy, but affect the performance.  Too low or
-     * too high values can decrease the computation speed.  "SIMD_BLOCK_A" is
-     * used in with the spherical harmonic analysis and "SIMD_BLOCK_S" is used
-     * with the synthesis. */
-#   define SIMD_BLOCK_A 8
-#   define SIMD_BLOCK_S 4
-
-
 #   define MUL_R(x, y)         PF(mul)((x), (y))
 #   define DIV_R(x, y)         PF(div)((x), (y))
 #   define ADD_R(x, y)         PF(add)((x), (y))
 #   define SUB_R(x, y)         PF(sub)((x), (y))
 
 
+    /* Fused multiply-add.  "FMA_R(x, y, z)" returns "x * y + z" and
+     * "FNMA_R(x, y, z)" returns "z - x * y".  If the CPU instructions are
+     * available (AVX-512F, NEON on ARM64 and AVX2 with the FMA3 extension),
+     * the result is rounded only once and "SIMD_FMA" is defined.  Otherwise, the
+     * operations are emulated by a multiplication followed by an addition or
+     * a subtraction. */
+#   if HAVE_AVX512F || (HAVE_AVX2 && defined(__FMA__))
+#       define SIMD_FMA
+#       define FMA_R(x, y, z)      PF(fmadd)((x), (y), (z))
+#       define FNMA_R(x, y, z)     PF(fnmadd)((x), (y), (z))
+#   elif HAVE_NEON && defined(__ARM_FEATURE_FMA)
+#       define SIMD_FMA
+#       define FMA_R(x, y, z)      PF(fma)((z), (x), (y))
+#       define FNMA_R(x, y, z)     PF(fms)((z), (x), (y))
+#   else
+#       define FMA_R(x, y, z)      ADD_R(MUL_R((x), (y)), (z))
+#       define FNMA_R(x, y, z)     SUB_R((z), MUL_R((x), (y)))
+#   endif
+
+
 #   if HAVE_SSE41 || HAVE_AVX || HAVE_AVX2 || HAVE_AVX512F
 #       define SET1_R(x)           PF(set1)((x))
 #       define LOAD_R(x)           PF(load)((x))
@@ -603,12 +667,171 @@
 #   endif
 
 
+#elif defined(SIMD_GENERIC)
+
+
+#   if CHARM_QUAD
+#       error "Cannot compile with SIMD instructions in quadruple precision."
+#   endif
+
+
+#   include <math.h>
+
+
+    /* The generic vectors have 64 bytes, so that they have the same size as
+     * the AVX-512 vectors.  With narrower instruction sets, the compiler
+     * splits the operations into several instructions. */
+#   if CHARM_FLOAT
+#       define SIMD_SIZE     16
+#   else
+#       define SIMD_SIZE     8
+#   endif
+#   define SIMD_MEMALIGN     64
+#   define REAL_SIMD         REAL __attribute__((vector_size(64)))
+#   define RI_SIMD           INT __attribute__((vector_size(64)))
+#   define INT_SIMD          RI_SIMD
+    /* The masks are integer vectors with all bits of the "true" elements set
+     * and all bits of the "false" elements unset. */
+#   define MASK_SIMD         RI_SIMD
+#   define MASK2_SIMD        RI_SIMD
+
+
+#   define MUL_R(x, y)         ((x) * (y))
+#   define DIV_R(x, y)         ((x) / (y))
+#   define ADD_R(x, y)         ((x) + (y))
+#   define SUB_R(x, y)         ((x) - (y))
+#   define FMA_R(x, y, z)      ((x) * (y) + (z))
+#   define FNMA_R(x, y, z)     ((z) - (x) * (y))
+#   define NEG_R(x)            (-(x))
+
+
+    inline static REAL_SIMD SET1_R(REAL x)
+    {
+        REAL_SIMD v;
+        for (int i = 0; i < SIMD_SIZE; i++)
+            v[i] = x;
+        return v;
+    }
+
+
+    inline static RI_SIMD SET1_RI(INT x)
+    {
+        RI_SIMD v;
+        for (int i = 0; i < SIMD_SIZE; i++)
+            v[i] = x;
+        return v;
+    }
+
+
+#   define SET_ZERO_R          ((REAL_SIMD){0})
+#   define SET_ZERO_I          ((RI_SIMD){0})
+#   define SET_ZERO_RI         SET_ZERO_I
+
+
+    /* "LOAD_R" and "STORE_R" require "x" and "ptr" to be aligned to
+     * "SIMD_MEMALIGN" bytes, the other macros do not. */
+#   define LOAD_R(x)           (*(const REAL_SIMD *)(x))
+#   define STORE_R(ptr, x)     (*(REAL_SIMD *)(ptr) = (x))
+
+
+    inline static REAL_SIMD LOADU_R(const REAL *x)
+    {
+        REAL_SIMD v;
+        memcpy(&v, x, sizeof(v));
+        return v;
+    }
+
+
+    inline static void STOREU_R(REAL *ptr, REAL_SIMD x)
+    {
+        memcpy(ptr, &x, sizeof(x));
+    }
+
+
+    inline static RI_SIMD LOAD_RI(const INT *x)
+    {
+        RI_SIMD v;
+        memcpy(&v, x, sizeof(v));
+        return v;
+    }
+
+
+#   define CAST_RI2R(x)        ((REAL_SIMD)(x))
+#   define CAST_R2RI(x)        ((RI_SIMD)(x))
+
+
+#   define EQ_R(x, y)          ((RI_SIMD)((x) == (y)))
+#   define GE_R(x, y)          ((RI_SIMD)((x) >= (y)))
+#   define LT_R(x, y)          ((RI_SIMD)((x) < (y)))
+#   define EQ_RI(x, y)         ((RI_SIMD)((x) == (y)))
+#   define GT_RI(x, y)         ((RI_SIMD)((x) > (y)))
+#   define ADD_RI(x, y)        ((x) + (y))
+#   define SUB_RI(x, y)        ((x) - (y))
+
+
+#   define AND_R(x, y)         ((REAL_SIMD)((RI_SIMD)(x) & (RI_SIMD)(y)))
+#   define OR_R(x, y)          ((REAL_SIMD)((RI_SIMD)(x) | (RI_SIMD)(y)))
+#   define OR_MASK(x, y)       ((RI_SIMD)(x) | (RI_SIMD)(y))
+#   define ANDNOT_MASK(x)      (~(RI_SIMD)(x))
+
+
+    /* Returns the elements of "y" where "mask" is true and the elements of
+     * "x" elsewhere. */
+#   define BLEND_RI(x, y, mask)  ((((RI_SIMD)(x)) & ~((RI_SIMD)(mask))) | \
+                                  (((RI_SIMD)(y)) & ((RI_SIMD)(mask))))
+#   define BLEND_R(x, y, mask)   ((REAL_SIMD)BLEND_RI((x), (y), (mask)))
+
+
+#   if CHARM_FLOAT
+#       define NONSIGNBITS 0x7FFFFFFF
+#       define SIGNBIT     0x80000000
+#   else
+#       define NONSIGNBITS 0x7FFFFFFFFFFFFFFFLL
+#       define SIGNBIT     0x8000000000000000LL
+#   endif
+#   define ABS_R(x)     ((REAL_SIMD)((RI_SIMD)(x) & SET1_RI(NONSIGNBITS)))
+
+
+    inline static REAL SUM_R(REAL_SIMD x)
+    {
+        REAL sum = x[0];
+        for (int i = 1; i < SIMD_SIZE; i++)
+            sum += x[i];
+        return sum;
+    }
+
+
+#   define SIMD_MULTIPLE(x, multiple) ((((x) + \
+                                         (multiple) - 1) / (multiple)) * \
+                                       (multiple))
+
+
+    inline static _Bool MASK_TRUE_ALL_RI(RI_SIMD x)
+    {
+        for (int i = 0; i < SIMD_SIZE; i++)
+            if (!x[i])
+                return 0;
+        return 1;
+    }
+
+
+    inline static _Bool MASK_TRUE_ANY_RI(RI_SIMD x)
+    {
+        for (int i = 0; i < SIMD_SIZE; i++)
+            if (x[i])
+                return 1;
+        return 0;
+    }
+
+
+#   define MASK_TRUE_ALL(x)     MASK_TRUE_ALL_RI((RI_SIMD)(x))
+#   define MASK_TRUE_ANY(x)     MASK_TRUE_ANY_RI((RI_SIMD)(x))
+
+
 #else
 
 
 #   define SIMD_SIZE     1
-#   define SIMD_BLOCK_A  8  /* See the description in the SIMD section */
-#   define SIMD_BLOCK_S  8  /* See the description in the SIMD section */
 #   define SIMD_TRUE     1
 #   define SIMD_MEMALIGN 0
 #   define REAL_SIMD     REAL
@@ -620,6 +843,8 @@
 #   define DIV_R(x, y)    ((x) / (y))
 #   define ADD_R(x, y)    ((x) + (y))
 #   define SUB_R(x, y)    ((x) - (y))
+#   define FMA_R(x, y, z)  ((x) * (y) + (z))
+#   define FNMA_R(x, y, z) ((z) - (x) * (y))
 
 
 #   define SET1_R(x)            (x)
@@ -667,4 +892,66 @@
 
 
 
+
+
+
+/* "SIMD_LAYOUT" is the number of elements of the vectors, in which the data
+ * are passed to the kernels of spherical harmonic transforms.  It is equal to
+ * "SIMD_SIZE", except with "HAVE_SIMD_DISPATCH", where the data are stored as
+ * the generic SIMD vectors of 64 bytes for all instruction sets.  A kernel
+ * compiled for an instruction set with narrower vectors then processes each
+ * generic vector as "SIMD_SPLIT" consecutive vectors of "SIMD_SIZE"
+ * elements. */
+#if HAVE_SIMD_DISPATCH
+#   if CHARM_FLOAT
+#       define SIMD_LAYOUT 16
+#   else
+#       define SIMD_LAYOUT 8
+#   endif
+#   undef SIMD_MEMALIGN
+#   define SIMD_MEMALIGN 64
+#else
+#   define SIMD_LAYOUT SIMD_SIZE
+#endif
+#define SIMD_SPLIT (SIMD_LAYOUT / SIMD_SIZE)
+
+
+/* Name of a function compiled for the instruction set "SIMD_ISA_SUFFIX", for
+ * instance, "SIMD_ISA_NAME(shs_cell_kernel)" expands to
+ * "charm_shs_cell_kernel_avx2" when compiling the AVX2 kernels in double
+ * precision.  Without "SIMD_ISA_SUFFIX", this is the same as "CHARM(x)". */
+#ifdef SIMD_ISA_SUFFIX
+#   define SIMD_ISA_NAME_(x, suffix) CAT(x, suffix)
+#   define SIMD_ISA_NAME(x) SIMD_ISA_NAME_(CHARM(x), SIMD_ISA_SUFFIX)
+#else
+#   define SIMD_ISA_NAME(x) CHARM(x)
+#endif
+
+
+/* The "SIMD_BLOCK_A" and "SIMD_BLOCK_S" values can be played with.  They have
+ * no effect on the accuracy, but affect the performance.  Too low or too high
+ * values can decrease the computation speed.  "SIMD_BLOCK_A" is used in with
+ * the spherical harmonic analysis and "SIMD_BLOCK_S" is used with the
+ * synthesis.  The default values can be changed during the installation by
+ * "--with-simd-block-a" and "--with-simd-block-s" (see "bench/tune_block.c"
+ * to find the optimal values for the host's CPU).  With "HAVE_RUNTIME_BLOCK",
+ * these are only the default values of "glob_sha_block_lat_multiplier" and
+ * "glob_shs_block_lat_multiplier".  The values are multiplied by "SIMD_SPLIT",
+ * so that a latitude block has the same number of latitudes in the kernels
+ * compiled for all instruction sets. */
+#if CHARM_SIMD_BLOCK_A
+#   define SIMD_BLOCK_A (CHARM_SIMD_BLOCK_A * SIMD_SPLIT)
+#else
+#   define SIMD_BLOCK_A (8 * SIMD_SPLIT)
+#endif
+#if CHARM_SIMD_BLOCK_S
+#   define SIMD_BLOCK_S (CHARM_SIMD_BLOCK_S * SIMD_SPLIT)
+#elif defined(SIMD)
+#   define SIMD_BLOCK_S (4 * SIMD_SPLIT)
+#else
+#   define SIMD_BLOCK_S (8 * SIMD_SPLIT)
+#endif
+
+
+
 #endif
@@ -0,0 +1,128 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../prec.h"
+#include "../misc/misc_buildopt.h"
+#include "../shs/shs_kernels.h"
+#include "../sha/sha_kernels.h"
+#include "simd_dispatch.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+#if HAVE_SIMD_DISPATCH
+
+
+/* Kernels compiled for the individual instruction sets, see "SIMD_ISA_NAME"
+ * in "simd.h" */
+extern const CHARM(shs_kernels_table) CHARM(shs_kernels_sse41);
+extern const CHARM(shs_kernels_table) CHARM(shs_kernels_avx);
+extern const CHARM(shs_kernels_table) CHARM(shs_kernels_avx2);
+extern const CHARM(shs_kernels_table) CHARM(shs_kernels_avx512);
+extern const CHARM(sha_kernels_table) CHARM(sha_kernels_sse41);
+extern const CHARM(sha_kernels_table) CHARM(sha_kernels_avx);
+extern const CHARM(sha_kernels_table) CHARM(sha_kernels_avx2);
+extern const CHARM(sha_kernels_table) CHARM(sha_kernels_avx512);
+
+
+/* Kernels of all instruction sets.  The instructions of a row are a subset of
+ * the instructions of the rows that follow.  The first row holds the kernels
+ * compiled without any instruction set flags. */
+static const struct
+{
+    int simd;
+    const CHARM(shs_kernels_table) *shs;
+    const CHARM(sha_kernels_table) *sha;
+} kernels[] =
+{
+    {BUILDOPT_SIMD_NONE,   &CHARM(shs_kernels),
+                           &CHARM(sha_kernels)},
+    {BUILDOPT_SIMD_SSE41,  &CHARM(shs_kernels_sse41),
+                           &CHARM(sha_kernels_sse41)},
+    {BUILDOPT_SIMD_AVX,    &CHARM(shs_kernels_avx),
+                           &CHARM(sha_kernels_avx)},
+    {BUILDOPT_SIMD_AVX2,   &CHARM(shs_kernels_avx2),
+                           &CHARM(sha_kernels_avx2)},
+    {BUILDOPT_SIMD_AVX512, &CHARM(shs_kernels_avx512),
+                           &CHARM(sha_kernels_avx512)}
+};
+
+
+#undef NKERNELS
+#define NKERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+
+
+
+
+
+/* Kernels called by the spherical harmonic transforms, see "SHS_KERNEL" and
+ * "SHA_KERNEL".  Until "simd_dispatch_init" is called, the kernels compiled
+ * without any instruction set flags are used. */
+const CHARM(shs_kernels_table) *CHARM(simd_dispatch_shs) = &CHARM(shs_kernels);
+const CHARM(sha_kernels_table) *CHARM(simd_dispatch_sha) = &CHARM(sha_kernels);
+
+
+/* SIMD instructions of the kernels in "simd_dispatch_shs" and
+ * "simd_dispatch_sha" */
+int CHARM(simd_dispatch_isa) = BUILDOPT_SIMD_NONE;
+
+
+
+
+
+
+/* Selects the kernels compiled for the SIMD instructions "simd"
+ * ("BUILDOPT_SIMD_NONE", "BUILDOPT_SIMD_SSE41", ...).  Returns "0" on success
+ * and "1" if the kernels are not available or if the CPU does not support
+ * "simd".  The function is not thread-safe and must not be called while
+ * a spherical harmonic transform is running. */
+int CHARM(simd_dispatch_set)(int simd)
+{
+    const int simd_cpu = CHARM(misc_cpu_simd)();
+
+
+    for (size_t i = 0; i < NKERNELS; i++)
+    {
+        if (kernels[i].simd == simd)
+        {
+            CHARM(simd_dispatch_shs) = kernels[i].shs;
+            CHARM(simd_dispatch_sha) = kernels[i].sha;
+            CHARM(simd_dispatch_isa) = simd;
+
+
+            return 0;
+        }
+
+
+        /* The CPU does not support the instructions of the rows that
+         * follow */
+        if (kernels[i].simd == simd_cpu)
+            break;
+    }
+
+
+    return 1;
+}
+
+
+
+
+
+
+/* Selects the kernels of the best SIMD instructions supported by the CPU when
+ * the library is loaded */
+__attribute__((constructor)) static void simd_dispatch_init(void)
+{
+    CHARM(simd_dispatch_set)(CHARM(misc_cpu_simd)());
+
+
+    return;
+}
+
+
+#endif
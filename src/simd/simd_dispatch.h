@@ -0,0 +1,27 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __SIMD_DISPATCH_H__
+#define __SIMD_DISPATCH_H__
+
+
+#include <config.h>
+#include "../prec.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern int CHARM(simd_dispatch_isa);
+extern int CHARM(simd_dispatch_set)(int);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -2,6 +2,8 @@
 /* ------------------------------------------------------------------------- */
 #include <config.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
 #include "../src/prec.h"
 #include "parameters.h"
 #include "error_messages.h"
@@ -18,6 +20,17 @@
 
 
 
+/* Maximum harmonic degree to check the Fourier coefficients against Legendre
+ * functions.  It is high enough to employ all OpenMP threads and SIMD
+ * vectors. */
+#undef NMAX_HIGH
+#define NMAX_HIGH (300UL)
+
+
+
+
+
+
 long int check_leg_pnmj_coeffs(void)
 {
     /* --------------------------------------------------------------------- */
@@ -118,6 +131,84 @@ long int check_leg_pnmj_coeffs(void)
 
 
 
+    /* Fourier series with the coefficients of high degrees must give the
+     * Legendre functions computed by the standard recurrences */
+    /* --------------------------------------------------------------------- */
+    pnmj = CHARM(leg_pnmj_calloc)(NMAX_HIGH, CHARM_LEG_PMNJ);
+    REAL *pn = (REAL *)malloc((NMAX_HIGH + 1) * sizeof(REAL));
+    if ((pnmj == NULL) || (pn == NULL))
+    {
+        fprintf(stderr, "%s", ERR_MSG_PNMJ);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(leg_pnmj_coeffs)(pnmj, NMAX_HIGH, err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* Co-latitude of the evaluation point */
+    REAL theta = PREC(0.7);
+    REAL t     = COS(theta);
+    REAL u     = SIN(theta);
+    REAL pmm   = PREC(1.0);
+    REAL anm, bnm, sum;
+    for (unsigned long m = 0; m <= NMAX_HIGH; m++)
+    {
+        if (m == 1)
+            pmm = SQRT(PREC(3.0)) * u;
+        else if (m > 1)
+            pmm *= u * SQRT((PREC(2.0) * (REAL)m + PREC(1.0)) /
+                            (PREC(2.0) * (REAL)m));
+
+
+        pn[m] = pmm;
+        if (m < NMAX_HIGH)
+            pn[m + 1] = SQRT(PREC(2.0) * (REAL)m + PREC(3.0)) * t * pmm;
+        for (unsigned long n = m + 2; n <= NMAX_HIGH; n++)
+        {
+            anm = SQRT((PREC(2.0) * (REAL)n - PREC(1.0)) *
+                       (PREC(2.0) * (REAL)n + PREC(1.0)) /
+                       ((REAL)(n - m) * (REAL)(n + m)));
+            bnm = SQRT((PREC(2.0) * (REAL)n + PREC(1.0)) *
+                       (REAL)(n + m - 1) * (REAL)(n - m - 1) /
+                       ((REAL)(n - m) * (REAL)(n + m) *
+                        (PREC(2.0) * (REAL)n - PREC(3.0))));
+            pn[n] = anm * t * pn[n - 1] - bnm * pn[n - 2];
+        }
+
+
+        for (unsigned long n = m; n <= NMAX_HIGH; n++)
+        {
+            sum = PREC(0.0);
+            for (unsigned long j = 0; j <= (n / 2); j++)
+            {
+                REAL kt = (REAL)CHARM(leg_pnmj_j2k)(n, j) * theta;
+                sum += pnmj->pnmj[m][n - m][j] * ((m % 2) ? SIN(kt) :
+                                                            COS(kt));
+            }
+
+
+            if (FABS(sum - pn[n]) > CHARM(glob_threshold2))
+            {
+                printf("\n        WARNING: The Fourier series of degree %lu "
+                       "and order %lu does not match the Legendre "
+                       "function!\n", n, m);
+                e += 1;
+            }
+        }
+    }
+
+
+    CHARM(leg_pnmj_free)(pnmj);
+    free(pn);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
     /* --------------------------------------------------------------------- */
     CHARM(err_free)(err);
 
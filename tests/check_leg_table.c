@@ -0,0 +1,149 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/prec.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "generate_point.h"
+#include "check_leg_table.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+long int check_leg_table(void)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+    CHARM(leg_table) *table = NULL;
+
+
+    /* Grid with the poles */
+    CHARM(point) *pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 5, 4);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, PREC(1.0), PI, PREC(2.0) * PI);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Memory requirements */
+    /* --------------------------------------------------------------------- */
+    for (unsigned dlat = 0; dlat <= 2; dlat++)
+    {
+        for (int single = 0; single < 2; single++)
+        {
+            size_t nbytes = CHARM(leg_table_nbytes)(pnt, NMAX, dlat, single);
+            size_t nbytes_ref = (dlat + 1) *
+                                ((NMAX + 1) * (NMAX + 2) / 2) * pnt->nlat *
+                                ((single) ? sizeof(float) : sizeof(REAL));
+            if (nbytes != nbytes_ref)
+            {
+                printf("\n        WARNING: Wrong number of bytes of the "
+                       "table (%zu instead of %zu)!\n", nbytes, nbytes_ref);
+                e += 1;
+            }
+        }
+    }
+
+
+    if (CHARM(leg_table_nbytes)(pnt, NMAX, 3, 0) != 0)
+    {
+        printf("\n        WARNING: Non-zero number of bytes of the table with "
+               "\"dlat > 2\"!\n");
+        e += 1;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Invalid input */
+    /* --------------------------------------------------------------------- */
+    /* "dlat > 2" */
+    table = CHARM(leg_table_init)(pnt, NMAX, 3, 0, 0, err);
+    if ((table != NULL) || CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too large \"dlat\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(leg_table_free)(table);
+    CHARM(err_reset)(err);
+
+
+    /* Derivatives at the poles */
+    table = CHARM(leg_table_init)(pnt, NMAX, 1, 0, 0, err);
+    if ((table != NULL) || CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Derivatives at the poles didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(leg_table_free)(table);
+    CHARM(err_reset)(err);
+
+
+    /* Table larger than "max_bytes" */
+    table = CHARM(leg_table_init)(pnt, NMAX, 0, 0,
+                                  CHARM(leg_table_nbytes)(pnt, NMAX, 0, 0) - 1,
+                                  err);
+    if ((table != NULL) || CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too small \"max_bytes\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(leg_table_free)(table);
+    CHARM(err_reset)(err);
+
+
+    /* Valid input with the exact "max_bytes" and with no limit */
+    for (int limit = 0; limit < 2; limit++)
+    {
+        size_t max_bytes = (limit) ? CHARM(leg_table_nbytes)(pnt, NMAX, 0, 0)
+                                   : 0;
+        table = CHARM(leg_table_init)(pnt, NMAX, 0, 0, max_bytes, err);
+        if ((table == NULL) || !CHARM(err_isempty)(err))
+        {
+            printf("\n        WARNING: Valid input produced an error!\n");
+            e += 1;
+        }
+        CHARM(leg_table_free)(table);
+        CHARM(err_reset)(err);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(crd_point_free)(pnt);
+    CHARM(err_free)(err);
+
+
+    return e;
+    /* --------------------------------------------------------------------- */
+}
@@ -0,0 +1,347 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE_MPI
+#   include <mpi.h>
+#else
+#   error "mpi.h required"
+#endif
+#include "../src/prec.h"
+#include "../src/err/err_is_null_ptr.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "cmp_vals.h"
+#include "cmp_arrays.h"
+#include "mpi_shc_distribute.h"
+#include "check_mpi_shc_read.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* "gfc" readers with the signature of the other readers */
+static unsigned long read_gfc(const char *pathname,
+                              unsigned long nmax,
+                              CHARM(shc) *shcs,
+                              CHARM(err) *err)
+{
+    return CHARM(shc_read_gfc)(pathname, nmax, NULL, shcs, err);
+}
+
+
+static unsigned long mpi_read_gfc(const char *pathname,
+                                  unsigned long nmax,
+                                  CHARM(shc) *shcs,
+                                  CHARM(err) *err)
+{
+    return CHARM(mpi_shc_read_gfc)(pathname, nmax, NULL, shcs, err);
+}
+
+
+static unsigned long read_gfc_tvg(const char *pathname,
+                                  unsigned long nmax,
+                                  CHARM(shc) *shcs,
+                                  CHARM(err) *err)
+{
+    return CHARM(shc_read_gfc)(pathname, nmax, TVG_EPOCH, shcs, err);
+}
+
+
+static unsigned long mpi_read_gfc_tvg(const char *pathname,
+                                      unsigned long nmax,
+                                      CHARM(shc) *shcs,
+                                      CHARM(err) *err)
+{
+    return CHARM(mpi_shc_read_gfc)(pathname, nmax, TVG_EPOCH, shcs, err);
+}
+
+
+
+
+
+
+/* Reads "pathname" up to degree "nmax" to a distributed structure with the
+ * maximum degree "nmax_shcs" by "mpi_read" and compares the local
+ * coefficients with those from "read" */
+static long int check_read(unsigned long (*read)(const char *,
+                                                 unsigned long,
+                                                 CHARM(shc) *,
+                                                 CHARM(err) *),
+                           unsigned long (*mpi_read)(const char *,
+                                                     unsigned long,
+                                                     CHARM(shc) *,
+                                                     CHARM(err) *),
+                           const char *pathname,
+                           unsigned long nmax,
+                           unsigned long nmax_shcs,
+                           size_t local_nchunk,
+                           MPI_Comm comm,
+                           CHARM(err) *err)
+{
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+
+    long int e = 0;
+
+
+    /* Reference coefficients */
+    CHARM(err) *err_d0 = CHARM(err_init)();
+    if (err_d0 == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc) *shcs_ref = CHARM(shc_calloc)(nmax_shcs, PREC(1.0),
+                                             PREC(1.0));
+    if (shcs_ref == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    unsigned long nmax_file = read(pathname, nmax, shcs_ref, err_d0);
+    CHARM(err_handler)(err_d0, 1);
+
+
+    /* Distributed coefficients.  "mpi_shc_malloc" is used on purpose, so that
+     * the reader must set all the local coefficients. */
+    unsigned long *local_order = mpi_shc_distribute(nmax_shcs, rank, size,
+                                                    local_nchunk);
+    CHARM(shc) *shcs = CHARM(mpi_shc_malloc)(nmax_shcs, PREC(1.0), PREC(1.0),
+                                             local_nchunk, local_order, comm,
+                                             err);
+    CHARM(err_handler)(err, 1);
+    for (size_t i = 0; i < shcs->local_nc; i++)
+        shcs->c[shcs->local_order[0]][i] = PREC(7.0);
+    for (size_t i = 0; i < shcs->local_ns; i++)
+        shcs->s[shcs->local_order[0]][i] = PREC(7.0);
+
+
+    e += cmp_vals_ulong(mpi_read(pathname, nmax, shcs, err), nmax_file);
+    CHARM(err_handler)(err, 1);
+    e += cmp_vals_ulong(mpi_read(pathname, CHARM_SHC_NMAX_MODEL, NULL, err),
+                        nmax_file);
+    CHARM(err_handler)(err, 1);
+
+
+    e += cmp_vals_real(shcs->mu, shcs_ref->mu, CHARM(glob_threshold));
+    e += cmp_vals_real(shcs->r, shcs_ref->r, CHARM(glob_threshold));
+    for (size_t j = 0; j < local_nchunk; j++)
+    {
+        for (unsigned long m = local_order[2 * j];
+             m <= local_order[2 * j + 1]; m++)
+        {
+            e += cmp_arrays(shcs->c[m], shcs_ref->c[m], nmax_shcs + 1 - m,
+                            CHARM(glob_threshold));
+            e += cmp_arrays(shcs->s[m], shcs_ref->s[m], nmax_shcs + 1 - m,
+                            CHARM(glob_threshold));
+        }
+    }
+
+
+    /* Non-distributed "shcs" must be rejected by all processes */
+    mpi_read(pathname, nmax, shcs_ref, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shc_free)(shcs);
+    CHARM(shc_free)(shcs_ref);
+    CHARM(err_free)(err_d0);
+    free(local_order);
+
+
+    return e;
+}
+
+
+
+
+
+
+/* Reads the corrupted "pathname" by "mpi_read", which must fail at all
+ * processes */
+static long int check_read_corrupt(unsigned long (*mpi_read)(const char *,
+                                                             unsigned long,
+                                                             CHARM(shc) *,
+                                                             CHARM(err) *),
+                                   const char *pathname,
+                                   MPI_Comm comm,
+                                   CHARM(err) *err)
+{
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+
+    unsigned long *local_order = mpi_shc_distribute(SHCS_NMAX_POT, rank, size,
+                                                    1);
+    CHARM(shc) *shcs = CHARM(mpi_shc_calloc)(SHCS_NMAX_POT, PREC(1.0),
+                                             PREC(1.0), 1, local_order, comm,
+                                             err);
+    CHARM(err_handler)(err, 1);
+
+
+    mpi_read(pathname, SHCS_NMAX_POT, shcs, err);
+    long int e = (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shc_free)(shcs);
+    free(local_order);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_mpi_shc_read(void)
+{
+    /* --------------------------------------------------------------------- */
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+
+    CHARM(err) *err = CHARM(mpi_err_init)(comm);
+    if (CHARM(err_is_null_ptr)(err, 1, comm))
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+    /* --------------------------------------------------------------------- */
+
+
+    /* Write the binary file to be read by "mpi_shc_read_bin" */
+    /* --------------------------------------------------------------------- */
+    if (rank == 0)
+    {
+        CHARM(err) *err_d0 = CHARM(err_init)();
+        if (err_d0 == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_ERR);
+            exit(CHARM_FAILURE);
+        }
+        CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0),
+                                             PREC(1.0));
+        if (shcs == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+        CHARM(shc_read_gfc)(SHCS_IN_PATH_POT_GFC, SHCS_NMAX_POT, NULL, shcs,
+                            err_d0);
+        CHARM(err_handler)(err_d0, 1);
+        CHARM(shc_write_bin)(shcs, SHCS_NMAX_POT, SHCS_OUT_PATH_POT_BIN_MPI,
+                             err_d0);
+        CHARM(err_handler)(err_d0, 1);
+
+
+        /* Text files with the orders in the outer loop, so that each process
+         * reads a few long byte ranges of the files */
+        CHARM(shc_write_tbl)(shcs, SHCS_NMAX_POT, NULL, CHARM_SHC_WRITE_M,
+                             SHCS_OUT_PATH_POT_TBL_MPI, err_d0);
+        CHARM(err_handler)(err_d0, 1);
+        CHARM(shc_write_dov)(shcs, SHCS_NMAX_POT, NULL, CHARM_SHC_WRITE_M,
+                             SHCS_OUT_PATH_POT_DOV_MPI, err_d0);
+        CHARM(err_handler)(err_d0, 1);
+
+
+        /* "tbl" file with a line of an invalid order, which is assigned to the
+         * root process */
+        CHARM(shc_write_tbl)(shcs, SHCS_NMAX_POT, NULL, CHARM_SHC_WRITE_M,
+                             SHCS_OUT_PATH_POT_TBL_CORRUPT_MPI, err_d0);
+        CHARM(err_handler)(err_d0, 1);
+        FILE *fptr = fopen(SHCS_OUT_PATH_POT_TBL_CORRUPT_MPI, "a");
+        if (fptr == NULL)
+        {
+            fprintf(stderr, "Failed to open the corrupted \"tbl\" file.\n");
+            exit(CHARM_FAILURE);
+        }
+        fprintf(fptr, "3 x 0.0 0.0\n");
+        fclose(fptr);
+        CHARM(shc_free)(shcs);
+        CHARM(err_free)(err_d0);
+    }
+    MPI_Barrier(comm);
+    /* --------------------------------------------------------------------- */
+
+
+    /* --------------------------------------------------------------------- */
+#define NFORMATS 8
+    unsigned long (*read[NFORMATS])(const char *, unsigned long, CHARM(shc) *,
+                                    CHARM(err) *) = {CHARM(shc_read_bin),
+                                                     CHARM(shc_read_mtx),
+                                                     CHARM(shc_read_tbl),
+                                                     CHARM(shc_read_dov),
+                                                     read_gfc,
+                                                     read_gfc_tvg,
+                                                     CHARM(shc_read_tbl),
+                                                     CHARM(shc_read_dov)};
+    unsigned long (*mpi_read[NFORMATS])(const char *, unsigned long,
+                                        CHARM(shc) *,
+                                        CHARM(err) *) =
+                                                {CHARM(mpi_shc_read_bin),
+                                                 CHARM(mpi_shc_read_mtx),
+                                                 CHARM(mpi_shc_read_tbl),
+                                                 CHARM(mpi_shc_read_dov),
+                                                 mpi_read_gfc,
+                                                 mpi_read_gfc_tvg,
+                                                 CHARM(mpi_shc_read_tbl),
+                                                 CHARM(mpi_shc_read_dov)};
+    const char *pathname[NFORMATS] = {SHCS_OUT_PATH_POT_BIN_MPI,
+                                      SHCS_IN_PATH_POT_MTX,
+                                      SHCS_IN_PATH_POT_TBL,
+                                      SHCS_IN_PATH_POT_DOV,
+                                      SHCS_IN_PATH_POT_GFC,
+                                      SHCS_IN_PATH_POT_GFC_TVG,
+                                      SHCS_OUT_PATH_POT_TBL_MPI,
+                                      SHCS_OUT_PATH_POT_DOV_MPI};
+
+
+    for (size_t f = 0; f < NFORMATS; f++)
+    {
+        for (unsigned long nmax = SHCS_NMAX_POT - 3; nmax <= SHCS_NMAX_POT;
+             nmax += 3)
+        {
+            /* "nmax_shcs" is never too small to distribute two chunks per
+             * process (see "mpi_shc_distribute") */
+            for (unsigned long nmax_shcs = SHCS_NMAX_POT;
+                 nmax_shcs <= SHCS_NMAX_POT + 2; nmax_shcs += 2)
+            {
+                for (size_t local_nchunk = 1; local_nchunk <= 2;
+                     local_nchunk++)
+                {
+                    e += check_read(read[f], mpi_read[f], pathname[f], nmax,
+                                    nmax_shcs, local_nchunk, comm, err);
+                }
+            }
+        }
+    }
+#undef NFORMATS
+
+
+    e += check_read_corrupt(CHARM(mpi_shc_read_tbl),
+                            SHCS_OUT_PATH_POT_TBL_CORRUPT_MPI, comm, err);
+    /* --------------------------------------------------------------------- */
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(err_free)(err);
+    /* --------------------------------------------------------------------- */
+
+
+    return e;
+}
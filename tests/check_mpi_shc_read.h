@@ -0,0 +1,25 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __CHECK_MPI_SHC_READ_H__
+#define __CHECK_MPI_SHC_READ_H__
+
+
+#include <config.h>
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern long int check_mpi_shc_read(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
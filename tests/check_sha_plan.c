@@ -0,0 +1,313 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/prec.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "cmp_arrays.h"
+#include "modify_low_degree_coefficients.h"
+#include "check_sha_plan.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Number of signals analysed by a single plan */
+#undef NSIGNAL
+#define NSIGNAL (3)
+
+
+
+
+
+
+/* Creates a plan for the quadrature grid "pnt", executes it several times with
+ * the signals synthesized from "shcs" and "shcs2" and compares the results
+ * with the reference values from "CHARM(sha_point)" */
+static long int check_plan(const CHARM(point) *pnt,
+                           const CHARM(shc) *shcs,
+                           const CHARM(shc) *shcs2,
+                           unsigned long nmax,
+                           int flags,
+                           CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    REAL *f  = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    REAL *f2 = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if ((f == NULL) || (f2 == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_point)(pnt, shcs, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(shs_point)(pnt, shcs2, nmax, f2, err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* Output coefficients are alternately scaled to "shcs->r" and to the
+     * radius of "pnt", so that the rescaling of the coefficients is checked,
+     * too */
+    const REAL *f_all[NSIGNAL] = {f, f2, f};
+    REAL r_all[NSIGNAL]        = {shcs->r, pnt->r[0], shcs->r};
+
+
+    CHARM(sha_plan) *plan = CHARM(sha_plan_init)(pnt, nmax, flags, err);
+    CHARM(err_handler)(err, 1);
+
+
+    for (size_t k = 0; k < NSIGNAL; k++)
+    {
+        CHARM(shc) *shcs_out = CHARM(shc_calloc)(nmax, shcs->mu, r_all[k]);
+        CHARM(shc) *shcs_ref = CHARM(shc_calloc)(nmax, shcs->mu, r_all[k]);
+        if ((shcs_out == NULL) || (shcs_ref == NULL))
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+
+
+        CHARM(sha_plan_execute)(plan, f_all[k], shcs_out, err);
+        CHARM(err_handler)(err, 1);
+
+
+        CHARM(sha_point)(pnt, f_all[k], nmax, shcs_ref, err);
+        CHARM(err_handler)(err, 1);
+
+
+        e += cmp_arrays(shcs_out->c[0], shcs_ref->c[0], shcs_ref->nc,
+                        PREC(10.0) * CHARM(glob_threshold));
+        e += cmp_arrays(shcs_out->s[0], shcs_ref->s[0], shcs_ref->ns,
+                        PREC(10.0) * CHARM(glob_threshold));
+
+
+        CHARM(shc_free)(shcs_out);
+        CHARM(shc_free)(shcs_ref);
+    }
+
+
+    CHARM(sha_plan_free)(plan);
+    free(f);
+    free(f2);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_sha_plan(void)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_read_mtx)(SHCS_IN_PATH_POT_MTX, SHCS_NMAX_POT, shcs, err);
+    CHARM(err_handler)(err, 1);
+    modify_low_degree_coefficients(shcs);
+
+
+    /* Coefficients of another signal */
+    CHARM(shc) *shcs2 = CHARM(shc_copy)(shcs, 0, shcs->nmax, shcs->nmax);
+    if (shcs2 == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_rescale)(shcs2, shcs2->mu * SHCS_RESCALE_MU_FACTOR,
+                       shcs2->r * SHCS_RESCALE_R_FACTOR, err);
+    CHARM(err_handler)(err, 1);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    long int e = 0;
+    CHARM(point) *pnt = NULL;
+
+
+    /* Quadrature grids */
+    /* --------------------------------------------------------------------- */
+    {
+    int grd_types[3] = {CHARM_CRD_POINT_GRID_GL,
+                        CHARM_CRD_POINT_GRID_DH1,
+                        CHARM_CRD_POINT_GRID_DH2};
+
+
+    for (int g = 0; g < 3; g++)
+    {
+        for (unsigned long nmax = 0; nmax <= SHCS_NMAX_POT; nmax++)
+        {
+            REAL r = shcs->r + (REAL)(DELTAR);
+
+
+            if (grd_types[g] == CHARM_CRD_POINT_GRID_GL)
+                pnt = CHARM(crd_point_gl)(nmax, r);
+            else if (grd_types[g] == CHARM_CRD_POINT_GRID_DH1)
+                pnt = CHARM(crd_point_dh1)(nmax, r);
+            else
+                pnt = CHARM(crd_point_dh2)(nmax, r);
+            if (pnt == NULL)
+            {
+                fprintf(stderr, "%s", ERR_MSG_POINT);
+                exit(CHARM_FAILURE);
+            }
+
+
+            e += check_plan(pnt, shcs, shcs2, nmax, CHARM_SHA_PLAN_ESTIMATE,
+                            err);
+
+
+            CHARM(crd_point_free)(pnt);
+        }
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Other planning flags */
+    /* --------------------------------------------------------------------- */
+    {
+    int flags[2] = {CHARM_SHA_PLAN_MEASURE, CHARM_SHA_PLAN_PATIENT};
+
+
+    pnt = CHARM(crd_point_dh1)(SHCS_NMAX_POT, shcs->r + (REAL)(DELTAR));
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    for (size_t i = 0; i < 2; i++)
+        e += check_plan(pnt, shcs, shcs2, SHCS_NMAX_POT, flags[i], err);
+
+
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Invalid input */
+    /* --------------------------------------------------------------------- */
+    {
+    pnt = CHARM(crd_point_gl)(NMAX, shcs->r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Wrong planning flag */
+    CHARM(sha_plan) *plan = CHARM(sha_plan_init)(pnt, NMAX, 9999, err);
+    if ((plan != NULL) || CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Wrong planning flag didn't "
+               "produce an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    /* "nmax" larger than the maximum degree of the grid */
+    plan = CHARM(sha_plan_init)(pnt, NMAX + 1, CHARM_SHA_PLAN_ESTIMATE, err);
+    if ((plan != NULL) || CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too large \"nmax\" of the plan didn't "
+               "produce an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    /* "nmax" of the plan larger than "shcs_out->nmax" */
+    plan = CHARM(sha_plan_init)(pnt, NMAX, CHARM_SHA_PLAN_ESTIMATE, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(shc) *shcs_out = CHARM(shc_calloc)(NMAX - 1, shcs->mu, shcs->r);
+    if (shcs_out == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    REAL *f = (REAL *)calloc(pnt->npoint, sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(sha_plan_execute)(plan, f, shcs_out, err);
+    if (CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too large \"nmax\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    free(f);
+    CHARM(shc_free)(shcs_out);
+    CHARM(sha_plan_free)(plan);
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(shc_free)(shcs);
+    CHARM(shc_free)(shcs2);
+    CHARM(err_free)(err);
+
+
+    return e;
+    /* --------------------------------------------------------------------- */
+}
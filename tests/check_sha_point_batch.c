@@ -0,0 +1,271 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/prec.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "cmp_arrays.h"
+#include "modify_low_degree_coefficients.h"
+#include "check_sha_point_batch.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Maximum number of signals analysed at once */
+#undef NSIGNAL
+#define NSIGNAL (3)
+
+
+
+
+
+
+/* Analyses "nsignals" signals synthesized from "shcs" and "shcs2" at the
+ * quadrature grid "pnt" with "CHARM(sha_point_batch)" and compares the results
+ * with those from "CHARM(sha_point)" */
+static long int check_batch(const CHARM(point) *pnt,
+                            const CHARM(shc) *shcs,
+                            const CHARM(shc) *shcs2,
+                            size_t nsignals,
+                            unsigned long nmax,
+                            CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    REAL *f  = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    REAL *f2 = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if ((f == NULL) || (f2 == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_point)(pnt, shcs, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(shs_point)(pnt, shcs2, nmax, f2, err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* Output coefficients are alternately scaled to "shcs->r" and to the
+     * radius of "pnt" and have different "mu", so that the normalization and
+     * the rescaling of each signal are checked, too */
+    REAL *f_all[NSIGNAL]  = {f, f2, f};
+    REAL r_all[NSIGNAL]   = {shcs->r, pnt->r[0], pnt->r[0]};
+    REAL mu_all[NSIGNAL]  = {shcs->mu, shcs->mu, PREC(2.0) * shcs->mu};
+    CHARM(shc) *shcs_out[NSIGNAL];
+    for (size_t k = 0; k < nsignals; k++)
+    {
+        shcs_out[k] = CHARM(shc_calloc)(nmax, mu_all[k], r_all[k]);
+        if (shcs_out[k] == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+    }
+
+
+    CHARM(sha_point_batch)(pnt, f_all, nsignals, nmax, shcs_out, err);
+    CHARM(err_handler)(err, 1);
+
+
+    for (size_t k = 0; k < nsignals; k++)
+    {
+        CHARM(shc) *shcs_ref = CHARM(shc_calloc)(nmax, mu_all[k], r_all[k]);
+        if (shcs_ref == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+
+
+        CHARM(sha_point)(pnt, f_all[k], nmax, shcs_ref, err);
+        CHARM(err_handler)(err, 1);
+
+
+        /* The batched FFT may use a different FFTW algorithm than
+         * "CHARM(sha_point)", so small coefficients may differ slightly more
+         * than with "CHARM(glob_threshold)" */
+        e += cmp_arrays(shcs_out[k]->c[0], shcs_ref->c[0], shcs_ref->nc,
+                        CHARM(glob_threshold2));
+        e += cmp_arrays(shcs_out[k]->s[0], shcs_ref->s[0], shcs_ref->ns,
+                        CHARM(glob_threshold2));
+
+
+        CHARM(shc_free)(shcs_ref);
+        CHARM(shc_free)(shcs_out[k]);
+    }
+
+
+    free(f);
+    free(f2);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_sha_point_batch(void)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_read_mtx)(SHCS_IN_PATH_POT_MTX, SHCS_NMAX_POT, shcs, err);
+    CHARM(err_handler)(err, 1);
+    modify_low_degree_coefficients(shcs);
+
+
+    /* Coefficients of another signal */
+    CHARM(shc) *shcs2 = CHARM(shc_copy)(shcs, 0, shcs->nmax, shcs->nmax);
+    if (shcs2 == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_rescale)(shcs2, shcs2->mu * SHCS_RESCALE_MU_FACTOR,
+                       shcs2->r * SHCS_RESCALE_R_FACTOR, err);
+    CHARM(err_handler)(err, 1);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    long int e = 0;
+    CHARM(point) *pnt = NULL;
+
+
+    /* Quadrature grids */
+    /* --------------------------------------------------------------------- */
+    {
+    int grd_types[3] = {CHARM_CRD_POINT_GRID_GL,
+                        CHARM_CRD_POINT_GRID_DH1,
+                        CHARM_CRD_POINT_GRID_DH2};
+
+
+    for (int g = 0; g < 3; g++)
+    {
+        for (unsigned long nmax = 0; nmax <= SHCS_NMAX_POT; nmax++)
+        {
+            REAL r = shcs->r + (REAL)(DELTAR);
+
+
+            if (grd_types[g] == CHARM_CRD_POINT_GRID_GL)
+                pnt = CHARM(crd_point_gl)(nmax, r);
+            else if (grd_types[g] == CHARM_CRD_POINT_GRID_DH1)
+                pnt = CHARM(crd_point_dh1)(nmax, r);
+            else
+                pnt = CHARM(crd_point_dh2)(nmax, r);
+            if (pnt == NULL)
+            {
+                fprintf(stderr, "%s", ERR_MSG_POINT);
+                exit(CHARM_FAILURE);
+            }
+
+
+            for (size_t nsignals = 0; nsignals <= NSIGNAL; nsignals++)
+                e += check_batch(pnt, shcs, shcs2, nsignals, nmax, err);
+
+
+            CHARM(crd_point_free)(pnt);
+        }
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Invalid input */
+    /* --------------------------------------------------------------------- */
+    {
+    pnt = CHARM(crd_point_gl)(NMAX, shcs->r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    REAL *f = (REAL *)calloc(pnt->npoint, sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc) *shcs_out  = CHARM(shc_calloc)(NMAX, shcs->mu, shcs->r);
+    CHARM(shc) *shcs_out2 = CHARM(shc_calloc)(NMAX - 1, shcs->mu, shcs->r);
+    if ((shcs_out == NULL) || (shcs_out2 == NULL))
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* "nmax" larger than "nmax" of one of the output structures */
+    REAL *f_all[2]          = {f, f};
+    CHARM(shc) *shcs_all[2] = {shcs_out, shcs_out2};
+    CHARM(sha_point_batch)(pnt, f_all, 2, NMAX, shcs_all, err);
+    if (CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too large \"nmax\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    free(f);
+    CHARM(shc_free)(shcs_out);
+    CHARM(shc_free)(shcs_out2);
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(shc_free)(shcs);
+    CHARM(shc_free)(shcs2);
+    CHARM(err_free)(err);
+
+
+    return e;
+    /* --------------------------------------------------------------------- */
+}
@@ -0,0 +1,25 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __CHECK_SHA_POINT_BATCH_H__
+#define __CHECK_SHA_POINT_BATCH_H__
+
+
+#include <config.h>
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern long int check_sha_point_batch(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,298 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../src/prec.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "cmp_arrays.h"
+#include "modify_low_degree_coefficients.h"
+#include "check_sha_point_table.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Analyses the signal synthesized from "shcs" at the quadrature grid "pnt"
+ * with "CHARM(sha_point_table)" and compares the results with those from
+ * "CHARM(sha_point)".  If "single" is "1", the Legendre functions are
+ * tabulated in single precision and the maximum absolute difference is
+ * compared with the maximum absolute value of the reference coefficients. */
+static long int check_table(const CHARM(point) *pnt,
+                            const CHARM(shc) *shcs,
+                            unsigned long nmax,
+                            _Bool single,
+                            CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    REAL *f = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_point)(pnt, shcs, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(leg_table) *table = CHARM(leg_table_init)(pnt, nmax, 0, single, 0,
+                                                    err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* The output coefficients are scaled to "shcs->r" and to the radius of
+     * "pnt", so that the rescaling is checked, too */
+    REAL r_all[2] = {shcs->r, pnt->r[0]};
+    for (int k = 0; k < 2; k++)
+    {
+        CHARM(shc) *shcs_out = CHARM(shc_calloc)(nmax, shcs->mu, r_all[k]);
+        CHARM(shc) *shcs_ref = CHARM(shc_calloc)(nmax, shcs->mu, r_all[k]);
+        if ((shcs_out == NULL) || (shcs_ref == NULL))
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+
+
+        CHARM(sha_point_table)(table, f, nmax, shcs_out, err);
+        CHARM(err_handler)(err, 1);
+
+
+        CHARM(sha_point)(pnt, f, nmax, shcs_ref, err);
+        CHARM(err_handler)(err, 1);
+
+
+        if (!single)
+        {
+            e += cmp_arrays(shcs_out->c[0], shcs_ref->c[0], shcs_ref->nc,
+                            CHARM(glob_threshold2));
+            e += cmp_arrays(shcs_out->s[0], shcs_ref->s[0], shcs_ref->ns,
+                            CHARM(glob_threshold2));
+        }
+        else
+        {
+            REAL dmax = PREC(0.0);
+            REAL cmax = PREC(0.0);
+            for (size_t i = 0; i < shcs_ref->nc; i++)
+            {
+                dmax = CHARM_MAX(dmax, FABS(shcs_out->c[0][i] -
+                                            shcs_ref->c[0][i]));
+                cmax = CHARM_MAX(cmax, FABS(shcs_ref->c[0][i]));
+            }
+            for (size_t i = 0; i < shcs_ref->ns; i++)
+                dmax = CHARM_MAX(dmax, FABS(shcs_out->s[0][i] -
+                                            shcs_ref->s[0][i]));
+
+
+            if (dmax > PREC(1e-5) * cmax)
+            {
+                printf("\n        WARNING: Analysis with the single "
+                       "precision table is not accurate enough!\n");
+                e += 1;
+            }
+        }
+
+
+        CHARM(shc_free)(shcs_out);
+        CHARM(shc_free)(shcs_ref);
+    }
+
+
+    CHARM(leg_table_free)(table);
+    free(f);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_sha_point_table(void)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_read_mtx)(SHCS_IN_PATH_POT_MTX, SHCS_NMAX_POT, shcs, err);
+    CHARM(err_handler)(err, 1);
+    modify_low_degree_coefficients(shcs);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    long int e = 0;
+    CHARM(point) *pnt = NULL;
+
+
+    /* Quadrature grids */
+    /* --------------------------------------------------------------------- */
+    {
+    int grd_types[3] = {CHARM_CRD_POINT_GRID_GL,
+                        CHARM_CRD_POINT_GRID_DH1,
+                        CHARM_CRD_POINT_GRID_DH2};
+
+
+    for (int g = 0; g < 3; g++)
+    {
+        for (unsigned long nmax = 0; nmax <= SHCS_NMAX_POT; nmax++)
+        {
+            REAL r = shcs->r + (REAL)(DELTAR);
+
+
+            if (grd_types[g] == CHARM_CRD_POINT_GRID_GL)
+                pnt = CHARM(crd_point_gl)(nmax, r);
+            else if (grd_types[g] == CHARM_CRD_POINT_GRID_DH1)
+                pnt = CHARM(crd_point_dh1)(nmax, r);
+            else
+                pnt = CHARM(crd_point_dh2)(nmax, r);
+            if (pnt == NULL)
+            {
+                fprintf(stderr, "%s", ERR_MSG_POINT);
+                exit(CHARM_FAILURE);
+            }
+
+
+            e += check_table(pnt, shcs, nmax, 0, err);
+            if (nmax == SHCS_NMAX_POT)
+                e += check_table(pnt, shcs, nmax, 1, err);
+
+
+            CHARM(crd_point_free)(pnt);
+        }
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Invalid input */
+    /* --------------------------------------------------------------------- */
+    {
+    REAL *f = NULL;
+    CHARM(shc) *shcs_out = CHARM(shc_calloc)(NMAX, shcs->mu, shcs->r);
+    if (shcs_out == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* "nmax" larger than "nmax" of the table */
+    pnt = CHARM(crd_point_gl)(NMAX, shcs->r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    f = (REAL *)calloc(pnt->npoint, sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(leg_table) *table = CHARM(leg_table_init)(pnt, NMAX - 1, 0, 0, 0,
+                                                    err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(sha_point_table)(table, f, NMAX, shcs_out, err);
+    if (CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too large \"nmax\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    CHARM(leg_table_free)(table);
+    CHARM(crd_point_free)(pnt);
+    free(f);
+
+
+    /* Table of a custom grid */
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, NMAX + 1,
+                                  2 * NMAX + 2);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    f = (REAL *)calloc(pnt->npoint, sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    table = CHARM(leg_table_init)(pnt, NMAX, 0, 0, 0, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(sha_point_table)(table, f, NMAX, shcs_out, err);
+    if (CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Table of a custom grid didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    CHARM(leg_table_free)(table);
+    CHARM(crd_point_free)(pnt);
+    CHARM(shc_free)(shcs_out);
+    free(f);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(shc_free)(shcs);
+    CHARM(err_free)(err);
+
+
+    return e;
+    /* --------------------------------------------------------------------- */
+}
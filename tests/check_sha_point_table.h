@@ -0,0 +1,25 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __CHECK_SHA_POINT_TABLE_H__
+#define __CHECK_SHA_POINT_TABLE_H__
+
+
+#include <config.h>
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern long int check_sha_point_table(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,403 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../src/prec.h"
+#include "cmp_vals.h"
+#include "cmp_arrays.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "generate_point.h"
+#include "check_shc_binz.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Compares "shcs" with "shcs_ref" up to the maximum degree of "shcs_ref".  The
+ * compression is lossless, so the coefficients must be equal. */
+static long int cmp_shcs(const CHARM(shc) *shcs_ref,
+                         const CHARM(shc) *shcs)
+{
+    long int e = 0;
+
+
+    e += cmp_vals_real(shcs->mu, shcs_ref->mu, PREC(0.0));
+    e += cmp_vals_real(shcs->r, shcs_ref->r, PREC(0.0));
+    for (unsigned long m = 0; m <= shcs_ref->nmax; m++)
+    {
+        e += cmp_arrays(shcs->c[m], shcs_ref->c[m], shcs_ref->nmax + 1 - m,
+                        PREC(0.0));
+        e += cmp_arrays(shcs->s[m], shcs_ref->s[m], shcs_ref->nmax + 1 - m,
+                        PREC(0.0));
+    }
+
+
+    return e;
+}
+
+
+
+
+
+
+/* Returns the size of "pathname" in bytes */
+static long size_of_file(const char *pathname)
+{
+    FILE *fptr = fopen(pathname, "rb");
+    if (fptr == NULL)
+    {
+        fprintf(stderr, "Failed to open \"%s\".\n", pathname);
+        exit(CHARM_FAILURE);
+    }
+    fseek(fptr, 0, SEEK_END);
+    long size = ftell(fptr);
+    fclose(fptr);
+
+
+    return size;
+}
+
+
+
+
+
+
+/* Copies "SHCS_OUT_PATH_POT_BINZ" to "SHCS_OUT_PATH_POT_BINZ_CORRUPT" and
+ * flips one bit of the compressed coefficients */
+static void write_corrupted(void)
+{
+    FILE *fptr = fopen(SHCS_OUT_PATH_POT_BINZ, "rb");
+    if (fptr == NULL)
+    {
+        fprintf(stderr, "Failed to open \"%s\".\n", SHCS_OUT_PATH_POT_BINZ);
+        exit(CHARM_FAILURE);
+    }
+    fseek(fptr, 0, SEEK_END);
+    size_t size = (size_t)ftell(fptr);
+    rewind(fptr);
+    unsigned char *buf = (unsigned char *)malloc(size);
+    if (buf == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+    if (fread(buf, sizeof(unsigned char), size, fptr) != size)
+    {
+        fprintf(stderr, "Failed to read \"%s\".\n", SHCS_OUT_PATH_POT_BINZ);
+        exit(CHARM_FAILURE);
+    }
+    fclose(fptr);
+
+
+    /* The first bytes after the header of 128 bytes belong to the compressed
+     * order "m = 0" */
+    buf[128 + 4] ^= 0x10;
+
+
+    fptr = fopen(SHCS_OUT_PATH_POT_BINZ_CORRUPT, "wb");
+    if ((fptr == NULL) ||
+        (fwrite(buf, sizeof(unsigned char), size, fptr) != size))
+    {
+        fprintf(stderr, "Failed to write \"%s\".\n",
+                SHCS_OUT_PATH_POT_BINZ_CORRUPT);
+        exit(CHARM_FAILURE);
+    }
+    fclose(fptr);
+    free(buf);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Returns a model of degree "nmax" with pseudo-random coefficients decaying
+ * with the harmonic degree.  Some orders are set to zero to check also the
+ * compression of zero rows. */
+static CHARM(shc) *random_shcs(unsigned long nmax)
+{
+    CHARM(shc) *shcs = CHARM(shc_calloc)(nmax, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    uint32_t state = 12345;
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        if (m % 17 == 5)
+            continue;
+
+
+        for (unsigned long n = m; n <= nmax; n++)
+        {
+            state = state * 1103515245U + 12345U;
+            REAL x = (REAL)(state >> 8) / (REAL)(1U << 24) - PREC(0.5);
+            REAL scale = PREC(1.0) / ((REAL)(n + 1) * (REAL)(n + 1));
+            shcs->c[m][n - m] = x * scale;
+
+
+            state = state * 1103515245U + 12345U;
+            x = (REAL)(state >> 8) / (REAL)(1U << 24) - PREC(0.5);
+            shcs->s[m][n - m] = (m == 0) ? PREC(0.0) : x * scale;
+        }
+    }
+
+
+    return shcs;
+}
+
+
+
+
+
+
+/* Synthesizes "shcs" and "shcs_ref" at "pnt" up to degree "nmax" and compares
+ * the results */
+static long int check_synthesis(const CHARM(point) *pnt,
+                                const CHARM(shc) *shcs,
+                                const CHARM(shc) *shcs_ref,
+                                unsigned long nmax,
+                                CHARM(err) *err)
+{
+    REAL *f    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    REAL *fref = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if ((f == NULL) || (fref == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_point)(pnt, shcs, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shs_point)(pnt, shcs_ref, nmax, fref, err);
+    CHARM(err_handler)(err, 1);
+
+
+    long int e = cmp_arrays(f, fref, pnt->npoint,
+                            PREC(10.0) * CHARM(glob_threshold));
+
+
+    free(f);
+    free(fref);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_shc_binz(void)
+{
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+
+
+    /* Write the reference "gfc" file to the compressed binary file and read
+     * it back */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc) *shcs_ref = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0),
+                                             PREC(1.0));
+    if (shcs_ref == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc_read_gfc)(SHCS_IN_PATH_POT_GFC, SHCS_NMAX_POT, NULL, shcs_ref,
+                        err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(shc_write_binz)(shcs_ref, SHCS_NMAX_POT, SHCS_OUT_PATH_POT_BINZ,
+                          err);
+    CHARM(err_handler)(err, 1);
+
+
+    unsigned long nmax_file = CHARM(shc_read_binz)(SHCS_OUT_PATH_POT_BINZ,
+                                                   CHARM_SHC_NMAX_MODEL,
+                                                   NULL, err);
+    CHARM(err_handler)(err, 1);
+    e += cmp_vals_ulong(nmax_file, SHCS_NMAX_POT);
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0),
+                                         PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc_read_binz)(SHCS_OUT_PATH_POT_BINZ, SHCS_NMAX_POT, shcs, err);
+    CHARM(err_handler)(err, 1);
+    e += cmp_shcs(shcs_ref, shcs);
+    CHARM(shc_free)(shcs);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Read the coefficients up to a lower degree to a structure of a higher
+     * degree.  The remaining coefficients must be zero. */
+    /* --------------------------------------------------------------------- */
+    unsigned long nmax = SHCS_NMAX_POT / 2;
+    shcs = CHARM(shc_malloc)(SHCS_NMAX_POT + 3, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc_read_binz)(SHCS_OUT_PATH_POT_BINZ, nmax, shcs, err);
+    CHARM(err_handler)(err, 1);
+    for (unsigned long m = 0; m <= shcs->nmax; m++)
+    {
+        for (unsigned long n = m; n <= shcs->nmax; n++)
+        {
+            REAL cref = (n <= nmax) ? shcs_ref->c[m][n - m] : PREC(0.0);
+            REAL sref = (n <= nmax) ? shcs_ref->s[m][n - m] : PREC(0.0);
+            e += cmp_vals_real(shcs->c[m][n - m], cref, PREC(0.0));
+            e += cmp_vals_real(shcs->s[m][n - m], sref, PREC(0.0));
+        }
+    }
+    CHARM(shc_free)(shcs);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Corrupted and non-existing files */
+    /* --------------------------------------------------------------------- */
+    write_corrupted();
+    shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc_read_binz)(SHCS_OUT_PATH_POT_BINZ_CORRUPT, SHCS_NMAX_POT, shcs,
+                         err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+    CHARM(shc_free)(shcs);
+
+
+    shcs = CHARM(shc_open_binz)(SHCS_OUT_PATH_POT_BINZ ".none", err);
+    e += ((shcs != NULL) || CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+    CHARM(shc_free)(shcs);
+    CHARM(shc_free)(shcs_ref);
+    /* --------------------------------------------------------------------- */
+
+
+    /* A model of a higher degree, so that the orders are decompressed by
+     * several blocks during the synthesis */
+    /* --------------------------------------------------------------------- */
+    shcs_ref = random_shcs(SHCS_NMAX_BINZ);
+    CHARM(shc_write_binz)(shcs_ref, SHCS_NMAX_BINZ, SHCS_OUT_PATH_RAND_BINZ,
+                          err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shc_write_bin)(shcs_ref, SHCS_NMAX_BINZ, SHCS_OUT_PATH_RAND_BIN,
+                         err);
+    CHARM(err_handler)(err, 1);
+    e += (size_of_file(SHCS_OUT_PATH_RAND_BINZ) >=
+          size_of_file(SHCS_OUT_PATH_RAND_BIN)) ? 1 : 0;
+
+
+    shcs = CHARM(shc_open_binz)(SHCS_OUT_PATH_RAND_BINZ, err);
+    CHARM(err_handler)(err, 1);
+    e += cmp_vals_ulong(shcs->nmax, SHCS_NMAX_BINZ);
+    e += ((shcs->c != NULL) || (shcs->s != NULL)) ? 1 : 0;
+
+
+    CHARM(point) *pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_SCATTERED, 23,
+                                                23);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs_ref->r + (REAL)(DELTAR), PI,
+                          PREC(2.0) * PI);
+    e += check_synthesis(pnt, shcs, shcs_ref, SHCS_NMAX_BINZ, err);
+    e += check_synthesis(pnt, shcs, shcs_ref, SHCS_NMAX_BINZ / 3, err);
+    CHARM(crd_point_free)(pnt);
+
+
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 9, 17);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs_ref->r, PI, PREC(2.0) * PI);
+    e += check_synthesis(pnt, shcs, shcs_ref, SHCS_NMAX_BINZ, err);
+    e += check_synthesis(pnt, shcs, shcs_ref, SHCS_NMAX_BINZ / 3, err);
+    CHARM(crd_point_free)(pnt);
+
+
+    /* The coefficients of "shcs" are not stored in the memory, so functions
+     * accessing them directly must fail */
+    CHARM(shc_write_bin)(shcs, SHCS_NMAX_BINZ, SHCS_OUT_PATH_RAND_BIN, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shc_rescale)(shcs, PREC(2.0), PREC(2.0), err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    pnt = CHARM(crd_point_gl)(SHCS_NMAX_BINZ, shcs_ref->r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    REAL *f = (REAL *)calloc(pnt->npoint, sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+    CHARM(sha_plan) *plan = CHARM(sha_plan_init)(pnt, SHCS_NMAX_BINZ,
+                                                 CHARM_SHA_PLAN_ESTIMATE,
+                                                 err);
+    CHARM(err_handler)(err, 1);
+    CHARM(sha_plan_execute)(plan, f, shcs, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+    CHARM(sha_point)(pnt, f, SHCS_NMAX_BINZ, shcs, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+    CHARM(sha_plan_free)(plan);
+    CHARM(crd_point_free)(pnt);
+    free(f);
+
+
+    CHARM(shc_free)(shcs);
+    CHARM(shc_free)(shcs_ref);
+    /* --------------------------------------------------------------------- */
+
+
+    CHARM(err_free)(err);
+
+
+    return e;
+}
@@ -3,6 +3,10 @@
 #include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
 #include "../src/prec.h"
 #include "cmp_arrays.h"
 #include "parameters.h"
@@ -15,6 +19,107 @@
 
 
 
+#if HAVE_OPENMP
+/* Returns a model of degree "nmax" with pseudo-random coefficients decaying
+ * with the harmonic degree.  "seed" initializes the generator. */
+static CHARM(shc) *random_shcs(unsigned long nmax,
+                               uint32_t seed)
+{
+    CHARM(shc) *shcs = CHARM(shc_calloc)(nmax, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    uint32_t state = seed;
+    for (unsigned long m = 0; m <= nmax; m++)
+    {
+        for (unsigned long n = m; n <= nmax; n++)
+        {
+            state = state * 1103515245U + 12345U;
+            REAL x = (REAL)(state >> 8) / (REAL)(1U << 24) - PREC(0.5);
+            REAL scale = PREC(1.0) / (REAL)(n + 1);
+            shcs->c[m][n - m] = x * scale;
+
+
+            state = state * 1103515245U + 12345U;
+            x = (REAL)(state >> 8) / (REAL)(1U << 24) - PREC(0.5);
+            shcs->s[m][n - m] = (m == 0) ? PREC(0.0) : x * scale;
+        }
+    }
+
+
+    return shcs;
+}
+
+
+/* Checks that "shc_ddav" and the corresponding "shc_dav" return bitwise
+ * identical results with different numbers of threads */
+static long int check_threads(void (*shc_ddav)(const CHARM(shc) *,
+                                               const CHARM(shc) *,
+                                               unsigned long,
+                                               REAL *,
+                                               CHARM(err) *),
+                              CHARM(err) *err)
+{
+    void (*shc_dav)(const CHARM(shc) *, unsigned long, REAL *,
+                    CHARM(err) *) = (shc_ddav == CHARM(shc_ddv)) ?
+                                    CHARM(shc_dv) : CHARM(shc_da);
+
+
+    CHARM(shc) *shcs1 = random_shcs(SHCS_NMAX_THREADS, 12345);
+    CHARM(shc) *shcs2 = random_shcs(SHCS_NMAX_THREADS, 54321);
+
+
+    const size_t n = SHCS_NMAX_THREADS + 1;
+    REAL *f    = (REAL *)malloc(4 * n * sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+    REAL *fref  = f + n;
+    REAL *f2    = fref + n;
+    REAL *f2ref = f2 + n;
+
+
+    long int e = 0;
+    int nthreads = omp_get_max_threads();
+    const int nthreads_test[3] = {1, 3, 7};
+    for (int t = 0; t < 3; t++)
+    {
+        omp_set_num_threads(nthreads_test[t]);
+        shc_ddav(shcs1, shcs2, SHCS_NMAX_THREADS, (t == 0) ? fref : f, err);
+        CHARM(err_handler)(err, 1);
+        shc_dav(shcs1, SHCS_NMAX_THREADS, (t == 0) ? f2ref : f2, err);
+        CHARM(err_handler)(err, 1);
+
+
+        if (t > 0)
+        {
+            e += cmp_arrays(f, fref, n, PREC(0.0));
+            e += cmp_arrays(f2, f2ref, n, PREC(0.0));
+        }
+    }
+    omp_set_num_threads(nthreads);
+
+
+    free(f);
+    CHARM(shc_free)(shcs1);
+    CHARM(shc_free)(shcs2);
+
+
+    return e;
+}
+#endif
+
+
+
+
+
+
 long int check_shc_ddav(void (*shc_ddav)(const CHARM(shc) *,
                                          const CHARM(shc) *,
                                          unsigned long,
@@ -70,6 +175,11 @@ long int check_shc_ddav(void (*shc_ddav)(const CHARM(shc) *,
     }
 
 
+#if HAVE_OPENMP
+    e += check_threads(shc_ddav, err);
+#endif
+
+
     CHARM(err_free)(err);
     CHARM(shc_free)(shcs);
     free(fref);
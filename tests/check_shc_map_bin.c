@@ -0,0 +1,326 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../src/prec.h"
+#include "../src/misc/misc_crc32.h"
+#include "../src/misc/misc_swap_bytes.h"
+#include "../src/shc/shc_bin.h"
+#include "cmp_vals.h"
+#include "cmp_arrays.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "check_shc_map_bin.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Compares "shcs" with "shcs_ref" up to the maximum degree of "shcs_ref" */
+static long int cmp_shcs(const CHARM(shc) *shcs_ref,
+                         const CHARM(shc) *shcs)
+{
+    long int e = 0;
+
+
+    e += cmp_vals_ulong(shcs->nmax, shcs_ref->nmax);
+    e += cmp_vals_real(shcs->mu, shcs_ref->mu,
+                       PREC(10.0) * CHARM(glob_threshold));
+    e += cmp_vals_real(shcs->r, shcs_ref->r,
+                       PREC(10.0) * CHARM(glob_threshold));
+    e += cmp_arrays(shcs->c[0], shcs_ref->c[0], shcs_ref->nc,
+                    PREC(10.0) * CHARM(glob_threshold));
+    e += cmp_arrays(shcs->s[0], shcs_ref->s[0], shcs_ref->ns,
+                    PREC(10.0) * CHARM(glob_threshold));
+
+
+    return e;
+}
+
+
+
+
+
+
+/* Reads "SHCS_OUT_PATH_POT_BIN", reverses the byte order of all its header
+ * fields, coefficients and index entries and writes the result to
+ * "SHCS_OUT_PATH_POT_BIN_SWAP", as if the file was written on a machine with
+ * the opposite byte order. */
+static void write_swapped(void)
+{
+    FILE *fptr = fopen(SHCS_OUT_PATH_POT_BIN, "rb");
+    if (fptr == NULL)
+    {
+        fprintf(stderr, "Failed to open \"%s\".\n", SHCS_OUT_PATH_POT_BIN);
+        exit(CHARM_FAILURE);
+    }
+    fseek(fptr, 0, SEEK_END);
+    size_t size = (size_t)ftell(fptr);
+    rewind(fptr);
+    unsigned char *buf = (unsigned char *)malloc(size);
+    if (buf == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+    if (fread(buf, sizeof(unsigned char), size, fptr) != size)
+    {
+        fprintf(stderr, "Failed to read \"%s\".\n", SHCS_OUT_PATH_POT_BIN);
+        exit(CHARM_FAILURE);
+    }
+    fclose(fptr);
+
+
+    uint64_t nmax, offset_c, offset_s, offset_idx;
+    memcpy(&nmax,       buf + 32, sizeof(uint64_t));
+    memcpy(&offset_c,   buf + 40, sizeof(uint64_t));
+    memcpy(&offset_s,   buf + 48, sizeof(uint64_t));
+    memcpy(&offset_idx, buf + 56, sizeof(uint64_t));
+    size_t ncs = (size_t)(((nmax + 2) * (nmax + 1)) / 2);
+
+
+    /* Version, byte order mark, precision, size of "REAL", alignment,
+     * flags */
+    CHARM(misc_swap_bytes)(buf + 8,  sizeof(uint32_t), 6);
+    /* Maximum degree and the offsets of the coefficients and of the index */
+    CHARM(misc_swap_bytes)(buf + 32, sizeof(uint64_t), 4);
+    /* "mu" and "r" */
+    CHARM(misc_swap_bytes)(buf + 64, sizeof(REAL), 1);
+    CHARM(misc_swap_bytes)(buf + 80, sizeof(REAL), 1);
+    /* Coefficients */
+    CHARM(misc_swap_bytes)(buf + offset_c, sizeof(REAL), ncs);
+    CHARM(misc_swap_bytes)(buf + offset_s, sizeof(REAL), ncs);
+
+
+    /* The index.  The checksums are computed from the bytes stored in the
+     * file, so they have to be computed again. */
+    for (uint64_t m = 0; m <= nmax; m++)
+    {
+        unsigned char *entry = buf + offset_idx + m * SHC_BIN_INDEX_ENTRY;
+        uint64_t offset_cm, offset_sm;
+        memcpy(&offset_cm, entry,     sizeof(uint64_t));
+        memcpy(&offset_sm, entry + 8, sizeof(uint64_t));
+        uint32_t crc_c = CHARM(misc_crc32)(0, buf + offset_cm,
+                                           (nmax + 1 - m) * sizeof(REAL));
+        uint32_t crc_s = CHARM(misc_crc32)(0, buf + offset_sm,
+                                           (nmax + 1 - m) * sizeof(REAL));
+        memcpy(entry + 16, &crc_c, sizeof(uint32_t));
+        memcpy(entry + 20, &crc_s, sizeof(uint32_t));
+        CHARM(misc_swap_bytes)(entry, sizeof(uint64_t), 2);
+        CHARM(misc_swap_bytes)(entry + 16, sizeof(uint32_t), 2);
+    }
+
+
+    fptr = fopen(SHCS_OUT_PATH_POT_BIN_SWAP, "wb");
+    if ((fptr == NULL) ||
+        (fwrite(buf, sizeof(unsigned char), size, fptr) != size))
+    {
+        fprintf(stderr, "Failed to write \"%s\".\n",
+                SHCS_OUT_PATH_POT_BIN_SWAP);
+        exit(CHARM_FAILURE);
+    }
+    fclose(fptr);
+    free(buf);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Writes "shcs" to "SHCS_OUT_PATH_POT_BIN_LEGACY" in the format of binary
+ * files from CHarm 0.4.8 and older (no header) */
+static void write_legacy(const CHARM(shc) *shcs)
+{
+    FILE *fptr = fopen(SHCS_OUT_PATH_POT_BIN_LEGACY, "wb");
+    if ((fptr == NULL) ||
+        (fwrite(&shcs->nmax, sizeof(unsigned long), 1, fptr) != 1) ||
+        (fwrite(&shcs->mu, sizeof(REAL), 1, fptr) != 1) ||
+        (fwrite(&shcs->r, sizeof(REAL), 1, fptr) != 1) ||
+        (fwrite(shcs->c[0], sizeof(REAL), shcs->nc, fptr) != shcs->nc) ||
+        (fwrite(shcs->s[0], sizeof(REAL), shcs->ns, fptr) != shcs->ns))
+    {
+        fprintf(stderr, "Failed to write \"%s\".\n",
+                SHCS_OUT_PATH_POT_BIN_LEGACY);
+        exit(CHARM_FAILURE);
+    }
+    fclose(fptr);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Reads "pathname" by "shc_read_bin" and compares the coefficients with
+ * "shcs_ref" */
+static long int check_read_bin(const char *pathname,
+                               const CHARM(shc) *shcs_ref,
+                               CHARM(err) *err)
+{
+    CHARM(shc) *shcs = CHARM(shc_calloc)(shcs_ref->nmax, PREC(1.0),
+                                         PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+    unsigned long nmax = CHARM(shc_read_bin)(pathname, CHARM_SHC_NMAX_MODEL,
+                                             NULL, err);
+    CHARM(err_handler)(err, 1);
+    e += cmp_vals_ulong(nmax, shcs_ref->nmax);
+
+
+    CHARM(shc_read_bin)(pathname, shcs_ref->nmax, shcs, err);
+    CHARM(err_handler)(err, 1);
+    e += cmp_shcs(shcs_ref, shcs);
+
+
+    CHARM(shc_free)(shcs);
+
+
+    return e;
+}
+
+
+
+
+
+
+/* Checks that "shc_map_bin" refuses to map "pathname" */
+static long int check_map_bin_fails(const char *pathname,
+                                    CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    CHARM(shc) *shcs = CHARM(shc_map_bin)(pathname, err);
+    if ((shcs != NULL) || CHARM(err_isempty)(err))
+        e += 1;
+    CHARM(shc_free)(shcs);
+    CHARM(err_reset)(err);
+
+
+    return e;
+}
+
+
+
+
+
+
+/* Must be called only after "SHCS_OUT_PATH_POT_BIN" was created by
+ * "module_shc". */
+long int check_shc_map_bin(void)
+{
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+
+
+    /* Read the reference "gfc" file */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc) *shcs_ref = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0),
+                                             PREC(1.0));
+    if (shcs_ref == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc_read_gfc)(SHCS_IN_PATH_POT_GFC, SHCS_NMAX_POT, NULL, shcs_ref,
+                        err);
+    CHARM(err_handler)(err, 1);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Map the binary file */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc) *shcs = CHARM(shc_map_bin)(SHCS_OUT_PATH_POT_BIN, err);
+    CHARM(err_handler)(err, 1);
+
+
+    e += cmp_shcs(shcs_ref, shcs);
+    e += (shcs->map == NULL) ? 1 : 0;
+    e += (shcs->owner != 0) ? 1 : 0;
+
+
+    /* Both blocks of coefficients must be equally aligned within the file */
+    e += ((size_t)((char *)shcs->s[0] - (char *)shcs->c[0]) % SHC_BIN_ALIGN
+          != 0) ? 1 : 0;
+    e += ((uintptr_t)shcs->c[0] % sizeof(REAL) != 0) ? 1 : 0;
+
+
+    /* Functions modifying the coefficients must refuse the read-only
+     * structure */
+    CHARM(shc_rescale)(shcs, PREC(2.0) * shcs->mu, PREC(2.0) * shcs->r, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shc_add)(shcs, shcs_ref, shcs_ref, 0, SHCS_NMAX_POT, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shc_read_bin)(SHCS_OUT_PATH_POT_BIN, SHCS_NMAX_POT, shcs, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    e += cmp_shcs(shcs_ref, shcs);
+
+
+    CHARM(shc_free)(shcs);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Files with the opposite byte order are read by "shc_read_bin", but they
+     * cannot be mapped */
+    /* --------------------------------------------------------------------- */
+    write_swapped();
+    e += check_read_bin(SHCS_OUT_PATH_POT_BIN_SWAP, shcs_ref, err);
+    e += check_map_bin_fails(SHCS_OUT_PATH_POT_BIN_SWAP, err);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Files in the legacy format are read by "shc_read_bin", but they cannot
+     * be mapped */
+    /* --------------------------------------------------------------------- */
+    write_legacy(shcs_ref);
+    e += check_read_bin(SHCS_OUT_PATH_POT_BIN_LEGACY, shcs_ref, err);
+    e += check_map_bin_fails(SHCS_OUT_PATH_POT_BIN_LEGACY, err);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Non-existing file */
+    /* --------------------------------------------------------------------- */
+    e += check_map_bin_fails(SHCS_OUT_PATH_POT_BIN_LEGACY ".none", err);
+    /* --------------------------------------------------------------------- */
+
+
+    CHARM(err_free)(err);
+    CHARM(shc_free)(shcs_ref);
+
+
+    return e;
+}
@@ -0,0 +1,235 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/prec.h"
+#include "cmp_vals.h"
+#include "cmp_arrays.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "check_shc_read_bin_chunk.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Value of the coefficients that must not be touched by
+ * "shc_read_bin_chunk" */
+#undef UNTOUCHED
+#define UNTOUCHED (PREC(7.0))
+
+
+
+
+
+
+/* Reads the chunks "order" of "pathname" up to degree "nmax" and compares
+ * them with "shcs_ref" */
+static long int check_chunks(const char *pathname,
+                             unsigned long nmax,
+                             size_t nchunk,
+                             const unsigned long *order,
+                             const CHARM(shc) *shcs_ref,
+                             CHARM(err) *err)
+{
+    CHARM(shc) *shcs = CHARM(shc_malloc)(shcs_ref->nmax, PREC(1.0),
+                                         PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    for (size_t i = 0; i < shcs->nc; i++)
+        shcs->c[0][i] = shcs->s[0][i] = UNTOUCHED;
+
+
+    long int e = 0;
+    unsigned long nmax_file = CHARM(shc_read_bin_chunk)(pathname, nmax,
+                                                        nchunk, order, shcs,
+                                                        err);
+    CHARM(err_handler)(err, 1);
+    e += cmp_vals_ulong(nmax_file, shcs_ref->nmax);
+    e += cmp_vals_real(shcs->mu, shcs_ref->mu,
+                       PREC(10.0) * CHARM(glob_threshold));
+    e += cmp_vals_real(shcs->r, shcs_ref->r,
+                       PREC(10.0) * CHARM(glob_threshold));
+
+
+    for (unsigned long m = 0; m <= shcs->nmax; m++)
+    {
+        _Bool read = 0;
+        for (size_t j = 0; j < nchunk; j++)
+            if ((m >= order[2 * j]) && (m <= order[2 * j + 1]))
+                read = 1;
+
+
+        for (unsigned long n = m; n <= shcs->nmax; n++)
+        {
+            REAL cref, sref;
+            if (!read)
+                cref = sref = UNTOUCHED;
+            else if (n > nmax)
+                cref = sref = PREC(0.0);
+            else
+            {
+                cref = shcs_ref->c[m][n - m];
+                sref = shcs_ref->s[m][n - m];
+            }
+
+
+            e += cmp_vals_real(shcs->c[m][n - m], cref,
+                               PREC(10.0) * CHARM(glob_threshold));
+            e += cmp_vals_real(shcs->s[m][n - m], sref,
+                               PREC(10.0) * CHARM(glob_threshold));
+        }
+    }
+
+
+    CHARM(shc_free)(shcs);
+
+
+    return e;
+}
+
+
+
+
+
+
+/* Writes a copy of "SHCS_OUT_PATH_POT_BIN" with one modified byte of the
+ * coefficients to "SHCS_OUT_PATH_POT_BIN_CORRUPT" */
+static void write_corrupted(void)
+{
+    FILE *fin  = fopen(SHCS_OUT_PATH_POT_BIN, "rb");
+    FILE *fout = fopen(SHCS_OUT_PATH_POT_BIN_CORRUPT, "wb");
+    if ((fin == NULL) || (fout == NULL))
+    {
+        fprintf(stderr, "Failed to copy \"%s\".\n", SHCS_OUT_PATH_POT_BIN);
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* The byte to be modified belongs to "C_{5,3}" */
+    long byte = 128 + (long)(((3 * (2 * SHCS_NMAX_POT + 3 - 3)) / 2 + 2) *
+                             sizeof(REAL));
+    int c;
+    for (long i = 0; (c = fgetc(fin)) != EOF; i++)
+        fputc((i == byte) ? (c ^ 0x10) : c, fout);
+
+
+    fclose(fin);
+    fclose(fout);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Must be called only after "SHCS_OUT_PATH_POT_BIN" and
+ * "SHCS_OUT_PATH_POT_BIN_LEGACY" were created by "module_shc". */
+long int check_shc_read_bin_chunk(void)
+{
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+
+
+    /* Read the reference "gfc" file */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc) *shcs_ref = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0),
+                                             PREC(1.0));
+    if (shcs_ref == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc_read_gfc)(SHCS_IN_PATH_POT_GFC, SHCS_NMAX_POT, NULL, shcs_ref,
+                        err);
+    CHARM(err_handler)(err, 1);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Read various chunks up to various degrees from the versioned and the
+     * legacy files */
+    /* --------------------------------------------------------------------- */
+    const char *pathnames[2] = {SHCS_OUT_PATH_POT_BIN,
+                                SHCS_OUT_PATH_POT_BIN_LEGACY};
+    unsigned long order1[2] = {0, 4};
+    unsigned long order2[4] = {6, 6, 1, 3};
+
+
+    for (size_t f = 0; f < 2; f++)
+    {
+        for (unsigned long nmax = 6; nmax <= SHCS_NMAX_POT; nmax++)
+        {
+            e += check_chunks(pathnames[f], nmax, 1, order1, shcs_ref, err);
+            e += check_chunks(pathnames[f], nmax, 2, order2, shcs_ref, err);
+        }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* Invalid chunks */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0),
+                                         PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    unsigned long order3[2] = {3, SHCS_NMAX_POT};
+    CHARM(shc_read_bin_chunk)(SHCS_OUT_PATH_POT_BIN, SHCS_NMAX_POT - 1, 1,
+                              order3, shcs, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Corrupted file.  The checksums are verified only if the orders are read
+     * up to the maximum degree of the file. */
+    /* --------------------------------------------------------------------- */
+    write_corrupted();
+    CHARM(shc_read_bin_chunk)(SHCS_OUT_PATH_POT_BIN_CORRUPT, SHCS_NMAX_POT, 1,
+                              order1, shcs, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shc_read_bin)(SHCS_OUT_PATH_POT_BIN_CORRUPT, SHCS_NMAX_POT, shcs,
+                        err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    /* Order "3" is not read */
+    unsigned long order4[4] = {0, 2, 4, SHCS_NMAX_POT};
+    CHARM(shc_read_bin_chunk)(SHCS_OUT_PATH_POT_BIN_CORRUPT, SHCS_NMAX_POT, 2,
+                              order4, shcs, err);
+    e += (!CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+    /* --------------------------------------------------------------------- */
+
+
+    CHARM(err_free)(err);
+    CHARM(shc_free)(shcs);
+    CHARM(shc_free)(shcs_ref);
+
+
+    return e;
+}
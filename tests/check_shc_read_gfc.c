@@ -2,6 +2,8 @@
 /* ------------------------------------------------------------------------- */
 #include <config.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "../src/prec.h"
 #include "cmp_vals.h"
 #include "validate.h"
@@ -16,6 +18,76 @@
 
 
 
+/* Coefficients of the large "gfc" file.  They are exactly representable in
+ * all precisions and are never zero. */
+static double gfc_large_coeff(unsigned long n,
+                              unsigned long m,
+                              unsigned long cs)
+{
+    unsigned long k = (31 * n + 17 * m + 7 * cs) % 2048;
+
+
+    return ((double)(2 * k + 1) - 2048.0) / 2048.0;
+}
+
+
+
+
+
+
+/* Writes "x" to "fptr" using one of several formats of numbers that are
+ * accepted in "gfc" files */
+static void gfc_large_fprintf(FILE *fptr,
+                              double x,
+                              unsigned long fmt)
+{
+    char str[NSTR_SHORT];
+    char *exp;
+
+
+    switch (fmt % 5)
+    {
+    case 0:
+        snprintf(str, NSTR_SHORT, "%0.20e", x);
+        break;
+    case 1:
+        /* Fortran's "D" exponent */
+        snprintf(str, NSTR_SHORT, "%0.12E", x);
+        exp = strchr(str, 'E');
+        *exp = 'D';
+        break;
+    case 2:
+        snprintf(str, NSTR_SHORT, "%0.11f", x);
+        break;
+    case 3:
+        /* Fortran's "d" exponent and the plus sign */
+        snprintf(str, NSTR_SHORT, "%+0.17e", x);
+        exp = strchr(str, 'e');
+        *exp = 'd';
+        break;
+    default:
+        /* Too many significant digits, so that the number cannot be converted
+         * by the fast path in "shc_read_gfc".  The tiny perturbation does not
+         * change the value after rounding. */
+        snprintf(str, NSTR_SHORT, "%0.20e", x);
+        exp = strchr(str, 'e');
+        fprintf(fptr, "%.*s0000000000000000000000001%s", (int)(exp - str),
+                str, exp);
+        return;
+    }
+
+
+    fprintf(fptr, "%s", str);
+
+
+    return;
+}
+
+
+
+
+
+
 long int check_shc_read_gfc(void)
 {
     CHARM(err) *err = CHARM(err_init)();
@@ -88,6 +160,92 @@ long int check_shc_read_gfc(void)
     /* --------------------------------------------------------------------- */
 
 
+    /* Check a large "gfc" file that is read in several batches.  The file
+     * contains various formats of the coefficients, comments, empty lines and
+     * lines with the "\r\n" ending. */
+    /* --------------------------------------------------------------------- */
+    FILE *fptr = fopen(SHCS_OUT_PATH_GFC_LARGE, "w");
+    if (fptr == NULL)
+    {
+        fprintf(stderr, "Failed to open the stream for \"%s\".\n",
+                SHCS_OUT_PATH_GFC_LARGE);
+        exit(CHARM_FAILURE);
+    }
+
+
+    fprintf(fptr, "A large gfc file to test charm_shc_read_gfc\n"
+                  "gfc 1 2 3 4 lines in this section are comments\n"
+                  "begin_of_head\n"
+                  "earth_gravity_constant 3.986004415D+14\n"
+                  "radius 6378136.3\n"
+                  "max_degree %lu\n"
+                  "norm fully_normalized\n"
+                  "errors formal\n"
+                  "key n m C S sigma_C sigma_S\n"
+                  "end_of_head\n", SHCS_NMAX_GFC_LARGE);
+    unsigned long i = 0;
+    for (unsigned long n = 0; n <= SHCS_NMAX_GFC_LARGE; n++)
+    {
+        for (unsigned long m = 0; m <= n; m++, i++)
+        {
+            if ((i % 1000) == 0)
+                fprintf(fptr, "\n# comment 1 2 3\n\n");
+
+
+            fprintf(fptr, (n % 3) ? "gfc %lu %lu " : "  gfc\t%5lu%5lu   ", n,
+                    m);
+            gfc_large_fprintf(fptr, gfc_large_coeff(n, m, 0), i);
+            fprintf(fptr, " ");
+            if (m == 0)
+                fprintf(fptr, "0.0");
+            else
+                gfc_large_fprintf(fptr, gfc_large_coeff(n, m, 1), i + 1);
+            fprintf(fptr, " 1.0e-12 1.0e-12%s", (n % 7) ? "\n" : "\r\n");
+        }
+    }
+    fclose(fptr);
+
+
+    for (int j = 0; j < 2; j++)
+    {
+        unsigned long nmax_large = SHCS_NMAX_GFC_LARGE - 50 * j;
+        CHARM(shc) *shcs_large = CHARM(shc_calloc)(nmax_large, PREC(1.0),
+                                                   PREC(1.0));
+        if (shcs_large == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+
+
+        nmax_out = CHARM(shc_read_gfc)(SHCS_OUT_PATH_GFC_LARGE, nmax_large,
+                                       NULL, shcs_large, err);
+        CHARM(err_handler)(err, 1);
+        e += cmp_vals_ulong(nmax_out, SHCS_NMAX_GFC_LARGE);
+        e += cmp_vals_real(shcs_large->mu, PREC(3.986004415e+14), PREC(0.0));
+        e += cmp_vals_real(shcs_large->r, PREC(6378136.3), PREC(0.0));
+
+
+        for (unsigned long m = 0; m <= nmax_large; m++)
+        {
+            for (unsigned long n = m; n <= nmax_large; n++)
+            {
+                e += cmp_vals_real(shcs_large->c[m][n - m],
+                                   (REAL)gfc_large_coeff(n, m, 0),
+                                   PREC(0.0));
+                e += cmp_vals_real(shcs_large->s[m][n - m],
+                                   (m == 0) ? PREC(0.0) :
+                                   (REAL)gfc_large_coeff(n, m, 1),
+                                   PREC(0.0));
+            }
+        }
+
+
+        CHARM(shc_free)(shcs_large);
+    }
+    /* --------------------------------------------------------------------- */
+
+
     /* --------------------------------------------------------------------- */
     CHARM(shc_free)(shcs);
     CHARM(err_free)(err);
@@ -0,0 +1,279 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/prec.h"
+#include "cmp_vals.h"
+#include "cmp_arrays.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "check_shc_tv.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Number of epochs, at which the time variable models are evaluated */
+#define NEPOCHS 5
+
+
+/* Maximum harmonic degree of the "icgem2.0" file */
+#define NMAX_ICGEM2 4
+
+
+
+
+
+
+/* Writes a time variable "gfc" file of the "icgem2.0" format with two time
+ * periods to "SHCS_OUT_PATH_GFC_ICGEM2" */
+static void write_icgem2(void)
+{
+    FILE *fptr = fopen(SHCS_OUT_PATH_GFC_ICGEM2, "w");
+    if (fptr == NULL)
+    {
+        fprintf(stderr, "Failed to open the stream for \"%s\".\n",
+                SHCS_OUT_PATH_GFC_ICGEM2);
+        exit(CHARM_FAILURE);
+    }
+
+
+    fprintf(fptr, "begin_of_head\n"
+                  "format icgem2.0\n"
+                  "earth_gravity_constant 3.986004415e+14\n"
+                  "radius 6378136.3\n"
+                  "max_degree %d\n"
+                  "norm fully_normalized\n"
+                  "errors no\n"
+                  "end_of_head\n", NMAX_ICGEM2);
+
+
+    const char *t[3] = {"20000101", "20100101", "20200101"};
+    for (unsigned long n = 0; n <= NMAX_ICGEM2; n++)
+    {
+        for (unsigned long m = 0; m <= n; m++)
+        {
+            double x = (double)(n + 1) * 1.0e-6 + (double)m * 1.0e-8;
+
+
+            /* Degrees "0" and "1" are time invariant */
+            if (n < 2)
+            {
+                fprintf(fptr, "gfc %lu %lu %0.12e %0.12e\n", n, m, x,
+                        (m == 0) ? 0.0 : -x);
+                continue;
+            }
+
+
+            for (int i = 0; i < 2; i++)
+            {
+                double y = x * (double)(i + 1);
+                fprintf(fptr, "gfct %lu %lu %0.12e %0.12e %s %s\n", n, m, y,
+                        (m == 0) ? 0.0 : -y, t[i], t[i + 1]);
+                fprintf(fptr, "trnd %lu %lu %0.12e %0.12e %s %s\n", n, m,
+                        1.0e-3 * y, (m == 0) ? 0.0 : 2.0e-3 * y, t[i],
+                        t[i + 1]);
+                fprintf(fptr, "acos %lu %lu %0.12e %0.12e %s %s 1.0\n", n,
+                        m, 1.0e-2 * y, (m == 0) ? 0.0 : -1.0e-2 * y, t[i],
+                        t[i + 1]);
+                fprintf(fptr, "asin %lu %lu %0.12e %0.12e %s %s 0.5\n", n,
+                        m, 3.0e-2 * y, (m == 0) ? 0.0 : 5.0e-3 * y, t[i],
+                        t[i + 1]);
+            }
+        }
+    }
+
+
+    fclose(fptr);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Evaluates the time variable model from "pathname" up to degree "nmax" at
+ * "epochs" and compares the coefficients with those from "shc_read_gfc" */
+static long int check_tv(const char *pathname,
+                         unsigned long nmax,
+                         const char **epochs,
+                         CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    CHARM(shc_tv) *tv = CHARM(shc_tv_read_gfc)(pathname, nmax, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(shc) *shcs[NEPOCHS];
+    for (size_t k = 0; k < NEPOCHS; k++)
+    {
+        /* The output structures may have a larger maximum degree */
+        shcs[k] = CHARM(shc_calloc)(nmax + k % 2, PREC(1.0), PREC(1.0));
+        if (shcs[k] == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+    }
+    CHARM(shc) *shcs_ref = CHARM(shc_calloc)(nmax + 1, PREC(1.0), PREC(1.0));
+    if (shcs_ref == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_tv_eval)(tv, epochs, NEPOCHS, shcs, err);
+    CHARM(err_handler)(err, 1);
+
+
+    for (size_t k = 0; k < NEPOCHS; k++)
+    {
+        CHARM(shc_read_gfc)(pathname, nmax, epochs[k], shcs_ref, err);
+        CHARM(err_handler)(err, 1);
+
+
+        e += cmp_vals_real(shcs[k]->mu, shcs_ref->mu, PREC(0.0));
+        e += cmp_vals_real(shcs[k]->r, shcs_ref->r, PREC(0.0));
+        for (unsigned long m = 0; m <= shcs[k]->nmax; m++)
+        {
+            e += cmp_arrays(shcs[k]->c[m], shcs_ref->c[m],
+                            shcs[k]->nmax + 1 - m,
+                            PREC(10.0) * CHARM(glob_threshold));
+            e += cmp_arrays(shcs[k]->s[m], shcs_ref->s[m],
+                            shcs[k]->nmax + 1 - m,
+                            PREC(10.0) * CHARM(glob_threshold));
+        }
+    }
+
+
+    /* "shcs" with too small maximum harmonic degree */
+    if (nmax > 0)
+    {
+        CHARM(shc) *shcs_small = CHARM(shc_calloc)(nmax - 1, PREC(1.0),
+                                                   PREC(1.0));
+        if (shcs_small == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+        CHARM(shc_tv_eval)(tv, epochs, 1, &shcs_small, err);
+        e += CHARM(err_isempty)(err) ? 1 : 0;
+        CHARM(err_reset)(err);
+        CHARM(shc_free)(shcs_small);
+    }
+
+
+    for (size_t k = 0; k < NEPOCHS; k++)
+        CHARM(shc_free)(shcs[k]);
+    CHARM(shc_free)(shcs_ref);
+    CHARM(shc_tv_free)(tv);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_shc_tv(void)
+{
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+
+
+    /* Static model */
+    /* --------------------------------------------------------------------- */
+    const char *epochs_static[NEPOCHS] = {NULL, NULL, TVG_EPOCH, NULL,
+                                          "20240229"};
+    e += check_tv(SHCS_IN_PATH_POT_GFC, SHCS_NMAX_POT, epochs_static, err);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Time variable model of the "icgem1.0" format.  "NULL" stands for the
+     * reference epochs of the model. */
+    /* --------------------------------------------------------------------- */
+    const char *epochs_icgem1[NEPOCHS] = {TVG_EPOCH, "20100101", NULL,
+                                          "20170615.0030", "19991231.2400"};
+    e += check_tv(SHCS_IN_PATH_POT_GFC_TVG, SHCS_NMAX_POT, epochs_icgem1,
+                  err);
+    e += check_tv(SHCS_IN_PATH_POT_GFC_TVG, SHCS_NMAX_POT - 3, epochs_icgem1,
+                  err);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Time variable model of the "icgem2.0" format.  The epochs are from both
+     * time periods, from their boundaries and outside the periods. */
+    /* --------------------------------------------------------------------- */
+    write_icgem2();
+    const char *epochs_icgem2[NEPOCHS] = {"20050317.1200", "20100101",
+                                          "20191231.2359", "19990101",
+                                          "20200101"};
+    e += check_tv(SHCS_OUT_PATH_GFC_ICGEM2, NMAX_ICGEM2, epochs_icgem2, err);
+    e += check_tv(SHCS_OUT_PATH_GFC_ICGEM2, 2, epochs_icgem2, err);
+
+
+    /* The maximum degree of the file */
+    CHARM(shc_tv) *tv = CHARM(shc_tv_read_gfc)(SHCS_OUT_PATH_GFC_ICGEM2,
+                                               CHARM_SHC_NMAX_MODEL, err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shc) *shcs = CHARM(shc_calloc)(NMAX_ICGEM2, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc_tv_eval)(tv, epochs_icgem2, 1, &shcs, err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* "NULL" epochs are not allowed with "icgem2.0" */
+    const char *epoch_null = NULL;
+    CHARM(shc_tv_eval)(tv, &epoch_null, 1, &shcs, err);
+    e += CHARM(err_isempty)(err) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    /* Invalid epoch */
+    const char *epoch_invalid = "20230229";
+    CHARM(shc_tv_eval)(tv, &epoch_invalid, 1, &shcs, err);
+    e += CHARM(err_isempty)(err) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shc_free)(shcs);
+    CHARM(shc_tv_free)(tv);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Too large maximum degree */
+    /* --------------------------------------------------------------------- */
+    tv = CHARM(shc_tv_read_gfc)(SHCS_OUT_PATH_GFC_ICGEM2, NMAX_ICGEM2 + 1,
+                                err);
+    e += ((tv != NULL) || CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+    /* --------------------------------------------------------------------- */
+
+
+    CHARM(err_free)(err);
+
+
+    return e;
+}
@@ -0,0 +1,359 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/prec.h"
+#include "cmp_vals.h"
+#include "cmp_arrays.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "generate_point.h"
+#include "check_shc_view.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Number of tested slices */
+#undef NSLICES
+#define NSLICES (6)
+
+
+
+
+
+
+/* Returns a hard copy of the coefficients of "shcs" of degrees "nmin" to
+ * "nmax" and orders "mmin" to "mmax".  The other coefficients are zero. */
+static CHARM(shc) *copy_slice(const CHARM(shc) *shcs,
+                              unsigned long nmin,
+                              unsigned long nmax,
+                              unsigned long mmin,
+                              unsigned long mmax)
+{
+    CHARM(shc) *out = CHARM(shc_calloc)(nmax, shcs->mu, shcs->r);
+    if (out == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    for (unsigned long m = mmin; m <= mmax; m++)
+    {
+        for (unsigned long n = CHARM_MAX(m, nmin); n <= nmax; n++)
+        {
+            out->c[m][n - m] = shcs->c[m][n - m];
+            out->s[m][n - m] = shcs->s[m][n - m];
+        }
+    }
+
+
+    return out;
+}
+
+
+
+
+
+
+/* Synthesizes "shcs" and "shcs_ref" at "pnt" and compares the results */
+static long int check_synthesis(const CHARM(point) *pnt,
+                                const CHARM(shc) *shcs,
+                                const CHARM(shc) *shcs_ref,
+                                CHARM(err) *err)
+{
+    REAL *f    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    REAL *fref = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if ((f == NULL) || (fref == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_point)(pnt, shcs, shcs->nmax, f, err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shs_point)(pnt, shcs_ref, shcs_ref->nmax, fref, err);
+    CHARM(err_handler)(err, 1);
+
+
+    long int e = cmp_arrays(f, fref, pnt->npoint,
+                            PREC(10.0) * CHARM(glob_threshold));
+
+
+    free(f);
+    free(fref);
+
+
+    return e;
+}
+
+
+
+
+
+
+/* Compares "view" with the hard copy "shcs_ref" of its slice */
+static long int check_view(const CHARM(shc) *view,
+                           const CHARM(shc) *shcs,
+                           const CHARM(shc) *shcs_ref,
+                           CHARM(err) *err)
+{
+    long int e = 0;
+    unsigned long nmax = view->nmax;
+
+
+    /* Hard copy of the view */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc) *shcs_copy = CHARM(shc_copy)(view, 0, nmax, nmax);
+    if (shcs_copy == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    e += cmp_arrays(shcs_copy->c[0], shcs_ref->c[0], shcs_ref->nc, PREC(0.0));
+    e += cmp_arrays(shcs_copy->s[0], shcs_ref->s[0], shcs_ref->ns, PREC(0.0));
+    CHARM(shc_free)(shcs_copy);
+    /* --------------------------------------------------------------------- */
+
+
+    /* (Difference) degree variances */
+    /* --------------------------------------------------------------------- */
+    REAL *dv    = (REAL *)malloc((nmax + 1) * sizeof(REAL));
+    REAL *dvref = (REAL *)malloc((nmax + 1) * sizeof(REAL));
+    if ((dv == NULL) || (dvref == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_dv)(view, nmax, dv, err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shc_dv)(shcs_ref, nmax, dvref, err);
+    CHARM(err_handler)(err, 1);
+    e += cmp_arrays(dv, dvref, nmax + 1, PREC(0.0));
+
+
+    CHARM(shc_ddv)(view, shcs, nmax, dv, err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shc_ddv)(shcs_ref, shcs, nmax, dvref, err);
+    CHARM(err_handler)(err, 1);
+    e += cmp_arrays(dv, dvref, nmax + 1, PREC(0.0));
+
+
+    free(dv);
+    free(dvref);
+    /* --------------------------------------------------------------------- */
+
+
+    /* Synthesis at scattered points and at a grid */
+    /* --------------------------------------------------------------------- */
+    CHARM(point) *pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_SCATTERED,
+                                                13, 13);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI, PREC(2.0) * PI);
+    e += check_synthesis(pnt, view, shcs_ref, err);
+    CHARM(crd_point_free)(pnt);
+
+
+    pnt = CHARM(crd_point_gl)(nmax, shcs->r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    e += check_synthesis(pnt, view, shcs_ref, err);
+    CHARM(crd_point_free)(pnt);
+    /* --------------------------------------------------------------------- */
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_shc_view(void)
+{
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc_read_gfc)(SHCS_IN_PATH_POT_GFC, SHCS_NMAX_POT, NULL, shcs, err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* "nmin", "nmax", "mmin" and "mmax" of the slices.  The first two slices
+     * only truncate the coefficients. */
+    /* --------------------------------------------------------------------- */
+    const unsigned long slices[NSLICES][4] = {{0, SHCS_NMAX_POT,
+                                               0, SHCS_NMAX_POT},
+                                              {0, 6, 0, 6},
+                                              {2, SHCS_NMAX_POT,
+                                               0, SHCS_NMAX_POT},
+                                              {0, SHCS_NMAX_POT, 3, 7},
+                                              {4, 8, 1, 5},
+                                              {7, 7, 7, 7}};
+
+
+    for (size_t i = 0; i < NSLICES; i++)
+    {
+        unsigned long nmin = slices[i][0];
+        unsigned long nmax = slices[i][1];
+        unsigned long mmin = slices[i][2];
+        unsigned long mmax = slices[i][3];
+
+
+        CHARM(shc) *view = CHARM(shc_view)(shcs, nmin, nmax, mmin, mmax);
+        if (view == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+        e += cmp_vals_ulong(view->nmax, nmax);
+        e += (view->c != shcs->c) ? 1 : 0;
+
+
+        CHARM(shc) *shcs_ref = copy_slice(shcs, nmin, nmax, mmin, mmax);
+        e += check_view(view, shcs, shcs_ref, err);
+        CHARM(shc_free)(shcs_ref);
+
+
+        /* View of the view */
+        CHARM(shc) *view2 = CHARM(shc_view)(view, 1, nmax, 2, mmax);
+        if (view2 == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+        shcs_ref = copy_slice(shcs, CHARM_MAX(nmin, 1), nmax,
+                              CHARM_MAX(mmin, 2), mmax);
+        e += check_view(view2, shcs, shcs_ref, err);
+        CHARM(shc_free)(shcs_ref);
+        CHARM(shc_free)(view2);
+
+
+        /* Views are read-only */
+        CHARM(shc_rescale)(view, PREC(2.0), PREC(2.0), err);
+        e += (CHARM(err_isempty)(err)) ? 1 : 0;
+        CHARM(err_reset)(err);
+
+
+        CHARM(shc_free)(view);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* Spherical harmonic analysis cannot write to views, so that the
+     * coefficients of "shcs" outside the view are not reset */
+    /* --------------------------------------------------------------------- */
+    {
+    CHARM(shc) *view = CHARM(shc_view)(shcs, 0, 6, 0, 6);
+    if (view == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(point) *pnt = CHARM(crd_point_gl)(6, shcs->r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    REAL *f = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+    for (size_t i = 0; i < pnt->npoint; i++)
+        f[i] = PREC(1.0);
+
+
+    CHARM(sha_plan) *plan = CHARM(sha_plan_init)(pnt, 6,
+                                                 CHARM_SHA_PLAN_ESTIMATE,
+                                                 err);
+    CHARM(err_handler)(err, 1);
+
+
+    REAL c70 = shcs->c[0][7];
+    CHARM(sha_plan_execute)(plan, f, view, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+    e += cmp_vals_real(shcs->c[0][7], c70, PREC(0.0));
+
+
+    CHARM(sha_point)(pnt, f, 6, view, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(sha_plan_free)(plan);
+    CHARM(crd_point_free)(pnt);
+    CHARM(shc_free)(view);
+    free(f);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* Invalid slices */
+    /* --------------------------------------------------------------------- */
+    e += (CHARM(shc_view)(shcs, 0, SHCS_NMAX_POT + 1, 0, 0) != NULL) ? 1 : 0;
+    e += (CHARM(shc_view)(shcs, 3, 2, 0, 0) != NULL) ? 1 : 0;
+    e += (CHARM(shc_view)(shcs, 0, 5, 3, 2) != NULL) ? 1 : 0;
+    e += (CHARM(shc_view)(shcs, 0, 5, 0, 6) != NULL) ? 1 : 0;
+
+
+    /* Views of a view with an empty intersection of the slices */
+    {
+    CHARM(shc) *view = CHARM(shc_view)(shcs, 2, 8, 1, 3);
+    if (view == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    e += (CHARM(shc_view)(view, 0, 8, 4, 8) != NULL) ? 1 : 0;
+    e += (CHARM(shc_view)(view, 0, 1, 0, 1) != NULL) ? 1 : 0;
+
+
+    CHARM(shc_free)(view);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    CHARM(shc_free)(shcs);
+    CHARM(err_free)(err);
+
+
+    return e;
+}
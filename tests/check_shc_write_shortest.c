@@ -0,0 +1,233 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#if HAVE_OPENMP
+#   include <omp.h>
+#endif
+#include "../src/prec.h"
+#include "cmp_vals.h"
+#include "cmp_arrays.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "check_shc_write_shortest.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Number of write cases tested (see "write_type") */
+#define NTYPES 5
+
+
+
+
+
+
+/* Writes "shcs" to "pathname" with the "formatting" specifier.  "type" takes
+ * the following values:
+ *
+ * * "0" -- "shc_write_mtx",
+ *
+ * * "1" -- "shc_write_tbl" with "CHARM_SHC_WRITE_N",
+ *
+ * * "2" -- "shc_write_tbl" with "CHARM_SHC_WRITE_M",
+ *
+ * * "3" -- "shc_write_dov" with "CHARM_SHC_WRITE_N", and
+ *
+ * * "4" -- "shc_write_dov" with "CHARM_SHC_WRITE_M".
+ *
+ * */
+static void write_type(int type,
+                       const CHARM(shc) *shcs,
+                       const char *formatting,
+                       const char *pathname,
+                       CHARM(err) *err)
+{
+    if (type == 0)
+        CHARM(shc_write_mtx)(shcs, shcs->nmax, formatting, pathname, err);
+    else if (type == 1)
+        CHARM(shc_write_tbl)(shcs, shcs->nmax, formatting, CHARM_SHC_WRITE_N,
+                             pathname, err);
+    else if (type == 2)
+        CHARM(shc_write_tbl)(shcs, shcs->nmax, formatting, CHARM_SHC_WRITE_M,
+                             pathname, err);
+    else if (type == 3)
+        CHARM(shc_write_dov)(shcs, shcs->nmax, formatting, CHARM_SHC_WRITE_N,
+                             pathname, err);
+    else
+        CHARM(shc_write_dov)(shcs, shcs->nmax, formatting, CHARM_SHC_WRITE_M,
+                             pathname, err);
+    CHARM(err_handler)(err, 1);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Reads "pathname" written by "write_type" to "shcs" */
+static void read_type(int type,
+                      const char *pathname,
+                      CHARM(shc) *shcs,
+                      CHARM(err) *err)
+{
+    if (type == 0)
+        CHARM(shc_read_mtx)(pathname, shcs->nmax, shcs, err);
+    else if ((type == 1) || (type == 2))
+        CHARM(shc_read_tbl)(pathname, shcs->nmax, shcs, err);
+    else
+        CHARM(shc_read_dov)(pathname, shcs->nmax, shcs, err);
+    CHARM(err_handler)(err, 1);
+
+
+    return;
+}
+
+
+
+
+
+
+/* Returns "0" if the files "pathname1" and "pathname2" are identical and "1"
+ * otherwise */
+static long int cmp_files(const char *pathname1,
+                          const char *pathname2)
+{
+    FILE *fptr1 = fopen(pathname1, "rb");
+    FILE *fptr2 = fopen(pathname2, "rb");
+    if ((fptr1 == NULL) || (fptr2 == NULL))
+    {
+        fprintf(stderr, "Failed to open \"%s\" or \"%s\".\n", pathname1,
+                pathname2);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+    int c1, c2;
+    do
+    {
+        c1 = fgetc(fptr1);
+        c2 = fgetc(fptr2);
+        if (c1 != c2)
+        {
+            e = 1;
+            break;
+        }
+    } while (c1 != EOF);
+
+
+    fclose(fptr1);
+    fclose(fptr2);
+
+
+    return e;
+}
+
+
+
+
+
+
+/* Tests that text files written with the "NULL" formatting specifier are read
+ * back to exactly the same coefficients and that the output of the text
+ * writers does not depend on the number of threads. */
+long int check_shc_write_shortest(void)
+{
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Coefficients with a wide range of magnitudes, including zeros and
+     * numbers with short decimal representations */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc) *shcs_ref = CHARM(shc_calloc)(SHCS_NMAX_SHORTEST,
+                                             PREC(3.986004415e+14),
+                                             PREC(6378136.3));
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_SHORTEST, PREC(1.0),
+                                         PREC(1.0));
+    if ((shcs_ref == NULL) || (shcs == NULL))
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    unsigned long seed = 1;
+    for (size_t i = 0; i < shcs_ref->nc; i++)
+    {
+        seed = (seed * 1103515245UL + 12345UL) % 2147483648UL;
+        REAL x = (REAL)seed / PREC(2147483648.0) - PREC(0.5);
+        if (i % 7 == 0)
+            x = PREC(0.0);
+        else if (i % 11 == 0)
+            x = (REAL)(i % 5) / PREC(10.0);
+        shcs_ref->c[0][i] = x * POW(PREC(10.0), (REAL)((long)(i % 61) - 30));
+        shcs_ref->s[0][i] = -x * POW(PREC(10.0), (REAL)((long)(i % 41) - 20));
+    }
+
+
+    /* "S" coefficients of order zero are not written to all formats */
+    for (unsigned long n = 0; n <= SHCS_NMAX_SHORTEST; n++)
+        shcs_ref->s[0][n] = PREC(0.0);
+    /* --------------------------------------------------------------------- */
+
+
+    long int e = 0;
+    for (int type = 0; type < NTYPES; type++)
+    {
+        write_type(type, shcs_ref, NULL, SHCS_OUT_PATH_SHORTEST, err);
+        read_type(type, SHCS_OUT_PATH_SHORTEST, shcs, err);
+
+
+        e += cmp_vals_real(shcs->mu, shcs_ref->mu, PREC(0.0));
+        e += cmp_vals_real(shcs->r, shcs_ref->r, PREC(0.0));
+        e += cmp_arrays(shcs->c[0], shcs_ref->c[0], shcs_ref->nc, PREC(0.0));
+        e += cmp_arrays(shcs->s[0], shcs_ref->s[0], shcs_ref->ns, PREC(0.0));
+
+
+#if HAVE_OPENMP
+        /* The files must be identical regardless of the number of threads,
+         * both with and without the formatting specifier */
+        int nthreads = omp_get_max_threads();
+        for (int f = 0; f < 2; f++)
+        {
+            const char *formatting = (f == 0) ? NULL : REAL_PRINT_FORMAT;
+
+
+            omp_set_num_threads(1);
+            write_type(type, shcs_ref, formatting, SHCS_OUT_PATH_SHORTEST,
+                       err);
+            omp_set_num_threads(3);
+            write_type(type, shcs_ref, formatting,
+                       SHCS_OUT_PATH_SHORTEST_THREADS, err);
+            omp_set_num_threads(nthreads);
+
+
+            e += cmp_files(SHCS_OUT_PATH_SHORTEST,
+                           SHCS_OUT_PATH_SHORTEST_THREADS);
+        }
+#endif
+    }
+
+
+    CHARM(shc_free)(shcs_ref);
+    CHARM(shc_free)(shcs);
+    CHARM(err_free)(err);
+
+
+    return e;
+}
@@ -0,0 +1,25 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __CHECK_SHC_WRITE_SHORTEST_H__
+#define __CHECK_SHC_WRITE_SHORTEST_H__
+
+
+#include <config.h>
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern long int check_shc_write_shortest(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -149,6 +149,27 @@ long int check_shs_cell_isurf(void)
 #endif
 
 
+#ifndef GENREF
+                /* The same synthesis with the coefficients computed by tiles
+                 * of one and two orders */
+                size_t memory = CHARM(glob_shs_cell_isurf_memory);
+                size_t memory_tile[2] = {0, 8 * (NMAX2 + 1) * (NMAX2 + 1) *
+                                            (nmax_p + 1) * sizeof(REAL)};
+                for (size_t t = 0; t < 2; t++)
+                {
+                    CHARM(glob_shs_cell_isurf_memory) = memory_tile[t];
+                    CHARM(shs_cell_isurf)(grd, shcs_pot, nmax_p, shcs_topo,
+                                          nmax_t, NMAX2, NMAX2, f, err);
+                    CHARM(err_handler)(err, 1);
+
+
+                    e += validate(file, f, grd->ncell,
+                                  CHARM(glob_threshold2));
+                }
+                CHARM(glob_shs_cell_isurf_memory) = memory;
+#endif
+
+
                 CHARM(crd_cell_free)(grd);
                 free(f);
             }
@@ -0,0 +1,894 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../src/prec.h"
+#include "../src/shs/shs_point_gradn.h"
+#include "../src/shs/shs_check_single_derivative.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "generate_point.h"
+#include "cmp_arrays.h"
+#include "modify_low_degree_coefficients.h"
+#include "check_shs_plan.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Maximum number of quantities that can be synthesized by a single plan
+ * (second-order gradient) */
+#undef NPAR_MAX
+#define NPAR_MAX (6)
+
+
+/* Number of combinations of the derivatives to be checked (potential,
+ * first-order gradient, second-order gradient and all combinations of
+ * "dr", "dlat" and "dlon" of "CHARM(shs_point_guru)") */
+#undef NDERIV
+#define NDERIV (13)
+
+
+
+
+
+
+/* Synthesis of the reference signal "fref" with the functions from the "shs"
+ * module that do not rely on plans */
+static void synth_ref(const CHARM(point) *pnt,
+                      const CHARM(shc) *shcs,
+                      unsigned long nmax,
+                      int dr,
+                      int dlat,
+                      int dlon,
+                      REAL **fref,
+                      CHARM(err) *err)
+{
+    if ((dr == GRAD_0) && (dlat == GRAD_0) && (dlon == GRAD_0))
+        CHARM(shs_point)(pnt, shcs, nmax, fref[0], err);
+    else if ((dr == GRAD_1) && (dlat == GRAD_1) && (dlon == GRAD_1))
+        CHARM(shs_point_grad1)(pnt, shcs, nmax, fref, err);
+    else if ((dr == GRAD_2) && (dlat == GRAD_2) && (dlon == GRAD_2))
+        CHARM(shs_point_grad2)(pnt, shcs, nmax, fref, err);
+    else
+        CHARM(shs_point_guru)(pnt, shcs, nmax, dr, dlat, dlon, fref[0], err);
+    CHARM(err_handler)(err, 1);
+
+
+    return;
+}
+
+
+/* For derivatives, sets the signal at points near the poles to zero in both
+ * "f" and "fref", as the results are not reliable there */
+static void treat_singularity(const CHARM(point) *pnt,
+                              REAL *f,
+                              REAL *fref)
+{
+    REAL LAT_THRESHOLD = PI_2 - PREC(100.0) * FABS(CHARM(glob_threshold));
+
+
+    for (size_t i = 0; i < pnt->nlat; i++)
+    {
+        if (FABS(pnt->lat[i]) <= LAT_THRESHOLD)
+            continue;
+
+
+        if (pnt->type == CHARM_CRD_POINT_SCATTERED)
+            f[i] = fref[i] = PREC(0.0);
+        else
+            for (size_t j = 0; j < pnt->nlon; j++)
+                f[i * pnt->nlon + j] = fref[i * pnt->nlon + j] = PREC(0.0);
+    }
+
+
+    return;
+}
+
+
+#if HAVE_RUNTIME_BLOCK
+/* Creates a plan for "pnt", increases "charm_glob_shs_block_lat_multiplier"
+ * and executes the plan.  The plan must keep using the size of the latitude
+ * blocks it was created with. */
+static long int check_block_change(const CHARM(point) *pnt,
+                                   const CHARM(shc) *shcs,
+                                   unsigned long nmax,
+                                   CHARM(err) *err)
+{
+    REAL *f    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    REAL *fref = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if ((f == NULL) || (fref == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_plan) *plan = CHARM(shs_plan_init)(pnt, nmax, GRAD_0, GRAD_0,
+                                                 GRAD_0,
+                                                 CHARM_SHS_PLAN_ESTIMATE,
+                                                 err);
+    CHARM(err_handler)(err, 1);
+
+
+    size_t block_s = CHARM(glob_shs_block_lat_multiplier);
+    CHARM(glob_shs_block_lat_multiplier) = block_s + 3;
+    CHARM(shs_plan_execute)(plan, shcs, &f, err);
+    CHARM(err_handler)(err, 1);
+    CHARM(glob_shs_block_lat_multiplier) = block_s;
+
+
+    synth_ref(pnt, shcs, nmax, GRAD_0, GRAD_0, GRAD_0, &fref, err);
+    long int e = cmp_arrays(f, fref, pnt->npoint,
+                            PREC(10.0) * CHARM(glob_threshold));
+
+
+    CHARM(shs_plan_free)(plan);
+    free(f);
+    free(fref);
+
+
+    return e;
+}
+#endif
+
+
+/* Creates a plan for "pnt", executes it with "shcs" and "shcs2" (several
+ * times to check the caching of the plan) and compares the results with the
+ * reference values from the functions that do not use plans */
+static long int check_plan(const CHARM(point) *pnt,
+                           const CHARM(shc) *shcs,
+                           const CHARM(shc) *shcs2,
+                           unsigned long nmax,
+                           int dr,
+                           int dlat,
+                           int dlon,
+                           int flags,
+                           CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    size_t npar = 1;
+    if ((dr == GRAD_1) && (dlat == GRAD_1) && (dlon == GRAD_1))
+        npar = 3;
+    else if ((dr == GRAD_2) && (dlat == GRAD_2) && (dlon == GRAD_2))
+        npar = 6;
+    _Bool deriv = (dr != GRAD_0) || (dlat != GRAD_0) || (dlon != GRAD_0);
+
+
+    REAL *f[NPAR_MAX];
+    REAL *fref[NPAR_MAX];
+    for (size_t j = 0; j < npar; j++)
+    {
+        f[j]    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+        fref[j] = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+        if ((f[j] == NULL) || (fref[j] == NULL))
+        {
+            fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+            exit(CHARM_FAILURE);
+        }
+    }
+
+
+    CHARM(shs_plan) *plan = CHARM(shs_plan_init)(pnt, nmax, dr, dlat, dlon,
+                                                 flags, err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* "shcs", "shcs2" and "shcs" again, so that the cached powers of the
+     * radius ratios are set, modified and set back again */
+    const CHARM(shc) *shcs_all[3] = {shcs, shcs2, shcs};
+    for (size_t k = 0; k < 3; k++)
+    {
+        CHARM(shs_plan_execute)(plan, shcs_all[k], f, err);
+        CHARM(err_handler)(err, 1);
+
+
+        synth_ref(pnt, shcs_all[k], nmax, dr, dlat, dlon, fref, err);
+
+
+        for (size_t j = 0; j < npar; j++)
+        {
+            if (deriv)
+                treat_singularity(pnt, f[j], fref[j]);
+
+
+            e += cmp_arrays(f[j], fref[j], pnt->npoint,
+                            PREC(10.0) * CHARM(glob_threshold));
+        }
+    }
+
+
+    CHARM(shs_plan_free)(plan);
+    for (size_t j = 0; j < npar; j++)
+    {
+        free(f[j]);
+        free(fref[j]);
+    }
+
+
+    return e;
+}
+
+
+
+
+
+
+/* Synthesizes "shcs" at the grid "pnt" by a plan with "pslr_factor" and
+ * "czt_factor" assigned to "charm_glob_shs_grd_pslr_factor" and
+ * "charm_glob_shs_grd_czt_factor", respectively, and compares the results
+ * with the synthesis that applies FFT whenever possible and PSLR otherwise.
+ * Returned in "nfft" and "npslr" are the numbers of latitude blocks
+ * transformed by FFT (or by the chirp-z transform) and by PSLR in the former
+ * synthesis. */
+static long int check_pslr(const CHARM(point) *pnt,
+                           const CHARM(shc) *shcs,
+                           unsigned long nmax,
+                           int dr,
+                           int dlat,
+                           int dlon,
+                           REAL pslr_factor,
+                           REAL czt_factor,
+                           size_t *nfft,
+                           size_t *npslr,
+                           CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    size_t npar = 1;
+    if ((dr == GRAD_1) && (dlat == GRAD_1) && (dlon == GRAD_1))
+        npar = 3;
+    else if ((dr == GRAD_2) && (dlat == GRAD_2) && (dlon == GRAD_2))
+        npar = 6;
+    _Bool deriv = (dr != GRAD_0) || (dlat != GRAD_0) || (dlon != GRAD_0);
+
+
+    REAL *f[NPAR_MAX];
+    REAL *fref[NPAR_MAX];
+    for (size_t j = 0; j < npar; j++)
+    {
+        f[j]    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+        fref[j] = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+        if ((f[j] == NULL) || (fref[j] == NULL))
+        {
+            fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+            exit(CHARM_FAILURE);
+        }
+    }
+
+
+    REAL pslr_factor_default = CHARM(glob_shs_grd_pslr_factor);
+    REAL czt_factor_default  = CHARM(glob_shs_grd_czt_factor);
+
+
+    CHARM(glob_shs_grd_pslr_factor) = PREC(0.0);
+    CHARM(glob_shs_grd_czt_factor)  = PREC(0.0);
+    synth_ref(pnt, shcs, nmax, dr, dlat, dlon, fref, err);
+
+
+    CHARM(glob_shs_grd_pslr_factor) = pslr_factor;
+    CHARM(glob_shs_grd_czt_factor)  = czt_factor;
+    CHARM(shs_plan) *plan = CHARM(shs_plan_init)(pnt, nmax, dr, dlat, dlon,
+                                                 CHARM_SHS_PLAN_ESTIMATE,
+                                                 err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shs_plan_execute)(plan, shcs, f, err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shs_plan_nblocks)(plan, nfft, npslr);
+    CHARM(shs_plan_free)(plan);
+
+
+    CHARM(glob_shs_grd_pslr_factor) = pslr_factor_default;
+    CHARM(glob_shs_grd_czt_factor)  = czt_factor_default;
+
+
+    for (size_t j = 0; j < npar; j++)
+    {
+        if (deriv)
+            treat_singularity(pnt, f[j], fref[j]);
+
+
+        /* FFT, the chirp-z transform and PSLR accumulate the rounding errors
+         * differently */
+        e += cmp_arrays(f[j], fref[j], pnt->npoint, CHARM(glob_threshold2));
+
+
+        free(f[j]);
+        free(fref[j]);
+    }
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_shs_plan(void)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_read_mtx)(SHCS_IN_PATH_POT_MTX, SHCS_NMAX_POT, shcs, err);
+    CHARM(err_handler)(err, 1);
+    modify_low_degree_coefficients(shcs);
+
+
+    /* The same coefficients, but with a different reference radius */
+    CHARM(shc) *shcs2 = CHARM(shc_copy)(shcs, 0, shcs->nmax, shcs->nmax);
+    if (shcs2 == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_rescale)(shcs2, shcs2->mu, shcs2->r * SHCS_RESCALE_R_FACTOR,
+                       err);
+    CHARM(err_handler)(err, 1);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Combinations of derivatives */
+    /* --------------------------------------------------------------------- */
+    int dr[NDERIV], dlat[NDERIV], dlon[NDERIV];
+    dr[0] = dlat[0] = dlon[0] = GRAD_0;
+    dr[1] = dlat[1] = dlon[1] = GRAD_1;
+    dr[2] = dlat[2] = dlon[2] = GRAD_2;
+    size_t nderiv = 3;
+    for (int i = 0; i <= SHS_MAX_DERIVATIVE; i++)
+        for (int j = 0; j <= SHS_MAX_DERIVATIVE; j++)
+            for (int k = 0; k <= SHS_MAX_DERIVATIVE; k++)
+            {
+                if ((i + j + k == 0) || (i + j + k > SHS_MAX_DERIVATIVE))
+                    continue;
+
+
+                dr[nderiv]   = i;
+                dlat[nderiv] = j;
+                dlon[nderiv] = k;
+                nderiv++;
+            }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    long int e = 0;
+    CHARM(point) *pnt = NULL;
+
+
+    /* Quadrature grids */
+    /* --------------------------------------------------------------------- */
+    {
+    int grd_types[3] = {CHARM_CRD_POINT_GRID_GL,
+                        CHARM_CRD_POINT_GRID_DH1,
+                        CHARM_CRD_POINT_GRID_DH2};
+
+
+    for (int g = 0; g < 3; g++)
+    {
+        for (unsigned long nmax = 0; nmax <= NMAX; nmax++)
+        {
+            for (int deltar = 0; deltar < NDELTAR; deltar++)
+            {
+                REAL r = shcs->r + (REAL)(DELTAR) * (REAL)deltar;
+
+
+                if (grd_types[g] == CHARM_CRD_POINT_GRID_GL)
+                    pnt = CHARM(crd_point_gl)(nmax, r);
+                else if (grd_types[g] == CHARM_CRD_POINT_GRID_DH1)
+                    pnt = CHARM(crd_point_dh1)(nmax, r);
+                else
+                    pnt = CHARM(crd_point_dh2)(nmax, r);
+                if (pnt == NULL)
+                {
+                    fprintf(stderr, "%s", ERR_MSG_POINT);
+                    exit(CHARM_FAILURE);
+                }
+
+
+                for (size_t d = 0; d < nderiv; d++)
+                    e += check_plan(pnt, shcs, shcs2, nmax, dr[d], dlat[d],
+                                    dlon[d], CHARM_SHS_PLAN_ESTIMATE, err);
+
+
+                CHARM(crd_point_free)(pnt);
+            }
+        }
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Custom grids with and without FFT and with and without the symmetry */
+    /* --------------------------------------------------------------------- */
+    {
+    size_t nlat[NCUSTOM_GRD] = {1, 1, 3, 10};
+    size_t nlon[NCUSTOM_GRD] = {1, 2, 8, 22};
+
+
+    for (unsigned long nmax = 0; nmax <= NMAX; nmax++)
+    {
+        for (size_t i = 0; i < NCUSTOM_GRD; i++)
+        {
+            for (int fft = 0; fft < 2; fft++)
+            {
+                for (int s = 0; s < 2; s++)
+                {
+                    if ((nlat[i] == 1) && (s == 1))
+                        continue;
+
+
+                    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID,
+                                                  nlat[i], nlon[i]);
+                    if (pnt == NULL)
+                    {
+                        fprintf(stderr, "%s", ERR_MSG_POINT);
+                        exit(CHARM_FAILURE);
+                    }
+
+
+                    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI,
+                                          (fft == 0) ? PI : PREC(2.0) * PI);
+                    if (s == 0)
+                        pnt->lat[0] -= (REAL)(BREAK_SYMM);
+
+
+                    for (size_t d = 0; d < nderiv; d++)
+                        e += check_plan(pnt, shcs, shcs2, nmax, dr[d],
+                                        dlat[d], dlon[d],
+                                        CHARM_SHS_PLAN_ESTIMATE, err);
+
+
+                    CHARM(crd_point_free)(pnt);
+                }
+            }
+        }
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Scattered points */
+    /* --------------------------------------------------------------------- */
+    {
+    size_t npoint[3] = {1, 9, 31};
+
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        pnt = CHARM(crd_point_malloc)(CHARM_CRD_POINT_SCATTERED, npoint[i],
+                                      npoint[i]);
+        if (pnt == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_POINT);
+            exit(CHARM_FAILURE);
+        }
+
+
+        CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI,
+                              PREC(2.0) * PI);
+
+
+        for (size_t d = 0; d < nderiv; d++)
+            e += check_plan(pnt, shcs, shcs2, NMAX, dr[d], dlat[d], dlon[d],
+                            CHARM_SHS_PLAN_ESTIMATE, err);
+
+
+        CHARM(crd_point_free)(pnt);
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Other planning flags */
+    /* --------------------------------------------------------------------- */
+    {
+    int flags[2] = {CHARM_SHS_PLAN_MEASURE, CHARM_SHS_PLAN_PATIENT};
+
+
+    pnt = CHARM(crd_point_gl)(SHCS_NMAX_POT, shcs->r + (REAL)(DELTAR));
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    for (size_t i = 0; i < 2; i++)
+        e += check_plan(pnt, shcs, shcs2, SHCS_NMAX_POT, GRAD_0, GRAD_0,
+                        GRAD_0, flags[i], err);
+
+
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Latitude blocks transformed by FFT and by PSLR */
+    /* --------------------------------------------------------------------- */
+    {
+    size_t nfft, npslr;
+
+
+    /* Without the polar optimization, a huge factor transforms all the
+     * latitude blocks of quadrature grids by PSLR and the zero factor by FFT
+     * */
+    pnt = CHARM(crd_point_dh1)(SHCS_NMAX_POT, shcs->r + (REAL)(DELTAR));
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    for (size_t d = 0; d < nderiv; d++)
+    {
+        e += check_pslr(pnt, shcs, SHCS_NMAX_POT, dr[d], dlat[d], dlon[d],
+                        PREC(1.0e9), PREC(0.0), &nfft, &npslr, err);
+        e += ((nfft != 0) || (npslr == 0)) ? 1 : 0;
+
+
+        e += check_pslr(pnt, shcs, SHCS_NMAX_POT, dr[d], dlat[d], dlon[d],
+                        PREC(0.0), PREC(0.0), &nfft, &npslr, err);
+        e += ((nfft == 0) || (npslr != 0)) ? 1 : 0;
+    }
+
+
+    CHARM(crd_point_free)(pnt);
+
+
+    /* Grids that do not allow FFT are transformed by PSLR if the chirp-z
+     * transform is disabled */
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 10, 22);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI, PI);
+
+
+    e += check_pslr(pnt, shcs, SHCS_NMAX_POT, GRAD_0, GRAD_0, GRAD_0,
+                    PREC(0.0), PREC(0.0), &nfft, &npslr, err);
+    e += ((nfft != 0) || (npslr == 0)) ? 1 : 0;
+
+
+    CHARM(crd_point_free)(pnt);
+
+
+    /* With the polar optimization, the latitude blocks close to the poles
+     * synthesize only a few orders, so they are transformed by PSLR, while
+     * the blocks close to the equator are transformed by FFT.  The grid has
+     * only a few longitudes, because the recursion over longitudes
+     * accumulates the rounding errors.  The factor is chosen so that
+     * "pslr_nm = 8" ("log2(22) = 4"). */
+    unsigned long a1 = CHARM(glob_polar_optimization_a1);
+    REAL a2          = CHARM(glob_polar_optimization_a2);
+    CHARM(glob_polar_optimization_a1) = 0;
+    CHARM(glob_polar_optimization_a2) = PREC(0.0);
+
+
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 401, 22);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI, PREC(2.0) * PI);
+
+
+    for (size_t d = 0; d < 2; d++)
+    {
+        e += check_pslr(pnt, shcs, SHCS_NMAX_POT, dr[d], dlat[d], dlon[d],
+                        PREC(2.0), PREC(0.0), &nfft, &npslr, err);
+        e += ((nfft == 0) || (npslr == 0)) ? 1 : 0;
+    }
+
+
+    CHARM(crd_point_free)(pnt);
+    CHARM(glob_polar_optimization_a1) = a1;
+    CHARM(glob_polar_optimization_a2) = a2;
+
+
+    /* Grids that do not allow FFT are transformed by the chirp-z transform
+     * if the factor is tiny: a regional grid, a regional grid not starting
+     * at the zero longitude and a full-circle grid with too few longitudes
+     * for FFT */
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 10, 22);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI, PI);
+
+
+    for (int k = 0; k < 2; k++)
+    {
+        for (size_t d = 0; d < nderiv; d++)
+        {
+            e += check_pslr(pnt, shcs, SHCS_NMAX_POT, dr[d], dlat[d],
+                            dlon[d], PREC(0.0), PREC(1.0e-9), &nfft, &npslr,
+                            err);
+            e += ((nfft == 0) || (npslr != 0)) ? 1 : 0;
+        }
+
+
+        for (size_t j = 0; j < pnt->nlon; j++)
+            pnt->lon[j] -= PREC(0.7);
+    }
+
+
+    CHARM(crd_point_free)(pnt);
+
+
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 10, 15);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI, PREC(2.0) * PI);
+
+
+    e += check_pslr(pnt, shcs, SHCS_NMAX_POT, GRAD_0, GRAD_0, GRAD_0,
+                    PREC(0.0), PREC(1.0e-9), &nfft, &npslr, err);
+    e += ((nfft == 0) || (npslr != 0)) ? 1 : 0;
+
+
+    CHARM(crd_point_free)(pnt);
+
+
+    /* With the polar optimization, the latitude blocks of a regional grid
+     * close to the poles are transformed by PSLR and the blocks close to the
+     * equator by the chirp-z transform.  The length of the FFTs of the
+     * chirp-z transform is "32", so the factor is chosen such that "pslr_nm =
+     * 8" ("log2(32) * 32 / 22 = 7.27"). */
+    CHARM(glob_polar_optimization_a1) = 0;
+    CHARM(glob_polar_optimization_a2) = PREC(0.0);
+
+
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 401, 22);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI, PI);
+
+
+    /* With "--enable-simd-dispatch", PSLR and the chirp-z transform are
+     * compiled for the baseline instruction set, so "FMA_R" of the generic
+     * vectors is a multiplication followed by an addition, while the
+     * non-dispatch builds fuse them.  In single precision, this doubles the
+     * relative error of the latitudinal derivative at a point, at which the
+     * derivative is about four orders of magnitude smaller than its largest
+     * values. */
+    REAL threshold2 = CHARM(glob_threshold2);
+#if HAVE_SIMD_DISPATCH && defined(CHARM_FLOAT)
+    CHARM(glob_threshold2) *= PREC(2.0);
+#endif
+    for (size_t d = 0; d < 2; d++)
+    {
+        e += check_pslr(pnt, shcs, SHCS_NMAX_POT, dr[d], dlat[d], dlon[d],
+                        PREC(0.0), PREC(1.1), &nfft, &npslr, err);
+        e += ((nfft == 0) || (npslr == 0)) ? 1 : 0;
+    }
+    CHARM(glob_threshold2) = threshold2;
+
+
+    CHARM(crd_point_free)(pnt);
+
+
+    /* With the polar optimization, the lumped coefficients of the orders
+     * skipped at the latitude block close to the pole of a non-symmetric grid
+     * must not be taken from the previous block close to the equator */
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 32, 22);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI, PREC(2.0) * PI);
+    for (size_t i = 0; i < 16; i++)
+    {
+        pnt->lat[i]      = PREC(0.3) - PREC(0.01) * (REAL)i;
+        pnt->lat[16 + i] = PREC(-1.2) - PREC(0.02) * (REAL)i;
+    }
+
+
+    e += check_pslr(pnt, shcs, SHCS_NMAX_POT, GRAD_0, GRAD_0, GRAD_0,
+                    PREC(1.0e9), PREC(0.0), &nfft, &npslr, err);
+    e += ((nfft != 0) || (npslr == 0)) ? 1 : 0;
+
+
+    CHARM(crd_point_free)(pnt);
+    CHARM(glob_polar_optimization_a1) = a1;
+    CHARM(glob_polar_optimization_a2) = a2;
+
+
+    /* No latitude blocks for scattered points */
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_SCATTERED, 9, 9);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI, PREC(2.0) * PI);
+
+
+    e += check_pslr(pnt, shcs, SHCS_NMAX_POT, GRAD_0, GRAD_0, GRAD_0,
+                    PREC(1.0e9), PREC(0.0), &nfft, &npslr, err);
+    e += ((nfft != 0) || (npslr != 0)) ? 1 : 0;
+
+
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+#if HAVE_RUNTIME_BLOCK
+    /* Latitude block size changed between the plan creation and its
+     * execution */
+    /* --------------------------------------------------------------------- */
+    {
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 37, 22);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI, PREC(2.0) * PI);
+
+
+    /* With the FFT and with the PSLR algorithm */
+    REAL pslr_factor = CHARM(glob_shs_grd_pslr_factor);
+    for (int k = 0; k < 2; k++)
+    {
+        CHARM(glob_shs_grd_pslr_factor) = (k == 0) ? PREC(0.0) :
+                                                     PREC(1.0e9);
+        e += check_block_change(pnt, shcs, SHCS_NMAX_POT, err);
+    }
+    CHARM(glob_shs_grd_pslr_factor) = pslr_factor;
+
+
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+#endif
+
+
+
+
+
+
+    /* Invalid input */
+    /* --------------------------------------------------------------------- */
+    {
+    pnt = CHARM(crd_point_gl)(NMAX, shcs->r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* Wrong planning flag */
+    CHARM(shs_plan) *plan = CHARM(shs_plan_init)(pnt, NMAX, GRAD_0, GRAD_0,
+                                                 GRAD_0, 9999, err);
+    if ((plan != NULL) || CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Wrong planning flag didn't "
+               "produce an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    /* Wrong combination of derivatives */
+    plan = CHARM(shs_plan_init)(pnt, NMAX, GRAD_1, GRAD_0, GRAD_0,
+                                CHARM_SHS_PLAN_ESTIMATE, err);
+    if ((plan != NULL) || CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Wrong combination of derivatives didn't "
+               "produce an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    /* "nmax" of the plan larger than "shcs->nmax" */
+    plan = CHARM(shs_plan_init)(pnt, SHCS_NMAX_POT + 1, GRAD_0, GRAD_0,
+                                GRAD_0, CHARM_SHS_PLAN_ESTIMATE, err);
+    CHARM(err_handler)(err, 1);
+
+
+    REAL *f = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_plan_execute)(plan, shcs, &f, err);
+    if (CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too large \"nmax\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    free(f);
+    CHARM(shs_plan_free)(plan);
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(shc_free)(shcs);
+    CHARM(shc_free)(shcs2);
+    CHARM(err_free)(err);
+
+
+    return e;
+    /* --------------------------------------------------------------------- */
+}
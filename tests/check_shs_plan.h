@@ -0,0 +1,25 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __CHECK_SHS_PLAN_H__
+#define __CHECK_SHS_PLAN_H__
+
+
+#include <config.h>
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern long int check_shs_plan(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
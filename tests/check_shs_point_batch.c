@@ -0,0 +1,417 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../src/prec.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "generate_point.h"
+#include "cmp_arrays.h"
+#include "modify_low_degree_coefficients.h"
+#include "check_shs_point_batch.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Number of models to be synthesized at once */
+#undef NMODELS
+#define NMODELS (3)
+
+
+
+
+
+
+/* Synthesizes "nmodels" models from "shcs" at "pnt" with
+ * "CHARM(shs_point_batch)" and compares the results with those from
+ * "CHARM(shs_point)" */
+static long int check_batch(const CHARM(point) *pnt,
+                            CHARM(shc) **shcs,
+                            size_t nmodels,
+                            unsigned long nmax,
+                            CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    REAL *f[NMODELS];
+    REAL *fref = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if (fref == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+    for (size_t k = 0; k < nmodels; k++)
+    {
+        f[k] = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+        if (f[k] == NULL)
+        {
+            fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+            exit(CHARM_FAILURE);
+        }
+    }
+
+
+    CHARM(shs_point_batch)(pnt, shcs, nmodels, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+
+
+    for (size_t k = 0; k < nmodels; k++)
+    {
+        CHARM(shs_point)(pnt, shcs[k], nmax, fref, err);
+        CHARM(err_handler)(err, 1);
+
+
+        e += cmp_arrays(f[k], fref, pnt->npoint,
+                        PREC(10.0) * CHARM(glob_threshold));
+    }
+
+
+    for (size_t k = 0; k < nmodels; k++)
+        free(f[k]);
+    free(fref);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_shs_point_batch(void)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc) *shcs[NMODELS];
+    shcs[0] = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs[0] == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_read_mtx)(SHCS_IN_PATH_POT_MTX, SHCS_NMAX_POT, shcs[0], err);
+    CHARM(err_handler)(err, 1);
+    modify_low_degree_coefficients(shcs[0]);
+
+
+    /* The other models differ in the coefficients and in "mu", but share the
+     * reference radius */
+    for (size_t k = 1; k < NMODELS; k++)
+    {
+        shcs[k] = CHARM(shc_copy)(shcs[0], 0, shcs[0]->nmax, shcs[0]->nmax);
+        if (shcs[k] == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_SHC);
+            exit(CHARM_FAILURE);
+        }
+
+
+        shcs[k]->mu *= (REAL)(k + 1);
+        for (unsigned long m = 0; m <= shcs[k]->nmax; m++)
+            for (unsigned long n = m; n <= shcs[k]->nmax; n++)
+            {
+                shcs[k]->c[m][n - m] *= PREC(1.0) + (REAL)(k * (n + m)) /
+                                                    PREC(10.0);
+                shcs[k]->s[m][n - m] *= PREC(1.0) - (REAL)(k * m) /
+                                                    PREC(20.0);
+            }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    long int e = 0;
+    CHARM(point) *pnt = NULL;
+
+
+    /* Quadrature grids */
+    /* --------------------------------------------------------------------- */
+    {
+    int grd_types[3] = {CHARM_CRD_POINT_GRID_GL,
+                        CHARM_CRD_POINT_GRID_DH1,
+                        CHARM_CRD_POINT_GRID_DH2};
+
+
+    for (int g = 0; g < 3; g++)
+    {
+        for (unsigned long nmax = 0; nmax <= NMAX; nmax++)
+        {
+            for (int deltar = 0; deltar < NDELTAR; deltar++)
+            {
+                REAL r = shcs[0]->r + (REAL)(DELTAR) * (REAL)deltar;
+
+
+                if (grd_types[g] == CHARM_CRD_POINT_GRID_GL)
+                    pnt = CHARM(crd_point_gl)(nmax, r);
+                else if (grd_types[g] == CHARM_CRD_POINT_GRID_DH1)
+                    pnt = CHARM(crd_point_dh1)(nmax, r);
+                else
+                    pnt = CHARM(crd_point_dh2)(nmax, r);
+                if (pnt == NULL)
+                {
+                    fprintf(stderr, "%s", ERR_MSG_POINT);
+                    exit(CHARM_FAILURE);
+                }
+
+
+                for (size_t nmodels = 0; nmodels <= NMODELS; nmodels++)
+                    e += check_batch(pnt, shcs, nmodels, nmax, err);
+
+
+                CHARM(crd_point_free)(pnt);
+            }
+        }
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Custom grids with and without FFT and with and without the symmetry */
+    /* --------------------------------------------------------------------- */
+    {
+    size_t nlat[NCUSTOM_GRD] = {1, 1, 3, 10};
+    size_t nlon[NCUSTOM_GRD] = {1, 2, 8, 22};
+
+
+    for (unsigned long nmax = 0; nmax <= NMAX; nmax++)
+    {
+        for (size_t i = 0; i < NCUSTOM_GRD; i++)
+        {
+            for (int fft = 0; fft < 2; fft++)
+            {
+                for (int s = 0; s < 2; s++)
+                {
+                    if ((nlat[i] == 1) && (s == 1))
+                        continue;
+
+
+                    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID,
+                                                  nlat[i], nlon[i]);
+                    if (pnt == NULL)
+                    {
+                        fprintf(stderr, "%s", ERR_MSG_POINT);
+                        exit(CHARM_FAILURE);
+                    }
+
+
+                    CHARM(generate_point)(pnt, shcs[0]->r + (REAL)(DELTAR),
+                                          PI, (fft == 0) ? PI :
+                                                           PREC(2.0) * PI);
+                    if (s == 0)
+                        pnt->lat[0] -= (REAL)(BREAK_SYMM);
+
+
+                    e += check_batch(pnt, shcs, NMODELS, nmax, err);
+
+
+                    CHARM(crd_point_free)(pnt);
+                }
+            }
+        }
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Grid that is not symmetric with respect to the equator with the polar
+     * optimization.  The lumped coefficients of the orders skipped at the
+     * latitudes close to the pole must not be taken from the latitudes close
+     * to the equator.  The reference values are obtained by PSLR, which does
+     * not use the lumped coefficients of the FFT. */
+    /* --------------------------------------------------------------------- */
+    {
+    unsigned long a1 = CHARM(glob_polar_optimization_a1);
+    REAL a2          = CHARM(glob_polar_optimization_a2);
+    REAL pslr_factor = CHARM(glob_shs_grd_pslr_factor);
+    CHARM(glob_polar_optimization_a1) = 0;
+    CHARM(glob_polar_optimization_a2) = PREC(0.0);
+
+
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 32, 22);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, shcs[0]->r + (REAL)(DELTAR), PI,
+                          PREC(2.0) * PI);
+    for (size_t i = 0; i < 16; i++)
+    {
+        pnt->lat[i]      = PREC(0.3) - PREC(0.01) * (REAL)i;
+        pnt->lat[16 + i] = PREC(-1.2) - PREC(0.02) * (REAL)i;
+    }
+
+
+    REAL *f[NMODELS], *fref[NMODELS];
+    for (size_t k = 0; k < NMODELS; k++)
+    {
+        f[k]    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+        fref[k] = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+        if ((f[k] == NULL) || (fref[k] == NULL))
+        {
+            fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+            exit(CHARM_FAILURE);
+        }
+    }
+
+
+    CHARM(glob_shs_grd_pslr_factor) = PREC(0.0);
+    CHARM(shs_point_batch)(pnt, shcs, NMODELS, shcs[0]->nmax, f, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(glob_shs_grd_pslr_factor) = PREC(1.0e9);
+    CHARM(shs_point_batch)(pnt, shcs, NMODELS, shcs[0]->nmax, fref, err);
+    CHARM(err_handler)(err, 1);
+
+
+    for (size_t k = 0; k < NMODELS; k++)
+    {
+        /* FFT and PSLR accumulate the rounding errors differently */
+        e += cmp_arrays(f[k], fref[k], pnt->npoint, CHARM(glob_threshold2));
+        free(f[k]);
+        free(fref[k]);
+    }
+
+
+    CHARM(crd_point_free)(pnt);
+    CHARM(glob_polar_optimization_a1) = a1;
+    CHARM(glob_polar_optimization_a2) = a2;
+    CHARM(glob_shs_grd_pslr_factor)   = pslr_factor;
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Scattered points */
+    /* --------------------------------------------------------------------- */
+    {
+    size_t npoint[3] = {1, 9, 31};
+
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        pnt = CHARM(crd_point_malloc)(CHARM_CRD_POINT_SCATTERED, npoint[i],
+                                      npoint[i]);
+        if (pnt == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_POINT);
+            exit(CHARM_FAILURE);
+        }
+
+
+        CHARM(generate_point)(pnt, shcs[0]->r + (REAL)(DELTAR), PI,
+                              PREC(2.0) * PI);
+
+
+        e += check_batch(pnt, shcs, NMODELS, NMAX, err);
+
+
+        CHARM(crd_point_free)(pnt);
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Invalid input */
+    /* --------------------------------------------------------------------- */
+    {
+    pnt = CHARM(crd_point_gl)(NMAX, shcs[0]->r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    REAL *f[NMODELS];
+    for (size_t k = 0; k < NMODELS; k++)
+    {
+        f[k] = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+        if (f[k] == NULL)
+        {
+            fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+            exit(CHARM_FAILURE);
+        }
+    }
+
+
+    /* "nmax" larger than "shcs[k]->nmax" */
+    CHARM(shs_point_batch)(pnt, shcs, NMODELS, SHCS_NMAX_POT + 1, f, err);
+    if (CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too large \"nmax\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    /* Different reference radii */
+    REAL r_tmp = shcs[NMODELS - 1]->r;
+    shcs[NMODELS - 1]->r *= SHCS_RESCALE_R_FACTOR;
+    CHARM(shs_point_batch)(pnt, shcs, NMODELS, NMAX, f, err);
+    if (CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Different \"shcs[k]->r\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+    shcs[NMODELS - 1]->r = r_tmp;
+
+
+    for (size_t k = 0; k < NMODELS; k++)
+        free(f[k]);
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    for (size_t k = 0; k < NMODELS; k++)
+        CHARM(shc_free)(shcs[k]);
+    CHARM(err_free)(err);
+
+
+    return e;
+    /* --------------------------------------------------------------------- */
+}
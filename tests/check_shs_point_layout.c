@@ -0,0 +1,174 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../src/prec.h"
+#include "cmp_vals.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "generate_point.h"
+#include "check_shs_point_layout.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Number of tested derivatives */
+#undef NDERIV
+#define NDERIV (10)
+
+
+
+
+
+
+/* Synthesizes the "dr", "dlat" and "dlon" derivative of "shcs" at "pnt" with
+ * the interleaved layout of the coefficients and without it and compares the
+ * results */
+static long int check_layout(const CHARM(point) *pnt,
+                             const CHARM(shc) *shcs,
+                             unsigned long nmax,
+                             unsigned dr,
+                             unsigned dlat,
+                             unsigned dlon,
+                             CHARM(err) *err)
+{
+    REAL *f    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    REAL *fref = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if ((f == NULL) || (fref == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    unsigned long interleave_nmax = CHARM(glob_shs_point_interleave_nmax);
+
+
+    CHARM(glob_shs_point_interleave_nmax) = nmax + 1;
+    CHARM(shs_point_guru)(pnt, shcs, nmax, dr, dlat, dlon, f, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(glob_shs_point_interleave_nmax) = 0;
+    CHARM(shs_point_guru)(pnt, shcs, nmax, dr, dlat, dlon, fref, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(glob_shs_point_interleave_nmax) = interleave_nmax;
+
+
+    /* The layouts differ in the rounding of the factor "mu / r", so the
+     * errors are related to the largest value of "fref" rather than to each
+     * value, some of which are close to zero */
+    REAL fmax = PREC(0.0);
+    for (size_t i = 0; i < pnt->npoint; i++)
+        fmax = CHARM_MAX(fmax, FABS(fref[i]));
+
+
+    long int e = 0;
+    REAL eps = PREC(10.0) * CHARM(glob_threshold);
+    for (size_t i = 0; i < pnt->npoint; i++)
+    {
+        if (FABS(f[i] - fref[i]) > eps * fmax)
+            e += cmp_vals_real(f[i], fref[i], eps);
+    }
+
+
+    free(f);
+    free(fref);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_shs_point_layout(void)
+{
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    long int e = 0;
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(shc_read_gfc)(SHCS_IN_PATH_POT_GFC, SHCS_NMAX_POT, NULL, shcs, err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* A sliced view to check that the coefficients outside the slice are
+     * ignored in the interleaved layout, too */
+    CHARM(shc) *view = CHARM(shc_view)(shcs, 2, SHCS_NMAX_POT, 1,
+                                       SHCS_NMAX_POT - 2);
+    if (view == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* "dr", "dlat" and "dlon" */
+    const unsigned deriv[NDERIV][3] = {{0, 0, 0},
+                                       {1, 0, 0}, {0, 1, 0}, {0, 0, 1},
+                                       {2, 0, 0}, {0, 2, 0}, {0, 0, 2},
+                                       {1, 1, 0}, {1, 0, 1}, {0, 1, 1}};
+
+
+    /* Points above the reference sphere and on it, so that both variants of
+     * the kernel are used */
+    const REAL r[2] = {shcs->r + (REAL)(DELTAR), shcs->r};
+
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        CHARM(point) *pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_SCATTERED,
+                                                    13, 13);
+        if (pnt == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_POINT);
+            exit(CHARM_FAILURE);
+        }
+        CHARM(generate_point)(pnt, r[i], PI, PREC(2.0) * PI);
+
+
+        for (unsigned long nmax = 0; nmax <= SHCS_NMAX_POT; nmax++)
+        {
+            for (size_t d = 0; d < NDERIV; d++)
+            {
+                e += check_layout(pnt, shcs, nmax, deriv[d][0], deriv[d][1],
+                                  deriv[d][2], err);
+                e += check_layout(pnt, view, nmax, deriv[d][0], deriv[d][1],
+                                  deriv[d][2], err);
+            }
+        }
+
+
+        CHARM(crd_point_free)(pnt);
+    }
+
+
+    CHARM(shc_free)(view);
+    CHARM(shc_free)(shcs);
+    CHARM(err_free)(err);
+
+
+    return e;
+}
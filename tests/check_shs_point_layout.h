@@ -0,0 +1,25 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __CHECK_SHS_POINT_LAYOUT_H__
+#define __CHECK_SHS_POINT_LAYOUT_H__
+
+
+#include <config.h>
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern long int check_shs_point_layout(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,343 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../src/prec.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "generate_point.h"
+#include "modify_low_degree_coefficients.h"
+#include "check_shs_point_table.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Synthesizes "shcs" at "pnt" with "CHARM(shs_point_table)" for all
+ * latitudinal derivatives up to "dlatmax" and compares the results with those
+ * from "CHARM(shs_point_guru)".  If "single" is "1", the Legendre functions
+ * are tabulated in single precision. */
+static long int check_table(const CHARM(point) *pnt,
+                            const CHARM(shc) *shcs,
+                            unsigned long nmax,
+                            unsigned dlatmax,
+                            _Bool single,
+                            CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    REAL *f    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    REAL *fref = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if ((f == NULL) || (fref == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(leg_table) *table = CHARM(leg_table_init)(pnt, nmax, dlatmax,
+                                                    single, 0, err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* The lumped coefficients are summed in a different order than in
+     * "CHARM(shs_point_guru)", so the differences are related to the maximum
+     * absolute value of the signal.  Still, some derivatives are obtained with
+     * a considerable cancellation, hence "CHARM(glob_threshold2)". */
+    const REAL eps = (single) ? CHARM_MAX(PREC(1e-5), CHARM(glob_threshold2))
+                              : CHARM(glob_threshold2);
+
+
+    for (unsigned dlat = 0; dlat <= dlatmax; dlat++)
+    {
+        CHARM(shs_point_table)(table, shcs, nmax, dlat, f, err);
+        CHARM(err_handler)(err, 1);
+
+
+        CHARM(shs_point_guru)(pnt, shcs, nmax, 0, dlat, 0, fref, err);
+        CHARM(err_handler)(err, 1);
+
+
+        REAL dmax = PREC(0.0);
+        REAL fmax = PREC(0.0);
+        for (size_t i = 0; i < pnt->npoint; i++)
+        {
+            dmax = CHARM_MAX(dmax, FABS(f[i] - fref[i]));
+            fmax = CHARM_MAX(fmax, FABS(fref[i]));
+        }
+
+
+        if (dmax > eps * fmax)
+        {
+            printf("\n        WARNING: Synthesis with the table is not "
+                   "accurate enough (nmax = %lu, dlat = %u, single = %d)!\n",
+                   nmax, dlat, (int)single);
+            e += 1;
+        }
+    }
+
+
+    CHARM(leg_table_free)(table);
+    free(f);
+    free(fref);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_shs_point_table(void)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_read_mtx)(SHCS_IN_PATH_POT_MTX, SHCS_NMAX_POT, shcs, err);
+    CHARM(err_handler)(err, 1);
+    modify_low_degree_coefficients(shcs);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    long int e = 0;
+    CHARM(point) *pnt = NULL;
+
+
+    /* Quadrature grids.  The Gauss--Legendre grids do not contain the poles,
+     * so all the derivatives are checked. */
+    /* --------------------------------------------------------------------- */
+    {
+    int grd_types[3] = {CHARM_CRD_POINT_GRID_GL,
+                        CHARM_CRD_POINT_GRID_DH1,
+                        CHARM_CRD_POINT_GRID_DH2};
+
+
+    for (int g = 0; g < 3; g++)
+    {
+        for (unsigned long nmax = 0; nmax <= SHCS_NMAX_POT; nmax++)
+        {
+            REAL r = shcs->r + (REAL)(DELTAR);
+
+
+            if (grd_types[g] == CHARM_CRD_POINT_GRID_GL)
+                pnt = CHARM(crd_point_gl)(nmax, r);
+            else if (grd_types[g] == CHARM_CRD_POINT_GRID_DH1)
+                pnt = CHARM(crd_point_dh1)(nmax, r);
+            else
+                pnt = CHARM(crd_point_dh2)(nmax, r);
+            if (pnt == NULL)
+            {
+                fprintf(stderr, "%s", ERR_MSG_POINT);
+                exit(CHARM_FAILURE);
+            }
+
+
+            unsigned dlatmax = (g == 0) ? 2 : 0;
+            e += check_table(pnt, shcs, nmax, dlatmax, 0, err);
+
+
+            CHARM(crd_point_free)(pnt);
+        }
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Custom grids without the poles with and without FFT */
+    /* --------------------------------------------------------------------- */
+    {
+    size_t nlat[NCUSTOM_GRD] = {1, 2, 3, 10};
+    size_t nlon[NCUSTOM_GRD] = {1, 2, 8, 22};
+
+
+    for (unsigned long nmax = 0; nmax <= NMAX; nmax++)
+    {
+        for (size_t i = 0; i < NCUSTOM_GRD; i++)
+        {
+            for (int fft = 0; fft < 2; fft++)
+            {
+                pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, nlat[i],
+                                              nlon[i]);
+                if (pnt == NULL)
+                {
+                    fprintf(stderr, "%s", ERR_MSG_POINT);
+                    exit(CHARM_FAILURE);
+                }
+
+
+                CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI,
+                                      (fft == 0) ? PI : PREC(2.0) * PI);
+                for (size_t l = 0; l < nlat[i]; l++)
+                    pnt->lat[l] = PI_2 - ((REAL)l + PREC(0.5)) /
+                                  (REAL)nlat[i] * PI;
+
+
+                e += check_table(pnt, shcs, nmax, 2, 0, err);
+
+
+                CHARM(crd_point_free)(pnt);
+            }
+        }
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Scattered points */
+    /* --------------------------------------------------------------------- */
+    {
+    size_t npoint[3] = {1, 9, 31};
+
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        pnt = CHARM(crd_point_malloc)(CHARM_CRD_POINT_SCATTERED, npoint[i],
+                                      npoint[i]);
+        if (pnt == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_POINT);
+            exit(CHARM_FAILURE);
+        }
+
+
+        CHARM(generate_point)(pnt, shcs->r + (REAL)(DELTAR), PI,
+                              PREC(2.0) * PI);
+        for (size_t l = 0; l < npoint[i]; l++)
+            pnt->lat[l] = PI_2 - ((REAL)l + PREC(0.5)) /
+                          (REAL)npoint[i] * PI;
+
+
+        e += check_table(pnt, shcs, SHCS_NMAX_POT, 2, 0, err);
+
+
+        CHARM(crd_point_free)(pnt);
+    }
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Legendre functions tabulated in single precision */
+    /* --------------------------------------------------------------------- */
+    {
+    pnt = CHARM(crd_point_gl)(SHCS_NMAX_POT, shcs->r + (REAL)(DELTAR));
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    e += check_table(pnt, shcs, SHCS_NMAX_POT, 2, 1, err);
+
+
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Invalid input */
+    /* --------------------------------------------------------------------- */
+    {
+    pnt = CHARM(crd_point_gl)(NMAX, shcs->r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    REAL *f = (REAL *)calloc(pnt->npoint, sizeof(REAL));
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(leg_table) *table = CHARM(leg_table_init)(pnt, NMAX - 1, 1, 0, 0,
+                                                    err);
+    CHARM(err_handler)(err, 1);
+
+
+    /* "nmax" larger than "nmax" of the table */
+    CHARM(shs_point_table)(table, shcs, NMAX, 0, f, err);
+    if (CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too large \"nmax\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    /* "dlat" larger than "dlat" of the table */
+    CHARM(shs_point_table)(table, shcs, NMAX - 1, 2, f, err);
+    if (CHARM(err_isempty)(err))
+    {
+        printf("\n        WARNING: Too large \"dlat\" didn't produce "
+               "an error!\n");
+        e += 1;
+    }
+    CHARM(err_reset)(err);
+
+
+    free(f);
+    CHARM(leg_table_free)(table);
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* --------------------------------------------------------------------- */
+    CHARM(shc_free)(shcs);
+    CHARM(err_free)(err);
+
+
+    return e;
+    /* --------------------------------------------------------------------- */
+}
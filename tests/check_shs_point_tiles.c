@@ -0,0 +1,412 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/prec.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "generate_point.h"
+#include "cmp_arrays.h"
+#include "check_shs_point_tiles.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Number of tested tile sizes */
+#undef NTILES
+#define NTILES (5)
+
+
+
+
+
+
+/* Assembles the tiles into the whole grid */
+typedef struct
+{
+    REAL *f;
+    size_t nlon;
+    size_t nlat_tile;
+    size_t nlon_tile;
+
+
+    /* Number of times each point was passed */
+    size_t *count;
+
+
+    /* Number of tiles exceeding "nlat_tile" or "nlon_tile" */
+    long int e;
+} tiles;
+
+
+
+
+
+
+static int store_tile(size_t i0,
+                      size_t j0,
+                      size_t nlat,
+                      size_t nlon,
+                      const REAL *f,
+                      void *data)
+{
+    tiles *t = (tiles *)data;
+
+
+    if ((nlat > t->nlat_tile) || (nlon > t->nlon_tile))
+        t->e++;
+
+
+    for (size_t i = 0; i < nlat; i++)
+    {
+        for (size_t j = 0; j < nlon; j++)
+        {
+            t->f[(i0 + i) * t->nlon + j0 + j] = f[i * nlon + j];
+            t->count[(i0 + i) * t->nlon + j0 + j]++;
+        }
+    }
+
+
+    return 0;
+}
+
+
+
+
+
+
+static int fail_tile(size_t i0,
+                     size_t j0,
+                     size_t nlat,
+                     size_t nlon,
+                     const REAL *f,
+                     void *data)
+{
+    (void)i0;
+    (void)j0;
+    (void)nlat;
+    (void)nlon;
+    (void)f;
+    (void)data;
+
+
+    return 1;
+}
+
+
+
+
+
+
+/* Synthesizes "shcs" at "pnt" by tiles of all the tested sizes and compares
+ * the results with "CHARM(shs_point)" */
+static long int check_tiles(const CHARM(point) *pnt,
+                            const CHARM(shc) *shcs,
+                            CHARM(err) *err)
+{
+    long int e = 0;
+
+
+    const size_t nlat_tile[NTILES] = {1, 2, 4, 3, 1000};
+    const size_t nlon_tile[NTILES] = {1, 3, 1000, 7, 1000};
+
+
+    REAL *fref    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    REAL *f       = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    size_t *count = (size_t *)malloc(pnt->npoint * sizeof(size_t));
+    if ((fref == NULL) || (f == NULL) || (count == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_point)(pnt, shcs, shcs->nmax, fref, err);
+    CHARM(err_handler)(err, 1);
+
+
+    for (size_t k = 0; k < NTILES; k++)
+    {
+        for (size_t i = 0; i < pnt->npoint; i++)
+        {
+            f[i]     = PREC(0.0);
+            count[i] = 0;
+        }
+
+
+        tiles t;
+        t.f         = f;
+        t.nlon      = pnt->nlon;
+        t.nlat_tile = nlat_tile[k];
+        t.nlon_tile = nlon_tile[k];
+        t.count     = count;
+        t.e         = 0;
+
+
+        CHARM(shs_point_tiles)(pnt, shcs, shcs->nmax, nlat_tile[k],
+                               nlon_tile[k], store_tile, &t, err);
+        CHARM(err_handler)(err, 1);
+
+
+        e += t.e;
+        for (size_t i = 0; i < pnt->npoint; i++)
+            e += (count[i] != 1) ? 1 : 0;
+        e += cmp_arrays(f, fref, pnt->npoint,
+                        PREC(10.0) * CHARM(glob_threshold));
+    }
+
+
+    free(fref);
+    free(f);
+    free(count);
+
+
+    return e;
+}
+
+
+
+
+
+
+long int check_shs_point_tiles(void)
+{
+    /* --------------------------------------------------------------------- */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_read_mtx)(SHCS_IN_PATH_POT_MTX, SHCS_NMAX_POT, shcs, err);
+    CHARM(err_handler)(err, 1);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    long int e = 0;
+    CHARM(point) *pnt = NULL;
+    REAL r = shcs->r + (REAL)(DELTAR);
+
+
+    /* Quadrature grids.  The Gauss--Legendre grid is symmetric with respect
+     * to the equator, the Driscoll--Healy grid is not. */
+    /* --------------------------------------------------------------------- */
+    pnt = CHARM(crd_point_gl)(SHCS_NMAX_POT, r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    e += check_tiles(pnt, shcs, err);
+    CHARM(crd_point_free)(pnt);
+
+
+    pnt = CHARM(crd_point_dh1)(SHCS_NMAX_POT, r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    e += check_tiles(pnt, shcs, err);
+    CHARM(crd_point_free)(pnt);
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Custom grids, including regional grids */
+    /* --------------------------------------------------------------------- */
+    {
+#undef NCUSTOM_GRD
+#define NCUSTOM_GRD (5)
+    size_t nlat[NCUSTOM_GRD] = {1, 2, 3, 10, 11};
+    size_t nlon[NCUSTOM_GRD] = {1, 5, 8, 22, 30};
+    REAL lon_rng[NCUSTOM_GRD] = {PREC(2.0) * PI, PREC(2.0) * PI,
+                                 PREC(2.0) * PI, PREC(2.0) * PI, PI};
+
+
+    for (size_t g = 0; g < NCUSTOM_GRD; g++)
+    {
+        pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, nlat[g], nlon[g]);
+        if (pnt == NULL)
+        {
+            fprintf(stderr, "%s", ERR_MSG_POINT);
+            exit(CHARM_FAILURE);
+        }
+        CHARM(generate_point)(pnt, r, PI, lon_rng[g]);
+
+
+        e += check_tiles(pnt, shcs, err);
+        CHARM(crd_point_free)(pnt);
+    }
+
+
+    /* Non-symmetric grid with symmetric first bands of three latitudes */
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, 7, 9);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, r, PI, PREC(2.0) * PI);
+    const REAL lat[7] = {PREC(0.3), PREC(0.0), PREC(-0.3), PREC(-0.5),
+                         PREC(-0.6), PREC(-0.9), PREC(-1.2)};
+    memcpy(pnt->lat, lat, 7 * sizeof(REAL));
+
+
+    e += check_tiles(pnt, shcs, err);
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Raw binary file */
+    /* --------------------------------------------------------------------- */
+    {
+    pnt = CHARM(crd_point_gl)(SHCS_NMAX_POT, r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    REAL *fref = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    REAL *f    = (REAL *)malloc(pnt->npoint * sizeof(REAL));
+    if ((fref == NULL) || (f == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_point)(pnt, shcs, SHCS_NMAX_POT, fref, err);
+    CHARM(err_handler)(err, 1);
+
+
+    CHARM(shs_point_tiles_raw)(pnt, shcs, SHCS_NMAX_POT, 2,
+                               SHS_OUT_PATH_TILES_RAW, err);
+    CHARM(err_handler)(err, 1);
+
+
+    FILE *fptr = fopen(SHS_OUT_PATH_TILES_RAW, "rb");
+    if (fptr == NULL)
+    {
+        fprintf(stderr, "Failed to open the raw binary file.\n");
+        exit(CHARM_FAILURE);
+    }
+    e += (fread(f, sizeof(REAL), pnt->npoint, fptr) != pnt->npoint) ? 1 : 0;
+    e += (fgetc(fptr) != EOF) ? 1 : 0;
+    fclose(fptr);
+
+
+    e += cmp_arrays(f, fref, pnt->npoint,
+                    PREC(10.0) * CHARM(glob_threshold));
+
+
+    free(fref);
+    free(f);
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+
+
+
+
+    /* Invalid input */
+    /* --------------------------------------------------------------------- */
+    {
+    tiles t;
+    t.nlat_tile = t.nlon_tile = 1;
+
+
+    pnt = CHARM(crd_point_calloc)(CHARM_CRD_POINT_SCATTERED, 3, 3);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_point)(pnt, r, PI, PREC(2.0) * PI);
+    CHARM(shs_point_tiles)(pnt, shcs, SHCS_NMAX_POT, 1, 1, store_tile, &t,
+                           err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+    CHARM(crd_point_free)(pnt);
+
+
+    pnt = CHARM(crd_point_gl)(SHCS_NMAX_POT, r);
+    if (pnt == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shs_point_tiles)(pnt, shcs, SHCS_NMAX_POT, 0, 1, store_tile, &t,
+                           err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shs_point_tiles)(pnt, shcs, SHCS_NMAX_POT, 1, 0, store_tile, &t,
+                           err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shs_point_tiles)(pnt, shcs, SHCS_NMAX_POT, 1, 1, NULL, &t, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(shs_point_tiles)(pnt, shcs, SHCS_NMAX_POT + 1, 1, 1, store_tile,
+                           &t, err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    /* The synthesis stops if "tile" fails */
+    CHARM(shs_point_tiles)(pnt, shcs, SHCS_NMAX_POT, 1, 1, fail_tile, NULL,
+                           err);
+    e += (CHARM(err_isempty)(err)) ? 1 : 0;
+    CHARM(err_reset)(err);
+
+
+    CHARM(crd_point_free)(pnt);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    CHARM(shc_free)(shcs);
+    CHARM(err_free)(err);
+
+
+    return e;
+}
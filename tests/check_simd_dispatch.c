@@ -0,0 +1,392 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/prec.h"
+#include "../src/misc/misc_buildopt.h"
+#include "../src/simd/simd_dispatch.h"
+#include "parameters.h"
+#include "error_messages.h"
+#include "cmp_arrays.h"
+#include "generate_cell.h"
+#include "modify_low_degree_coefficients.h"
+#include "check_simd_dispatch.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+#if HAVE_SIMD_DISPATCH
+
+
+/* Number of latitudes and longitudes of the custom point and cell grids and
+ * the number of scattered points and cells */
+#undef NLAT
+#define NLAT (37)
+#undef NLON
+#define NLON (20)
+
+
+/* Number of outputs per point of the grids and per scattered point: the
+ * synthesis ("1"), the first- and second-order gradients ("3" and "6") and,
+ * with the grids only, the batched synthesis of two models ("2") */
+#undef NGRD
+#define NGRD (12)
+#undef NSCTR
+#define NSCTR (10)
+
+
+/* SIMD instructions of the kernels compiled with "--enable-simd-dispatch" */
+static const int simd_all[] = {BUILDOPT_SIMD_NONE,
+                               BUILDOPT_SIMD_SSE41,
+                               BUILDOPT_SIMD_AVX,
+                               BUILDOPT_SIMD_AVX2,
+                               BUILDOPT_SIMD_AVX512};
+
+
+#undef NSIMD
+#define NSIMD (sizeof(simd_all) / sizeof(simd_all[0]))
+
+
+
+
+
+
+/* Sets the coordinates of "pnt" with "pnt->nlat" latitudes that are
+ * symmetric with respect to the equator.  The poles are avoided, because the
+ * gradients are ill-conditioned there, so the kernels with and without fused
+ * multiply-add instructions may give different results. */
+static void set_point(CHARM(point) *pnt,
+                      REAL r)
+{
+    for (size_t l = 0; l < pnt->nlat; l++)
+    {
+        pnt->lat[l] = PI_2 - ((REAL)l + PREC(0.5)) / (REAL)pnt->nlat * PI;
+        pnt->r[l]   = r;
+    }
+
+
+    for (size_t l = 0; l < pnt->nlon; l++)
+        pnt->lon[l] = (REAL)l / (REAL)pnt->nlon * PREC(2.0) * PI;
+
+
+    return;
+}
+
+
+
+
+
+
+/* Copies the coefficients of "shcs" to "out" and returns the number of the
+ * copied coefficients */
+static size_t copy_shc(const CHARM(shc) *shcs,
+                       REAL *out)
+{
+    memcpy(out, shcs->c[0], shcs->nc * sizeof(REAL));
+    memcpy(out + shcs->nc, shcs->s[0], shcs->ns * sizeof(REAL));
+
+
+    return shcs->nc + shcs->ns;
+}
+
+
+
+
+
+
+/* Synthesizes "shcs" and "shcs2" at "grd", "sctr", "cgrd" and "csctr" and
+ * analyses "fquad" and "fquad2" given at the quadrature grid "quad" with the
+ * kernels selected by the last call of "CHARM(simd_dispatch_set)".  All the
+ * outputs are stored one after another in "out". */
+static void transforms(const CHARM(shc) *shcs,
+                       const CHARM(shc) *shcs2,
+                       const CHARM(point) *grd,
+                       const CHARM(point) *sctr,
+                       const CHARM(cell) *cgrd,
+                       const CHARM(cell) *csctr,
+                       const CHARM(point) *quad,
+                       REAL *fquad,
+                       REAL *fquad2,
+                       REAL *out,
+                       CHARM(err) *err)
+{
+    const unsigned long nmax = shcs->nmax;
+    REAL *f[6];
+    size_t i = 0;
+
+
+    /* Point grid */
+    /* --------------------------------------------------------------------- */
+    CHARM(shs_point)(grd, shcs, nmax, out + i, err);
+    CHARM(err_handler)(err, 1);
+    i += grd->npoint;
+
+
+    for (int k = 0; k < 3; k++)
+        f[k] = out + i + k * grd->npoint;
+    CHARM(shs_point_grad1)(grd, shcs, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+    i += 3 * grd->npoint;
+
+
+    for (int k = 0; k < 6; k++)
+        f[k] = out + i + k * grd->npoint;
+    CHARM(shs_point_grad2)(grd, shcs, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+    i += 6 * grd->npoint;
+
+
+    CHARM(shc) *shcs_all[2] = {(CHARM(shc) *)shcs, (CHARM(shc) *)shcs2};
+    for (int k = 0; k < 2; k++)
+        f[k] = out + i + k * grd->npoint;
+    CHARM(shs_point_batch)(grd, shcs_all, 2, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+    i += 2 * grd->npoint;
+    /* --------------------------------------------------------------------- */
+
+
+    /* Scattered points */
+    /* --------------------------------------------------------------------- */
+    CHARM(shs_point)(sctr, shcs, nmax, out + i, err);
+    CHARM(err_handler)(err, 1);
+    i += sctr->npoint;
+
+
+    for (int k = 0; k < 3; k++)
+        f[k] = out + i + k * sctr->npoint;
+    CHARM(shs_point_grad1)(sctr, shcs, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+    i += 3 * sctr->npoint;
+
+
+    for (int k = 0; k < 6; k++)
+        f[k] = out + i + k * sctr->npoint;
+    CHARM(shs_point_grad2)(sctr, shcs, nmax, f, err);
+    CHARM(err_handler)(err, 1);
+    i += 6 * sctr->npoint;
+    /* --------------------------------------------------------------------- */
+
+
+    /* Cells */
+    /* --------------------------------------------------------------------- */
+    CHARM(shs_cell)(cgrd, shcs, nmax, out + i, err);
+    CHARM(err_handler)(err, 1);
+    i += cgrd->ncell;
+
+
+    CHARM(shs_cell)(csctr, shcs, nmax, out + i, err);
+    CHARM(err_handler)(err, 1);
+    i += csctr->ncell;
+    /* --------------------------------------------------------------------- */
+
+
+    /* Analysis */
+    /* --------------------------------------------------------------------- */
+    CHARM(shc) *shcs_out  = CHARM(shc_calloc)(nmax, shcs->mu, shcs->r);
+    CHARM(shc) *shcs_out2 = CHARM(shc_calloc)(nmax, shcs->mu, shcs->r);
+    if ((shcs_out == NULL) || (shcs_out2 == NULL))
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(sha_point)(quad, fquad, nmax, shcs_out, err);
+    CHARM(err_handler)(err, 1);
+    i += copy_shc(shcs_out, out + i);
+
+
+    REAL *fquad_all[2] = {fquad, fquad2};
+    shcs_all[0]        = shcs_out;
+    shcs_all[1]        = shcs_out2;
+    CHARM(sha_point_batch)(quad, fquad_all, 2, nmax, shcs_all, err);
+    CHARM(err_handler)(err, 1);
+    i += copy_shc(shcs_out, out + i);
+    i += copy_shc(shcs_out2, out + i);
+
+
+    CHARM(shc_free)(shcs_out);
+    CHARM(shc_free)(shcs_out2);
+    /* --------------------------------------------------------------------- */
+
+
+    return;
+}
+
+
+#endif
+
+
+
+
+
+
+/* Compares spherical harmonic transforms with the kernels of all SIMD
+ * instructions supported by the CPU with those of the kernels compiled
+ * without any SIMD instructions */
+long int check_simd_dispatch(void)
+{
+    long int e = 0;
+
+
+#if HAVE_SIMD_DISPATCH
+    /* --------------------------------------------------------------------- */
+    CHARM(err) *err = CHARM(err_init)();
+    if (err == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_ERR);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc) *shcs = CHARM(shc_calloc)(SHCS_NMAX_POT, PREC(1.0), PREC(1.0));
+    if (shcs == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    CHARM(shc_read_mtx)(SHCS_IN_PATH_POT_MTX, SHCS_NMAX_POT, shcs, err);
+    CHARM(err_handler)(err, 1);
+    modify_low_degree_coefficients(shcs);
+
+
+    CHARM(shc) *shcs2 = CHARM(shc_copy)(shcs, 0, shcs->nmax, shcs->nmax);
+    if (shcs2 == NULL)
+    {
+        fprintf(stderr, "%s", ERR_MSG_SHC);
+        exit(CHARM_FAILURE);
+    }
+
+
+    /* "CHARM(shs_point_batch)" requires the same "r" of all models */
+    CHARM(shc_rescale)(shcs2, shcs2->mu * SHCS_RESCALE_MU_FACTOR, shcs2->r,
+                       err);
+    CHARM(err_handler)(err, 1);
+    /* --------------------------------------------------------------------- */
+
+
+    /* --------------------------------------------------------------------- */
+    const REAL r = shcs->r + (REAL)(DELTAR);
+
+
+    CHARM(point) *grd  = CHARM(crd_point_calloc)(CHARM_CRD_POINT_GRID, NLAT,
+                                                 NLON);
+    CHARM(point) *sctr = CHARM(crd_point_calloc)(CHARM_CRD_POINT_SCATTERED,
+                                                 NLAT, NLAT);
+    CHARM(point) *quad = CHARM(crd_point_gl)(shcs->nmax, r);
+    if ((grd == NULL) || (sctr == NULL) || (quad == NULL))
+    {
+        fprintf(stderr, "%s", ERR_MSG_POINT);
+        exit(CHARM_FAILURE);
+    }
+    set_point(grd, r);
+    set_point(sctr, r);
+
+
+    CHARM(cell) *cgrd  = CHARM(crd_cell_calloc)(CHARM_CRD_CELL_GRID, NLAT,
+                                                NLON);
+    CHARM(cell) *csctr = CHARM(crd_cell_calloc)(CHARM_CRD_CELL_SCATTERED,
+                                                NLAT, NLAT);
+    if ((cgrd == NULL) || (csctr == NULL))
+    {
+        fprintf(stderr, "%s", ERR_MSG_CELL);
+        exit(CHARM_FAILURE);
+    }
+    CHARM(generate_cell)(cgrd, r, PI, PREC(2.0) * PI);
+    CHARM(generate_cell)(csctr, r, PI, PREC(2.0) * PI);
+
+
+    const size_t nout = NGRD * grd->npoint + NSCTR * sctr->npoint +
+                        cgrd->ncell + csctr->ncell +
+                        3 * (shcs->nc + shcs->ns);
+    REAL *fquad  = (REAL *)malloc(quad->npoint * sizeof(REAL));
+    REAL *fquad2 = (REAL *)malloc(quad->npoint * sizeof(REAL));
+    REAL *ref    = (REAL *)malloc(nout * sizeof(REAL));
+    REAL *out    = (REAL *)malloc(nout * sizeof(REAL));
+    if ((fquad == NULL) || (fquad2 == NULL) || (ref == NULL) ||
+        (out == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+    /* --------------------------------------------------------------------- */
+
+
+    /* Reference values from the kernels compiled without any SIMD
+     * instructions */
+    /* --------------------------------------------------------------------- */
+    if (CHARM(simd_dispatch_set)(simd_all[0]) ||
+        (CHARM(misc_buildopt_simd)() != simd_all[0]))
+    {
+        printf("\n        WARNING: Failed to select the kernels without "
+               "SIMD instructions!\n");
+        e += 1;
+    }
+
+
+    CHARM(shs_point)(quad, shcs, shcs->nmax, fquad, err);
+    CHARM(err_handler)(err, 1);
+    CHARM(shs_point)(quad, shcs2, shcs->nmax, fquad2, err);
+    CHARM(err_handler)(err, 1);
+
+
+    transforms(shcs, shcs2, grd, sctr, cgrd, csctr, quad, fquad, fquad2,
+               ref, err);
+    /* --------------------------------------------------------------------- */
+
+
+    /* --------------------------------------------------------------------- */
+    for (size_t s = 1; s < NSIMD; s++)
+    {
+        /* The kernels of the instructions that are not supported by the CPU
+         * cannot be selected */
+        if (CHARM(simd_dispatch_set)(simd_all[s]))
+            continue;
+
+
+        if (CHARM(misc_buildopt_simd)() != simd_all[s])
+        {
+            printf("\n        WARNING: \"charm" CHARM_SUFFIX
+                   "_misc_buildopt_simd\" does not return the selected "
+                   "SIMD instructions!\n");
+            e += 1;
+        }
+
+
+        transforms(shcs, shcs2, grd, sctr, cgrd, csctr, quad, fquad, fquad2,
+                   out, err);
+        e += cmp_arrays(out, ref, nout, CHARM(glob_threshold2));
+    }
+
+
+    /* Restore the kernels selected when the library was loaded */
+    CHARM(simd_dispatch_set)(CHARM(misc_cpu_simd)());
+    /* --------------------------------------------------------------------- */
+
+
+    /* --------------------------------------------------------------------- */
+    free(fquad);
+    free(fquad2);
+    free(ref);
+    free(out);
+    CHARM(crd_point_free)(grd);
+    CHARM(crd_point_free)(sctr);
+    CHARM(crd_point_free)(quad);
+    CHARM(crd_cell_free)(cgrd);
+    CHARM(crd_cell_free)(csctr);
+    CHARM(shc_free)(shcs);
+    CHARM(shc_free)(shcs2);
+    CHARM(err_free)(err);
+    /* --------------------------------------------------------------------- */
+#endif
+
+
+    return e;
+}
@@ -0,0 +1,191 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include "../src/prec.h"
+#include "../src/simd/simd.h"
+#include "../src/simd/calloc_aligned.h"
+#include "../src/simd/free_aligned.h"
+#include "../src/leg/leg_func_xnum.h"
+#include "check_simd_fma_leg.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Maximum harmonic degree of the recurrence */
+#undef NMAX_FMA
+#define NMAX_FMA (2000UL)
+
+
+/* Number of evaluation points, must be a multiple of "SIMD_SIZE" */
+#undef NPOINT_FMA
+#define NPOINT_FMA (64 * SIMD_SIZE)
+
+
+/* The reference values are computed in "long double", which is useful only if
+ * it is more precise than "REAL" */
+#undef FMA_LEG_REF
+#if CHARM_FLOAT
+#   define FMA_LEG_REF (LDBL_MANT_DIG > FLT_MANT_DIG)
+#elif CHARM_QUAD
+#   define FMA_LEG_REF 0
+#else
+#   define FMA_LEG_REF (LDBL_MANT_DIG > DBL_MANT_DIG)
+#endif
+
+
+
+
+
+
+/* Checks that the recurrence for the Legendre polynomials, "P_{n}(t) = a_{n}
+ * * t * P_{n - 1}(t) - b_{n} * P_{n - 2}(t)", combined with the sum
+ * "\sum_{n = 0}^{N} c_{n} * P_{n}(t)", evaluated by "PNM_RECURRENCE" and
+ * "FMA_R" as in the synthesis kernels, is not less accurate than the same
+ * computation, in which every product is rounded before the addition.  The
+ * errors are taken with respect to the reference values computed in "long
+ * double".  If "FMA_R" is not fused, both computations are the same. */
+long int check_simd_fma_leg(void)
+{
+    long int e = 0;
+
+
+#if FMA_LEG_REF
+    REAL *t = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, NPOINT_FMA,
+                                            sizeof(REAL));
+    REAL *f = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, NPOINT_FMA,
+                                            sizeof(REAL));
+    REAL *a = (REAL *)malloc((NMAX_FMA + 1) * sizeof(REAL));
+    REAL *b = (REAL *)malloc((NMAX_FMA + 1) * sizeof(REAL));
+    REAL *c = (REAL *)malloc((NMAX_FMA + 1) * sizeof(REAL));
+    if ((t == NULL) || (f == NULL) || (a == NULL) || (b == NULL) ||
+        (c == NULL))
+    {
+        fprintf(stderr, "%s", CHARM_ERR_MALLOC_FAILURE"\n");
+        exit(CHARM_FAILURE);
+    }
+
+
+    for (size_t i = 0; i < NPOINT_FMA; i++)
+        t[i] = PREC(-1.0) + PREC(2.0) * ((REAL)i + PREC(0.5)) /
+               (REAL)NPOINT_FMA;
+
+
+    unsigned long state = 1;
+    for (unsigned long n = 0; n <= NMAX_FMA; n++)
+    {
+        state = (state * 1103515245UL + 12345UL) % 2147483648UL;
+        c[n] = PREC(-1.0) + PREC(2.0) * (REAL)state / PREC(2147483648.0);
+
+
+        a[n] = b[n] = PREC(0.0);
+        if (n < 2)
+            continue;
+
+
+        a[n] = SQRT((REAL)((2 * n - 1) * (2 * n + 1))) / (REAL)n;
+        b[n] = (REAL)(n - 1) / (REAL)n *
+               SQRT((REAL)(2 * n + 1) / (REAL)(2 * n - 3));
+    }
+
+
+    /* The recurrence and the sum as in the synthesis kernels */
+    REAL_SIMD tv, x, y, pnm2, sum;
+    REAL_SIMD root3 = SET1_R(SQRT(PREC(3.0)));
+    for (size_t i = 0; i < NPOINT_FMA; i += SIMD_SIZE)
+    {
+        tv  = LOAD_R(&t[i]);
+        y   = SET1_R(PREC(1.0));
+        x   = MUL_R(root3, tv);
+        sum = FMA_R(SET1_R(c[1]), x, SET1_R(c[0]));
+        for (unsigned long n = 2; n <= NMAX_FMA; n++)
+        {
+            PNM_RECURRENCE(x, y, pnm2, tv, SET1_R(a[n]), SET1_R(b[n]));
+            sum = FMA_R(SET1_R(c[n]), pnm2, sum);
+            RECURRENCE_NEXT_ITER(y, x, pnm2);
+        }
+        STORE_R(&f[i], sum);
+    }
+
+
+    /* The same computation with the products rounded before the additions
+     * ("volatile" prevents the compiler from contracting them) and the
+     * reference computation in "long double".  The recurrence coefficients
+     * "a" and "b" are the same in all three computations, so that only the
+     * rounding errors of the recurrence and of the sum are compared. */
+    REAL maxe_fma = PREC(0.0), maxe_sep = PREC(0.0), maxf = PREC(0.0);
+    for (size_t i = 0; i < NPOINT_FMA; i++)
+    {
+        REAL xs = SQRT(PREC(3.0)) * t[i];
+        REAL ys = PREC(1.0);
+        REAL zs;
+        volatile REAL p1, p2;
+        p1 = c[1] * xs;
+        REAL sums = p1 + c[0];
+
+
+        long double xr   = (long double)xs;
+        long double yr   = 1.0L;
+        long double zr;
+        long double sumr = (long double)c[1] * xr + (long double)c[0];
+
+
+        for (unsigned long n = 2; n <= NMAX_FMA; n++)
+        {
+            p1   = a[n] * t[i];
+            p1   = p1 * xs;
+            p2   = b[n] * ys;
+            zs   = p1 - p2;
+            p1   = c[n] * zs;
+            sums = p1 + sums;
+            ys   = xs;
+            xs   = zs;
+
+
+            zr   = (long double)a[n] * (long double)t[i] * xr -
+                   (long double)b[n] * yr;
+            sumr = sumr + (long double)c[n] * zr;
+            yr   = xr;
+            xr   = zr;
+        }
+
+
+        if (FABS((REAL)sumr) > maxf)
+            maxf = FABS((REAL)sumr);
+        if (FABS((REAL)((long double)f[i] - sumr)) > maxe_fma)
+            maxe_fma = FABS((REAL)((long double)f[i] - sumr));
+        if (FABS((REAL)((long double)sums - sumr)) > maxe_sep)
+            maxe_sep = FABS((REAL)((long double)sums - sumr));
+    }
+
+
+    /* The errors of both computations fluctuate by a small factor, depending
+     * on the particular rounding errors, so the factor "2" is used */
+    if (maxe_fma > PREC(2.0) * maxe_sep)
+    {
+        printf("\n        WARNING: The relative error of the recurrence with "
+               "\"FMA_R\" (");
+        printf(REAL_PRINT_FORMAT, maxe_fma / maxf);
+        printf(") is larger than without \"FMA_R\" (");
+        printf(REAL_PRINT_FORMAT, maxe_sep / maxf);
+        printf(")!\n");
+        e += 1;
+    }
+
+
+    CHARM(free_aligned)(t);
+    CHARM(free_aligned)(f);
+    free(a);
+    free(b);
+    free(c);
+#endif
+
+
+    return e;
+}
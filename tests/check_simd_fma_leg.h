@@ -0,0 +1,25 @@
+/* This header file is not a part of API. */
+
+
+#ifndef __CHECK_SIMD_FMA_LEG_H__
+#define __CHECK_SIMD_FMA_LEG_H__
+
+
+#include <config.h>
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+extern long int check_simd_fma_leg(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
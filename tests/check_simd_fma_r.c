@@ -0,0 +1,98 @@
+/* Header files */
+/* ------------------------------------------------------------------------- */
+#include <config.h>
+#include <stdio.h>
+#include "../src/prec.h"
+#include "../src/simd/simd.h"
+#include "../src/simd/calloc_aligned.h"
+#include "../src/simd/free_aligned.h"
+#include "check_simd_fma_r.h"
+#include "cmp_vals.h"
+/* ------------------------------------------------------------------------- */
+
+
+
+
+
+
+/* Check the "FMA_R" and "FNMA_R" macros from "../src/simd/simd.h". */
+long int check_simd_fma_r(void)
+{
+    long int e = 0;
+
+
+    /* Test arrays "x = [1, 2, ..., SIMD_SIZE]", "y = [0.5, 1.5, ...,
+     * SIMD_SIZE - 0.5]" and "z = [-1, -2, ..., -SIMD_SIZE]" */
+    REAL *x = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                            sizeof(REAL));
+    REAL *y = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                            sizeof(REAL));
+    REAL *z = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                            sizeof(REAL));
+    REAL *r = (REAL *)CHARM(calloc_aligned)(SIMD_MEMALIGN, SIMD_SIZE,
+                                            sizeof(REAL));
+    for (int i = 0; i < SIMD_SIZE; i++)
+    {
+        x[i] = (REAL)(i + 1);
+        y[i] = (REAL)i + PREC(0.5);
+        z[i] = -(REAL)(i + 1);
+    }
+
+
+    STORE_R(&r[0], FMA_R(LOAD_R(x), LOAD_R(y), LOAD_R(z)));
+    for (int i = 0; i < SIMD_SIZE; i++)
+        e += cmp_vals_real(r[i], x[i] * y[i] + z[i], CHARM(glob_threshold));
+
+
+    STORE_R(&r[0], FNMA_R(LOAD_R(x), LOAD_R(y), LOAD_R(z)));
+    for (int i = 0; i < SIMD_SIZE; i++)
+        e += cmp_vals_real(r[i], z[i] - x[i] * y[i], CHARM(glob_threshold));
+
+
+#ifdef SIMD
+    /* Now check the rounding.  We take "h = 2^(-k)" such that "1 - h^2" is
+     * rounded to "1".  Then, "(1 + h) * (1 - h) - 1" is "-h^2" if the fused
+     * multiply-add instructions are available (single rounding) and "0" if
+     * the product is rounded before the addition. */
+    REAL h = PREC(1.0);
+    while ((REAL)(PREC(1.0) - h * h) != PREC(1.0))
+        h /= PREC(2.0);
+
+
+#   ifdef SIMD_FMA
+    REAL ref  = -h * h;
+    REAL ref2 = h * h;
+#   else
+    REAL ref  = PREC(0.0);
+    REAL ref2 = PREC(0.0);
+#   endif
+
+
+    REAL_SIMD xh  = SET1_R(PREC(1.0) + h);
+    REAL_SIMD yh  = SET1_R(PREC(1.0) - h);
+    REAL_SIMD one = SET1_R(PREC(1.0));
+
+
+    if (!MASK_TRUE_ALL(EQ_R(FMA_R(xh, yh, NEG_R(one)), SET1_R(ref))))
+    {
+        printf("\n        WARNING: Rounding of \"FMA_R\" didn't pass!\n");
+        e += 1;
+    }
+
+
+    if (!MASK_TRUE_ALL(EQ_R(FNMA_R(xh, yh, one), SET1_R(ref2))))
+    {
+        printf("\n        WARNING: Rounding of \"FNMA_R\" didn't pass!\n");
+        e += 1;
+    }
+#endif
+
+
+    CHARM(free_aligned)(x);
+    CHARM(free_aligned)(y);
+    CHARM(free_aligned)(z);
+    CHARM(free_aligned)(r);
+
+
+    return e;
+}
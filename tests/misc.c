@@ -6,8 +6,11 @@
 #include "check_simd_abs_r.h"
 #include "check_simd_neg_r.h"
 #include "check_simd_sum_r.h"
+#include "check_simd_fma_r.h"
+#include "check_simd_fma_leg.h"
 #include "check_simd_masks.h"
 #include "check_simd_blend_r.h"
+#include "check_simd_dispatch.h"
 #include "check_func.h"
 #include "check_outcome.h"
 #include "misc.h"
@@ -55,6 +58,18 @@ long int misc(void)
     esum += e;
 
 
+    check_func("FMA_R");
+    e = check_simd_fma_r();
+    check_outcome(e);
+    esum += e;
+
+
+    check_func("FMA_R in Legendre recurrences");
+    e = check_simd_fma_leg();
+    check_outcome(e);
+    esum += e;
+
+
 #ifdef SIMD
     check_func("BLEND_R");
     e = check_simd_blend_r();
@@ -63,6 +78,14 @@ long int misc(void)
 #endif
 
 
+#if HAVE_SIMD_DISPATCH
+    check_func("simd_dispatch_set");
+    e = check_simd_dispatch();
+    check_outcome(e);
+    esum += e;
+#endif
+
+
     return esum;
 }
 
@@ -5,6 +5,7 @@
 #include "../src/prec.h"
 #include "check_leg_pnmj_coeffs.h"
 #include "check_leg_pnmj_alloc.h"
+#include "check_leg_table.h"
 #include "check_func.h"
 #include "check_outcome.h"
 #include "module_leg.h"
@@ -40,6 +41,12 @@ long int module_leg(void)
     esum += e;
 
 
+    check_func("leg_table");
+    e = check_leg_table();
+    check_outcome(e);
+    esum += e;
+
+
     return esum;
 }
 
@@ -12,6 +12,7 @@
 #include "check_mpi_shc_alloc.h"
 #include "check_mpi_shc_init.h"
 #include "check_mpi_shc_local_ncs.h"
+#include "check_mpi_shc_read.h"
 #include "check_mpi_crd_point_init.h"
 #include "check_mpi_crd_point_quad.h"
 #include "check_mpi_crd_point_alloc.h"
@@ -55,6 +56,12 @@ long int module_mpi(void)
     esum += e;
 
 
+    check_func("mpi_shc_read");
+    e = check_mpi_shc_read();
+    check_outcome(e);
+    esum += e;
+
+
     check_func("mpi_crd_point_init");
     e = check_mpi_crd_point_init();
     check_outcome(e);
@@ -6,6 +6,9 @@
 #include "check_outcome.h"
 #include "check_sha_point.h"
 #include "check_sha_cell.h"
+#include "check_sha_plan.h"
+#include "check_sha_point_batch.h"
+#include "check_sha_point_table.h"
 #include "module_sha.h"
 /* ------------------------------------------------------------------------- */
 
@@ -27,6 +30,24 @@ long int module_sha(void)
     esum += e;
 
 
+    check_func("sha_plan");
+    e = check_sha_plan();
+    check_outcome(e);
+    esum += e;
+
+
+    check_func("sha_point_batch");
+    e = check_sha_point_batch();
+    check_outcome(e);
+    esum += e;
+
+
+    check_func("sha_point_table");
+    e = check_sha_point_table();
+    check_outcome(e);
+    esum += e;
+
+
     check_func("sha_cell");
     e = check_sha_cell();
     check_outcome(e);
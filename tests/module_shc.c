@@ -7,8 +7,13 @@
 #include "check_func.h"
 #include "check_outcome.h"
 #include "check_shc_read_gfc.h"
+#include "check_shc_tv.h"
+#include "check_shc_map_bin.h"
+#include "check_shc_read_bin_chunk.h"
+#include "check_shc_binz.h"
 #include "check_shc_read_type.h"
 #include "check_shc_write_type.h"
+#include "check_shc_write_shortest.h"
 #include "check_shc_arithmetics.h"
 #include "check_shc_arithmetics_wise.h"
 #include "check_shc_dav.h"
@@ -17,6 +22,7 @@
 #include "check_shc_alloc.h"
 #include "check_shc_init.h"
 #include "check_shc_copy.h"
+#include "check_shc_view.h"
 #include "module_shc.h"
 /* ------------------------------------------------------------------------- */
 
@@ -55,6 +61,12 @@ long int module_shc(void)
     esum += e;
 
 
+    check_func("shc_view");
+    e = check_shc_view();
+    check_outcome(e);
+    esum += e;
+
+
     /* Must run before testing any other reading routine, because they use this
      * routine as a reference */
     check_func("shc_read_gfc");
@@ -63,6 +75,12 @@ long int module_shc(void)
     esum += e;
 
 
+    check_func("shc_tv");
+    e = check_shc_tv();
+    check_outcome(e);
+    esum += e;
+
+
     check_func("shc_read_mtx");
     e = check_shc_read_type(CHARM(shc_read_mtx));
     check_outcome(e);
@@ -94,6 +112,24 @@ long int module_shc(void)
     esum += e;
 
 
+    check_func("shc_map_bin");
+    e = check_shc_map_bin();
+    check_outcome(e);
+    esum += e;
+
+
+    check_func("shc_read_bin_chunk");
+    e = check_shc_read_bin_chunk();
+    check_outcome(e);
+    esum += e;
+
+
+    check_func("shc_binz");
+    e = check_shc_binz();
+    check_outcome(e);
+    esum += e;
+
+
     check_func("shc_write_mtx");
     e = check_shc_write_type(1);
     check_outcome(e);
@@ -114,6 +150,12 @@ long int module_shc(void)
     esum += e;
 
 
+    check_func("shc_write_{mtx,tbl,dov} (shortest)");
+    e = check_shc_write_shortest();
+    check_outcome(e);
+    esum += e;
+
+
     check_func("shc_add");
     e = check_shc_arithmetics(CHARM(shc_add));
     check_outcome(e);
@@ -5,6 +5,11 @@
 #include "check_func.h"
 #include "check_outcome.h"
 #include "check_shs_point_all.h"
+#include "check_shs_point_batch.h"
+#include "check_shs_point_tiles.h"
+#include "check_shs_point_table.h"
+#include "check_shs_point_layout.h"
+#include "check_shs_plan.h"
 #include "check_shs_cell.h"
 #include "check_shs_cell_isurf.h"
 #include "module_shs.h"
@@ -46,6 +51,36 @@ long int module_shs(void)
     esum += e;
 
 
+    check_func("shs_point_batch");
+    e = check_shs_point_batch();
+    check_outcome(e);
+    esum += e;
+
+
+    check_func("shs_point_tiles");
+    e = check_shs_point_tiles();
+    check_outcome(e);
+    esum += e;
+
+
+    check_func("shs_point_table");
+    e = check_shs_point_table();
+    check_outcome(e);
+    esum += e;
+
+
+    check_func("shs_point_layout");
+    e = check_shs_point_layout();
+    check_outcome(e);
+    esum += e;
+
+
+    check_func("shs_plan");
+    e = check_shs_plan();
+    check_outcome(e);
+    esum += e;
+
+
     check_func("shs_cell");
     e = check_shs_cell();
     check_outcome(e);
@@ -78,6 +78,62 @@
 #define SHCS_OUT_PATH_POT_BIN "../data/output/EGM96-degree10.shcs"
 
 
+/* Paths to the binary file "SHCS_OUT_PATH_POT_BIN" with swapped bytes, to
+ * the same file in the legacy format without the header and to its corrupted
+ * copy */
+#undef SHCS_OUT_PATH_POT_BIN_SWAP
+#define SHCS_OUT_PATH_POT_BIN_SWAP "../data/output/EGM96-degree10-swap.shcs"
+#undef SHCS_OUT_PATH_POT_BIN_LEGACY
+#define SHCS_OUT_PATH_POT_BIN_LEGACY "../data/output/EGM96-degree10-legacy.shcs"
+#undef SHCS_OUT_PATH_POT_BIN_CORRUPT
+#define SHCS_OUT_PATH_POT_BIN_CORRUPT "../data/output/EGM96-degree10" \
+                                      "-corrupt.shcs"
+
+
+/* Paths to the compressed binary files written by "shc_write_binz", to the
+ * corrupted copy of the former and to the binary files with the random model
+ * written by "shc_write_binz" and "shc_write_bin".  "SHCS_NMAX_BINZ" is the
+ * maximum degree of the random model. */
+#undef SHCS_OUT_PATH_POT_BINZ
+#define SHCS_OUT_PATH_POT_BINZ "../data/output/EGM96-degree10.shcz"
+#undef SHCS_OUT_PATH_POT_BINZ_CORRUPT
+#define SHCS_OUT_PATH_POT_BINZ_CORRUPT "../data/output/EGM96-degree10" \
+                                       "-corrupt.shcz"
+#undef SHCS_OUT_PATH_RAND_BINZ
+#define SHCS_OUT_PATH_RAND_BINZ "../data/output/random.shcz"
+#undef SHCS_OUT_PATH_RAND_BIN
+#define SHCS_OUT_PATH_RAND_BIN "../data/output/random.shcs"
+#undef SHCS_NMAX_BINZ
+#define SHCS_NMAX_BINZ (300UL)
+
+
+/* Maximum harmonic degree of the models, with which the degree variances are
+ * checked not to depend on the number of threads */
+#undef SHCS_NMAX_THREADS
+#define SHCS_NMAX_THREADS (300UL)
+
+
+/* Path to the binary file written and read by the MPI tests */
+#undef SHCS_OUT_PATH_POT_BIN_MPI
+#define SHCS_OUT_PATH_POT_BIN_MPI "../data/output/EGM96-degree10-mpi.shcs"
+
+
+/* Paths to the text files with orders in the outer loop written and read by
+ * the MPI tests and to a corrupted "tbl" file */
+#undef SHCS_OUT_PATH_POT_TBL_MPI
+#define SHCS_OUT_PATH_POT_TBL_MPI "../data/output/EGM96-degree10-tbl-mpi.txt"
+#undef SHCS_OUT_PATH_POT_DOV_MPI
+#define SHCS_OUT_PATH_POT_DOV_MPI "../data/output/EGM96-degree10-dov-mpi.txt"
+#undef SHCS_OUT_PATH_POT_TBL_CORRUPT_MPI
+#define SHCS_OUT_PATH_POT_TBL_CORRUPT_MPI "../data/output/EGM96-degree10" \
+                                          "-tbl-corrupt-mpi.txt"
+
+
+/* Path to the raw binary file written by "shs_point_tiles_raw" */
+#undef SHS_OUT_PATH_TILES_RAW
+#define SHS_OUT_PATH_TILES_RAW "../data/output/shs-tiles.raw"
+
+
 /* Path to input spherical harmonic coefficients of the potential in the mtx 
  * format */
 #undef SHCS_OUT_PATH_POT_MTX
@@ -108,6 +164,30 @@
 #define SHCS_OUT_PATH_POT_DOV_M "../data/output/EGM96-degree10-dov-m.txt"
 
 
+/* Paths to the output files written by "check_shc_write_shortest" and the
+ * maximum harmonic degree of the coefficients written to the files */
+#undef SHCS_OUT_PATH_SHORTEST
+#define SHCS_OUT_PATH_SHORTEST "../data/output/shortest.txt"
+#undef SHCS_OUT_PATH_SHORTEST_THREADS
+#define SHCS_OUT_PATH_SHORTEST_THREADS "../data/output/shortest-threads.txt"
+#undef SHCS_NMAX_SHORTEST
+#define SHCS_NMAX_SHORTEST (150UL)
+
+
+/* Path to a large "gfc" file that is generated and then read by
+ * "check_shc_read_gfc" and its maximum harmonic degree */
+#undef SHCS_OUT_PATH_GFC_LARGE
+#define SHCS_OUT_PATH_GFC_LARGE "../data/output/shc-read-gfc-large.gfc"
+#undef SHCS_NMAX_GFC_LARGE
+#define SHCS_NMAX_GFC_LARGE (300UL)
+
+
+/* Path to a time variable "gfc" file of the "icgem2.0" format that is
+ * generated and then read by "check_shc_tv" */
+#undef SHCS_OUT_PATH_GFC_ICGEM2
+#define SHCS_OUT_PATH_GFC_ICGEM2 "../data/output/shc-tv-icgem2.gfc"
+
+
 /* Multiplication factors to test rescaling of spherical harmonics coefficients
  * */
 #undef SHCS_RESCALE_MU_FACTOR
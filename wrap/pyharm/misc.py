@@ -81,6 +81,12 @@ def buildopt_simd():
 
     * ``5`` if CHarm was compiled with SSE4.1 instructions enabled
       (``--enable-sse4.1``).
+
+    If CHarm was compiled with ``--enable-simd-dispatch``, the kernels of
+    spherical harmonic transforms are compiled for SSE4.1, AVX, AVX2 and
+    AVX-512 and the richest instruction set supported by the CPU is selected
+    when the library is loaded.  The function then returns the selected
+    instruction set (``0`` if the CPU supports none of them).
     """
 
     func          = _libcharm[_CHARM + 'misc_buildopt_simd']
@@ -94,6 +100,11 @@ def buildopt_simd_vector_size():
     """
     Returns the size of SIMD vectors if CHarm was compiled with SIMD
     instructions enabled and ``1`` otherwise (SIMD instructions disabled).
+
+    With ``--enable-simd-dispatch``, the data are passed to the kernels in
+    vectors of 64 bytes regardless of the instruction set selected at
+    runtime, so the function returns ``8`` in double and ``16`` in single
+    precision.
     """
 
     func          = _libcharm[_CHARM + 'misc_buildopt_simd_vector_size']
@@ -103,6 +114,55 @@ def buildopt_simd_vector_size():
     return func()
 
 
+def buildopt_simd_dispatch():
+    """
+    Returns a non-zero value if CHarm was compiled with the runtime selection
+    of SIMD instructions enabled (``--enable-simd-dispatch``).  Otherwise,
+    zero is returned.  The instruction set selected at runtime is returned by
+    :obj:`buildopt_simd`.
+    """
+
+    func          = _libcharm[_CHARM + 'misc_buildopt_simd_dispatch']
+    func.argtypes = None
+    func.restype  = _ct_int
+
+    return func()
+
+
+def cpu_simd():
+    """
+    Returns the richest SIMD instruction set supported by the CPU on which
+    the program is running.  The return values are the same as in
+    :obj:`buildopt_simd`, so that ``0`` means that none of the SIMD
+    instruction sets supported by CHarm is available.
+
+    This is useful to select the most efficient CHarm build on
+    heterogeneous clusters, since the SIMD instructions are selected when
+    compiling CHarm (unless CHarm was compiled with
+    ``--enable-simd-dispatch``, see :obj:`buildopt_simd_dispatch`).
+    """
+
+    func          = _libcharm[_CHARM + 'misc_cpu_simd']
+    func.argtypes = None
+    func.restype  = _ct_int
+
+    return func()
+
+
+def cpu_simd_check():
+    """
+    Returns a non-zero value if the CPU on which the program is running
+    supports the SIMD instructions CHarm was compiled with (see
+    :obj:`buildopt_simd` and :obj:`cpu_simd`).  Otherwise, zero is returned.
+    """
+
+    func          = _libcharm[_CHARM + 'misc_cpu_simd_check']
+    func.argtypes = None
+    func.restype  = _ct_int
+
+    return func()
+
+
 def buildopt_omp_charm():
     """
     Returns a non-zero value if CHarm was compiled with the OpenMP